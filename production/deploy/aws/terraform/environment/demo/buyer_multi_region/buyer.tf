@@ -73,6 +73,7 @@ locals {
     CONSENTED_DEBUG_TOKEN                                 = "" # Example: "123456". Consented debugging requests increase server load in production. A high QPS of these requests can lead to unhealthy servers.
     DEBUG_SAMPLE_RATE_MICRO                               = "0"
     TEST_MODE                                             = "" # Example: "false"
+    GENERATE_BID_BATCH_SIZE                               = "" # Example: "1". Number of interest groups sent to generateBid in one UDF invocation.
     BUYER_CODE_FETCH_CONFIG                               = "" # Example:
 
     # [BEGIN] Protected App Signals (PAS) related params
@@ -135,6 +136,9 @@ locals {
     INFERENCE_MODEL_REGISTRATION_TIMEOUT_MS  = "60000"
     INFERENCE_MODEL_EXECUTION_TIMEOUT_MS     = "60000"
     INFERENCE_MODEL_PATHS_REQUEST_TIMEOUT_MS = "60000"
+    INFERENCE_MAX_BATCH_SIZE                 = "0"
+    INFERENCE_BATCH_TIMEOUT_US               = "500"
+    INFERENCE_MODEL_SHARED_DIR               = "" # Example: "/dev/shm/inference_models"
     INFERENCE_ENABLE_PROTO_PARSING           = false
     INFERENCE_ENABLE_CANCELLATION_AT_BIDDING = false
     # "{
@@ -191,6 +195,10 @@ locals {
     CURL_BFE_WORK_QUEUE_LENGTH     = 1000
     CURL_BIDDING_WORK_QUEUE_LENGTH = 10 # Recommended to keep it 10.
     #
+    # Lets idle BFE curl workers take queued requests from busy workers, which
+    # keeps all the workers busy during KV fan-out bursts.
+    CURL_BFE_ENABLE_WORK_STEALING = "false"
+    #
     # Constrains the size of the libcurl connection cache.
     # 0 is default, means unlimited.
     # See https://curl.se/libcurl/c/CURLMOPT_MAXCONNECTS.html.
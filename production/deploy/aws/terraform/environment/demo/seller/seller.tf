@@ -97,6 +97,7 @@ locals {
     NUM_K_ANON_SHARDS                   = "" # Example: "1"
     NUM_NON_K_ANON_SHARDS               = "" # Example: "1"
     ENABLE_K_ANON_QUERY_CACHE           = "" # Example: "true"
+    K_ANON_CACHE_TYPE                   = "" # Example: "LRU", "SHARDED_LRU" or "CLOCK"
 
     # Coordinator-based attestation flags.
     # These flags are production-ready and you do not need to change them.
@@ -129,9 +130,10 @@ locals {
     SFE_TCMALLOC_BACKGROUND_RELEASE_RATE_BYTES_PER_SECOND     = "4096"
     SFE_TCMALLOC_MAX_TOTAL_THREAD_CACHE_BYTES                 = "10737418240"
 
-    ENABLE_CHAFFING        = "" # Example: "false"
-    ENABLE_CHAFFING_V2     = "" # Example: "false"
-    ENABLE_PRIORITY_VECTOR = "" # Example: "true"
+    ENABLE_CHAFFING                = "" # Example: "false"
+    ENABLE_CHAFFING_V2             = "" # Example: "false"
+    CHAFFING_V2_MOVING_MEDIAN_TYPE = "" # Example: "MULTISET" or "TWO_HEAP"
+    ENABLE_PRIORITY_VECTOR         = "" # Example: "true"
     # Possible values:
     # NOT_FETCHED: No call to KV server is made. All ads are sent to scoreAd().
     # FETCHED_BUT_OPTIONAL: Call to KV server is made and must not fail. All ads are sent to scoreAd() irrespective of whether their adRenderUrls have scoring signals or not.
@@ -141,6 +143,26 @@ locals {
     ENABLE_BUYER_CACHING            = "" # Example: "true"
     SFE_BFE_COMPRESSION_ALGO        = "" # Provide an integer value: 0 - uncompressed, 1 - DEFLATE, 2 - zstd
 
+    # Fetch the scoring signals for each buyer's bids as soon as they arrive.
+    ENABLE_INCREMENTAL_SCORING_SIGNALS_FETCH = "" # Example: "true"
+
+    # Hedge slow GetBids calls and cut them off ahead of the SelectAd deadline.
+    ENABLE_ADAPTIVE_GET_BIDS   = "" # Example: "true"
+    GET_BIDS_CUTOFF_RESERVE_MS = "" # Example: "100"
+    # Cache the scoring signals of each render URL for this many milliseconds,
+    # sharing in-flight fetches across auctions. Disabled if 0.
+    SCORING_SIGNALS_CACHE_TTL_MS      = "" # Example: "1000"
+    SCORING_SIGNALS_CACHE_MAX_ENTRIES = "" # Example: "65536"
+
+    # Send identical in-flight scoring signals GET requests as a single
+    # transfer.
+    CURL_SFE_ENABLE_SINGLE_FLIGHT = "" # Example: "false"
+
+    # Multiplex scoring signals requests to a host over its HTTP/2 connections,
+    # with at most CURL_SFE_MAX_CONCURRENT_STREAMS streams each.
+    CURL_SFE_ENABLE_HTTP2_MULTIPLEXING = "" # Example: "false"
+    CURL_SFE_MAX_CONCURRENT_STREAMS    = "" # Example: "100"
+
     ###### [BEGIN] Libcurl parameters.
     #
     # Libcurl is used in frontend servers to fetch real time signals for BYOS
@@ -224,6 +224,7 @@ module "buyer" {
     #  }"
     UDF_NUM_WORKERS           = "" # Example: "64" Must be <=vCPUs in bidding_machine_type.
     JS_WORKER_QUEUE_LEN       = "" # Example: "200".
+    GENERATE_BID_BATCH_SIZE   = "" # Example: "1". Number of interest groups sent to generateBid in one UDF invocation.
     ROMA_TIMEOUT_MS           = "" # Example: "10000"
     TELEMETRY_CONFIG          = "" # Example: "mode: EXPERIMENT"
     COLLECTOR_ENDPOINT        = "" # Example: "collector-buyer-1-${each.key}.bfe-gcp.com:4317"
@@ -262,6 +263,9 @@ module "buyer" {
     INFERENCE_MODEL_REGISTRATION_TIMEOUT_MS  = "60000"
     INFERENCE_MODEL_EXECUTION_TIMEOUT_MS     = "60000"
     INFERENCE_MODEL_PATHS_REQUEST_TIMEOUT_MS = "60000"
+    INFERENCE_MAX_BATCH_SIZE                 = "0"
+    INFERENCE_BATCH_TIMEOUT_US               = "500"
+    INFERENCE_MODEL_SHARED_DIR               = "" # Example: "/dev/shm/inference_models"
     INFERENCE_ENABLE_PROTO_PARSING           = false
     INFERENCE_ENABLE_CANCELLATION_AT_BIDDING = false
     # "{
@@ -316,6 +320,24 @@ module "buyer" {
     CURL_BFE_WORK_QUEUE_LENGTH     = 1000
     CURL_BIDDING_WORK_QUEUE_LENGTH = 10 # Recommended to keep it 10.
     #
+    # Lets idle BFE curl workers take queued requests from busy workers, which
+    # keeps all the workers busy during KV fan-out bursts.
+    CURL_BFE_ENABLE_WORK_STEALING = "false"
+    #
+    # How long (in milliseconds) BFE serves buyer KV responses from its cache.
+    # Only enable it if the KV responses don't depend on the client IP.
+    # 0 disables the cache.
+    BUYER_KV_CACHE_TTL_MS      = 0
+    BUYER_KV_CACHE_MAX_ENTRIES = 65536
+
+    # Send identical in-flight KV GET requests as a single transfer.
+    CURL_BFE_ENABLE_SINGLE_FLIGHT = false
+
+    # Multiplex KV requests to a host over its HTTP/2 connections, with at
+    # most CURL_BFE_MAX_CONCURRENT_STREAMS streams each (0 for libcurl's 100).
+    CURL_BFE_ENABLE_HTTP2_MULTIPLEXING = false
+    CURL_BFE_MAX_CONCURRENT_STREAMS    = 0
+    #
     # Constrains the size of the libcurl connection cache.
     # 0 is default, means unlimited.
     # See https://curl.se/libcurl/c/CURLMOPT_MAXCONNECTS.html.
@@ -496,17 +496,18 @@ void ScoreAdsReactor::BuildScoreAdRequestForComponentGhostWinners(
       case AdType::AD_TYPE_PROTECTED_AUDIENCE_AD: {
         auto [unused_it, inserted] = ad_data_.try_emplace(
             dispatch_request->id,
-            MapKAnonGhostWinnerToAdWithBidMetadata(
+            OwnOnArena(MapKAnonGhostWinnerToAdWithBidMetadata(
                 ghost_winner.owner(), ghost_winner.ig_name(),
-                ghost_winner_for_top_level_auction));
+                ghost_winner_for_top_level_auction)));
         insertion_success = inserted;
         break;
       }
       case AdType::AD_TYPE_PROTECTED_APP_SIGNALS_AD: {
         auto [unused_it, inserted] = protected_app_signals_ad_data_.try_emplace(
             dispatch_request->id,
-            MapKAnonGhostWinnerToProtectedAppSignalsAdWithBidMetadata(
-                ghost_winner.owner(), ghost_winner_for_top_level_auction));
+            OwnOnArena(
+                MapKAnonGhostWinnerToProtectedAppSignalsAdWithBidMetadata(
+                    ghost_winner.owner(), ghost_winner_for_top_level_auction)));
         insertion_success = inserted;
         break;
       }
@@ -531,8 +532,7 @@ void ScoreAdsReactor::BuildScoreAdRequestForComponentGhostWinners(
         << "Created scoring request for component ghost winner: "
         << ghost_winner_for_top_level_auction;
     ad_k_anon_join_cand_.try_emplace(
-        dispatch_request->id,
-        std::move(*ghost_winner.mutable_k_anon_join_candidates()));
+        dispatch_request->id, ghost_winner.mutable_k_anon_join_candidates());
 
     dispatch_request->metadata = shared_context;
     dispatch_request->tags[kRomaTimeoutTag] = roma_timeout_duration_;
@@ -589,17 +589,18 @@ void ScoreAdsReactor::BuildScoreAdRequestForComponentWinner(
   switch (auction_result.ad_type()) {
     case AdType::AD_TYPE_PROTECTED_AUDIENCE_AD: {
       auto [unused_it, inserted] = ad_data_.try_emplace(
-          dispatch_request->id, MapAuctionResultToAdWithBidMetadata(
-                                    auction_result, /*k_anon_status=*/true));
+          dispatch_request->id,
+          OwnOnArena(MapAuctionResultToAdWithBidMetadata(
+              auction_result, /*k_anon_status=*/true)));
       insertion_success = inserted;
       break;
     }
     case AdType::AD_TYPE_PROTECTED_APP_SIGNALS_AD: {
       auto [unused_it, inserted] = protected_app_signals_ad_data_.try_emplace(
           dispatch_request->id,
-          MapAuctionResultToProtectedAppSignalsAdWithBidMetadata(
+          OwnOnArena(MapAuctionResultToProtectedAppSignalsAdWithBidMetadata(
               auction_result,
-              /*k_anon_status=*/true));
+              /*k_anon_status=*/true)));
       insertion_success = inserted;
       break;
     }
@@ -627,7 +628,7 @@ void ScoreAdsReactor::BuildScoreAdRequestForComponentWinner(
 
   ad_k_anon_join_cand_.try_emplace(
       dispatch_request->id,
-      std::move(*auction_result.mutable_k_anon_winner_join_candidates()));
+      auction_result.mutable_k_anon_winner_join_candidates());
 
   dispatch_request->metadata = shared_context;
   dispatch_request->tags[kRomaTimeoutTag] = roma_timeout_duration_;
@@ -694,7 +695,9 @@ void ScoreAdsReactor::PopulateProtectedAudienceDispatchRequests(
     return;
   }
   while (!ads.empty()) {
-    std::unique_ptr<AdWithBidMetadata> ad(ads.ReleaseLast());
+    // The ads are on the request arena, which keeps owning the released ad.
+    // ReleaseLast() would return a heap copy of it instead.
+    AdWithBidMetadata* ad = ads.UnsafeArenaReleaseLast();
     absl::string_view scoring_signals_str = kNullScoringSignalsJson;
     if (scoring_signals != nullptr) {
       auto scoring_signals_it = scoring_signals->find(ad->render());
@@ -743,7 +746,7 @@ void ScoreAdsReactor::PopulateProtectedAudienceDispatchRequests(
       continue;
     }
     auto [unused_it, inserted] =
-        ad_data_.emplace(dispatch_request->id, std::move(ad));
+        ad_data_.emplace(dispatch_request->id, ad);
     if (!inserted) {
       PS_VLOG(kNoisyWarn, log_context_)
           << "Protected Audience ScoreAd Request id "
@@ -776,8 +779,9 @@ void ScoreAdsReactor::MayPopulateProtectedAppSignalsDispatchRequests(
     return;
   }
   while (!protected_app_signals_ad_bids.empty()) {
-    std::unique_ptr<ProtectedAppSignalsAdWithBidMetadata> pas_ad_with_bid(
-        protected_app_signals_ad_bids.ReleaseLast());
+    // Owned by the request arena, as the ads above.
+    ProtectedAppSignalsAdWithBidMetadata* pas_ad_with_bid =
+        protected_app_signals_ad_bids.UnsafeArenaReleaseLast();
     absl::string_view scoring_signals_str = kNullScoringSignalsJson;
     if (scoring_signals != nullptr) {
       auto scoring_signals_it =
@@ -817,7 +821,7 @@ void ScoreAdsReactor::MayPopulateProtectedAppSignalsDispatchRequests(
     }
 
     auto [unused_it, inserted] = protected_app_signals_ad_data_.emplace(
-        dispatch_request->id, std::move(pas_ad_with_bid));
+        dispatch_request->id, pas_ad_with_bid);
     if (!inserted) {
       PS_VLOG(kNoisyWarn, log_context_)
           << "ProtectedAppSignals ScoreAd Request id conflict detected: "
@@ -1253,13 +1257,13 @@ void ScoreAdsReactor::FindScoredAdType(
     ProtectedAppSignalsAdWithBidMetadata**
         protected_app_signals_ad_with_bid_metadata) {
   if (auto ad_it = ad_data_.find(response_id); ad_it != ad_data_.end()) {
-    *ad_with_bid_metadata = ad_it->second.get();
+    *ad_with_bid_metadata = ad_it->second;
   } else if (auto protected_app_signals_ad_it =
                  protected_app_signals_ad_data_.find(response_id);
              protected_app_signals_ad_it !=
              protected_app_signals_ad_data_.end()) {
     *protected_app_signals_ad_with_bid_metadata =
-        protected_app_signals_ad_it->second.get();
+        protected_app_signals_ad_it->second;
   }
 }
 
@@ -1283,8 +1287,8 @@ void ScoreAdsReactor::MayAddKAnonJoinCandidate(
   PS_VLOG(5, log_context_) << __func__
                            << ": Found k-anon join candidate for request_id: "
                            << request_id << ":\n"
-                           << it->second.DebugString();
-  *ad_score.mutable_k_anon_join_candidate() = std::move(it->second);
+                           << it->second->DebugString();
+  *ad_score.mutable_k_anon_join_candidate() = std::move(*it->second);
 }
 
 std::vector<ScoredAdData> ScoreAdsReactor::CollectValidRomaResponses(
@@ -1580,7 +1584,14 @@ void ScoreAdsReactor::PopulateRelevantFieldsInResponse(
   auto& ad_score = parsed_ad.ad_score;
   if (ad) {
     ad_score.set_render(ad->render());
-    ad_score.mutable_component_renders()->Swap(ad->mutable_ad_components());
+    // The ad is on the request arena, so swapping its field with the one of the
+    // heap ad_score would copy it. Moving the strings doesn't copy them.
+    auto& component_renders = *ad_score.mutable_component_renders();
+    component_renders.Clear();
+    component_renders.Reserve(ad->ad_components_size());
+    for (std::string& ad_component : *ad->mutable_ad_components()) {
+      component_renders.Add(std::move(ad_component));
+    }
   } else {
     ad_score.set_render(protected_app_signals_ad_with_bid->render());
   }
@@ -153,6 +153,14 @@ class ScoreAdsReactor
       ScoreAdsRequest::ScoreAdsRawRequest::ProtectedAppSignalsAdWithBidMetadata;
   using OptionalAdRejectionReason =
       std::optional<ScoreAdsResponse::AdScore::AdRejectionReason>;
+  // Hands `message` over to arena_, which frees it along with the request.
+  template <typename T>
+  T* OwnOnArena(std::unique_ptr<T> message) {
+    T* owned = message.release();
+    arena_.Own(owned);
+    return owned;
+  }
+
   // Finds the ad type of the scored ad and set it. After the function call,
   // expect one of the input pointers to be populated.
   void FindScoredAdType(absl::string_view response_id,
@@ -444,12 +452,11 @@ class ScoreAdsReactor
   V8DispatchClient& dispatcher_;
 
   // The key is the id of the DispatchRequest, and the value is the ad
-  // used to create the dispatch request. This map is used to amend each ad's
-  // DispatchResponse with more data which is then passed into the final
-  // ScoreAdsResponse.
-  absl::flat_hash_map<
-      std::string,
-      std::unique_ptr<ScoreAdsRequest::ScoreAdsRawRequest::AdWithBidMetadata>>
+  // used to create the dispatch request, owned by arena_. This map is used to
+  // amend each ad's DispatchResponse with more data which is then passed into
+  // the final ScoreAdsResponse.
+  absl::flat_hash_map<std::string,
+                      ScoreAdsRequest::ScoreAdsRawRequest::AdWithBidMetadata*>
       ad_data_;
 
   // The key is the id of the DispatchRequest, and the value is the seller
@@ -458,17 +465,17 @@ class ScoreAdsReactor
   absl::flat_hash_map<std::string, std::string> component_ad_seller_;
 
   // The key is the id of the DispatchRequest and the value is the k-anon join
-  // candidate belonging to the scoring dispatch request. This map is used
-  // during top-level multi seller auction.
-  absl::flat_hash_map<std::string, KAnonJoinCandidate> ad_k_anon_join_cand_;
+  // candidate belonging to the scoring dispatch request, owned by raw_request_.
+  // This map is used during top-level multi seller auction.
+  absl::flat_hash_map<std::string, KAnonJoinCandidate*> ad_k_anon_join_cand_;
 
   // Map of dispatch id to component level reporting data in a component auction
   // result.
   absl::flat_hash_map<std::string, ComponentReportingDataInAuctionResult>
       component_level_reporting_data_;
 
-  absl::flat_hash_map<std::string,
-                      std::unique_ptr<ProtectedAppSignalsAdWithBidMetadata>>
+  // Same as ad_data_, for protected app signals ads.
+  absl::flat_hash_map<std::string, ProtectedAppSignalsAdWithBidMetadata*>
       protected_app_signals_ad_data_;
   std::unique_ptr<ScoreAdsBenchmarkingLogger> benchmarking_logger_;
   const AsyncReporter& async_reporter_;
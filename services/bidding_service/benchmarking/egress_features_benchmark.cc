@@ -0,0 +1,235 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks the egress features pipeline, from the parsed schema and the
+// egress payload returned by generateBid to the base64 encoded bytes.
+//
+// Run the benchmark as follows:
+// builders/tools/bazel-debian run --dynamic_mode=off -c opt --copt=-gmlt \
+//   --copt=-fno-omit-frame-pointer --fission=yes --strip=never \
+//   services/bidding_service/benchmarking:egress_features_benchmark -- \
+//   --benchmark_time_unit=us --benchmark_repetitions=10
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+#include "rapidjson/document.h"
+#include "services/bidding_service/egress_features/egress_feature.h"
+#include "services/bidding_service/egress_features/egress_feature_plan.h"
+#include "services/bidding_service/egress_features/feature_factory.h"
+#include "services/bidding_service/utils/bit_writer.h"
+#include "services/common/util/json_util.h"
+#include "src/util/status_macro/status_macros.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+constexpr int kBucketSize = 16;
+constexpr char kHeaderByte = 0x20;
+
+// Every group adds one feature of each type (37 bits in total).
+constexpr absl::string_view kSchemaGroup = R"JSON(
+    {"name": "boolean-feature"},
+    {"name": "unsigned-integer-feature", "size": 8},
+    {"name": "signed-integer-feature", "size": 8},
+    {"name": "bucket-feature", "size": 16},
+    {"name": "histogram-feature", "size": 2, "value": [
+      {"name": "unsigned-integer-feature", "size": 4},
+      {"name": "signed-integer-feature", "size": 4}]})JSON";
+
+std::string RepeatGroups(int num_groups,
+                         const std::function<void(std::string&)>& append) {
+  std::string out;
+  for (int i = 0; i < num_groups; ++i) {
+    if (i > 0) {
+      out.push_back(',');
+    }
+    append(out);
+  }
+  return out;
+}
+
+std::string CreateSchema(int num_groups) {
+  return absl::StrCat(R"({"features": [)",
+                      RepeatGroups(num_groups,
+                                   [](std::string& out) {
+                                     absl::StrAppend(&out, kSchemaGroup);
+                                   }),
+                      "]}");
+}
+
+std::vector<std::unique_ptr<EgressFeature>> CreateSchemaFeatures(
+    int num_groups) {
+  auto schema_doc = ParseJsonString(CreateSchema(num_groups));
+  CHECK_OK(schema_doc);
+  auto feature_array = GetArrayMember(*schema_doc, "features");
+  CHECK_OK(feature_array);
+  std::vector<std::unique_ptr<EgressFeature>> features;
+  for (rapidjson::Value& feat : *feature_array) {
+    std::string name = feat["name"].GetString();
+    const uint32_t size = feat.HasMember("size") ? feat["size"].GetUint() : 1;
+    auto shared_schema = std::make_shared<rapidjson::Document>();
+    shared_schema->CopyFrom(feat, shared_schema->GetAllocator());
+    auto feature = CreateEgressFeature(name, size, std::move(shared_schema));
+    CHECK_OK(feature);
+    features.push_back(*std::move(feature));
+  }
+  return features;
+}
+
+// Payload with the features in the same order as the schema.
+std::string CreatePayload(int num_groups) {
+  std::string bucket = RepeatGroups(kBucketSize, [](std::string& out) {
+    absl::StrAppend(&out, R"({"value": true})");
+  });
+  return absl::StrCat(
+      R"({"features": [)", RepeatGroups(num_groups, [&](std::string& out) {
+        absl::StrAppend(
+            &out, R"({"name": "boolean-feature", "value": true},)",
+            R"({"name": "unsigned-integer-feature", "value": 200},)",
+            R"({"name": "signed-integer-feature", "value": -100},)",
+            R"({"name": "bucket-feature", "value": [)", bucket, "]},",
+            R"({"name": "histogram-feature", "value": [)",
+            R"({"name": "unsigned-integer-feature", "value": 9},)",
+            R"({"name": "signed-integer-feature", "value": -5}]})");
+      }),
+      "]}");
+}
+
+absl::StatusOr<std::vector<std::unique_ptr<EgressFeature>>> PopulateFeatures(
+    const std::vector<std::unique_ptr<EgressFeature>>& schema_features,
+    absl::string_view payload, uint32_t& total_size) {
+  std::vector<std::unique_ptr<EgressFeature>> features;
+  features.reserve(schema_features.size());
+  total_size = 0;
+  for (const auto& feature : schema_features) {
+    PS_ASSIGN_OR_RETURN(auto copy, feature->Copy());
+    total_size += copy->Size();
+    features.push_back(std::move(copy));
+  }
+  PS_ASSIGN_OR_RETURN(auto payload_doc, ParseJsonString(payload));
+  PS_ASSIGN_OR_RETURN(auto feature_array,
+                      GetArrayMember(payload_doc, "features"));
+  int idx = 0;
+  for (rapidjson::Value& feat : feature_array) {
+    PS_RETURN_IF_ERROR(features[idx++]->SetValue(std::move(feat)));
+  }
+  return features;
+}
+
+// Serializes the features by writing them straight into one BitWriter.
+absl::StatusOr<std::string> SerializeWithBitWriter(
+    const std::vector<std::unique_ptr<EgressFeature>>& features,
+    uint32_t total_size) {
+  BitWriter writer(total_size);
+  for (const auto& feature : features) {
+    PS_RETURN_IF_ERROR(feature->SerializeInto(writer));
+  }
+  std::string bytes;
+  bytes.reserve((total_size + 7) / 8 + 1);
+  writer.AppendBytes(bytes);
+  bytes.push_back(kHeaderByte);
+  return absl::Base64Escape(bytes);
+}
+
+// Serializes every feature into its own bit vector and copies the bits one
+// at a time into the byte array, as the features were serialized before
+// BitWriter.
+absl::StatusOr<std::string> SerializeWithBitVectors(
+    const std::vector<std::unique_ptr<EgressFeature>>& features,
+    uint32_t total_size) {
+  std::vector<uint8_t> bytes_array((total_size + 7) / 8, 0);
+  int bytes_array_idx = bytes_array.size() - 1;
+  int bit_position = 0;
+  for (const auto& feature : features) {
+    PS_ASSIGN_OR_RETURN(std::vector<bool> bits, feature->Serialize());
+    for (auto it = bits.rbegin(); it != bits.rend(); ++it) {
+      if (bit_position > 0 && bit_position % 8 == 0) {
+        bit_position = 0;
+        --bytes_array_idx;
+      }
+      if (*it) {
+        bytes_array[bytes_array_idx] |= (1 << bit_position);
+      }
+      ++bit_position;
+    }
+  }
+  bytes_array.push_back(kHeaderByte);
+  return absl::Base64Escape(
+      std::string(bytes_array.begin(), bytes_array.end()));
+}
+
+template <auto kSerialize>
+static void BM_EgressFeaturesToBytes(benchmark::State& state) {
+  const int num_groups = state.range(0);
+  const auto schema_features = CreateSchemaFeatures(num_groups);
+  const std::string payload = CreatePayload(num_groups);
+  for (auto _ : state) {
+    uint32_t total_size = 0;
+    auto features = PopulateFeatures(schema_features, payload, total_size);
+    CHECK_OK(features);
+    auto serialized = kSerialize(*features, total_size);
+    CHECK_OK(serialized);
+    benchmark::DoNotOptimize(serialized);
+  }
+  state.SetItemsProcessed(state.iterations() * schema_features.size());
+}
+
+BENCHMARK_TEMPLATE(BM_EgressFeaturesToBytes, SerializeWithBitVectors)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(64);
+BENCHMARK_TEMPLATE(BM_EgressFeaturesToBytes, SerializeWithBitWriter)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(64);
+
+// Applies the payload to a schema compiled up front, without copying any
+// features per iteration.
+static void BM_EgressFeaturePlanToBytes(benchmark::State& state) {
+  const int num_groups = state.range(0);
+  auto schema_doc = ParseJsonString(CreateSchema(num_groups));
+  CHECK_OK(schema_doc);
+  auto plan = EgressFeaturePlan::Compile(*schema_doc);
+  CHECK_OK(plan);
+  const std::string payload = CreatePayload(num_groups);
+  for (auto _ : state) {
+    auto payload_doc = ParseJsonString(payload);
+    CHECK_OK(payload_doc);
+    BitWriter writer(plan->total_bits());
+    CHECK_OK(plan->Apply(*payload_doc, writer));
+    std::string bytes;
+    bytes.reserve((plan->total_bits() + 7) / 8 + 1);
+    writer.AppendBytes(bytes);
+    bytes.push_back(kHeaderByte);
+    auto serialized = absl::Base64Escape(bytes);
+    benchmark::DoNotOptimize(serialized);
+  }
+  state.SetItemsProcessed(state.iterations() * plan->num_features());
+}
+
+BENCHMARK(BM_EgressFeaturePlanToBytes)->Arg(1)->Arg(8)->Arg(64);
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -18,12 +18,17 @@
 //   services/bidding_service/benchmarking:generate_bids_reactor_benchmarks -- \
 //   --benchmark_time_unit=us --benchmark_repetitions=10
 
+#include "absl/strings/str_format.h"
 #include "benchmark/benchmark.h"
+#include "rapidjson/document.h"
 #include "services/bidding_service/benchmarking/bidding_no_op_logger.h"
 #include "services/bidding_service/benchmarking/generate_bids_reactor_benchmarks_util.h"
 #include "services/bidding_service/generate_bids_reactor.h"
+#include "services/bidding_service/utils/interest_group_serializer.h"
 #include "services/common/test/mocks.h"
 #include "services/common/test/utils/test_init.h"
+#include "services/common/util/json_util.h"
+#include "src/util/status_macro/status_macros.h"
 
 namespace privacy_sandbox::bidding_auction_servers {
 
@@ -94,10 +99,112 @@ static void BM_ProtectedAudience(benchmark::State& state) {
   }
 }
 
+using IGForBidding =
+    GenerateBidsRequest::GenerateBidsRawRequest::InterestGroupForBidding;
+
+// Serializes the repeated field into its own JSON array, the way interest
+// groups were serialized before SerializeIG wrote the JSON directly. Kept as
+// the baseline for the IG serialization benchmarks.
+absl::StatusOr<std::string> SerializeRepeatedStringFieldWithRapidjson(
+    const google::protobuf::RepeatedPtrField<std::string>&
+        repeated_string_field) {
+  rapidjson::Document json_array;
+  json_array.SetArray();
+  for (const auto& item : repeated_string_field) {
+    json_array.PushBack(
+        rapidjson::Value(item.c_str(), json_array.GetAllocator()).Move(),
+        json_array.GetAllocator());
+  }
+  return SerializeJsonDoc(json_array);
+}
+
+absl::StatusOr<std::string> SerializeIGWithRapidjson(const IGForBidding& ig) {
+  std::string serialized_ig =
+      absl::StrFormat(R"JSON({"name":"%s")JSON", ig.name());
+  if (!ig.trusted_bidding_signals_keys().empty()) {
+    PS_ASSIGN_OR_RETURN(std::string keys,
+                        SerializeRepeatedStringFieldWithRapidjson(
+                            ig.trusted_bidding_signals_keys()));
+    absl::StrAppend(
+        &serialized_ig,
+        absl::StrFormat(R"JSON(,"trustedBiddingSignalsKeys":%s)JSON", keys));
+  }
+  if (!ig.ad_render_ids().empty()) {
+    PS_ASSIGN_OR_RETURN(
+        std::string ids,
+        SerializeRepeatedStringFieldWithRapidjson(ig.ad_render_ids()));
+    absl::StrAppend(&serialized_ig,
+                    absl::StrFormat(R"JSON(,"adRenderIds":%s)JSON", ids));
+  }
+  if (!ig.ad_component_render_ids().empty()) {
+    PS_ASSIGN_OR_RETURN(std::string ids,
+                        SerializeRepeatedStringFieldWithRapidjson(
+                            ig.ad_component_render_ids()));
+    absl::StrAppend(
+        &serialized_ig,
+        absl::StrFormat(R"JSON(,"adComponentRenderIds":%s)JSON", ids));
+  }
+  if (!ig.user_bidding_signals().empty()) {
+    absl::StrAppend(&serialized_ig,
+                    absl::StrFormat(R"JSON(,"userBiddingSignals":%s)JSON",
+                                    ig.user_bidding_signals()));
+  }
+  absl::StrAppend(&serialized_ig, "}");
+  return serialized_ig;
+}
+
+// Returns a large interest group with `state.range(0)` additional ad render
+// IDs.
+IGForBidding MakeInterestGroupForSerialization(
+    const benchmark::State& state) {
+  IGForBidding ig = MakeALargeInterestGroupForBiddingForLatencyTesting();
+  for (int i = 0; i < state.range(0); ++i) {
+    ig.add_ad_render_ids(absl::StrCat("additionalAdRenderId", i));
+  }
+  return ig;
+}
+
+static void BM_SerializeIG_Rapidjson(benchmark::State& state) {
+  IGForBidding ig = MakeInterestGroupForSerialization(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SerializeIGWithRapidjson(ig));
+  }
+}
+
+static void BM_SerializeIG_DirectWriter(benchmark::State& state) {
+  IGForBidding ig = MakeInterestGroupForSerialization(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SerializeIG(ig));
+  }
+}
+
+static void BM_SerializeIG_DirectWriterReusedBuffer(benchmark::State& state) {
+  IGForBidding ig = MakeInterestGroupForSerialization(state);
+  std::string buffer;
+  for (auto _ : state) {
+    buffer.clear();
+    AppendSerializedIG(ig, buffer);
+    benchmark::DoNotOptimize(buffer);
+  }
+}
+
 }  // namespace privacy_sandbox::bidding_auction_servers
 
 // Register the function as a benchmark
 BENCHMARK(privacy_sandbox::bidding_auction_servers::BM_ProtectedAudience);
+BENCHMARK(privacy_sandbox::bidding_auction_servers::BM_SerializeIG_Rapidjson)
+    ->Arg(0)
+    ->Arg(100)
+    ->Arg(1000);
+BENCHMARK(privacy_sandbox::bidding_auction_servers::BM_SerializeIG_DirectWriter)
+    ->Arg(0)
+    ->Arg(100)
+    ->Arg(1000);
+BENCHMARK(privacy_sandbox::bidding_auction_servers::
+              BM_SerializeIG_DirectWriterReusedBuffer)
+    ->Arg(0)
+    ->Arg(100)
+    ->Arg(1000);
 
 // Run the benchmark
 BENCHMARK_MAIN();
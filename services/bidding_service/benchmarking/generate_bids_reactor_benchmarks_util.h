@@ -42,6 +42,12 @@ class CryptoClientStub : public CryptoClientWrapperInterface {
       : raw_request_(*raw_request) {}
   virtual ~CryptoClientStub() = default;
 
+  // Keeps the overloads that take ownership of their payload visible, which
+  // forward to the ones below.
+  using CryptoClientWrapperInterface::AeadDecrypt;
+  using CryptoClientWrapperInterface::AeadEncrypt;
+  using CryptoClientWrapperInterface::HpkeEncrypt;
+
   // Decrypts a ciphertext using HPKE.
   absl::StatusOr<google::cmrt::sdk::crypto_service::v1::HpkeDecryptResponse>
   HpkeDecrypt(const server_common::PrivateKey& private_key,
@@ -143,6 +143,10 @@ ABSL_FLAG(
 ABSL_FLAG(std::optional<bool>, enable_fdo_attestation, true,
           "If true, fDO destinations given by AdTechs are attested against API "
           "enrollment list.");
+ABSL_FLAG(std::optional<int>, generate_bid_batch_size, 1,
+          "Maximum number of interest groups passed to generateBid in a single "
+          "UDF invocation. Interest groups are dispatched one per invocation "
+          "if this is 1.");
 
 namespace privacy_sandbox::bidding_auction_servers {
 
@@ -240,6 +244,12 @@ absl::StatusOr<TrustedServersConfigClient> GetConfigClient(
                         INFERENCE_MODEL_EXECUTION_TIMEOUT_MS);
   config_client.SetFlag(FLAGS_inference_model_paths_request_timeout_ms,
                         INFERENCE_MODEL_PATHS_REQUEST_TIMEOUT_MS);
+  config_client.SetFlag(FLAGS_inference_max_batch_size,
+                        INFERENCE_MAX_BATCH_SIZE);
+  config_client.SetFlag(FLAGS_inference_batch_timeout_us,
+                        INFERENCE_BATCH_TIMEOUT_US);
+  config_client.SetFlag(FLAGS_inference_model_shared_dir,
+                        INFERENCE_MODEL_SHARED_DIR);
   config_client.SetFlag(
       FLAGS_bidding_tcmalloc_background_release_rate_bytes_per_second,
       BIDDING_TCMALLOC_BACKGROUND_RELEASE_RATE_BYTES_PER_SECOND);
@@ -254,6 +264,7 @@ absl::StatusOr<TrustedServersConfigClient> GetConfigClient(
   config_client.SetFlag(FLAGS_curl_bidding_work_queue_length,
                         CURL_BIDDING_WORK_QUEUE_LENGTH);
   config_client.SetFlag(FLAGS_enable_fdo_attestation, ENABLE_FDO_ATTESTATION);
+  config_client.SetFlag(FLAGS_generate_bid_batch_size, GENERATE_BID_BATCH_SIZE);
 
   PS_RETURN_IF_ERROR(
       MaybeInitConfigClient(absl::GetFlag(FLAGS_init_config_client),
@@ -360,6 +371,15 @@ DispatchConfig GetV8DispatchConfig(
           &FLAGS_inference_model_paths_request_timeout_ms,
           GetInt64ParameterSafe(config_client,
                                 INFERENCE_MODEL_PATHS_REQUEST_TIMEOUT_MS));
+      absl::SetFlag(
+          &FLAGS_inference_max_batch_size,
+          GetInt64ParameterSafe(config_client, INFERENCE_MAX_BATCH_SIZE));
+      absl::SetFlag(
+          &FLAGS_inference_batch_timeout_us,
+          GetInt64ParameterSafe(config_client, INFERENCE_BATCH_TIMEOUT_US));
+      absl::SetFlag(
+          &FLAGS_inference_model_shared_dir,
+          GetStringParameterSafe(config_client, INFERENCE_MODEL_SHARED_DIR));
       absl::SetFlag(
           &FLAGS_inference_enable_proto_parsing,
           config_client.GetBooleanParameter(INFERENCE_ENABLE_PROTO_PARSING));
@@ -576,7 +596,8 @@ absl::Status RunServer() {
                                           std::move(blob_storage_client)),
             inference::CreateInferenceStub(), executor.get(),
             absl::Milliseconds(config_client.GetInt64Parameter(
-                INFERENCE_MODEL_FETCH_PERIOD_MS)));
+                INFERENCE_MODEL_FETCH_PERIOD_MS)),
+            GetStringParameterSafe(config_client, INFERENCE_MODEL_SHARED_DIR));
         PS_RETURN_IF_ERROR(model_fetcher->Start())
             << "Failed to start periodic model fetcher.";
       } else {
@@ -653,7 +674,9 @@ absl::Status RunServer() {
       .enable_temporary_unlimited_egress = enable_temporary_unlimited_egress,
       .enable_byob_batching = byob_batching_config.ByteSizeLong() > 0,
       .byob_batch_start_timeout =
-          absl::Milliseconds(byob_batching_config.batch_start_timeout_ms())};
+          absl::Milliseconds(byob_batching_config.batch_start_timeout_ms()),
+      .generate_bid_batch_size =
+          config_client.GetIntParameter(GENERATE_BID_BATCH_SIZE)};
 
   PS_RETURN_IF_ERROR(udf_fetcher->ConfigureRuntimeDefaults(runtime_config))
       << "Could not init runtime defaults for udf fetching.";
@@ -355,6 +355,68 @@ constexpr absl::string_view js_code_throws_exception_with_debug_urls =
     }
   )JS_CODE";
 
+// Fails for all but the last of the interest groups of a batch of 5, each in
+// a way generateBidEntryFunction doesn't catch.
+constexpr absl::string_view js_code_fails_in_batch_template = R"JS_CODE(
+    var num_calls = 0;
+
+    function generateBid(interest_group,
+                         auction_signals,
+                         buyer_signals,
+                         trusted_bidding_signals,
+                         device_signals) {
+      num_calls++;
+      const render = "%s" + interest_group.adRenderIds[0];
+      switch (num_calls) {
+        case 1:
+          throw null;
+        case 2:
+          throw undefined;
+        case 3:
+          // JSON.stringify() can't serialize a BigInt...
+          return {render: render, bid: 1n, allowComponentAuction: false};
+        case 4: {
+          // ...nor a cyclic value.
+          const ad = {};
+          ad.self = ad;
+          return {render: render, ad: ad, bid: 1, allowComponentAuction: false};
+        }
+      }
+      return {
+        render: render,
+        ad: {"arbitraryMetadataField": 1},
+        bid: 1,
+        allowComponentAuction: false
+      };
+    }
+  )JS_CODE";
+
+// Bids the floor in the auction and buyer signals, which the first of the
+// interest groups of a batch changes after reading it.
+constexpr absl::string_view js_code_mutates_signals_in_batch_template =
+    R"JS_CODE(
+    var num_calls = 0;
+
+    function generateBid(interest_group,
+                         auction_signals,
+                         buyer_signals,
+                         trusted_bidding_signals,
+                         device_signals) {
+      num_calls++;
+      const bid = auction_signals.floor + buyer_signals.floor;
+      if (num_calls === 1) {
+        auction_signals.floor = 10;
+        buyer_signals.floor = 10;
+      }
+      return {
+        render: "%s" + interest_group.adRenderIds[0],
+        ad: {"arbitraryMetadataField": 1},
+        bid: bid,
+        allowComponentAuction: false
+      };
+    }
+  )JS_CODE";
+
 constexpr absl::string_view js_code_with_logs_template = R"JS_CODE(
     function fibonacci(num) {
       if (num <= 1) return 1;
@@ -1118,6 +1180,9 @@ struct GenerateBidHelperConfig {
   bool enable_private_aggregate_reporting = false;
   int multi_bid_limit = kTestMultiBidLimit;
   int per_adtech_paapi_contributions_limit = 100;
+  int generate_bid_batch_size = 1;
+  std::string auction_signals = "";
+  std::string buyer_signals = "";
 };
 
 void GenerateBidCodeWrapperTestHelper(
@@ -1141,6 +1206,8 @@ void GenerateBidCodeWrapperTestHelper(
   raw_request->mutable_fdo_flags()->set_in_cooldown_or_lockout(
       test_config.in_cooldown_or_lockout);
   raw_request->set_multi_bid_limit(test_config.multi_bid_limit);
+  raw_request->set_auction_signals(test_config.auction_signals);
+  raw_request->set_buyer_signals(test_config.buyer_signals);
   if (test_config.enable_adtech_code_logging) {
     raw_request->mutable_consented_debug_config()->set_token(kTestConsentToken);
     raw_request->mutable_consented_debug_config()->set_is_consented(true);
@@ -1167,7 +1234,8 @@ void GenerateBidCodeWrapperTestHelper(
       .per_adtech_paapi_contributions_limit =
           test_config.per_adtech_paapi_contributions_limit,
       .debug_reporting_sampling_upper_bound =
-          test_config.debug_reporting_sampling_upper_bound};
+          test_config.debug_reporting_sampling_upper_bound,
+      .generate_bid_batch_size = test_config.generate_bid_batch_size};
   BiddingService service(GetProtectedAudienceV8ReactorFactory(client),
                          std::move(key_fetcher_manager),
                          std::move(crypto_client), std::move(runtime_config),
@@ -1413,6 +1481,48 @@ TEST_F(GenerateBidsReactorIntegrationTest, NoDebugUrlsOnScriptCrash) {
   EXPECT_EQ(raw_response.bids_size(), 0);
 }
 
+TEST_F(GenerateBidsReactorIntegrationTest,
+       KeepsBidsOfBatchWhenOtherInterestGroupsFail) {
+  for (bool enable_adtech_code_logging : {false, true}) {
+    GenerateBidsResponse response;
+    GenerateBidHelperConfig test_config = {
+        .enable_adtech_code_logging = enable_adtech_code_logging,
+        .desired_bid_count = 5,
+        .generate_bid_batch_size = 5};
+    GenerateBidCodeWrapperTestHelper(
+        &response,
+        absl::StrFormat(js_code_fails_in_batch_template,
+                        kAdRenderUrlPrefixForTest),
+        test_config);
+    GenerateBidsResponse::GenerateBidsRawResponse raw_response;
+    ASSERT_TRUE(raw_response.ParseFromString(response.response_ciphertext()));
+    // Only the bid of the last interest group is left.
+    EXPECT_EQ(raw_response.bids_size(), 1);
+  }
+}
+
+TEST_F(GenerateBidsReactorIntegrationTest,
+       DoesNotShareSignalChangesAcrossBatch) {
+  GenerateBidsResponse response;
+  GenerateBidHelperConfig test_config = {
+      .desired_bid_count = 5,
+      .generate_bid_batch_size = 5,
+      .auction_signals = R"JSON({"floor": 1})JSON",
+      .buyer_signals = R"JSON({"floor": 1})JSON"};
+  GenerateBidCodeWrapperTestHelper(
+      &response,
+      absl::StrFormat(js_code_mutates_signals_in_batch_template,
+                      kAdRenderUrlPrefixForTest),
+      test_config);
+  GenerateBidsResponse::GenerateBidsRawResponse raw_response;
+  ASSERT_TRUE(raw_response.ParseFromString(response.response_ciphertext()));
+  ASSERT_EQ(raw_response.bids_size(), 5);
+  // The interest groups after the first still see the original floors.
+  for (const auto& ad_with_bid : raw_response.bids()) {
+    EXPECT_EQ(ad_with_bid.bid(), 2);
+  }
+}
+
 TEST_F(GenerateBidsReactorIntegrationTest, HasNumericPAAPIBucketAndValue) {
   GenerateBidsResponse response;
   GenerateBidHelperConfig test_config = {
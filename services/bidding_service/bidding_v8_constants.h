@@ -25,6 +25,8 @@ namespace privacy_sandbox::bidding_auction_servers {
 
 inline constexpr char kDispatchHandlerFunctionNameWithCodeWrapper[] =
     "generateBidEntryFunction";
+inline constexpr char kBatchDispatchHandlerFunctionNameWithCodeWrapper[] =
+    "generateBidsBatchEntryFunction";
 inline constexpr char kDefaultEgressSchemaId[] = "default";
 inline constexpr char kProtectedAudienceGenerateBidBlobVersion[] = "v1";
 inline constexpr char kProtectedAppSignalsGenerateBidBlobVersion[] = "v2";
@@ -58,7 +60,9 @@ constexpr absl::string_view kEncodedProtectedAppSignalsHandler =
       })JS_CODE";
 
 // Params related to the UDF to use to generate bids for protected audience
-// interest groups.
+// interest groups. When a batch of interest groups is passed to the UDF,
+// kInterestGroup, kTrustedBiddingSignals and kDeviceSignals are JSON arrays
+// with one entry per interest group.
 enum class GenerateBidUdfArgs : std::uint8_t {
   kInterestGroup = 0,
   kAuctionSignals,
@@ -104,6 +108,8 @@ inline constexpr int ArgIndex(T arg) {
 
 inline constexpr char kUnexpectedNumberOfRomaResponses[] =
     "Unexpected count of roma responses received.";
+inline constexpr char kMalformedBatchedGenerateBidResponse[] =
+    "Malformed response received for a batch of interest groups.";
 inline constexpr char kDecodedProtectedAppSignalsNotFound[] =
     "Decoded protected signals were not found.";
 inline constexpr char kDecodedProtectedAppSignalsUnexpectedType[] =
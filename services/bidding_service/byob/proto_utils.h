@@ -15,15 +15,37 @@
 #ifndef SERVICES_BIDDING_SERVICE_BYOB_PROTO_UTILS_H_
 #define SERVICES_BIDDING_SERVICE_BYOB_PROTO_UTILS_H_
 
+#include <string>
 #include <utility>
 
 #include "absl/time/time.h"
 #include "api/bidding_auction_servers.pb.h"
 #include "api/udf/generate_bid_udf_interface.pb.h"
+#include "google/protobuf/message.h"
+#include "google/protobuf/repeated_ptr_field.h"
 #include "services/common/util/request_response_constants.h"
 
 namespace privacy_sandbox::bidding_auction_servers {
 
+// Moves the strings of `from` into `to`. Swapping the fields of messages on
+// different arenas (e.g. a heap bid request and an arena-allocated raw
+// request) would copy them instead.
+inline void MoveRepeatedStrings(
+    const google::protobuf::Message& to_message,
+    google::protobuf::RepeatedPtrField<std::string>& to,
+    const google::protobuf::Message& from_message,
+    google::protobuf::RepeatedPtrField<std::string>& from) {
+  if (to_message.GetArena() == from_message.GetArena()) {
+    to.Swap(&from);
+    return;
+  }
+  to.Clear();
+  to.Reserve(from.size());
+  for (std::string& value : from) {
+    to.Add(std::move(value));
+  }
+}
+
 inline void UpdateProtectedAudienceBidRequest(
     roma_service::GenerateProtectedAudienceBidRequest& bid_request,
     const GenerateBidsRequest::GenerateBidsRawRequest& raw_request,
@@ -33,12 +55,16 @@ inline void UpdateProtectedAudienceBidRequest(
   roma_service::ProtectedAudienceInterestGroup* interest_group =
       bid_request.mutable_interest_group();
   *interest_group->mutable_name() = std::move(*ig_for_bidding.mutable_name());
-  interest_group->mutable_trusted_bidding_signals_keys()->Swap(
-      ig_for_bidding.mutable_trusted_bidding_signals_keys());
-  interest_group->mutable_ad_render_ids()->Swap(
-      ig_for_bidding.mutable_ad_render_ids());
-  interest_group->mutable_ad_component_render_ids()->Swap(
-      ig_for_bidding.mutable_ad_component_render_ids());
+  MoveRepeatedStrings(*interest_group,
+                      *interest_group->mutable_trusted_bidding_signals_keys(),
+                      ig_for_bidding,
+                      *ig_for_bidding.mutable_trusted_bidding_signals_keys());
+  MoveRepeatedStrings(*interest_group, *interest_group->mutable_ad_render_ids(),
+                      ig_for_bidding, *ig_for_bidding.mutable_ad_render_ids());
+  MoveRepeatedStrings(*interest_group,
+                      *interest_group->mutable_ad_component_render_ids(),
+                      ig_for_bidding,
+                      *ig_for_bidding.mutable_ad_component_render_ids());
   *interest_group->mutable_user_bidding_signals() =
       std::move(*ig_for_bidding.mutable_user_bidding_signals());
 
@@ -65,11 +65,16 @@ std::string GetBuyerWrappedCode(
   }
   absl::string_view args =
       GetGenerateBidUdfArgs(buyer_code_wrapper_config.auction_type);
+  absl::string_view batch_entry_function = "";
+  if (buyer_code_wrapper_config.auction_type ==
+      AuctionType::kProtectedAudience) {
+    batch_entry_function = kBatchEntryFunction;
+  }
   return absl::StrCat(
       WasmBytesToJavascript(buyer_code_wrapper_config.ad_tech_wasm),
       absl::Substitute(kEntryFunction, args,
                        buyer_code_wrapper_config.auction_specific_setup),
-      ad_tech_js, private_aggregation_wrapper);
+      batch_entry_function, ad_tech_js, private_aggregation_wrapper);
 }
 
 std::string GetProtectedAppSignalsGenericBuyerWrappedCode(
@@ -37,6 +37,8 @@ struct BuyerCodeWrapperConfig {
 // - Generation of event level debug reporting
 // - Exporting console.logs from the AdTech execution.
 // - wasmHelper added to device_signals
+// - Generating bids for a batch of interest groups in a single invocation
+//   (Protected Audience only)
 std::string GetBuyerWrappedCode(
     absl::string_view ad_tech_js,
     const BuyerCodeWrapperConfig& buyer_code_wrapper_config);
@@ -152,6 +154,66 @@ inline constexpr absl::string_view kEntryFunction = R"JS_CODE(
     }
 )JS_CODE";
 
+// Batched entry point for Protected Audience, appended after kEntryFunction.
+// Runs generateBidEntryFunction for every interest group in the batch within
+// a single UDF invocation, so that the shared inputs are only parsed once.
+// The per interest group inputs (interest group, trusted bidding signals and
+// device signals) are passed as arrays and the result is an array with one
+// serialized generateBidEntryFunction output per interest group. An interest
+// group whose output can't be generated or serialized gets an output with no
+// bids, so that it doesn't fail the rest of the batch.
+inline constexpr absl::string_view kBatchEntryFunction = R"JS_CODE(
+    async function generateBidsBatchEntryFunction(interest_groups, auction_signals, buyer_signals, trusted_bidding_signals, device_signals, multiBidLimit, featureFlags){
+      // Each interest group gets its own copy of the auction and buyer signals, so that it doesn't see what the
+      // generateBid of an earlier interest group in the batch changed in them.
+      // Each interest group gets the output generateBidEntryFunction would have returned for it, as a JSON string.
+      const auction_signals_json = JSON.stringify(auction_signals);
+      const buyer_signals_json = JSON.stringify(buyer_signals);
+      const copySignals = (signals, signals_json) =>
+          (signals !== null && typeof signals === "object") ? JSON.parse(signals_json) : signals;
+      const paapicontributions = ps_response.paapicontributions;
+      const batch_response = [];
+      for (let i = 0; i < interest_groups.length; i++) {
+        ps_response = {
+          response: [],
+          logs: [],
+          errors: [],
+          warnings: []
+        };
+        if (paapicontributions) {
+          paapicontributions.length = 0;
+          ps_response.paapicontributions = paapicontributions;
+        }
+        try {
+          const response = await generateBidEntryFunction(interest_groups[i],
+              i === 0 ? auction_signals : copySignals(auction_signals, auction_signals_json),
+              i === 0 ? buyer_signals : copySignals(buyer_signals, buyer_signals_json),
+              trusted_bidding_signals[i], device_signals[i], multiBidLimit, featureFlags);
+          batch_response.push(JSON.stringify(response));
+        } catch (e) {
+          // Errors generateBidEntryFunction doesn't catch, e.g. a thrown null, or a response JSON.stringify
+          // rejects (BigInt or cyclic values), only drop the bids of this interest group.
+          let error_response = [];
+          if (featureFlags.enable_logging) {
+            error_response = {
+              response: [],
+              logs: ps_response.logs,
+              errors: ps_response.errors,
+              warnings: ps_response.warnings
+            };
+            try {
+              error_response.errors.push("[Error: " + String(e) + "]");
+            } catch {
+              error_response.errors.push("[Error: " + typeof e + "]");
+            }
+          }
+          batch_response.push(JSON.stringify(error_response));
+        }
+      }
+      return batch_response;
+    }
+)JS_CODE";
+
 // Wrapper Javascript over AdTech code.
 // This wrapper supports the features below:
 //- Exporting logs to Bidding Service using console.log
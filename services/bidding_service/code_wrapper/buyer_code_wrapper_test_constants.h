@@ -197,6 +197,56 @@ constexpr absl::string_view kExpectedGenerateBidCode_template = R"JS_CODE(
       return ps_response.response;
     }
 
+    async function generateBidsBatchEntryFunction(interest_groups, auction_signals, buyer_signals, trusted_bidding_signals, device_signals, multiBidLimit, featureFlags){
+      // Each interest group gets its own copy of the auction and buyer signals, so that it doesn't see what the
+      // generateBid of an earlier interest group in the batch changed in them.
+      // Each interest group gets the output generateBidEntryFunction would have returned for it, as a JSON string.
+      const auction_signals_json = JSON.stringify(auction_signals);
+      const buyer_signals_json = JSON.stringify(buyer_signals);
+      const copySignals = (signals, signals_json) =>
+          (signals !== null && typeof signals === "object") ? JSON.parse(signals_json) : signals;
+      const paapicontributions = ps_response.paapicontributions;
+      const batch_response = [];
+      for (let i = 0; i < interest_groups.length; i++) {
+        ps_response = {
+          response: [],
+          logs: [],
+          errors: [],
+          warnings: []
+        };
+        if (paapicontributions) {
+          paapicontributions.length = 0;
+          ps_response.paapicontributions = paapicontributions;
+        }
+        try {
+          const response = await generateBidEntryFunction(interest_groups[i],
+              i === 0 ? auction_signals : copySignals(auction_signals, auction_signals_json),
+              i === 0 ? buyer_signals : copySignals(buyer_signals, buyer_signals_json),
+              trusted_bidding_signals[i], device_signals[i], multiBidLimit, featureFlags);
+          batch_response.push(JSON.stringify(response));
+        } catch (e) {
+          // Errors generateBidEntryFunction doesn't catch, e.g. a thrown null, or a response JSON.stringify
+          // rejects (BigInt or cyclic values), only drop the bids of this interest group.
+          let error_response = [];
+          if (featureFlags.enable_logging) {
+            error_response = {
+              response: [],
+              logs: ps_response.logs,
+              errors: ps_response.errors,
+              warnings: ps_response.warnings
+            };
+            try {
+              error_response.errors.push("[Error: " + String(e) + "]");
+            } catch {
+              error_response.errors.push("[Error: " + typeof e + "]");
+            }
+          }
+          batch_response.push(JSON.stringify(error_response));
+        }
+      }
+      return batch_response;
+    }
+
     function fibonacci(num) {
       if (num <= 1) return 1;
       return fibonacci(num - 1) + fibonacci(num - 2);
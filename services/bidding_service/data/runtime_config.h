@@ -91,6 +91,11 @@ struct BiddingServiceRuntimeConfig {
 
   // The maximum duration to wait for a batch to start processing.
   absl::Duration byob_batch_start_timeout;
+
+  // Max number of interest groups passed to generateBid in one UDF
+  // invocation. Auction and buyer signals are parsed once per invocation.
+  // Such an invocation gets roma_timeout_duration per interest group.
+  int generate_bid_batch_size = 1;
 };
 
 }  // namespace privacy_sandbox::bidding_auction_servers
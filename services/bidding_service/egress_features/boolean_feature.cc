@@ -27,10 +27,11 @@ BooleanFeature::BooleanFeature(const BooleanFeature& other)
 
 absl::string_view BooleanFeature::Type() const { return "boolean-feature"; }
 
-absl::StatusOr<std::vector<bool>> BooleanFeature::Serialize() {
+absl::Status BooleanFeature::SerializeInto(BitWriter& writer) {
   if (!is_value_set_) {
     PS_VLOG(5) << "Boolean Feature value has not been set, returning a default";
-    return std::vector<bool>(1, false);
+    writer.WriteBit(false);
+    return absl::OkStatus();
   }
   std::optional<bool> value;
   PS_ASSIGN_IF_PRESENT(value, value_, "value", Bool);
@@ -38,7 +39,8 @@ absl::StatusOr<std::vector<bool>> BooleanFeature::Serialize() {
     return absl::InvalidArgumentError(
         "Value in the egress payload didn't have a bool");
   }
-  return std::vector<bool>{*value};
+  writer.WriteBit(*value);
+  return absl::OkStatus();
 }
 
 absl::StatusOr<std::unique_ptr<EgressFeature>> BooleanFeature::Copy() const {
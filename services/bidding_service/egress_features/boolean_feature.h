@@ -30,7 +30,7 @@ class BooleanFeature : public EgressFeature {
   explicit BooleanFeature(uint32_t size);
   explicit BooleanFeature(const BooleanFeature& other);
   absl::string_view Type() const override;
-  absl::StatusOr<std::vector<bool>> Serialize() override;
+  absl::Status SerializeInto(BitWriter& writer) override;
   absl::StatusOr<std::unique_ptr<EgressFeature>> Copy() const override;
   ~BooleanFeature() override = default;
 };
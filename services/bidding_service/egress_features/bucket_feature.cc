@@ -35,10 +35,11 @@ absl::StatusOr<std::unique_ptr<EgressFeature>> BucketFeature::Copy() const {
 
 absl::string_view BucketFeature::Type() const { return "bucket-feature"; }
 
-absl::StatusOr<std::vector<bool>> BucketFeature::Serialize() {
+absl::Status BucketFeature::SerializeInto(BitWriter& writer) {
   if (!is_value_set_) {
     PS_VLOG(5) << "Bucket Feature value has not been set, returning default";
-    return std::vector<bool>(size_, false);
+    writer.WriteZeros(size_);
+    return absl::OkStatus();
   }
   PS_ASSIGN_OR_RETURN(auto buckets, GetArrayMember(value_, "value"));
   if (buckets.Size() != size_) {
@@ -46,26 +47,20 @@ absl::StatusOr<std::vector<bool>> BucketFeature::Serialize() {
         absl::StrCat("Number of buckets in feature payload (", buckets.Size(),
                      ") doesn't match schema (", size_, ")"));
   }
-  std::vector<bool> serialized_feat;
-  serialized_feat.reserve(buckets.Size());
-  int idx = size_ - 1;
+  // The first bucket goes to the least significant bit.
+  int idx = 0;
   for (rapidjson::Value& feat : buckets) {
     if (!feat.IsObject()) {
-      return absl::InvalidArgumentError(
-          absl::StrCat("Feature at index ", size_ - (idx + 1),
-                       " is not an object, expected object"));
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Feature at index ", idx, " is not an object, expected object"));
     }
     BooleanFeature bool_feat(/*size=*/1);
     PS_RETURN_IF_ERROR(bool_feat.SetValue(std::move(feat),
                                           /*verify_type=*/false));
-    PS_ASSIGN_OR_RETURN(auto serialized_bool, bool_feat.Serialize());
-    DCHECK_EQ(serialized_bool.size(), 1)
-        << "Unexpected boolean bit vector size";
-    serialized_feat.emplace_back(serialized_bool[0]);
-    --idx;
+    PS_RETURN_IF_ERROR(bool_feat.SerializeInto(writer));
+    ++idx;
   }
-  std::reverse(serialized_feat.begin(), serialized_feat.end());
-  return serialized_feat;
+  return absl::OkStatus();
 }
 
 }  // namespace privacy_sandbox::bidding_auction_servers
@@ -21,6 +21,7 @@
 #include "rapidjson/document.h"
 #include "services/common/util/json_util.h"
 #include "src/logger/request_context_impl.h"
+#include "src/util/status_macro/status_macros.h"
 
 namespace privacy_sandbox::bidding_auction_servers {
 
@@ -54,4 +55,10 @@ absl::Status EgressFeature::SetValue(rapidjson::Value value, bool verify_type) {
   return absl::OkStatus();
 }
 
+absl::StatusOr<std::vector<bool>> EgressFeature::Serialize() {
+  BitWriter writer(Size());
+  PS_RETURN_IF_ERROR(SerializeInto(writer));
+  return writer.ToBits();
+}
+
 }  // namespace privacy_sandbox::bidding_auction_servers
@@ -23,6 +23,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "include/rapidjson/document.h"
+#include "services/bidding_service/utils/bit_writer.h"
 
 namespace privacy_sandbox::bidding_auction_servers {
 
@@ -48,8 +49,12 @@ class EgressFeature {
   virtual absl::Status SetValue(rapidjson::Value value,
                                 bool verify_type = true);
 
-  // Converts the egress feature into a byte-string.
-  virtual absl::StatusOr<std::vector<bool>> Serialize() = 0;
+  // Appends the Size() bits of the egress feature to `writer`.
+  virtual absl::Status SerializeInto(BitWriter& writer) = 0;
+
+  // Converts the egress feature into a bit vector, most significant bit
+  // first.
+  absl::StatusOr<std::vector<bool>> Serialize();
 
   // Returns the copy of the derived egress feature.
   virtual absl::StatusOr<std::unique_ptr<EgressFeature>> Copy() const = 0;
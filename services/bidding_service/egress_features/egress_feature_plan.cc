@@ -0,0 +1,304 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/bidding_service/egress_features/egress_feature_plan.h"
+
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "services/common/util/json_util.h"
+#include "src/logger/request_context_impl.h"
+#include "src/util/status_macro/status_macros.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+namespace {
+
+using FeatureKind = EgressFeaturePlan::FeatureKind;
+using Step = EgressFeaturePlan::Step;
+
+inline constexpr absl::string_view kBooleanFeatureTag = "boolean-feature";
+inline constexpr absl::string_view kSignedIntFeatureTag =
+    "signed-integer-feature";
+inline constexpr absl::string_view kUnsignedIntFeatureTag =
+    "unsigned-integer-feature";
+inline constexpr absl::string_view kBucketFeatureTag = "bucket-feature";
+inline constexpr absl::string_view kHistogramFeatureTag = "histogram-feature";
+
+absl::string_view FeatureTag(FeatureKind kind) {
+  switch (kind) {
+    case FeatureKind::kBoolean:
+      return kBooleanFeatureTag;
+    case FeatureKind::kSignedInt:
+      return kSignedIntFeatureTag;
+    case FeatureKind::kUnsignedInt:
+      return kUnsignedIntFeatureTag;
+    case FeatureKind::kBucket:
+      return kBucketFeatureTag;
+    case FeatureKind::kHistogram:
+      return kHistogramFeatureTag;
+  }
+  return "";
+}
+
+absl::StatusOr<FeatureKind> GetFeatureKind(absl::string_view name) {
+  for (FeatureKind kind :
+       {FeatureKind::kBoolean, FeatureKind::kSignedInt,
+        FeatureKind::kUnsignedInt, FeatureKind::kBucket,
+        FeatureKind::kHistogram}) {
+    if (name == FeatureTag(kind)) {
+      return kind;
+    }
+  }
+  std::string err = absl::StrCat("Unidentified feature type provided: ", name);
+  PS_VLOG(5) << err;
+  return absl::InvalidArgumentError(std::move(err));
+}
+
+// Creates the step for an integer feature of `width` bits along with the range
+// of values that can be represented in it.
+Step IntStep(FeatureKind kind, uint32_t width) {
+  Step step = {.kind = kind, .width = width};
+  if (kind == FeatureKind::kUnsignedInt) {
+    // For 3-bits unsigned int, the max positive number will be: 111 = 7
+    step.min_value = 0;
+    step.max_value = width >= 32 ? std::numeric_limits<uint32_t>::max()
+                                 : (int64_t{1} << width) - 1;
+  } else if (width == 0 || width > 32) {
+    // Payload values are 32 bit ints which always fit in wider features.
+    // Zero width signed features have never been bounds checked.
+    step.min_value = std::numeric_limits<int64_t>::min();
+    step.max_value = std::numeric_limits<int64_t>::max();
+  } else {
+    // For 3-bits signed int, the max positive number will be: 011 = 3
+    // and the max negative int will be 100 = -4
+    step.min_value = -(int64_t{1} << (width - 1));
+    step.max_value = (int64_t{1} << (width - 1)) - 1;
+  }
+  return step;
+}
+
+// Verifies that the name of the feature in the payload matches the schema.
+absl::Status VerifyType(const rapidjson::Value& feature, FeatureKind kind) {
+  absl::string_view observed_feat_type;
+  if (auto it = feature.FindMember("name");
+      it != feature.MemberEnd() && it->value.IsString()) {
+    observed_feat_type = absl::string_view(it->value.GetString(),
+                                           it->value.GetStringLength());
+  }
+  absl::string_view expected_feat_type = FeatureTag(kind);
+  if (observed_feat_type != expected_feat_type) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Type of the feature in payload '", observed_feat_type,
+                     "' doesn't match with the name in the schema: '",
+                     expected_feat_type, "' at the same index"));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status CheckBounds(const Step& step, int64_t value) {
+  if (value < step.min_value || value > step.max_value) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Out of bound error: ",
+        step.kind == FeatureKind::kSignedInt ? "Int" : "Uint",
+        " feature value: ", value, " can not be represented in ", step.width,
+        " bits allowed by the schema"));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::StatusOr<EgressFeaturePlan> EgressFeaturePlan::Compile(
+    const rapidjson::Value& schema) {
+  PS_ASSIGN_OR_RETURN(auto feature_array, GetArrayMember(schema, "features"));
+  EgressFeaturePlan plan;
+  plan.steps_.reserve(feature_array.Size());
+  int idx = 0;
+  for (const rapidjson::Value& feat : feature_array) {
+    if (!feat.IsObject()) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Feature at index ", idx, " is not an object, expected object"));
+    }
+    std::string name;
+    uint32_t size = 1;  // Defaulting to size of a boolean
+    PS_ASSIGN_IF_PRESENT(name, feat, "name", String);
+    PS_ASSIGN_IF_PRESENT(size, feat, "size", Uint);
+    PS_ASSIGN_OR_RETURN(FeatureKind kind, GetFeatureKind(name));
+    Step step;
+    switch (kind) {
+      case FeatureKind::kBoolean:
+        step = {.kind = kind, .width = 1};
+        break;
+      case FeatureKind::kSignedInt:
+      case FeatureKind::kUnsignedInt:
+        step = IntStep(kind, size);
+        break;
+      case FeatureKind::kBucket:
+        step = {.kind = kind, .width = size};
+        break;
+      case FeatureKind::kHistogram: {
+        // The width of a histogram is the sum of its buckets' widths.
+        PS_ASSIGN_OR_RETURN(auto histogram_schema,
+                            GetArrayMember(feat, "value"));
+        step = {.kind = kind,
+                .first_bucket =
+                    static_cast<uint32_t>(plan.histogram_steps_.size()),
+                .num_buckets = histogram_schema.Size()};
+        for (const rapidjson::Value& bucket_schema : histogram_schema) {
+          std::string bucket_name;
+          uint32_t bucket_size = 0;
+          PS_ASSIGN_IF_PRESENT(bucket_name, bucket_schema, "name", String);
+          PS_ASSIGN_IF_PRESENT(bucket_size, bucket_schema, "size", Uint);
+          if (bucket_name != kSignedIntFeatureTag &&
+              bucket_name != kUnsignedIntFeatureTag) {
+            return absl::InvalidArgumentError(absl::StrCat(
+                "Only signed and unsigned integer feature types are "
+                "supported for histogram, got: ",
+                bucket_name));
+          }
+          plan.histogram_steps_.push_back(
+              IntStep(bucket_name == kSignedIntFeatureTag
+                          ? FeatureKind::kSignedInt
+                          : FeatureKind::kUnsignedInt,
+                      bucket_size));
+          step.width += bucket_size;
+        }
+        break;
+      }
+    }
+    PS_VLOG(5) << "Feature name: " << name << ", size: " << step.width;
+    plan.total_bits_ += step.width;
+    plan.steps_.push_back(step);
+    ++idx;
+  }
+  return plan;
+}
+
+absl::Status EgressFeaturePlan::Apply(const rapidjson::Value& payload,
+                                      BitWriter& writer) const {
+  PS_ASSIGN_OR_RETURN(auto feature_array, GetArrayMember(payload, "features"));
+  if (feature_array.Size() != steps_.size()) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Number of values in the egress payload: ", feature_array.Size(),
+        " doesn't match with egress schema: ", steps_.size(),
+        " (note: nullability is not supported yet)"));
+  }
+  for (int idx = 0; idx < steps_.size(); ++idx) {
+    const rapidjson::Value& feat = feature_array[idx];
+    if (!feat.IsObject()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Feature in egress payload at index ", idx,
+                       " is not an object, expected object"));
+    }
+    PS_RETURN_IF_ERROR(VerifyType(feat, steps_[idx].kind))
+        << "Failed to set value for feature at idx: " << idx;
+    PS_RETURN_IF_ERROR(ApplyStep(steps_[idx], feat, writer))
+        << "Failed to serialize feature at idx: " << idx;
+  }
+  return absl::OkStatus();
+}
+
+absl::Status EgressFeaturePlan::ApplyStep(const Step& step,
+                                          const rapidjson::Value& feature,
+                                          BitWriter& writer) const {
+  switch (step.kind) {
+    case FeatureKind::kBoolean: {
+      std::optional<bool> value;
+      PS_ASSIGN_IF_PRESENT(value, feature, "value", Bool);
+      if (!value) {
+        return absl::InvalidArgumentError(
+            "Value in the egress payload didn't have a bool");
+      }
+      writer.WriteBit(*value);
+      return absl::OkStatus();
+    }
+    case FeatureKind::kUnsignedInt: {
+      std::optional<uint32_t> value;
+      PS_ASSIGN_IF_PRESENT(value, feature, "value", Uint);
+      if (!value) {
+        return absl::InvalidArgumentError(
+            "Int feature not found in the egress payload");
+      }
+      PS_RETURN_IF_ERROR(CheckBounds(step, *value));
+      writer.Write(*value, step.width);
+      return absl::OkStatus();
+    }
+    case FeatureKind::kSignedInt: {
+      std::optional<int32_t> value;
+      PS_ASSIGN_IF_PRESENT(value, feature, "value", Int);
+      if (!value) {
+        return absl::InvalidArgumentError(
+            "Int feature not found in the egress payload");
+      }
+      PS_RETURN_IF_ERROR(CheckBounds(step, *value));
+      // Negative values are written in two's complement, e.g. -1 as 111.
+      writer.WriteSigned(*value, step.width);
+      return absl::OkStatus();
+    }
+    case FeatureKind::kBucket: {
+      PS_ASSIGN_OR_RETURN(auto buckets, GetArrayMember(feature, "value"));
+      if (buckets.Size() != step.width) {
+        return absl::InvalidArgumentError(absl::StrCat(
+            "Number of buckets in feature payload (", buckets.Size(),
+            ") doesn't match schema (", step.width, ")"));
+      }
+      // The first bucket goes to the least significant bit. Bucket entries
+      // are homogeneous booleans, so their names are not verified.
+      for (int idx = 0; idx < buckets.Size(); ++idx) {
+        if (!buckets[idx].IsObject()) {
+          return absl::InvalidArgumentError(absl::StrCat(
+              "Feature at index ", idx, " is not an object, expected object"));
+        }
+        std::optional<bool> value;
+        PS_ASSIGN_IF_PRESENT(value, buckets[idx], "value", Bool);
+        if (!value) {
+          return absl::InvalidArgumentError(
+              "Value in the egress payload didn't have a bool");
+        }
+        writer.WriteBit(*value);
+      }
+      return absl::OkStatus();
+    }
+    case FeatureKind::kHistogram: {
+      PS_ASSIGN_OR_RETURN(auto histogram_val,
+                          GetArrayMember(feature, "value"));
+      if (histogram_val.Size() != step.num_buckets) {
+        return absl::InvalidArgumentError(absl::StrCat(
+            "Number of buckets in histogram feature payload (",
+            histogram_val.Size(), ") doesn't match schema (",
+            step.num_buckets, ")"));
+      }
+      // The first bucket goes to the least significant bits.
+      for (int idx = 0; idx < step.num_buckets; ++idx) {
+        const rapidjson::Value& bucket = histogram_val[idx];
+        if (!bucket.IsObject()) {
+          return absl::InvalidArgumentError(absl::StrCat(
+              "Feature at index ", idx, " is not an object, expected object"));
+        }
+        const Step& bucket_step = histogram_steps_[step.first_bucket + idx];
+        PS_RETURN_IF_ERROR(VerifyType(bucket, bucket_step.kind));
+        PS_RETURN_IF_ERROR(ApplyStep(bucket_step, bucket, writer));
+      }
+      return absl::OkStatus();
+    }
+  }
+  return absl::InternalError("Unknown egress feature kind");
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,88 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef SERVICES_BIDDING_SERVICE_EGRESS_FEATURES_EGRESS_FEATURE_PLAN_H_
+#define SERVICES_BIDDING_SERVICE_EGRESS_FEATURES_EGRESS_FEATURE_PLAN_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "include/rapidjson/document.h"
+#include "services/bidding_service/utils/bit_writer.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// Immutable, flattened form of an adtech egress schema.
+//
+// The schema is compiled once (when it is fetched) into a flat list of steps
+// holding the type, width and value bounds of every feature. Applying the
+// plan to an egress payload then validates the payload against the schema and
+// writes the features straight into a `BitWriter`, without creating (or
+// copying) any `EgressFeature` objects per request.
+//
+// A plan can be shared and applied concurrently by any number of requests.
+class EgressFeaturePlan {
+ public:
+  enum class FeatureKind : uint8_t {
+    kBoolean,
+    kSignedInt,
+    kUnsignedInt,
+    kBucket,
+    kHistogram,
+  };
+
+  struct Step {
+    FeatureKind kind;
+    // Number of bits written for the feature.
+    uint32_t width = 0;
+    // Inclusive bounds of the values accepted for integer features.
+    int64_t min_value = 0;
+    int64_t max_value = 0;
+    // Range of the histogram's buckets in `histogram_steps_`.
+    uint32_t first_bucket = 0;
+    uint32_t num_buckets = 0;
+  };
+
+  // Compiles the "features" of a (CDDL validated) adtech egress schema.
+  static absl::StatusOr<EgressFeaturePlan> Compile(
+      const rapidjson::Value& schema);
+
+  // Validates the "features" in the egress `payload` against the schema and
+  // appends their total_bits() bits to `writer`. The first feature goes to
+  // the least significant bits. On error, `writer` may be partially written.
+  absl::Status Apply(const rapidjson::Value& payload, BitWriter& writer) const;
+
+  // Returns the total number of bits of all the features in the schema.
+  uint32_t total_bits() const { return total_bits_; }
+
+  // Returns the number of (top level) features in the schema.
+  int num_features() const { return steps_.size(); }
+
+ private:
+  EgressFeaturePlan() = default;
+
+  absl::Status ApplyStep(const Step& step, const rapidjson::Value& feature,
+                         BitWriter& writer) const;
+
+  std::vector<Step> steps_;
+  // Buckets of all histograms in the schema, laid out back to back.
+  std::vector<Step> histogram_steps_;
+  uint32_t total_bits_ = 0;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_BIDDING_SERVICE_EGRESS_FEATURES_EGRESS_FEATURE_PLAN_H_
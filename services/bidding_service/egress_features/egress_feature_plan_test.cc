@@ -0,0 +1,210 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/bidding_service/egress_features/egress_feature_plan.h"
+
+#include <string>
+#include <utility>
+
+#include <include/gmock/gmock-matchers.h>
+
+#include "absl/log/check.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+#include "services/bidding_service/utils/bit_writer.h"
+#include "services/common/util/json_util.h"
+#include "src/util/status_macro/status_macros.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+using ::testing::HasSubstr;
+
+inline constexpr absl::string_view kTestSchema = R"JSON(
+  {
+    "features": [
+      {
+        "name": "boolean-feature"
+      },
+      {
+        "name": "unsigned-integer-feature",
+        "size": 3
+      },
+      {
+        "name": "signed-integer-feature",
+        "size": 3
+      },
+      {
+        "name": "bucket-feature",
+        "size": 2
+      },
+      {
+        "name": "histogram-feature",
+        "value": [
+          {
+            "name": "unsigned-integer-feature",
+            "size": 2
+          },
+          {
+            "name": "signed-integer-feature",
+            "size": 2
+          }
+        ]
+      }
+    ]
+  })JSON";
+
+EgressFeaturePlan CompileOrDie(absl::string_view schema) {
+  auto schema_doc = ParseJsonString(schema);
+  CHECK_OK(schema_doc);
+  auto plan = EgressFeaturePlan::Compile(*schema_doc);
+  CHECK_OK(plan);
+  return *std::move(plan);
+}
+
+absl::StatusOr<std::string> ApplyToBits(const EgressFeaturePlan& plan,
+                                        absl::string_view payload) {
+  auto payload_doc = ParseJsonString(payload);
+  CHECK_OK(payload_doc);
+  BitWriter writer(plan.total_bits());
+  PS_RETURN_IF_ERROR(plan.Apply(*payload_doc, writer));
+  std::string bits;
+  for (bool bit : writer.ToBits()) {
+    bits.push_back(bit ? '1' : '0');
+  }
+  return bits;
+}
+
+TEST(EgressFeaturePlanTest, CompilesFeatureWidths) {
+  EgressFeaturePlan plan = CompileOrDie(kTestSchema);
+  EXPECT_EQ(plan.num_features(), 5);
+  EXPECT_EQ(plan.total_bits(), 1 + 3 + 3 + 2 + 4);
+}
+
+TEST(EgressFeaturePlanTest, FailsToCompileUnknownFeature) {
+  auto schema_doc = ParseJsonString(R"JSON(
+    {"features": [{"name": "float-feature"}]})JSON");
+  CHECK_OK(schema_doc);
+  auto plan = EgressFeaturePlan::Compile(*schema_doc);
+  ASSERT_FALSE(plan.ok());
+  EXPECT_THAT(plan.status().message(), HasSubstr("Unidentified feature"));
+}
+
+TEST(EgressFeaturePlanTest, FailsToCompileUnsupportedHistogramBucket) {
+  auto schema_doc = ParseJsonString(R"JSON(
+    {"features": [{
+      "name": "histogram-feature",
+      "value": [{"name": "boolean-feature"}]
+    }]})JSON");
+  CHECK_OK(schema_doc);
+  auto plan = EgressFeaturePlan::Compile(*schema_doc);
+  ASSERT_FALSE(plan.ok());
+  EXPECT_THAT(plan.status().message(),
+              HasSubstr("Only signed and unsigned integer"));
+}
+
+TEST(EgressFeaturePlanTest, AppliesPayload) {
+  EgressFeaturePlan plan = CompileOrDie(kTestSchema);
+  auto bits = ApplyToBits(plan, R"JSON(
+    {
+      "features": [
+        {"name": "boolean-feature", "value": true},
+        {"name": "unsigned-integer-feature", "value": 5},
+        {"name": "signed-integer-feature", "value": -2},
+        {"name": "bucket-feature", "value": [
+          {"value": false}, {"value": true}
+        ]},
+        {"name": "histogram-feature", "value": [
+          {"name": "unsigned-integer-feature", "value": 2},
+          {"name": "signed-integer-feature", "value": -1}
+        ]}
+      ]
+    })JSON");
+  ASSERT_TRUE(bits.ok()) << bits.status();
+  // Last feature first: histogram (11, 10), bucket (1, 0), signed int (110),
+  // unsigned int (101), boolean (1).
+  EXPECT_EQ(*bits, "1110101101011");
+}
+
+TEST(EgressFeaturePlanTest, PlanIsReusableAcrossPayloads) {
+  EgressFeaturePlan plan = CompileOrDie(R"JSON(
+    {"features": [{"name": "unsigned-integer-feature", "size": 2}]})JSON");
+  for (int value = 0; value < 4; ++value) {
+    auto bits = ApplyToBits(
+        plan, absl::StrCat(R"({"features": [{"name": )",
+                           R"("unsigned-integer-feature", "value": )", value,
+                           "}]}"));
+    ASSERT_TRUE(bits.ok()) << bits.status();
+    EXPECT_EQ(*bits, absl::StrCat(value >> 1, value & 1));
+  }
+}
+
+TEST(EgressFeaturePlanTest, FailsOnFeatureCountMismatch) {
+  EgressFeaturePlan plan = CompileOrDie(kTestSchema);
+  auto bits = ApplyToBits(plan, R"JSON(
+    {"features": [{"name": "boolean-feature", "value": true}]})JSON");
+  ASSERT_FALSE(bits.ok());
+  EXPECT_THAT(bits.status().message(), HasSubstr("doesn't match"));
+}
+
+TEST(EgressFeaturePlanTest, FailsOnTypeMismatch) {
+  EgressFeaturePlan plan = CompileOrDie(R"JSON(
+    {"features": [{"name": "boolean-feature"}]})JSON");
+  auto bits = ApplyToBits(plan, R"JSON(
+    {"features": [{"name": "signed-integer-feature", "value": 1}]})JSON");
+  ASSERT_FALSE(bits.ok());
+  EXPECT_THAT(bits.status().message(), HasSubstr("doesn't match with"));
+}
+
+TEST(EgressFeaturePlanTest, FailsOnOutOfBoundsValues) {
+  EgressFeaturePlan plan = CompileOrDie(R"JSON(
+    {"features": [
+      {"name": "unsigned-integer-feature", "size": 3},
+      {"name": "signed-integer-feature", "size": 3}
+    ]})JSON");
+  EXPECT_TRUE(ApplyToBits(plan, R"JSON(
+    {"features": [
+      {"name": "unsigned-integer-feature", "value": 7},
+      {"name": "signed-integer-feature", "value": -4}
+    ]})JSON")
+                  .ok());
+  auto unsigned_overflow = ApplyToBits(plan, R"JSON(
+    {"features": [
+      {"name": "unsigned-integer-feature", "value": 8},
+      {"name": "signed-integer-feature", "value": 0}
+    ]})JSON");
+  ASSERT_FALSE(unsigned_overflow.ok());
+  EXPECT_THAT(unsigned_overflow.status().message(), HasSubstr("Out of bound"));
+  auto signed_overflow = ApplyToBits(plan, R"JSON(
+    {"features": [
+      {"name": "unsigned-integer-feature", "value": 0},
+      {"name": "signed-integer-feature", "value": 4}
+    ]})JSON");
+  ASSERT_FALSE(signed_overflow.ok());
+  EXPECT_THAT(signed_overflow.status().message(), HasSubstr("Out of bound"));
+}
+
+TEST(EgressFeaturePlanTest, FailsOnBucketCountMismatch) {
+  EgressFeaturePlan plan = CompileOrDie(R"JSON(
+    {"features": [{"name": "bucket-feature", "size": 2}]})JSON");
+  auto bits = ApplyToBits(plan, R"JSON(
+    {"features": [
+      {"name": "bucket-feature", "value": [{"value": true}]}
+    ]})JSON");
+  ASSERT_FALSE(bits.ok());
+  EXPECT_THAT(bits.status().message(), HasSubstr("Number of buckets"));
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
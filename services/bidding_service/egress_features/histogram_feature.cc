@@ -19,7 +19,6 @@
 #include "absl/strings/str_join.h"
 #include "services/bidding_service/egress_features/signed_int_feature.h"
 #include "services/bidding_service/egress_features/unsigned_int_feature.h"
-#include "services/bidding_service/utils/egress.h"
 #include "services/common/util/json_util.h"
 #include "src/logger/request_context_impl.h"
 #include "src/util/status_macro/status_macros.h"
@@ -59,10 +58,11 @@ uint32_t HistogramFeature::Size() const {
 
 absl::string_view HistogramFeature::Type() const { return "histogram-feature"; }
 
-absl::StatusOr<std::vector<bool>> HistogramFeature::Serialize() {
+absl::Status HistogramFeature::SerializeInto(BitWriter& writer) {
   if (!is_value_set_) {
     PS_VLOG(5) << "Histogram Feature value has not been set, returning default";
-    return std::vector<bool>(Size(), false);
+    writer.WriteZeros(Size());
+    return absl::OkStatus();
   }
   PS_ASSIGN_OR_RETURN(auto histogram_val, GetArrayMember(value_, "value"));
   PS_ASSIGN_OR_RETURN(auto histogram_schema,
@@ -73,56 +73,37 @@ absl::StatusOr<std::vector<bool>> HistogramFeature::Serialize() {
                      histogram_val.Size(), ") doesn't match schema (",
                      histogram_schema.Size(), ")"));
   }
-  std::vector<std::vector<bool>> serialized_feat;
-  serialized_feat.reserve(size_);
-  int idx = size_ - 1;
-  uint32_t total_size = 0;
+  // The first bucket goes to the least significant bits.
+  int idx = 0;
   for (rapidjson::Value& feat : histogram_val) {
     if (!feat.IsObject()) {
-      return absl::InvalidArgumentError(
-          absl::StrCat("Feature at index ", size_ - (idx + 1),
-                       " is not an object, expected object"));
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Feature at index ", idx, " is not an object, expected object"));
     }
-    const rapidjson::Value& feat_schema = histogram_schema[size_ - (idx + 1)];
+    const rapidjson::Value& feat_schema = histogram_schema[idx];
     std::string feat_name;
     PS_ASSIGN_IF_PRESENT(feat_name, feat_schema, "name", String);
     DCHECK(!feat_name.empty())
-        << "No name found in schema for feature at idx: " << size_ - (idx + 1);
+        << "No name found in schema for feature at idx: " << idx;
     uint32_t feat_size = 0;
     PS_ASSIGN_IF_PRESENT(feat_size, feat_schema, "size", Uint);
     if (feat_name == "unsigned-integer-feature") {
       UnsignedIntFeature unsigned_int_feat(feat_size);
-      total_size += feat_size;
       PS_RETURN_IF_ERROR(unsigned_int_feat.SetValue(std::move(feat)));
-      PS_ASSIGN_OR_RETURN(auto serialized_num, unsigned_int_feat.Serialize());
-      PS_VLOG(5) << "Serialized unsigned int at idx: " << idx
-                 << " in histogram is: " << DebugString(serialized_num);
-      serialized_feat.emplace_back(std::move(serialized_num));
+      PS_RETURN_IF_ERROR(unsigned_int_feat.SerializeInto(writer));
     } else if (feat_name == "signed-integer-feature") {
-      total_size += feat_size;
       SignedIntFeature signed_int_feat(feat_size);
       PS_RETURN_IF_ERROR(signed_int_feat.SetValue(std::move(feat)));
-      PS_ASSIGN_OR_RETURN(auto serialized_num, signed_int_feat.Serialize());
-      PS_VLOG(5) << "Serialized signed int at idx: " << idx
-                 << " in histogram is: " << DebugString(serialized_num);
-      serialized_feat.emplace_back(std::move(serialized_num));
+      PS_RETURN_IF_ERROR(signed_int_feat.SerializeInto(writer));
     } else {
       return absl::InvalidArgumentError(
           absl::StrCat("Only signed and unsigned integer feature types are "
                        "supported for histogram, got: ",
                        feat_name));
     }
-    --idx;
-  }
-  std::vector<bool> flattened_vector;
-  flattened_vector.reserve(total_size);
-  for (auto feat_it = serialized_feat.rbegin();
-       feat_it != serialized_feat.rend(); ++feat_it) {
-    for (const bool feat_val : *feat_it) {
-      flattened_vector.emplace_back(feat_val);
-    }
+    ++idx;
   }
-  return flattened_vector;
+  return absl::OkStatus();
 }
 
 }  // namespace privacy_sandbox::bidding_auction_servers
@@ -14,10 +14,10 @@
 
 #include "services/bidding_service/egress_features/signed_int_feature.h"
 
+#include <cmath>
 #include <optional>
 #include <utility>
 
-#include "services/bidding_service/utils/egress.h"
 #include "services/common/util/json_util.h"
 #include "src/logger/request_context_impl.h"
 
@@ -36,10 +36,11 @@ absl::StatusOr<std::unique_ptr<EgressFeature>> SignedIntFeature::Copy() const {
   return std::make_unique<SignedIntFeature>(*this);
 }
 
-absl::StatusOr<std::vector<bool>> SignedIntFeature::Serialize() {
+absl::Status SignedIntFeature::SerializeInto(BitWriter& writer) {
   if (!is_value_set_) {
     PS_VLOG(5) << "Signed int feature value has not been set, default";
-    return std::vector<bool>(size_, false);
+    writer.WriteZeros(size_);
+    return absl::OkStatus();
   }
   std::optional<int> value;
   PS_ASSIGN_IF_PRESENT(value, value_, "value", Int);
@@ -55,15 +56,9 @@ absl::StatusOr<std::vector<bool>> SignedIntFeature::Serialize() {
         "Out of bound error: Int feature value: ", *value,
         " can not be represented in ", size_, " bits allowed by the schema"));
   }
-  std::vector<bool> bit_rep(size_, false);
-  if (*value < 0) {
-    *value += pow(2, size_ - 1);
-    UnsignedIntToBits(*value, bit_rep);
-    bit_rep[0] = true;  // Set signed bit
-  } else {
-    UnsignedIntToBits(*value, bit_rep);
-  }
-  return bit_rep;
+  // Negative values are written in two's complement, e.g. -1 as 111.
+  writer.WriteSigned(*value, size_);
+  return absl::OkStatus();
 }
 
 }  // namespace privacy_sandbox::bidding_auction_servers
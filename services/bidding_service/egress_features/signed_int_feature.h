@@ -33,8 +33,8 @@ class SignedIntFeature : public EgressFeature {
 
   absl::string_view Type() const override;
 
-  // Converts the egress feature into a byte-string.
-  absl::StatusOr<std::vector<bool>> Serialize() override;
+  // Appends the bits of the egress feature to the writer.
+  absl::Status SerializeInto(BitWriter& writer) override;
 
   absl::StatusOr<std::unique_ptr<EgressFeature>> Copy() const override;
 };
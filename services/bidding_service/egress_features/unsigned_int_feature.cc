@@ -14,10 +14,10 @@
 
 #include "services/bidding_service/egress_features/unsigned_int_feature.h"
 
+#include <cmath>
 #include <optional>
 #include <utility>
 
-#include "services/bidding_service/utils/egress.h"
 #include "services/common/util/json_util.h"
 #include "src/logger/request_context_impl.h"
 
@@ -37,11 +37,12 @@ absl::string_view UnsignedIntFeature::Type() const {
   return "unsigned-integer-feature";
 }
 
-absl::StatusOr<std::vector<bool>> UnsignedIntFeature::Serialize() {
+absl::Status UnsignedIntFeature::SerializeInto(BitWriter& writer) {
   if (!is_value_set_) {
     PS_VLOG(5)
         << "Unsigned int feature value has not been set, returning default";
-    return std::vector<bool>(size_, false);
+    writer.WriteZeros(size_);
+    return absl::OkStatus();
   }
   std::optional<uint> value;
   PS_ASSIGN_IF_PRESENT(value, value_, "value", Uint);
@@ -56,9 +57,8 @@ absl::StatusOr<std::vector<bool>> UnsignedIntFeature::Serialize() {
         "Out of bound error: Uint feature value: ", *value,
         " can not be represented in ", size_, " bits allowed by the schema"));
   }
-  std::vector<bool> bit_rep(size_, false);
-  UnsignedIntToBits(*value, bit_rep);
-  return bit_rep;
+  writer.Write(*value, size_);
+  return absl::OkStatus();
 }
 
 }  // namespace privacy_sandbox::bidding_auction_servers
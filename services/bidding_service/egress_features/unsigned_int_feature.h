@@ -33,7 +33,7 @@ class UnsignedIntFeature : public EgressFeature {
 
   absl::string_view Type() const override;
 
-  absl::StatusOr<std::vector<bool>> Serialize() override;
+  absl::Status SerializeInto(BitWriter& writer) override;
 
   absl::StatusOr<std::unique_ptr<EgressFeature>> Copy() const override;
 };
@@ -83,13 +83,18 @@ absl::Status EgressSchemaCache::Update(absl::string_view egress_schema,
     return absl::InvalidArgumentError(std::move(err));
   }
   PS_ASSIGN_OR_RETURN(auto extracted_features, ExtractFeatures(json_doc));
+  // Compile the schema once here so that requests don't have to interpret
+  // (or copy) the features again.
+  PS_ASSIGN_OR_RETURN(auto plan, EgressFeaturePlan::Compile(json_doc));
   // If validation passes, extract the features from the schema into Feature
   // objects that can be used by the bidding service when it has to serialize
   // the features.
   absl::MutexLock lock(&mu_);
   version_features_[std::string(id)] =
       EgressSchemaData({.version = static_cast<uint32_t>(schema_version),
-                        .features = std::move(extracted_features)});
+                        .features = std::move(extracted_features),
+                        .plan = std::make_shared<const EgressFeaturePlan>(
+                            std::move(plan))});
   return absl::OkStatus();
 }
 
@@ -122,8 +127,22 @@ absl::StatusOr<EgressSchemaData> EgressSchemaCache::Get(
     PS_ASSIGN_OR_RETURN(auto feat_copy, feat->Copy());
     egress_features.emplace_back(std::move(feat_copy));
   }
-  return EgressSchemaData(
-      {.version = it->second.version, .features = std::move(egress_features)});
+  return EgressSchemaData({.version = it->second.version,
+                           .features = std::move(egress_features),
+                           .plan = it->second.plan});
+}
+
+absl::StatusOr<CompiledEgressSchema> EgressSchemaCache::GetPlan(
+    absl::string_view schema_id) ABSL_LOCKS_EXCLUDED(mu_) {
+  PS_VLOG(5) << "Getting plan for schema id: " << schema_id;
+  absl::ReaderMutexLock lock(&mu_);
+  auto it = version_features_.find(schema_id);
+  if (it == version_features_.end()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Adtech schema version not found in cache: ", schema_id));
+  }
+  return CompiledEgressSchema(
+      {.version = it->second.version, .plan = it->second.plan});
 }
 
 }  // namespace privacy_sandbox::bidding_auction_servers
@@ -27,6 +27,7 @@
 #include "services/bidding_service/bidding_v8_constants.h"
 #include "services/bidding_service/cddl_spec_cache.h"
 #include "services/bidding_service/egress_features/egress_feature.h"
+#include "services/bidding_service/egress_features/egress_feature_plan.h"
 
 namespace privacy_sandbox::bidding_auction_servers {
 
@@ -35,6 +36,15 @@ struct EgressSchemaData {
   uint32_t version;
   // A list of feature objects in a given schema.
   std::vector<std::unique_ptr<EgressFeature>> features;
+  // The features of the schema compiled into an immutable plan.
+  std::shared_ptr<const EgressFeaturePlan> plan;
+};
+
+struct CompiledEgressSchema {
+  // The numeric version of a given schema.
+  uint32_t version;
+  // Compiled plan shared by all the requests using the schema.
+  std::shared_ptr<const EgressFeaturePlan> plan;
 };
 
 // Cache to store the validation status of adtech provided schema.
@@ -65,6 +75,13 @@ class EgressSchemaCache {
   virtual absl::StatusOr<EgressSchemaData> Get(absl::string_view schema_id)
       ABSL_LOCKS_EXCLUDED(mu_);
 
+  // Gets the compiled feature plan for the egress schema matching the
+  // specified egress schema id. Unlike Get, this doesn't copy any features
+  // and is meant to be used on the request path. Returns a non-ok Status if
+  // the schema id passed in was not loaded previously.
+  virtual absl::StatusOr<CompiledEgressSchema> GetPlan(
+      absl::string_view schema_id) ABSL_LOCKS_EXCLUDED(mu_);
+
  private:
   absl::Mutex mu_;
 
@@ -21,6 +21,7 @@
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/time/time.h"
+#include "google/protobuf/arena.h"
 #include "services/common/util/cancellation_wrapper.h"
 #include "services/common/util/error_categories.h"
 
@@ -33,12 +34,9 @@ using IGForBidding =
 inline constexpr absl::Duration kDefaultGenerateBidExecutionTimeout =
     absl::Seconds(1);
 
-roma_service::GenerateProtectedAudienceBidRequest
-BuildCommonProtectedAudienceBidRequest(RawRequest& raw_request,
-                                       bool logging_enabled,
-                                       bool debug_reporting_enabled) {
-  roma_service::GenerateProtectedAudienceBidRequest bid_request;
-
+void BuildCommonProtectedAudienceBidRequest(
+    RawRequest& raw_request, bool logging_enabled, bool debug_reporting_enabled,
+    roma_service::GenerateProtectedAudienceBidRequest& bid_request) {
   // Populate auction and buyer signals.
   bid_request.set_auction_signals(
       std::move(*raw_request.mutable_auction_signals()));
@@ -50,7 +48,6 @@ BuildCommonProtectedAudienceBidRequest(RawRequest& raw_request,
       bid_request.mutable_server_metadata();
   server_metadata->set_logging_enabled(logging_enabled);
   server_metadata->set_debug_reporting_enabled(debug_reporting_enabled);
-  return bid_request;
 }
 
 std::vector<AdWithBid> ParseProtectedAudienceBids(
@@ -252,9 +249,13 @@ void GenerateBidsBinaryReactor::DispatchExecutions() {
   // Resize to number of interest groups in advance to prevent reallocation.
   ads_with_bids_by_ig_.resize(ig_count);
 
-  roma_service::GenerateProtectedAudienceBidRequest common_bid_request =
-      BuildCommonProtectedAudienceBidRequest(raw_request_, is_logging_enabled_,
-                                             is_debug_reporting_enabled_);
+  // Allocated on the arena of raw_request_, so that the fields of each
+  // interest group are swapped into it rather than copied.
+  auto& common_bid_request = *google::protobuf::Arena::Create<
+      roma_service::GenerateProtectedAudienceBidRequest>(&arena_);
+  BuildCommonProtectedAudienceBidRequest(raw_request_, is_logging_enabled_,
+                                         is_debug_reporting_enabled_,
+                                         common_bid_request);
 
   // Send execution requests for each interest group immediately.
   start_binary_execution_time_ = absl::Now();
@@ -310,9 +311,10 @@ void GenerateBidsBinaryReactor::DispatchExecutionsInBatch() {
     ig_names.push_back(
         raw_request_.mutable_interest_group_for_bidding(ig_index)->name());
   }
-  roma_service::GenerateProtectedAudienceBidRequest common_bid_request =
-      BuildCommonProtectedAudienceBidRequest(raw_request_, is_logging_enabled_,
-                                             is_debug_reporting_enabled_);
+  roma_service::GenerateProtectedAudienceBidRequest common_bid_request;
+  BuildCommonProtectedAudienceBidRequest(raw_request_, is_logging_enabled_,
+                                         is_debug_reporting_enabled_,
+                                         common_bid_request);
   start_binary_execution_time_ = absl::Now();
   const absl::Status execute_status =
       byob_client_->ExecuteManyWithSharedTimeouts(
@@ -25,11 +25,13 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
-#include "absl/strings/str_format.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
 #include "services/bidding_service/bidding_v8_constants.h"
 #include "services/bidding_service/code_wrapper/buyer_code_wrapper.h"
 #include "services/bidding_service/inference/inference_flags.h"
 #include "services/bidding_service/utils/browser_signals_util.h"
+#include "services/bidding_service/utils/interest_group_serializer.h"
 #include "services/common/constants/common_constants.h"
 #include "services/common/metric/roma_metric_utils.h"
 #include "services/common/util/cancellation_wrapper.h"
@@ -57,75 +59,6 @@ absl::StatusOr<std::string> ProtoToJson(
   return json;
 }
 
-absl::StatusOr<std::string> SerializeRepeatedStringField(
-    const google::protobuf::RepeatedPtrField<std::string>&
-        repeated_string_field) {
-  rapidjson::Document json_array;
-  json_array.SetArray();
-  for (const auto& item : repeated_string_field) {
-    json_array.PushBack(
-        rapidjson::Value(item.c_str(), json_array.GetAllocator()).Move(),
-        json_array.GetAllocator());
-  }
-  return SerializeJsonDoc(json_array);
-}
-
-constexpr char kName[] = "name";
-constexpr char kTrustedBiddingSignalsKeys[] = "trustedBiddingSignalsKeys";
-constexpr char kAdRenderIds[] = "adRenderIds";
-constexpr char kAdComponentRenderIds[] = "adComponentRenderIds";
-constexpr char kUserBiddingSignals[] = "userBiddingSignals";
-
-// Manual/Custom serializer for Interest Group.
-// Empty fields will not be included at all in the serialized JSON.
-// No default, null, or dummy values are filled in.
-// Device signals are not serialized since they are passed to generateBid()
-// in a different parameter.
-absl::StatusOr<std::string> SerializeIG(const IGForBidding& ig) {
-  // Insert the name in quotes.
-  std::string serialized_ig =
-      absl::StrFormat(R"JSON({"%s":"%s")JSON", kName, ig.name());
-  // Bidding signals keys.
-  if (!ig.trusted_bidding_signals_keys().empty()) {
-    absl::StatusOr<std::string> bidding_signals_keys_json_arr =
-        SerializeRepeatedStringField(ig.trusted_bidding_signals_keys());
-    if (!bidding_signals_keys_json_arr.ok()) {
-      return bidding_signals_keys_json_arr.status();
-    }
-    absl::StrAppend(
-        &serialized_ig,
-        absl::StrFormat(R"JSON(,"%s":%s)JSON", kTrustedBiddingSignalsKeys,
-                        bidding_signals_keys_json_arr.value()));
-  }
-  // Ad render IDs.
-  if (!ig.ad_render_ids().empty()) {
-    PS_ASSIGN_OR_RETURN(std::string ad_render_ids_json_arr,
-                        SerializeRepeatedStringField(ig.ad_render_ids()));
-    absl::StrAppend(&serialized_ig,
-                    absl::StrFormat(R"JSON(,"%s":%s)JSON", kAdRenderIds,
-                                    ad_render_ids_json_arr));
-  }
-  // Ad component render IDs.
-  if (!ig.ad_component_render_ids().empty()) {
-    PS_ASSIGN_OR_RETURN(
-        absl::StatusOr<std::string> ad_component_render_ids_json_arr,
-        SerializeRepeatedStringField(ig.ad_component_render_ids()));
-    absl::StrAppend(
-        &serialized_ig,
-        absl::StrFormat(R"JSON(,"%s":%s)JSON", kAdComponentRenderIds,
-                        ad_component_render_ids_json_arr.value()));
-  }
-  // User Bidding Signals gets no quotes as it needs no transformation.
-  if (!ig.user_bidding_signals().empty()) {
-    absl::StrAppend(&serialized_ig,
-                    absl::StrFormat(R"JSON(,"%s":%s)JSON", kUserBiddingSignals,
-                                    ig.user_bidding_signals()));
-  }
-  // Device signals do not have to be serialized.
-  absl::StrAppend(&serialized_ig, "}");
-  return serialized_ig;
-}
-
 // Builds a vector containing commonly shared inputs, following the description
 // here:
 // https://github.com/privacysandbox/fledge-docs/blob/main/bidding_auction_services_api.md#generatebids
@@ -221,12 +154,8 @@ absl::StatusOr<DispatchRequest> BuildGenerateBidRequest(
       kDispatchHandlerFunctionNameWithCodeWrapper;
 
   auto start_parse_time = absl::Now();
-  auto serialized_ig = SerializeIG(interest_group);
-  if (!serialized_ig.ok()) {
-    return serialized_ig.status();
-  }
   generate_bid_request.input[ArgIndex(GenerateBidUdfArgs::kInterestGroup)] =
-      std::make_shared<std::string>(std::move(serialized_ig.value()));
+      std::make_shared<std::string>(SerializeIG(interest_group));
   PS_VLOG(kStats, log_context)
       << "\nInterest Group Serialize Time: "
       << ToInt64Microseconds((absl::Now() - start_parse_time))
@@ -245,6 +174,61 @@ absl::StatusOr<DispatchRequest> BuildGenerateBidRequest(
   return generate_bid_request;
 }
 
+// Joins the input at `arg` of every request into a JSON array.
+std::shared_ptr<std::string> JoinInputAsJsonArray(
+    const std::vector<DispatchRequest>& generate_bid_requests,
+    GenerateBidUdfArgs arg) {
+  // Brackets and separators.
+  size_t joined_size = generate_bid_requests.size() + 1;
+  for (const DispatchRequest& request : generate_bid_requests) {
+    joined_size += std::max<size_t>(request.input[ArgIndex(arg)]->size(), 2);
+  }
+  std::string joined_input;
+  joined_input.reserve(joined_size);
+  joined_input.push_back('[');
+  for (const DispatchRequest& request : generate_bid_requests) {
+    if (joined_input.size() > 1) {
+      joined_input.push_back(',');
+    }
+    const std::string& input = *request.input[ArgIndex(arg)];
+    absl::StrAppend(&joined_input, input.empty() ? "\"\"" : input);
+  }
+  joined_input.push_back(']');
+  return std::make_shared<std::string>(std::move(joined_input));
+}
+
+// Combines Dispatch Requests built for single Interest Groups into one
+// Dispatch Request that generates bids for all of them in a single UDF
+// invocation. Inputs shared by all the Interest Groups are only passed once,
+// inputs specific to an Interest Group are passed as JSON arrays.
+DispatchRequest BuildGenerateBidBatchRequest(
+    const std::vector<DispatchRequest>& generate_bid_requests) {
+  DispatchRequest batch_request;
+  batch_request.id = generate_bid_requests.front().id;
+  batch_request.version_string = generate_bid_requests.front().version_string;
+  batch_request.handler_name = kBatchDispatchHandlerFunctionNameWithCodeWrapper;
+  batch_request.input = generate_bid_requests.front().input;
+  for (GenerateBidUdfArgs arg : {GenerateBidUdfArgs::kInterestGroup,
+                                 GenerateBidUdfArgs::kTrustedBiddingSignals,
+                                 GenerateBidUdfArgs::kDeviceSignals}) {
+    batch_request.input[ArgIndex(arg)] =
+        JoinInputAsJsonArray(generate_bid_requests, arg);
+  }
+  return batch_request;
+}
+
+// Returns the Roma timeout of a batch running generateBid for
+// `num_interest_groups` interest groups, each of them getting `roma_timeout`.
+std::string GetBatchRomaTimeout(const std::string& roma_timeout,
+                                int num_interest_groups) {
+  absl::Duration timeout;
+  if (!absl::ParseDuration(roma_timeout, &timeout)) {
+    return roma_timeout;
+  }
+  return absl::StrCat(
+      absl::ToInt64Milliseconds(timeout * num_interest_groups), "ms");
+}
+
 // Removes contributions with no event type and contributions beyond
 // per_adtech_paapi_contributions_limit for each event type.
 void ProcessPAggContributions(AdWithBid& bid,
@@ -296,6 +280,7 @@ GenerateBidsReactor::GenerateBidsReactor(
               : AuctionScope::AUCTION_SCOPE_DEVICE_COMPONENT_MULTI_SELLER),
       per_adtech_paapi_contributions_limit_(
           runtime_config.per_adtech_paapi_contributions_limit),
+      generate_bid_batch_size_(runtime_config.generate_bid_batch_size),
       cancellable_grpc_context_manager_(
           std::make_shared<CancellableGrpcContextManager>()) {
   PS_CHECK_OK(
@@ -376,6 +361,7 @@ void GenerateBidsReactor::Execute() {
   // Build base input.
   std::vector<std::shared_ptr<std::string>> base_input =
       BuildBaseInput(raw_request_);
+  std::vector<DispatchRequest> pending_batch;
   for (int i = 0; i < interest_groups.size(); i++) {
     absl::StatusOr<DispatchRequest> generate_bid_request =
         BuildGenerateBidRequest(interest_groups.at(i), raw_request_, base_input,
@@ -387,18 +373,19 @@ void GenerateBidsReactor::Execute() {
           << "Unable to build GenerateBidRequest: "
           << generate_bid_request.status().ToString(
                  absl::StatusToStringMode::kWithEverything);
+    } else if (generate_bid_batch_size_ > 1) {
+      pending_batch.push_back(*std::move(generate_bid_request));
+      if (pending_batch.size() >= generate_bid_batch_size_) {
+        AddBatchDispatchRequest(pending_batch);
+        pending_batch.clear();
+      }
     } else {
-      auto dispatch_request = generate_bid_request.value();
-      dispatch_request.metadata =
-          RomaSharedContextWithMetric<google::protobuf::Message>(
-              request_,
-              roma_request_context_factory_.Create(
-                  cancellable_grpc_context_manager_),
-              log_context_);
-      dispatch_request.tags[kRomaTimeoutTag] = roma_timeout_duration_;
-      dispatch_requests_.push_back(dispatch_request);
+      AddDispatchRequest(*std::move(generate_bid_request));
     }
   }
+  if (!pending_batch.empty()) {
+    AddBatchDispatchRequest(pending_batch);
+  }
 
   if (dispatch_requests_.empty()) {
     EncryptResponseAndFinish(grpc::Status::OK);
@@ -419,7 +406,11 @@ void GenerateBidsReactor::Execute() {
             LogIfError(metric_context_
                            ->LogHistogram<metric::kUdfBatchExecutionDuration>(
                                js_execution_time_ms));
-            GenerateBidsCallback(result);
+            if (generate_bid_batch_size_ > 1) {
+              GenerateBidsCallback(UnbatchResponses(result));
+            } else {
+              GenerateBidsCallback(result);
+            }
             LogRomaMetrics(result, metric_context_.get());
             EncryptResponseAndFinish(grpc::Status::OK);
           },
@@ -450,6 +441,89 @@ void GenerateBidsReactor::Execute() {
   }
 }
 
+void GenerateBidsReactor::AddDispatchRequest(
+    DispatchRequest dispatch_request,
+    std::vector<std::string> interest_group_names) {
+  dispatch_request.metadata =
+      RomaSharedContextWithMetric<google::protobuf::Message>(
+          request_,
+          roma_request_context_factory_.Create(
+              cancellable_grpc_context_manager_),
+          log_context_);
+  // A batch runs generateBid for each of its interest groups in turn, so it
+  // gets the time budget of all of them rather than the budget of one.
+  dispatch_request.tags[kRomaTimeoutTag] =
+      interest_group_names.empty()
+          ? roma_timeout_duration_
+          : GetBatchRomaTimeout(roma_timeout_duration_,
+                                interest_group_names.size());
+  dispatch_requests_.push_back(std::move(dispatch_request));
+  batched_interest_group_names_.push_back(std::move(interest_group_names));
+}
+
+void GenerateBidsReactor::AddBatchDispatchRequest(
+    std::vector<DispatchRequest>& generate_bid_requests) {
+  if (generate_bid_requests.size() == 1) {
+    AddDispatchRequest(std::move(generate_bid_requests.front()));
+    return;
+  }
+  std::vector<std::string> interest_group_names;
+  interest_group_names.reserve(generate_bid_requests.size());
+  for (const DispatchRequest& request : generate_bid_requests) {
+    interest_group_names.push_back(request.id);
+  }
+  AddDispatchRequest(BuildGenerateBidBatchRequest(generate_bid_requests),
+                     std::move(interest_group_names));
+}
+
+std::vector<absl::StatusOr<DispatchResponse>>
+GenerateBidsReactor::UnbatchResponses(
+    const std::vector<absl::StatusOr<DispatchResponse>>& output) {
+  std::vector<absl::StatusOr<DispatchResponse>> unbatched_output;
+  unbatched_output.reserve(output.size());
+  for (int i = 0; i < output.size(); i++) {
+    const std::vector<std::string>& interest_group_names =
+        batched_interest_group_names_.at(i);
+    if (interest_group_names.empty()) {
+      unbatched_output.push_back(output[i]);
+      continue;
+    }
+    if (!output[i].ok()) {
+      unbatched_output.insert(unbatched_output.end(),
+                              interest_group_names.size(), output[i].status());
+      continue;
+    }
+
+    // The batch response is expected to be an array with one serialized
+    // generateBidEntryFunction output per interest group.
+    absl::StatusOr<rapidjson::Document> batch_response =
+        ParseJsonString(output[i]->resp);
+    if (!batch_response.ok() || !batch_response->IsArray() ||
+        batch_response->Size() != interest_group_names.size()) {
+      PS_LOG(ERROR, log_context_)
+          << "Malformed batched generateBid response: " << output[i]->resp;
+      unbatched_output.insert(
+          unbatched_output.end(), interest_group_names.size(),
+          absl::InternalError(kMalformedBatchedGenerateBidResponse));
+      continue;
+    }
+    for (int j = 0; j < interest_group_names.size(); j++) {
+      const rapidjson::Value& response = (*batch_response)[j];
+      if (!response.IsString()) {
+        unbatched_output.push_back(
+            absl::InternalError(kMalformedBatchedGenerateBidResponse));
+        continue;
+      }
+      DispatchResponse dispatch_response = {};
+      dispatch_response.id = interest_group_names[j];
+      dispatch_response.resp =
+          std::string(response.GetString(), response.GetStringLength());
+      unbatched_output.push_back(std::move(dispatch_response));
+    }
+  }
+  return unbatched_output;
+}
+
 // Handles the output of the code execution dispatch.
 // Note that the dispatch response value is expected to be a json string
 // conforming to the generateBid function output described here:
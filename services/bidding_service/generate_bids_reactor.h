@@ -67,6 +67,23 @@ class GenerateBidsReactor
   // Called when the reactor is cancelled by the client or times out.
   void OnCancel() override;
 
+  // Adds a request to the dispatch batch. `interest_group_names` lists the
+  // interest groups of a batched request and is empty for a request built for
+  // a single interest group.
+  void AddDispatchRequest(DispatchRequest dispatch_request,
+                          std::vector<std::string> interest_group_names = {});
+
+  // Adds the requests built for single interest groups to the dispatch batch
+  // as one request that generates bids for all of them.
+  void AddBatchDispatchRequest(
+      std::vector<DispatchRequest>& generate_bid_requests);
+
+  // Splits the responses of batched requests into one response per interest
+  // group, so that they can be handled like the responses of requests built
+  // for single interest groups.
+  std::vector<absl::StatusOr<DispatchResponse>> UnbatchResponses(
+      const std::vector<absl::StatusOr<DispatchResponse>>& output);
+
   // Asynchronous callback used by the v8 code executor to return a result. This
   // will be called in a different thread owned by the code dispatch library.
   //
@@ -87,6 +104,9 @@ class GenerateBidsReactor
   // separate processes.
   V8DispatchClient& dispatcher_;
   std::vector<DispatchRequest> dispatch_requests_;
+  // Interest group names of each request in dispatch_requests_, see
+  // AddDispatchRequest().
+  std::vector<std::vector<std::string>> batched_interest_group_names_;
 
   std::unique_ptr<BiddingBenchmarkingLogger> benchmarking_logger_;
 
@@ -106,6 +126,10 @@ class GenerateBidsReactor
   // The max contributions limit for private aggregation.
   int per_adtech_paapi_contributions_limit_;
 
+  // Max number of interest groups passed to generateBid in one dispatch
+  // request.
+  int generate_bid_batch_size_;
+
   // The context manager for gRPC calls that can be cancelled.
   std::shared_ptr<CancellableGrpcContextManager>
       cancellable_grpc_context_manager_;
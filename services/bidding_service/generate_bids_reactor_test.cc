@@ -29,11 +29,13 @@
 #include "google/protobuf/text_format.h"
 #include "google/protobuf/util/message_differencer.h"
 #include "gtest/gtest.h"
+#include "rapidjson/document.h"
 #include "services/bidding_service/benchmarking/bidding_benchmarking_logger.h"
 #include "services/bidding_service/benchmarking/bidding_no_op_logger.h"
 #include "services/bidding_service/generate_bids_reactor_test_utils.h"
 #include "services/common/attestation/adtech_enrollment_cache.h"
 #include "services/common/attestation/attestation_util.h"
+#include "services/common/constants/common_constants.h"
 #include "services/common/constants/common_service_flags.h"
 #include "services/common/encryption/key_fetcher_factory.h"
 #include "services/common/encryption/mock_crypto_client_wrapper.h"
@@ -41,6 +43,7 @@
 #include "services/common/test/mocks.h"
 #include "services/common/test/random.h"
 #include "services/common/test/utils/test_init.h"
+#include "services/common/util/json_util.h"
 #include "src/encryption/key_fetcher/interface/key_fetcher_manager_interface.h"
 
 namespace privacy_sandbox::bidding_auction_servers {
@@ -81,12 +84,13 @@ using ::wireless::android::adservices::mdd::adtech_enrollment::chrome::
 using PrivacySandboxAttestedAPIsProto =
     PrivacySandboxAttestationsProto::PrivacySandboxAttestedAPIsProto;
 
-absl::Status FakeExecute(std::vector<DispatchRequest>& batch,
-                         BatchDispatchDoneCallback batch_callback,
-                         absl::string_view response_json) {
+absl::Status FakeExecute(
+    std::vector<DispatchRequest>& batch,
+    BatchDispatchDoneCallback batch_callback, absl::string_view response_json,
+    absl::string_view handler_name = "generateBidEntryFunction") {
   std::vector<absl::StatusOr<DispatchResponse>> responses;
   for (const auto& request : batch) {
-    EXPECT_EQ(request.handler_name, "generateBidEntryFunction");
+    EXPECT_EQ(request.handler_name, handler_name);
     DispatchResponse dispatch_response = {};
     dispatch_response.resp = response_json;
     dispatch_response.id = request.id;
@@ -626,6 +630,169 @@ TEST_F(GenerateBidsReactorTest, GeneratesBidsForMultipleIGForBiddings) {
       expected_response);
 }
 
+// Returns a batched generateBid response with the provided per interest group
+// responses.
+std::string GetBatchedTestResponse(const std::vector<std::string>& responses) {
+  rapidjson::Document batch_response(rapidjson::kArrayType);
+  for (const auto& response : responses) {
+    batch_response.PushBack(
+        rapidjson::Value(response.c_str(), batch_response.GetAllocator())
+            .Move(),
+        batch_response.GetAllocator());
+  }
+  return *SerializeJsonDoc(batch_response);
+}
+
+TEST_F(GenerateBidsReactorTest, GeneratesBidsForBatchOfIGForBiddings) {
+  GenerateBidsResponse expected_response;
+  GenerateBidsResponse::GenerateBidsRawResponse expected_raw_response;
+  *expected_raw_response.add_bids() = GetAdWithBidFromIgFoo(kTestRenderUrl, 2);
+  *expected_raw_response.add_bids() = GetAdWithBidFromIgBar(kTestRenderUrl, 1);
+  *expected_response.mutable_response_ciphertext() =
+      expected_raw_response.SerializeAsString();
+
+  const std::string response_json = GetBatchedTestResponse(
+      {GetTestResponse(kTestRenderUrl, 1), GetTestResponse(kTestRenderUrl, 2)});
+  EXPECT_CALL(dispatcher_, BatchExecute)
+      .WillOnce([&response_json](std::vector<DispatchRequest>& batch,
+                                 BatchDispatchDoneCallback batch_callback) {
+        EXPECT_EQ(batch.size(), 1);
+        const DispatchRequest& request = batch[0];
+        EXPECT_EQ(request.handler_name, "generateBidsBatchEntryFunction");
+        EXPECT_EQ(*request.input[1], kTestAuctionSignals);
+        EXPECT_EQ(*request.input[2], kTestBuyerSignals);
+        EXPECT_EQ(*request.input[3],
+                  absl::StrCat("[", kTestTrustedBiddingSignals, ",",
+                               kTestTrustedBiddingSignals, "]"));
+        absl::StatusOr<rapidjson::Document> interest_groups =
+            ParseJsonString(*request.input[0]);
+        EXPECT_TRUE(interest_groups.ok());
+        EXPECT_TRUE(interest_groups->IsArray());
+        EXPECT_EQ(interest_groups->Size(), 2);
+        absl::StatusOr<rapidjson::Document> device_signals =
+            ParseJsonString(*request.input[4]);
+        EXPECT_TRUE(device_signals.ok());
+        EXPECT_TRUE(device_signals->IsArray());
+        EXPECT_EQ(device_signals->Size(), 2);
+
+        DispatchResponse dispatch_response = {};
+        dispatch_response.resp = response_json;
+        dispatch_response.id = request.id;
+        std::vector<absl::StatusOr<DispatchResponse>> responses = {
+            dispatch_response};
+        batch_callback(responses);
+        return absl::OkStatus();
+      });
+
+  std::vector<IGForBidding> igs;
+  igs.push_back(GetIGForBiddingBar());
+  igs.push_back(GetIGForBiddingFoo());
+  CheckGenerateBids(
+      BuildGenerateBidsRawRequest({.interest_groups_to_add = std::move(igs)}),
+      expected_response,
+      BiddingServiceRuntimeConfig({.generate_bid_batch_size = 2}));
+}
+
+TEST_F(GenerateBidsReactorTest, SplitsIGForBiddingsIntoBatches) {
+  GenerateBidsResponse expected_response;
+  GenerateBidsResponse::GenerateBidsRawResponse expected_raw_response;
+  *expected_raw_response.add_bids() = GetAdWithBidFromIgBar(kTestRenderUrl, 1);
+  *expected_raw_response.add_bids() = GetAdWithBidFromIgFoo(kTestRenderUrl, 1);
+  *expected_raw_response.add_bids() = GetAdWithBidFromIgBar(kTestRenderUrl, 1);
+  *expected_response.mutable_response_ciphertext() =
+      expected_raw_response.SerializeAsString();
+
+  const std::string response_json = GetTestResponse(kTestRenderUrl, 1);
+  EXPECT_CALL(dispatcher_, BatchExecute)
+      .WillOnce([&response_json](std::vector<DispatchRequest>& batch,
+                                 BatchDispatchDoneCallback batch_callback) {
+        // The last interest group does not fill a batch and is dispatched on
+        // its own.
+        EXPECT_EQ(batch.size(), 2);
+        EXPECT_EQ(batch[0].handler_name, "generateBidsBatchEntryFunction");
+        EXPECT_EQ(batch[1].handler_name, "generateBidEntryFunction");
+        std::vector<absl::StatusOr<DispatchResponse>> responses;
+        DispatchResponse batch_response = {};
+        batch_response.resp =
+            GetBatchedTestResponse({response_json, response_json});
+        batch_response.id = batch[0].id;
+        responses.emplace_back(batch_response);
+        DispatchResponse single_response = {};
+        single_response.resp = response_json;
+        single_response.id = batch[1].id;
+        responses.emplace_back(single_response);
+        batch_callback(responses);
+        return absl::OkStatus();
+      });
+
+  std::vector<IGForBidding> igs;
+  igs.push_back(GetIGForBiddingBar());
+  igs.push_back(GetIGForBiddingFoo());
+  igs.push_back(GetIGForBiddingBar());
+  CheckGenerateBids(
+      BuildGenerateBidsRawRequest({.interest_groups_to_add = std::move(igs)}),
+      expected_response,
+      BiddingServiceRuntimeConfig({.generate_bid_batch_size = 2}));
+}
+
+TEST_F(GenerateBidsReactorTest, DropsMalformedBatchedResponse) {
+  EXPECT_CALL(dispatcher_, BatchExecute)
+      .WillOnce([](std::vector<DispatchRequest>& batch,
+                   BatchDispatchDoneCallback batch_callback) {
+        // Only one response for a batch of two interest groups.
+        return FakeExecute(
+            batch, std::move(batch_callback),
+            GetBatchedTestResponse({GetTestResponse(kTestRenderUrl, 1)}),
+            "generateBidsBatchEntryFunction");
+      });
+
+  std::vector<IGForBidding> igs;
+  igs.push_back(GetIGForBiddingBar());
+  igs.push_back(GetIGForBiddingFoo());
+  CheckGenerateBids(
+      BuildGenerateBidsRawRequest({.interest_groups_to_add = std::move(igs)}),
+      GenerateBidsResponse(),
+      BiddingServiceRuntimeConfig({.generate_bid_batch_size = 2}));
+}
+
+TEST_F(GenerateBidsReactorTest, BatchTimeoutOnlyDropsBidsOfThatBatch) {
+  GenerateBidsResponse expected_response;
+  GenerateBidsResponse::GenerateBidsRawResponse expected_raw_response;
+  *expected_raw_response.add_bids() = GetAdWithBidFromIgBar(kTestRenderUrl, 1);
+  *expected_response.mutable_response_ciphertext() =
+      expected_raw_response.SerializeAsString();
+
+  EXPECT_CALL(dispatcher_, BatchExecute)
+      .WillOnce([](std::vector<DispatchRequest>& batch,
+                   BatchDispatchDoneCallback batch_callback) {
+        EXPECT_EQ(batch.size(), 2);
+        // The batch gets the timeout of both of its interest groups.
+        EXPECT_EQ(batch[0].handler_name, "generateBidsBatchEntryFunction");
+        EXPECT_EQ(batch[0].tags[kRomaTimeoutTag], "2000ms");
+        EXPECT_EQ(batch[1].handler_name, "generateBidEntryFunction");
+        EXPECT_EQ(batch[1].tags[kRomaTimeoutTag], "1000ms");
+        std::vector<absl::StatusOr<DispatchResponse>> responses;
+        responses.emplace_back(
+            absl::DeadlineExceededError("Code execution timeout"));
+        DispatchResponse single_response = {};
+        single_response.resp = GetTestResponse(kTestRenderUrl, 1);
+        single_response.id = batch[1].id;
+        responses.emplace_back(single_response);
+        batch_callback(responses);
+        return absl::OkStatus();
+      });
+
+  std::vector<IGForBidding> igs;
+  igs.push_back(GetIGForBiddingFoo());
+  igs.push_back(GetIGForBiddingFoo());
+  igs.push_back(GetIGForBiddingBar());
+  CheckGenerateBids(
+      BuildGenerateBidsRawRequest({.interest_groups_to_add = std::move(igs)}),
+      expected_response,
+      BiddingServiceRuntimeConfig({.roma_timeout_duration = "1000ms",
+                                   .generate_bid_batch_size = 2}));
+}
+
 TEST_F(GenerateBidsReactorTest, FiltersBidsWithZeroBidPrice) {
   const std::vector<std::string> json_arr{GetTestResponse(kTestRenderUrl, 1),
                                           GetTestResponse(kTestRenderUrl, 0)};
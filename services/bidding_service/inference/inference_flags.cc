@@ -52,6 +52,20 @@ ABSL_FLAG(std::optional<std::int64_t>, inference_model_paths_request_timeout_ms,
           60000,
           "GRPC Timeout for GetModelPaths requests in milliseconds, "
           "60 seconds by default");
+ABSL_FLAG(std::optional<std::int64_t>, inference_max_batch_size, 0,
+          "Maximum number of inference requests from concurrent Roma "
+          "callbacks to send to the inference sidecar in one Predict request. "
+          "Only applies with inference_enable_proto_parsing. Batching is "
+          "disabled if the value is 0 or 1.");
+ABSL_FLAG(std::optional<std::int64_t>, inference_batch_timeout_us, 500,
+          "Maximum time in microseconds an inference request waits for more "
+          "requests to batch with, 500 microseconds by default");
+ABSL_FLAG(std::optional<std::string>, inference_model_shared_dir, std::nullopt,
+          "Absolute path of a directory, preferably on tmpfs (e.g. "
+          "/dev/shm/inference_models), where fetched model files are written "
+          "and shared with the inference sidecar instead of being copied "
+          "into RegisterModel requests. Model files are sent in the requests "
+          "if it is empty.");
 ABSL_FLAG(
     bool, inference_enable_cancellation_at_bidding, true,
     "If true, inference cancellation is enabled at the bidding service. "
@@ -35,6 +35,9 @@ ABSL_DECLARE_FLAG(std::optional<std::int64_t>,
                   inference_model_execution_timeout_ms);
 ABSL_DECLARE_FLAG(std::optional<std::int64_t>,
                   inference_model_paths_request_timeout_ms);
+ABSL_DECLARE_FLAG(std::optional<std::int64_t>, inference_max_batch_size);
+ABSL_DECLARE_FLAG(std::optional<std::int64_t>, inference_batch_timeout_us);
+ABSL_DECLARE_FLAG(std::optional<std::string>, inference_model_shared_dir);
 ABSL_DECLARE_FLAG(bool, inference_enable_cancellation_at_bidding);
 ABSL_DECLARE_FLAG(bool, inference_enable_proto_parsing);
 
@@ -64,6 +67,11 @@ inline constexpr char INFERENCE_MODEL_EXECUTION_TIMEOUT_MS[] =
     "INFERENCE_MODEL_EXECUTION_TIMEOUT_MS";
 inline constexpr char INFERENCE_MODEL_PATHS_REQUEST_TIMEOUT_MS[] =
     "INFERENCE_MODEL_PATHS_REQUEST_TIMEOUT_MS";
+inline constexpr char INFERENCE_MAX_BATCH_SIZE[] = "INFERENCE_MAX_BATCH_SIZE";
+inline constexpr char INFERENCE_BATCH_TIMEOUT_US[] =
+    "INFERENCE_BATCH_TIMEOUT_US";
+inline constexpr char INFERENCE_MODEL_SHARED_DIR[] =
+    "INFERENCE_MODEL_SHARED_DIR";
 
 inline constexpr absl::string_view kInferenceFlags[] = {
     INFERENCE_SIDECAR_BINARY_PATH,
@@ -14,12 +14,15 @@
 
 #include "services/bidding_service/inference/inference_utils.h"
 
+#include <filesystem>
 #include <fstream>
 #include <future>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -38,6 +41,7 @@
 #include "rapidjson/pointer.h"
 #include "rapidjson/writer.h"
 #include "services/bidding_service/inference/inference_flags.h"
+#include "services/bidding_service/inference/predict_request_batcher.h"
 #include "services/common/clients/code_dispatcher/request_context.h"
 #include "services/common/loggers/request_log_context.h"
 #include "services/common/metric/server_definition.h"
@@ -132,10 +136,24 @@ SandboxExecutor& Executor() {
   // Static object will be lazily initiated within static storage.
 
   // TODO(b/317124648): Pass a SandboxExecutor object via Roma's `TMetadata`.
-  static SandboxExecutor* executor = new SandboxExecutor(
-      absl::GetFlag(FLAGS_inference_sidecar_binary_path).value_or(""),
-      {absl::GetFlag(FLAGS_inference_sidecar_runtime_config).value_or("")},
-      absl::GetFlag(FLAGS_inference_sidecar_rlimit_mb).value_or(0));
+  static SandboxExecutor* executor = []() {
+    const std::string shared_model_dir =
+        absl::GetFlag(FLAGS_inference_model_shared_dir).value_or("");
+    if (!shared_model_dir.empty()) {
+      // The model fetcher writes the model files into subdirectories.
+      std::error_code error;
+      std::filesystem::create_directories(shared_model_dir, error);
+      if (error) {
+        PS_LOG(ERROR) << "Failed to create the shared model directory "
+                      << shared_model_dir << ": " << error.message();
+      }
+    }
+    return new SandboxExecutor(
+        absl::GetFlag(FLAGS_inference_sidecar_binary_path).value_or(""),
+        {absl::GetFlag(FLAGS_inference_sidecar_runtime_config).value_or("")},
+        absl::GetFlag(FLAGS_inference_sidecar_rlimit_mb).value_or(0),
+        shared_model_dir);
+  }();
   return *executor;
 }
 
@@ -278,12 +296,13 @@ void HandlePredictResponse(
     const BatchOrderedInferenceErrorResponse& parsing_errors,
     const absl::StatusOr<std::shared_ptr<RomaRequestContext>>&
         roma_request_context,
-    const grpc::Status& rpc_status, std::promise<void>& promise) {
+    const grpc::Status& rpc_status) {
   wrapper.metadata.ReportRPCFinish();
 
   // Handle the gRPC call result.
   if (rpc_status.ok()) {
-    if (InferenceUseProto()) {
+    // Binary requests are answered in JSON even if proto parsing is enabled.
+    if (InferenceUseProto() && !predict_response.has_output()) {
       absl::StatusOr<BatchInferenceResponse> merged_result =
           MergeBatchResponse(predict_response.proto_output(), parsing_errors);
       if (merged_result.ok()) {
@@ -299,7 +318,7 @@ void HandlePredictResponse(
         SetBatchErrorString(wrapper, Error::OUTPUT_PARSING,
                             merged_result.status().message());
       }
-    } else {  // rpc_status.ok() && !InferenceUseProto()
+    } else {  // rpc_status.ok() && JSON output
       wrapper.io_proto.set_output_string(predict_response.output());
     }
     if (roma_request_context.ok()) {
@@ -339,23 +358,89 @@ void HandlePredictResponse(
       }
     }
   }
-  promise.set_value();
+}
+
+// Returns the batcher of the concurrent inference requests, or nullptr if
+// batching is disabled.
+PredictRequestBatcher* GetPredictRequestBatcher() {
+  // TODO(b/314976301): Use absl::NoDestructor<T> when it becomes available.
+  // Static object will be lazily initiated within static storage.
+  static PredictRequestBatcher* batcher = []() -> PredictRequestBatcher* {
+    const int64_t max_batch_size =
+        absl::GetFlag(FLAGS_inference_max_batch_size).value_or(0);
+    if (max_batch_size <= 1) {
+      return nullptr;
+    }
+    return new PredictRequestBatcher(
+        max_batch_size,
+        absl::Microseconds(
+            absl::GetFlag(FLAGS_inference_batch_timeout_us).value_or(0)),
+        [stub = CreateInferenceStub()](grpc::ClientContext& context,
+                                       const PredictRequest& request,
+                                       PredictResponse& response) {
+          grpc::Status status;
+          std::promise<void> promise;
+          auto future = promise.get_future();
+          stub->async()->Predict(&context, &request, &response,
+                                 [&status, &promise](grpc::Status rpc_status) {
+                                   status = std::move(rpc_status);
+                                   promise.set_value();
+                                 });
+          future.wait();
+          return status;
+        });
+  }();
+  return batcher;
+}
+
+// Sends the inference requests along with the ones of other Roma workers.
+void RunBatchedInference(
+    google::scp::roma::FunctionBindingPayload<RomaRequestSharedContext>&
+        wrapper,
+    PredictRequestBatcher& batcher, PredictRequest& predict_request,
+    const BatchOrderedInferenceErrorResponse& parsing_errors,
+    const absl::StatusOr<std::shared_ptr<RomaRequestContext>>&
+        roma_request_context) {
+  std::optional<std::int64_t> timeout =
+      absl::GetFlag(FLAGS_inference_model_execution_timeout_ms);
+  PredictRequestBatcher::Result result = batcher.Predict(
+      std::move(*predict_request.mutable_proto_input()),
+      predict_request.is_consented(),
+      timeout.has_value() ? absl::Now() + absl::Milliseconds(*timeout)
+                          : absl::InfiniteFuture());
+  HandlePredictResponse(wrapper, result.response, parsing_errors,
+                        roma_request_context, result.status);
+  if (!roma_request_context.ok()) {
+    return;
+  }
+  if (auto inference_metric_context =
+          (*roma_request_context)->GetMetricContext();
+      inference_metric_context.ok()) {
+    metric::BiddingContext* context =
+        std::get<metric::BiddingContext*>(*inference_metric_context);
+    LogIfError(context->LogHistogram<metric::kBiddingInferenceBatchSize>(
+        result.batch_size));
+  }
 }
 
 void RunInferenceInternal(google::scp::roma::FunctionBindingPayload<
                               RomaRequestSharedContext>& wrapper,
                           InferenceService::StubInterface& stub) {
   // Parse input and prepare the request object.
-  const std::string& payload = wrapper.io_proto.input_string();
   PredictRequest predict_request;
   PS_VLOG(10) << "FLAGS_inference_enable_proto_parsing: "
               << InferenceUseProto();
 
   PredictResponse predict_response;
   BatchOrderedInferenceErrorResponse parsing_errors;
-  if (InferenceUseProto()) {
+  if (wrapper.io_proto.has_input_bytes()) {
+    // A binary request built from JS typed arrays is passed through as is:
+    // the sidecar parses it without copying the tensor contents.
+    predict_request.set_binary_input(
+        std::move(*wrapper.io_proto.mutable_input_bytes()));
+  } else if (InferenceUseProto()) {
     absl::StatusOr<BatchInferenceRequest> parsed_requests =
-        ConvertJsonToProto(payload, parsing_errors);
+        ConvertJsonToProto(wrapper.io_proto.input_string(), parsing_errors);
     if (!parsed_requests.ok()) {
       AddMetric(predict_response, "kInferenceErrorCountByErrorCode", 1,
                 std::string(kInferenceUnableToParseRequest));
@@ -365,7 +450,7 @@ void RunInferenceInternal(google::scp::roma::FunctionBindingPayload<
     }
     *predict_request.mutable_proto_input() = *std::move(parsed_requests);
   } else {
-    predict_request.set_input(payload);
+    predict_request.set_input(wrapper.io_proto.input_string());
   }
 
   // Fetch context and enrich the request.
@@ -398,14 +483,25 @@ void RunInferenceInternal(google::scp::roma::FunctionBindingPayload<
     }
   }
 
+  if (PredictRequestBatcher* batcher = GetPredictRequestBatcher();
+      batcher != nullptr && predict_request.has_proto_input()) {
+    // The batched RPC does not use the per-request context, so that a
+    // cancelled request does not cancel the ones batched with it.
+    RunBatchedInference(wrapper, *batcher, predict_request, parsing_errors,
+                        roma_request_context);
+    return;
+  }
+
   std::promise<void> promise;
   auto future = promise.get_future();
 
   stub.async()->Predict((*context).get(), &predict_request, &predict_response,
                         [&](const grpc::Status& rpc_status) {
-                          HandlePredictResponse(
-                              wrapper, predict_response, parsing_errors,
-                              roma_request_context, rpc_status, promise);
+                          HandlePredictResponse(wrapper, predict_response,
+                                                parsing_errors,
+                                                roma_request_context,
+                                                rpc_status);
+                          promise.set_value();
                         });
 
   future.wait();
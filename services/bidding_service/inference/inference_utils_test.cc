@@ -391,6 +391,31 @@ TEST_F(InferenceUtilsTest, RunInference_SuccessPathNonProto) {
   EXPECT_EQ(wrapper.io_proto.output_string(), expected_output);
 }
 
+TEST_F(InferenceUtilsTest, RunInference_PassesBinaryInputThrough) {
+  auto mock_stub = std::make_unique<MockInferenceStub>();
+  const std::string binary_input("\x01\x00\x00\x00binary", 10);
+  const std::string expected_output = "json output";
+
+  EXPECT_CALL(mock_stub->async_stub_,
+              Predict(_, _, _, An<std::function<void(grpc::Status)>>()))
+      .WillOnce([&binary_input, &expected_output](
+                    grpc::ClientContext* context, const PredictRequest* request,
+                    PredictResponse* response,
+                    const std::function<void(grpc::Status)>& callback) {
+        EXPECT_EQ(request->binary_input(), binary_input);
+        response->set_output(expected_output);
+        callback(grpc::Status::OK);
+      });
+
+  google::scp::roma::proto::FunctionBindingIoProto io_proto;
+  io_proto.set_input_bytes(binary_input);
+  google::scp::roma::FunctionBindingPayload<RomaRequestSharedContext> wrapper{
+      io_proto, {}};
+
+  RunInferenceInternal(wrapper, *mock_stub);
+  EXPECT_EQ(wrapper.io_proto.output_string(), expected_output);
+}
+
 TEST_F(InferenceUtilsTest, GetModelResponseToJsonOuput) {
   GetModelPathsResponse get_model_paths_response;
   EXPECT_EQ("[]", GetModelResponseToJson(get_model_paths_response));
@@ -32,6 +32,7 @@
 #include "absl/functional/any_invocable.h"
 #include "absl/log/check.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
@@ -44,6 +45,7 @@
 #include "src/logger/request_context_impl.h"
 #include "src/util/status_macro/status_macros.h"
 #include "src/util/status_macro/status_util.h"
+#include "utils/shared_model_files.h"
 
 namespace privacy_sandbox::bidding_auction_servers::inference {
 
@@ -52,17 +54,51 @@ constexpr size_t kMaxProtoMessageSize = 2ULL * 1024ULL * 1024ULL * 1024ULL;
 // Minimal duration to wait before trying to fetch model blobs again.
 constexpr absl::Duration kMinModelFetchPeriod = absl::Minutes(1);
 
+namespace {
+
+void DeleteSharedFiles(absl::string_view shared_files_dir) {
+  if (shared_files_dir.empty()) {
+    return;
+  }
+  if (absl::Status status = DeleteSharedModelFiles(shared_files_dir);
+      !status.ok()) {
+    PS_LOG(ERROR) << "Failed to delete shared model files: " << status;
+  }
+}
+
+}  // namespace
+
 PeriodicModelFetcher::PeriodicModelFetcher(
     absl::string_view config_path,
     std::unique_ptr<privacy_sandbox::bidding_auction_servers::BlobFetcherBase>&&
         blob_fetcher,
     std::unique_ptr<InferenceService::StubInterface>&& inference_stub,
-    server_common::Executor* executor, const absl::Duration& fetch_period_ms)
+    server_common::Executor* executor, const absl::Duration& fetch_period_ms,
+    absl::string_view shared_model_dir)
     : config_path_(config_path),
       blob_fetcher_(std::move(blob_fetcher)),
       inference_stub_(std::move(inference_stub)),
       executor_(*executor),
-      fetch_period_ms_(fetch_period_ms) {}
+      fetch_period_ms_(fetch_period_ms),
+      shared_model_dir_(shared_model_dir) {}
+
+absl::StatusOr<std::string> PeriodicModelFetcher::ShareModelFiles(
+    const std::vector<const BlobFetcherBase::Blob*>& blobs,
+    RegisterModelRequest& request) {
+  const std::string shared_files_dir =
+      absl::StrCat(shared_model_dir_, "/", num_shared_registrations_++);
+  for (const BlobFetcherBase::Blob* blob : blobs) {
+    absl::StatusOr<std::string> shared_path =
+        WriteSharedModelFile(shared_files_dir, blob->path, blob->bytes);
+    if (!shared_path.ok()) {
+      DeleteSharedFiles(shared_files_dir);
+      return shared_path.status();
+    }
+    (*request.mutable_shared_model_files())[blob->path] =
+        *std::move(shared_path);
+  }
+  return shared_files_dir;
+}
 
 absl::Status PeriodicModelFetcher::Start() {
   CHECK_GT(fetch_period_ms_, kMinModelFetchPeriod)
@@ -88,6 +124,7 @@ void PeriodicModelFetcher::DeleteModel(absl::string_view model_path)
     ModelFetcherMetric::IncrementModelDeletionFailedCountByStatus(
         server_common::ToAbslStatus(status).code());
   } else {
+    DeleteSharedFiles(model_entry_map_[model_path].shared_files_dir);
     model_entry_map_.erase(model_path);
     PS_LOG(INFO) << "Successful deletion of model: " << model_path;
     ModelFetcherMetric::IncrementModelDeletionSuccessCount();
@@ -257,16 +294,22 @@ void PeriodicModelFetcher::InternalModelFetchAndRegistration() {
       request.set_warm_up_batch_request_json(
           metadata.warm_up_batch_request_json());
     }
+    request.set_merge_batch_requests(metadata.merge_batch_requests());
     PS_VLOG(10) << "Start registering model for: " << model_path;
 
     std::vector<BlobFetcherBase::BlobView> blob_views;
+    std::vector<const BlobFetcherBase::Blob*> shared_blobs;
     for (const BlobFetcherBase::Blob& blob : bucket_snapshot) {
       // When model path ends with "/", we match all files under the directory.
       // When model path does not end with "/", we perform exact matching.
       if ((absl::EndsWith(model_path, "/") &&
            absl::StartsWith(blob.path, model_path)) ||
           blob.path == model_path) {
-        (*request.mutable_model_files())[blob.path] = blob.bytes;
+        if (shared_model_dir_.empty()) {
+          (*request.mutable_model_files())[blob.path] = blob.bytes;
+        } else {
+          shared_blobs.push_back(&blob);
+        }
         blob_views.push_back(blob.CreateBlobView());
       }
     }
@@ -300,6 +343,22 @@ void PeriodicModelFetcher::InternalModelFetchAndRegistration() {
       }
     }
 
+    std::string shared_files_dir;
+    if (!shared_blobs.empty()) {
+      absl::StatusOr<std::string> shared_dir =
+          ShareModelFiles(shared_blobs, request);
+      if (!shared_dir.ok()) {
+        PS_LOG(ERROR) << "Skip registering model for: " << model_path
+                      << " Failed to share model files: "
+                      << shared_dir.status();
+        ModelFetcherMetric::IncrementModelRegistrationFailedCountByStatus(
+            shared_dir.status().code());
+        failure_models.push_back(model_path);
+        continue;
+      }
+      shared_files_dir = *std::move(shared_dir);
+    }
+
     grpc::ClientContext context;
     RegisterModelResponse response;
     grpc::Status status =
@@ -308,6 +367,7 @@ void PeriodicModelFetcher::InternalModelFetchAndRegistration() {
     if (!status.ok()) {
       PS_LOG(ERROR) << "Registering model failure for: " << model_path
                     << " because of " << status.error_message();
+      DeleteSharedFiles(shared_files_dir);
       failure_models.push_back(model_path);
       ModelFetcherMetric::IncrementModelRegistrationFailedCountByStatus(
           server_common::ToAbslStatus(status).code());
@@ -316,7 +376,8 @@ void PeriodicModelFetcher::InternalModelFetchAndRegistration() {
       model_entry_map_[model_path] = {
           .checksum = metadata.checksum(),
           .eviction_grace_period_in_ms = metadata.eviction_grace_period_in_ms(),
-          .model_state = ModelState::ACTIVE};
+          .model_state = ModelState::ACTIVE,
+          .shared_files_dir = std::move(shared_files_dir)};
       success_models.push_back(model_path);
       if (response.metrics_list_size() != 0) {
         if (response.metrics_list().find(
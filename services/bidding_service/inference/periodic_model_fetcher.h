@@ -56,6 +56,9 @@ class PeriodicModelFetcher : public FetcherInterface {
     int eviction_grace_period_in_ms;
     // TODO(b/380455492): Consider moving model states to inference sidecar.
     ModelState model_state;
+    // Directory holding the model files shared with the inference sidecar, if
+    // any.
+    std::string shared_files_dir;
   };
   PeriodicModelFetcher(
       absl::string_view config_path,
@@ -63,7 +66,8 @@ class PeriodicModelFetcher : public FetcherInterface {
           privacy_sandbox::bidding_auction_servers::BlobFetcherBase>&&
           blob_fetcher,
       std::unique_ptr<InferenceService::StubInterface>&& inference_stub,
-      server_common::Executor* executor, const absl::Duration& fetch_period_ms);
+      server_common::Executor* executor, const absl::Duration& fetch_period_ms,
+      absl::string_view shared_model_dir = "");
 
   ~PeriodicModelFetcher() { End(); }
 
@@ -89,6 +93,12 @@ class PeriodicModelFetcher : public FetcherInterface {
   // Makes an RPC call to the inference sidecar to delete a single model.
   void DeleteModel(absl::string_view model_path)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(model_entry_mutex_);
+  // Writes the model files of `blobs` under a new directory of
+  // `shared_model_dir_` and adds them to `request`. Returns the directory.
+  absl::StatusOr<std::string> ShareModelFiles(
+      const std::vector<const BlobFetcherBase::Blob*>& blobs,
+      RegisterModelRequest& request)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(model_entry_mutex_);
   // Update model partition for request level metrics and the model availability
   // metric.
   void UpdateMetricsForAvailableModels()
@@ -104,11 +114,19 @@ class PeriodicModelFetcher : public FetcherInterface {
   // Keeps track of the next async task for the executor.
   absl::optional<server_common::TaskId> task_id_;
   const absl::Duration fetch_period_ms_;
+  // If not empty, model files are written to this directory and registered
+  // with the inference sidecar by path instead of being copied into the
+  // requests.
+  const std::string shared_model_dir_;
   // Addition or deletion of models reqiures locking on this mutex.
   absl::Mutex model_entry_mutex_;
   // Maintains a map from currently loaded models to their metadata.
   absl::flat_hash_map<std::string, ModelEntry> model_entry_map_
       ABSL_GUARDED_BY(model_entry_mutex_);
+  // Number of model registrations that shared their model files, used to give
+  // each registration its own directory. A model registered again (e.g. with
+  // updated content) then doesn't overwrite the files of its previous version.
+  int64_t num_shared_registrations_ ABSL_GUARDED_BY(model_entry_mutex_) = 0;
 };
 
 }  // namespace privacy_sandbox::bidding_auction_servers::inference
@@ -16,6 +16,9 @@
 
 #include "services/bidding_service/inference/periodic_model_fetcher.h"
 
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 #include <utility>
 #include <vector>
 
@@ -1032,5 +1035,89 @@ TEST_F(PeriodicModelFetcherTest, DirectModelPathShouldRegisterSingleModelFile) {
   model_fetcher.End();
 }
 
+TEST_F(PeriodicModelFetcherTest, SharesModelFilesAndDeletesThemWithModel) {
+  const std::string model_metadata_config = R"({
+        "model_metadata": [
+            {"model_path": "model1"},
+        ]
+  })";
+
+  const std::string empty_model_metadata_config = R"({
+        "model_metadata": []
+  })";
+
+  const std::vector<BlobFetcherBase::Blob> config_fetch_result = {
+      BlobFetcherBase::Blob(kModelConfigPath, model_metadata_config)};
+
+  const std::vector<BlobFetcherBase::Blob> empty_config_fetch_result = {
+      BlobFetcherBase::Blob(kModelConfigPath, empty_model_metadata_config)};
+
+  const std::vector<BlobFetcherBase::Blob> mock_snapshot = {
+      BlobFetcherBase::Blob(kTestModelName1, kTestModelContent1)};
+
+  const std::string shared_model_dir =
+      absl::StrCat(::testing::TempDir(), "/shared_models");
+  std::filesystem::remove_all(shared_model_dir);
+  const std::string shared_files_dir = absl::StrCat(shared_model_dir, "/0");
+  const std::string shared_model_path =
+      absl::StrCat(shared_files_dir, "/", kTestModelName1);
+
+  auto blob_fetcher = std::make_unique<BlobFetcherMock>();
+  auto mock_inference_stub = std::make_unique<MockInferenceServiceStub>();
+  auto executor = std::make_unique<MockExecutor>();
+
+  // Triggers periodic model fetching twice.
+  absl::BlockingCounter done(2);
+
+  {
+    InSequence s;
+    SetUpCloudFetchExpectation({kModelConfigPath}, config_fetch_result,
+                               *blob_fetcher);
+    SetUpCloudFetchExpectation({kTestModelName1}, mock_snapshot, *blob_fetcher);
+
+    RegisterModelRequest request;
+    request.mutable_model_spec()->set_model_path(kTestModelName1);
+    (*request.mutable_shared_model_files())[kTestModelName1] =
+        shared_model_path;
+    EXPECT_CALL(*mock_inference_stub, RegisterModel(_, EqualsProto(request), _))
+        .WillOnce([&shared_model_path](grpc::ClientContext* context,
+                                       const RegisterModelRequest& request,
+                                       RegisterModelResponse* response) {
+          std::ifstream ifs(shared_model_path, std::ios::binary);
+          std::stringstream contents;
+          contents << ifs.rdbuf();
+          EXPECT_EQ(contents.str(), kTestModelContent1);
+          return grpc::Status::OK;
+        });
+
+    // Second poll gets an empty config.
+    SetUpCloudFetchExpectation({kModelConfigPath}, empty_config_fetch_result,
+                               *blob_fetcher);
+    SetupDeleteModelExpectation(kTestModelName1, *mock_inference_stub);
+  }
+
+  EXPECT_CALL(*executor, RunAfter)
+      .Times(2)
+      .WillRepeatedly(
+          [&done](absl::Duration duration, absl::AnyInvocable<void()> closure) {
+            EXPECT_EQ(duration, kFetchPeriod);
+            if (!done.DecrementCount()) {
+              closure();
+            }
+            return server_common::TaskId();
+          });
+
+  PeriodicModelFetcher model_fetcher(
+      kModelConfigPath, std::move(blob_fetcher), std::move(mock_inference_stub),
+      executor.get(), kFetchPeriod, shared_model_dir);
+  auto status = model_fetcher.Start();
+  ASSERT_TRUE(status.ok()) << status;
+  done.Wait();
+  model_fetcher.End();
+
+  EXPECT_FALSE(std::filesystem::exists(shared_files_dir));
+  std::filesystem::remove_all(shared_model_dir);
+}
+
 }  // namespace
 }  // namespace privacy_sandbox::bidding_auction_servers::inference
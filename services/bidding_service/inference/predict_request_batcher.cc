@@ -0,0 +1,150 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/bidding_service/inference/predict_request_batcher.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "absl/container/btree_set.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/synchronization/notification.h"
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+
+struct PredictRequestBatcher::Batch {
+  PredictRequest request;
+  // Number of inference requests added by each caller, in order.
+  std::vector<int> caller_request_counts;
+  int size = 0;
+  absl::Time deadline = absl::InfiniteFuture();
+  // Set once the batch stops accepting requests. Guarded by the batcher's
+  // mutex.
+  bool sealed = false;
+  absl::Notification done;
+  grpc::Status status;
+  std::vector<PredictResponse> caller_responses;
+};
+
+namespace {
+
+// Returns the distinct model paths of `requests` as a single string.
+std::string GetModelKey(const BatchInferenceRequest& requests) {
+  absl::btree_set<absl::string_view> model_paths;
+  for (const InferenceRequestProto& request : requests.request()) {
+    model_paths.insert(request.model_path());
+  }
+  return absl::StrJoin(model_paths, ",");
+}
+
+}  // namespace
+
+PredictRequestBatcher::PredictRequestBatcher(int max_batch_size,
+                                             absl::Duration max_delay,
+                                             SendFunction send)
+    : max_batch_size_(max_batch_size),
+      max_delay_(max_delay),
+      send_(std::move(send)) {}
+
+PredictRequestBatcher::Result PredictRequestBatcher::Predict(
+    BatchInferenceRequest requests, bool is_consented, absl::Time deadline) {
+  const int num_requests = requests.request_size();
+  BatchKey key(is_consented, GetModelKey(requests));
+  std::shared_ptr<Batch> batch;
+  int caller_index = 0;
+  {
+    absl::MutexLock lock(&mu_);
+    auto it = open_batches_.find(key);
+    if (it != open_batches_.end() &&
+        it->second->size + num_requests > max_batch_size_) {
+      // No room left for these requests; lets the batch go.
+      it->second->sealed = true;
+      open_batches_.erase(it);
+      it = open_batches_.end();
+    }
+    const bool sends_batch = it == open_batches_.end();
+    if (sends_batch) {
+      batch = std::make_shared<Batch>();
+      batch->request.set_is_consented(is_consented);
+      it = open_batches_.emplace(key, batch).first;
+    } else {
+      batch = it->second;
+    }
+    caller_index = batch->caller_request_counts.size();
+    batch->caller_request_counts.push_back(num_requests);
+    batch->size += num_requests;
+    batch->deadline = std::min(batch->deadline, deadline);
+    auto& batch_requests = *batch->request.mutable_proto_input();
+    for (InferenceRequestProto& request : *requests.mutable_request()) {
+      *batch_requests.add_request() = std::move(request);
+    }
+    if (batch->size >= max_batch_size_) {
+      batch->sealed = true;
+      open_batches_.erase(it);
+    }
+    if (sends_batch) {
+      mu_.AwaitWithTimeout(absl::Condition(&batch->sealed), max_delay_);
+      if (!batch->sealed) {
+        batch->sealed = true;
+        open_batches_.erase(key);
+      }
+    }
+  }
+  if (caller_index == 0) {
+    SendBatch(*batch);
+  } else {
+    batch->done.WaitForNotification();
+  }
+  Result result{.status = batch->status, .batch_size = batch->size};
+  if (result.status.ok()) {
+    result.response = std::move(batch->caller_responses[caller_index]);
+  }
+  return result;
+}
+
+void PredictRequestBatcher::SendBatch(Batch& batch) {
+  grpc::ClientContext context;
+  if (batch.deadline != absl::InfiniteFuture()) {
+    context.set_deadline(absl::ToChronoTime(batch.deadline));
+  }
+  PredictResponse response;
+  batch.status = send_(context, batch.request, response);
+  auto& responses = *response.mutable_proto_output()->mutable_response();
+  if (batch.status.ok() && responses.size() != batch.size) {
+    batch.status = grpc::Status(
+        grpc::StatusCode::INTERNAL,
+        absl::StrCat("Expected ", batch.size, " inference responses, got ",
+                     responses.size()));
+  }
+  if (batch.status.ok()) {
+    batch.caller_responses.resize(batch.caller_request_counts.size());
+    int next_response = 0;
+    for (int i = 0; i < batch.caller_request_counts.size(); ++i) {
+      auto& caller_responses =
+          *batch.caller_responses[i].mutable_proto_output();
+      for (int j = 0; j < batch.caller_request_counts[i]; ++j) {
+        *caller_responses.add_response() =
+            std::move(responses[next_response++]);
+      }
+    }
+    *batch.caller_responses[0].mutable_metrics_list() =
+        std::move(*response.mutable_metrics_list());
+    *batch.caller_responses[0].mutable_debug_info() =
+        std::move(*response.mutable_debug_info());
+  }
+  batch.done.Notify();
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
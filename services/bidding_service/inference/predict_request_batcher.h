@@ -0,0 +1,92 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef SERVICES_BIDDING_SERVICE_INFERENCE_PREDICT_REQUEST_BATCHER_H_
+#define SERVICES_BIDDING_SERVICE_INFERENCE_PREDICT_REQUEST_BATCHER_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <grpcpp/grpcpp.h>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "proto/inference_payload.pb.h"
+#include "proto/inference_sidecar.pb.h"
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+
+// Collects the inference requests that the Roma workers issue concurrently
+// (e.g. from the generateBid executions of many interest groups) and sends
+// them to the inference sidecar as a single Predict RPC. The responses are
+// split back to the callers in the order of their requests.
+//
+// Only requests with the same consent and for the same model (or the same
+// mix of models) are batched together. A batch is sent once it holds
+// `max_batch_size` inference requests, or `max_delay` after its first caller
+// joined it, whichever comes first. The batched RPC uses the earliest deadline
+// of its callers and is not cancelled if a single caller's request is.
+class PredictRequestBatcher {
+ public:
+  // Sends `request` to the inference sidecar and blocks until `response`
+  // is populated.
+  using SendFunction = absl::AnyInvocable<grpc::Status(
+      grpc::ClientContext& context, const PredictRequest& request,
+      PredictResponse& response)>;
+
+  struct Result {
+    grpc::Status status;
+    // The responses to the caller's requests in `proto_output`. The metrics
+    // and debug info reported by the sidecar for the whole batch are only
+    // returned to the caller that sent the batch, so that they are logged
+    // once.
+    PredictResponse response;
+    // Number of inference requests sent in the same Predict RPC.
+    int batch_size = 0;
+  };
+
+  PredictRequestBatcher(int max_batch_size, absl::Duration max_delay,
+                        SendFunction send);
+
+  // Not copyable or movable.
+  PredictRequestBatcher(const PredictRequestBatcher&) = delete;
+  PredictRequestBatcher& operator=(const PredictRequestBatcher&) = delete;
+
+  // Adds `requests` to a batch and blocks until the batch response arrives.
+  Result Predict(BatchInferenceRequest requests, bool is_consented,
+                 absl::Time deadline) ABSL_LOCKS_EXCLUDED(mu_);
+
+ private:
+  struct Batch;
+  using BatchKey = std::pair<bool, std::string>;
+
+  // Sends the batch and splits its response among the callers.
+  void SendBatch(Batch& batch);
+
+  const int max_batch_size_;
+  const absl::Duration max_delay_;
+  SendFunction send_;
+  absl::Mutex mu_;
+  // Batches that are still accepting requests.
+  absl::flat_hash_map<BatchKey, std::shared_ptr<Batch>> open_batches_
+      ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
+
+#endif  // SERVICES_BIDDING_SERVICE_INFERENCE_PREDICT_REQUEST_BATCHER_H_
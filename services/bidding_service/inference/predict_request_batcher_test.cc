@@ -0,0 +1,237 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/bidding_service/inference/predict_request_batcher.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "gtest/gtest.h"
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+namespace {
+
+constexpr absl::string_view kModelPath = "model";
+
+BatchInferenceRequest CreateRequests(absl::string_view model_path,
+                                     absl::string_view tensor_name,
+                                     int num_requests = 1) {
+  BatchInferenceRequest requests;
+  for (int i = 0; i < num_requests; ++i) {
+    InferenceRequestProto* request = requests.add_request();
+    request->set_model_path(std::string(model_path));
+    request->add_tensors()->set_tensor_name(absl::StrCat(tensor_name, i));
+  }
+  return requests;
+}
+
+// Fake sidecar that echoes the tensors of each inference request and records
+// the size of each received batch.
+class FakeSidecar {
+ public:
+  PredictRequestBatcher::SendFunction SendFunction() {
+    return [this](grpc::ClientContext& context, const PredictRequest& request,
+                  PredictResponse& response) {
+      absl::MutexLock lock(&mu_);
+      batch_sizes_.push_back(request.proto_input().request_size());
+      consents_.push_back(request.is_consented());
+      for (const InferenceRequestProto& inference_request :
+           request.proto_input().request()) {
+        InferenceResponseProto* inference_response =
+            response.mutable_proto_output()->add_response();
+        inference_response->set_model_path(inference_request.model_path());
+        *inference_response->mutable_tensors() = inference_request.tensors();
+      }
+      MetricValue* metric =
+          (*response.mutable_metrics_list())["kInferenceRequestCount"]
+              .add_metrics();
+      metric->set_value_int32(request.proto_input().request_size());
+      return status_;
+    };
+  }
+
+  std::vector<int> batch_sizes() {
+    absl::MutexLock lock(&mu_);
+    return batch_sizes_;
+  }
+
+  std::vector<bool> consents() {
+    absl::MutexLock lock(&mu_);
+    return consents_;
+  }
+
+  void set_status(grpc::Status status) { status_ = std::move(status); }
+
+ private:
+  absl::Mutex mu_;
+  std::vector<int> batch_sizes_ ABSL_GUARDED_BY(mu_);
+  std::vector<bool> consents_ ABSL_GUARDED_BY(mu_);
+  grpc::Status status_;
+};
+
+TEST(PredictRequestBatcherTest, SendsConcurrentRequestsInOneBatch) {
+  constexpr int kNumCallers = 8;
+  FakeSidecar sidecar;
+  PredictRequestBatcher batcher(kNumCallers, absl::Seconds(60),
+                                sidecar.SendFunction());
+
+  std::vector<PredictRequestBatcher::Result> results(kNumCallers);
+  std::vector<std::thread> callers;
+  for (int i = 0; i < kNumCallers; ++i) {
+    callers.emplace_back([&batcher, &results, i]() {
+      results[i] = batcher.Predict(
+          CreateRequests(kModelPath, absl::StrCat("caller", i, "_")),
+          /*is_consented=*/false, absl::InfiniteFuture());
+    });
+  }
+  for (std::thread& caller : callers) {
+    caller.join();
+  }
+
+  EXPECT_EQ(sidecar.batch_sizes(), std::vector<int>{kNumCallers});
+  int callers_with_metrics = 0;
+  for (int i = 0; i < kNumCallers; ++i) {
+    ASSERT_TRUE(results[i].status.ok());
+    EXPECT_EQ(results[i].batch_size, kNumCallers);
+    ASSERT_EQ(results[i].response.proto_output().response_size(), 1);
+    const InferenceResponseProto& response =
+        results[i].response.proto_output().response(0);
+    EXPECT_EQ(response.model_path(), kModelPath);
+    ASSERT_EQ(response.tensors_size(), 1);
+    EXPECT_EQ(response.tensors(0).tensor_name(),
+              absl::StrCat("caller", i, "_0"));
+    callers_with_metrics += results[i].response.metrics_list_size();
+  }
+  EXPECT_EQ(callers_with_metrics, 1);
+}
+
+TEST(PredictRequestBatcherTest, SendsPartialBatchAfterMaxDelay) {
+  FakeSidecar sidecar;
+  PredictRequestBatcher batcher(/*max_batch_size=*/100, absl::Milliseconds(1),
+                                sidecar.SendFunction());
+
+  PredictRequestBatcher::Result result =
+      batcher.Predict(CreateRequests(kModelPath, "tensor", 2),
+                      /*is_consented=*/false, absl::InfiniteFuture());
+
+  ASSERT_TRUE(result.status.ok());
+  EXPECT_EQ(result.batch_size, 2);
+  ASSERT_EQ(result.response.proto_output().response_size(), 2);
+  EXPECT_EQ(result.response.proto_output().response(1).tensors(0).tensor_name(),
+            "tensor1");
+  EXPECT_EQ(result.response.metrics_list_size(), 1);
+  EXPECT_EQ(sidecar.batch_sizes(), std::vector<int>{2});
+}
+
+TEST(PredictRequestBatcherTest, SendsRequestsLargerThanMaxBatchSizeAlone) {
+  FakeSidecar sidecar;
+  PredictRequestBatcher batcher(/*max_batch_size=*/2, absl::Seconds(60),
+                                sidecar.SendFunction());
+
+  PredictRequestBatcher::Result result =
+      batcher.Predict(CreateRequests(kModelPath, "tensor", 3),
+                      /*is_consented=*/false, absl::InfiniteFuture());
+
+  ASSERT_TRUE(result.status.ok());
+  EXPECT_EQ(result.response.proto_output().response_size(), 3);
+  EXPECT_EQ(sidecar.batch_sizes(), std::vector<int>{3});
+}
+
+TEST(PredictRequestBatcherTest, DoesNotBatchDifferentConsents) {
+  FakeSidecar sidecar;
+  PredictRequestBatcher batcher(/*max_batch_size=*/2, absl::Milliseconds(100),
+                                sidecar.SendFunction());
+
+  std::thread consented_caller([&batcher]() {
+    batcher.Predict(CreateRequests(kModelPath, "consented"),
+                    /*is_consented=*/true, absl::InfiniteFuture());
+  });
+  batcher.Predict(CreateRequests(kModelPath, "not_consented"),
+                  /*is_consented=*/false, absl::InfiniteFuture());
+  consented_caller.join();
+
+  EXPECT_EQ(sidecar.batch_sizes(), (std::vector<int>{1, 1}));
+  std::vector<bool> consents = sidecar.consents();
+  std::sort(consents.begin(), consents.end());
+  EXPECT_EQ(consents, (std::vector<bool>{false, true}));
+}
+
+TEST(PredictRequestBatcherTest, DoesNotBatchDifferentModels) {
+  FakeSidecar sidecar;
+  PredictRequestBatcher batcher(/*max_batch_size=*/2, absl::Milliseconds(100),
+                                sidecar.SendFunction());
+
+  std::thread other_model_caller([&batcher]() {
+    batcher.Predict(CreateRequests("other_model", "tensor"),
+                    /*is_consented=*/false, absl::InfiniteFuture());
+  });
+  batcher.Predict(CreateRequests(kModelPath, "tensor"),
+                  /*is_consented=*/false, absl::InfiniteFuture());
+  other_model_caller.join();
+
+  EXPECT_EQ(sidecar.batch_sizes(), (std::vector<int>{1, 1}));
+}
+
+TEST(PredictRequestBatcherTest, ReturnsRpcErrorToAllCallers) {
+  constexpr int kNumCallers = 2;
+  FakeSidecar sidecar;
+  sidecar.set_status(grpc::Status(grpc::StatusCode::UNAVAILABLE, "down"));
+  PredictRequestBatcher batcher(kNumCallers, absl::Seconds(60),
+                                sidecar.SendFunction());
+
+  std::vector<PredictRequestBatcher::Result> results(kNumCallers);
+  std::vector<std::thread> callers;
+  for (int i = 0; i < kNumCallers; ++i) {
+    callers.emplace_back([&batcher, &results, i]() {
+      results[i] = batcher.Predict(CreateRequests(kModelPath, "tensor"),
+                                   /*is_consented=*/false,
+                                   absl::InfiniteFuture());
+    });
+  }
+  for (std::thread& caller : callers) {
+    caller.join();
+  }
+
+  for (const PredictRequestBatcher::Result& result : results) {
+    EXPECT_EQ(result.status.error_code(), grpc::StatusCode::UNAVAILABLE);
+  }
+}
+
+TEST(PredictRequestBatcherTest, SetsEarliestCallerDeadline) {
+  absl::Time deadline = absl::Now() + absl::Hours(1);
+  absl::Time batch_deadline;
+  PredictRequestBatcher batcher(
+      /*max_batch_size=*/1, absl::Seconds(60),
+      [&batch_deadline](grpc::ClientContext& context,
+                        const PredictRequest& request,
+                        PredictResponse& response) {
+        batch_deadline = absl::FromChrono(context.deadline());
+        response.mutable_proto_output()->add_response();
+        return grpc::Status::OK;
+      });
+
+  PredictRequestBatcher::Result result = batcher.Predict(
+      CreateRequests(kModelPath, "tensor"), /*is_consented=*/false, deadline);
+
+  ASSERT_TRUE(result.status.ok());
+  EXPECT_LE(absl::AbsDuration(batch_deadline - deadline),
+            absl::Milliseconds(1));
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
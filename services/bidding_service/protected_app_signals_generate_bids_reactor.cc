@@ -29,6 +29,7 @@
 #include "services/bidding_service/bidding_v8_constants.h"
 #include "services/bidding_service/code_wrapper/buyer_code_wrapper.h"
 #include "services/bidding_service/inference/inference_flags.h"
+#include "services/bidding_service/utils/bit_writer.h"
 #include "services/bidding_service/utils/egress.h"
 #include "services/bidding_service/utils/validation.h"
 #include "services/common/feature_flags.h"
@@ -69,32 +70,6 @@ inline void PopulateArgInRomaRequest(
   request[index] = std::make_shared<std::string>((arg.empty()) ? "\"\"" : arg);
 }
 
-absl::Status PopulateValuesForEgressFeatures(
-    rapidjson::Value&& values,
-    std::vector<std::unique_ptr<EgressFeature>>& egress_features) {
-  PS_ASSIGN_OR_RETURN(auto feature_array, GetArrayMember(values, "features"));
-  if (feature_array.Size() != egress_features.size()) {
-    return absl::InvalidArgumentError(absl::StrCat(
-        "Number of values in the egress payload: ", feature_array.Size(),
-        " doesn't match with egress "
-        "schema: ",
-        egress_features.size(), " (note: nullability is not supported yet)"));
-  }
-  int idx = 0;
-  for (rapidjson::Value& feat : feature_array) {
-    if (!feat.IsObject()) {
-      return absl::InvalidArgumentError(
-          absl::StrCat("Feature in egress payload at index ", idx,
-                       " is not an object, expected object"));
-    }
-    PS_VLOG(5) << "Setting the value using payload for feature at idx: " << idx;
-    PS_RETURN_IF_ERROR(egress_features[idx]->SetValue(std::move(feat)))
-        << "Failed to set value for feature at idx: " << idx;
-    ++idx;
-  }
-  return absl::OkStatus();
-}
-
 uint8_t GetEgressVectorHeader(uint32_t schema_version) {
   DCHECK_LE(schema_version, 7) << "Only 8 schema versions are supported";
   uint8_t header = schema_version << kEgressProtocolBitWidth;
@@ -102,16 +77,16 @@ uint8_t GetEgressVectorHeader(uint32_t schema_version) {
   return header;
 }
 
-// Returns all serialized features as a Base64 encoded byte string.
+// Validates the egress payload against the compiled schema and returns all
+// serialized features as a Base64 encoded byte string.
 absl::StatusOr<std::string> SerializeEgressFeatures(
-    uint32_t schema_version,
-    const std::vector<std::unique_ptr<EgressFeature>>& egress_features,
+    const CompiledEgressSchema& schema, const rapidjson::Value& egress_values,
     uint32_t egress_bit_limit) {
-  uint32_t total_size = 0;
-  for (const auto& egress_feature : egress_features) {
-    PS_VLOG(5) << "Size of feature: " << egress_feature->Size();
-    total_size += egress_feature->Size();
-  }
+  const uint32_t total_size = schema.plan->total_bits();
+  // The payload is validated before the size checks, so that an invalid
+  // payload is reported as such regardless of the size of the schema.
+  BitWriter writer(total_size);
+  PS_RETURN_IF_ERROR(schema.plan->Apply(egress_values, writer));
   PS_VLOG(5) << "Total size (without padding) in bits for egress features is: "
              << total_size;
   if (total_size == 0) {
@@ -123,48 +98,18 @@ absl::StatusOr<std::string> SerializeEgressFeatures(
                << " is greater than the system limit: " << egress_bit_limit;
     return "";
   }
-  // Round up to the nearest byte, if needed.
-  if (total_size % 8 != 0) {
-    PS_VLOG(5) << "Rounding up the total size to nearest byte";
-    total_size = (total_size / 8 + 1) * 8;
-  }
-  PS_VLOG(5) << "Total size (including any padding) in bits for egress "
-             << "features is: " << total_size;
-  std::vector<uint8_t> bytes_array(total_size / 8, 0);
-  int bytes_array_idx = bytes_array.size() - 1;
-  int feat_idx = 0;
-  int bit_position = 0;
-  for (const auto& egress_feature : egress_features) {
-    PS_VLOG(5) << "Serializing feature at index: " << feat_idx;
-    // TODO: Check if this returns NotFound and use a default value instead.
-    PS_ASSIGN_OR_RETURN(auto serialized_feature, egress_feature->Serialize());
-    PS_VLOG(5) << "Successfully serialized feature at index: " << feat_idx
-               << " to: " << DebugString(serialized_feature);
-    // Copy the serialized feature to the final byte array.
-    for (auto feat_val_it = serialized_feature.rbegin();
-         feat_val_it != serialized_feature.rend(); ++feat_val_it) {
-      if (bit_position > 0 && bit_position % 8 == 0) {
-        PS_VLOG(10) << "Resetting the bit position and advancing to next byte";
-        bit_position = 0;
-        --bytes_array_idx;
-      }
-      if (*feat_val_it) {
-        bytes_array[bytes_array_idx] |= (*feat_val_it << bit_position);
-      }
-      ++bit_position;
-      PS_VLOG(10) << "New bit position:, " << bit_position
-                  << " byte array idx: " << bytes_array_idx;
-    }
-    PS_VLOG(5) << "Successfully copied feature at index: " << feat_idx
-               << ", new overall vector: " << DebugString(bytes_array);
-    ++feat_idx;
-  }
-  bytes_array.emplace_back(GetEgressVectorHeader(schema_version));
-  std::string bytes_string(bytes_array.begin(), bytes_array.end());
+  // Features are packed into whole bytes, with any padding in the most
+  // significant bits of the first byte, and followed by the header byte.
+  std::string bytes_string;
+  bytes_string.reserve((total_size + 7) / 8 + 1);
+  writer.AppendBytes(bytes_string);
+  bytes_string.push_back(
+      static_cast<char>(GetEgressVectorHeader(schema.version)));
   std::string base64_encoded_string;
   absl::Base64Escape(bytes_string, &base64_encoded_string);
   PS_VLOG(5) << "Done serializing features to bit string: "
-             << DebugString(bytes_array)
+             << DebugString(std::vector<uint8_t>(bytes_string.begin(),
+                                                 bytes_string.end()))
              << ", base64 encoded string: " << base64_encoded_string;
   return base64_encoded_string;
 }
@@ -440,19 +385,14 @@ ProtectedAppSignalsGenerateBidsReactor::GetSerializedEgressPayload(
     absl::string_view schema_id, absl::string_view egress_payload,
     EgressSchemaCache& egress_schema_cache, int egress_bit_limit) {
   PS_VLOG(5) << "Fetching egress schema from cache";
-  PS_ASSIGN_OR_RETURN(auto schema_data, egress_schema_cache.Get(schema_id));
+  PS_ASSIGN_OR_RETURN(auto schema, egress_schema_cache.GetPlan(schema_id));
   PS_VLOG(5) << "Fetched egress schema successfully from cache, retreiving "
                 "features in egress payload: "
              << egress_payload;
   PS_ASSIGN_OR_RETURN(auto egress_values_doc, ParseJsonString(egress_payload));
-  PS_VLOG(5) << "Retrieved features from egress payload, setting them on the "
-                "egress features object next";
-  PS_RETURN_IF_ERROR(PopulateValuesForEgressFeatures(
-      std::move(egress_values_doc.Move()), schema_data.features));
-  PS_VLOG(5) << "Succeeded in setting features from egress payload to the "
-                "egress feature object, serializing the features next";
-  return SerializeEgressFeatures(schema_data.version, schema_data.features,
-                                 egress_bit_limit);
+  PS_VLOG(5) << "Retrieved features from egress payload, serializing them "
+                "with the compiled egress schema next";
+  return SerializeEgressFeatures(schema, egress_values_doc, egress_bit_limit);
 }
 
 void ProtectedAppSignalsGenerateBidsReactor::PopulateSerializedEgressPayload(
@@ -1081,7 +1081,7 @@ TEST_F(GenerateBidsReactorTest, UsesSchemaVersionsFromRequest) {
   auto unlimited_egress_mock = std::make_unique<EgressSchemaCacheMock>();
   EXPECT_CALL(
       *unlimited_egress_mock,
-      Get(raw_request.blob_versions().temporary_unlimited_egress_schema()))
+      GetPlan(raw_request.blob_versions().temporary_unlimited_egress_schema()))
       .Times(1);
 
   egress_schema_cache_ = std::move(unlimited_egress_mock);
@@ -1089,7 +1089,7 @@ TEST_F(GenerateBidsReactorTest, UsesSchemaVersionsFromRequest) {
   absl::SetFlag(&FLAGS_limited_egress_bits, 1);
   auto limited_egress_mock = std::make_unique<EgressSchemaCacheMock>();
   EXPECT_CALL(*limited_egress_mock,
-              Get(raw_request.blob_versions().egress_schema()))
+              GetPlan(raw_request.blob_versions().egress_schema()))
       .Times(1);
 
   limited_egress_schema_cache_ = std::move(limited_egress_mock);
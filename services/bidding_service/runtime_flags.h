@@ -65,8 +65,10 @@ inline constexpr absl::string_view CURL_BIDDING_WORK_QUEUE_LENGTH =
     "CURL_BIDDING_WORK_QUEUE_LENGTH";
 inline constexpr absl::string_view ENABLE_FDO_ATTESTATION =
     "ENABLE_FDO_ATTESTATION";
+inline constexpr absl::string_view GENERATE_BID_BATCH_SIZE =
+    "GENERATE_BID_BATCH_SIZE";
 
-inline constexpr int kNumRuntimeFlags = 21;
+inline constexpr int kNumRuntimeFlags = 22;
 inline constexpr std::array<absl::string_view, kNumRuntimeFlags> kFlags = {
     PORT,
     HEALTHCHECK_PORT,
@@ -89,6 +91,7 @@ inline constexpr std::array<absl::string_view, kNumRuntimeFlags> kFlags = {
     CURL_BIDDING_QUEUE_MAX_WAIT_MS,
     CURL_BIDDING_WORK_QUEUE_LENGTH,
     ENABLE_FDO_ATTESTATION,
+    GENERATE_BID_BATCH_SIZE,
 };
 
 inline std::vector<absl::string_view> GetServiceFlags() {
@@ -0,0 +1,101 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "services/bidding_service/utils/bit_writer.h"
+
+#include <algorithm>
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+namespace {
+
+inline constexpr uint32_t kWordBits = 64;
+
+uint32_t NumWords(uint32_t num_bits) {
+  return (num_bits + kWordBits - 1) / kWordBits;
+}
+
+}  // namespace
+
+BitWriter::BitWriter(uint32_t expected_num_bits) {
+  words_.reserve(NumWords(expected_num_bits));
+}
+
+void BitWriter::Write(uint64_t value, uint32_t num_bits) {
+  if (num_bits > kWordBits) {
+    Write(value, kWordBits);
+    WriteZeros(num_bits - kWordBits);
+    return;
+  }
+  if (num_bits == 0) {
+    return;
+  }
+  if (num_bits < kWordBits) {
+    value &= (uint64_t{1} << num_bits) - 1;
+  }
+
+  // Bits above `num_bits_` in the last word are always zero, so the field can
+  // be OR-ed in.
+  const uint32_t offset = num_bits_ % kWordBits;
+  if (offset == 0) {
+    words_.push_back(value);
+  } else {
+    words_.back() |= value << offset;
+    if (offset + num_bits > kWordBits) {
+      words_.push_back(value >> (kWordBits - offset));
+    }
+  }
+  num_bits_ += num_bits;
+}
+
+void BitWriter::WriteSigned(int64_t value, uint32_t num_bits) {
+  const uint64_t bits = static_cast<uint64_t>(value);
+  if (num_bits <= kWordBits || value >= 0) {
+    Write(bits, num_bits);
+    return;
+  }
+  Write(bits, kWordBits);
+  for (uint32_t remaining = num_bits - kWordBits; remaining > 0;) {
+    const uint32_t chunk = std::min(remaining, kWordBits);
+    Write(~uint64_t{0}, chunk);
+    remaining -= chunk;
+  }
+}
+
+void BitWriter::WriteZeros(uint32_t num_bits) {
+  num_bits_ += num_bits;
+  words_.resize(NumWords(num_bits_), 0);
+}
+
+void BitWriter::AppendBytes(std::string& out) const {
+  const uint32_t num_bytes = (num_bits_ + 7) / 8;
+  const size_t start = out.size();
+  out.resize(start + num_bytes);
+  // Byte i (counting from the least significant end) of the number is byte
+  // i % 8 of word i / 8.
+  for (uint32_t i = 0; i < num_bytes; ++i) {
+    out[start + num_bytes - 1 - i] =
+        static_cast<char>(words_[i / 8] >> (8 * (i % 8)));
+  }
+}
+
+std::vector<bool> BitWriter::ToBits() const {
+  std::vector<bool> bits(num_bits_);
+  for (uint32_t i = 0; i < num_bits_; ++i) {
+    bits[num_bits_ - 1 - i] = (words_[i / kWordBits] >> (i % kWordBits)) & 1;
+  }
+  return bits;
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,68 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SERVICES_BIDDING_SERVICE_UTILS_BIT_WRITER_H_
+#define SERVICES_BIDDING_SERVICE_UTILS_BIT_WRITER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// Accumulates fixed width fields into a bit string packed in 64-bit words.
+//
+// The bit string is treated as one large unsigned integer: every field is
+// placed right above the previously written ones, i.e. the first field
+// written ends up in the least significant bits. This is the layout of the
+// egress payload, where the first feature of the schema occupies the least
+// significant bits of the (big-endian) payload.
+class BitWriter {
+ public:
+  // `expected_num_bits` is only used to reserve space up front.
+  explicit BitWriter(uint32_t expected_num_bits = 0);
+
+  // Appends the `num_bits` least significant bits of `value`. Fields wider
+  // than 64 bits are zero extended.
+  void Write(uint64_t value, uint32_t num_bits);
+
+  // Appends the `num_bits` wide two's complement representation of `value`.
+  // Fields wider than 64 bits are sign extended.
+  void WriteSigned(int64_t value, uint32_t num_bits);
+
+  // Appends a single bit.
+  void WriteBit(bool bit) { Write(bit ? 1 : 0, 1); }
+
+  // Appends `num_bits` zero bits.
+  void WriteZeros(uint32_t num_bits);
+
+  // Returns the number of bits written so far.
+  uint32_t NumBits() const { return num_bits_; }
+
+  // Appends the bit string as a big-endian number of (NumBits() + 7) / 8
+  // bytes to `out`. Padding bits, if any, are the most significant bits of
+  // the first byte and are zero.
+  void AppendBytes(std::string& out) const;
+
+  // Returns the bit string, most significant (i.e. last written) bit first.
+  std::vector<bool> ToBits() const;
+
+ private:
+  std::vector<uint64_t> words_;
+  uint32_t num_bits_ = 0;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_BIDDING_SERVICE_UTILS_BIT_WRITER_H_
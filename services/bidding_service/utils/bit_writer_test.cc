@@ -0,0 +1,148 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "services/bidding_service/utils/bit_writer.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+std::vector<bool> Bits(absl::string_view bit_string) {
+  std::vector<bool> bits;
+  for (char c : bit_string) {
+    bits.push_back(c == '1');
+  }
+  return bits;
+}
+
+TEST(BitWriterTest, EmptyWriter) {
+  BitWriter writer;
+  EXPECT_EQ(writer.NumBits(), 0);
+  EXPECT_TRUE(writer.ToBits().empty());
+  std::string bytes;
+  writer.AppendBytes(bytes);
+  EXPECT_TRUE(bytes.empty());
+}
+
+TEST(BitWriterTest, FirstFieldIsLeastSignificant) {
+  BitWriter writer;
+  writer.Write(0b10, 2);
+  writer.Write(0b101, 3);
+  writer.WriteBit(true);
+  EXPECT_EQ(writer.NumBits(), 6);
+  EXPECT_EQ(writer.ToBits(), Bits("110110"));
+}
+
+TEST(BitWriterTest, DropsBitsAboveWidth) {
+  BitWriter writer;
+  writer.Write(0xFF, 3);
+  writer.Write(0, 2);
+  EXPECT_EQ(writer.ToBits(), Bits("00111"));
+}
+
+TEST(BitWriterTest, WritesSignedAsTwosComplement) {
+  BitWriter writer;
+  writer.WriteSigned(-3, 3);
+  writer.WriteSigned(2, 3);
+  writer.WriteSigned(-1, 4);
+  EXPECT_EQ(writer.ToBits(), Bits("1111010101"));
+}
+
+TEST(BitWriterTest, ZeroAndSignExtendsWideFields) {
+  BitWriter writer;
+  writer.Write(1, 66);
+  writer.WriteSigned(-1, 70);
+  std::vector<bool> expected(70, true);
+  expected.resize(136, false);
+  expected.back() = true;
+  EXPECT_EQ(writer.ToBits(), expected);
+}
+
+TEST(BitWriterTest, WriteZerosAcrossWords) {
+  BitWriter writer;
+  writer.WriteBit(true);
+  writer.WriteZeros(130);
+  writer.WriteBit(true);
+  EXPECT_EQ(writer.NumBits(), 132);
+  std::vector<bool> expected(132, false);
+  expected.front() = true;
+  expected.back() = true;
+  EXPECT_EQ(writer.ToBits(), expected);
+}
+
+TEST(BitWriterTest, AppendsBigEndianBytesWithLeadingPadding) {
+  BitWriter writer;
+  writer.Write(0x34, 8);
+  writer.Write(0x12, 8);
+  writer.Write(0b101, 3);
+  std::string bytes = "x";
+  writer.AppendBytes(bytes);
+  EXPECT_EQ(bytes, std::string("x\x05\x12\x34", 4));
+}
+
+// Reference implementation: copies each field's bits one at a time into a
+// byte array that is filled from the back, as egress features used to be.
+std::string PackBitByBit(const std::vector<std::vector<bool>>& fields) {
+  int total_size = 0;
+  for (const auto& field : fields) {
+    total_size += field.size();
+  }
+  std::string bytes((total_size + 7) / 8, '\0');
+  int byte_idx = bytes.size() - 1;
+  int bit_position = 0;
+  for (const auto& field : fields) {
+    for (auto it = field.rbegin(); it != field.rend(); ++it) {
+      if (bit_position > 0 && bit_position % 8 == 0) {
+        bit_position = 0;
+        --byte_idx;
+      }
+      if (*it) {
+        bytes[byte_idx] |= (1 << bit_position);
+      }
+      ++bit_position;
+    }
+  }
+  return bytes;
+}
+
+TEST(BitWriterTest, MatchesBitByBitPacking) {
+  std::mt19937 rng(42);
+  for (int run = 0; run < 100; ++run) {
+    BitWriter writer;
+    std::vector<std::vector<bool>> fields;
+    const int num_fields = std::uniform_int_distribution<int>(1, 40)(rng);
+    for (int i = 0; i < num_fields; ++i) {
+      const uint32_t width = std::uniform_int_distribution<int>(1, 64)(rng);
+      const uint64_t value = rng() | (static_cast<uint64_t>(rng()) << 32);
+      writer.Write(value, width);
+      std::vector<bool> field(width);
+      for (uint32_t bit = 0; bit < width; ++bit) {
+        field[width - 1 - bit] = (value >> bit) & 1;
+      }
+      fields.push_back(std::move(field));
+    }
+    std::string bytes;
+    writer.AppendBytes(bytes);
+    ASSERT_EQ(bytes, PackBitByBit(fields)) << "run: " << run;
+  }
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
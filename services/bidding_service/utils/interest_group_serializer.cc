@@ -0,0 +1,177 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "services/bidding_service/utils/interest_group_serializer.h"
+
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+using IGForBidding =
+    GenerateBidsRequest::GenerateBidsRawRequest::InterestGroupForBidding;
+using RepeatedStringField = google::protobuf::RepeatedPtrField<std::string>;
+
+// Field prefixes, including the separator from the preceding field. The name
+// is always present and therefore always comes first.
+constexpr absl::string_view kNamePrefix = R"JSON({"name":)JSON";
+constexpr absl::string_view kTrustedBiddingSignalsKeysPrefix =
+    R"JSON(,"trustedBiddingSignalsKeys":)JSON";
+constexpr absl::string_view kAdRenderIdsPrefix = R"JSON(,"adRenderIds":)JSON";
+constexpr absl::string_view kAdComponentRenderIdsPrefix =
+    R"JSON(,"adComponentRenderIds":)JSON";
+constexpr absl::string_view kUserBiddingSignalsPrefix =
+    R"JSON(,"userBiddingSignals":)JSON";
+
+constexpr char kHexDigits[] = "0123456789ABCDEF";
+
+// Returns the escape character for characters that have a short escape
+// sequence, 'u' for other control characters and 0 for characters that are
+// written as is. Matches the escaping of rapidjson::Writer.
+char GetEscapeChar(unsigned char c) {
+  switch (c) {
+    case '"':
+      return '"';
+    case '\\':
+      return '\\';
+    case '\b':
+      return 'b';
+    case '\f':
+      return 'f';
+    case '\n':
+      return 'n';
+    case '\r':
+      return 'r';
+    case '\t':
+      return 't';
+    default:
+      return c < 0x20 ? 'u' : 0;
+  }
+}
+
+size_t GetJsonStringSize(absl::string_view value) {
+  // Opening and closing quotes.
+  size_t size = value.size() + 2;
+  for (unsigned char c : value) {
+    switch (GetEscapeChar(c)) {
+      case 0:
+        break;
+      case 'u':
+        // \u00XX
+        size += 5;
+        break;
+      default:
+        size += 1;
+    }
+  }
+  return size;
+}
+
+void AppendJsonString(absl::string_view value, std::string& out) {
+  out.push_back('"');
+  for (unsigned char c : value) {
+    const char escape_char = GetEscapeChar(c);
+    if (escape_char == 0) {
+      out.push_back(c);
+      continue;
+    }
+    out.push_back('\\');
+    out.push_back(escape_char);
+    if (escape_char == 'u') {
+      out.append("00");
+      out.push_back(kHexDigits[c >> 4]);
+      out.push_back(kHexDigits[c & 0xF]);
+    }
+  }
+  out.push_back('"');
+}
+
+size_t GetJsonStringArraySize(const RepeatedStringField& values) {
+  // Brackets and separators.
+  size_t size = 2 + (values.empty() ? 0 : values.size() - 1);
+  for (const auto& value : values) {
+    size += GetJsonStringSize(value);
+  }
+  return size;
+}
+
+void AppendJsonStringArray(const RepeatedStringField& values,
+                           std::string& out) {
+  out.push_back('[');
+  for (int i = 0; i < values.size(); ++i) {
+    if (i > 0) {
+      out.push_back(',');
+    }
+    AppendJsonString(values[i], out);
+  }
+  out.push_back(']');
+}
+
+}  // namespace
+
+size_t GetSerializedIGSize(const IGForBidding& ig) {
+  // Closing brace.
+  size_t size = kNamePrefix.size() + GetJsonStringSize(ig.name()) + 1;
+  if (!ig.trusted_bidding_signals_keys().empty()) {
+    size += kTrustedBiddingSignalsKeysPrefix.size() +
+            GetJsonStringArraySize(ig.trusted_bidding_signals_keys());
+  }
+  if (!ig.ad_render_ids().empty()) {
+    size += kAdRenderIdsPrefix.size() +
+            GetJsonStringArraySize(ig.ad_render_ids());
+  }
+  if (!ig.ad_component_render_ids().empty()) {
+    size += kAdComponentRenderIdsPrefix.size() +
+            GetJsonStringArraySize(ig.ad_component_render_ids());
+  }
+  if (!ig.user_bidding_signals().empty()) {
+    size += kUserBiddingSignalsPrefix.size() + ig.user_bidding_signals().size();
+  }
+  return size;
+}
+
+void AppendSerializedIG(const IGForBidding& ig, std::string& out) {
+  absl::StrAppend(&out, kNamePrefix);
+  AppendJsonString(ig.name(), out);
+  if (!ig.trusted_bidding_signals_keys().empty()) {
+    absl::StrAppend(&out, kTrustedBiddingSignalsKeysPrefix);
+    AppendJsonStringArray(ig.trusted_bidding_signals_keys(), out);
+  }
+  if (!ig.ad_render_ids().empty()) {
+    absl::StrAppend(&out, kAdRenderIdsPrefix);
+    AppendJsonStringArray(ig.ad_render_ids(), out);
+  }
+  if (!ig.ad_component_render_ids().empty()) {
+    absl::StrAppend(&out, kAdComponentRenderIdsPrefix);
+    AppendJsonStringArray(ig.ad_component_render_ids(), out);
+  }
+  // User bidding signals need no transformation.
+  if (!ig.user_bidding_signals().empty()) {
+    absl::StrAppend(&out, kUserBiddingSignalsPrefix);
+    out.append(ig.user_bidding_signals());
+  }
+  out.push_back('}');
+}
+
+std::string SerializeIG(const IGForBidding& ig) {
+  std::string serialized_ig;
+  serialized_ig.reserve(GetSerializedIGSize(ig));
+  AppendSerializedIG(ig, serialized_ig);
+  return serialized_ig;
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,54 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SERVICES_BIDDING_SERVICE_UTILS_INTEREST_GROUP_SERIALIZER_H_
+#define SERVICES_BIDDING_SERVICE_UTILS_INTEREST_GROUP_SERIALIZER_H_
+
+#include <cstddef>
+#include <string>
+
+#include "api/bidding_auction_servers.pb.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// Serializes the interest group into the JSON passed to generateBid().
+// Empty fields are not included at all in the serialized JSON and no default,
+// null or dummy values are filled in. Device signals and trusted bidding
+// signals are not serialized since they are passed to generateBid() in
+// different parameters. User bidding signals are expected to be valid JSON and
+// are copied as is.
+//
+// The JSON is written in a single pass, into a string that is sized exactly
+// up front.
+std::string SerializeIG(
+    const GenerateBidsRequest::GenerateBidsRawRequest::InterestGroupForBidding&
+        ig);
+
+// Same as above but appends the JSON to `out`, so that a buffer can be reused
+// across interest groups. `out` isn't reserved, since an exact reserve per
+// interest group would reallocate the buffer each time; callers appending
+// several interest groups reserve the sum of their GetSerializedIGSize() once.
+void AppendSerializedIG(
+    const GenerateBidsRequest::GenerateBidsRawRequest::InterestGroupForBidding&
+        ig,
+    std::string& out);
+
+// Returns the exact size of the JSON the functions above produce for `ig`.
+size_t GetSerializedIGSize(
+    const GenerateBidsRequest::GenerateBidsRawRequest::InterestGroupForBidding&
+        ig);
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_BIDDING_SERVICE_UTILS_INTEREST_GROUP_SERIALIZER_H_
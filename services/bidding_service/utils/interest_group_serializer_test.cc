@@ -0,0 +1,107 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/bidding_service/utils/interest_group_serializer.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "rapidjson/document.h"
+#include "services/common/test/random.h"
+#include "services/common/util/json_util.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+using IGForBidding =
+    GenerateBidsRequest::GenerateBidsRawRequest::InterestGroupForBidding;
+
+constexpr char kTestStringWithSpecialChars[] =
+    "stop\", \"custom_key\": \"val\\\n\t\x01/\xc3\xa9";
+
+TEST(SerializeIGTest, SerializesOnlyTheNameOfAnEmptyIG) {
+  IGForBidding ig;
+  ig.set_name("ig_name");
+  EXPECT_EQ(SerializeIG(ig), R"JSON({"name":"ig_name"})JSON");
+}
+
+TEST(SerializeIGTest, SerializesAllFieldsInOrder) {
+  IGForBidding ig;
+  ig.set_name("ig_name");
+  ig.add_trusted_bidding_signals_keys("key_1");
+  ig.add_trusted_bidding_signals_keys("key_2");
+  ig.add_ad_render_ids("ad_1");
+  ig.add_ad_component_render_ids("component_1");
+  ig.add_ad_component_render_ids("component_2");
+  ig.set_user_bidding_signals(R"JSON({"signal":[1,2]})JSON");
+  // Neither of these is part of the serialized interest group.
+  ig.set_trusted_bidding_signals(R"JSON({"key_1":1})JSON");
+  ig.mutable_browser_signals_for_bidding()->set_join_count(5);
+
+  EXPECT_EQ(
+      SerializeIG(ig),
+      R"JSON({"name":"ig_name",)JSON"
+      R"JSON("trustedBiddingSignalsKeys":["key_1","key_2"],)JSON"
+      R"JSON("adRenderIds":["ad_1"],)JSON"
+      R"JSON("adComponentRenderIds":["component_1","component_2"],)JSON"
+      R"JSON("userBiddingSignals":{"signal":[1,2]}})JSON");
+}
+
+TEST(SerializeIGTest, EscapesStringsLikeRapidjson) {
+  IGForBidding ig;
+  ig.set_name(kTestStringWithSpecialChars);
+  ig.add_ad_render_ids(kTestStringWithSpecialChars);
+
+  rapidjson::Document expected(rapidjson::kObjectType);
+  rapidjson::Document::AllocatorType& allocator = expected.GetAllocator();
+  rapidjson::Value ad_render_ids(rapidjson::kArrayType);
+  ad_render_ids.PushBack(
+      rapidjson::Value(kTestStringWithSpecialChars, allocator).Move(),
+      allocator);
+  expected.AddMember("name",
+                     rapidjson::Value(kTestStringWithSpecialChars, allocator),
+                     allocator);
+  expected.AddMember("adRenderIds", ad_render_ids, allocator);
+  absl::StatusOr<std::string> expected_json = SerializeJsonDoc(expected);
+  ASSERT_TRUE(expected_json.ok());
+
+  std::string serialized_ig = SerializeIG(ig);
+  EXPECT_EQ(serialized_ig, *expected_json);
+  absl::StatusOr<rapidjson::Document> parsed_ig =
+      ParseJsonString(serialized_ig);
+  ASSERT_TRUE(parsed_ig.ok());
+  EXPECT_TRUE(parsed_ig->FindMember("custom_key") == parsed_ig->MemberEnd());
+  EXPECT_STREQ((*parsed_ig)["name"].GetString(), kTestStringWithSpecialChars);
+}
+
+TEST(SerializeIGTest, ComputesExactSize) {
+  IGForBidding ig = MakeALargeInterestGroupForBiddingForLatencyTesting();
+  ig.add_ad_render_ids(kTestStringWithSpecialChars);
+  std::string serialized_ig = SerializeIG(ig);
+  EXPECT_EQ(GetSerializedIGSize(ig), serialized_ig.size());
+}
+
+TEST(SerializeIGTest, AppendsToBuffer) {
+  IGForBidding ig;
+  ig.set_name("ig_name");
+  std::string buffer = "[";
+  AppendSerializedIG(ig, buffer);
+  buffer.push_back(',');
+  AppendSerializedIG(ig, buffer);
+  buffer.push_back(']');
+  EXPECT_EQ(buffer, R"JSON([{"name":"ig_name"},{"name":"ig_name"}])JSON");
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
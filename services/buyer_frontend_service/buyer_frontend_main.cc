@@ -32,11 +32,15 @@
 #include "services/buyer_frontend_service/buyer_frontend_service.h"
 #include "services/buyer_frontend_service/providers/http_bidding_signals_async_provider.h"
 #include "services/buyer_frontend_service/runtime_flags.h"
+#include "services/common/chaffing/moving_median.h"
 #include "services/common/clients/bidding_server/bidding_async_client.h"
 #include "services/common/clients/config/trusted_server_config_client.h"
 #include "services/common/clients/config/trusted_server_config_client_util.h"
+#include "services/common/clients/http/curl_connection_metrics.h"
 #include "services/common/clients/http/multi_curl_http_fetcher_async.h"
+#include "services/common/clients/http/single_flight_http_fetcher_async.h"
 #include "services/common/clients/http_kv_server/buyer/buyer_key_value_async_http_client.h"
+#include "services/common/clients/http_kv_server/buyer/caching_buyer_key_value_async_client.h"
 #include "services/common/clients/http_kv_server/buyer/fake_buyer_key_value_async_http_client.h"
 #include "services/common/constants/common_constants.h"
 #include "services/common/encryption/crypto_client_factory.h"
@@ -118,6 +122,24 @@ ABSL_FLAG(std::optional<int>, curl_bfe_queue_max_wait_ms, 1000,
 ABSL_FLAG(std::optional<int>, curl_bfe_work_queue_length, 5000,
           "Maximum number of outstanding curl requests that are allowed to "
           "wait for processing");
+ABSL_FLAG(std::optional<bool>, curl_bfe_enable_work_stealing, false,
+          "Whether idle curl workers steal queued requests from busy ones");
+ABSL_FLAG(std::optional<int>, buyer_kv_cache_ttl_ms, 0,
+          "How long (in milliseconds) BFE serves the buyer KV values of a key "
+          "from its cache. The cache is disabled if 0");
+ABSL_FLAG(std::optional<int>, buyer_kv_cache_max_entries, 65536,
+          "Maximum number of keys whose buyer KV values are cached");
+ABSL_FLAG(std::optional<bool>, curl_bfe_enable_http2_multiplexing, false,
+          "Multiplex the buyer KV requests to a host over its HTTP/2 "
+          "connections instead of opening a connection per concurrent "
+          "request");
+ABSL_FLAG(std::optional<int>, curl_bfe_max_concurrent_streams, 0,
+          "Maximum number of concurrent streams per HTTP/2 connection when "
+          "curl_bfe_enable_http2_multiplexing is set. libcurl's default (100) "
+          "is used if 0");
+ABSL_FLAG(std::optional<bool>, curl_bfe_enable_single_flight, false,
+          "Send identical buyer KV GET requests that are in flight at the "
+          "same time as a single transfer");
 
 namespace privacy_sandbox::bidding_auction_servers {
 
@@ -216,6 +238,17 @@ absl::StatusOr<TrustedServersConfigClient> GetConfigClient(
                         CURL_BFE_QUEUE_MAX_WAIT_MS);
   config_client.SetFlag(FLAGS_curl_bfe_work_queue_length,
                         CURL_BFE_WORK_QUEUE_LENGTH);
+  config_client.SetFlag(FLAGS_curl_bfe_enable_work_stealing,
+                        CURL_BFE_ENABLE_WORK_STEALING);
+  config_client.SetFlag(FLAGS_buyer_kv_cache_ttl_ms, BUYER_KV_CACHE_TTL_MS);
+  config_client.SetFlag(FLAGS_buyer_kv_cache_max_entries,
+                        BUYER_KV_CACHE_MAX_ENTRIES);
+  config_client.SetFlag(FLAGS_curl_bfe_enable_single_flight,
+                        CURL_BFE_ENABLE_SINGLE_FLIGHT);
+  config_client.SetFlag(FLAGS_curl_bfe_enable_http2_multiplexing,
+                        CURL_BFE_ENABLE_HTTP2_MULTIPLEXING);
+  config_client.SetFlag(FLAGS_curl_bfe_max_concurrent_streams,
+                        CURL_BFE_MAX_CONCURRENT_STREAMS);
 
   PS_RETURN_IF_ERROR(
       MaybeInitConfigClient(absl::GetFlag(FLAGS_init_config_client),
@@ -343,8 +376,7 @@ absl::Status RunServer() {
         config_client.GetIntParameter(CURL_BFE_QUEUE_MAX_WAIT_MS);
     int curl_queue_length =
         config_client.GetIntParameter(CURL_BFE_WORK_QUEUE_LENGTH);
-    buyer_kv_async_http_client = std::make_unique<BuyerKeyValueAsyncHttpClient>(
-        buyer_kv_server_addr,
+    std::unique_ptr<HttpFetcherAsync> http_fetcher_async =
         std::make_unique<MultiCurlHttpFetcherAsync>(
             executor.get(),
             MultiCurlHttpFetcherAsyncOptions{
@@ -364,8 +396,35 @@ absl::Status RunServer() {
                 .curl_queue_length = curl_queue_length > 0
                                          ? curl_queue_length
                                          : kDefaultMaxCurlPendingRequests,
-            }),
-        true);
+                .enable_work_stealing = config_client.GetBooleanParameter(
+                    CURL_BFE_ENABLE_WORK_STEALING),
+                .enable_http2_multiplexing = config_client.GetBooleanParameter(
+                    CURL_BFE_ENABLE_HTTP2_MULTIPLEXING),
+                .curlmopt_max_concurrent_streams =
+                    config_client.GetIntParameter(
+                        CURL_BFE_MAX_CONCURRENT_STREAMS),
+            });
+    PS_RETURN_IF_ERROR(CurlConnectionMetrics::RegisterBfeMetrics());
+    if (config_client.GetBooleanParameter(CURL_BFE_ENABLE_SINGLE_FLIGHT)) {
+      PS_RETURN_IF_ERROR(SingleFlightHttpFetcherMetrics::RegisterBfeMetrics());
+      http_fetcher_async = std::make_unique<SingleFlightHttpFetcherAsync>(
+          std::move(http_fetcher_async));
+    }
+    buyer_kv_async_http_client = std::make_unique<BuyerKeyValueAsyncHttpClient>(
+        buyer_kv_server_addr, std::move(http_fetcher_async), true);
+    const int kv_cache_ttl_ms =
+        config_client.GetIntParameter(BUYER_KV_CACHE_TTL_MS);
+    if (kv_cache_ttl_ms > 0) {
+      PS_RETURN_IF_ERROR(BuyerKeyValueCacheMetrics::RegisterBfeMetrics());
+      buyer_kv_async_http_client =
+          std::make_unique<CachingBuyerKeyValueAsyncClient>(
+              std::move(buyer_kv_async_http_client),
+              BuyerKeyValueCacheOptions{
+                  .ttl = absl::Milliseconds(kv_cache_ttl_ms),
+                  .max_entries =
+                      config_client.GetIntParameter(BUYER_KV_CACHE_MAX_ENTRIES),
+              });
+    }
     bidding_signals_async_providers =
         std::make_unique<HttpBiddingSignalsAsyncProvider>(
             std::move(buyer_kv_async_http_client));
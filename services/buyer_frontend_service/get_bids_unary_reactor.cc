@@ -22,6 +22,7 @@
 #include "api/bidding_auction_servers.grpc.pb.h"
 #include "services/buyer_frontend_service/util/bidding_signals.h"
 #include "services/buyer_frontend_service/util/proto_factory.h"
+#include "services/buyer_frontend_service/util/trusted_bidding_signals_index.h"
 #include "services/common/chaffing/transcoding_utils.h"
 #include "services/common/clients/kv_server/kv_v2.h"
 #include "services/common/constants/user_error_strings.h"
@@ -149,6 +150,9 @@ GetBidsUnaryReactor::GetBidsUnaryReactor(
     const ChaffMedianTrackers& chaff_median_trackers, bool enable_benchmarking)
     : context_(&context),
       request_(&get_bids_request),
+      raw_request_(
+          *google::protobuf::Arena::Create<GetBidsRequest::GetBidsRawRequest>(
+              &arena_)),
       get_bids_response_(&get_bids_response),
       get_bids_raw_response_(
           std::make_unique<GetBidsResponse::GetBidsRawResponse>()),
@@ -292,8 +296,8 @@ grpc::Status GetBidsUnaryReactor::ParseRawRequestBytestring(
   }
 
   absl::StatusOr<DecodedGetBidsPayload<GetBidsRequest::GetBidsRawRequest>>
-      decoded_payload = DecodeGetBidsPayload<GetBidsRequest::GetBidsRawRequest>(
-          decrypt_response.payload());
+      decoded_payload =
+          DecodeGetBidsPayloadInto(decrypt_response.payload(), raw_request_);
   if (!decoded_payload.ok()) {
     PS_LOG(ERROR) << "Failed to decode request: " << decoded_payload.status();
     return {grpc::StatusCode::INVALID_ARGUMENT, kMalformedCiphertext};
@@ -305,8 +309,6 @@ grpc::Status GetBidsUnaryReactor::ParseRawRequestBytestring(
     return {grpc::StatusCode::INVALID_ARGUMENT, kUnsupportedMetadataValues};
   }
 
-  raw_request_ = std::move(decoded_payload->get_bids_proto);
-
   PS_VLOG(kStats) << "Compression type: " << ((int)compression_type_);
   PS_VLOG(kStats) << "Decoded/Decompressed payload size: "
                   << raw_request_.SerializeAsString().length();
@@ -438,8 +440,11 @@ void GetBidsUnaryReactor::CancellableExecute() {
   async_task_tracker_.SetNumTasksToTrack(num_bidding_calls);
 
   if (raw_request_.has_buyer_input()) {
-    *raw_request_.mutable_buyer_input_for_bidding() =
-        ToBuyerInputForBidding(std::move(*raw_request_.mutable_buyer_input()));
+    // Converts in place, so that the converted input stays on the arena of the
+    // request instead of being copied into it from the heap.
+    raw_request_.clear_buyer_input_for_bidding();
+    ToBuyerInputForBiddingInto(std::move(*raw_request_.mutable_buyer_input()),
+                               *raw_request_.mutable_buyer_input_for_bidding());
   }
 
   const bool get_protected_audience_bids =
@@ -500,8 +505,8 @@ void GetBidsUnaryReactor::CancellableExecuteChaffRequest() {
   }
 
   absl::StatusOr<google::cmrt::sdk::crypto_service::v1::AeadEncryptResponse>
-      aead_encrypt =
-          crypto_client_->AeadEncrypt(*encoded_payload, hpke_secret_);
+      aead_encrypt = crypto_client_->AeadEncrypt(*std::move(encoded_payload),
+                                                 hpke_secret_);
   if (!aead_encrypt.ok()) {
     PS_LOG(ERROR, log_context_)
         << "Failed to encrypt chaff response: " << aead_encrypt.status();
@@ -511,7 +516,7 @@ void GetBidsUnaryReactor::CancellableExecuteChaffRequest() {
 
   PS_VLOG(kNoisyInfo, log_context_) << "Chaff response encrypted successfully";
   get_bids_response_->set_response_ciphertext(
-      aead_encrypt->encrypted_data().ciphertext());
+      std::move(*aead_encrypt->mutable_encrypted_data()->mutable_ciphertext()));
 
   // Artificially delay the response for chaff requests to mimic processing a
   // real request.
@@ -850,11 +855,11 @@ void GetBidsUnaryReactor::PrepareAndGenerateProtectedAudienceBid(
       .per_ig_priority_vectors =
           bidding_signal_json_components_.per_ig_priority_vectors};
 
-  absl::flat_hash_map<std::string, std::string> common_bidding_signals;
-  if (bidding_signal_json_components_.bidding_signals) {
-    common_bidding_signals =
-        BiddingSignalsToMap(*bidding_signal_json_components_.bidding_signals);
-  }
+  const TrustedBiddingSignalsIndex common_bidding_signals =
+      bidding_signal_json_components_.bidding_signals
+          ? TrustedBiddingSignalsIndex(
+                *bidding_signal_json_components_.bidding_signals)
+          : TrustedBiddingSignalsIndex();
   PrepareGenerateBidsRequestResult result = PrepareGenerateBidsRequest(
       raw_request_, common_bidding_signals,
       bidding_signal_json_components_.raw_size, data_version, pv_config,
@@ -963,7 +968,7 @@ absl::Status GetBidsUnaryReactor::EncryptResponse() {
       auto aead_encrypt,
       crypto_client_->AeadEncrypt(*std::move(encoded_payload), hpke_secret_));
   get_bids_response_->set_response_ciphertext(
-      aead_encrypt.encrypted_data().ciphertext());
+      std::move(*aead_encrypt.mutable_encrypted_data()->mutable_ciphertext()));
   return absl::OkStatus();
 }
 
@@ -31,6 +31,7 @@
 #include "absl/synchronization/blocking_counter.h"
 #include "api/bidding_auction_servers.grpc.pb.h"
 #include "api/bidding_auction_servers.pb.h"
+#include "google/protobuf/arena.h"
 #include "services/buyer_frontend_service/data/get_bids_config.h"
 #include "services/buyer_frontend_service/providers/bidding_signals_async_provider.h"
 #include "services/buyer_frontend_service/util/bidding_signals.h"
@@ -173,7 +174,10 @@ class GetBidsUnaryReactor : public grpc::ServerUnaryReactor {
   // https://github.com/grpc/grpc/blob/dbc45208e2bfe14f01b1cbb06d0cd7c01077debb/include/grpcpp/server_context.h#L604
   grpc::CallbackServerContext* context_;
   const GetBidsRequest* request_;
-  GetBidsRequest::GetBidsRawRequest raw_request_;
+  // Backs the decrypted request, which is parsed directly into it.
+  google::protobuf::Arena arena_;
+  // The decrypted request, allocated on arena_.
+  GetBidsRequest::GetBidsRawRequest& raw_request_;
 
   // Should be released by gRPC after call is finished
   GetBidsResponse* get_bids_response_;
@@ -66,8 +66,20 @@ inline constexpr absl::string_view CURL_BFE_QUEUE_MAX_WAIT_MS =
     "CURL_BFE_QUEUE_MAX_WAIT_MS";
 inline constexpr absl::string_view CURL_BFE_WORK_QUEUE_LENGTH =
     "CURL_BFE_WORK_QUEUE_LENGTH";
+inline constexpr absl::string_view CURL_BFE_ENABLE_WORK_STEALING =
+    "CURL_BFE_ENABLE_WORK_STEALING";
+inline constexpr absl::string_view BUYER_KV_CACHE_TTL_MS =
+    "BUYER_KV_CACHE_TTL_MS";
+inline constexpr absl::string_view BUYER_KV_CACHE_MAX_ENTRIES =
+    "BUYER_KV_CACHE_MAX_ENTRIES";
+inline constexpr absl::string_view CURL_BFE_ENABLE_SINGLE_FLIGHT =
+    "CURL_BFE_ENABLE_SINGLE_FLIGHT";
+inline constexpr absl::string_view CURL_BFE_ENABLE_HTTP2_MULTIPLEXING =
+    "CURL_BFE_ENABLE_HTTP2_MULTIPLEXING";
+inline constexpr absl::string_view CURL_BFE_MAX_CONCURRENT_STREAMS =
+    "CURL_BFE_MAX_CONCURRENT_STREAMS";
 
-inline constexpr int kNumRuntimeFlags = 24;
+inline constexpr int kNumRuntimeFlags = 30;
 inline constexpr std::array<absl::string_view, kNumRuntimeFlags> kFlags = {
     PORT,
     HEALTHCHECK_PORT,
@@ -93,6 +105,12 @@ inline constexpr std::array<absl::string_view, kNumRuntimeFlags> kFlags = {
     CURL_BFE_NUM_WORKERS,
     CURL_BFE_QUEUE_MAX_WAIT_MS,
     CURL_BFE_WORK_QUEUE_LENGTH,
+    CURL_BFE_ENABLE_WORK_STEALING,
+    BUYER_KV_CACHE_TTL_MS,
+    BUYER_KV_CACHE_MAX_ENTRIES,
+    CURL_BFE_ENABLE_SINGLE_FLIGHT,
+    CURL_BFE_ENABLE_HTTP2_MULTIPLEXING,
+    CURL_BFE_MAX_CONCURRENT_STREAMS,
 };
 
 inline std::vector<absl::string_view> GetServiceFlags() {
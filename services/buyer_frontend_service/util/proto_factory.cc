@@ -15,9 +15,9 @@
 #include "services/buyer_frontend_service/util/proto_factory.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "absl/container/flat_hash_set.h"
-#include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/blocking_counter.h"
 #include "absl/synchronization/mutex.h"
@@ -39,23 +39,10 @@ using GenerateProtectedAppSignalsBidsRawRequest =
 using InterestGroupForBidding = GenerateBidsRawRequest::InterestGroupForBidding;
 struct ParsedTrustedBiddingSignals {
   std::string json;
-  absl::flat_hash_set<std::string> keys;
+  // Views into the IG's bidding signals keys.
+  std::vector<absl::string_view> keys;
 };
 
-inline std::string SerializeSignalsMap(
-    const absl::flat_hash_map<absl::string_view, absl::string_view>& signals) {
-  return absl::StrCat(
-      "{",
-      absl::StrJoin(
-          signals, ",",
-          [](std::string* out,
-             std::pair<absl::string_view, absl::string_view> key_val) {
-            out->append(
-                absl::StrCat("\"", key_val.first, "\"", ":", key_val.second));
-          }),
-      "}");
-}
-
 }  // namespace
 
 std::unique_ptr<GetBidsRawResponse> CreateGetBidsRawResponse(
@@ -76,31 +63,50 @@ std::unique_ptr<GetBidsRawResponse> CreateGetBidsRawResponse(
 // Parses trusted bidding signals for a single Interest Group (IG).
 // Queries the bidding signals for trusted bidding signal keys in the IG.
 // If found,
-// 1. Copies key to parsed trusted keys hash set
+// 1. Adds key to parsed trusted keys, in the order of the IG's keys
 // 2. Key-value pair to parsed trusted JSON string
+// The JSON string is sized upfront and assembled from the members serialized
+// in the index, so that no signal is serialized again per IG.
 absl::StatusOr<ParsedTrustedBiddingSignals> GetSignalsForIG(
     const ::google::protobuf::RepeatedPtrField<std::string>&
         bidding_signals_keys,
-    const absl::flat_hash_map<std::string, std::string>& bidding_signals_obj) {
-  // Insert bidding signal values for this IG.
+    const TrustedBiddingSignalsIndex& bidding_signals) {
   ParsedTrustedBiddingSignals parsed_signals;
-  absl::flat_hash_map<absl::string_view, absl::string_view> ig_signals;
-
-  // Copy bidding signals with key name in bidding signal keys.
+  std::vector<absl::string_view> members;
+  members.reserve(bidding_signals_keys.size());
+  parsed_signals.keys.reserve(bidding_signals_keys.size());
+  absl::flat_hash_set<absl::string_view> seen_keys;
+  // Opening and closing braces.
+  size_t json_size = 2;
+
+  // Find bidding signals with key name in bidding signal keys.
   for (const auto& key : bidding_signals_keys) {
-    if (parsed_signals.keys.contains(key)) {
+    if (!seen_keys.insert(key).second) {
       // Do not process duplicate keys.
       continue;
     }
-    auto bidding_signals_key_itr = bidding_signals_obj.find(key);
-    if (bidding_signals_key_itr != bidding_signals_obj.end()) {
-      ig_signals[key] = bidding_signals_key_itr->second;
-      parsed_signals.keys.emplace(key);
+    absl::string_view member = bidding_signals.FindMember(key);
+    if (member.empty()) {
+      continue;
     }
+    // Including the separating comma.
+    json_size += member.size() + 1;
+    members.push_back(member);
+    parsed_signals.keys.push_back(key);
   }
-  if (!ig_signals.empty()) {
-    parsed_signals.json = SerializeSignalsMap(ig_signals);
+  if (members.empty()) {
+    return parsed_signals;
+  }
+
+  parsed_signals.json.reserve(json_size);
+  parsed_signals.json.push_back('{');
+  for (absl::string_view member : members) {
+    if (parsed_signals.json.size() > 1) {
+      parsed_signals.json.push_back(',');
+    }
+    parsed_signals.json.append(member);
   }
+  parsed_signals.json.push_back('}');
   return parsed_signals;
 }
 
@@ -141,7 +147,7 @@ void CopyIGFromDeviceToIGForBidding(
 
 PrepareGenerateBidsRequestResult PrepareGenerateBidsRequest(
     GetBidsRequest::GetBidsRawRequest& get_bids_raw_request,
-    const absl::flat_hash_map<std::string, std::string>& bidding_signals_obj,
+    const TrustedBiddingSignalsIndex& bidding_signals,
     const size_t signal_size, uint32_t data_version,
     const PriorityVectorConfig& priority_vector_config,
     server_common::Executor& executor,
@@ -163,9 +169,8 @@ PrepareGenerateBidsRequestResult PrepareGenerateBidsRequest(
     absl::BlockingCounter done(buyer_input.interest_groups().size());
     for (auto&& ig_from_device : *buyer_input.mutable_interest_groups()) {
       executor.Run([&generate_bids_raw_request_mu, &generate_bids_raw_request,
-                    &done, &bidding_signals_obj, &options,
-                    &priority_vector_config, &interest_group_priorities,
-                    &num_filtered_igs,
+                    &done, &bidding_signals, &options, &priority_vector_config,
+                    &interest_group_priorities, &num_filtered_igs,
                     ig_from_device = std::move(ig_from_device)]() mutable {
         // Skip IG if it has no name or if bidding signals are required but the
         // IG has no bidding signals keys.
@@ -191,9 +196,9 @@ PrepareGenerateBidsRequestResult PrepareGenerateBidsRequest(
 
         // Get parsed trusted bidding signals for this IG.
         absl::StatusOr<ParsedTrustedBiddingSignals> parsed_signals;
-        if (!bidding_signals_obj.empty()) {
+        if (!bidding_signals.empty()) {
           parsed_signals = GetSignalsForIG(
-              ig_from_device.bidding_signals_keys(), bidding_signals_obj);
+              ig_from_device.bidding_signals_keys(), bidding_signals);
         }
 
         // Skip IG if bidding signals are required but the IG has no parsed
@@ -215,8 +220,9 @@ PrepareGenerateBidsRequestResult PrepareGenerateBidsRequest(
         }
         if (has_parsed_signals) {
           // Only add trusted bidding signals keys that are parsed.
-          // TODO(b/308793587): Optimize.
-          for (const std::string& key : parsed_signals->keys) {
+          mutable_ig_for_bidding->mutable_trusted_bidding_signals_keys()
+              ->Reserve(parsed_signals->keys.size());
+          for (absl::string_view key : parsed_signals->keys) {
             mutable_ig_for_bidding->add_trusted_bidding_signals_keys(key);
           }
           // Set trusted bidding signals to include only those signals that are
@@ -23,6 +23,7 @@
 #include "api/bidding_auction_servers.pb.h"
 #include "rapidjson/document.h"
 #include "services/buyer_frontend_service/data/bidding_signals.h"
+#include "services/buyer_frontend_service/util/trusted_bidding_signals_index.h"
 #include "services/common/loggers/request_log_context.h"
 #include "src/concurrent/executor.h"
 
@@ -60,7 +61,7 @@ std::unique_ptr<GetBidsResponse::GetBidsRawResponse> CreateGetBidsRawResponse(
 // Creates Bidding Request from GetBidsRawRequest, Bidding Signals.
 PrepareGenerateBidsRequestResult PrepareGenerateBidsRequest(
     GetBidsRequest::GetBidsRawRequest& get_bids_raw_request,
-    const absl::flat_hash_map<std::string, std::string>& bidding_signals_obj,
+    const TrustedBiddingSignalsIndex& bidding_signals,
     const size_t signal_size, uint32_t data_version,
     const PriorityVectorConfig& priority_vector_config,
     server_common::Executor& executor,
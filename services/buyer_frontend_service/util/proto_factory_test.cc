@@ -155,7 +155,8 @@ TEST_F(CreateGenerateBidsRequestTest, SetsAllFieldsFromInputParamsForAndroid) {
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size,
           expected_raw_output.data_version(), GetDefaultPriorityVectorConfig(),
           *executor_, {.enable_kanon = true})
@@ -224,7 +225,8 @@ TEST_F(CreateGenerateBidsRequestTest, SetsAllFieldsFromInputParamsForBrowser) {
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size,
           expected_raw_output.data_version(), GetDefaultPriorityVectorConfig(),
           *executor_)
@@ -312,7 +314,8 @@ TEST_F(CreateGenerateBidsRequestTest, SetsAllFieldsFromInputParamsForTestIG) {
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size,
           expected_raw_output.data_version(), GetDefaultPriorityVectorConfig(),
           *executor_)
@@ -357,7 +360,8 @@ TEST_F(CreateGenerateBidsRequestTest, SkipsIGWithoutBiddingSignalsKeys) {
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size, kTestDefaultDataVersion,
           GetDefaultPriorityVectorConfig(), *executor_)
           .raw_request;
@@ -383,7 +387,8 @@ TEST_F(CreateGenerateBidsRequestTest,
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size, kTestDefaultDataVersion,
           GetDefaultPriorityVectorConfig(), *executor_,
           {.require_bidding_signals = false})
@@ -423,7 +428,8 @@ TEST_F(CreateGenerateBidsRequestTest,
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size, kTestDefaultDataVersion,
           GetDefaultPriorityVectorConfig(), *executor_)
           .raw_request;
@@ -456,7 +462,8 @@ TEST_F(CreateGenerateBidsRequestTest,
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size, kTestDefaultDataVersion,
           GetDefaultPriorityVectorConfig(), *executor_)
           .raw_request;
@@ -491,7 +498,8 @@ TEST_F(CreateGenerateBidsRequestTest, SkipsIGWithoutBiddingSignals) {
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size, kTestDefaultDataVersion,
           GetDefaultPriorityVectorConfig(), *executor_)
           .raw_request;
@@ -514,7 +522,8 @@ TEST_F(CreateGenerateBidsRequestTest,
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size, kTestDefaultDataVersion,
           GetDefaultPriorityVectorConfig(), *executor_,
           {.require_bidding_signals = false})
@@ -543,7 +552,8 @@ TEST_F(CreateGenerateBidsRequestTest, SetsDebugReportingFlags) {
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size, kTestDefaultDataVersion,
           GetDefaultPriorityVectorConfig(), *executor_)
           .raw_request;
@@ -567,7 +577,8 @@ TEST_F(CreateGenerateBidsRequestTest, SetsLogContext) {
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size, kTestDefaultDataVersion,
           GetDefaultPriorityVectorConfig(), *executor_)
           .raw_request;
@@ -593,7 +604,8 @@ TEST_F(CreateGenerateBidsRequestTest, SetsConsentedDebugConfig) {
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size, kTestDefaultDataVersion,
           GetDefaultPriorityVectorConfig(), *executor_)
           .raw_request;
@@ -616,7 +628,8 @@ TEST_F(CreateGenerateBidsRequestTest, SetsTopLevelSellerForComponentAuction) {
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size, kTestDefaultDataVersion,
           GetDefaultPriorityVectorConfig(), *executor_)
           .raw_request;
@@ -638,7 +651,8 @@ TEST_F(CreateGenerateBidsRequestTest, SetsMultiBidLimit) {
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size, kTestDefaultDataVersion,
           GetDefaultPriorityVectorConfig(), *executor_, {.enable_kanon = true})
           .raw_request;
@@ -661,7 +675,8 @@ TEST_F(CreateGenerateBidsRequestTest, MultiBidLimitDefaultsWithFalseFlags) {
 
   auto raw_output =
       PrepareGenerateBidsRequest(
-          input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+          input,
+          TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
           (*parsed_bidding_signals).raw_size, kTestDefaultDataVersion,
           GetDefaultPriorityVectorConfig(), *executor_, {.enable_kanon = false})
           .raw_request;
@@ -728,7 +743,8 @@ TEST_F(CreateGenerateBidsRequestTest, VerifyPriorityVectorFiltering) {
       .priority_signals = priority_signals,
       .per_ig_priority_vectors = per_ig_priority_vectors};
   auto result = PrepareGenerateBidsRequest(
-      input, BiddingSignalsToMap(*parsed_bidding_signals->bidding_signals),
+      input,
+      TrustedBiddingSignalsIndex(*parsed_bidding_signals->bidding_signals),
       (*parsed_bidding_signals).raw_size, expected_raw_output.data_version(),
       pv_config, *executor_, {.enable_kanon = true});
   auto raw_output = std::move(result.raw_request);
@@ -0,0 +1,90 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "services/buyer_frontend_service/util/trusted_bidding_signals_index.h"
+
+#include <cstring>
+#include <vector>
+
+#include "rapidjson/writer.h"
+#include "services/common/loggers/request_log_context.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+// Offsets into the buffer, since it may be reallocated while it's filled.
+struct MemberOffsets {
+  size_t key_begin;
+  size_t member_begin;
+  size_t member_end;
+};
+
+}  // namespace
+
+TrustedBiddingSignalsIndex::TrustedBiddingSignalsIndex(
+    const rapidjson::Value& signals) {
+  if (!signals.IsObject() || signals.MemberCount() == 0) {
+    return;
+  }
+
+  std::vector<MemberOffsets> offsets;
+  offsets.reserve(signals.MemberCount());
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer_);
+  for (auto it = signals.MemberBegin(); it != signals.MemberEnd(); ++it) {
+    const size_t key_begin = buffer_.GetSize();
+    const size_t key_size = it->name.GetStringLength();
+    std::memcpy(buffer_.Push(key_size), it->name.GetString(), key_size);
+
+    // The key and the value are written as separate roots, since the writer
+    // only emits complete JSON values.
+    const size_t member_begin = buffer_.GetSize();
+    writer.Reset(buffer_);
+    bool serialized =
+        writer.String(it->name.GetString(), it->name.GetStringLength());
+    buffer_.Put(':');
+    writer.Reset(buffer_);
+    serialized = serialized && it->value.Accept(writer);
+    if (!serialized) {
+      PS_VLOG(5) << "Unable to serialize signals for key: "
+                 << it->name.GetString();
+      buffer_.Pop(buffer_.GetSize() - key_begin);
+      continue;
+    }
+    offsets.push_back({.key_begin = key_begin,
+                       .member_begin = member_begin,
+                       .member_end = buffer_.GetSize()});
+  }
+
+  // The buffer won't grow anymore, so views into it are stable from here on.
+  const char* data = buffer_.GetString();
+  members_.reserve(offsets.size());
+  for (const MemberOffsets& member : offsets) {
+    members_.insert_or_assign(
+        absl::string_view(data + member.key_begin,
+                          member.member_begin - member.key_begin),
+        absl::string_view(data + member.member_begin,
+                          member.member_end - member.member_begin));
+  }
+}
+
+absl::string_view TrustedBiddingSignalsIndex::FindMember(
+    absl::string_view key) const {
+  auto it = members_.find(key);
+  if (it == members_.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,63 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SERVICES_BUYER_FRONTEND_SERVICE_UTIL_TRUSTED_BIDDING_SIGNALS_INDEX_H_
+#define SERVICES_BUYER_FRONTEND_SERVICE_UTIL_TRUSTED_BIDDING_SIGNALS_INDEX_H_
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// Index of the trusted bidding signals returned by the KV server, built with
+// a single pass over the 'keys' object of the KV response.
+//
+// Every signal is serialized once, as a `"key":value` JSON member, into a
+// buffer owned by the index. The per-IG signals JSON can then be assembled by
+// concatenating members, no matter how many IGs share a key.
+//
+// The index is immutable once built, so it can be read concurrently.
+class TrustedBiddingSignalsIndex {
+ public:
+  // Creates an empty index.
+  TrustedBiddingSignalsIndex() = default;
+
+  // Indexes the members of `signals`. Signals that can't be serialized are
+  // skipped. If a key is repeated, its last value is indexed.
+  explicit TrustedBiddingSignalsIndex(const rapidjson::Value& signals);
+
+  // Not copyable or movable, since the index points into the buffer.
+  TrustedBiddingSignalsIndex(const TrustedBiddingSignalsIndex&) = delete;
+  TrustedBiddingSignalsIndex& operator=(const TrustedBiddingSignalsIndex&) =
+      delete;
+
+  // Returns the serialized `"key":value` member for `key`, or an empty string
+  // if there is no signal for `key`.
+  absl::string_view FindMember(absl::string_view key) const;
+
+  bool empty() const { return members_.empty(); }
+  size_t size() const { return members_.size(); }
+
+ private:
+  // Holds the unescaped keys, followed by their serialized members.
+  rapidjson::StringBuffer buffer_;
+  // Key to `"key":value` member, both pointing into `buffer_`.
+  absl::flat_hash_map<absl::string_view, absl::string_view> members_;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_BUYER_FRONTEND_SERVICE_UTIL_TRUSTED_BIDDING_SIGNALS_INDEX_H_
@@ -0,0 +1,84 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "services/buyer_frontend_service/util/trusted_bidding_signals_index.h"
+
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+#include "rapidjson/document.h"
+#include "services/common/util/json_util.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+TEST(TrustedBiddingSignalsIndexTest, IndexesSerializedMembers) {
+  auto signals = ParseJsonString(
+      R"JSON({"key1": [1, 2], "key2": {"a": "b"}, "key3": null})JSON");
+  ASSERT_TRUE(signals.ok()) << signals.status();
+
+  TrustedBiddingSignalsIndex index(*signals);
+  EXPECT_EQ(index.size(), 3);
+  EXPECT_EQ(index.FindMember("key1"), R"JSON("key1":[1,2])JSON");
+  EXPECT_EQ(index.FindMember("key2"), R"JSON("key2":{"a":"b"})JSON");
+  EXPECT_EQ(index.FindMember("key3"), R"JSON("key3":null)JSON");
+  EXPECT_TRUE(index.FindMember("key4").empty());
+}
+
+TEST(TrustedBiddingSignalsIndexTest, EscapesKeysInMembers) {
+  auto signals = ParseJsonString(R"JSON({"a\"b": 1})JSON");
+  ASSERT_TRUE(signals.ok()) << signals.status();
+
+  TrustedBiddingSignalsIndex index(*signals);
+  EXPECT_EQ(index.FindMember("a\"b"), R"JSON("a\"b":1)JSON");
+}
+
+TEST(TrustedBiddingSignalsIndexTest, IndexesLastValueOfRepeatedKeys) {
+  auto signals = ParseJsonString(R"JSON({"key": 1, "key": 2})JSON");
+  ASSERT_TRUE(signals.ok()) << signals.status();
+
+  TrustedBiddingSignalsIndex index(*signals);
+  EXPECT_EQ(index.size(), 1);
+  EXPECT_EQ(index.FindMember("key"), R"JSON("key":2)JSON");
+}
+
+TEST(TrustedBiddingSignalsIndexTest, IsEmptyForNonObjectSignals) {
+  auto signals = ParseJsonString("[1, 2]");
+  ASSERT_TRUE(signals.ok()) << signals.status();
+
+  EXPECT_TRUE(TrustedBiddingSignalsIndex(*signals).empty());
+  EXPECT_TRUE(TrustedBiddingSignalsIndex().empty());
+}
+
+TEST(TrustedBiddingSignalsIndexTest, KeepsMembersValidAcrossBufferGrowth) {
+  // Enough members for the buffer to be reallocated several times.
+  constexpr int kNumKeys = 1000;
+  rapidjson::Document signals(rapidjson::kObjectType);
+  for (int i = 0; i < kNumKeys; ++i) {
+    std::string key = absl::StrCat("key", i);
+    signals.AddMember(rapidjson::Value(key.c_str(), signals.GetAllocator()),
+                      rapidjson::Value(i), signals.GetAllocator());
+  }
+
+  TrustedBiddingSignalsIndex index(signals);
+  ASSERT_EQ(index.size(), kNumKeys);
+  for (int i = 0; i < kNumKeys; ++i) {
+    EXPECT_EQ(index.FindMember(absl::StrCat("key", i)),
+              absl::StrCat("\"key", i, "\":", i));
+  }
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -21,11 +21,16 @@
 //   services/seller_frontend_service/cache:cache_benchmarks -- \
 //   --benchmark_time_unit=us --benchmark_repetitions=10
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "absl/algorithm/container.h"
 #include "absl/container/btree_set.h"
 #include "absl/strings/str_cat.h"
 #include "benchmark/benchmark.h"
 #include "services/common/cache/cache.h"
+#include "services/common/cache/sharded_cache.h"
 #include "services/common/test/utils/test_init.h"
 #include "services/common/util/hash_util.h"
 
@@ -37,6 +42,12 @@ constexpr int kRangeArg = 0;
 // query, resolved as non-k-anon query, resolved as k-anon by client query, or
 // unresolved after all the queries (which get inserted into non-k-anon cache).
 constexpr int kHashOutcomeSplit = 4;
+// Number of distinct keys used by the multi-threaded benchmarks. The caches
+// under test can only hold half of them, so that both hits and misses (and
+// hence evictions) are exercised.
+constexpr int kMultiThreadedNumKeys = 1 << 14;
+constexpr int kMultiThreadedBatchSize = 16;
+constexpr int kMaxThreads = 64;
 
 absl::btree_set<std::string> MapToBTreeSet(
     absl::flat_hash_map<std::string, std::string> map) {
@@ -217,9 +228,111 @@ static void BM_QueryCachesUsingSetDifference(benchmark::State& state) {
   }
 }
 
+std::vector<absl::flat_hash_set<std::string>> ConstructKeyBatches() {
+  std::vector<absl::flat_hash_set<std::string>> batches(
+      kMultiThreadedNumKeys / kMultiThreadedBatchSize);
+  for (int i = 0; i < kMultiThreadedNumKeys; i++) {
+    batches[i % batches.size()].insert(
+        ComputeSHA256(absl::StrCat(i), /* return_hex= */ false));
+  }
+  return batches;
+}
+
+// State shared by the threads of the multi-threaded benchmarks. It is set up
+// and torn down by the Setup() and Teardown() callbacks, which run once per
+// benchmark run, before the threads start and after they all finish.
+struct MultiThreadedState {
+  std::unique_ptr<server_common::GrpcInit> grpc_init;
+  std::unique_ptr<server_common::EventEngineExecutor> executor;
+  std::unique_ptr<CacheInterface<std::string, std::string>> cache;
+  std::vector<absl::flat_hash_set<std::string>> batches;
+};
+
+MultiThreadedState& GetMultiThreadedState() {
+  static auto* state = new MultiThreadedState();
+  return *state;
+}
+
+void SetupEventExpiryCache(const benchmark::State& state) {
+  CommonTestInit();
+  MultiThreadedState& shared = GetMultiThreadedState();
+  shared.grpc_init = std::make_unique<server_common::GrpcInit>();
+  shared.executor = std::make_unique<server_common::EventEngineExecutor>(
+      grpc_event_engine::experimental::CreateEventEngine());
+  shared.cache = std::make_unique<Cache<std::string, std::string>>(
+      kMultiThreadedNumKeys / 2, absl::Minutes(30), shared.executor.get());
+  shared.batches = ConstructKeyBatches();
+}
+
+void SetupShardedCache(const benchmark::State& state) {
+  CommonTestInit();
+  MultiThreadedState& shared = GetMultiThreadedState();
+  shared.cache = std::make_unique<ShardedCache<std::string, std::string>>(
+      kMultiThreadedNumKeys / 2, absl::Minutes(30),
+      /* num_shards= */ state.range(kRangeArg));
+  shared.batches = ConstructKeyBatches();
+}
+
+void TeardownMultiThreadedState(const benchmark::State& state) {
+  MultiThreadedState& shared = GetMultiThreadedState();
+  // The cache may use the executor, which needs gRPC to be initialized.
+  shared.cache.reset();
+  shared.executor.reset();
+  shared.grpc_init.reset();
+  shared.batches.clear();
+}
+
+// Each thread queries a batch of keys and inserts the ones that missed, which
+// mirrors how the k-anon caches are used on the request path.
+void RunQueryInsertLoop(benchmark::State& state) {
+  CacheInterface<std::string, std::string>& cache =
+      *GetMultiThreadedState().cache;
+  const std::vector<absl::flat_hash_set<std::string>>& batches =
+      GetMultiThreadedState().batches;
+  // Start threads at different offsets so that they don't walk in lockstep.
+  size_t batch_offset = state.thread_index() * 7919;
+  for (auto _ : state) {
+    const auto& batch = batches[batch_offset++ % batches.size()];
+    auto found = cache.Query(batch);
+    absl::flat_hash_map<std::string, std::string> misses;
+    for (const auto& key : batch) {
+      if (!found.contains(key)) {
+        misses.insert({key, std::string()});
+      }
+    }
+    benchmark::DoNotOptimize(cache.Insert(misses));
+  }
+  state.SetItemsProcessed(state.iterations() * kMultiThreadedBatchSize);
+}
+
+// Multi-threaded Query/Insert throughput of the cache backed by a single mutex
+// and one timer event per entry.
+static void BM_MultiThreadedQueryInsert_EventExpiryCache(
+    benchmark::State& state) {
+  RunQueryInsertLoop(state);
+}
+
+// Multi-threaded Query/Insert throughput of the lock-striped cache with lazy
+// expiry.
+static void BM_MultiThreadedQueryInsert_ShardedCache(benchmark::State& state) {
+  RunQueryInsertLoop(state);
+}
+
 // Register the function as a benchmark
 BENCHMARK(BM_QueryBothCacheWithAllHashes)->Range(8, 8 << 10);
 BENCHMARK(BM_QueryCachesUsingSetDifference)->Range(8, 8 << 10);
+BENCHMARK(BM_MultiThreadedQueryInsert_EventExpiryCache)
+    ->Setup(SetupEventExpiryCache)
+    ->Teardown(TeardownMultiThreadedState)
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+// Arg is the number of shards.
+BENCHMARK(BM_MultiThreadedQueryInsert_ShardedCache)
+    ->Setup(SetupShardedCache)
+    ->Teardown(TeardownMultiThreadedState)
+    ->Arg(kDefaultNumCacheShards)
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
 
 // Run the benchmark
 BENCHMARK_MAIN();
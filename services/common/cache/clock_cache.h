@@ -0,0 +1,255 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef SERVICES_COMMON_CACHE_CLOCK_CACHE_H_
+#define SERVICES_COMMON_CACHE_CLOCK_CACHE_H_
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/base/optimization.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "services/common/cache/cache.h"
+#include "services/common/cache/sharded_cache.h"
+#include "src/logger/request_context_logger.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// Read-mostly, lock-striped cache with CLOCK (second chance) eviction.
+//
+// CLOCK approximates LRU without reordering anything on a hit: a hit only sets
+// the entry's reference bit, which is an atomic store. Queries therefore run
+// under a shared (reader) lock and concurrent lookups never serialize against
+// each other; only inserts take a shard's writer lock. On eviction, the clock
+// hand sweeps the shard's slots, giving every referenced entry a second chance
+// by clearing its bit, and evicts the first expired or unreferenced entry.
+//
+// Like `ShardedCache`, entries are expired lazily: expired entries are never
+// returned by queries and are the first to be reused on insert.
+template <typename KeyT, typename ValueT>
+class ClockCache : public CacheInterface<KeyT, ValueT> {
+ public:
+  // Constructs a cache that can hold about `capacity` entries in total, split
+  // evenly across `num_shards` shards. Each inserted entry expires `ttl` after
+  // its (latest) insertion.
+  explicit ClockCache(int capacity, absl::Duration ttl,
+                      int num_shards = kDefaultNumCacheShards)
+      : ttl_(ttl), shards_(num_shards) {
+    CHECK_GT(num_shards, 0);
+    PS_VLOG(5) << "Creating clock cache with max capacity of: " << capacity
+               << " across " << num_shards << " shards";
+    // Round up so that the total capacity is never below the requested one.
+    const int shard_capacity = (capacity + num_shards - 1) / num_shards;
+    for (auto& shard : shards_) {
+      absl::MutexLock lock(&shard.mutex);
+      shard.capacity = shard_capacity;
+      shard.slots = std::make_unique<Slot[]>(shard_capacity);
+      shard.key_to_slot.reserve(shard_capacity);
+    }
+  }
+
+  // Returns the entries for keys present (and unexpired) in the cache and
+  // marks them as recently referenced.
+  absl::flat_hash_map<KeyT, ValueT> Query(
+      const absl::flat_hash_set<KeyT>& keys) override {
+    absl::flat_hash_map<KeyT, ValueT> found_entries;
+    if (keys.empty()) {
+      return found_entries;
+    }
+
+    const absl::Time now = absl::Now();
+    if (shards_.size() == 1) {
+      QueryShard(shards_[0], keys, now, found_entries);
+      return found_entries;
+    }
+
+    std::vector<absl::flat_hash_set<KeyT>> shard_keys(shards_.size());
+    for (const auto& key : keys) {
+      shard_keys[ShardIndex(key)].insert(key);
+    }
+    for (int i = 0; i < shards_.size(); ++i) {
+      if (!shard_keys[i].empty()) {
+        QueryShard(shards_[i], shard_keys[i], now, found_entries);
+      }
+    }
+    return found_entries;
+  }
+
+  // Inserts the entries into the cache, reusing expired slots first and
+  // otherwise evicting entries as chosen by the clock hand. Entries that
+  // already exist get their value and expiry refreshed.
+  absl::Status Insert(
+      const absl::flat_hash_map<KeyT, ValueT>& entries) override {
+    if (entries.empty()) {
+      return absl::OkStatus();
+    }
+
+    const absl::Time now = absl::Now();
+    if (shards_.size() == 1) {
+      InsertIntoShard(shards_[0], entries, now, now + ttl_);
+      return absl::OkStatus();
+    }
+
+    std::vector<absl::flat_hash_map<KeyT, ValueT>> shard_entries(
+        shards_.size());
+    for (const auto& entry : entries) {
+      shard_entries[ShardIndex(entry.first)].insert(entry);
+    }
+    for (int i = 0; i < shards_.size(); ++i) {
+      if (!shard_entries[i].empty()) {
+        InsertIntoShard(shards_[i], shard_entries[i], now, now + ttl_);
+      }
+    }
+    return absl::OkStatus();
+  }
+
+  // Returns all unexpired entries (used for testing only).
+  absl::flat_hash_map<KeyT, ValueT> GetAllEntriesForTesting() {
+    absl::flat_hash_map<KeyT, ValueT> entries;
+    const absl::Time now = absl::Now();
+    for (auto& shard : shards_) {
+      absl::ReaderMutexLock lock(&shard.mutex);
+      for (const auto& [key, slot_index] : shard.key_to_slot) {
+        const Slot& slot = shard.slots[slot_index];
+        if (slot.expiry_time > now) {
+          entries.insert({key, slot.value});
+        }
+      }
+    }
+    return entries;
+  }
+
+ private:
+  struct Slot {
+    KeyT key;
+    ValueT value;
+    absl::Time expiry_time = absl::InfinitePast();
+    // Set by readers on a hit and cleared by the clock hand. This is the only
+    // state mutated under the reader lock.
+    std::atomic<bool> referenced = false;
+  };
+
+  // Shards are cache line aligned so that the mutexes of neighbouring shards
+  // don't false share.
+  struct ABSL_CACHELINE_ALIGNED Shard {
+    absl::Mutex mutex;
+    std::unique_ptr<Slot[]> slots ABSL_GUARDED_BY(mutex);
+    absl::flat_hash_map<KeyT, int> key_to_slot ABSL_GUARDED_BY(mutex);
+    // Number of slots in use; slots are filled in order before any eviction.
+    int size ABSL_GUARDED_BY(mutex) = 0;
+    int hand ABSL_GUARDED_BY(mutex) = 0;
+    int capacity = 0;
+  };
+
+  int ShardIndex(const KeyT& key) const {
+    return absl::Hash<KeyT>{}(key) % shards_.size();
+  }
+
+  static void QueryShard(Shard& shard, const absl::flat_hash_set<KeyT>& keys,
+                         absl::Time now,
+                         absl::flat_hash_map<KeyT, ValueT>& found_entries)
+      ABSL_LOCKS_EXCLUDED(shard.mutex) {
+    absl::ReaderMutexLock lock(&shard.mutex);
+    for (const auto& key : keys) {
+      auto it = shard.key_to_slot.find(key);
+      if (it == shard.key_to_slot.end()) {
+        continue;
+      }
+
+      Slot& slot = shard.slots[it->second];
+      if (slot.expiry_time <= now) {
+        continue;
+      }
+
+      // Avoid dirtying the cache line if the bit is already set.
+      if (!slot.referenced.load(std::memory_order_relaxed)) {
+        slot.referenced.store(true, std::memory_order_relaxed);
+      }
+      found_entries.insert({key, slot.value});
+    }
+  }
+
+  static void InsertIntoShard(Shard& shard,
+                              const absl::flat_hash_map<KeyT, ValueT>& entries,
+                              absl::Time now, absl::Time expiry_time)
+      ABSL_LOCKS_EXCLUDED(shard.mutex) {
+    if (shard.capacity == 0) {
+      PS_VLOG(5) << "Cache shard has no capacity, skipping entries";
+      return;
+    }
+
+    absl::MutexLock lock(&shard.mutex);
+    for (const auto& [key, value] : entries) {
+      auto it = shard.key_to_slot.find(key);
+      if (it != shard.key_to_slot.end()) {
+        Slot& slot = shard.slots[it->second];
+        slot.value = value;
+        slot.expiry_time = expiry_time;
+        slot.referenced.store(true, std::memory_order_relaxed);
+        continue;
+      }
+
+      int slot_index;
+      if (shard.size < shard.capacity) {
+        slot_index = shard.size++;
+      } else {
+        slot_index = AdvanceHand(shard, now);
+        shard.key_to_slot.erase(shard.slots[slot_index].key);
+      }
+
+      // New entries start unreferenced so that entries which are inserted but
+      // never read are the first ones to go.
+      Slot& slot = shard.slots[slot_index];
+      slot.key = key;
+      slot.value = value;
+      slot.expiry_time = expiry_time;
+      slot.referenced.store(false, std::memory_order_relaxed);
+      shard.key_to_slot[key] = slot_index;
+    }
+  }
+
+  // Sweeps the clock hand over a full shard and returns the index of the slot
+  // to reuse: the first expired or unreferenced slot. Referenced slots that are
+  // passed over lose their reference bit, which bounds the sweep to at most
+  // two rounds.
+  static int AdvanceHand(Shard& shard, absl::Time now)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex) {
+    while (true) {
+      const int index = shard.hand;
+      shard.hand = (shard.hand + 1) % shard.capacity;
+      Slot& slot = shard.slots[index];
+      if (slot.expiry_time <= now ||
+          !slot.referenced.exchange(false, std::memory_order_relaxed)) {
+        return index;
+      }
+    }
+  }
+
+  const absl::Duration ttl_;
+  std::vector<Shard> shards_;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_COMMON_CACHE_CLOCK_CACHE_H_
@@ -20,6 +20,7 @@
 #include <utility>
 
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "services/common/util/event.h"
 #include "src/logger/request_context_logger.h"
 
@@ -31,6 +32,8 @@ struct CacheHashData {
   KeyT key;
   ValueT value;
   std::unique_ptr<Event> timer_event = nullptr;
+  // Used by caches that expire entries lazily instead of via `timer_event`.
+  absl::Time expiry_time = absl::InfiniteFuture();
 };
 
 // DLL Node.
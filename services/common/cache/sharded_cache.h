@@ -0,0 +1,253 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef SERVICES_COMMON_CACHE_SHARDED_CACHE_H_
+#define SERVICES_COMMON_CACHE_SHARDED_CACHE_H_
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/base/optimization.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "services/common/cache/cache.h"
+#include "services/common/cache/doubly_linked_list.h"
+#include "src/logger/request_context_logger.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+inline constexpr int kDefaultNumCacheShards = 16;
+
+// Lock-striped LRU cache.
+//
+// Keys are hashed onto `num_shards` independent shards, each of which has its
+// own mutex, LRU list and index. Concurrent callers working on keys that land
+// on different shards therefore never contend with each other.
+//
+// Unlike `Cache`, no timer event is registered per entry and no event loop is
+// required. Every entry records its expiry time instead and is expired lazily:
+// expired entries are dropped when they are read and are preferentially
+// reclaimed (from the LRU end) when a shard needs room for new entries.
+template <typename KeyT, typename ValueT>
+class ShardedCache : public CacheInterface<KeyT, ValueT> {
+ public:
+  // Constructs a cache that can hold about `capacity` entries in total, split
+  // evenly across `num_shards` shards. Each inserted entry expires `ttl` after
+  // its (latest) insertion.
+  explicit ShardedCache(int capacity, absl::Duration ttl,
+                        int num_shards = kDefaultNumCacheShards)
+      : ttl_(ttl), shards_(num_shards) {
+    CHECK_GT(num_shards, 0);
+    PS_VLOG(5) << "Creating sharded cache with max capacity of: " << capacity
+               << " across " << num_shards << " shards";
+    // Round up so that the total capacity is never below the requested one.
+    const size_t shard_capacity = (capacity + num_shards - 1) / num_shards;
+    for (auto& shard : shards_) {
+      shard.capacity = shard_capacity;
+    }
+  }
+
+  ~ShardedCache() override {
+    for (auto& shard : shards_) {
+      absl::MutexLock lock(&shard.mutex);
+      shard.hash_to_node.clear();
+      while (shard.dll.Tail()) {
+        shard.dll.Remove(shard.dll.Tail());
+      }
+    }
+  }
+
+  // Returns the entries for keys present (and unexpired) in the cache. Marks
+  // the returned entries as most recently used in their shards.
+  absl::flat_hash_map<KeyT, ValueT> Query(
+      const absl::flat_hash_set<KeyT>& keys) override {
+    absl::flat_hash_map<KeyT, ValueT> found_entries;
+    if (keys.empty()) {
+      return found_entries;
+    }
+
+    const absl::Time now = absl::Now();
+    if (shards_.size() == 1) {
+      QueryShard(shards_[0], keys, now, found_entries);
+      return found_entries;
+    }
+
+    std::vector<absl::flat_hash_set<KeyT>> shard_keys(shards_.size());
+    for (const auto& key : keys) {
+      shard_keys[ShardIndex(key)].insert(key);
+    }
+    // Only take locks for the shards that are touched by the keys.
+    for (size_t i = 0; i < shards_.size(); ++i) {
+      if (!shard_keys[i].empty()) {
+        QueryShard(shards_[i], shard_keys[i], now, found_entries);
+      }
+    }
+    return found_entries;
+  }
+
+  // Inserts the entries into the cache, evicting expired and then least
+  // recently used entries from a shard to make room as needed. Entries that
+  // already exist get their value and expiry refreshed.
+  absl::Status Insert(
+      const absl::flat_hash_map<KeyT, ValueT>& entries) override {
+    if (entries.empty()) {
+      return absl::OkStatus();
+    }
+
+    const absl::Time now = absl::Now();
+    if (shards_.size() == 1) {
+      InsertIntoShard(shards_[0], entries, now, now + ttl_);
+      return absl::OkStatus();
+    }
+
+    std::vector<absl::flat_hash_map<KeyT, ValueT>> shard_entries(
+        shards_.size());
+    for (const auto& entry : entries) {
+      shard_entries[ShardIndex(entry.first)].insert(entry);
+    }
+    for (size_t i = 0; i < shards_.size(); ++i) {
+      if (!shard_entries[i].empty()) {
+        InsertIntoShard(shards_[i], shard_entries[i], now, now + ttl_);
+      }
+    }
+    return absl::OkStatus();
+  }
+
+  // Returns all unexpired entries (used for testing only).
+  absl::flat_hash_map<KeyT, ValueT> GetAllEntriesForTesting() {
+    absl::flat_hash_map<KeyT, ValueT> entries;
+    const absl::Time now = absl::Now();
+    for (auto& shard : shards_) {
+      absl::MutexLock lock(&shard.mutex);
+      for (const auto& [key, node] : shard.hash_to_node) {
+        if (node->data->expiry_time > now) {
+          entries.insert({key, node->data->value});
+        }
+      }
+    }
+    return entries;
+  }
+
+ private:
+  // Shards are cache line aligned so that the mutexes of neighbouring shards
+  // don't false share.
+  struct ABSL_CACHELINE_ALIGNED Shard {
+    absl::Mutex mutex;
+    DoublyLinkedList<KeyT, ValueT> dll ABSL_GUARDED_BY(mutex);
+    absl::flat_hash_map<KeyT, Node<KeyT, ValueT>*> hash_to_node
+        ABSL_GUARDED_BY(mutex);
+    size_t capacity = 0;
+  };
+
+  size_t ShardIndex(const KeyT& key) const {
+    return absl::Hash<KeyT>{}(key) % shards_.size();
+  }
+
+  static void QueryShard(Shard& shard, const absl::flat_hash_set<KeyT>& keys,
+                         absl::Time now,
+                         absl::flat_hash_map<KeyT, ValueT>& found_entries)
+      ABSL_LOCKS_EXCLUDED(shard.mutex) {
+    absl::MutexLock lock(&shard.mutex);
+    for (const auto& key : keys) {
+      auto it = shard.hash_to_node.find(key);
+      if (it == shard.hash_to_node.end()) {
+        continue;
+      }
+
+      Node<KeyT, ValueT>* node = it->second;
+      if (node->data->expiry_time <= now) {
+        PS_VLOG(6) << "Dropping expired entry upon query";
+        shard.hash_to_node.erase(it);
+        shard.dll.Remove(node);
+        continue;
+      }
+
+      shard.dll.MoveToFront(node);
+      found_entries.insert({key, node->data->value});
+    }
+  }
+
+  static void InsertIntoShard(Shard& shard,
+                              const absl::flat_hash_map<KeyT, ValueT>& entries,
+                              absl::Time now, absl::Time expiry_time)
+      ABSL_LOCKS_EXCLUDED(shard.mutex) {
+    absl::MutexLock lock(&shard.mutex);
+    for (const auto& [key, value] : entries) {
+      auto it = shard.hash_to_node.find(key);
+      if (it != shard.hash_to_node.end()) {
+        it->second->data->value = value;
+        it->second->data->expiry_time = expiry_time;
+        shard.dll.MoveToFront(it->second);
+        continue;
+      }
+
+      if (shard.hash_to_node.size() >= shard.capacity &&
+          !EvictOne(shard, now)) {
+        PS_VLOG(5) << "Unable to make space in cache shard, skipping "
+                   << "remaining entries";
+        return;
+      }
+
+      Node<KeyT, ValueT>* node =
+          shard.dll.InsertAtFront(std::make_unique<CacheHashData<KeyT, ValueT>>(
+              CacheHashData<KeyT, ValueT>{.key = key,
+                                          .value = value,
+                                          .expiry_time = expiry_time}));
+      shard.hash_to_node[key] = node;
+    }
+  }
+
+  // Evicts one entry from the shard, preferring an expired entry close to the
+  // LRU end over the least recently used one. Returns false if the shard is
+  // empty.
+  static bool EvictOne(Shard& shard, absl::Time now)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex) {
+    Node<KeyT, ValueT>* victim = shard.dll.Tail();
+    if (victim == nullptr) {
+      return false;
+    }
+
+    // Sentinel nodes carry no data, which bounds the walk on short lists.
+    Node<KeyT, ValueT>* node = victim;
+    for (int i = 0; i < kMaxExpiryScan && node->data != nullptr; ++i) {
+      if (node->data->expiry_time <= now) {
+        victim = node;
+        break;
+      }
+      node = node->prev;
+    }
+    shard.hash_to_node.erase(victim->data->key);
+    shard.dll.Remove(victim);
+    return true;
+  }
+
+  // Number of entries looked at from the LRU end for an expired entry before
+  // falling back to evicting the least recently used one.
+  static constexpr int kMaxExpiryScan = 8;
+
+  const absl::Duration ttl_;
+  std::vector<Shard> shards_;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_COMMON_CACHE_SHARDED_CACHE_H_
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "services/common/cache/sharded_cache.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
+#include "absl/strings/str_cat.h"
+#include "include/gtest/gtest.h"
+#include "services/common/test/utils/test_init.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+constexpr int kTestCacheCapacity = 2;
+constexpr absl::Duration kTestCacheDefaultTimeoutDuration = absl::Minutes(30);
+constexpr char kTestKey1[] = "key1";
+constexpr char kTestKey2[] = "key2";
+constexpr char kTestKey3[] = "key3";
+
+class ShardedCacheTest : public ::testing::Test {
+ public:
+  void SetUp() { CommonTestInit(); }
+};
+
+TEST_F(ShardedCacheTest, CanAddElement) {
+  ShardedCache<std::string, std::string> cache(
+      kTestCacheCapacity, kTestCacheDefaultTimeoutDuration);
+  CHECK_OK(cache.Insert({{kTestKey1, kTestKey1}}));
+  auto found = cache.Query({kTestKey1});
+  ASSERT_TRUE(found.contains(kTestKey1));
+  EXPECT_EQ(found[kTestKey1], kTestKey1);
+}
+
+TEST_F(ShardedCacheTest, EvictsLeastRecentlyUsedElementWithinShard) {
+  ShardedCache<std::string, std::string> cache(
+      kTestCacheCapacity, kTestCacheDefaultTimeoutDuration, /*num_shards=*/1);
+  CHECK_OK(cache.Insert({{kTestKey1, kTestKey1}}));
+  CHECK_OK(cache.Insert({{kTestKey2, kTestKey2}}));
+
+  // Querying the key makes it most recently used.
+  EXPECT_TRUE(cache.Query({kTestKey1}).contains(kTestKey1));
+  EXPECT_TRUE(cache.Query({kTestKey2}).contains(kTestKey2));
+
+  // Cache is now at capacity and adding a new key should evict the LRU entry.
+  CHECK_OK(cache.Insert({{kTestKey3, kTestKey3}}));
+  EXPECT_FALSE(cache.Query({kTestKey1}).contains(kTestKey1));
+  EXPECT_TRUE(cache.Query({kTestKey2}).contains(kTestKey2));
+  EXPECT_TRUE(cache.Query({kTestKey3}).contains(kTestKey3));
+}
+
+TEST_F(ShardedCacheTest, KeysGetDeduplicated) {
+  ShardedCache<std::string, std::string> cache(
+      kTestCacheCapacity, kTestCacheDefaultTimeoutDuration);
+  CHECK_OK(cache.Insert({{kTestKey1, kTestKey1}}));
+  CHECK_OK(cache.Insert({{kTestKey1, kTestKey2}}));
+  auto cached = cache.GetAllEntriesForTesting();
+  ASSERT_EQ(cached.size(), 1);
+  EXPECT_EQ(cached[kTestKey1], kTestKey2);
+}
+
+TEST_F(ShardedCacheTest, KeysExpire) {
+  ShardedCache<std::string, std::string> cache(kTestCacheCapacity,
+                                               absl::Nanoseconds(1));
+  CHECK_OK(cache.Insert({{kTestKey1, kTestKey1}}));
+  absl::SleepFor(absl::Milliseconds(1));
+  EXPECT_FALSE(cache.Query({kTestKey1}).contains(kTestKey1));
+  EXPECT_TRUE(cache.GetAllEntriesForTesting().empty());
+}
+
+TEST_F(ShardedCacheTest, PrefersEvictingExpiredEntries) {
+  ShardedCache<std::string, std::string> cache(
+      kTestCacheCapacity, absl::Milliseconds(200), /*num_shards=*/1);
+  CHECK_OK(cache.Insert({{kTestKey1, kTestKey1}}));
+  absl::SleepFor(absl::Milliseconds(100));
+  CHECK_OK(cache.Insert({{kTestKey2, kTestKey2}}));
+  // Makes key2 the LRU entry while key1 is the one to expire first.
+  EXPECT_TRUE(cache.Query({kTestKey1}).contains(kTestKey1));
+  absl::SleepFor(absl::Milliseconds(150));
+
+  CHECK_OK(cache.Insert({{kTestKey3, kTestKey3}}));
+  auto cached = cache.GetAllEntriesForTesting();
+  EXPECT_FALSE(cached.contains(kTestKey1));
+  EXPECT_TRUE(cached.contains(kTestKey2));
+  EXPECT_TRUE(cached.contains(kTestKey3));
+}
+
+TEST_F(ShardedCacheTest, AttemptingToAddMoreEntriesThanCapacityDoesntError) {
+  ShardedCache<std::string, std::string> cache(
+      /*capacity=*/1, absl::Nanoseconds(1), /*num_shards=*/1);
+  CHECK_OK(cache.Insert({{kTestKey1, kTestKey1}, {kTestKey2, kTestKey2}}));
+  EXPECT_EQ(cache.GetAllEntriesForTesting().size(), 0);
+}
+
+TEST_F(ShardedCacheTest, SpreadsEntriesAcrossShards) {
+  constexpr int kNumEntries = 64;
+  ShardedCache<std::string, std::string> cache(
+      kNumEntries * 2, kTestCacheDefaultTimeoutDuration, /*num_shards=*/4);
+  absl::flat_hash_map<std::string, std::string> entries;
+  absl::flat_hash_set<std::string> keys;
+  for (int i = 0; i < kNumEntries; ++i) {
+    entries[absl::StrCat(i)] = absl::StrCat("value", i);
+    keys.insert(absl::StrCat(i));
+  }
+  CHECK_OK(cache.Insert(entries));
+  EXPECT_EQ(cache.Query(keys), entries);
+}
+
+TEST_F(ShardedCacheTest, SupportsConcurrentQueriesAndInserts) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumOpsPerThread = 1000;
+  ShardedCache<std::string, std::string> cache(
+      /*capacity=*/128, kTestCacheDefaultTimeoutDuration);
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < kNumOpsPerThread; ++i) {
+        std::string key = absl::StrCat((t * kNumOpsPerThread + i) % 256);
+        CHECK_OK(cache.Insert({{key, key}}));
+        auto found = cache.Query({key});
+        if (found.contains(key)) {
+          CHECK_EQ(found[key], key);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_LE(cache.GetAllEntriesForTesting().size(), 128);
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
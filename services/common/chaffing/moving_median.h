@@ -24,6 +24,7 @@
 
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
+#include "services/common/chaffing/moving_median_interface.h"
 #include "services/common/random/rng.h"
 
 namespace privacy_sandbox::bidding_auction_servers {
@@ -34,7 +35,7 @@ namespace privacy_sandbox::bidding_auction_servers {
 // probablity that (once the window of size window_size) a call to AddNumber()
 // will add the number to the window. It is expected that there will be a much
 // higher ratio of GetMedian() to AddNumber() calls when using this class.
-class MovingMedian {
+class MovingMedian : public MovingMedianInterface {
  public:
   explicit MovingMedian(size_t window_size, float sampling_probability);
 
@@ -48,16 +49,16 @@ class MovingMedian {
         median_(std::move(other.median_)),
         sampling_probability_(other.sampling_probability_) {}
 
-  virtual ~MovingMedian() = default;
+  ~MovingMedian() override = default;
 
   // Inserts a new value into the sliding window. If the window reaches its
   // maximum size, the oldest value is removed.
-  virtual void AddNumber(RandomNumberGenerator& rng, int value);
+  void AddNumber(RandomNumberGenerator& rng, int value) override;
 
   // Returns median of the window IF the window is full, otherwise an error.
-  virtual absl::StatusOr<int> GetMedian() const;
+  absl::StatusOr<int> GetMedian() const override;
 
-  virtual bool IsWindowFilled() const;
+  bool IsWindowFilled() const override;
 
  private:
   size_t window_size_;
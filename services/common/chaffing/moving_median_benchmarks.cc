@@ -0,0 +1,113 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Benchmark of the moving median implementations used for chaffing v2.
+// Run the benchmark as follows:
+// builders/tools/bazel-debian run --dynamic_mode=off -c opt --copt=-gmlt \
+//   --copt=-fno-omit-frame-pointer --fission=yes --strip=never \
+//   services/common/chaffing:moving_median_benchmarks -- \
+//   --benchmark_time_unit=us --benchmark_repetitions=10
+
+#include <memory>
+
+#include "benchmark/benchmark.h"
+#include "services/common/chaffing/moving_median.h"
+#include "services/common/chaffing/moving_median_interface.h"
+#include "services/common/chaffing/two_heap_moving_median.h"
+#include "services/common/random/rng.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+// Same window size and sampling probability as SFE/BFE use for chaffing v2.
+constexpr int kWindowSize = 10'000;
+constexpr float kSamplingProbability = 0.1;
+constexpr int kMaxValue = 100'000;
+constexpr int kMaxThreads = 64;
+// Median reads per AddNumber() call in the mixed workload, since every
+// request reads the medians of the chaff buyers but only adds numbers for
+// the non-chaff buyers.
+constexpr int kReadsPerAdd = 4;
+
+std::unique_ptr<MovingMedianInterface> CreateFilledMovingMedian(
+    MovingMedianType type, float sampling_probability) {
+  std::unique_ptr<MovingMedianInterface> moving_median;
+  if (type == MovingMedianType::kTwoHeap) {
+    moving_median = std::make_unique<TwoHeapMovingMedian>(kWindowSize,
+                                                          sampling_probability);
+  } else {
+    moving_median =
+        std::make_unique<MovingMedian>(kWindowSize, sampling_probability);
+  }
+  RandomNumberGenerator rng(0);
+  for (int i = 0; i < kWindowSize; ++i) {
+    moving_median->AddNumber(rng, rng.GetUniformInt(0, kMaxValue));
+  }
+  return moving_median;
+}
+
+// Cost of sliding a filled window by one (unsampled) number.
+template <MovingMedianType kType>
+static void BM_AddNumber(benchmark::State& state) {
+  auto moving_median =
+      CreateFilledMovingMedian(kType, /*sampling_probability=*/1);
+  RandomNumberGenerator rng(1);
+  for (auto _ : state) {
+    moving_median->AddNumber(rng, rng.GetUniformInt(0, kMaxValue));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+std::unique_ptr<MovingMedianInterface> shared_moving_median;
+
+// Many request threads sharing one buyer's window, each adding numbers with
+// the chaffing v2 sampling probability and reading the median in between.
+template <MovingMedianType kType>
+static void BM_MultiThreadedAddNumberAndGetMedian(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    shared_moving_median =
+        CreateFilledMovingMedian(kType, kSamplingProbability);
+  }
+  RandomNumberGenerator rng(state.thread_index() + 1);
+  for (auto _ : state) {
+    shared_moving_median->AddNumber(rng, rng.GetUniformInt(0, kMaxValue));
+    for (int i = 0; i < kReadsPerAdd; ++i) {
+      benchmark::DoNotOptimize(shared_moving_median->IsWindowFilled());
+      benchmark::DoNotOptimize(shared_moving_median->GetMedian());
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    shared_moving_median.reset();
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_AddNumber, MovingMedianType::kMultiset);
+BENCHMARK_TEMPLATE(BM_AddNumber, MovingMedianType::kTwoHeap);
+BENCHMARK_TEMPLATE(BM_MultiThreadedAddNumberAndGetMedian,
+                   MovingMedianType::kMultiset)
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_MultiThreadedAddNumberAndGetMedian,
+                   MovingMedianType::kTwoHeap)
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+// Run the benchmark
+BENCHMARK_MAIN();
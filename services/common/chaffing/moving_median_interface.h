@@ -0,0 +1,52 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERVICES_COMMON_CHAFFING_MOVING_MEDIAN_INTERFACE_H_
+#define SERVICES_COMMON_CHAFFING_MOVING_MEDIAN_INTERFACE_H_
+
+#include "absl/status/statusor.h"
+#include "services/common/random/rng.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// Available implementations of MovingMedianInterface.
+enum class MovingMedianType {
+  // MovingMedian: sorted std::multiset plus an insertion order std::deque.
+  kMultiset,
+  // TwoHeapMovingMedian: preallocated ring buffer indexed by two heaps.
+  kTwoHeap,
+};
+
+// Sliding window of a fixed size over which the median is tracked. Once the
+// window is filled, numbers are only added to it with the sampling
+// probability the implementation was constructed with.
+class MovingMedianInterface {
+ public:
+  virtual ~MovingMedianInterface() = default;
+
+  // Inserts a new value into the sliding window. If the window reaches its
+  // maximum size, the oldest value is removed.
+  virtual void AddNumber(RandomNumberGenerator& rng, int value) = 0;
+
+  // Returns median of the window IF the window is full, otherwise an error.
+  virtual absl::StatusOr<int> GetMedian() const = 0;
+
+  virtual bool IsWindowFilled() const = 0;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_COMMON_CHAFFING_MOVING_MEDIAN_INTERFACE_H_
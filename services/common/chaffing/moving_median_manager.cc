@@ -18,6 +18,8 @@
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/synchronization/mutex.h"
+#include "services/common/chaffing/moving_median.h"
+#include "services/common/chaffing/two_heap_moving_median.h"
 
 namespace privacy_sandbox::bidding_auction_servers {
 
@@ -26,14 +28,26 @@ namespace {
 inline constexpr absl::string_view kBuyerNotPresentError =
     "Buyer not present in moving median manager: ";
 
+std::unique_ptr<MovingMedianInterface> CreateMovingMedian(
+    size_t window_size, float sampling_probability, MovingMedianType type) {
+  switch (type) {
+    case MovingMedianType::kTwoHeap:
+      return std::make_unique<TwoHeapMovingMedian>(window_size,
+                                                   sampling_probability);
+    case MovingMedianType::kMultiset:
+    default:
+      return std::make_unique<MovingMedian>(window_size, sampling_probability);
+  }
+}
+
 }  // namespace
 
 MovingMedianManager::MovingMedianManager(
     const absl::flat_hash_set<std::string>& buyers, size_t window_size,
-    float sampling_probability) {
+    float sampling_probability, MovingMedianType type) {
   for (const std::string& buyer : buyers) {
     moving_medians_by_buyer_.emplace(
-        buyer, MovingMedian(window_size, sampling_probability));
+        buyer, CreateMovingMedian(window_size, sampling_probability, type));
   }
 }
 
@@ -45,7 +59,7 @@ absl::Status MovingMedianManager::AddNumberToBuyerWindow(
         absl::StrCat(kBuyerNotPresentError, buyer));
   }
 
-  it->second.AddNumber(rng, val);
+  it->second->AddNumber(rng, val);
   return absl::OkStatus();
 }
 
@@ -57,7 +71,7 @@ absl::StatusOr<int> MovingMedianManager::GetMedian(
         absl::StrCat(kBuyerNotPresentError, buyer));
   }
 
-  return it->second.GetMedian();
+  return it->second->GetMedian();
 }
 
 absl::StatusOr<bool> MovingMedianManager::IsWindowFilled(
@@ -68,7 +82,7 @@ absl::StatusOr<bool> MovingMedianManager::IsWindowFilled(
         absl::StrCat(kBuyerNotPresentError, buyer));
   }
 
-  return it->second.IsWindowFilled();
+  return it->second->IsWindowFilled();
 }
 
 }  // namespace privacy_sandbox::bidding_auction_servers
@@ -17,20 +17,25 @@
 #ifndef SERVICES_COMMON_CHAFFING_MOVING_MEDIAN_MANAGER_H
 #define SERVICES_COMMON_CHAFFING_MOVING_MEDIAN_MANAGER_H
 
+#include <memory>
 #include <string>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
-#include "services/common/chaffing/moving_median.h"
+#include "services/common/chaffing/moving_median_interface.h"
 #include "services/common/random/rng.h"
 
 namespace privacy_sandbox::bidding_auction_servers {
 
+// Tracks a moving median per buyer, using the implementation given by
+// MovingMedianType.
 class MovingMedianManager {
  public:
-  explicit MovingMedianManager(const absl::flat_hash_set<std::string>& buyers,
-                               size_t window_size, float sampling_probability);
+  explicit MovingMedianManager(
+      const absl::flat_hash_set<std::string>& buyers, size_t window_size,
+      float sampling_probability,
+      MovingMedianType type = MovingMedianType::kMultiset);
 
   virtual ~MovingMedianManager() = default;
 
@@ -46,7 +51,8 @@ class MovingMedianManager {
   virtual absl::StatusOr<bool> IsWindowFilled(absl::string_view buyer) const;
 
  private:
-  absl::flat_hash_map<std::string, MovingMedian> moving_medians_by_buyer_;
+  absl::flat_hash_map<std::string, std::unique_ptr<MovingMedianInterface>>
+      moving_medians_by_buyer_;
 };
 
 }  // namespace privacy_sandbox::bidding_auction_servers
@@ -90,9 +90,12 @@ absl::StatusOr<std::string> EncodeAndCompressGetBidsPayload(
   return encoded_payload;
 }
 
+// Decodes a payload encoded by EncodeAndCompressGetBidsPayload, parsing the
+// proto into `get_bids_proto` so that the caller can allocate it (e.g. on an
+// arena). The get_bids_proto of the returned payload is left empty.
 template <typename GetBidsProto>
-absl::StatusOr<DecodedGetBidsPayload<GetBidsProto>> DecodeGetBidsPayload(
-    absl::string_view encoded_payload) {
+absl::StatusOr<DecodedGetBidsPayload<GetBidsProto>> DecodeGetBidsPayloadInto(
+    absl::string_view encoded_payload, GetBidsProto& get_bids_proto) {
   const bool is_get_bids_proto =
       std::is_base_of<GetBidsRequest::GetBidsRawRequest, GetBidsProto>::value ||
       std::is_base_of<GetBidsResponse::GetBidsRawResponse, GetBidsProto>::value;
@@ -119,7 +122,6 @@ absl::StatusOr<DecodedGetBidsPayload<GetBidsProto>> DecodeGetBidsPayload(
   PS_ASSIGN_OR_RETURN(CompressionType compression_type,
                       ToCompressionType(first_byte & kCompressionTypeMask));
 
-  GetBidsProto get_bids_proto;
   if (compression_type != CompressionType::kUncompressed) {
     PS_ASSIGN_OR_RETURN(std::string decompressed,
                         Decompress(compression_type, payload));
@@ -138,9 +140,19 @@ absl::StatusOr<DecodedGetBidsPayload<GetBidsProto>> DecodeGetBidsPayload(
   DecodedGetBidsPayload<GetBidsProto> decoded_payload = {
       .version = version,
       .compression_type = compression_type,
-      .payload_length = payload_length,
-      .get_bids_proto = std::move(get_bids_proto)};
+      .payload_length = payload_length};
+
+  return decoded_payload;
+}
 
+template <typename GetBidsProto>
+absl::StatusOr<DecodedGetBidsPayload<GetBidsProto>> DecodeGetBidsPayload(
+    absl::string_view encoded_payload) {
+  GetBidsProto get_bids_proto;
+  PS_ASSIGN_OR_RETURN(
+      DecodedGetBidsPayload<GetBidsProto> decoded_payload,
+      DecodeGetBidsPayloadInto(encoded_payload, get_bids_proto));
+  decoded_payload.get_bids_proto = std::move(get_bids_proto);
   return decoded_payload;
 }
 
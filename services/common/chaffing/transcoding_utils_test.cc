@@ -22,6 +22,7 @@
 
 #include "absl/strings/string_view.h"
 #include "gmock/gmock.h"
+#include "google/protobuf/arena.h"
 #include "google/protobuf/util/message_differencer.h"
 #include "gtest/gtest.h"
 
@@ -91,6 +92,30 @@ TEST(TranscodingUtilsTest,
   EXPECT_EQ(decoded_payload->version, 0);
 }
 
+TEST(TranscodingUtilsTest, VerifySuccessfulDecodeIntoArenaProto) {
+  GetBidsRequest::GetBidsRawRequest raw_request;
+  raw_request.set_is_chaff(true);
+  raw_request.mutable_log_context()->set_generation_id("testGenerationId");
+
+  absl::StatusOr<std::string> encoded_payload =
+      EncodeAndCompressGetBidsPayload(raw_request, CompressionType::kGzip);
+  ASSERT_TRUE(encoded_payload.ok());
+
+  google::protobuf::Arena arena;
+  auto* arena_request =
+      google::protobuf::Arena::Create<GetBidsRequest::GetBidsRawRequest>(
+          &arena);
+  auto decoded_payload =
+      DecodeGetBidsPayloadInto(*encoded_payload, *arena_request);
+  ASSERT_TRUE(decoded_payload.ok()) << decoded_payload.status();
+
+  google::protobuf::util::MessageDifferencer differencer;
+  EXPECT_TRUE(differencer.Equals(*arena_request, raw_request));
+  EXPECT_EQ(arena_request->GetArena(), &arena);
+  EXPECT_EQ(decoded_payload->compression_type, CompressionType::kGzip);
+  EXPECT_EQ(decoded_payload->version, 0);
+}
+
 }  // namespace
 
 }  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,199 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "services/common/chaffing/two_heap_moving_median.h"
+
+#include <utility>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+TwoHeapMovingMedian::TwoHeapMovingMedian(size_t window_size,
+                                         float sampling_probability)
+    : window_size_(window_size),
+      sampling_probability_(sampling_probability),
+      values_(window_size),
+      slot_heap_(window_size, kLow),
+      slot_pos_(window_size, 0) {
+  DCHECK_GT(window_size_, 0);
+  // The lower half holds the extra element of odd sized windows.
+  heaps_[kLow].reserve(window_size_ - window_size_ / 2);
+  heaps_[kHigh].reserve(window_size_ / 2);
+}
+
+bool TwoHeapMovingMedian::ShouldSample(RandomNumberGenerator& rng) const {
+  return sampling_probability_ != 0 &&
+         rng.GetUniformDouble(0.0, 1.0) < sampling_probability_;
+}
+
+void TwoHeapMovingMedian::AddNumber(RandomNumberGenerator& rng, int value) {
+  if (window_filled_.load(std::memory_order_acquire)) {
+    if (!ShouldSample(rng) || !mutex_.TryLock()) {
+      return;
+    }
+    ReplaceOldest(value);
+    mutex_.Unlock();
+    return;
+  }
+
+  absl::MutexLock lock(&mutex_);
+  // Another thread may have filled the window while this one was waiting.
+  if (size_ < window_size_) {
+    Insert(value);
+  } else if (ShouldSample(rng)) {
+    ReplaceOldest(value);
+  }
+}
+
+absl::StatusOr<int> TwoHeapMovingMedian::GetMedian() const {
+  if (!window_filled_.load(std::memory_order_acquire)) {
+    return absl::FailedPreconditionError("Window is not full.");
+  }
+  return median_.load(std::memory_order_relaxed);
+}
+
+bool TwoHeapMovingMedian::IsWindowFilled() const {
+  return window_filled_.load(std::memory_order_acquire);
+}
+
+void TwoHeapMovingMedian::Insert(int value) {
+  const uint32_t slot = size_++;
+  values_[slot] = value;
+  if (heaps_[kLow].empty() || value <= Top(kLow)) {
+    Push(kLow, slot);
+  } else {
+    Push(kHigh, slot);
+  }
+
+  // Keep the lower half the same size as the upper half or one larger.
+  if (heaps_[kLow].size() > heaps_[kHigh].size() + 1) {
+    Push(kHigh, Pop(kLow));
+  } else if (heaps_[kHigh].size() > heaps_[kLow].size()) {
+    Push(kLow, Pop(kHigh));
+  }
+
+  if (size_ == window_size_) {
+    PublishMedian();
+    window_filled_.store(true, std::memory_order_release);
+  }
+}
+
+void TwoHeapMovingMedian::ReplaceOldest(int value) {
+  const uint32_t slot = oldest_slot_;
+  oldest_slot_ = (oldest_slot_ + 1) % window_size_;
+  values_[slot] = value;
+
+  const Heap heap = slot_heap_[slot];
+  SiftDown(heap, SiftUp(heap, slot_pos_[slot]));
+
+  // Only the replaced value can be on the wrong side. If it is, it is now at
+  // the top of its heap, and exchanging the tops of both heaps restores the
+  // split without changing their sizes.
+  if (!heaps_[kHigh].empty() && Top(kLow) > Top(kHigh)) {
+    const uint32_t low_top = heaps_[kLow][0];
+    Place(kLow, 0, heaps_[kHigh][0]);
+    Place(kHigh, 0, low_top);
+    SiftDown(kLow, 0);
+    SiftDown(kHigh, 0);
+  }
+
+  PublishMedian();
+}
+
+void TwoHeapMovingMedian::PublishMedian() {
+  int median;
+  if (window_size_ % 2 == 0) {
+    // Even window size: average the two middle elements.
+    median = (static_cast<double>(Top(kLow)) + Top(kHigh)) / 2.0;
+  } else {
+    // Odd window size: the lower half holds the middle element.
+    median = Top(kLow);
+  }
+  median_.store(median, std::memory_order_relaxed);
+}
+
+bool TwoHeapMovingMedian::IsAbove(Heap heap, uint32_t i, uint32_t j) const {
+  const int a = values_[heaps_[heap][i]];
+  const int b = values_[heaps_[heap][j]];
+  return heap == kLow ? a > b : a < b;
+}
+
+void TwoHeapMovingMedian::Place(Heap heap, uint32_t pos, uint32_t slot) {
+  heaps_[heap][pos] = slot;
+  slot_heap_[slot] = heap;
+  slot_pos_[slot] = pos;
+}
+
+void TwoHeapMovingMedian::Push(Heap heap, uint32_t slot) {
+  heaps_[heap].push_back(slot);
+  Place(heap, heaps_[heap].size() - 1, slot);
+  SiftUp(heap, heaps_[heap].size() - 1);
+}
+
+uint32_t TwoHeapMovingMedian::Pop(Heap heap) {
+  std::vector<uint32_t>& entries = heaps_[heap];
+  const uint32_t top = entries[0];
+  Place(heap, 0, entries.back());
+  entries.pop_back();
+  if (!entries.empty()) {
+    SiftDown(heap, 0);
+  }
+  return top;
+}
+
+uint32_t TwoHeapMovingMedian::SiftUp(Heap heap, uint32_t pos) {
+  std::vector<uint32_t>& entries = heaps_[heap];
+  while (pos > 0) {
+    const uint32_t parent = (pos - 1) / 2;
+    if (!IsAbove(heap, pos, parent)) {
+      break;
+    }
+    const uint32_t slot = entries[pos];
+    Place(heap, pos, entries[parent]);
+    Place(heap, parent, slot);
+    pos = parent;
+  }
+  return pos;
+}
+
+void TwoHeapMovingMedian::SiftDown(Heap heap, uint32_t pos) {
+  std::vector<uint32_t>& entries = heaps_[heap];
+  const uint32_t size = entries.size();
+  while (true) {
+    uint32_t best = pos;
+    const uint32_t left = 2 * pos + 1;
+    const uint32_t right = left + 1;
+    if (left < size && IsAbove(heap, left, best)) {
+      best = left;
+    }
+    if (right < size && IsAbove(heap, right, best)) {
+      best = right;
+    }
+    if (best == pos) {
+      return;
+    }
+    const uint32_t slot = entries[pos];
+    Place(heap, pos, entries[best]);
+    Place(heap, best, slot);
+    pos = best;
+  }
+}
+
+int TwoHeapMovingMedian::Top(Heap heap) const {
+  return values_[heaps_[heap][0]];
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
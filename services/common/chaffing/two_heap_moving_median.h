@@ -0,0 +1,109 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERVICES_COMMON_CHAFFING_TWO_HEAP_MOVING_MEDIAN_H_
+#define SERVICES_COMMON_CHAFFING_TWO_HEAP_MOVING_MEDIAN_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "services/common/chaffing/moving_median_interface.h"
+#include "services/common/random/rng.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// Moving median over a fixed size window, with all memory allocated up front.
+//
+// The window is a ring buffer of `window_size` slots. The slots are indexed by
+// two heaps: a max-heap holding the lower half of the window and a min-heap
+// holding the upper half, so that the median is always at the top of the
+// heaps. Overwriting the oldest slot re-sifts that slot within its heap and
+// swaps the tops of the heaps if the halves crossed, in O(log n) and without
+// allocating.
+//
+// The median is published through an atomic after every update, so
+// GetMedian() and IsWindowFilled() never take a lock. Once the window is
+// filled, sampled numbers are dropped rather than waited for if another
+// thread is updating the window: the window is a random sample of the
+// stream either way, and request threads never block on each other.
+class TwoHeapMovingMedian : public MovingMedianInterface {
+ public:
+  explicit TwoHeapMovingMedian(size_t window_size, float sampling_probability);
+
+  // Not copyable or movable.
+  TwoHeapMovingMedian(const TwoHeapMovingMedian&) = delete;
+  TwoHeapMovingMedian& operator=(const TwoHeapMovingMedian&) = delete;
+
+  void AddNumber(RandomNumberGenerator& rng, int value) override;
+
+  absl::StatusOr<int> GetMedian() const override;
+
+  bool IsWindowFilled() const override;
+
+ private:
+  enum Heap : uint8_t { kLow = 0, kHigh = 1 };
+
+  bool ShouldSample(RandomNumberGenerator& rng) const;
+
+  // Appends `value` to the window while it is being filled.
+  void Insert(int value) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Overwrites the oldest value of the (filled) window with `value`.
+  void ReplaceOldest(int value) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void PublishMedian() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Whether the slot at position `i` of `heap` should be above the slot at
+  // position `j`.
+  bool IsAbove(Heap heap, uint32_t i, uint32_t j) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void Place(Heap heap, uint32_t pos, uint32_t slot)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void Push(Heap heap, uint32_t slot) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  uint32_t Pop(Heap heap) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Restores the heap property for the slot at `pos` and returns its new
+  // position.
+  uint32_t SiftUp(Heap heap, uint32_t pos)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void SiftDown(Heap heap, uint32_t pos) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  int Top(Heap heap) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const uint32_t window_size_;
+  const float sampling_probability_;
+
+  absl::Mutex mutex_;
+  // Ring buffer with the values of the window.
+  std::vector<int> values_ ABSL_GUARDED_BY(mutex_);
+  // Slot indices of the lower (max-heap) and upper (min-heap) halves.
+  std::array<std::vector<uint32_t>, 2> heaps_ ABSL_GUARDED_BY(mutex_);
+  // Heap and position within that heap of every slot.
+  std::vector<Heap> slot_heap_ ABSL_GUARDED_BY(mutex_);
+  std::vector<uint32_t> slot_pos_ ABSL_GUARDED_BY(mutex_);
+  // Number of slots in use; slots are filled in order before being reused.
+  uint32_t size_ ABSL_GUARDED_BY(mutex_) = 0;
+  // Slot holding the oldest value once the window is filled.
+  uint32_t oldest_slot_ ABSL_GUARDED_BY(mutex_) = 0;
+
+  std::atomic<int> median_ = 0;
+  std::atomic<bool> window_filled_ = false;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_COMMON_CHAFFING_TWO_HEAP_MOVING_MEDIAN_H_
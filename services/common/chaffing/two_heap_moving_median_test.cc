@@ -0,0 +1,164 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/common/chaffing/two_heap_moving_median.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "services/common/chaffing/moving_median.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+class TwoHeapMovingMedianTest : public testing::Test {
+ public:
+  TwoHeapMovingMedianTest() : rng_(1) {}
+
+ protected:
+  RandomNumberGenerator rng_;
+};
+
+TEST_F(TwoHeapMovingMedianTest, WindowNotFull) {
+  TwoHeapMovingMedian mm(3, 1);
+  mm.AddNumber(rng_, 1);
+  mm.AddNumber(rng_, 2);
+  EXPECT_FALSE(mm.IsWindowFilled());
+  auto result = mm.GetMedian();
+  EXPECT_FALSE(result.ok());
+  EXPECT_EQ(result.status().code(), absl::StatusCode::kFailedPrecondition);
+}
+
+TEST_F(TwoHeapMovingMedianTest, OddWindowSize) {
+  TwoHeapMovingMedian mm(3, 1);
+  mm.AddNumber(rng_, 1);
+  mm.AddNumber(rng_, 2);
+  mm.AddNumber(rng_, 3);
+  auto result = mm.GetMedian();
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result.value(), 2);
+
+  mm.AddNumber(rng_, 4);
+  result = mm.GetMedian();
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result.value(), 3);
+}
+
+TEST_F(TwoHeapMovingMedianTest, EvenWindowSize) {
+  TwoHeapMovingMedian mm(4, 1);
+  mm.AddNumber(rng_, 1);
+  mm.AddNumber(rng_, 2);
+  mm.AddNumber(rng_, 3);
+  mm.AddNumber(rng_, 4);
+  auto result = mm.GetMedian();
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result.value(), 2);
+
+  mm.AddNumber(rng_, 5);
+  result = mm.GetMedian();
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result.value(), 3);
+}
+
+TEST_F(TwoHeapMovingMedianTest, ReplacedValueMovesAcrossHalves) {
+  TwoHeapMovingMedian mm(3, 1);
+  mm.AddNumber(rng_, 10);
+  mm.AddNumber(rng_, 20);
+  mm.AddNumber(rng_, 30);
+  // Evicts 10 from the lower half and inserts into the upper half.
+  mm.AddNumber(rng_, 100);
+  auto result = mm.GetMedian();
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result.value(), 30);
+
+  // Evicts 20 and 30, pulling the median down again.
+  mm.AddNumber(rng_, 0);
+  mm.AddNumber(rng_, 1);
+  result = mm.GetMedian();
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result.value(), 1);
+}
+
+TEST_F(TwoHeapMovingMedianTest, LargeNumbers) {
+  TwoHeapMovingMedian mm(2, 1);
+  mm.AddNumber(rng_, 2147483647);
+  mm.AddNumber(rng_, 2147483645);
+  auto result = mm.GetMedian();
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result.value(), 2147483646);
+}
+
+TEST_F(TwoHeapMovingMedianTest, MatchesMultisetMovingMedian) {
+  for (size_t window_size : {1, 2, 7, 64, 101}) {
+    TwoHeapMovingMedian two_heap(window_size, 1);
+    MovingMedian multiset(window_size, 1);
+    for (int i = 0; i < 2000; ++i) {
+      // Small range so that the window holds many duplicates.
+      const int value = rng_.GetUniformInt(-50, 50);
+      two_heap.AddNumber(rng_, value);
+      multiset.AddNumber(rng_, value);
+      ASSERT_EQ(two_heap.IsWindowFilled(), multiset.IsWindowFilled());
+      if (multiset.IsWindowFilled()) {
+        ASSERT_EQ(*two_heap.GetMedian(), *multiset.GetMedian())
+            << "window_size: " << window_size << ", iteration: " << i;
+      }
+    }
+  }
+}
+
+TEST_F(TwoHeapMovingMedianTest, ConcurrentAddNumberAndGetMedian) {
+  TwoHeapMovingMedian mm(10, 1);
+  std::vector<std::thread> threads;
+  threads.reserve(20);
+
+  for (int i = 0; i < 20; ++i) {
+    threads.emplace_back([i, &mm]() {
+      RandomNumberGenerator rng(i);
+      for (int j = 0; j < 100; ++j) {
+        mm.AddNumber(rng, j);
+        (void)mm.GetMedian();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto result = mm.GetMedian();
+  ASSERT_TRUE(result.ok());
+  EXPECT_GE(result.value(), 0);
+  EXPECT_LT(result.value(), 100);
+}
+
+TEST_F(TwoHeapMovingMedianTest, ValidateSamplingProbabilityLogic) {
+  // Provide 0 for sampling probability, i.e. no numbers would be added to
+  // window once it's filled.
+  TwoHeapMovingMedian mm(1, 0);
+  mm.AddNumber(rng_, 1);
+  ASSERT_TRUE(mm.IsWindowFilled());
+
+  auto result = mm.GetMedian();
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result.value(), 1);
+
+  mm.AddNumber(rng_, 999);
+  result = mm.GetMedian();
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result.value(), 1);
+}
+
+}  // namespace
+
+}  // namespace privacy_sandbox::bidding_auction_servers
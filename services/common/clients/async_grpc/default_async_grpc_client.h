@@ -92,13 +92,14 @@ class DefaultAsyncGrpcClient
   using SecretRequest = std::pair<std::string, std::unique_ptr<Request>>;
 
   absl::Status EncryptPayloadAndSendRpc(
-      const std::string& plaintext, grpc::ClientContext* context,
+      std::string plaintext, grpc::ClientContext* context,
       absl::AnyInvocable<void(absl::StatusOr<std::unique_ptr<RawResponse>>,
                               ResponseMetadata) &&>
           on_done,
       absl::Duration timeout, RequestConfig request_config = {}) {
-    auto secret_request = EncryptRequestWithHpke<Request>(
-        plaintext, *crypto_client_, *key_fetcher_manager_, cloud_platform_);
+    auto secret_request =
+        EncryptRequestWithHpke<Request>(std::move(plaintext), *crypto_client_,
+                                        *key_fetcher_manager_, cloud_platform_);
     if (!secret_request.ok()) {
       PS_LOG(ERROR, SystemLogContext())
           << "Failed to encrypt the request: " << secret_request.status();
@@ -134,7 +135,7 @@ class DefaultAsyncGrpcClient
     PS_VLOG(6) << "Decrypting the response ...";
     absl::StatusOr<google::cmrt::sdk::crypto_service::v1::AeadDecryptResponse>
         decrypt_response = crypto_client_->AeadDecrypt(
-            response->response_ciphertext(), hpke_secret);
+            std::move(*response->mutable_response_ciphertext()), hpke_secret);
     if (!decrypt_response.ok()) {
       const std::string error = absl::StrCat(
           "Could not decrypt response: ", decrypt_response.status().message());
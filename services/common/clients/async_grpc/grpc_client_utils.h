@@ -33,12 +33,12 @@ namespace privacy_sandbox::bidding_auction_servers {
 template <typename Request>
 absl::StatusOr<std::pair<std::string, std::unique_ptr<Request>>>
 EncryptRequestWithHpke(
-    const std::string& plaintext, CryptoClientWrapperInterface& crypto_client,
+    std::string plaintext, CryptoClientWrapperInterface& crypto_client,
     server_common::KeyFetcherManagerInterface& key_fetcher_manager,
     server_common::CloudPlatform cloud_platform) {
   PS_ASSIGN_OR_RETURN(HpkeMessage encrypted_request,
-                      HpkeEncrypt(plaintext, crypto_client, key_fetcher_manager,
-                                  cloud_platform));
+                      HpkeEncrypt(std::move(plaintext), crypto_client,
+                                  key_fetcher_manager, cloud_platform));
   std::unique_ptr<Request> request = std::make_unique<Request>();
   request->set_key_id(std::move(encrypted_request.key_id));
   request->set_request_ciphertext(std::move(encrypted_request.ciphertext));
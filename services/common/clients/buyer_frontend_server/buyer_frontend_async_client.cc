@@ -64,7 +64,7 @@ absl::Status BuyerFrontEndAsyncGrpcClient::ExecuteInternal(
   PS_VLOG(kStats) << "compression_type: "
                   << static_cast<int>(request_config.compression_type);
 
-  return EncryptPayloadAndSendRpc(encoded_req_payload, context,
+  return EncryptPayloadAndSendRpc(std::move(encoded_req_payload), context,
                                   std::move(on_done), timeout, request_config);
 }
 
@@ -127,7 +127,9 @@ void BuyerFrontEndAsyncGrpcClient::SendRpc(
         absl::StatusOr<
             google::cmrt::sdk::crypto_service::v1::AeadDecryptResponse>
             decrypt_response = crypto_client_->AeadDecrypt(
-                params->ResponseRef()->response_ciphertext(), hpke_secret);
+                std::move(
+                    *params->ResponseRef()->mutable_response_ciphertext()),
+                hpke_secret);
         if (!decrypt_response.ok()) {
           PS_LOG(ERROR, SystemLogContext())
               << "BuyerFrontEndAsyncGrpcClient Failed to decrypt response";
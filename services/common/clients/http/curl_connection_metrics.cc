@@ -0,0 +1,220 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/common/clients/http/curl_connection_metrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "services/common/metric/server_definition.h"
+#include "src/util/status_macro/status_macros.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+constexpr absl::string_view kCurlPartition = "curl";
+
+// Queue delay of the transfers to a host. The host of a slot is set by the
+// first transfer to it and is kept for the lifetime of the server, so that
+// transfers find their slot without taking a lock.
+struct QueueDelay {
+  std::atomic<const std::string*> host{nullptr};
+  std::atomic<int64_t> total_us{0};
+  std::atomic<int64_t> transfers{0};
+};
+
+std::atomic<int64_t> num_transfers{0};
+std::atomic<int64_t> num_reused_transfers{0};
+std::atomic<int64_t> num_tls_handshakes{0};
+// Only used by the observers, not when recording transfers.
+ABSL_CONST_INIT absl::Mutex tls_handshakes_since_mu(absl::kConstInit);
+absl::Time tls_handshakes_since ABSL_GUARDED_BY(tls_handshakes_since_mu) =
+    absl::InfinitePast();
+QueueDelay queue_delays[kMaxTrackedHosts];
+QueueDelay other_hosts_queue_delay;
+
+// Returns the slot of `host`, claiming a free one if `host` is new.
+QueueDelay& GetQueueDelay(absl::string_view host) {
+  // The slots are claimed in order and never released, so a host is in the
+  // first slots up to the first free one.
+  for (QueueDelay& queue_delay : queue_delays) {
+    const std::string* slot_host =
+        queue_delay.host.load(std::memory_order_acquire);
+    if (slot_host == nullptr) {
+      auto new_host = std::make_unique<std::string>(host);
+      if (queue_delay.host.compare_exchange_strong(
+              slot_host, new_host.get(), std::memory_order_acq_rel,
+              std::memory_order_acquire)) {
+        new_host.release();
+        return queue_delay;
+      }
+      // Another transfer claimed the slot first; `slot_host` is its host.
+    }
+    if (*slot_host == host) {
+      return queue_delay;
+    }
+  }
+  return other_hosts_queue_delay;
+}
+
+template <typename ContextMap>
+absl::Status RegisterMetrics(ContextMap* context_map) {
+  PS_RETURN_IF_ERROR(context_map->AddObserverable(
+      metric::kHttpConnectionReuseRatio,
+      CurlConnectionMetrics::GetConnectionReuseRatio));
+  PS_RETURN_IF_ERROR(
+      context_map->AddObserverable(metric::kHttpTlsHandshakeRate,
+                                   CurlConnectionMetrics::GetTlsHandshakeRate));
+  PS_RETURN_IF_ERROR(
+      context_map->AddObserverable(metric::kHttpHostQueueDelayMs,
+                                   CurlConnectionMetrics::GetHostQueueDelayMs));
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::string_view GetHostFromUrl(absl::string_view url) {
+  if (size_t scheme_end = url.find("://");
+      scheme_end != absl::string_view::npos) {
+    url.remove_prefix(scheme_end + 3);
+  }
+  url = url.substr(0, url.find_first_of("/?#"));
+  // Drops the user info, if any.
+  if (size_t user_info_end = url.rfind('@');
+      user_info_end != absl::string_view::npos) {
+    url.remove_prefix(user_info_end + 1);
+  }
+  return url;
+}
+
+void RecordCurlTransfer(CURL* handle) {
+  long new_connections = 0;
+  curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &new_connections);
+  // Zero unless this transfer completed a TLS handshake itself.
+  curl_off_t app_connect_time_us = 0;
+  curl_easy_getinfo(handle, CURLINFO_APPCONNECT_TIME_T, &app_connect_time_us);
+  curl_off_t queue_time_us = 0;
+  curl_easy_getinfo(handle, CURLINFO_QUEUE_TIME_T, &queue_time_us);
+  char* url = nullptr;
+  curl_easy_getinfo(handle, CURLINFO_EFFECTIVE_URL, &url);
+  CurlConnectionMetrics::RecordTransfer(
+      url == nullptr ? "" : GetHostFromUrl(url),
+      /*new_connection=*/new_connections > 0,
+      /*tls_handshake=*/new_connections > 0 && app_connect_time_us > 0,
+      absl::Microseconds(queue_time_us));
+}
+
+absl::Status CurlConnectionMetrics::RegisterBfeMetrics() {
+  return RegisterMetrics(metric::BfeContextMap());
+}
+
+absl::Status CurlConnectionMetrics::RegisterSfeMetrics() {
+  return RegisterMetrics(metric::SfeContextMap());
+}
+
+void CurlConnectionMetrics::RecordTransfer(absl::string_view host,
+                                           bool new_connection,
+                                           bool tls_handshake,
+                                           absl::Duration queue_time) {
+  num_transfers.fetch_add(1, std::memory_order_relaxed);
+  if (!new_connection) {
+    num_reused_transfers.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (tls_handshake) {
+    num_tls_handshakes.fetch_add(1, std::memory_order_relaxed);
+  }
+  QueueDelay& queue_delay = GetQueueDelay(host);
+  queue_delay.total_us.fetch_add(absl::ToInt64Microseconds(queue_time),
+                                 std::memory_order_relaxed);
+  queue_delay.transfers.fetch_add(1, std::memory_order_relaxed);
+}
+
+absl::flat_hash_map<std::string, double>
+CurlConnectionMetrics::GetConnectionReuseRatio() {
+  const int64_t transfers =
+      num_transfers.exchange(0, std::memory_order_relaxed);
+  const int64_t reused_transfers =
+      num_reused_transfers.exchange(0, std::memory_order_relaxed);
+  if (transfers == 0) {
+    return {};
+  }
+  // A transfer split across two periods may make the count of reused
+  // transfers exceed the count of transfers.
+  const double reuse_ratio =
+      std::min(1.0, static_cast<double>(reused_transfers) / transfers);
+  return {{std::string(kCurlPartition), reuse_ratio}};
+}
+
+absl::flat_hash_map<std::string, double>
+CurlConnectionMetrics::GetTlsHandshakeRateAt(absl::Time now) {
+  const int64_t tls_handshakes =
+      num_tls_handshakes.exchange(0, std::memory_order_relaxed);
+  absl::MutexLock lock(&tls_handshakes_since_mu);
+  const absl::Duration elapsed = now - tls_handshakes_since;
+  tls_handshakes_since = now;
+  if (elapsed <= absl::ZeroDuration() || elapsed == absl::InfiniteDuration()) {
+    // Nothing to compute a rate over before the first observation.
+    return {};
+  }
+  const double rate = tls_handshakes / absl::ToDoubleSeconds(elapsed);
+  return {{std::string(kCurlPartition), rate}};
+}
+
+absl::flat_hash_map<std::string, double>
+CurlConnectionMetrics::GetHostQueueDelayMs() {
+  absl::flat_hash_map<std::string, double> queue_delay_ms;
+  auto report = [&queue_delay_ms](absl::string_view host,
+                                  QueueDelay& queue_delay) {
+    const int64_t transfers =
+        queue_delay.transfers.exchange(0, std::memory_order_relaxed);
+    const int64_t total_us =
+        queue_delay.total_us.exchange(0, std::memory_order_relaxed);
+    if (transfers > 0) {
+      queue_delay_ms.emplace(host, total_us / 1000.0 / transfers);
+    }
+  };
+  for (QueueDelay& queue_delay : queue_delays) {
+    const std::string* host = queue_delay.host.load(std::memory_order_acquire);
+    if (host == nullptr) {
+      break;
+    }
+    report(*host, queue_delay);
+  }
+  report(kOtherHosts, other_hosts_queue_delay);
+  return queue_delay_ms;
+}
+
+void CurlConnectionMetrics::ClearStates_TestOnly(absl::Time now) {
+  num_transfers = 0;
+  num_reused_transfers = 0;
+  num_tls_handshakes = 0;
+  {
+    absl::MutexLock lock(&tls_handshakes_since_mu);
+    tls_handshakes_since = now;
+  }
+  for (QueueDelay& queue_delay : queue_delays) {
+    delete queue_delay.host.exchange(nullptr);
+    queue_delay.total_us = 0;
+    queue_delay.transfers = 0;
+  }
+  other_hosts_queue_delay.total_us = 0;
+  other_hosts_queue_delay.transfers = 0;
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
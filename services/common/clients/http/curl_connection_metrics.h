@@ -0,0 +1,87 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef SERVICES_COMMON_CLIENTS_HTTP_CURL_CONNECTION_METRICS_H_
+#define SERVICES_COMMON_CLIENTS_HTTP_CURL_CONNECTION_METRICS_H_
+
+#include <string>
+
+#include <curl/curl.h>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// Maximum number of hosts the queueing delay is tracked for separately: the
+// first hosts the server transfers to. The transfers to any other host are
+// reported under kOtherHosts.
+inline constexpr int kMaxTrackedHosts = 32;
+inline constexpr absl::string_view kOtherHosts = "other";
+
+// Returns the host (and port, if any) of `url`.
+absl::string_view GetHostFromUrl(absl::string_view url);
+
+// Records the connection metrics of a completed curl transfer.
+void RecordCurlTransfer(CURL* handle);
+
+// Records how the curl fetchers of the server use their connections. These
+// metrics are observed periodically rather than logged per transfer.
+//
+// Transfers are recorded with atomic counters only, since they complete on the
+// event loops of all the curl fetchers of the server. The counters of a period
+// are read one at a time, so a transfer recorded during an observation may be
+// split across two periods.
+class CurlConnectionMetrics {
+ public:
+  // Registers the metrics with the BFE metric context map.
+  static absl::Status RegisterBfeMetrics();
+
+  // Registers the metrics with the SFE metric context map.
+  static absl::Status RegisterSfeMetrics();
+
+  // Records a completed transfer to `host`. `new_connection` is set if the
+  // transfer could not reuse (or multiplex over) an open connection, and
+  // `tls_handshake` if that new connection performed a TLS handshake.
+  // `queue_time` is the time the transfer waited in libcurl for a connection.
+  static void RecordTransfer(absl::string_view host, bool new_connection,
+                             bool tls_handshake, absl::Duration queue_time);
+
+  // Returns the ratio of transfers that reused an open connection since the
+  // previous call, or nothing if there were no transfers.
+  static absl::flat_hash_map<std::string, double> GetConnectionReuseRatio();
+
+  // Returns the number of TLS handshakes per second since the previous call.
+  static absl::flat_hash_map<std::string, double> GetTlsHandshakeRate() {
+    return GetTlsHandshakeRateAt(absl::Now());
+  }
+
+  // Same as above, observed at `now`.
+  static absl::flat_hash_map<std::string, double> GetTlsHandshakeRateAt(
+      absl::Time now);
+
+  // Returns the average time (in milliseconds) the transfers to each host
+  // waited in libcurl for a connection since the previous call.
+  static absl::flat_hash_map<std::string, double> GetHostQueueDelayMs();
+
+  // Clears all metric counters and tracked hosts. Must not run concurrently
+  // with RecordTransfer().
+  static void ClearStates_TestOnly(absl::Time now = absl::Now());
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_COMMON_CLIENTS_HTTP_CURL_CONNECTION_METRICS_H_
@@ -0,0 +1,133 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/common/clients/http/curl_connection_metrics.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+using ::testing::DoubleEq;
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+class CurlConnectionMetricsTest : public testing::Test {
+ protected:
+  void SetUp() override { CurlConnectionMetrics::ClearStates_TestOnly(now_); }
+
+  const absl::Time now_ = absl::FromUnixSeconds(1000);
+};
+
+TEST(GetHostFromUrlTest, ReturnsHostAndPort) {
+  EXPECT_EQ(GetHostFromUrl("https://kv.com/keys?k=a"), "kv.com");
+  EXPECT_EQ(GetHostFromUrl("https://kv.com:8443?k=a"), "kv.com:8443");
+  EXPECT_EQ(GetHostFromUrl("http://user:pw@kv.com#top"), "kv.com");
+  EXPECT_EQ(GetHostFromUrl("kv.com/keys"), "kv.com");
+  EXPECT_EQ(GetHostFromUrl(""), "");
+}
+
+TEST_F(CurlConnectionMetricsTest, ReportsConnectionReuseRatio) {
+  EXPECT_TRUE(CurlConnectionMetrics::GetConnectionReuseRatio().empty());
+
+  CurlConnectionMetrics::RecordTransfer("kv.com", /*new_connection=*/true,
+                                        /*tls_handshake=*/true,
+                                        absl::ZeroDuration());
+  for (int i = 0; i < 3; ++i) {
+    CurlConnectionMetrics::RecordTransfer("kv.com", /*new_connection=*/false,
+                                          /*tls_handshake=*/false,
+                                          absl::ZeroDuration());
+  }
+  EXPECT_THAT(CurlConnectionMetrics::GetConnectionReuseRatio(),
+              UnorderedElementsAre(Pair("curl", DoubleEq(0.75))));
+  // The ratio only covers the transfers since the previous observation.
+  EXPECT_TRUE(CurlConnectionMetrics::GetConnectionReuseRatio().empty());
+}
+
+TEST_F(CurlConnectionMetricsTest, ReportsTlsHandshakeRate) {
+  for (int i = 0; i < 4; ++i) {
+    CurlConnectionMetrics::RecordTransfer("kv.com", /*new_connection=*/true,
+                                          /*tls_handshake=*/i % 2 == 0,
+                                          absl::ZeroDuration());
+  }
+  EXPECT_THAT(
+      CurlConnectionMetrics::GetTlsHandshakeRateAt(now_ + absl::Seconds(4)),
+      UnorderedElementsAre(Pair("curl", DoubleEq(0.5))));
+  EXPECT_THAT(
+      CurlConnectionMetrics::GetTlsHandshakeRateAt(now_ + absl::Seconds(5)),
+      UnorderedElementsAre(Pair("curl", DoubleEq(0))));
+}
+
+TEST_F(CurlConnectionMetricsTest, ReportsAverageQueueDelayPerHost) {
+  CurlConnectionMetrics::RecordTransfer("a.com", /*new_connection=*/false,
+                                        /*tls_handshake=*/false,
+                                        absl::Milliseconds(1));
+  CurlConnectionMetrics::RecordTransfer("a.com", /*new_connection=*/false,
+                                        /*tls_handshake=*/false,
+                                        absl::Milliseconds(3));
+  CurlConnectionMetrics::RecordTransfer("b.com", /*new_connection=*/true,
+                                        /*tls_handshake=*/true,
+                                        absl::Milliseconds(5));
+  EXPECT_THAT(CurlConnectionMetrics::GetHostQueueDelayMs(),
+              UnorderedElementsAre(Pair("a.com", DoubleEq(2)),
+                                   Pair("b.com", DoubleEq(5))));
+  EXPECT_TRUE(CurlConnectionMetrics::GetHostQueueDelayMs().empty());
+}
+
+TEST_F(CurlConnectionMetricsTest, ReportsUntrackedHostsAsOther) {
+  for (int i = 0; i < kMaxTrackedHosts + 2; ++i) {
+    CurlConnectionMetrics::RecordTransfer(
+        absl::StrCat("host", i, ".com"), /*new_connection=*/false,
+        /*tls_handshake=*/false, absl::Milliseconds(i));
+  }
+  const auto queue_delay_ms = CurlConnectionMetrics::GetHostQueueDelayMs();
+  EXPECT_EQ(queue_delay_ms.size(), kMaxTrackedHosts + 1);
+  EXPECT_DOUBLE_EQ(queue_delay_ms.at("host0.com"), 0);
+  EXPECT_DOUBLE_EQ(queue_delay_ms.at(kOtherHosts),
+                   kMaxTrackedHosts + 0.5);
+}
+
+TEST_F(CurlConnectionMetricsTest, RecordsTransfersFromConcurrentThreads) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumTransfersPerThread = 1000;
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([i]() {
+      // Every thread races to track the same two hosts.
+      for (int j = 0; j < kNumTransfersPerThread; ++j) {
+        CurlConnectionMetrics::RecordTransfer(
+            (i + j) % 2 == 0 ? "a.com" : "b.com", /*new_connection=*/false,
+            /*tls_handshake=*/false, absl::Milliseconds(1));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_THAT(CurlConnectionMetrics::GetConnectionReuseRatio(),
+              UnorderedElementsAre(Pair("curl", DoubleEq(1))));
+  EXPECT_THAT(CurlConnectionMetrics::GetHostQueueDelayMs(),
+              UnorderedElementsAre(Pair("a.com", DoubleEq(1)),
+                                   Pair("b.com", DoubleEq(1))));
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -110,6 +110,17 @@ struct MultiCurlHttpFetcherAsyncOptions {
   int num_curl_workers = kDefaultNumCurlWorkers;
   absl::Duration curl_max_wait_time_ms = kDefaultMaxRequestWaitTime;
   int curl_queue_length = kDefaultMaxCurlPendingRequests;
+  // When set, the curl workers share a work-stealing CurlRequestScheduler
+  // instead of each draining its own CurlRequestQueue.
+  bool enable_work_stealing = false;
+  // When set, transfers negotiate HTTP/2 over TLS and wait for an open
+  // connection to the host they can be multiplexed over, rather than opening
+  // a new connection each.
+  bool enable_http2_multiplexing = false;
+  // Maximum number of concurrent streams per HTTP/2 connection. With
+  // curlmopt_max_host_connections this caps the streams per host. libcurl's
+  // default (100) is used if 0.
+  const long curlmopt_max_concurrent_streams = 0L;
 };
 
 // This struct maintains the data related to a Curl request, some of which
@@ -147,6 +158,10 @@ struct CurlRequestData {
 
   // Records the time when the request was started.
   absl::Time start_time;
+
+  // Intrusive link used by CurlRequestScheduler while the request waits in
+  // the lock-free inbox of a worker queue.
+  CurlRequestData* next_in_queue = nullptr;
 };
 
 }  // namespace privacy_sandbox::bidding_auction_servers
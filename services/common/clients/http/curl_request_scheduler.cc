@@ -0,0 +1,179 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/common/clients/http/curl_request_scheduler.h"
+
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "src/logger/request_context_logger.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+CurlRequestScheduler::CurlRequestScheduler(server_common::Executor* executor,
+                                           int num_workers,
+                                           int capacity_per_worker,
+                                           absl::Duration max_wait_time)
+    : executor_(executor),
+      capacity_per_worker_(capacity_per_worker),
+      max_wait_(max_wait_time),
+      queues_(num_workers) {
+  DCHECK(executor_ != nullptr);
+  CHECK_GT(num_workers, 0);
+}
+
+CurlRequestScheduler::~CurlRequestScheduler() {
+  Shutdown();
+  for (auto& queue : queues_) {
+    absl::MutexLock lock(&queue.mu);
+    DrainInbox(queue);
+    for (auto& request : queue.pending) {
+      std::move(request->done_callback)(absl::InternalError("Shutting down."));
+    }
+    queue.pending.clear();
+    queue.size.store(0, std::memory_order_relaxed);
+  }
+}
+
+void CurlRequestScheduler::Schedule(std::unique_ptr<CurlRequestData> request) {
+  if (shutting_down_.load(std::memory_order_acquire)) {
+    std::move(request->done_callback)(absl::InternalError("Shutting down."));
+    return;
+  }
+
+  WorkerQueue& queue =
+      queues_[next_queue_.fetch_add(1, std::memory_order_relaxed) %
+              queues_.size()];
+  // The size is bumped before the request is visible in the inbox, so that a
+  // worker about to go idle (see Next()) either sees the new size or is woken
+  // up below.
+  if (queue.size.fetch_add(1) >= capacity_per_worker_) {
+    queue.size.fetch_sub(1);
+    std::move(request->done_callback)(
+        absl::ResourceExhaustedError("Request Queue Limit Exceeded."));
+    return;
+  }
+
+  request->start_time = absl::Now();
+  CurlRequestData* node = request.release();
+  node->next_in_queue = queue.inbox.load(std::memory_order_relaxed);
+  while (!queue.inbox.compare_exchange_weak(node->next_in_queue, node,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+  }
+
+  if (num_idle_.load() > 0) {
+    absl::MutexLock lock(&idle_mu_);
+    idle_cv_.Signal();
+  }
+}
+
+std::unique_ptr<CurlRequestData> CurlRequestScheduler::Next(int worker_index) {
+  DCHECK_LT(worker_index, queues_.size());
+  const int num_queues = queues_.size();
+  while (!shutting_down_.load(std::memory_order_acquire)) {
+    // Own queue first, then steal from the others.
+    for (int i = 0; i < num_queues; ++i) {
+      WorkerQueue& queue = queues_[(worker_index + i) % num_queues];
+      if (queue.size.load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+      if (auto request = Dequeue(queue)) {
+        if (i > 0) {
+          PS_VLOG(6) << "Curl worker " << worker_index
+                     << " stole a request from worker "
+                     << (worker_index + i) % num_queues;
+        }
+        return request;
+      }
+    }
+
+    absl::MutexLock lock(&idle_mu_);
+    num_idle_.fetch_add(1);
+    if (NumQueued() == 0 && !shutting_down_.load(std::memory_order_acquire)) {
+      idle_cv_.Wait(&idle_mu_);
+    }
+    num_idle_.fetch_sub(1);
+  }
+  return nullptr;
+}
+
+void CurlRequestScheduler::Shutdown() {
+  shutting_down_.store(true, std::memory_order_release);
+  absl::MutexLock lock(&idle_mu_);
+  idle_cv_.SignalAll();
+}
+
+int CurlRequestScheduler::NumQueued() const {
+  int num_queued = 0;
+  for (const auto& queue : queues_) {
+    num_queued += queue.size.load();
+  }
+  return num_queued;
+}
+
+std::unique_ptr<CurlRequestData> CurlRequestScheduler::Dequeue(
+    WorkerQueue& queue) {
+  std::unique_ptr<CurlRequestData> request;
+  std::vector<std::unique_ptr<CurlRequestData>> expired;
+  {
+    absl::MutexLock lock(&queue.mu);
+    DrainInbox(queue);
+    const absl::Time now = absl::Now();
+    while (!queue.pending.empty()) {
+      std::unique_ptr<CurlRequestData> oldest =
+          std::move(queue.pending.front());
+      queue.pending.pop_front();
+      queue.size.fetch_sub(1, std::memory_order_relaxed);
+      if (now - oldest->start_time < max_wait_) {
+        request = std::move(oldest);
+        break;
+      }
+      expired.push_back(std::move(oldest));
+    }
+  }
+
+  // Move the callbacks to a different thread.
+  for (auto& expired_request : expired) {
+    executor_->Run([expired_request = std::move(expired_request)]() {
+      std::move(expired_request->done_callback)(
+          absl::InternalError("Request timed out waiting in the queue"));
+    });
+  }
+  return request;
+}
+
+void CurlRequestScheduler::DrainInbox(WorkerQueue& queue) {
+  CurlRequestData* newest =
+      queue.inbox.exchange(nullptr, std::memory_order_acquire);
+  // Reverse the stack in place so that the requests get appended oldest
+  // first.
+  CurlRequestData* oldest = nullptr;
+  while (newest != nullptr) {
+    CurlRequestData* next = newest->next_in_queue;
+    newest->next_in_queue = oldest;
+    oldest = newest;
+    newest = next;
+  }
+  while (oldest != nullptr) {
+    CurlRequestData* next = oldest->next_in_queue;
+    oldest->next_in_queue = nullptr;
+    queue.pending.emplace_back(oldest);
+    oldest = next;
+  }
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,124 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef SERVICES_COMMON_CLIENTS_HTTP_CURL_REQUEST_SCHEDULER_H_
+#define SERVICES_COMMON_CLIENTS_HTTP_CURL_REQUEST_SCHEDULER_H_
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "absl/base/optimization.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "services/common/clients/http/curl_request_data.h"
+#include "src/concurrent/executor.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// Work-stealing scheduler for the curl requests of a pool of curl workers.
+//
+// Every worker owns a queue. Requests are spread round robin over the queues
+// and are pushed onto a queue's lock-free inbox, so producers never take a
+// lock (or contend with the workers) to enqueue. A worker takes requests from
+// its own queue first and steals from the other queues once it runs dry,
+// which keeps all the workers busy when a burst lands on a few queues.
+//
+// All requests wait for at most the same `max_wait_time`, so the oldest
+// request in a queue always has the earliest deadline. Requests are expired
+// from the head of a queue whenever a worker dequeues from it, which needs
+// neither a timer nor an event loop.
+//
+// This class is thread-safe.
+class CurlRequestScheduler {
+ public:
+  explicit CurlRequestScheduler(server_common::Executor* executor,
+                                int num_workers, int capacity_per_worker,
+                                absl::Duration max_wait_time);
+
+  // Fails all the requests still queued. Workers must be done calling Next()
+  // before the scheduler is destroyed.
+  ~CurlRequestScheduler();
+
+  // Not copyable or movable.
+  CurlRequestScheduler(const CurlRequestScheduler&) = delete;
+  CurlRequestScheduler& operator=(const CurlRequestScheduler&) = delete;
+
+  // Queues the request for one of the workers. If the chosen worker queue is
+  // full (or the scheduler is shutting down), the request's callback is
+  // invoked with an error right away.
+  void Schedule(std::unique_ptr<CurlRequestData> request);
+
+  // Returns the next request for the worker at `worker_index`, stealing from
+  // the other workers' queues if its own queue is empty. Blocks until a
+  // request is available and returns nullptr once Shutdown() is called.
+  std::unique_ptr<CurlRequestData> Next(int worker_index);
+
+  // Wakes up all the workers blocked in Next() and rejects new requests.
+  void Shutdown();
+
+  // Returns the number of requests waiting across all the queues.
+  int NumQueued() const;
+
+ private:
+  // Queues are cache line aligned so that the atomics and mutexes of
+  // neighbouring queues don't false share.
+  struct ABSL_CACHELINE_ALIGNED WorkerQueue {
+    // Lock-free multi producer stack of incoming requests, newest first,
+    // linked through `CurlRequestData::next_in_queue`.
+    std::atomic<CurlRequestData*> inbox = nullptr;
+    // Number of requests in `inbox` and `pending`.
+    std::atomic<int> size = 0;
+    // Serializes the consumers (the owner and any thieves).
+    absl::Mutex mu;
+    // Requests moved out of the inbox, oldest (i.e. earliest deadline) first.
+    std::deque<std::unique_ptr<CurlRequestData>> pending ABSL_GUARDED_BY(mu);
+  };
+
+  // Returns the oldest unexpired request from `queue`, if any, and fails the
+  // expired requests found ahead of it.
+  std::unique_ptr<CurlRequestData> Dequeue(WorkerQueue& queue)
+      ABSL_LOCKS_EXCLUDED(queue.mu);
+
+  // Moves all the requests from the inbox of `queue` to its pending requests.
+  static void DrainInbox(WorkerQueue& queue)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(queue.mu);
+
+  // Executor used to run the callbacks of expired requests.
+  server_common::Executor* executor_;
+
+  const int capacity_per_worker_;
+
+  // Max time a request is allowed to wait in a queue before it is expired.
+  const absl::Duration max_wait_;
+
+  std::vector<WorkerQueue> queues_;
+
+  // Index of the queue that receives the next request.
+  std::atomic<unsigned int> next_queue_ = 0;
+
+  // Idle workers wait on `idle_cv_`. Producers only take `idle_mu_` (to wake
+  // a worker up) when `num_idle_` is non-zero.
+  absl::Mutex idle_mu_;
+  absl::CondVar idle_cv_;
+  std::atomic<int> num_idle_ = 0;
+
+  std::atomic<bool> shutting_down_ = false;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_COMMON_CLIENTS_HTTP_CURL_REQUEST_SCHEDULER_H_
@@ -0,0 +1,196 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/common/clients/http/curl_request_scheduler.h"
+
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "grpc/event_engine/event_engine.h"
+#include "grpc/grpc.h"
+#include "include/gtest/gtest.h"
+#include "services/common/clients/http/curl_request_data.h"
+#include "services/common/test/utils/test_init.h"
+#include "src/concurrent/event_engine_executor.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+constexpr absl::Duration kBigWaitTime = absl::Minutes(30);
+constexpr absl::Duration kSmallWaitTime = absl::Milliseconds(1);
+
+std::unique_ptr<CurlRequestData> CreateRequest(
+    OnDoneFetchUrlWithMetadata on_done) {
+  return std::make_unique<CurlRequestData>(std::vector<std::string>{},
+                                           std::move(on_done),
+                                           std::vector<std::string>{}, false);
+}
+
+std::unique_ptr<CurlRequestData> CreateRequest() {
+  // NOLINTNEXTLINE
+  return CreateRequest([](absl::StatusOr<HTTPResponse>) {});
+}
+
+class CurlRequestSchedulerTest : public ::testing::Test {
+ protected:
+  CurlRequestSchedulerTest() {
+    CommonTestInit();
+    executor_ = std::make_unique<server_common::EventEngineExecutor>(
+        grpc_event_engine::experimental::CreateEventEngine());
+  }
+
+  std::unique_ptr<server_common::EventEngineExecutor> executor_;
+  server_common::GrpcInit gprc_init;
+};
+
+TEST_F(CurlRequestSchedulerTest, CanScheduleAndDequeue) {
+  CurlRequestScheduler scheduler(executor_.get(), /*num_workers=*/1,
+                                 /*capacity_per_worker=*/1, kBigWaitTime);
+  scheduler.Schedule(CreateRequest());
+  EXPECT_EQ(scheduler.NumQueued(), 1);
+  EXPECT_NE(scheduler.Next(/*worker_index=*/0), nullptr);
+  EXPECT_EQ(scheduler.NumQueued(), 0);
+}
+
+TEST_F(CurlRequestSchedulerTest, DequeuesInArrivalOrder) {
+  CurlRequestScheduler scheduler(executor_.get(), /*num_workers=*/1,
+                                 /*capacity_per_worker=*/3, kBigWaitTime);
+  std::vector<CurlRequestData*> scheduled;
+  for (int i = 0; i < 3; ++i) {
+    auto request = CreateRequest();
+    scheduled.push_back(request.get());
+    scheduler.Schedule(std::move(request));
+  }
+  for (int i = 0; i < 3; ++i) {
+    auto request = scheduler.Next(/*worker_index=*/0);
+    EXPECT_EQ(request.get(), scheduled[i]);
+  }
+}
+
+TEST_F(CurlRequestSchedulerTest, IdleWorkerStealsFromOtherQueues) {
+  CurlRequestScheduler scheduler(executor_.get(), /*num_workers=*/2,
+                                 /*capacity_per_worker=*/1, kBigWaitTime);
+  // Requests are spread round robin, one on each worker's queue.
+  scheduler.Schedule(CreateRequest());
+  scheduler.Schedule(CreateRequest());
+  EXPECT_NE(scheduler.Next(/*worker_index=*/0), nullptr);
+  EXPECT_NE(scheduler.Next(/*worker_index=*/0), nullptr);
+  EXPECT_EQ(scheduler.NumQueued(), 0);
+}
+
+TEST_F(CurlRequestSchedulerTest, RejectsRequestsWhenQueueIsFull) {
+  CurlRequestScheduler scheduler(executor_.get(), /*num_workers=*/1,
+                                 /*capacity_per_worker=*/1, kBigWaitTime);
+  scheduler.Schedule(CreateRequest());
+  absl::Status status;
+  scheduler.Schedule(CreateRequest(
+      [&status](absl::StatusOr<HTTPResponse> response) {
+        status = response.status();
+      }));
+  EXPECT_EQ(status.code(), absl::StatusCode::kResourceExhausted);
+  EXPECT_EQ(scheduler.NumQueued(), 1);
+}
+
+TEST_F(CurlRequestSchedulerTest, ExpiresRequestsWaitingTooLong) {
+  CurlRequestScheduler scheduler(executor_.get(), /*num_workers=*/1,
+                                 /*capacity_per_worker=*/2, kSmallWaitTime);
+  absl::Notification expired;
+  absl::Status status;
+  scheduler.Schedule(CreateRequest(
+      [&expired, &status](absl::StatusOr<HTTPResponse> response) {
+        status = response.status();
+        expired.Notify();
+      }));
+  absl::SleepFor(10 * kSmallWaitTime);
+  auto fresh_request = CreateRequest();
+  CurlRequestData* fresh_request_ptr = fresh_request.get();
+  scheduler.Schedule(std::move(fresh_request));
+
+  EXPECT_EQ(scheduler.Next(/*worker_index=*/0).get(), fresh_request_ptr);
+  expired.WaitForNotification();
+  EXPECT_EQ(status.code(), absl::StatusCode::kInternal);
+}
+
+TEST_F(CurlRequestSchedulerTest, NextReturnsNullOnShutdown) {
+  CurlRequestScheduler scheduler(executor_.get(), /*num_workers=*/1,
+                                 /*capacity_per_worker=*/1, kBigWaitTime);
+  std::thread worker([&scheduler]() {
+    EXPECT_EQ(scheduler.Next(/*worker_index=*/0), nullptr);
+  });
+  scheduler.Shutdown();
+  worker.join();
+}
+
+TEST_F(CurlRequestSchedulerTest, FailsQueuedRequestsOnDestruction) {
+  absl::Status status;
+  {
+    CurlRequestScheduler scheduler(executor_.get(), /*num_workers=*/1,
+                                   /*capacity_per_worker=*/1, kBigWaitTime);
+    scheduler.Schedule(CreateRequest(
+        [&status](absl::StatusOr<HTTPResponse> response) {
+          status = response.status();
+        }));
+  }
+  EXPECT_EQ(status.code(), absl::StatusCode::kInternal);
+}
+
+TEST_F(CurlRequestSchedulerTest, WorkersDequeueFromMultipleProducers) {
+  constexpr int kNumWorkers = 4;
+  constexpr int kNumProducers = 8;
+  constexpr int kRequestsPerProducer = 1000;
+  CurlRequestScheduler scheduler(
+      executor_.get(), kNumWorkers,
+      /*capacity_per_worker=*/kNumProducers * kRequestsPerProducer,
+      kBigWaitTime);
+  absl::BlockingCounter dequeued(kNumProducers * kRequestsPerProducer);
+  std::vector<std::thread> workers;
+  workers.reserve(kNumWorkers);
+  for (int i = 0; i < kNumWorkers; ++i) {
+    workers.emplace_back([&scheduler, &dequeued, i]() {
+      while (auto request = scheduler.Next(i)) {
+        dequeued.DecrementCount();
+      }
+    });
+  }
+
+  std::vector<std::thread> producers;
+  producers.reserve(kNumProducers);
+  for (int i = 0; i < kNumProducers; ++i) {
+    producers.emplace_back([&scheduler]() {
+      for (int j = 0; j < kRequestsPerProducer; ++j) {
+        scheduler.Schedule(CreateRequest());
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  dequeued.Wait();
+  EXPECT_EQ(scheduler.NumQueued(), 0);
+
+  scheduler.Shutdown();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
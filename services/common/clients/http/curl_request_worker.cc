@@ -26,19 +26,43 @@ CurlRequestWorker::CurlRequestWorker(server_common::Executor* executor,
                                      CurlRequestQueue& request_queue,
                                      const long curlmopt_maxconnects,
                                      const long curlmopt_max_total_connections,
-                                     const long curlmopt_max_host_connections)
+                                     const long curlmopt_max_host_connections,
+                                     bool enable_http2_multiplexing,
+                                     const long curlmopt_max_concurrent_streams)
     : executor_(executor),
-      request_queue_(request_queue),
-      multi_curl_request_manager_(curlmopt_maxconnects,
-                                  curlmopt_max_total_connections,
-                                  curlmopt_max_host_connections, *executor) {
+      request_queue_(&request_queue),
+      multi_curl_request_manager_(
+          curlmopt_maxconnects, curlmopt_max_total_connections,
+          curlmopt_max_host_connections, *executor, enable_http2_multiplexing,
+          curlmopt_max_concurrent_streams) {
   // Start processing thread.
   executor_->Run([this]() { ProcessRequests(); });
 }
 
+CurlRequestWorker::CurlRequestWorker(server_common::Executor* executor,
+                                     CurlRequestScheduler& scheduler,
+                                     int worker_index,
+                                     const long curlmopt_maxconnects,
+                                     const long curlmopt_max_total_connections,
+                                     const long curlmopt_max_host_connections,
+                                     bool enable_http2_multiplexing,
+                                     const long curlmopt_max_concurrent_streams)
+    : executor_(executor),
+      scheduler_(&scheduler),
+      worker_index_(worker_index),
+      multi_curl_request_manager_(
+          curlmopt_maxconnects, curlmopt_max_total_connections,
+          curlmopt_max_host_connections, *executor, enable_http2_multiplexing,
+          curlmopt_max_concurrent_streams) {
+  // Start processing thread.
+  executor_->Run([this]() { ProcessScheduledRequests(); });
+}
+
 CurlRequestWorker::~CurlRequestWorker() {
-  {
-    absl::MutexLock lock(&request_queue_.Mu());
+  if (scheduler_ != nullptr) {
+    scheduler_->Shutdown();
+  } else {
+    absl::MutexLock lock(&request_queue_->Mu());
     shutdown_requested_ = true;
   }
   shutdown_complete_.WaitForNotification();
@@ -46,13 +70,13 @@ CurlRequestWorker::~CurlRequestWorker() {
 
 void CurlRequestWorker::ProcessRequests() {
   CurlRequestWaiterArg waiter_arg = {
-      .queue = request_queue_,
+      .queue = *request_queue_,
       .shutdown_requested = shutdown_requested_,
   };
   while (true) {
     std::unique_ptr<CurlRequestData> request;
     {
-      absl::MutexLock lock(&request_queue_.Mu(),
+      absl::MutexLock lock(&request_queue_->Mu(),
                            absl::Condition(
                                +[](CurlRequestWaiterArg* waiter_arg) {
 #pragma clang diagnostic push
@@ -65,11 +89,19 @@ void CurlRequestWorker::ProcessRequests() {
       if (shutdown_requested_) {
         break;
       }
-      request = request_queue_.Dequeue();
+      request = request_queue_->Dequeue();
     }
     multi_curl_request_manager_.StartProcessing(std::move(request));
   }
   shutdown_complete_.Notify();
 }
 
+void CurlRequestWorker::ProcessScheduledRequests() {
+  while (std::unique_ptr<CurlRequestData> request =
+             scheduler_->Next(worker_index_)) {
+    multi_curl_request_manager_.StartProcessing(std::move(request));
+  }
+  shutdown_complete_.Notify();
+}
+
 }  // namespace privacy_sandbox::bidding_auction_servers
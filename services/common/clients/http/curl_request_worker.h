@@ -25,6 +25,7 @@
 #include "absl/synchronization/notification.h"
 #include "services/common/clients/http/curl_request_data.h"
 #include "services/common/clients/http/curl_request_queue.h"
+#include "services/common/clients/http/curl_request_scheduler.h"
 #include "services/common/clients/http/http_fetcher_async.h"
 #include "services/common/clients/http/multi_curl_request_manager.h"
 #include "services/common/loggers/request_log_context.h"
@@ -39,7 +40,19 @@ class CurlRequestWorker {
                              CurlRequestQueue& request_queue,
                              const long curlmopt_maxconnects = 0,
                              const long curlmopt_max_total_connections = 0,
-                             const long curlmopt_max_host_connections = 0);
+                             const long curlmopt_max_host_connections = 0,
+                             bool enable_http2_multiplexing = false,
+                             const long curlmopt_max_concurrent_streams = 0);
+
+  // Creates a worker that gets its requests from the queue at `worker_index`
+  // of the (shared) `scheduler`, stealing from the other queues when idle.
+  explicit CurlRequestWorker(server_common::Executor* executor,
+                             CurlRequestScheduler& scheduler, int worker_index,
+                             const long curlmopt_maxconnects = 0,
+                             const long curlmopt_max_total_connections = 0,
+                             const long curlmopt_max_host_connections = 0,
+                             bool enable_http2_multiplexing = false,
+                             const long curlmopt_max_concurrent_streams = 0);
 
   ~CurlRequestWorker();
 
@@ -54,8 +67,14 @@ class CurlRequestWorker {
   // Executes a thread to run the processing loop.
   server_common::Executor* executor_;
 
-  // Request queue to monitor for incoming requests.
-  CurlRequestQueue& request_queue_;
+  // Request queue to monitor for incoming requests. Not set for workers
+  // that are fed by a scheduler.
+  CurlRequestQueue* request_queue_ = nullptr;
+
+  // Scheduler to get the requests from, if any, and the index of this
+  // worker's queue in it.
+  CurlRequestScheduler* scheduler_ = nullptr;
+  int worker_index_ = 0;
 
   // Used to decide when to break out of the processing loop.
   bool shutdown_requested_ = false;
@@ -69,6 +88,9 @@ class CurlRequestWorker {
   // Pulls a requests off the queue and executes it, otherwise blocks
   // for a request to arrive.
   void ProcessRequests();
+
+  // Same as above but pulls the requests from the scheduler.
+  void ProcessScheduledRequests();
 };
 
 }  // namespace privacy_sandbox::bidding_auction_servers
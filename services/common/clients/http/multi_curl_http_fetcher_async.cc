@@ -46,6 +46,7 @@ MultiCurlHttpFetcherAsync::MultiCurlHttpFetcherAsync(
           absl::GetFlag(FLAGS_https_fetch_skips_tls_verification)
               .value_or(false)),
       ca_cert_(options.ca_cert),
+      enable_http2_multiplexing_(options.enable_http2_multiplexing),
       num_curl_workers_(options.num_curl_workers) {
   DCHECK_GT(num_curl_workers_, 0);
   auto ca_cert_blob = GetFileContent(ca_cert_, /*log_on_error=*/true);
@@ -54,13 +55,29 @@ MultiCurlHttpFetcherAsync::MultiCurlHttpFetcherAsync(
 
   // Setup curl workers and their work queues.
   curl_request_workers_.reserve(num_curl_workers_);
+  if (options.enable_work_stealing) {
+    request_scheduler_ = std::make_unique<CurlRequestScheduler>(
+        executor_, num_curl_workers_, options.curl_queue_length,
+        options.curl_max_wait_time_ms);
+    for (int i = 0; i < num_curl_workers_; ++i) {
+      curl_request_workers_.push_back(std::make_unique<CurlRequestWorker>(
+          executor_, *request_scheduler_, /*worker_index=*/i,
+          options.curlmopt_maxconnects, options.curlmopt_max_total_connections,
+          options.curlmopt_max_host_connections,
+          options.enable_http2_multiplexing,
+          options.curlmopt_max_concurrent_streams));
+    }
+    return;
+  }
   for (int i = 0; i < options.num_curl_workers; ++i) {
     auto request_queue = std::make_unique<CurlRequestQueue>(
         executor_, options.curl_queue_length, options.curl_max_wait_time_ms);
     curl_request_workers_.push_back(std::make_unique<CurlRequestWorker>(
         executor_, *request_queue, options.curlmopt_maxconnects,
         options.curlmopt_max_total_connections,
-        options.curlmopt_max_host_connections));
+        options.curlmopt_max_host_connections,
+        options.enable_http2_multiplexing,
+        options.curlmopt_max_concurrent_streams));
     request_queues_.emplace_back(std::move(request_queue));
   }
 }
@@ -185,6 +202,13 @@ std::unique_ptr<CurlRequestData> MultiCurlHttpFetcherAsync::CreateCurlRequest(
   // Set CURLOPT_ACCEPT_ENCODING to an empty string to pass all supported
   // encodings. See https://curl.se/libcurl/c/CURLOPT_ACCEPT_ENCODING.html.
   curl_easy_setopt(req_handle, CURLOPT_ACCEPT_ENCODING, "");
+  if (enable_http2_multiplexing_) {
+    curl_easy_setopt(req_handle, CURLOPT_HTTP_VERSION,
+                     CURL_HTTP_VERSION_2TLS);
+    // Wait for an open connection to the host to be confirmed as multiplexable
+    // rather than opening a new one.
+    curl_easy_setopt(req_handle, CURLOPT_PIPEWAIT, 1L);
+  }
 
   if (skip_tls_verification_) {
     curl_easy_setopt(req_handle, CURLOPT_SSL_VERIFYPEER, 0L);
@@ -204,6 +228,11 @@ std::unique_ptr<CurlRequestData> MultiCurlHttpFetcherAsync::CreateCurlRequest(
 
 void MultiCurlHttpFetcherAsync::ScheduleAsyncCurlRequest(
     std::unique_ptr<CurlRequestData> request) {
+  if (request_scheduler_ != nullptr) {
+    request_scheduler_->Schedule(std::move(request));
+    return;
+  }
+
   // Spreads the requests in a uniformly distributed (random) manner across
   // the available queues/workers.
   static std::random_device random_device;
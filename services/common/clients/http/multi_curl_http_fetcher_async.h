@@ -29,6 +29,7 @@
 #include "absl/synchronization/notification.h"
 #include "services/common/clients/http/curl_request_data.h"
 #include "services/common/clients/http/curl_request_queue.h"
+#include "services/common/clients/http/curl_request_scheduler.h"
 #include "services/common/clients/http/curl_request_worker.h"
 #include "services/common/clients/http/http_fetcher_async.h"
 #include "services/common/util/event.h"
@@ -188,6 +189,9 @@ class MultiCurlHttpFetcherAsync final : public HttpFetcherAsync {
   // CA cert blob holding the contents of roots.pem.
   std::string ca_cert_blob_;
 
+  // Whether transfers are multiplexed over HTTP/2 connections.
+  const bool enable_http2_multiplexing_;
+
   // Synchronizes the status of shutdown for destructor and execution loop.
   bool shutdown_requested_ = false;
   absl::Notification shutdown_complete_;
@@ -195,6 +199,9 @@ class MultiCurlHttpFetcherAsync final : public HttpFetcherAsync {
   const int num_curl_workers_;
 
   std::vector<std::unique_ptr<CurlRequestQueue>> request_queues_;
+  // Set (instead of request_queues_) when work stealing is enabled. Declared
+  // before the workers so that the workers are destroyed first.
+  std::unique_ptr<CurlRequestScheduler> request_scheduler_;
   std::vector<std::unique_ptr<CurlRequestWorker>> curl_request_workers_;
 };
 
@@ -0,0 +1,195 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+// Benchmarks bursts of fetches through MultiCurlHttpFetcherAsync against a
+// local HTTP stand-in server, with and without work stealing across the curl
+// workers.
+//
+// Run the benchmark as follows:
+// builders/tools/bazel-debian run --dynamic_mode=off -c opt --copt=-gmlt \
+//   --copt=-fno-omit-frame-pointer --fission=yes --strip=never \
+//   services/common/clients/http:multi_curl_http_fetcher_async_benchmarks -- \
+//   --benchmark_time_unit=ms --benchmark_repetitions=10
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/mutex.h"
+#include "benchmark/benchmark.h"
+#include "grpc/event_engine/event_engine.h"
+#include "services/common/clients/http/multi_curl_http_fetcher_async.h"
+#include "services/common/test/utils/test_init.h"
+#include "src/concurrent/event_engine_executor.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+constexpr int kNumCurlWorkers = 4;
+constexpr int kTimeoutMs = 5000;
+constexpr absl::string_view kResponse =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: application/json\r\n"
+    "Content-Length: 17\r\n"
+    "\r\n"
+    "{\"keys\": \"vals\"}\n";
+
+// Minimal keep-alive HTTP/1.1 server on the loopback interface that answers
+// every (body-less) request with the same small response, so that the
+// benchmark measures the client side and not a real KV server.
+class LocalHttpServer {
+ public:
+  LocalHttpServer() {
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    CHECK_GE(listen_fd_, 0);
+    int enable = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    CHECK_EQ(bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)),
+             0);
+    CHECK_EQ(listen(listen_fd_, SOMAXCONN), 0);
+    socklen_t addr_len = sizeof(addr);
+    CHECK_EQ(getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr),
+                         &addr_len),
+             0);
+    url_ = absl::StrCat("http://127.0.0.1:", ntohs(addr.sin_port), "/");
+    accept_thread_ = std::thread([this]() { AcceptConnections(); });
+  }
+
+  ~LocalHttpServer() {
+    shutdown(listen_fd_, SHUT_RDWR);
+    close(listen_fd_);
+    accept_thread_.join();
+    {
+      absl::MutexLock lock(&mu_);
+      for (int fd : connection_fds_) {
+        shutdown(fd, SHUT_RDWR);
+      }
+    }
+    for (auto& thread : connection_threads_) {
+      thread.join();
+    }
+  }
+
+  const std::string& url() const { return url_; }
+
+ private:
+  void AcceptConnections() {
+    while (true) {
+      const int fd = accept(listen_fd_, nullptr, nullptr);
+      if (fd < 0) {
+        return;
+      }
+      absl::MutexLock lock(&mu_);
+      connection_fds_.push_back(fd);
+      connection_threads_.emplace_back([fd]() { ServeConnection(fd); });
+    }
+  }
+
+  static void ServeConnection(int fd) {
+    std::string buffer;
+    char chunk[4096];
+    while (true) {
+      const ssize_t num_read = read(fd, chunk, sizeof(chunk));
+      if (num_read <= 0) {
+        break;
+      }
+      buffer.append(chunk, num_read);
+      // Answer every complete request in the buffer.
+      size_t end;
+      while ((end = buffer.find("\r\n\r\n")) != std::string::npos) {
+        buffer.erase(0, end + 4);
+        if (write(fd, kResponse.data(), kResponse.size()) < 0) {
+          close(fd);
+          return;
+        }
+      }
+    }
+    close(fd);
+  }
+
+  int listen_fd_;
+  std::string url_;
+  std::thread accept_thread_;
+  absl::Mutex mu_;
+  std::vector<int> connection_fds_ ABSL_GUARDED_BY(mu_);
+  std::vector<std::thread> connection_threads_;
+};
+
+// Issues a burst of `state.range(0)` concurrent fetches per iteration.
+template <bool kEnableWorkStealing>
+static void BM_FetchUrlBurst(benchmark::State& state) {
+  CommonTestInit();
+  server_common::GrpcInit grpc_init;
+  LocalHttpServer server;
+  auto executor = std::make_unique<server_common::EventEngineExecutor>(
+      grpc_event_engine::experimental::CreateEventEngine());
+  const int burst_size = state.range(0);
+  MultiCurlHttpFetcherAsync fetcher(
+      executor.get(), MultiCurlHttpFetcherAsyncOptions{
+                          .num_curl_workers = kNumCurlWorkers,
+                          .curl_queue_length = burst_size,
+                          .enable_work_stealing = kEnableWorkStealing,
+                      });
+  const HTTPRequest request = {.url = server.url()};
+  int num_failures = 0;
+  for (auto _ : state) {
+    absl::BlockingCounter done(burst_size);
+    absl::Mutex failures_mu;
+    for (int i = 0; i < burst_size; ++i) {
+      fetcher.FetchUrl(request, kTimeoutMs,
+                       [&done, &failures_mu,
+                        &num_failures](absl::StatusOr<std::string> response) {
+                         if (!response.ok()) {
+                           absl::MutexLock lock(&failures_mu);
+                           ++num_failures;
+                         }
+                         done.DecrementCount();
+                       });
+    }
+    done.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * burst_size);
+  state.counters["failures"] = num_failures;
+}
+
+BENCHMARK_TEMPLATE(BM_FetchUrlBurst, /*kEnableWorkStealing=*/false)
+    ->Arg(16)
+    ->Arg(128)
+    ->Arg(1024)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_FetchUrlBurst, /*kEnableWorkStealing=*/true)
+    ->Arg(16)
+    ->Arg(128)
+    ->Arg(1024)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+BENCHMARK_MAIN();
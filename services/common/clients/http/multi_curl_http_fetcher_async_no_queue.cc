@@ -26,6 +26,7 @@
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "event2/thread.h"
+#include "services/common/clients/http/curl_connection_metrics.h"
 #include "services/common/constants/common_service_flags.h"
 #include "services/common/loggers/request_log_context.h"
 #include "services/common/util/file_util.h"
@@ -118,6 +119,7 @@ MultiCurlHttpFetcherAsyncNoQueue::MultiCurlHttpFetcherAsyncNoQueue(
       skip_tls_verification_(
           absl::GetFlag(FLAGS_https_fetch_skips_tls_verification)
               .value_or(false)),
+      enable_http2_multiplexing_(options.enable_http2_multiplexing),
       // Shutdown timer event is persistent because we don't want to remove
       // it from the event loop the first time it fires. With this timer, we
       // periodically check for fetcher shutdown and terminate the event loop
@@ -130,7 +132,9 @@ MultiCurlHttpFetcherAsyncNoQueue::MultiCurlHttpFetcherAsyncNoQueue(
       multi_curl_request_manager_(event_base_.get(),
                                   options.curlmopt_maxconnects,
                                   options.curlmopt_max_total_connections,
-                                  options.curlmopt_max_host_connections),
+                                  options.curlmopt_max_host_connections,
+                                  options.enable_http2_multiplexing,
+                                  options.curlmopt_max_concurrent_streams),
       multi_timer_event_(Event(
           event_base_.get(), /*fd=*/-1, /*event_type=*/0,
           /*event_callback=*/multi_curl_request_manager_.MultiTimerCallback,
@@ -372,6 +376,13 @@ MultiCurlHttpFetcherAsyncNoQueue::CreateCurlRequest(
   // Set CURLOPT_ACCEPT_ENCODING to an empty string to pass all supported
   // encodings. See https://curl.se/libcurl/c/CURLOPT_ACCEPT_ENCODING.html.
   curl_easy_setopt(req_handle, CURLOPT_ACCEPT_ENCODING, "");
+  if (enable_http2_multiplexing_) {
+    curl_easy_setopt(req_handle, CURLOPT_HTTP_VERSION,
+                     CURL_HTTP_VERSION_2TLS);
+    // Wait for an open connection to the host to be confirmed as multiplexable
+    // rather than opening a new one.
+    curl_easy_setopt(req_handle, CURLOPT_PIPEWAIT, 1L);
+  }
 
   if (skip_tls_verification_) {
     curl_easy_setopt(req_handle, CURLOPT_SSL_VERIFYPEER, 0L);
@@ -524,6 +535,7 @@ void MultiCurlHttpFetcherAsyncNoQueue::PerformCurlUpdate()
         std::move(curl_request_data_ptr->done_callback)(status);
       }
       GetTraceFromCurl(req_handle);
+      RecordCurlTransfer(req_handle);
       // perform cleanup for handle.
     });
   }
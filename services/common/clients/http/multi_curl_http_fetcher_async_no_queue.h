@@ -223,6 +223,9 @@ class MultiCurlHttpFetcherAsyncNoQueue final : public HttpFetcherAsync {
 
   bool skip_tls_verification_;
 
+  // Whether transfers are multiplexed over HTTP/2 connections.
+  const bool enable_http2_multiplexing_;
+
   // All events in the loop are associated with this event base. Note: There can
   // be a single event base for a single thread.
   // Documentation: https://libevent.org/libevent-book/Ref2_eventbase.html
@@ -25,6 +25,7 @@
 
 #include "absl/log/check.h"
 #include "absl/strings/str_cat.h"
+#include "services/common/clients/http/curl_connection_metrics.h"
 #include "services/common/loggers/request_log_context.h"
 #include "src/logger/request_context_logger.h"
 
@@ -228,7 +229,8 @@ int MultiCurlRequestManager::OnLibcurlSocketUpdate(CURL* easy_handle,
 
 MultiCurlRequestManager::MultiCurlRequestManager(
     const long curlmopt_maxconnects, const long curlmopt_max_total_connections,
-    const long curlmopt_max_host_connections, server_common::Executor& executor)
+    const long curlmopt_max_host_connections, server_common::Executor& executor,
+    bool enable_http2_multiplexing, const long curlmopt_max_concurrent_streams)
     : running_handles_(0),
       eventloop_started_event_(Event(event_base_.get(), /* fd= */ -1,
                                      /* event_type= */ EV_TIMEOUT,
@@ -272,6 +274,15 @@ MultiCurlRequestManager::MultiCurlRequestManager(
   // to a single host.
   curl_multi_setopt(request_manager_, CURLMOPT_MAX_HOST_CONNECTIONS,
                     curlmopt_max_host_connections);
+  if (enable_http2_multiplexing) {
+    curl_multi_setopt(request_manager_, CURLMOPT_PIPELINING,
+                      CURLPIPE_MULTIPLEX);
+    if (curlmopt_max_concurrent_streams > 0) {
+      // The maximum number of concurrent streams per HTTP/2 connection.
+      curl_multi_setopt(request_manager_, CURLMOPT_MAX_CONCURRENT_STREAMS,
+                        curlmopt_max_concurrent_streams);
+    }
+  }
 
   // Start execution loop.
   executor_.Run([this]() {
@@ -447,6 +458,7 @@ void MultiCurlRequestManager::PerformCurlUpdate() {
         std::move(curl_request_data->done_callback)(status);
       }
       GetTraceFromCurl(req_handle);
+      RecordCurlTransfer(req_handle);
     });
   }
 }
@@ -38,11 +38,15 @@ namespace privacy_sandbox::bidding_auction_servers {
 // More info: https://curl.se/libcurl/c/threadsafe.html
 class MultiCurlRequestManager final {
  public:
-  // Initializes the Curl Multi session.
-  explicit MultiCurlRequestManager(const long curlmopt_maxconnects,
-                                   const long curlmopt_max_total_connections,
-                                   const long curlmopt_max_host_connections,
-                                   server_common::Executor& executor);
+  // Initializes the Curl Multi session. If `enable_http2_multiplexing` is
+  // set, transfers to the same host are multiplexed over its HTTP/2
+  // connections, up to `curlmopt_max_concurrent_streams` each.
+  explicit MultiCurlRequestManager(
+      const long curlmopt_maxconnects,
+      const long curlmopt_max_total_connections,
+      const long curlmopt_max_host_connections,
+      server_common::Executor& executor, bool enable_http2_multiplexing = false,
+      const long curlmopt_max_concurrent_streams = 0);
 
   // Cleans up the curl mutli session. Please make sure all easy handles
   // related to this multi session are manually cleaned up before this runs.
@@ -121,7 +121,8 @@ int OnLibcurlTimerUpdate(CURLM* multi, long timeout_ms, void* timer_event_arg) {
 MultiCurlRequestManagerLocking::MultiCurlRequestManagerLocking(
     struct event_base* event_base, const long curlmopt_maxconnects,
     const long curlmopt_max_total_connections,
-    const long curlmopt_max_host_connections)
+    const long curlmopt_max_host_connections, bool enable_http2_multiplexing,
+    const long curlmopt_max_concurrent_streams)
     : event_base_(event_base) {
   running_handles_ = 0;
   curl_global_init(CURL_GLOBAL_ALL);
@@ -141,6 +142,15 @@ MultiCurlRequestManagerLocking::MultiCurlRequestManagerLocking(
   // to a single host.
   curl_multi_setopt(request_manager_, CURLMOPT_MAX_HOST_CONNECTIONS,
                     curlmopt_max_host_connections);
+  if (enable_http2_multiplexing) {
+    curl_multi_setopt(request_manager_, CURLMOPT_PIPELINING,
+                      CURLPIPE_MULTIPLEX);
+    if (curlmopt_max_concurrent_streams > 0) {
+      // The maximum number of concurrent streams per HTTP/2 connection.
+      curl_multi_setopt(request_manager_, CURLMOPT_MAX_CONCURRENT_STREAMS,
+                        curlmopt_max_concurrent_streams);
+    }
+  }
 }
 
 MultiCurlRequestManagerLocking::~MultiCurlRequestManagerLocking() {
@@ -31,11 +31,15 @@ namespace privacy_sandbox::bidding_auction_servers {
 // More info: https://curl.se/libcurl/c/threadsafe.html
 class MultiCurlRequestManagerLocking final {
  public:
-  // Initializes the Curl Multi session.
+  // Initializes the Curl Multi session. If `enable_http2_multiplexing` is
+  // set, transfers to the same host are multiplexed over its HTTP/2
+  // connections, up to `curlmopt_max_concurrent_streams` each.
   explicit MultiCurlRequestManagerLocking(
       struct event_base* event_base, const long curlmopt_maxconnects,
       const long curlmopt_max_total_connections,
-      const long curlmopt_max_host_connections);
+      const long curlmopt_max_host_connections,
+      bool enable_http2_multiplexing = false,
+      const long curlmopt_max_concurrent_streams = 0);
 
   // Configures the request manager with the callback to invoke upon updates
   // to easy handle as well as the timer event to use to trigger transfer on
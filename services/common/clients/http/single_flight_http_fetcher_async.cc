@@ -0,0 +1,197 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/common/clients/http/single_flight_http_fetcher_async.h"
+
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "services/common/metric/server_definition.h"
+#include "services/common/util/cache_key_util.h"
+#include "src/util/status_macro/status_macros.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+std::string MakeKey(const HTTPRequest& request, int timeout_ms) {
+  std::string key;
+  AppendCacheKeyField(request.url, key);
+  AppendCacheKeyField(request.body, key);
+  AppendCacheKeyField(absl::StrCat(request.headers.size()), key);
+  for (absl::string_view header : request.headers) {
+    AppendCacheKeyField(header, key);
+  }
+  AppendCacheKeyField(absl::StrCat(request.include_headers.size()), key);
+  for (absl::string_view header : request.include_headers) {
+    AppendCacheKeyField(header, key);
+  }
+  absl::StrAppend(&key, request.redirect_config.strict_http,
+                  request.redirect_config.get_redirect_url, ":", timeout_ms);
+  return key;
+}
+
+// Tracks the responses of a FetchUrlsWithMetadata call until all of them are
+// received.
+struct FetchUrlsLifetime {
+  OnDoneFetchUrlsWithMetadata all_done_callback;
+  absl::Mutex results_mu;
+  std::vector<absl::StatusOr<HTTPResponse>> results
+      ABSL_GUARDED_BY(results_mu);
+  size_t pending_results ABSL_GUARDED_BY(results_mu);
+};
+
+}  // namespace
+
+SingleFlightHttpFetcherAsync::SingleFlightHttpFetcherAsync(
+    std::unique_ptr<HttpFetcherAsync> http_fetcher_async)
+    : http_fetcher_async_(std::move(http_fetcher_async)) {}
+
+void SingleFlightHttpFetcherAsync::FetchUrl(const HTTPRequest& http_request,
+                                            int timeout_ms,
+                                            OnDoneFetchUrl done_callback) {
+  FetchUrlWithMetadata(
+      http_request, timeout_ms,
+      [done_callback = std::move(done_callback)](
+          absl::StatusOr<HTTPResponse> response) mutable {
+        if (response.ok()) {
+          std::move(done_callback)(std::move(response)->body);
+        } else {
+          std::move(done_callback)(std::move(response).status());
+        }
+      });
+}
+
+void SingleFlightHttpFetcherAsync::FetchUrlWithMetadata(
+    const HTTPRequest& http_request, int timeout_ms,
+    OnDoneFetchUrlWithMetadata done_callback) {
+  std::string key = MakeKey(http_request, timeout_ms);
+  {
+    absl::MutexLock lock(&mu_);
+    auto [it, inserted] = in_flight_.try_emplace(key);
+    it->second.push_back(std::move(done_callback));
+    if (!inserted) {
+      SingleFlightHttpFetcherMetrics::RecordRequest(/*coalesced=*/true);
+      return;
+    }
+  }
+  SingleFlightHttpFetcherMetrics::RecordRequest(/*coalesced=*/false);
+  http_fetcher_async_->FetchUrlWithMetadata(
+      http_request, timeout_ms,
+      [this, key = std::move(key)](absl::StatusOr<HTTPResponse> response) {
+        OnFetchDone(key, std::move(response));
+      });
+}
+
+void SingleFlightHttpFetcherAsync::PutUrl(const HTTPRequest& http_request,
+                                          int timeout_ms,
+                                          OnDoneFetchUrl done_callback) {
+  http_fetcher_async_->PutUrl(http_request, timeout_ms,
+                              std::move(done_callback));
+}
+
+void SingleFlightHttpFetcherAsync::FetchUrls(
+    const std::vector<HTTPRequest>& requests, absl::Duration timeout,
+    OnDoneFetchUrls done_callback) {
+  FetchUrlsWithMetadata(
+      requests, timeout,
+      [done_callback = std::move(done_callback)](
+          std::vector<absl::StatusOr<HTTPResponse>> response_vector) mutable {
+        std::vector<absl::StatusOr<std::string>> results;
+        results.reserve(response_vector.size());
+        for (auto& response : response_vector) {
+          if (response.ok()) {
+            results.emplace_back(std::move(response)->body);
+          } else {
+            results.emplace_back(std::move(response).status());
+          }
+        }
+        std::move(done_callback)(std::move(results));
+      });
+}
+
+void SingleFlightHttpFetcherAsync::FetchUrlsWithMetadata(
+    const std::vector<HTTPRequest>& requests, absl::Duration timeout,
+    OnDoneFetchUrlsWithMetadata done_callback) {
+  if (requests.empty()) {
+    std::move(done_callback)({});
+    return;
+  }
+  auto lifetime = std::make_shared<FetchUrlsLifetime>();
+  lifetime->all_done_callback = std::move(done_callback);
+  {
+    absl::MutexLock lock(&lifetime->results_mu);
+    lifetime->results.resize(requests.size());
+    lifetime->pending_results = requests.size();
+  }
+  for (size_t i = 0; i < requests.size(); ++i) {
+    FetchUrlWithMetadata(
+        requests[i], absl::ToInt64Milliseconds(timeout),
+        [i, lifetime](absl::StatusOr<HTTPResponse> response) {
+          std::vector<absl::StatusOr<HTTPResponse>> results;
+          {
+            absl::MutexLock lock(&lifetime->results_mu);
+            lifetime->results[i] = std::move(response);
+            if (--lifetime->pending_results > 0) {
+              return;
+            }
+            results = std::move(lifetime->results);
+          }
+          std::move(lifetime->all_done_callback)(std::move(results));
+        });
+  }
+}
+
+void SingleFlightHttpFetcherAsync::OnFetchDone(
+    const std::string& key, absl::StatusOr<HTTPResponse> response) {
+  std::vector<OnDoneFetchUrlWithMetadata> callbacks;
+  {
+    absl::MutexLock lock(&mu_);
+    auto it = in_flight_.find(key);
+    if (it == in_flight_.end()) {
+      return;
+    }
+    callbacks = std::move(it->second);
+    in_flight_.erase(it);
+  }
+  // Every caller but the last gets a copy of the response.
+  for (size_t i = 0; i + 1 < callbacks.size(); ++i) {
+    std::move(callbacks[i])(response);
+  }
+  std::move(callbacks.back())(std::move(response));
+}
+
+absl::Status SingleFlightHttpFetcherMetrics::RegisterBfeMetrics() {
+  auto* context_map = metric::BfeContextMap();
+  PS_RETURN_IF_ERROR(context_map->AddObserverable(
+      metric::kHttpSingleFlightCoalescedRequests,
+      SingleFlightHttpFetcherMetrics::GetCoalescedRequests));
+  PS_RETURN_IF_ERROR(context_map->AddObserverable(
+      metric::kHttpSingleFlightCoalesceRatio,
+      SingleFlightHttpFetcherMetrics::GetCoalesceRatio));
+  return absl::OkStatus();
+}
+
+absl::Status SingleFlightHttpFetcherMetrics::RegisterSfeMetrics() {
+  auto* context_map = metric::SfeContextMap();
+  PS_RETURN_IF_ERROR(context_map->AddObserverable(
+      metric::kHttpSingleFlightCoalescedRequests,
+      SingleFlightHttpFetcherMetrics::GetCoalescedRequests));
+  PS_RETURN_IF_ERROR(context_map->AddObserverable(
+      metric::kHttpSingleFlightCoalesceRatio,
+      SingleFlightHttpFetcherMetrics::GetCoalesceRatio));
+  return absl::OkStatus();
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
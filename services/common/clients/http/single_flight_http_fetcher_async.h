@@ -0,0 +1,145 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef SERVICES_COMMON_CLIENTS_HTTP_SINGLE_FLIGHT_HTTP_FETCHER_ASYNC_H_
+#define SERVICES_COMMON_CLIENTS_HTTP_SINGLE_FLIGHT_HTTP_FETCHER_ASYNC_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "services/common/clients/http/http_fetcher_async.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// SingleFlightHttpFetcherAsync sends identical GET requests that are in flight
+// at the same time as a single transfer of the wrapped fetcher, and hands the
+// response to every caller. GET requests are identical if they have the same
+// URL, headers, response headers to include, redirect config and timeout.
+// PUT requests are always forwarded as is.
+//
+// Callbacks are invoked on the thread the wrapped fetcher completes the
+// transfer on.
+class SingleFlightHttpFetcherAsync final : public HttpFetcherAsync {
+ public:
+  explicit SingleFlightHttpFetcherAsync(
+      std::unique_ptr<HttpFetcherAsync> http_fetcher_async);
+
+  // Not copyable or movable.
+  SingleFlightHttpFetcherAsync(const SingleFlightHttpFetcherAsync&) = delete;
+  SingleFlightHttpFetcherAsync& operator=(const SingleFlightHttpFetcherAsync&) =
+      delete;
+
+  void FetchUrl(const HTTPRequest& http_request, int timeout_ms,
+                OnDoneFetchUrl done_callback) override;
+
+  void FetchUrlWithMetadata(const HTTPRequest& http_request, int timeout_ms,
+                            OnDoneFetchUrlWithMetadata done_callback) override;
+
+  void PutUrl(const HTTPRequest& http_request, int timeout_ms,
+              OnDoneFetchUrl done_callback) override;
+
+  // Each of the requests is coalesced separately.
+  void FetchUrls(const std::vector<HTTPRequest>& requests,
+                 absl::Duration timeout,
+                 OnDoneFetchUrls done_callback) override;
+
+  // Each of the requests is coalesced separately.
+  void FetchUrlsWithMetadata(
+      const std::vector<HTTPRequest>& requests, absl::Duration timeout,
+      OnDoneFetchUrlsWithMetadata done_callback) override;
+
+ private:
+  // Hands the response of the transfer for `key` to its callers.
+  void OnFetchDone(const std::string& key,
+                   absl::StatusOr<HTTPResponse> response)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+  absl::Mutex mu_;
+  // Callbacks of the callers of each in-flight transfer.
+  absl::flat_hash_map<std::string, std::vector<OnDoneFetchUrlWithMetadata>>
+      in_flight_ ABSL_GUARDED_BY(mu_);
+  // Declared last so that the transfers it fails on destruction can still
+  // reach their callers.
+  std::unique_ptr<HttpFetcherAsync> http_fetcher_async_;
+};
+
+// Records the metrics of the single-flight fetchers of the server. These
+// metrics are observed periodically rather than logged per request.
+class SingleFlightHttpFetcherMetrics {
+ public:
+  // Registers the metrics with the BFE metric context map.
+  static absl::Status RegisterBfeMetrics();
+
+  // Registers the metrics with the SFE metric context map.
+  static absl::Status RegisterSfeMetrics();
+
+  // Returns the number of GET requests that were attached to an in-flight
+  // transfer since the previous call.
+  static absl::flat_hash_map<std::string, double> GetCoalescedRequests()
+      ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    const double coalesced = static_cast<double>(coalesced_);
+    coalesced_ = 0;
+    return {{"single_flight", coalesced}};
+  }
+
+  // Returns the ratio of GET requests that were attached to an in-flight
+  // transfer since the previous call, or nothing if there were no requests.
+  static absl::flat_hash_map<std::string, double> GetCoalesceRatio()
+      ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    if (ratio_requests_ == 0) {
+      return {};
+    }
+    const double coalesce_ratio =
+        static_cast<double>(ratio_coalesced_) / ratio_requests_;
+    ratio_coalesced_ = 0;
+    ratio_requests_ = 0;
+    return {{"single_flight", coalesce_ratio}};
+  }
+
+  static void RecordRequest(bool coalesced) ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    ++ratio_requests_;
+    if (coalesced) {
+      ++coalesced_;
+      ++ratio_coalesced_;
+    }
+  }
+
+  // Clears all metric counters.
+  static void ClearStates_TestOnly() ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    coalesced_ = 0;
+    ratio_coalesced_ = 0;
+    ratio_requests_ = 0;
+  }
+
+ private:
+  ABSL_CONST_INIT static inline absl::Mutex mu_{absl::kConstInit};
+  static inline int64_t coalesced_ ABSL_GUARDED_BY(mu_) = 0;
+  static inline int64_t ratio_coalesced_ ABSL_GUARDED_BY(mu_) = 0;
+  static inline int64_t ratio_requests_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_COMMON_CLIENTS_HTTP_SINGLE_FLIGHT_HTTP_FETCHER_ASYNC_H_
@@ -0,0 +1,200 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/common/clients/http/single_flight_http_fetcher_async.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "gtest/gtest.h"
+#include "services/common/test/mocks.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+using ::testing::_;
+
+constexpr int kTimeoutMs = 100;
+
+class SingleFlightHttpFetcherAsyncTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    SingleFlightHttpFetcherMetrics::ClearStates_TestOnly();
+    auto mock_fetcher = std::make_unique<MockHttpFetcherAsync>();
+    mock_fetcher_ = mock_fetcher.get();
+    fetcher_ =
+        std::make_unique<SingleFlightHttpFetcherAsync>(std::move(mock_fetcher));
+  }
+
+  // Expects `num_transfers` transfers to reach the wrapped fetcher, and keeps
+  // their callbacks pending.
+  void ExpectTransfers(int num_transfers) {
+    EXPECT_CALL(*mock_fetcher_, FetchUrlWithMetadata(_, _, _))
+        .Times(num_transfers)
+        .WillRepeatedly([this](const HTTPRequest& request, int timeout_ms,
+                               OnDoneFetchUrlWithMetadata done_callback) {
+          pending_transfers_.push_back(std::move(done_callback));
+        });
+  }
+
+  MockHttpFetcherAsync* mock_fetcher_;
+  std::unique_ptr<SingleFlightHttpFetcherAsync> fetcher_;
+  std::vector<OnDoneFetchUrlWithMetadata> pending_transfers_;
+};
+
+TEST_F(SingleFlightHttpFetcherAsyncTest, CoalescesIdenticalRequests) {
+  ExpectTransfers(1);
+  const HTTPRequest request = {.url = "https://kv.com/keys=a",
+                               .headers = {"X-Header: 1"},
+                               .include_headers = {"Data-Version"}};
+
+  absl::StatusOr<std::string> first;
+  absl::StatusOr<HTTPResponse> second;
+  fetcher_->FetchUrl(request, kTimeoutMs,
+                     [&first](absl::StatusOr<std::string> response) {
+                       first = std::move(response);
+                     });
+  fetcher_->FetchUrlWithMetadata(
+      request, kTimeoutMs, [&second](absl::StatusOr<HTTPResponse> response) {
+        second = std::move(response);
+      });
+
+  ASSERT_EQ(pending_transfers_.size(), 1);
+  std::move(pending_transfers_[0])(
+      HTTPResponse{.body = "body", .headers = {{"Data-Version", "3"}}});
+  ASSERT_TRUE(first.ok()) << first.status();
+  EXPECT_EQ(*first, "body");
+  ASSERT_TRUE(second.ok()) << second.status();
+  EXPECT_EQ(second->body, "body");
+  EXPECT_EQ(second->headers.at("Data-Version").value(), "3");
+
+  EXPECT_EQ(
+      SingleFlightHttpFetcherMetrics::GetCoalescedRequests().at(
+          "single_flight"),
+      1);
+  EXPECT_EQ(
+      SingleFlightHttpFetcherMetrics::GetCoalesceRatio().at("single_flight"),
+      0.5);
+}
+
+TEST_F(SingleFlightHttpFetcherAsyncTest, FansOutErrors) {
+  ExpectTransfers(1);
+  const HTTPRequest request = {.url = "https://kv.com/keys=a"};
+
+  std::vector<absl::Status> statuses;
+  for (int i = 0; i < 3; ++i) {
+    fetcher_->FetchUrl(request, kTimeoutMs,
+                       [&statuses](absl::StatusOr<std::string> response) {
+                         statuses.push_back(response.status());
+                       });
+  }
+  ASSERT_EQ(pending_transfers_.size(), 1);
+  std::move(pending_transfers_[0])(absl::DeadlineExceededError("timeout"));
+
+  ASSERT_EQ(statuses.size(), 3);
+  for (const absl::Status& status : statuses) {
+    EXPECT_EQ(status.code(), absl::StatusCode::kDeadlineExceeded);
+  }
+}
+
+TEST_F(SingleFlightHttpFetcherAsyncTest, DoesNotCoalesceDifferentRequests) {
+  ExpectTransfers(5);
+  const HTTPRequest request = {.url = "https://kv.com/keys=a",
+                               .headers = {"X-Header: 1"}};
+  auto ignore_response = [](absl::StatusOr<std::string> response) {};
+
+  fetcher_->FetchUrl(request, kTimeoutMs, ignore_response);
+  fetcher_->FetchUrl({.url = "https://kv.com/keys=b",
+                      .headers = {"X-Header: 1"}},
+                     kTimeoutMs, ignore_response);
+  fetcher_->FetchUrl({.url = "https://kv.com/keys=a",
+                      .headers = {"X-Header: 2"}},
+                     kTimeoutMs, ignore_response);
+  fetcher_->FetchUrl({.url = "https://kv.com/keys=a",
+                      .headers = {"X-Header: 1"},
+                      .include_headers = {"Data-Version"}},
+                     kTimeoutMs, ignore_response);
+  fetcher_->FetchUrl(request, kTimeoutMs + 1, ignore_response);
+  EXPECT_EQ(pending_transfers_.size(), 5);
+}
+
+TEST_F(SingleFlightHttpFetcherAsyncTest, StartsNewTransferOnceDone) {
+  ExpectTransfers(2);
+  const HTTPRequest request = {.url = "https://kv.com/keys=a"};
+  auto ignore_response = [](absl::StatusOr<std::string> response) {};
+
+  fetcher_->FetchUrl(request, kTimeoutMs, ignore_response);
+  std::move(pending_transfers_[0])(HTTPResponse{.body = "body"});
+  fetcher_->FetchUrl(request, kTimeoutMs, ignore_response);
+  EXPECT_EQ(pending_transfers_.size(), 2);
+}
+
+TEST_F(SingleFlightHttpFetcherAsyncTest, DoesNotCoalescePuts) {
+  EXPECT_CALL(*mock_fetcher_, PutUrl(_, _, _))
+      .Times(2)
+      .WillRepeatedly([](const HTTPRequest& request, int timeout_ms,
+                         OnDoneFetchUrl done_callback) {
+        std::move(done_callback)("done");
+      });
+  const HTTPRequest request = {.url = "https://kv.com", .body = "data"};
+
+  int num_done = 0;
+  for (int i = 0; i < 2; ++i) {
+    fetcher_->PutUrl(request, kTimeoutMs,
+                     [&num_done](absl::StatusOr<std::string> response) {
+                       EXPECT_TRUE(response.ok());
+                       ++num_done;
+                     });
+  }
+  EXPECT_EQ(num_done, 2);
+}
+
+TEST_F(SingleFlightHttpFetcherAsyncTest, FetchUrlsCoalescesEachRequest) {
+  ExpectTransfers(2);
+  const HTTPRequest request_a = {.url = "https://kv.com/keys=a"};
+  const HTTPRequest request_b = {.url = "https://kv.com/keys=b"};
+
+  std::vector<absl::StatusOr<std::string>> results;
+  fetcher_->FetchUrls(
+      {request_a, request_b, request_a}, absl::Milliseconds(kTimeoutMs),
+      [&results](std::vector<absl::StatusOr<std::string>> responses) {
+        results = std::move(responses);
+      });
+  ASSERT_EQ(pending_transfers_.size(), 2);
+  std::move(pending_transfers_[1])(HTTPResponse{.body = "b"});
+  EXPECT_TRUE(results.empty());
+  std::move(pending_transfers_[0])(HTTPResponse{.body = "a"});
+
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_EQ(*results[0], "a");
+  EXPECT_EQ(*results[1], "b");
+  EXPECT_EQ(*results[2], "a");
+}
+
+TEST_F(SingleFlightHttpFetcherAsyncTest, FetchUrlsWithoutRequestsIsDone) {
+  bool done = false;
+  fetcher_->FetchUrlsWithMetadata(
+      {}, absl::Milliseconds(kTimeoutMs),
+      [&done](std::vector<absl::StatusOr<HTTPResponse>> responses) {
+        EXPECT_TRUE(responses.empty());
+        done = true;
+      });
+  EXPECT_TRUE(done);
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
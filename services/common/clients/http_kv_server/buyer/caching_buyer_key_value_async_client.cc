@@ -0,0 +1,278 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "services/common/clients/http_kv_server/buyer/caching_buyer_key_value_async_client.h"
+
+#include <optional>
+#include <utility>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+#include "services/common/metric/server_definition.h"
+#include "services/common/util/cache_key_util.h"
+#include "services/common/util/json_util.h"
+#include "src/util/status_macro/status_macros.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+using OnBuyerValuesDone = absl::AnyInvocable<
+    void(absl::StatusOr<std::unique_ptr<GetBuyerValuesOutput>>) &&>;
+
+constexpr absl::string_view kKeysNamespace = "keys";
+
+// Upper bound on the number of hostname, client type and experiment group
+// combinations tracked as passing through.
+constexpr int kMaxPassThroughScopes = 4096;
+
+// Returns the part of the cache key shared by all the keys of a lookup.
+std::string MakeScope(const GetBuyerValuesInput& input) {
+  std::string scope;
+  AppendCacheKeyField(input.hostname, scope);
+  AppendCacheKeyField(absl::StrCat(static_cast<int>(input.client_type)), scope);
+  AppendCacheKeyField(input.buyer_kv_experiment_group_id, scope);
+  return scope;
+}
+
+std::string MakeCacheKey(absl::string_view scope, absl::string_view key) {
+  std::string cache_key(scope);
+  AppendCacheKeyField(key, cache_key);
+  return cache_key;
+}
+
+// Returns the serialized values of the "keys" namespace of `output`, or
+// nothing if the response can't be split into values per key.
+std::optional<absl::flat_hash_map<std::string, std::string>> GetValuesByKey(
+    const GetBuyerValuesOutput& output) {
+  if (output.data_version != 0 || output.is_hybrid_v1_return) {
+    return std::nullopt;
+  }
+  absl::StatusOr<rapidjson::Document> document =
+      ParseJsonString(output.result);
+  if (!document.ok() || !document->IsObject()) {
+    return std::nullopt;
+  }
+  absl::flat_hash_map<std::string, std::string> values;
+  for (const auto& kv_namespace : document->GetObject()) {
+    if (absl::string_view(kv_namespace.name.GetString(),
+                          kv_namespace.name.GetStringLength()) !=
+            kKeysNamespace ||
+        !kv_namespace.value.IsObject()) {
+      return std::nullopt;
+    }
+    for (const auto& key_value : kv_namespace.value.GetObject()) {
+      absl::StatusOr<std::string> value = SerializeJsonDoc(key_value.value);
+      if (!value.ok()) {
+        return std::nullopt;
+      }
+      values.insert_or_assign(
+          std::string(key_value.name.GetString(),
+                      key_value.name.GetStringLength()),
+          *std::move(value));
+    }
+  }
+  return values;
+}
+
+// Returns a response holding the values of `keys` found in `cached_values` or
+// `fetched_values`.
+std::string BuildResult(
+    const UrlKeysSet& keys,
+    const absl::flat_hash_map<absl::string_view,
+                              std::shared_ptr<const std::string>>&
+        cached_values,
+    const absl::flat_hash_map<std::string, std::string>& fetched_values) {
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  writer.Key(kKeysNamespace.data(), kKeysNamespace.size());
+  writer.StartObject();
+  for (absl::string_view key : keys) {
+    const std::string* value = nullptr;
+    if (auto it = cached_values.find(key); it != cached_values.end()) {
+      value = it->second.get();
+    } else if (auto it = fetched_values.find(key);
+               it != fetched_values.end()) {
+      value = &it->second;
+    }
+    if (value == nullptr) {
+      continue;
+    }
+    writer.Key(key.data(), key.size());
+    writer.RawValue(value->data(), value->size(), rapidjson::kObjectType);
+  }
+  writer.EndObject();
+  writer.EndObject();
+  return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+}  // namespace
+
+CachingBuyerKeyValueAsyncClient::CachingBuyerKeyValueAsyncClient(
+    std::unique_ptr<AsyncClient<GetBuyerValuesInput, GetBuyerValuesOutput>>
+        client,
+    BuyerKeyValueCacheOptions options)
+    : client_(std::move(client)),
+      options_(std::move(options)),
+      cache_(options_.max_entries, options_.ttl, options_.num_shards),
+      pass_through_scopes_(kMaxPassThroughScopes, options_.pass_through_ttl) {}
+
+absl::Status CachingBuyerKeyValueAsyncClient::Execute(
+    std::unique_ptr<GetBuyerValuesInput> keys, const RequestMetadata& metadata,
+    OnBuyerValuesDone on_done, absl::Duration timeout,
+    RequestContext context) const {
+  if (keys->keys.empty()) {
+    return client_->Execute(std::move(keys), metadata, std::move(on_done),
+                            timeout, context);
+  }
+
+  std::string scope = MakeScope(*keys);
+  if (IsPassingThrough(scope)) {
+    BuyerKeyValueCacheMetrics::RecordPassThrough();
+    return client_->Execute(std::move(keys), metadata, std::move(on_done),
+                            timeout, context);
+  }
+  absl::flat_hash_map<absl::string_view, CachedValue> cached_values =
+      Lookup(scope, keys->keys);
+  BuyerKeyValueCacheMetrics::RecordLookup(
+      /*hits=*/cached_values.size(),
+      /*misses=*/keys->keys.size() - cached_values.size());
+  if (cached_values.size() == keys->keys.size()) {
+    auto output = std::make_unique<GetBuyerValuesOutput>(GetBuyerValuesOutput{
+        .result = BuildResult(keys->keys, cached_values, {}),
+        .request_size = 0,
+        .response_size = 0,
+        .data_version = 0});
+    std::move(on_done)(std::move(output));
+    return absl::OkStatus();
+  }
+
+  // Only looks up the keys missing from the cache. The interest group names
+  // are kept, so that any per interest group data is still returned.
+  auto missing_keys = std::make_unique<GetBuyerValuesInput>(*keys);
+  for (const auto& [key, unused] : cached_values) {
+    missing_keys->keys.erase(key);
+  }
+  UrlKeysSet fetched_keys = missing_keys->keys;
+  return client_->Execute(
+      std::move(missing_keys), metadata,
+      [this, keys = std::move(keys), metadata, timeout, context,
+       scope = std::move(scope), cached_values = std::move(cached_values),
+       fetched_keys = std::move(fetched_keys), on_done = std::move(on_done)](
+          absl::StatusOr<std::unique_ptr<GetBuyerValuesOutput>>
+              output) mutable {
+        if (!output.ok() || *output == nullptr) {
+          std::move(on_done)(std::move(output));
+          return;
+        }
+        std::optional<absl::flat_hash_map<std::string, std::string>>
+            fetched_values = GetValuesByKey(**output);
+        if (!fetched_values.has_value()) {
+          StartPassingThrough(scope);
+          BuyerKeyValueCacheMetrics::RecordPassThrough();
+          if (cached_values.empty()) {
+            std::move(on_done)(std::move(output));
+            return;
+          }
+          // The response only covers the missing keys, and its data may not
+          // apply to the cached values, so the whole lookup is sent again.
+          auto shared_on_done =
+              std::make_shared<OnBuyerValuesDone>(std::move(on_done));
+          absl::Status status = client_->Execute(
+              std::move(keys), metadata,
+              [shared_on_done](
+                  absl::StatusOr<std::unique_ptr<GetBuyerValuesOutput>>
+                      output) {
+                std::move(*shared_on_done)(std::move(output));
+              },
+              timeout, context);
+          if (!status.ok()) {
+            std::move(*shared_on_done)(std::move(status));
+          }
+          return;
+        }
+        if (!cached_values.empty()) {
+          (*output)->result =
+              BuildResult(keys->keys, cached_values, *fetched_values);
+        }
+        Insert(scope, fetched_keys, *std::move(fetched_values));
+        std::move(on_done)(std::move(output));
+      },
+      timeout, context);
+}
+
+absl::flat_hash_map<absl::string_view,
+                    CachingBuyerKeyValueAsyncClient::CachedValue>
+CachingBuyerKeyValueAsyncClient::Lookup(absl::string_view scope,
+                                        const UrlKeysSet& keys) const {
+  absl::flat_hash_map<std::string, absl::string_view> keys_by_cache_key;
+  absl::flat_hash_set<std::string> cache_keys;
+  keys_by_cache_key.reserve(keys.size());
+  cache_keys.reserve(keys.size());
+  for (absl::string_view key : keys) {
+    std::string cache_key = MakeCacheKey(scope, key);
+    keys_by_cache_key.emplace(cache_key, key);
+    cache_keys.insert(std::move(cache_key));
+  }
+  absl::flat_hash_map<absl::string_view, CachedValue> cached_values;
+  for (auto& [cache_key, value] : cache_.Query(cache_keys)) {
+    cached_values.emplace(keys_by_cache_key.at(cache_key), std::move(value));
+  }
+  return cached_values;
+}
+
+void CachingBuyerKeyValueAsyncClient::Insert(
+    absl::string_view scope, const UrlKeysSet& keys,
+    absl::flat_hash_map<std::string, std::string> values) const {
+  // The lookups of the scope may have started passing through meanwhile.
+  if (IsPassingThrough(std::string(scope))) {
+    return;
+  }
+  absl::flat_hash_map<std::string, CachedValue> entries;
+  entries.reserve(keys.size());
+  for (absl::string_view key : keys) {
+    CachedValue value;
+    if (auto it = values.find(key); it != values.end()) {
+      value = std::make_shared<const std::string>(std::move(it->second));
+    }
+    entries.emplace(MakeCacheKey(scope, key), std::move(value));
+  }
+  cache_.Insert(entries).IgnoreError();
+}
+
+bool CachingBuyerKeyValueAsyncClient::IsPassingThrough(
+    const std::string& scope) const {
+  return !pass_through_scopes_.Query({scope}).empty();
+}
+
+void CachingBuyerKeyValueAsyncClient::StartPassingThrough(
+    const std::string& scope) const {
+  pass_through_scopes_.Insert({{scope, true}}).IgnoreError();
+}
+
+absl::Status BuyerKeyValueCacheMetrics::RegisterBfeMetrics() {
+  auto* context_map = metric::BfeContextMap();
+  PS_RETURN_IF_ERROR(context_map->AddObserverable(
+      metric::kBfeKvCacheHitRatio, BuyerKeyValueCacheMetrics::GetHitRatio));
+  PS_RETURN_IF_ERROR(context_map->AddObserverable(
+      metric::kBfeKvCachePassThroughLookups,
+      BuyerKeyValueCacheMetrics::GetPassThroughLookups));
+  return absl::OkStatus();
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERVICES_COMMON_CLIENTS_CACHING_BUYER_KEY_VALUE_ASYNC_CLIENT_H_
+#define SERVICES_COMMON_CLIENTS_CACHING_BUYER_KEY_VALUE_ASYNC_CLIENT_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "services/common/cache/sharded_cache.h"
+#include "services/common/clients/async_client.h"
+#include "services/common/clients/http_kv_server/buyer/buyer_key_value_async_http_client.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+struct BuyerKeyValueCacheOptions {
+  // How long a KV response is served from the cache.
+  absl::Duration ttl = absl::Seconds(1);
+  // Upper bound on the number of keys whose values are cached.
+  int max_entries = 65536;
+  // Number of independently locked partitions of the cache.
+  int num_shards = kDefaultNumCacheShards;
+  // How long the lookups of a hostname, client type and experiment group pass
+  // through once the KV server returned a response for them that can't be
+  // split into values per key.
+  absl::Duration pass_through_ttl = absl::Minutes(1);
+};
+
+// Serves the Buyer KV lookups from a short-lived in-memory cache of the values
+// of each key, so that GetBids requests looking up overlapping trusted bidding
+// signals keys share the KV lookups of the common keys. Only the keys missing
+// from the cache are sent to the wrapped client, and the values of its
+// successful responses are cached.
+//
+// Values are cached per key, hostname, client type and experiment group. The
+// request metadata (e.g. the client IP) isn't part of the cache key, so the
+// cache must only front KV servers that don't vary the bidding signals on it.
+//
+// A response can only be split into values per key if it holds nothing but the
+// "keys" namespace. Once the KV server returns anything else for a hostname,
+// client type and experiment group, e.g. perInterestGroupData or a
+// Data-Version header, which apply to a lookup as a whole, the lookups of that
+// hostname, client type and experiment group are passed through to the
+// wrapped client unchanged for `pass_through_ttl`. The lookups of the others
+// are still served from the cache.
+//
+// The least recently used values are evicted first once a shard of the cache
+// holds more than its share of `max_entries`.
+class CachingBuyerKeyValueAsyncClient
+    : public AsyncClient<GetBuyerValuesInput, GetBuyerValuesOutput> {
+ public:
+  CachingBuyerKeyValueAsyncClient(
+      std::unique_ptr<AsyncClient<GetBuyerValuesInput, GetBuyerValuesOutput>>
+          client,
+      BuyerKeyValueCacheOptions options);
+
+  // CachingBuyerKeyValueAsyncClient is neither copyable nor movable.
+  CachingBuyerKeyValueAsyncClient(const CachingBuyerKeyValueAsyncClient&) =
+      delete;
+  CachingBuyerKeyValueAsyncClient& operator=(
+      const CachingBuyerKeyValueAsyncClient&) = delete;
+
+  // Invokes `on_done` inline if all the keys are cached. The sizes reported
+  // for such lookups are 0, since nothing is sent to the KV server.
+  absl::Status Execute(
+      std::unique_ptr<GetBuyerValuesInput> keys,
+      const RequestMetadata& metadata,
+      absl::AnyInvocable<
+          void(absl::StatusOr<std::unique_ptr<GetBuyerValuesOutput>>) &&>
+          on_done,
+      absl::Duration timeout,
+      RequestContext context = NoOpContext()) const override;
+
+ private:
+  // Value of a key, or nullptr if the KV server has no value for it.
+  using CachedValue = std::shared_ptr<const std::string>;
+
+  // Returns the unexpired values cached for `keys` in `scope`.
+  absl::flat_hash_map<absl::string_view, CachedValue> Lookup(
+      absl::string_view scope, const UrlKeysSet& keys) const;
+
+  // Caches the values of `keys` in `scope`, which are absent from `values` if
+  // the KV server has no value for them.
+  void Insert(absl::string_view scope, const UrlKeysSet& keys,
+              absl::flat_hash_map<std::string, std::string> values) const;
+
+  // Returns whether the lookups of `scope` are passed through.
+  bool IsPassingThrough(const std::string& scope) const;
+
+  // Passes the lookups of `scope` through for `pass_through_ttl`.
+  void StartPassingThrough(const std::string& scope) const;
+
+  std::unique_ptr<AsyncClient<GetBuyerValuesInput, GetBuyerValuesOutput>>
+      client_;
+  const BuyerKeyValueCacheOptions options_;
+  // The caches are internally synchronized, but Execute() is const in the
+  // AsyncClient interface.
+  mutable ShardedCache<std::string, CachedValue> cache_;
+  mutable ShardedCache<std::string, bool> pass_through_scopes_;
+};
+
+// Records the metrics of the Buyer KV caches of the server. These metrics are
+// observed periodically rather than logged per request.
+class BuyerKeyValueCacheMetrics {
+ public:
+  // Registers the metrics with the BFE metric context map.
+  static absl::Status RegisterBfeMetrics();
+
+  // Returns the ratio of keys served from the cache since the previous call,
+  // or nothing if no keys were looked up.
+  static absl::flat_hash_map<std::string, double> GetHitRatio()
+      ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    const int64_t lookups = hits_ + misses_;
+    if (lookups == 0) {
+      return {};
+    }
+    const double hit_ratio = static_cast<double>(hits_) / lookups;
+    hits_ = 0;
+    misses_ = 0;
+    return {{"kv_cache", hit_ratio}};
+  }
+
+  // Returns the number of lookups passed through to the KV server unchanged
+  // since the previous call.
+  static absl::flat_hash_map<std::string, double> GetPassThroughLookups()
+      ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    const double pass_through_lookups =
+        static_cast<double>(pass_through_lookups_);
+    pass_through_lookups_ = 0;
+    return {{"kv_cache", pass_through_lookups}};
+  }
+
+  static void RecordLookup(int64_t hits, int64_t misses)
+      ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    hits_ += hits;
+    misses_ += misses;
+  }
+
+  static void RecordPassThrough() ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    ++pass_through_lookups_;
+  }
+
+  // Clears all metric counters.
+  static void ClearStates_TestOnly() ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    hits_ = 0;
+    misses_ = 0;
+    pass_through_lookups_ = 0;
+  }
+
+ private:
+  ABSL_CONST_INIT static inline absl::Mutex mu_{absl::kConstInit};
+  static inline int64_t hits_ ABSL_GUARDED_BY(mu_) = 0;
+  static inline int64_t misses_ ABSL_GUARDED_BY(mu_) = 0;
+  static inline int64_t pass_through_lookups_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_COMMON_CLIENTS_CACHING_BUYER_KEY_VALUE_ASYNC_CLIENT_H_
@@ -0,0 +1,370 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "services/common/clients/http_kv_server/buyer/caching_buyer_key_value_async_client.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "services/common/test/mocks.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+using ::testing::_;
+using ::testing::ElementsAre;
+using BuyerKeyValueAsyncClientMock =
+    AsyncClientMock<GetBuyerValuesInput, GetBuyerValuesOutput>;
+using OnDone = absl::AnyInvocable<
+    void(absl::StatusOr<std::unique_ptr<GetBuyerValuesOutput>>) &&>;
+
+constexpr absl::string_view kHostname = "publisher.com";
+
+// Owns the strings the input sets point into.
+struct Lookup {
+  std::vector<std::string> keys;
+  std::vector<std::string> interest_group_names;
+
+  std::unique_ptr<GetBuyerValuesInput> ToInput() const {
+    auto input = std::make_unique<GetBuyerValuesInput>();
+    input->hostname = kHostname;
+    input->client_type = CLIENT_TYPE_BROWSER;
+    input->keys.insert(keys.begin(), keys.end());
+    input->interest_group_names.insert(interest_group_names.begin(),
+                                       interest_group_names.end());
+    return input;
+  }
+};
+
+class CachingBuyerKeyValueAsyncClientTest : public testing::Test {
+ protected:
+  void SetUp() override { BuyerKeyValueCacheMetrics::ClearStates_TestOnly(); }
+
+  std::unique_ptr<CachingBuyerKeyValueAsyncClient> CreateClient(
+      BuyerKeyValueCacheOptions options = {}) {
+    auto mock_client = std::make_unique<BuyerKeyValueAsyncClientMock>();
+    mock_client_ = mock_client.get();
+    return std::make_unique<CachingBuyerKeyValueAsyncClient>(
+        std::move(mock_client), options);
+  }
+
+  // Expects `num_lookups` lookups to reach the wrapped client, each of them
+  // succeeding with a value for each of the keys looked up. The keys of each
+  // lookup are appended to `upstream_keys` if set.
+  void ExpectUpstreamLookups(
+      int num_lookups,
+      std::vector<std::vector<std::string>>* upstream_keys = nullptr) {
+    EXPECT_CALL(*mock_client_, Execute(_, _, _, _, _))
+        .Times(num_lookups)
+        .WillRepeatedly([upstream_keys](
+                            std::unique_ptr<GetBuyerValuesInput> input,
+                            const RequestMetadata& metadata, OnDone on_done,
+                            absl::Duration timeout, RequestContext context) {
+          if (upstream_keys != nullptr) {
+            upstream_keys->emplace_back(input->keys.begin(),
+                                        input->keys.end());
+          }
+          std::move(on_done)(std::make_unique<GetBuyerValuesOutput>(
+              GetBuyerValuesOutput{.result = MakeResult(input->keys),
+                                   .request_size = 10,
+                                   .response_size = 20}));
+          return absl::OkStatus();
+        });
+  }
+
+  // Returns the KV response holding a value for each of `keys`.
+  static std::string MakeResult(const UrlKeysSet& keys) {
+    return absl::StrCat(
+        R"JSON({"keys":{)JSON",
+        absl::StrJoin(keys, ",",
+                      [](std::string* out, absl::string_view key) {
+                        absl::StrAppend(out, "\"", key, "\":\"value-", key,
+                                        "\"");
+                      }),
+        "}}");
+  }
+
+  // Runs a lookup and returns its output.
+  absl::StatusOr<std::unique_ptr<GetBuyerValuesOutput>> Execute(
+      const CachingBuyerKeyValueAsyncClient& client, const Lookup& lookup) {
+    absl::StatusOr<std::unique_ptr<GetBuyerValuesOutput>> result =
+        absl::UnknownError("Lookup not done");
+    absl::Status status = client.Execute(
+        lookup.ToInput(), {},
+        [&result](auto output) { result = std::move(output); },
+        absl::Seconds(1));
+    EXPECT_TRUE(status.ok()) << status;
+    return result;
+  }
+
+  BuyerKeyValueAsyncClientMock* mock_client_ = nullptr;
+};
+
+TEST_F(CachingBuyerKeyValueAsyncClientTest, ServesRepeatedLookupsFromCache) {
+  auto client = CreateClient();
+  ExpectUpstreamLookups(1);
+
+  const Lookup lookup = {.keys = {"key1", "key2"},
+                         .interest_group_names = {"ig"}};
+  auto first = Execute(*client, lookup);
+  ASSERT_TRUE(first.ok()) << first.status();
+  EXPECT_EQ((*first)->result, MakeResult({"key1", "key2"}));
+  EXPECT_EQ((*first)->request_size, 10);
+
+  // The same keys in a different order are the same lookup.
+  auto second = Execute(*client, {.keys = {"key2", "key1", "key2"},
+                                  .interest_group_names = {"ig"}});
+  ASSERT_TRUE(second.ok()) << second.status();
+  EXPECT_EQ((*second)->result, MakeResult({"key1", "key2"}));
+  EXPECT_EQ((*second)->data_version, 0);
+  EXPECT_EQ((*second)->request_size, 0);
+  EXPECT_EQ((*second)->response_size, 0);
+
+  EXPECT_EQ(BuyerKeyValueCacheMetrics::GetHitRatio().at("kv_cache"), 0.5);
+  // The ratio is reset once observed.
+  EXPECT_TRUE(BuyerKeyValueCacheMetrics::GetHitRatio().empty());
+}
+
+TEST_F(CachingBuyerKeyValueAsyncClientTest, FetchesOnlyMissingKeys) {
+  auto client = CreateClient();
+  std::vector<std::vector<std::string>> upstream_keys;
+  ExpectUpstreamLookups(2, &upstream_keys);
+
+  ASSERT_TRUE(Execute(*client, {.keys = {"key1", "key2"}}).ok());
+  auto second = Execute(*client, {.keys = {"key2", "key3"}});
+  ASSERT_TRUE(second.ok()) << second.status();
+  EXPECT_EQ((*second)->result, MakeResult({"key2", "key3"}));
+
+  EXPECT_THAT(upstream_keys, ElementsAre(ElementsAre("key1", "key2"),
+                                         ElementsAre("key3")));
+  // One of the four keys looked up was served from the cache.
+  EXPECT_EQ(BuyerKeyValueCacheMetrics::GetHitRatio().at("kv_cache"), 0.25);
+}
+
+TEST_F(CachingBuyerKeyValueAsyncClientTest, CachesKeysWithoutValues) {
+  auto client = CreateClient();
+  EXPECT_CALL(*mock_client_, Execute(_, _, _, _, _))
+      .WillOnce([](std::unique_ptr<GetBuyerValuesInput> input,
+                   const RequestMetadata& metadata, OnDone on_done,
+                   absl::Duration timeout, RequestContext context) {
+        std::move(on_done)(std::make_unique<GetBuyerValuesOutput>(
+            GetBuyerValuesOutput{.result = MakeResult({"key1"})}));
+        return absl::OkStatus();
+      });
+
+  const Lookup lookup = {.keys = {"key1", "key2"}};
+  ASSERT_TRUE(Execute(*client, lookup).ok());
+  auto second = Execute(*client, lookup);
+  ASSERT_TRUE(second.ok()) << second.status();
+  EXPECT_EQ((*second)->result, MakeResult({"key1"}));
+}
+
+TEST_F(CachingBuyerKeyValueAsyncClientTest, DistinguishesLookups) {
+  auto client = CreateClient();
+  ExpectUpstreamLookups(3);
+
+  ASSERT_TRUE(Execute(*client, {.keys = {"key1"}}).ok());
+  // Another hostname or client type isn't the same lookup.
+  Lookup lookup = {.keys = {"key1"}};
+  auto input = lookup.ToInput();
+  input->hostname = "other.com";
+  ASSERT_TRUE(client
+                  ->Execute(
+                      std::move(input), {}, [](auto output) {},
+                      absl::Seconds(1))
+                  .ok());
+  input = lookup.ToInput();
+  input->client_type = CLIENT_TYPE_ANDROID;
+  ASSERT_TRUE(client
+                  ->Execute(
+                      std::move(input), {}, [](auto output) {},
+                      absl::Seconds(1))
+                  .ok());
+}
+
+TEST_F(CachingBuyerKeyValueAsyncClientTest, PassesThroughPerInterestGroupData) {
+  auto client = CreateClient();
+  constexpr absl::string_view kResult =
+      R"JSON({"keys":{"key1":1},"perInterestGroupData":{"ig":{}}})JSON";
+  EXPECT_CALL(*mock_client_, Execute(_, _, _, _, _))
+      .Times(3)
+      .WillRepeatedly([kResult](std::unique_ptr<GetBuyerValuesInput> input,
+                                const RequestMetadata& metadata,
+                                OnDone on_done, absl::Duration timeout,
+                                RequestContext context) {
+        std::move(on_done)(std::make_unique<GetBuyerValuesOutput>(
+            GetBuyerValuesOutput{.result = std::string(kResult)}));
+        return absl::OkStatus();
+      });
+
+  const Lookup lookup = {.keys = {"key1"}, .interest_group_names = {"ig"}};
+  for (int i = 0; i < 3; ++i) {
+    auto output = Execute(*client, lookup);
+    ASSERT_TRUE(output.ok()) << output.status();
+    EXPECT_EQ((*output)->result, kResult);
+  }
+  EXPECT_EQ(
+      BuyerKeyValueCacheMetrics::GetPassThroughLookups().at("kv_cache"), 3);
+}
+
+TEST_F(CachingBuyerKeyValueAsyncClientTest, PassesThroughDataVersion) {
+  auto client = CreateClient();
+  std::vector<std::vector<std::string>> upstream_keys;
+  EXPECT_CALL(*mock_client_, Execute(_, _, _, _, _))
+      .Times(4)
+      .WillRepeatedly([&upstream_keys](
+                          std::unique_ptr<GetBuyerValuesInput> input,
+                          const RequestMetadata& metadata, OnDone on_done,
+                          absl::Duration timeout, RequestContext context) {
+        upstream_keys.emplace_back(input->keys.begin(), input->keys.end());
+        // Only the KV server responses after the first one are versioned.
+        const uint32_t data_version = upstream_keys.size() > 1 ? 7 : 0;
+        std::move(on_done)(
+            std::make_unique<GetBuyerValuesOutput>(GetBuyerValuesOutput{
+                .result = MakeResult(input->keys),
+                .data_version = data_version}));
+        return absl::OkStatus();
+      });
+
+  ASSERT_TRUE(Execute(*client, {.keys = {"key1"}}).ok());
+  // The versioned response for the missing key can't be combined with the
+  // cached value, so the whole lookup is sent again.
+  auto second = Execute(*client, {.keys = {"key1", "key2"}});
+  ASSERT_TRUE(second.ok()) << second.status();
+  EXPECT_EQ((*second)->result, MakeResult({"key1", "key2"}));
+  EXPECT_EQ((*second)->data_version, 7);
+  // The cache is bypassed for the hostname from then on.
+  auto third = Execute(*client, {.keys = {"key1"}});
+  ASSERT_TRUE(third.ok()) << third.status();
+  EXPECT_EQ((*third)->data_version, 7);
+
+  EXPECT_THAT(upstream_keys,
+              ElementsAre(ElementsAre("key1"), ElementsAre("key2"),
+                          ElementsAre("key1", "key2"), ElementsAre("key1")));
+  EXPECT_EQ(
+      BuyerKeyValueCacheMetrics::GetPassThroughLookups().at("kv_cache"), 2);
+}
+
+TEST_F(CachingBuyerKeyValueAsyncClientTest, PassesThroughOnlyTheSameHostname) {
+  auto client = CreateClient();
+  EXPECT_CALL(*mock_client_, Execute(_, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly([](std::unique_ptr<GetBuyerValuesInput> input,
+                         const RequestMetadata& metadata, OnDone on_done,
+                         absl::Duration timeout, RequestContext context) {
+        // Only the KV responses for the other hostname are versioned.
+        const uint32_t data_version = input->hostname == kHostname ? 0 : 7;
+        std::move(on_done)(
+            std::make_unique<GetBuyerValuesOutput>(GetBuyerValuesOutput{
+                .result = MakeResult(input->keys),
+                .data_version = data_version}));
+        return absl::OkStatus();
+      });
+
+  const Lookup lookup = {.keys = {"key1"}};
+  auto input = lookup.ToInput();
+  input->hostname = "other.com";
+  ASSERT_TRUE(client
+                  ->Execute(
+                      std::move(input), {}, [](auto output) {},
+                      absl::Seconds(1))
+                  .ok());
+  // The lookups of the hostname are still served from the cache.
+  ASSERT_TRUE(Execute(*client, lookup).ok());
+  ASSERT_TRUE(Execute(*client, lookup).ok());
+
+  EXPECT_EQ(
+      BuyerKeyValueCacheMetrics::GetPassThroughLookups().at("kv_cache"), 1);
+}
+
+TEST_F(CachingBuyerKeyValueAsyncClientTest, StopsPassingThroughAfterTtl) {
+  auto client = CreateClient({.pass_through_ttl = absl::ZeroDuration()});
+  std::vector<std::vector<std::string>> upstream_keys;
+  EXPECT_CALL(*mock_client_, Execute(_, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly([&upstream_keys](
+                          std::unique_ptr<GetBuyerValuesInput> input,
+                          const RequestMetadata& metadata, OnDone on_done,
+                          absl::Duration timeout, RequestContext context) {
+        upstream_keys.emplace_back(input->keys.begin(), input->keys.end());
+        // Only the first KV response is versioned.
+        const uint32_t data_version = upstream_keys.size() == 1 ? 7 : 0;
+        std::move(on_done)(
+            std::make_unique<GetBuyerValuesOutput>(GetBuyerValuesOutput{
+                .result = MakeResult(input->keys),
+                .data_version = data_version}));
+        return absl::OkStatus();
+      });
+
+  const Lookup lookup = {.keys = {"key1"}};
+  ASSERT_TRUE(Execute(*client, lookup).ok());
+  // Cached again, since the lookups no longer pass through.
+  ASSERT_TRUE(Execute(*client, lookup).ok());
+  ASSERT_TRUE(Execute(*client, lookup).ok());
+  EXPECT_EQ(upstream_keys.size(), 2);
+}
+
+TEST_F(CachingBuyerKeyValueAsyncClientTest, DoesNotCacheErrors) {
+  auto client = CreateClient();
+  EXPECT_CALL(*mock_client_, Execute(_, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly([](std::unique_ptr<GetBuyerValuesInput> input,
+                         const RequestMetadata& metadata, OnDone on_done,
+                         absl::Duration timeout, RequestContext context) {
+        std::move(on_done)(absl::UnavailableError("KV down"));
+        return absl::OkStatus();
+      });
+
+  const Lookup lookup = {.keys = {"key1"}};
+  EXPECT_FALSE(Execute(*client, lookup).ok());
+  EXPECT_FALSE(Execute(*client, lookup).ok());
+}
+
+TEST_F(CachingBuyerKeyValueAsyncClientTest, ExpiresEntries) {
+  auto client = CreateClient({.ttl = absl::ZeroDuration()});
+  ExpectUpstreamLookups(2);
+
+  const Lookup lookup = {.keys = {"key1"}};
+  ASSERT_TRUE(Execute(*client, lookup).ok());
+  ASSERT_TRUE(Execute(*client, lookup).ok());
+}
+
+TEST_F(CachingBuyerKeyValueAsyncClientTest, EvictsLeastRecentlyUsedEntries) {
+  // Only room for two entries.
+  auto client = CreateClient({.max_entries = 2, .num_shards = 1});
+  ExpectUpstreamLookups(4);
+
+  const Lookup lookup1 = {.keys = {"key1"}};
+  const Lookup lookup2 = {.keys = {"key2"}};
+  const Lookup lookup3 = {.keys = {"key3"}};
+  ASSERT_TRUE(Execute(*client, lookup1).ok());
+  ASSERT_TRUE(Execute(*client, lookup2).ok());
+  // Hit, which makes lookup2 the least recently used.
+  ASSERT_TRUE(Execute(*client, lookup1).ok());
+  ASSERT_TRUE(Execute(*client, lookup3).ok());
+  // Hit.
+  ASSERT_TRUE(Execute(*client, lookup1).ok());
+  // Miss, since it was evicted.
+  ASSERT_TRUE(Execute(*client, lookup2).ok());
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,535 @@
+//   Copyright 2025 Google LLC
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+
+#include "services/common/clients/http_kv_server/seller/caching_seller_key_value_async_client.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
+#include "absl/strings/str_cat.h"
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+#include "services/common/metric/server_definition.h"
+#include "services/common/util/cache_key_util.h"
+#include "services/common/util/json_util.h"
+#include "src/util/status_macro/status_macros.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+inline constexpr char kRenderUrls[] = "renderUrls";
+inline constexpr char kAdComponentRenderUrls[] = "adComponentRenderUrls";
+
+// Returns the part of the cache keys shared by all the URLs of `input`.
+std::string MakeCacheKeyPrefix(const GetSellerValuesInput& input) {
+  std::string prefix;
+  AppendCacheKeyField(absl::StrCat(static_cast<int>(input.client_type)), prefix);
+  AppendCacheKeyField(input.seller_kv_experiment_group_id, prefix);
+  return prefix;
+}
+
+std::string MakeCacheKey(absl::string_view prefix, bool is_ad_component,
+                         absl::string_view url) {
+  return absl::StrCat(prefix, is_ad_component ? "c" : "r", url);
+}
+
+}  // namespace
+
+class CachingSellerKeyValueAsyncClient::Fetch {
+ public:
+  struct Url {
+    bool is_ad_component;
+    std::string url;
+    std::string cache_key;
+  };
+
+  using Callback =
+      absl::AnyInvocable<void(const absl::StatusOr<FetchResult>&) &&>;
+
+  Fetch(ClientType client_type, std::string experiment_group_id)
+      : client_type_(client_type),
+        experiment_group_id_(std::move(experiment_group_id)) {}
+
+  // URLs are only added before the fetch is started.
+  void AddUrl(bool is_ad_component, absl::string_view url,
+              absl::string_view cache_key) {
+    urls_.push_back({.is_ad_component = is_ad_component,
+                     .url = std::string(url),
+                     .cache_key = std::string(cache_key)});
+  }
+
+  const std::vector<Url>& urls() const { return urls_; }
+
+  // The input points into the fetch, so it must outlive the input.
+  std::unique_ptr<GetSellerValuesInput> MakeInput() const {
+    auto input = std::make_unique<GetSellerValuesInput>();
+    input->client_type = client_type_;
+    input->seller_kv_experiment_group_id = experiment_group_id_;
+    for (const Url& url : urls_) {
+      if (url.is_ad_component) {
+        input->ad_component_render_urls.emplace(url.url);
+      } else {
+        input->render_urls.emplace(url.url);
+      }
+    }
+    return input;
+  }
+
+  // Invokes `callback` with the result of the fetch once it's done, inline if
+  // it's done already.
+  void OnDone(Callback callback) ABSL_LOCKS_EXCLUDED(mu_) {
+    {
+      absl::MutexLock lock(&mu_);
+      if (!result_.has_value()) {
+        callbacks_.push_back(std::move(callback));
+        return;
+      }
+    }
+    std::move(callback)(*result_);
+  }
+
+  // Only the first result of the fetch is kept.
+  void Complete(absl::StatusOr<FetchResult> result) ABSL_LOCKS_EXCLUDED(mu_) {
+    std::vector<Callback> callbacks;
+    {
+      absl::MutexLock lock(&mu_);
+      if (result_.has_value()) {
+        return;
+      }
+      result_ = std::move(result);
+      callbacks.swap(callbacks_);
+    }
+    for (Callback& callback : callbacks) {
+      std::move(callback)(*result_);
+    }
+  }
+
+ private:
+  const ClientType client_type_;
+  const std::string experiment_group_id_;
+  std::vector<Url> urls_;
+
+  absl::Mutex mu_;
+  // Set once under `mu_`, and never modified afterwards.
+  std::optional<absl::StatusOr<FetchResult>> result_;
+  std::vector<Callback> callbacks_ ABSL_GUARDED_BY(mu_);
+};
+
+struct CachingSellerKeyValueAsyncClient::PendingLookup {
+  PendingLookup(const GetSellerValuesInput& keys, RequestMetadata metadata,
+                absl::Time deadline, RequestContext context)
+      : client_type(keys.client_type),
+        experiment_group_id(keys.seller_kv_experiment_group_id),
+        metadata(std::move(metadata)),
+        deadline(deadline),
+        context(context) {}
+
+  struct Url {
+    bool is_ad_component;
+    std::string url;
+    std::string cache_key;
+    std::optional<std::string> signals;
+  };
+
+  // Fills the signals of the URLs at `url_indices` from `result`. The URLs
+  // another lookup failed to fetch are left to be fetched again.
+  void OnFetchDone(const std::vector<int>& url_indices,
+                   const absl::StatusOr<FetchResult>& result,
+                   bool is_own_fetch) ABSL_LOCKS_EXCLUDED(mu) {
+    int64_t bytes_saved = 0;
+    {
+      absl::MutexLock lock(&mu);
+      if (!result.ok()) {
+        if (!is_own_fetch) {
+          retry_url_indices.insert(retry_url_indices.end(),
+                                   url_indices.begin(), url_indices.end());
+        } else if (status.ok()) {
+          status = result.status();
+        }
+        return;
+      }
+      for (int index : url_indices) {
+        Url& url = urls[index];
+        if (auto it = result->signals.find(url.cache_key);
+            it != result->signals.end()) {
+          url.signals = it->second;
+        }
+        if (!is_own_fetch && url.signals.has_value()) {
+          bytes_saved += url.signals->size();
+        }
+      }
+      data_version = std::max(data_version, result->data_version);
+      if (is_own_fetch) {
+        request_size += result->request_size;
+        response_size += result->response_size;
+      }
+    }
+    SellerKeyValueCacheMetrics::AddBytesSaved(bytes_saved);
+  }
+
+  // Serializes the signals of the URLs in the Seller KV response format.
+  // Returns an empty string if there are no signals for any URL.
+  std::string SerializeSignals() const {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    bool has_signals = false;
+    writer.StartObject();
+    for (bool is_ad_component : {false, true}) {
+      bool has_namespace = false;
+      for (const Url& url : urls) {
+        if (url.is_ad_component != is_ad_component ||
+            !url.signals.has_value()) {
+          continue;
+        }
+        if (!has_namespace) {
+          writer.Key(is_ad_component ? kAdComponentRenderUrls : kRenderUrls);
+          writer.StartObject();
+          has_namespace = true;
+        }
+        writer.Key(url.url.data(), url.url.size());
+        writer.RawValue(url.signals->data(), url.signals->size(),
+                        rapidjson::kObjectType);
+      }
+      if (has_namespace) {
+        writer.EndObject();
+        has_signals = true;
+      }
+    }
+    writer.EndObject();
+    if (!has_signals) {
+      return "";
+    }
+    return std::string(buffer.GetString(), buffer.GetSize());
+  }
+
+  const ClientType client_type;
+  const std::string experiment_group_id;
+  const RequestMetadata metadata;
+  const absl::Time deadline;
+  const RequestContext context;
+  absl::AnyInvocable<
+      void(absl::StatusOr<std::unique_ptr<GetSellerValuesOutput>>) &&>
+      on_done;
+
+  absl::Mutex mu;
+  // Released by Execute() once all the fetches are awaited.
+  int pending_fetches ABSL_GUARDED_BY(mu) = 1;
+  // Only accessed under `mu` until all the fetches are done.
+  std::vector<Url> urls;
+  std::vector<int> retry_url_indices;
+  absl::Status status;
+  uint32_t data_version = 0;
+  size_t request_size = 0;
+  size_t response_size = 0;
+};
+
+namespace {
+
+// Adds the signals of the URLs under `url_namespace` of the Seller KV
+// response to `signals`. Signals of URLs that weren't fetched are ignored.
+absl::Status AddFetchedSignals(
+    const rapidjson::Document& response, const char* url_namespace,
+    absl::string_view cache_key_prefix, bool is_ad_component,
+    absl::flat_hash_map<std::string, std::optional<std::string>>& signals) {
+  auto it = response.FindMember(url_namespace);
+  if (it == response.MemberEnd()) {
+    return absl::OkStatus();
+  }
+  if (!it->value.IsObject()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Malformed ", url_namespace, " in Seller KV response"));
+  }
+  for (const auto& member : it->value.GetObject()) {
+    auto signals_it = signals.find(MakeCacheKey(
+        cache_key_prefix, is_ad_component,
+        absl::string_view(member.name.GetString(),
+                          member.name.GetStringLength())));
+    if (signals_it == signals.end()) {
+      continue;
+    }
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    if (!member.value.Accept(writer)) {
+      return absl::InvalidArgumentError(
+          "Unable to serialize Seller KV response signals");
+    }
+    signals_it->second.emplace(buffer.GetString(), buffer.GetSize());
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+CachingSellerKeyValueAsyncClient::CachingSellerKeyValueAsyncClient(
+    std::unique_ptr<AsyncClient<GetSellerValuesInput, GetSellerValuesOutput>>
+        client,
+    SellerKeyValueCacheOptions options)
+    : client_(std::move(client)),
+      options_(std::move(options)),
+      cache_(options_.max_entries, options_.ttl, options_.num_shards) {
+  fetch_shards_.reserve(std::max(options_.num_shards, 1));
+  for (int i = 0; i < std::max(options_.num_shards, 1); ++i) {
+    fetch_shards_.push_back(std::make_unique<FetchShard>());
+  }
+}
+
+absl::Status CachingSellerKeyValueAsyncClient::Execute(
+    std::unique_ptr<GetSellerValuesInput> keys, const RequestMetadata& metadata,
+    absl::AnyInvocable<
+        void(absl::StatusOr<std::unique_ptr<GetSellerValuesOutput>>) &&>
+        on_done,
+    absl::Duration timeout, RequestContext context) const {
+  const std::string cache_key_prefix = MakeCacheKeyPrefix(*keys);
+  auto lookup = std::make_shared<PendingLookup>(*keys, metadata,
+                                                absl::Now() + timeout, context);
+  lookup->on_done = std::move(on_done);
+  lookup->urls.reserve(keys->render_urls.size() +
+                       keys->ad_component_render_urls.size());
+  for (bool is_ad_component : {false, true}) {
+    for (absl::string_view url : is_ad_component
+                                     ? keys->ad_component_render_urls
+                                     : keys->render_urls) {
+      lookup->urls.push_back(
+          {.is_ad_component = is_ad_component,
+           .url = std::string(url),
+           .cache_key = MakeCacheKey(cache_key_prefix, is_ad_component, url)});
+    }
+  }
+
+  absl::flat_hash_set<std::string> cache_keys;
+  cache_keys.reserve(lookup->urls.size());
+  for (const PendingLookup::Url& url : lookup->urls) {
+    cache_keys.insert(url.cache_key);
+  }
+  absl::flat_hash_map<std::string, std::shared_ptr<const CachedSignals>>
+      cached_signals = cache_.Query(cache_keys);
+
+  // Fetch of the URLs that are neither cached nor being fetched already.
+  std::shared_ptr<Fetch> fetch;
+  // Fetches to wait on, with the indices of the URLs each of them provides.
+  std::vector<std::pair<std::shared_ptr<Fetch>, std::vector<int>>> waits;
+  absl::flat_hash_map<const Fetch*, int> wait_indices;
+  int64_t hits = 0;
+  int64_t coalesced = 0;
+  int64_t misses = 0;
+  int64_t bytes_saved = 0;
+  for (int i = 0; i < lookup->urls.size(); ++i) {
+    PendingLookup::Url& url = lookup->urls[i];
+    if (auto it = cached_signals.find(url.cache_key);
+        it != cached_signals.end()) {
+      url.signals = it->second->signals;
+      lookup->data_version =
+          std::max(lookup->data_version, it->second->data_version);
+      ++hits;
+      bytes_saved += url.signals.has_value() ? url.signals->size() : 0;
+      continue;
+    }
+    FetchShard& shard = GetFetchShard(url.cache_key);
+    std::shared_ptr<Fetch> url_fetch;
+    {
+      absl::MutexLock lock(&shard.mu);
+      if (auto it = shard.fetches_by_key.find(url.cache_key);
+          it != shard.fetches_by_key.end()) {
+        url_fetch = it->second;
+        ++coalesced;
+      } else {
+        if (fetch == nullptr) {
+          fetch = std::make_shared<Fetch>(keys->client_type,
+                                          keys->seller_kv_experiment_group_id);
+        }
+        fetch->AddUrl(url.is_ad_component, url.url, url.cache_key);
+        shard.fetches_by_key.emplace(url.cache_key, fetch);
+        url_fetch = fetch;
+        ++misses;
+      }
+    }
+    auto [wait_index, inserted] =
+        wait_indices.try_emplace(url_fetch.get(), waits.size());
+    if (inserted) {
+      waits.push_back({std::move(url_fetch), {}});
+    }
+    waits[wait_index->second].second.push_back(i);
+  }
+  SellerKeyValueCacheMetrics::RecordLookups(hits, coalesced, misses);
+  SellerKeyValueCacheMetrics::AddBytesSaved(bytes_saved);
+
+  {
+    absl::MutexLock lock(&lookup->mu);
+    lookup->pending_fetches += waits.size();
+  }
+  for (auto& [wait_fetch, url_indices] : waits) {
+    wait_fetch->OnDone([this, lookup, url_indices = std::move(url_indices),
+                        is_own_fetch = wait_fetch == fetch](
+                           const absl::StatusOr<FetchResult>& result) {
+      lookup->OnFetchDone(url_indices, result, is_own_fetch);
+      FinishIfDone(lookup);
+    });
+  }
+  if (fetch != nullptr) {
+    StartFetch(std::move(fetch), metadata, timeout, std::move(context));
+  }
+  FinishIfDone(std::move(lookup));
+  return absl::OkStatus();
+}
+
+CachingSellerKeyValueAsyncClient::FetchShard&
+CachingSellerKeyValueAsyncClient::GetFetchShard(absl::string_view key) const {
+  return *fetch_shards_[absl::Hash<absl::string_view>{}(key) %
+                        fetch_shards_.size()];
+}
+
+void CachingSellerKeyValueAsyncClient::StartFetch(
+    std::shared_ptr<Fetch> fetch, const RequestMetadata& metadata,
+    absl::Duration timeout, RequestContext context) const {
+  std::unique_ptr<GetSellerValuesInput> input = fetch->MakeInput();
+  const std::string cache_key_prefix = MakeCacheKeyPrefix(*input);
+  absl::Status status = client_->Execute(
+      std::move(input), metadata,
+      [this, fetch, cache_key_prefix](
+          absl::StatusOr<std::unique_ptr<GetSellerValuesOutput>> output) {
+        auto fetch_result = [&]() -> absl::StatusOr<FetchResult> {
+          PS_ASSIGN_OR_RETURN(std::unique_ptr<GetSellerValuesOutput> kv_output,
+                              std::move(output));
+          FetchResult result = {.data_version = kv_output->data_version,
+                                .request_size = kv_output->request_size,
+                                .response_size = kv_output->response_size};
+          result.signals.reserve(fetch->urls().size());
+          for (const Fetch::Url& url : fetch->urls()) {
+            result.signals.emplace(url.cache_key, std::nullopt);
+          }
+          if (kv_output->result.empty()) {
+            return result;
+          }
+          PS_ASSIGN_OR_RETURN(rapidjson::Document response,
+                              ParseJsonString(kv_output->result));
+          PS_RETURN_IF_ERROR(AddFetchedSignals(response, kRenderUrls,
+                                               cache_key_prefix,
+                                               /*is_ad_component=*/false,
+                                               result.signals));
+          PS_RETURN_IF_ERROR(AddFetchedSignals(response, kAdComponentRenderUrls,
+                                               cache_key_prefix,
+                                               /*is_ad_component=*/true,
+                                               result.signals));
+          return result;
+        }();
+        CompleteFetch(*fetch, std::move(fetch_result));
+      },
+      timeout, std::move(context));
+  if (!status.ok()) {
+    CompleteFetch(*fetch, std::move(status));
+  }
+}
+
+void CachingSellerKeyValueAsyncClient::CompleteFetch(
+    Fetch& fetch, absl::StatusOr<FetchResult> result) const {
+  // Cache the signals before the URLs stop being coalesced, so that lookups
+  // of these URLs always find them either cached or being fetched.
+  if (result.ok()) {
+    absl::flat_hash_map<std::string, std::shared_ptr<const CachedSignals>>
+        entries;
+    entries.reserve(result->signals.size());
+    for (const auto& [cache_key, signals] : result->signals) {
+      entries.emplace(cache_key, std::make_shared<const CachedSignals>(
+                                     CachedSignals{
+                                         .signals = signals,
+                                         .data_version = result->data_version,
+                                     }));
+    }
+    cache_.Insert(entries).IgnoreError();
+  }
+  for (const Fetch::Url& url : fetch.urls()) {
+    FetchShard& shard = GetFetchShard(url.cache_key);
+    absl::MutexLock lock(&shard.mu);
+    if (auto it = shard.fetches_by_key.find(url.cache_key);
+        it != shard.fetches_by_key.end() && it->second.get() == &fetch) {
+      shard.fetches_by_key.erase(it);
+    }
+  }
+  fetch.Complete(std::move(result));
+}
+
+void CachingSellerKeyValueAsyncClient::FinishIfDone(
+    std::shared_ptr<PendingLookup> lookup) const {
+  std::vector<int> retry_url_indices;
+  {
+    absl::MutexLock lock(&lookup->mu);
+    if (--lookup->pending_fetches > 0) {
+      return;
+    }
+    if (lookup->status.ok() && !lookup->retry_url_indices.empty()) {
+      retry_url_indices.swap(lookup->retry_url_indices);
+      ++lookup->pending_fetches;
+    }
+  }
+  if (!retry_url_indices.empty()) {
+    RetryFetch(std::move(lookup), retry_url_indices);
+    return;
+  }
+  if (!lookup->status.ok()) {
+    std::move(lookup->on_done)(lookup->status);
+    return;
+  }
+  std::move(lookup->on_done)(
+      std::make_unique<GetSellerValuesOutput>(GetSellerValuesOutput{
+          .result = lookup->SerializeSignals(),
+          .request_size = lookup->request_size,
+          .response_size = lookup->response_size,
+          .data_version = lookup->data_version}));
+}
+
+void CachingSellerKeyValueAsyncClient::RetryFetch(
+    std::shared_ptr<PendingLookup> lookup,
+    const std::vector<int>& url_indices) const {
+  // The retry isn't registered for coalescing: it only serves `lookup`, and
+  // the signals it fetches are cached for the next lookups.
+  auto fetch =
+      std::make_shared<Fetch>(lookup->client_type, lookup->experiment_group_id);
+  for (int index : url_indices) {
+    const PendingLookup::Url& url = lookup->urls[index];
+    fetch->AddUrl(url.is_ad_component, url.url, url.cache_key);
+  }
+  fetch->OnDone([this, lookup, url_indices](
+                    const absl::StatusOr<FetchResult>& result) {
+    lookup->OnFetchDone(url_indices, result, /*is_own_fetch=*/true);
+    FinishIfDone(lookup);
+  });
+  const absl::Duration timeout = lookup->deadline - absl::Now();
+  if (timeout <= absl::ZeroDuration()) {
+    CompleteFetch(*fetch, absl::DeadlineExceededError(
+                              "Seller KV lookup timed out before a failed "
+                              "shared fetch could be retried"));
+    return;
+  }
+  StartFetch(std::move(fetch), lookup->metadata, timeout, lookup->context);
+}
+
+absl::Status SellerKeyValueCacheMetrics::RegisterSfeMetrics() {
+  auto* context_map = metric::SfeContextMap();
+  PS_RETURN_IF_ERROR(context_map->AddObserverable(
+      metric::kSfeScoringSignalsCacheHitRatio,
+      SellerKeyValueCacheMetrics::GetHitRatio));
+  PS_RETURN_IF_ERROR(context_map->AddObserverable(
+      metric::kSfeScoringSignalsCacheCoalesceRatio,
+      SellerKeyValueCacheMetrics::GetCoalesceRatio));
+  PS_RETURN_IF_ERROR(context_map->AddObserverable(
+      metric::kSfeScoringSignalsCacheBytesSaved,
+      SellerKeyValueCacheMetrics::GetBytesSaved));
+  return absl::OkStatus();
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,227 @@
+//   Copyright 2025 Google LLC
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+
+#ifndef SERVICES_COMMON_CLIENTS_CACHING_SELLER_KEY_VALUE_ASYNC_CLIENT_H_
+#define SERVICES_COMMON_CLIENTS_CACHING_SELLER_KEY_VALUE_ASYNC_CLIENT_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "services/common/cache/sharded_cache.h"
+#include "services/common/clients/async_client.h"
+#include "services/common/clients/http_kv_server/seller/seller_key_value_async_http_client.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+struct SellerKeyValueCacheOptions {
+  // How long the scoring signals of a render URL are served from the cache.
+  absl::Duration ttl = absl::Seconds(1);
+  // Upper bound on the number of URLs whose scoring signals are cached.
+  int max_entries = 65536;
+  // Number of independently locked partitions of the cache.
+  int num_shards = kDefaultNumCacheShards;
+};
+
+// Serves the Seller KV lookups from an in-memory cache of the scoring signals
+// of each render URL and ad component render URL, since the same ads are
+// scored over and over across auctions. Only the URLs missing from the cache
+// are sent to the wrapped client, and their signals are cached once fetched.
+// A URL that is already being fetched for another lookup isn't fetched again:
+// the lookup waits for that fetch instead. If that fetch fails, the lookup
+// fetches the URL again on its own, within its own timeout.
+//
+// Signals are cached by URL, client type and experiment group. The request
+// metadata (e.g. the client IP) isn't part of the cache key, so the cache
+// must only front KV servers that don't vary the scoring signals on it. The
+// data version of a lookup served from several fetches is the highest one.
+//
+// The cache is split into shards, each of which evicts its least recently
+// used signals first once it holds more than its share of `max_entries`.
+class CachingSellerKeyValueAsyncClient
+    : public AsyncClient<GetSellerValuesInput, GetSellerValuesOutput> {
+ public:
+  CachingSellerKeyValueAsyncClient(
+      std::unique_ptr<AsyncClient<GetSellerValuesInput, GetSellerValuesOutput>>
+          client,
+      SellerKeyValueCacheOptions options);
+
+  // CachingSellerKeyValueAsyncClient is neither copyable nor movable.
+  CachingSellerKeyValueAsyncClient(const CachingSellerKeyValueAsyncClient&) =
+      delete;
+  CachingSellerKeyValueAsyncClient& operator=(
+      const CachingSellerKeyValueAsyncClient&) = delete;
+
+  // Invokes `on_done` inline if all the URLs are cached. The sizes reported
+  // only account for the URLs fetched for this lookup. Failures of the
+  // wrapped client are reported through `on_done`, so this always returns ok.
+  absl::Status Execute(
+      std::unique_ptr<GetSellerValuesInput> keys,
+      const RequestMetadata& metadata,
+      absl::AnyInvocable<
+          void(absl::StatusOr<std::unique_ptr<GetSellerValuesOutput>>) &&>
+          on_done,
+      absl::Duration timeout,
+      RequestContext context = NoOpContext()) const override;
+
+ private:
+  // A fetch of URLs from the wrapped client, shared by the lookups waiting on
+  // any of its URLs.
+  class Fetch;
+  // The state of a lookup waiting on fetches.
+  struct PendingLookup;
+
+  // Scoring signals of a URL.
+  struct CachedSignals {
+    // Unset if the KV server has no signals for the URL.
+    std::optional<std::string> signals;
+    uint32_t data_version;
+  };
+
+  // The fetches in flight, by the cache keys of their URLs.
+  struct FetchShard {
+    absl::Mutex mu;
+    absl::flat_hash_map<std::string, std::shared_ptr<Fetch>> fetches_by_key
+        ABSL_GUARDED_BY(mu);
+  };
+
+  FetchShard& GetFetchShard(absl::string_view key) const;
+
+  // Signals fetched from the wrapped client.
+  struct FetchResult {
+    // By cache key. Unset for the URLs the KV server has no signals for.
+    absl::flat_hash_map<std::string, std::optional<std::string>> signals;
+    uint32_t data_version = 0;
+    size_t request_size = 0;
+    size_t response_size = 0;
+  };
+
+  // Sends the URLs of `fetch` to the wrapped client, and completes `fetch`
+  // once they're fetched.
+  void StartFetch(std::shared_ptr<Fetch> fetch, const RequestMetadata& metadata,
+                  absl::Duration timeout, RequestContext context) const;
+
+  // Caches the fetched signals, stops coalescing lookups into `fetch` and
+  // hands the result to the lookups waiting on it.
+  void CompleteFetch(Fetch& fetch, absl::StatusOr<FetchResult> result) const;
+
+  // Invokes the callback of `lookup` once all its fetches are done, unless
+  // it has to fetch again the URLs that another lookup failed to fetch.
+  void FinishIfDone(std::shared_ptr<PendingLookup> lookup) const;
+
+  // Fetches the URLs at `url_indices` for `lookup` alone.
+  void RetryFetch(std::shared_ptr<PendingLookup> lookup,
+                  const std::vector<int>& url_indices) const;
+
+  std::unique_ptr<AsyncClient<GetSellerValuesInput, GetSellerValuesOutput>>
+      client_;
+  const SellerKeyValueCacheOptions options_;
+  // The cache is internally synchronized, but Execute() is const in the
+  // AsyncClient interface.
+  mutable ShardedCache<std::string, std::shared_ptr<const CachedSignals>>
+      cache_;
+  std::vector<std::unique_ptr<FetchShard>> fetch_shards_;
+};
+
+// Records the metrics of the Seller KV caches of the server. These metrics
+// are observed periodically rather than logged per request.
+class SellerKeyValueCacheMetrics {
+ public:
+  // Registers the metrics with the SFE metric context map.
+  static absl::Status RegisterSfeMetrics();
+
+  // Returns the ratio of URLs served from the cache since the previous call,
+  // or nothing if no URLs were looked up.
+  static absl::flat_hash_map<std::string, double> GetHitRatio()
+      ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    if (hit_ratio_lookups_ == 0) {
+      return {};
+    }
+    const double hit_ratio = static_cast<double>(hits_) / hit_ratio_lookups_;
+    hits_ = 0;
+    hit_ratio_lookups_ = 0;
+    return {{"scoring_signals_cache", hit_ratio}};
+  }
+
+  // Returns the ratio of URLs served by the fetch of another lookup since the
+  // previous call, or nothing if no URLs were looked up.
+  static absl::flat_hash_map<std::string, double> GetCoalesceRatio()
+      ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    if (coalesce_ratio_lookups_ == 0) {
+      return {};
+    }
+    const double coalesce_ratio =
+        static_cast<double>(coalesced_) / coalesce_ratio_lookups_;
+    coalesced_ = 0;
+    coalesce_ratio_lookups_ = 0;
+    return {{"scoring_signals_cache", coalesce_ratio}};
+  }
+
+  // Returns the bytes of signals that didn't have to be fetched since the
+  // previous call.
+  static absl::flat_hash_map<std::string, double> GetBytesSaved()
+      ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    const double bytes_saved = static_cast<double>(bytes_saved_);
+    bytes_saved_ = 0;
+    return {{"scoring_signals_cache", bytes_saved}};
+  }
+
+  static void RecordLookups(int64_t hits, int64_t coalesced, int64_t misses)
+      ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    hits_ += hits;
+    coalesced_ += coalesced;
+    hit_ratio_lookups_ += hits + coalesced + misses;
+    coalesce_ratio_lookups_ += hits + coalesced + misses;
+  }
+
+  static void AddBytesSaved(int64_t bytes) ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    bytes_saved_ += bytes;
+  }
+
+  // Clears all metric counters.
+  static void ClearStates_TestOnly() ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    hits_ = 0;
+    hit_ratio_lookups_ = 0;
+    coalesced_ = 0;
+    coalesce_ratio_lookups_ = 0;
+    bytes_saved_ = 0;
+  }
+
+ private:
+  ABSL_CONST_INIT static inline absl::Mutex mu_{absl::kConstInit};
+  static inline int64_t hits_ ABSL_GUARDED_BY(mu_) = 0;
+  static inline int64_t hit_ratio_lookups_ ABSL_GUARDED_BY(mu_) = 0;
+  static inline int64_t coalesced_ ABSL_GUARDED_BY(mu_) = 0;
+  static inline int64_t coalesce_ratio_lookups_ ABSL_GUARDED_BY(mu_) = 0;
+  static inline int64_t bytes_saved_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_COMMON_CLIENTS_CACHING_SELLER_KEY_VALUE_ASYNC_CLIENT_H_
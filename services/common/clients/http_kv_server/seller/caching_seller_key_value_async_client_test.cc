@@ -0,0 +1,393 @@
+//   Copyright 2025 Google LLC
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+
+#include "services/common/clients/http_kv_server/seller/caching_seller_key_value_async_client.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+#include "services/common/test/mocks.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+using ::testing::_;
+using SellerKeyValueAsyncClientMock =
+    AsyncClientMock<GetSellerValuesInput, GetSellerValuesOutput>;
+using OnDone = absl::AnyInvocable<
+    void(absl::StatusOr<std::unique_ptr<GetSellerValuesOutput>>) &&>;
+
+// Owns the strings the input sets point into.
+struct Lookup {
+  std::vector<std::string> render_urls;
+  std::vector<std::string> ad_component_render_urls;
+
+  std::unique_ptr<GetSellerValuesInput> ToInput() const {
+    auto input = std::make_unique<GetSellerValuesInput>();
+    input->client_type = CLIENT_TYPE_BROWSER;
+    input->render_urls.insert(render_urls.begin(), render_urls.end());
+    input->ad_component_render_urls.insert(ad_component_render_urls.begin(),
+                                           ad_component_render_urls.end());
+    return input;
+  }
+};
+
+// Returns the response of a KV server with signals for all the URLs of
+// `input`, except for "missing".
+std::unique_ptr<GetSellerValuesOutput> MakeResponse(
+    const GetSellerValuesInput& input) {
+  std::string render_urls;
+  for (absl::string_view url : input.render_urls) {
+    if (url != "missing") {
+      absl::StrAppend(&render_urls, render_urls.empty() ? "" : ",", "\"", url,
+                      "\":[\"", url, "\"]");
+    }
+  }
+  std::string ad_component_render_urls;
+  for (absl::string_view url : input.ad_component_render_urls) {
+    absl::StrAppend(&ad_component_render_urls,
+                    ad_component_render_urls.empty() ? "" : ",", "\"", url,
+                    "\":{\"component\":\"", url, "\"}");
+  }
+  return std::make_unique<GetSellerValuesOutput>(GetSellerValuesOutput{
+      .result = absl::StrCat(R"JSON({"renderUrls":{)JSON", render_urls,
+                             R"JSON(},"adComponentRenderUrls":{)JSON",
+                             ad_component_render_urls, "}}"),
+      .request_size = 10,
+      .response_size = 20,
+      .data_version = 7});
+}
+
+class CachingSellerKeyValueAsyncClientTest : public testing::Test {
+ protected:
+  void SetUp() override { SellerKeyValueCacheMetrics::ClearStates_TestOnly(); }
+
+  std::unique_ptr<CachingSellerKeyValueAsyncClient> CreateClient(
+      SellerKeyValueCacheOptions options = {}) {
+    auto mock_client = std::make_unique<SellerKeyValueAsyncClientMock>();
+    mock_client_ = mock_client.get();
+    return std::make_unique<CachingSellerKeyValueAsyncClient>(
+        std::move(mock_client), options);
+  }
+
+  // Expects `num_fetches` fetches to reach the wrapped client, each of them
+  // succeeding, and records the render URLs of each of them.
+  void ExpectUpstreamFetches(int num_fetches) {
+    EXPECT_CALL(*mock_client_, Execute(_, _, _, _, _))
+        .Times(num_fetches)
+        .WillRepeatedly([this](std::unique_ptr<GetSellerValuesInput> input,
+                               const RequestMetadata& metadata,
+                               OnDone on_done, absl::Duration timeout,
+                               RequestContext context) {
+          fetched_render_urls_.emplace_back(input->render_urls.begin(),
+                                            input->render_urls.end());
+          std::move(on_done)(MakeResponse(*input));
+          return absl::OkStatus();
+        });
+  }
+
+  // Runs a lookup and returns its output, or an error if it isn't done.
+  absl::StatusOr<std::unique_ptr<GetSellerValuesOutput>> Execute(
+      const CachingSellerKeyValueAsyncClient& client, const Lookup& lookup) {
+    absl::StatusOr<std::unique_ptr<GetSellerValuesOutput>> result =
+        absl::UnknownError("Lookup not done");
+    absl::Status status = client.Execute(
+        lookup.ToInput(), {},
+        [&result](auto output) { result = std::move(output); },
+        absl::Seconds(1));
+    EXPECT_TRUE(status.ok()) << status;
+    return result;
+  }
+
+  SellerKeyValueAsyncClientMock* mock_client_ = nullptr;
+  std::vector<std::vector<std::string>> fetched_render_urls_;
+};
+
+TEST_F(CachingSellerKeyValueAsyncClientTest, ServesRepeatedUrlsFromCache) {
+  auto client = CreateClient();
+  ExpectUpstreamFetches(1);
+
+  const Lookup lookup = {.render_urls = {"url1", "url2"},
+                         .ad_component_render_urls = {"component1"}};
+  auto first = Execute(*client, lookup);
+  ASSERT_TRUE(first.ok()) << first.status();
+  EXPECT_EQ((*first)->request_size, 10);
+  EXPECT_EQ((*first)->data_version, 7);
+
+  auto second = Execute(*client, lookup);
+  ASSERT_TRUE(second.ok()) << second.status();
+  EXPECT_EQ((*second)->result, (*first)->result);
+  EXPECT_EQ((*second)->result,
+            R"JSON({"renderUrls":{"url1":["url1"],"url2":["url2"]},)JSON"
+            R"JSON("adComponentRenderUrls":{"component1":)JSON"
+            R"JSON({"component":"component1"}}})JSON");
+  EXPECT_EQ((*second)->data_version, 7);
+  EXPECT_EQ((*second)->request_size, 0);
+  EXPECT_EQ((*second)->response_size, 0);
+
+  EXPECT_EQ(SellerKeyValueCacheMetrics::GetHitRatio().at(
+                "scoring_signals_cache"),
+            0.5);
+  EXPECT_GT(SellerKeyValueCacheMetrics::GetBytesSaved().at(
+                "scoring_signals_cache"),
+            0);
+  // The ratio is reset once observed.
+  EXPECT_TRUE(SellerKeyValueCacheMetrics::GetHitRatio().empty());
+}
+
+TEST_F(CachingSellerKeyValueAsyncClientTest, FetchesOnlyMissingUrls) {
+  auto client = CreateClient();
+  ExpectUpstreamFetches(2);
+
+  ASSERT_TRUE(Execute(*client, {.render_urls = {"url1"}}).ok());
+  auto output = Execute(*client, {.render_urls = {"url1", "url2"}});
+  ASSERT_TRUE(output.ok()) << output.status();
+  EXPECT_EQ((*output)->result,
+            R"JSON({"renderUrls":{"url1":["url1"],"url2":["url2"]}})JSON");
+
+  ASSERT_EQ(fetched_render_urls_.size(), 2);
+  EXPECT_EQ(fetched_render_urls_[1], std::vector<std::string>{"url2"});
+}
+
+TEST_F(CachingSellerKeyValueAsyncClientTest, CachesUrlsWithoutSignals) {
+  auto client = CreateClient();
+  ExpectUpstreamFetches(1);
+
+  const Lookup lookup = {.render_urls = {"missing"}};
+  auto first = Execute(*client, lookup);
+  ASSERT_TRUE(first.ok()) << first.status();
+  EXPECT_TRUE((*first)->result.empty());
+
+  auto second = Execute(*client, lookup);
+  ASSERT_TRUE(second.ok()) << second.status();
+  EXPECT_TRUE((*second)->result.empty());
+}
+
+TEST_F(CachingSellerKeyValueAsyncClientTest, DistinguishesUrlNamespaces) {
+  auto client = CreateClient();
+  ExpectUpstreamFetches(2);
+
+  ASSERT_TRUE(Execute(*client, {.render_urls = {"url"}}).ok());
+  auto output = Execute(*client, {.ad_component_render_urls = {"url"}});
+  ASSERT_TRUE(output.ok()) << output.status();
+  EXPECT_EQ((*output)->result,
+            R"JSON({"adComponentRenderUrls":{"url":{"component":"url"}}})JSON");
+}
+
+TEST_F(CachingSellerKeyValueAsyncClientTest, CoalescesConcurrentFetches) {
+  auto client = CreateClient();
+  std::unique_ptr<GetSellerValuesInput> pending_input;
+  OnDone pending_on_done;
+  EXPECT_CALL(*mock_client_, Execute(_, _, _, _, _))
+      .WillOnce([&](std::unique_ptr<GetSellerValuesInput> input,
+                    const RequestMetadata& metadata, OnDone on_done,
+                    absl::Duration timeout, RequestContext context) {
+        pending_input = std::move(input);
+        pending_on_done = std::move(on_done);
+        return absl::OkStatus();
+      });
+
+  const Lookup lookup = {.render_urls = {"url1"}};
+  absl::StatusOr<std::unique_ptr<GetSellerValuesOutput>> first =
+      absl::UnknownError("Lookup not done");
+  absl::StatusOr<std::unique_ptr<GetSellerValuesOutput>> second =
+      absl::UnknownError("Lookup not done");
+  ASSERT_TRUE(client
+                  ->Execute(
+                      lookup.ToInput(), {},
+                      [&first](auto output) { first = std::move(output); },
+                      absl::Seconds(1))
+                  .ok());
+  ASSERT_TRUE(client
+                  ->Execute(
+                      lookup.ToInput(), {},
+                      [&second](auto output) { second = std::move(output); },
+                      absl::Seconds(1))
+                  .ok());
+  // Neither lookup is done until the fetch they share is.
+  EXPECT_FALSE(first.ok());
+  EXPECT_FALSE(second.ok());
+
+  std::move(pending_on_done)(MakeResponse(*pending_input));
+  ASSERT_TRUE(first.ok()) << first.status();
+  ASSERT_TRUE(second.ok()) << second.status();
+  EXPECT_EQ((*first)->result, R"JSON({"renderUrls":{"url1":["url1"]}})JSON");
+  EXPECT_EQ((*second)->result, (*first)->result);
+  EXPECT_EQ((*first)->request_size, 10);
+  EXPECT_EQ((*second)->request_size, 0);
+  EXPECT_EQ(SellerKeyValueCacheMetrics::GetCoalesceRatio().at(
+                "scoring_signals_cache"),
+            0.5);
+}
+
+TEST_F(CachingSellerKeyValueAsyncClientTest, DoesNotCacheErrors) {
+  auto client = CreateClient();
+  std::vector<OnDone> pending_on_dones;
+  EXPECT_CALL(*mock_client_, Execute(_, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly([&](std::unique_ptr<GetSellerValuesInput> input,
+                          const RequestMetadata& metadata, OnDone on_done,
+                          absl::Duration timeout, RequestContext context) {
+        pending_on_dones.push_back(std::move(on_done));
+        return absl::OkStatus();
+      });
+
+  const Lookup lookup = {.render_urls = {"url1"}};
+  std::vector<absl::StatusOr<std::unique_ptr<GetSellerValuesOutput>>> results;
+  for (int i = 0; i < 2; ++i) {
+    results.emplace_back(absl::UnknownError("Lookup not done"));
+  }
+  ASSERT_TRUE(client
+                  ->Execute(
+                      lookup.ToInput(), {},
+                      [&result = results[0]](auto output) {
+                        result = std::move(output);
+                      },
+                      absl::Seconds(1))
+                  .ok());
+  ASSERT_EQ(pending_on_dones.size(), 1);
+  std::move(pending_on_dones[0])(absl::UnavailableError("KV down"));
+  EXPECT_EQ(results[0].status().code(), absl::StatusCode::kUnavailable);
+
+  // The URL is fetched again.
+  ASSERT_TRUE(client
+                  ->Execute(
+                      lookup.ToInput(), {},
+                      [&result = results[1]](auto output) {
+                        result = std::move(output);
+                      },
+                      absl::Seconds(1))
+                  .ok());
+  ASSERT_EQ(pending_on_dones.size(), 2);
+  std::move(pending_on_dones[1])(MakeResponse(*lookup.ToInput()));
+  EXPECT_TRUE(results[1].ok()) << results[1].status();
+}
+
+TEST_F(CachingSellerKeyValueAsyncClientTest,
+       RetriesCoalescedLookupsAfterFailedFetch) {
+  auto client = CreateClient();
+  std::vector<OnDone> pending_on_dones;
+  std::vector<absl::Duration> timeouts;
+  EXPECT_CALL(*mock_client_, Execute(_, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly([&](std::unique_ptr<GetSellerValuesInput> input,
+                          const RequestMetadata& metadata, OnDone on_done,
+                          absl::Duration timeout, RequestContext context) {
+        pending_on_dones.push_back(std::move(on_done));
+        timeouts.push_back(timeout);
+        return absl::OkStatus();
+      });
+
+  const Lookup lookup = {.render_urls = {"url1"}};
+  absl::StatusOr<std::unique_ptr<GetSellerValuesOutput>> first =
+      absl::UnknownError("Lookup not done");
+  absl::StatusOr<std::unique_ptr<GetSellerValuesOutput>> second =
+      absl::UnknownError("Lookup not done");
+  ASSERT_TRUE(client
+                  ->Execute(
+                      lookup.ToInput(), {},
+                      [&first](auto output) { first = std::move(output); },
+                      absl::Milliseconds(100))
+                  .ok());
+  ASSERT_TRUE(client
+                  ->Execute(
+                      lookup.ToInput(), {},
+                      [&second](auto output) { second = std::move(output); },
+                      absl::Seconds(10))
+                  .ok());
+  ASSERT_EQ(pending_on_dones.size(), 1);
+  std::move(pending_on_dones[0])(absl::DeadlineExceededError("Timed out"));
+  // The lookup that started the fetch gets its error, while the one waiting
+  // on it fetches the URL again within its own timeout.
+  EXPECT_EQ(first.status().code(), absl::StatusCode::kDeadlineExceeded);
+  EXPECT_FALSE(second.ok());
+  ASSERT_EQ(pending_on_dones.size(), 2);
+  EXPECT_GT(timeouts[1], absl::Milliseconds(100));
+  EXPECT_LE(timeouts[1], absl::Seconds(10));
+
+  std::move(pending_on_dones[1])(MakeResponse(*lookup.ToInput()));
+  ASSERT_TRUE(second.ok()) << second.status();
+  EXPECT_EQ((*second)->result, R"JSON({"renderUrls":{"url1":["url1"]}})JSON");
+  EXPECT_EQ((*second)->request_size, 10);
+}
+
+TEST_F(CachingSellerKeyValueAsyncClientTest,
+       DoesNotRetryCoalescedLookupsPastTheirTimeout) {
+  auto client = CreateClient();
+  OnDone pending_on_done;
+  EXPECT_CALL(*mock_client_, Execute(_, _, _, _, _))
+      .WillOnce([&](std::unique_ptr<GetSellerValuesInput> input,
+                    const RequestMetadata& metadata, OnDone on_done,
+                    absl::Duration timeout, RequestContext context) {
+        pending_on_done = std::move(on_done);
+        return absl::OkStatus();
+      });
+
+  const Lookup lookup = {.render_urls = {"url1"}};
+  absl::StatusOr<std::unique_ptr<GetSellerValuesOutput>> first =
+      absl::UnknownError("Lookup not done");
+  absl::StatusOr<std::unique_ptr<GetSellerValuesOutput>> second =
+      absl::UnknownError("Lookup not done");
+  ASSERT_TRUE(client
+                  ->Execute(
+                      lookup.ToInput(), {},
+                      [&first](auto output) { first = std::move(output); },
+                      absl::Seconds(1))
+                  .ok());
+  ASSERT_TRUE(client
+                  ->Execute(
+                      lookup.ToInput(), {},
+                      [&second](auto output) { second = std::move(output); },
+                      absl::ZeroDuration())
+                  .ok());
+  std::move(pending_on_done)(absl::UnavailableError("KV down"));
+  EXPECT_EQ(first.status().code(), absl::StatusCode::kUnavailable);
+  EXPECT_EQ(second.status().code(), absl::StatusCode::kDeadlineExceeded);
+}
+
+TEST_F(CachingSellerKeyValueAsyncClientTest, ExpiresEntries) {
+  auto client = CreateClient({.ttl = absl::ZeroDuration()});
+  ExpectUpstreamFetches(2);
+
+  const Lookup lookup = {.render_urls = {"url1"}};
+  ASSERT_TRUE(Execute(*client, lookup).ok());
+  ASSERT_TRUE(Execute(*client, lookup).ok());
+}
+
+TEST_F(CachingSellerKeyValueAsyncClientTest, EvictsLeastRecentlyUsedEntries) {
+  auto client = CreateClient({.max_entries = 2, .num_shards = 1});
+  ExpectUpstreamFetches(4);
+
+  const Lookup lookup1 = {.render_urls = {"url1"}};
+  const Lookup lookup2 = {.render_urls = {"url2"}};
+  const Lookup lookup3 = {.render_urls = {"url3"}};
+  ASSERT_TRUE(Execute(*client, lookup1).ok());
+  ASSERT_TRUE(Execute(*client, lookup2).ok());
+  // Hit, which makes url2 the least recently used.
+  ASSERT_TRUE(Execute(*client, lookup1).ok());
+  ASSERT_TRUE(Execute(*client, lookup3).ok());
+  // Hit.
+  ASSERT_TRUE(Execute(*client, lookup1).ok());
+  // Miss, since it was evicted.
+  ASSERT_TRUE(Execute(*client, lookup2).ok());
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -20,8 +20,29 @@
 
 namespace privacy_sandbox::bidding_auction_servers {
 
+namespace {
+
+// Sizes of the header and trailer that wrap deflate compressed data.
+constexpr size_t kZlibWrapperSize = 6;
+constexpr size_t kGzipWrapperSize = 18;
+
+}  // namespace
+
 absl::StatusOr<std::string> GzipCompress(absl::string_view uncompressed,
                                          int compression_level) {
+  std::string compressed;
+  absl::StatusOr<size_t> compressed_size =
+      GzipCompressInto(uncompressed, /*offset=*/0, compressed,
+                       compression_level);
+  if (!compressed_size.ok()) {
+    return compressed_size.status();
+  }
+  return compressed;
+}
+
+absl::StatusOr<size_t> GzipCompressInto(absl::string_view uncompressed,
+                                        size_t offset, std::string& output,
+                                        int compression_level) {
   z_stream zs;
   zs.zalloc = Z_NULL;
   zs.zfree = Z_NULL;
@@ -40,12 +61,12 @@ absl::StatusOr<std::string> GzipCompress(absl::string_view uncompressed,
   }
 
   const int kPartitionSizeBound = deflateBound(&zs, uncompressed.size());
-  std::string partition_output_buffer(kPartitionSizeBound, '\0');
+  output.resize(offset + kPartitionSizeBound);
 
   zs.avail_out = (uInt)kPartitionSizeBound;
   // We'll manually write the size of the compressed data manually after
   // compressing the data.
-  zs.next_out = (Bytef*)partition_output_buffer.data();
+  zs.next_out = (Bytef*)output.data() + offset;
 
   const int deflate_status = deflate(&zs, Z_FINISH);
   if (deflate_status != Z_STREAM_END) {
@@ -63,8 +84,14 @@ absl::StatusOr<std::string> GzipCompress(absl::string_view uncompressed,
         deflate_end_status));
   }
 
-  partition_output_buffer.resize(zs.total_out);
-  return partition_output_buffer;
+  output.resize(offset + zs.total_out);
+  return zs.total_out;
+}
+
+size_t GzipCompressBound(size_t decompressed_size) {
+  // compressBound() assumes the zlib wrapper.
+  return compressBound(decompressed_size) - kZlibWrapperSize +
+         kGzipWrapperSize;
 }
 
 absl::StatusOr<std::string> GzipDecompress(absl::string_view compressed) {
@@ -38,6 +38,18 @@ absl::StatusOr<std::string> GzipCompress(
     absl::string_view decompressed,
     int compression_level = Z_DEFAULT_COMPRESSION);
 
+// Compresses a string using gzip, writing the compressed data into `output`
+// starting at `offset`, so that callers can frame the data without copying
+// it. `output` is resized to end right after the compressed data; its
+// capacity is kept. Returns the size of the compressed data.
+absl::StatusOr<size_t> GzipCompressInto(
+    absl::string_view decompressed, size_t offset, std::string& output,
+    int compression_level = Z_DEFAULT_COMPRESSION);
+
+// Returns an upper bound on the size of `decompressed_size` bytes compressed
+// with gzip using the default memory level.
+size_t GzipCompressBound(size_t decompressed_size);
+
 // Decompresses a gzip compressed string.
 absl::StatusOr<std::string> GzipDecompress(absl::string_view compressed);
 
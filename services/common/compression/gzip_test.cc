@@ -94,5 +94,34 @@ TEST(GzipCompressionTests, DecompressWithBoost) {
   ASSERT_EQ(payload, boost_decompress);
 }
 
+TEST(GzipCompressionTests, CompressIntoKeepsPrefix) {
+  std::string payload = GeneratePayload(1);
+  std::string output = "prefix";
+  absl::StatusOr<size_t> compressed_size =
+      GzipCompressInto(payload, /*offset=*/6, output);
+  ASSERT_TRUE(compressed_size.ok()) << compressed_size.status();
+  ASSERT_EQ(output.size(), 6 + *compressed_size);
+  EXPECT_EQ(absl::string_view(output).substr(0, 6), "prefix");
+  EXPECT_LE(*compressed_size, GzipCompressBound(payload.size()));
+
+  absl::StatusOr<std::string> decompressed =
+      GzipDecompress(absl::string_view(output).substr(6));
+  ASSERT_TRUE(decompressed.ok()) << decompressed.status();
+  EXPECT_EQ(payload, *decompressed);
+}
+
+TEST(GzipCompressionTests, CompressBoundFitsIncompressibleData) {
+  // Pseudo-random bytes that deflate cannot shrink.
+  std::string payload(4096, '\0');
+  uint32_t state = 1;
+  for (char& c : payload) {
+    state = state * 1103515245 + 12345;
+    c = static_cast<char>(state >> 24);
+  }
+  absl::StatusOr<std::string> compressed = GzipCompress(payload);
+  ASSERT_TRUE(compressed.ok()) << compressed.status();
+  EXPECT_LE(compressed->size(), GzipCompressBound(payload.size()));
+}
+
 }  // namespace
 }  // namespace privacy_sandbox::bidding_auction_servers
@@ -84,13 +84,18 @@ CryptoClientWrapper::~CryptoClientWrapper() {
 
 absl::StatusOr<HpkeEncryptResponse> CryptoClientWrapper::HpkeEncrypt(
     const PublicKey& key, const std::string& plaintext_payload) noexcept {
+  return HpkeEncrypt(key, std::string(plaintext_payload));
+}
+
+absl::StatusOr<HpkeEncryptResponse> CryptoClientWrapper::HpkeEncrypt(
+    const PublicKey& key, std::string&& plaintext_payload) noexcept {
   google::cmrt::sdk::public_key_service::v1::PublicKey public_key;
   public_key.set_key_id(key.key_id());
   public_key.set_public_key(key.public_key());
 
   HpkeEncryptRequest request;
   *request.mutable_public_key() = std::move(public_key);
-  request.set_payload(plaintext_payload);
+  request.set_payload(std::move(plaintext_payload));
   request.set_shared_info(kSharedInfo);
   request.set_is_bidirectional(true);
   request.set_secret_length(
@@ -122,8 +127,13 @@ absl::StatusOr<HpkeEncryptResponse> CryptoClientWrapper::HpkeEncrypt(
 
 absl::StatusOr<AeadEncryptResponse> CryptoClientWrapper::AeadEncrypt(
     const std::string& plaintext_payload, const std::string& secret) noexcept {
+  return AeadEncrypt(std::string(plaintext_payload), secret);
+}
+
+absl::StatusOr<AeadEncryptResponse> CryptoClientWrapper::AeadEncrypt(
+    std::string&& plaintext_payload, const std::string& secret) noexcept {
   AeadEncryptRequest request;
-  request.set_payload(plaintext_payload);
+  request.set_payload(std::move(plaintext_payload));
   request.set_secret(secret);
   request.set_shared_info(kSharedInfo);
 
@@ -206,10 +216,15 @@ absl::StatusOr<HpkeDecryptResponse> CryptoClientWrapper::HpkeDecrypt(
 
 absl::StatusOr<AeadDecryptResponse> CryptoClientWrapper::AeadDecrypt(
     const std::string& ciphertext, const std::string& secret) noexcept {
+  return AeadDecrypt(std::string(ciphertext), secret);
+}
+
+absl::StatusOr<AeadDecryptResponse> CryptoClientWrapper::AeadDecrypt(
+    std::string&& ciphertext, const std::string& secret) noexcept {
   AeadDecryptRequest request;
   request.set_shared_info(kSharedInfo);
   request.set_secret(secret);
-  request.mutable_encrypted_data()->set_ciphertext(ciphertext);
+  request.mutable_encrypted_data()->set_ciphertext(std::move(ciphertext));
 
   AeadDecryptResponse response;
   bool success = false;
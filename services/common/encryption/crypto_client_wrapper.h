@@ -55,6 +55,11 @@ class CryptoClientWrapper : public CryptoClientWrapperInterface {
   HpkeEncrypt(const google::cmrt::sdk::public_key_service::v1::PublicKey& key,
               const std::string& plaintext_payload) noexcept override;
 
+  // Same as above, but moves `plaintext_payload` into the request.
+  absl::StatusOr<google::cmrt::sdk::crypto_service::v1::HpkeEncryptResponse>
+  HpkeEncrypt(const google::cmrt::sdk::public_key_service::v1::PublicKey& key,
+              std::string&& plaintext_payload) noexcept override;
+
   // Decrypts a ciphertext using HPKE.
   absl::StatusOr<google::cmrt::sdk::crypto_service::v1::HpkeDecryptResponse>
   HpkeDecrypt(const server_common::PrivateKey& private_key,
@@ -66,12 +71,22 @@ class CryptoClientWrapper : public CryptoClientWrapperInterface {
   AeadEncrypt(const std::string& plaintext_payload,
               const std::string& secret) noexcept override;
 
+  // Same as above, but moves `plaintext_payload` into the request.
+  absl::StatusOr<google::cmrt::sdk::crypto_service::v1::AeadEncryptResponse>
+  AeadEncrypt(std::string&& plaintext_payload,
+              const std::string& secret) noexcept override;
+
   // Decrypts a ciphertext using AEAD and a secret derived from the HPKE
   // encrypt operation.
   absl::StatusOr<google::cmrt::sdk::crypto_service::v1::AeadDecryptResponse>
   AeadDecrypt(const std::string& ciphertext,
               const std::string& secret) noexcept override;
 
+  // Same as above, but moves `ciphertext` into the request.
+  absl::StatusOr<google::cmrt::sdk::crypto_service::v1::AeadDecryptResponse>
+  AeadDecrypt(std::string&& ciphertext,
+              const std::string& secret) noexcept override;
+
  private:
   std::unique_ptr<google::scp::cpio::CryptoClientInterface> crypto_client_;
 };
@@ -0,0 +1,190 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark of the payload copies made around AEAD encryption/decryption of
+// the inter-server requests and responses. The crypto client is faked with an
+// identity cipher so that the reported bytes_allocated counter only reflects
+// the copies made by the wrapper and its callers.
+// Run the benchmark as follows:
+// builders/tools/bazel-debian run --dynamic_mode=off -c opt --copt=-gmlt \
+//   --copt=-fno-omit-frame-pointer --fission=yes --strip=never \
+//   services/common/encryption:crypto_client_wrapper_benchmarks -- \
+//   --benchmark_time_unit=us --benchmark_repetitions=10
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+#include "services/common/encryption/crypto_client_wrapper.h"
+
+namespace {
+
+std::atomic<int64_t> allocated_bytes = 0;
+
+}  // namespace
+
+// Counts the bytes allocated by the benchmarked code.
+void* operator new(size_t size) {
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t size) noexcept { std::free(ptr); }
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+using ::google::cmrt::sdk::crypto_service::v1::AeadDecryptRequest;
+using ::google::cmrt::sdk::crypto_service::v1::AeadDecryptResponse;
+using ::google::cmrt::sdk::crypto_service::v1::AeadEncryptRequest;
+using ::google::cmrt::sdk::crypto_service::v1::AeadEncryptResponse;
+using ::google::cmrt::sdk::crypto_service::v1::HpkeDecryptRequest;
+using ::google::cmrt::sdk::crypto_service::v1::HpkeDecryptResponse;
+using ::google::cmrt::sdk::crypto_service::v1::HpkeEncryptRequest;
+using ::google::cmrt::sdk::crypto_service::v1::HpkeEncryptResponse;
+using ::google::scp::core::SuccessExecutionResult;
+using ::google::scp::cpio::Callback;
+
+inline constexpr char kSecret[] = "secret";
+
+// Crypto client that "encrypts" and "decrypts" by moving the input into the
+// output.
+class IdentityCryptoClient : public google::scp::cpio::CryptoClientInterface {
+ public:
+  absl::Status Init() noexcept override { return absl::OkStatus(); }
+  absl::Status Run() noexcept override { return absl::OkStatus(); }
+  absl::Status Stop() noexcept override { return absl::OkStatus(); }
+
+  absl::Status HpkeEncrypt(
+      HpkeEncryptRequest request,
+      Callback<HpkeEncryptResponse> callback) noexcept override {
+    HpkeEncryptResponse response;
+    *response.mutable_encrypted_data()->mutable_ciphertext() =
+        std::move(*request.mutable_payload());
+    callback(SuccessExecutionResult(), std::move(response));
+    return absl::OkStatus();
+  }
+
+  absl::Status HpkeDecrypt(
+      HpkeDecryptRequest request,
+      Callback<HpkeDecryptResponse> callback) noexcept override {
+    HpkeDecryptResponse response;
+    *response.mutable_payload() =
+        std::move(*request.mutable_encrypted_data()->mutable_ciphertext());
+    callback(SuccessExecutionResult(), std::move(response));
+    return absl::OkStatus();
+  }
+
+  absl::Status AeadEncrypt(
+      AeadEncryptRequest request,
+      Callback<AeadEncryptResponse> callback) noexcept override {
+    AeadEncryptResponse response;
+    *response.mutable_encrypted_data()->mutable_ciphertext() =
+        std::move(*request.mutable_payload());
+    callback(SuccessExecutionResult(), std::move(response));
+    return absl::OkStatus();
+  }
+
+  absl::Status AeadDecrypt(
+      AeadDecryptRequest request,
+      Callback<AeadDecryptResponse> callback) noexcept override {
+    AeadDecryptResponse response;
+    *response.mutable_payload() =
+        std::move(*request.mutable_encrypted_data()->mutable_ciphertext());
+    callback(SuccessExecutionResult(), std::move(response));
+    return absl::OkStatus();
+  }
+};
+
+void SetBytesAllocatedCounter(benchmark::State& state, int64_t start) {
+  state.counters["bytes_allocated"] = benchmark::Counter(
+      allocated_bytes.load(std::memory_order_relaxed) - start,
+      benchmark::Counter::kAvgIterations);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Serializes a response payload, encrypts it and sets the ciphertext on the
+// outgoing response, like the reactors do before finishing the RPC.
+template <bool kMoveBuffers>
+static void BM_EncryptResponse(benchmark::State& state) {
+  CryptoClientWrapper crypto_client(std::make_unique<IdentityCryptoClient>());
+  const std::string serialized_response(state.range(0), 'r');
+  const int64_t start = allocated_bytes.load(std::memory_order_relaxed);
+  for (auto _ : state) {
+    std::string payload = serialized_response;
+    std::string response_ciphertext;
+    if constexpr (kMoveBuffers) {
+      absl::StatusOr<AeadEncryptResponse> encrypt_response =
+          crypto_client.AeadEncrypt(std::move(payload), kSecret);
+      response_ciphertext = std::move(
+          *encrypt_response->mutable_encrypted_data()->mutable_ciphertext());
+    } else {
+      absl::StatusOr<AeadEncryptResponse> encrypt_response =
+          crypto_client.AeadEncrypt(payload, kSecret);
+      response_ciphertext = encrypt_response->encrypted_data().ciphertext();
+    }
+    benchmark::DoNotOptimize(response_ciphertext.data());
+  }
+  SetBytesAllocatedCounter(state, start);
+}
+
+// Decrypts a received response ciphertext, like the async clients do before
+// parsing the raw response.
+template <bool kMoveBuffers>
+static void BM_DecryptResponse(benchmark::State& state) {
+  CryptoClientWrapper crypto_client(std::make_unique<IdentityCryptoClient>());
+  const std::string received_ciphertext(state.range(0), 'c');
+  const int64_t start = allocated_bytes.load(std::memory_order_relaxed);
+  for (auto _ : state) {
+    std::string response_ciphertext = received_ciphertext;
+    absl::StatusOr<AeadDecryptResponse> decrypt_response;
+    if constexpr (kMoveBuffers) {
+      decrypt_response =
+          crypto_client.AeadDecrypt(std::move(response_ciphertext), kSecret);
+    } else {
+      decrypt_response =
+          crypto_client.AeadDecrypt(response_ciphertext, kSecret);
+    }
+    benchmark::DoNotOptimize(decrypt_response->payload().data());
+  }
+  SetBytesAllocatedCounter(state, start);
+}
+
+BENCHMARK_TEMPLATE(BM_EncryptResponse, /*kMoveBuffers=*/false)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 512 << 10);
+BENCHMARK_TEMPLATE(BM_EncryptResponse, /*kMoveBuffers=*/true)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 512 << 10);
+BENCHMARK_TEMPLATE(BM_DecryptResponse, /*kMoveBuffers=*/false)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 512 << 10);
+BENCHMARK_TEMPLATE(BM_DecryptResponse, /*kMoveBuffers=*/true)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 512 << 10);
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -46,6 +46,15 @@ class CryptoClientWrapperInterface {
   HpkeEncrypt(const google::cmrt::sdk::public_key_service::v1::PublicKey& key,
               const std::string& plaintext_payload) noexcept = 0;
 
+  // Same as above, but takes ownership of `plaintext_payload` so that it can
+  // be moved into the encryption request rather than copied.
+  virtual absl::StatusOr<
+      google::cmrt::sdk::crypto_service::v1::HpkeEncryptResponse>
+  HpkeEncrypt(const google::cmrt::sdk::public_key_service::v1::PublicKey& key,
+              std::string&& plaintext_payload) noexcept {
+    return HpkeEncrypt(key, static_cast<const std::string&>(plaintext_payload));
+  }
+
   // Encrypts plaintext payload using AEAD and a secret derived from the HPKE
   // decrypt operation.
   virtual absl::StatusOr<
@@ -53,12 +62,29 @@ class CryptoClientWrapperInterface {
   AeadEncrypt(const std::string& plaintext_payload,
               const std::string& secret) noexcept = 0;
 
+  // Same as above, but takes ownership of `plaintext_payload`.
+  virtual absl::StatusOr<
+      google::cmrt::sdk::crypto_service::v1::AeadEncryptResponse>
+  AeadEncrypt(std::string&& plaintext_payload,
+              const std::string& secret) noexcept {
+    return AeadEncrypt(static_cast<const std::string&>(plaintext_payload),
+                       secret);
+  }
+
   // Decrypts a ciphertext using AEAD and a secret derived from the HPKE
   // encrypt operation.
   virtual absl::StatusOr<
       google::cmrt::sdk::crypto_service::v1::AeadDecryptResponse>
   AeadDecrypt(const std::string& ciphertext,
               const std::string& secret) noexcept = 0;
+
+  // Same as above, but takes ownership of `ciphertext`, e.g. when the
+  // ciphertext is moved out of a response that is no longer needed.
+  virtual absl::StatusOr<
+      google::cmrt::sdk::crypto_service::v1::AeadDecryptResponse>
+  AeadDecrypt(std::string&& ciphertext, const std::string& secret) noexcept {
+    return AeadDecrypt(static_cast<const std::string&>(ciphertext), secret);
+  }
 };
 
 }  // namespace privacy_sandbox::bidding_auction_servers
@@ -268,5 +268,45 @@ TEST(CryptoClientWrapperTest, AeadDecrypt_Success) {
       *actual_response, mock_response));
 }
 
+TEST(CryptoClientWrapperTest, AeadEncrypt_MovesPlaintextIntoRequest) {
+  // Long enough to not fit in the small string buffer.
+  std::string plaintext(1024, 'p');
+  const char* plaintext_data = plaintext.data();
+
+  std::unique_ptr<MockCryptoClientProvider> mock_crypto_client =
+      std::make_unique<MockCryptoClientProvider>();
+  EXPECT_CALL(*mock_crypto_client, AeadEncrypt)
+      .WillOnce([plaintext_data](
+                    const AeadEncryptRequest& request,
+                    const Callback<AeadEncryptResponse>& callback) {
+        EXPECT_EQ(request.payload().data(), plaintext_data);
+        callback(SuccessExecutionResult(), AeadEncryptResponse());
+        return absl::OkStatus();
+      });
+  CryptoClientWrapper crypto_client(std::move(mock_crypto_client));
+
+  EXPECT_TRUE(crypto_client.AeadEncrypt(std::move(plaintext), "secret").ok());
+}
+
+TEST(CryptoClientWrapperTest, AeadDecrypt_MovesCiphertextIntoRequest) {
+  std::string ciphertext(1024, 'c');
+  const char* ciphertext_data = ciphertext.data();
+
+  std::unique_ptr<MockCryptoClientProvider> mock_crypto_client =
+      std::make_unique<MockCryptoClientProvider>();
+  EXPECT_CALL(*mock_crypto_client, AeadDecrypt)
+      .WillOnce([ciphertext_data](
+                    const AeadDecryptRequest& request,
+                    const Callback<AeadDecryptResponse>& callback) {
+        EXPECT_EQ(request.encrypted_data().ciphertext().data(),
+                  ciphertext_data);
+        callback(SuccessExecutionResult(), AeadDecryptResponse());
+        return absl::OkStatus();
+      });
+  CryptoClientWrapper crypto_client(std::move(mock_crypto_client));
+
+  EXPECT_TRUE(crypto_client.AeadDecrypt(std::move(ciphertext), "secret").ok());
+}
+
 }  // namespace
 }  // namespace privacy_sandbox::bidding_auction_servers
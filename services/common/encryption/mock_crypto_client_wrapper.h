@@ -32,6 +32,10 @@ class MockCryptoClientWrapper : public CryptoClientWrapperInterface {
  public:
   virtual ~MockCryptoClientWrapper() = default;
 
+  using CryptoClientWrapperInterface::AeadDecrypt;
+  using CryptoClientWrapperInterface::AeadEncrypt;
+  using CryptoClientWrapperInterface::HpkeEncrypt;
+
   // NOLINTNEXTLINE
   MOCK_METHOD(absl::StatusOr<
                   google::cmrt::sdk::crypto_service::v1::HpkeEncryptResponse>,
@@ -382,6 +382,15 @@ inline constexpr server_common::metrics::Definition<
         "Time taken by Roma callback to execute inference",
         server_common::metrics::kTimeHistogram, 300, 0);
 
+inline constexpr server_common::metrics::Definition<
+    int, server_common::metrics::Privacy::kImpacting,
+    server_common::metrics::Instrument::kHistogram>
+    kBiddingInferenceBatchSize(
+        "bidding.inference.request.batch_size",
+        "Number of inference requests sent to the inference sidecar in the "
+        "same Predict RPC as the requests of a Roma callback",
+        kCountHistogram, 1'000, 1);
+
 inline constexpr server_common::metrics::Definition<
     double, server_common::metrics::Privacy::kNonImpacting,
     server_common::metrics::Instrument::kGauge>
@@ -456,6 +465,87 @@ inline constexpr server_common::metrics::Definition<
                     "Blob fetch and load status: 0 means success, positive "
                     "numbers map to absl error status codes.");
 
+inline constexpr server_common::metrics::Definition<
+    double, server_common::metrics::Privacy::kNonImpacting,
+    server_common::metrics::Instrument::kGauge>
+    kBfeKvCacheHitRatio(
+        "bfe.kv_cache.hit_ratio",
+        "Ratio of buyer KV keys served from the BFE KV cache since the "
+        "previous observation");
+
+inline constexpr server_common::metrics::Definition<
+    double, server_common::metrics::Privacy::kNonImpacting,
+    server_common::metrics::Instrument::kGauge>
+    kBfeKvCachePassThroughLookups(
+        "bfe.kv_cache.pass_through_lookups",
+        "Number of buyer KV lookups passed through the BFE KV cache unchanged "
+        "since the previous observation");
+
+inline constexpr server_common::metrics::Definition<
+    double, server_common::metrics::Privacy::kNonImpacting,
+    server_common::metrics::Instrument::kGauge>
+    kSfeScoringSignalsCacheHitRatio(
+        "sfe.scoring_signals_cache.hit_ratio",
+        "Ratio of render URLs whose scoring signals were served from the SFE "
+        "scoring signals cache since the previous observation");
+
+inline constexpr server_common::metrics::Definition<
+    double, server_common::metrics::Privacy::kNonImpacting,
+    server_common::metrics::Instrument::kGauge>
+    kSfeScoringSignalsCacheCoalesceRatio(
+        "sfe.scoring_signals_cache.coalesce_ratio",
+        "Ratio of render URLs whose scoring signals were served by a fetch "
+        "already in flight for another auction since the previous "
+        "observation");
+
+inline constexpr server_common::metrics::Definition<
+    double, server_common::metrics::Privacy::kNonImpacting,
+    server_common::metrics::Instrument::kGauge>
+    kSfeScoringSignalsCacheBytesSaved(
+        "sfe.scoring_signals_cache.bytes_saved",
+        "Bytes of scoring signals not fetched from the seller KV server thanks "
+        "to the SFE scoring signals cache since the previous observation");
+
+inline constexpr server_common::metrics::Definition<
+    double, server_common::metrics::Privacy::kNonImpacting,
+    server_common::metrics::Instrument::kGauge>
+    kHttpSingleFlightCoalescedRequests(
+        "http.single_flight.coalesced_requests",
+        "Number of HTTP GET requests attached to an identical in-flight "
+        "transfer since the previous observation");
+
+inline constexpr server_common::metrics::Definition<
+    double, server_common::metrics::Privacy::kNonImpacting,
+    server_common::metrics::Instrument::kGauge>
+    kHttpSingleFlightCoalesceRatio(
+        "http.single_flight.coalesce_ratio",
+        "Ratio of HTTP GET requests attached to an identical in-flight "
+        "transfer since the previous observation");
+
+inline constexpr server_common::metrics::Definition<
+    double, server_common::metrics::Privacy::kNonImpacting,
+    server_common::metrics::Instrument::kGauge>
+    kHttpConnectionReuseRatio(
+        "http.connection.reuse_ratio",
+        "Ratio of curl transfers that reused an open connection since the "
+        "previous observation");
+
+inline constexpr server_common::metrics::Definition<
+    double, server_common::metrics::Privacy::kNonImpacting,
+    server_common::metrics::Instrument::kGauge>
+    kHttpTlsHandshakeRate(
+        "http.connection.tls_handshakes_per_second",
+        "TLS handshakes per second performed by the curl fetchers since the "
+        "previous observation");
+
+inline constexpr server_common::metrics::Definition<
+    double, server_common::metrics::Privacy::kNonImpacting,
+    server_common::metrics::Instrument::kGauge>
+    kHttpHostQueueDelayMs(
+        "http.connection.host_queue_delay_ms",
+        "Average time in milliseconds curl transfers to a host waited for a "
+        "connection since the previous observation");
+
 inline constexpr server_common::metrics::Definition<
     int, server_common::metrics::Privacy::kImpacting,
     server_common::metrics::Instrument::kHistogram>
@@ -746,6 +836,34 @@ inline constexpr server_common::metrics::Definition<
         /*upper_bound*/ 30'000,
         /*lower_bound*/ 0);
 
+inline constexpr server_common::metrics::Definition<
+    int, server_common::metrics::Privacy::kImpacting,
+    server_common::metrics::Instrument::kPartitionedCounter>
+    kSfeInitiatedRequestHedgedCountByBuyer(
+        /*name*/ "sfe.initiated_request.to_bfe.hedged_count",
+        /*description*/
+        "Total number of hedged requests sent per buyer after the buyer's "
+        "request outlasted the buyer's latency percentile",
+        /*partition_type*/ "buyer",
+        /*max_partitions_contributed*/ kMaxBuyersSolicited,
+        /*public_partitions*/ server_common::metrics::kEmptyPublicPartition,
+        /*upper_bound*/ 1,
+        /*lower_bound*/ 0);
+
+inline constexpr server_common::metrics::Definition<
+    int, server_common::metrics::Privacy::kImpacting,
+    server_common::metrics::Instrument::kPartitionedCounter>
+    kSfeInitiatedRequestCutoffCountByBuyer(
+        /*name*/ "sfe.initiated_request.to_bfe.cutoff_count",
+        /*description*/
+        "Total number of requests per buyer abandoned to close the auction "
+        "within the remaining request budget",
+        /*partition_type*/ "buyer",
+        /*max_partitions_contributed*/ kMaxBuyersSolicited,
+        /*public_partitions*/ server_common::metrics::kEmptyPublicPartition,
+        /*upper_bound*/ 1,
+        /*lower_bound*/ 0);
+
 inline constexpr server_common::metrics::Definition<
     int, server_common::metrics::Privacy::kNonImpacting,
     server_common::metrics::Instrument::kPartitionedCounter>
@@ -1047,6 +1165,7 @@ inline constexpr const server_common::metrics::DefinitionName*
         &kBiddingErrorCountByErrorCode,
         &kBiddingBidRejectedCount,
         &kBiddingInferenceRequestDuration,
+        &kBiddingInferenceBatchSize,
         &kInferenceCloudFetchSuccessCount,
         &kInferenceCloudFetchFailedCountByStatus,
         &kInferenceRecentModelRegistrationSuccess,
@@ -1107,6 +1226,13 @@ inline constexpr const server_common::metrics::DefinitionName*
         &kComponentAdsSize,
         &kIGCount,
         &kPercentIgsFiltered,
+        &kBfeKvCacheHitRatio,
+        &kBfeKvCachePassThroughLookups,
+        &kHttpSingleFlightCoalescedRequests,
+        &kHttpSingleFlightCoalesceRatio,
+        &kHttpConnectionReuseRatio,
+        &kHttpTlsHandshakeRate,
+        &kHttpHostQueueDelayMs,
 };
 
 template <>
@@ -1137,6 +1263,8 @@ inline constexpr const server_common::metrics::DefinitionName*
         &kSfeInitiatedRequestCountByBuyer,
         &kSfeInitiatedResponseSizeByBuyer,
         &kSfeInitiatedRequestSizeByBuyer,
+        &kSfeInitiatedRequestHedgedCountByBuyer,
+        &kSfeInitiatedRequestCutoffCountByBuyer,
         &kInitiatedRequestKVDuration,
         &kInitiatedRequestCountByServer,
         &kInitiatedRequestAuctionDuration,
@@ -1158,6 +1286,14 @@ inline constexpr const server_common::metrics::DefinitionName*
         &kNonKAnonCacheHitPercentage,
         &kKAnonOverallQueryDuration,
         &kRequestAgeSeconds,
+        &kSfeScoringSignalsCacheHitRatio,
+        &kSfeScoringSignalsCacheCoalesceRatio,
+        &kSfeScoringSignalsCacheBytesSaved,
+        &kHttpSingleFlightCoalescedRequests,
+        &kHttpSingleFlightCoalesceRatio,
+        &kHttpConnectionReuseRatio,
+        &kHttpTlsHandshakeRate,
+        &kHttpHostQueueDelayMs,
 };
 
 template <>
@@ -1370,6 +1506,10 @@ inline void AddBuyerPartition(
                                 buyer_list_view);
   telemetry_config.SetPartition(metric::kSfeInitiatedResponseSizeByBuyer.name_,
                                 buyer_list_view);
+  telemetry_config.SetPartition(
+      metric::kSfeInitiatedRequestHedgedCountByBuyer.name_, buyer_list_view);
+  telemetry_config.SetPartition(
+      metric::kSfeInitiatedRequestCutoffCountByBuyer.name_, buyer_list_view);
 }
 
 inline void AddModelPartition(
@@ -135,6 +135,9 @@ class EgressSchemaCacheMock : public EgressSchemaCache {
 
   MOCK_METHOD(absl::StatusOr<EgressSchemaData>, Get, (absl::string_view),
               (override));
+
+  MOCK_METHOD(absl::StatusOr<CompiledEgressSchema>, GetPlan,
+              (absl::string_view), (override));
 };
 
 class CddlSpecCacheMock : public CddlSpecCache {
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "services/common/util/cache_key_util.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+TEST(AppendCacheKeyFieldTest, PrefixesFieldsWithTheirSize) {
+  std::string key;
+  AppendCacheKeyField("ab", key);
+  AppendCacheKeyField("", key);
+  AppendCacheKeyField("c", key);
+  EXPECT_EQ(key, "2:ab0:1:c");
+}
+
+TEST(AppendCacheKeyFieldTest, KeysOfDifferentFieldsDontCollide) {
+  std::string key_1;
+  AppendCacheKeyField("ab", key_1);
+  std::string key_2;
+  AppendCacheKeyField("a", key_2);
+  AppendCacheKeyField("b", key_2);
+  EXPECT_NE(key_1, key_2);
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,199 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "services/common/util/cbor_reader.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+// Additional information values (RFC 8949, section 3).
+inline constexpr uint8_t kMaxDirectArgument = 23;
+inline constexpr uint8_t kOneByteArgument = 24;
+inline constexpr uint8_t kEightByteArgument = 27;
+inline constexpr uint8_t kIndefiniteLength = 31;
+
+// Simple values for booleans.
+inline constexpr uint8_t kSimpleFalse = 20;
+inline constexpr uint8_t kSimpleTrue = 21;
+
+}  // namespace
+
+absl::StatusOr<CborMajorType> CborReader::PeekType() const {
+  if (AtEnd()) {
+    return absl::OutOfRangeError("Unexpected end of CBOR input");
+  }
+  return static_cast<CborMajorType>(
+      static_cast<uint8_t>(data_[position_]) >> 5);
+}
+
+absl::StatusOr<CborReader::Header> CborReader::ReadHeader() {
+  if (AtEnd()) {
+    return absl::OutOfRangeError("Unexpected end of CBOR input");
+  }
+  const uint8_t initial_byte = static_cast<uint8_t>(data_[position_++]);
+  Header header = {.type = static_cast<CborMajorType>(initial_byte >> 5),
+                   .info = static_cast<uint8_t>(initial_byte & 0x1f),
+                   .argument = 0};
+  if (header.info <= kMaxDirectArgument) {
+    header.argument = header.info;
+    return header;
+  }
+  if (header.info == kIndefiniteLength) {
+    return absl::UnimplementedError(
+        "Indefinite-length CBOR items are not supported");
+  }
+  if (header.info > kEightByteArgument) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Reserved CBOR additional information: ", header.info));
+  }
+
+  // 24 => 1 byte, 25 => 2 bytes, 26 => 4 bytes, 27 => 8 bytes.
+  const size_t num_bytes = size_t{1} << (header.info - kOneByteArgument);
+  if (data_.size() - position_ < num_bytes) {
+    return absl::OutOfRangeError("Truncated CBOR item header");
+  }
+  for (size_t i = 0; i < num_bytes; ++i) {
+    header.argument = (header.argument << 8) |
+                      static_cast<uint8_t>(data_[position_ + i]);
+  }
+  position_ += num_bytes;
+  return header;
+}
+
+absl::StatusOr<uint64_t> CborReader::ReadArgument(
+    CborMajorType expected_type) {
+  const size_t start = position_;
+  absl::StatusOr<Header> header = ReadHeader();
+  if (!header.ok()) {
+    position_ = start;
+    return header.status();
+  }
+  if (header->type != expected_type) {
+    position_ = start;
+    return absl::InvalidArgumentError(
+        absl::StrCat("Unexpected CBOR major type: ",
+                     static_cast<int>(header->type),
+                     ", expected: ", static_cast<int>(expected_type)));
+  }
+  return header->argument;
+}
+
+absl::StatusOr<uint64_t> CborReader::ReadInt() {
+  absl::StatusOr<CborMajorType> type = PeekType();
+  if (!type.ok()) {
+    return type.status();
+  }
+  if (*type == CborMajorType::kNegativeInt) {
+    return ReadArgument(CborMajorType::kNegativeInt);
+  }
+  return ReadArgument(CborMajorType::kUnsignedInt);
+}
+
+absl::StatusOr<bool> CborReader::ReadBool() {
+  const size_t start = position_;
+  absl::StatusOr<Header> header = ReadHeader();
+  if (header.ok() && header->type == CborMajorType::kSimpleOrFloat &&
+      (header->info == kSimpleFalse || header->info == kSimpleTrue)) {
+    return header->info == kSimpleTrue;
+  }
+  position_ = start;
+  if (!header.ok()) {
+    return header.status();
+  }
+  return absl::InvalidArgumentError("CBOR item is not a boolean");
+}
+
+absl::StatusOr<absl::string_view> CborReader::ReadString(
+    CborMajorType expected_type) {
+  const size_t start = position_;
+  absl::StatusOr<uint64_t> length = ReadArgument(expected_type);
+  if (!length.ok()) {
+    return length.status();
+  }
+  if (data_.size() - position_ < *length) {
+    position_ = start;
+    return absl::OutOfRangeError("Truncated CBOR string");
+  }
+  absl::string_view value = data_.substr(position_, *length);
+  position_ += *length;
+  return value;
+}
+
+absl::StatusOr<absl::string_view> CborReader::ReadTextString() {
+  return ReadString(CborMajorType::kTextString);
+}
+
+absl::StatusOr<absl::string_view> CborReader::ReadByteString() {
+  return ReadString(CborMajorType::kByteString);
+}
+
+absl::StatusOr<uint64_t> CborReader::ReadArrayHeader() {
+  return ReadArgument(CborMajorType::kArray);
+}
+
+absl::StatusOr<uint64_t> CborReader::ReadMapHeader() {
+  return ReadArgument(CborMajorType::kMap);
+}
+
+absl::Status CborReader::SkipItem() {
+  // Iterates instead of recursing, so that deeply nested inputs can't exhaust
+  // the stack. Every item takes at least one byte, which bounds the number of
+  // pending items by the size of the remaining input.
+  uint64_t pending_items = 1;
+  while (pending_items > 0) {
+    absl::StatusOr<Header> header = ReadHeader();
+    if (!header.ok()) {
+      return header.status();
+    }
+    --pending_items;
+
+    const uint64_t remaining = data_.size() - position_;
+    switch (header->type) {
+      case CborMajorType::kUnsignedInt:
+      case CborMajorType::kNegativeInt:
+      case CborMajorType::kSimpleOrFloat:
+        break;
+      case CborMajorType::kByteString:
+      case CborMajorType::kTextString:
+        if (remaining < header->argument) {
+          return absl::OutOfRangeError("Truncated CBOR string");
+        }
+        position_ += header->argument;
+        break;
+      case CborMajorType::kArray:
+        if (remaining < header->argument) {
+          return absl::OutOfRangeError("Truncated CBOR array");
+        }
+        pending_items += header->argument;
+        break;
+      case CborMajorType::kMap:
+        if (remaining / 2 < header->argument) {
+          return absl::OutOfRangeError("Truncated CBOR map");
+        }
+        pending_items += 2 * header->argument;
+        break;
+      case CborMajorType::kTag:
+        ++pending_items;
+        break;
+    }
+    if (pending_items > data_.size() - position_) {
+      return absl::OutOfRangeError("Truncated CBOR input");
+    }
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERVICES_COMMON_UTIL_CBOR_READER_H_
+#define SERVICES_COMMON_UTIL_CBOR_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// CBOR major types (RFC 8949, section 3.1).
+enum class CborMajorType : uint8_t {
+  kUnsignedInt = 0,
+  kNegativeInt = 1,
+  kByteString = 2,
+  kTextString = 3,
+  kArray = 4,
+  kMap = 5,
+  kTag = 6,
+  kSimpleOrFloat = 7,
+};
+
+// Single-pass pull reader over a CBOR encoded buffer.
+//
+// Unlike `cbor_load`, the reader doesn't build an item tree: items are read in
+// encoding order and strings are returned as views into the input buffer, so
+// the buffer must outlive the returned views. Only definite-length items are
+// supported; indefinite-length items yield an `UnimplementedError` so that
+// callers can fall back to libcbor for them.
+class CborReader {
+ public:
+  explicit CborReader(absl::string_view data) : data_(data) {}
+
+  // Returns the major type of the next item without consuming it.
+  absl::StatusOr<CborMajorType> PeekType() const;
+
+  // Reads an unsigned or negative integer and returns its encoded argument.
+  // For negative integers, this is `-1 - value`, which mirrors what libcbor's
+  // `cbor_get_int` returns.
+  absl::StatusOr<uint64_t> ReadInt();
+
+  // Reads a boolean simple value.
+  absl::StatusOr<bool> ReadBool();
+
+  // Read a text/byte string and return a view into the underlying buffer.
+  absl::StatusOr<absl::string_view> ReadTextString();
+  absl::StatusOr<absl::string_view> ReadByteString();
+
+  // Read the header of an array/map and return the number of elements/pairs
+  // that follow it.
+  absl::StatusOr<uint64_t> ReadArrayHeader();
+  absl::StatusOr<uint64_t> ReadMapHeader();
+
+  // Skips over the next item, including all of its nested items.
+  absl::Status SkipItem();
+
+  // Number of bytes consumed from the input so far.
+  size_t position() const { return position_; }
+
+  // Whether all of the input has been consumed.
+  bool AtEnd() const { return position_ == data_.size(); }
+
+ private:
+  struct Header {
+    CborMajorType type;
+    // Additional information (low 5 bits of the initial byte).
+    uint8_t info;
+    // Argument of the item: the value for ints, the length for strings,
+    // arrays and maps, the tag number for tags.
+    uint64_t argument;
+  };
+
+  // Reads the header of the next item.
+  absl::StatusOr<Header> ReadHeader();
+
+  // Reads the header of the next item and verifies its major type.
+  absl::StatusOr<uint64_t> ReadArgument(CborMajorType expected_type);
+
+  // Reads a string of the given major type.
+  absl::StatusOr<absl::string_view> ReadString(CborMajorType expected_type);
+
+  absl::string_view data_;
+  size_t position_ = 0;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_COMMON_UTIL_CBOR_READER_H_
@@ -0,0 +1,151 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "services/common/util/cbor_reader.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "gtest/gtest.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+using ::testing::TestWithParam;
+using ::testing::ValuesIn;
+
+// Builds a string from a literal, keeping any embedded NUL bytes.
+template <size_t N>
+std::string Bytes(const char (&literal)[N]) {
+  return std::string(literal, N - 1);
+}
+
+struct IntTestCase {
+  std::string encoded;
+  uint64_t expected;
+};
+
+class CborReaderIntTest : public TestWithParam<IntTestCase> {};
+
+TEST_P(CborReaderIntTest, ReadsIntsOfAllWidths) {
+  CborReader reader(GetParam().encoded);
+  auto decoded = reader.ReadInt();
+  ASSERT_TRUE(decoded.ok()) << decoded.status();
+  EXPECT_EQ(*decoded, GetParam().expected);
+  EXPECT_TRUE(reader.AtEnd());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AllWidths, CborReaderIntTest,
+    ValuesIn(std::vector<IntTestCase>{
+        {Bytes("\x00"), 0},
+        {"\x17", 23},
+        {"\x18\x18", 24},
+        {Bytes("\x19\x01\x00"), 256},
+        {Bytes("\x1a\x00\x01\x00\x00"), 65536},
+        {Bytes("\x1b\x00\x00\x00\x01\x00\x00\x00\x00"), 4294967296ull},
+        // -20 is encoded with an argument of 19, like libcbor reports it.
+        {"\x33", 19},
+    }));
+
+TEST(CborReaderTest, ReadsStringsAsViewsIntoInput) {
+  std::string encoded = "\x65hello";
+  CborReader reader(encoded);
+  ASSERT_EQ(*reader.PeekType(), CborMajorType::kTextString);
+  auto decoded = reader.ReadTextString();
+  ASSERT_TRUE(decoded.ok()) << decoded.status();
+  EXPECT_EQ(*decoded, "hello");
+  EXPECT_EQ(decoded->data(), encoded.data() + 1);
+}
+
+TEST(CborReaderTest, ReadsByteStrings) {
+  CborReader reader("\x42\x01\x02");
+  auto decoded = reader.ReadByteString();
+  ASSERT_TRUE(decoded.ok()) << decoded.status();
+  EXPECT_EQ(*decoded, "\x01\x02");
+}
+
+TEST(CborReaderTest, ReadsBools) {
+  CborReader reader("\xf5\xf4");
+  EXPECT_TRUE(*reader.ReadBool());
+  EXPECT_FALSE(*reader.ReadBool());
+  EXPECT_TRUE(reader.AtEnd());
+}
+
+TEST(CborReaderTest, ReadsMapsAndArrays) {
+  // {"key": [1, 2]}
+  CborReader reader("\xa1\x63key\x82\x01\x02");
+  EXPECT_EQ(*reader.ReadMapHeader(), 1);
+  EXPECT_EQ(*reader.ReadTextString(), "key");
+  EXPECT_EQ(*reader.ReadArrayHeader(), 2);
+  EXPECT_EQ(*reader.ReadInt(), 1);
+  EXPECT_EQ(*reader.ReadInt(), 2);
+  EXPECT_TRUE(reader.AtEnd());
+}
+
+TEST(CborReaderTest, TypeMismatchDoesNotConsumeInput) {
+  CborReader reader("\x65value");
+  EXPECT_EQ(reader.ReadInt().status().code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(reader.ReadBool().status().code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(reader.ReadMapHeader().status().code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(reader.position(), 0);
+  EXPECT_EQ(*reader.ReadTextString(), "value");
+}
+
+TEST(CborReaderTest, SkipsNestedItems) {
+  // [{"nested": 1(7)}, 1.5 (half float)] followed by "next".
+  std::string encoded =
+      Bytes("\x82\xa1\x66nested\xc1\x07\xf9\x3e\x00\x64next");
+  CborReader reader(encoded);
+  ASSERT_TRUE(reader.SkipItem().ok());
+  EXPECT_EQ(*reader.ReadTextString(), "next");
+  EXPECT_TRUE(reader.AtEnd());
+}
+
+TEST(CborReaderTest, RejectsTruncatedInput) {
+  CborReader reader("\x6atruncated");
+  EXPECT_EQ(reader.ReadTextString().status().code(),
+            absl::StatusCode::kOutOfRange);
+  EXPECT_EQ(reader.SkipItem().code(), absl::StatusCode::kOutOfRange);
+
+  // Array header claiming more items than there are bytes left.
+  CborReader array_reader("\x9a\x7f\xff\xff\xff");
+  EXPECT_EQ(array_reader.SkipItem().code(), absl::StatusCode::kOutOfRange);
+
+  CborReader empty_reader("");
+  EXPECT_EQ(empty_reader.PeekType().status().code(),
+            absl::StatusCode::kOutOfRange);
+}
+
+TEST(CborReaderTest, RejectsIndefiniteLengthItems) {
+  // Indefinite-length array holding a single 0, followed by "break".
+  std::string encoded = Bytes("\x9f\x00\xff");
+  CborReader reader(encoded);
+  EXPECT_EQ(reader.ReadArrayHeader().status().code(),
+            absl::StatusCode::kUnimplemented);
+  EXPECT_EQ(reader.SkipItem().code(), absl::StatusCode::kUnimplemented);
+}
+
+TEST(CborReaderTest, RejectsReservedAdditionalInformation) {
+  CborReader reader("\x1c");
+  EXPECT_EQ(reader.ReadInt().status().code(),
+            absl::StatusCode::kInvalidArgument);
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,301 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "services/common/util/cbor_writer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "absl/log/check.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+// Initial bytes of the fixed width simple values and floats.
+inline constexpr uint8_t kFalse = 0xf4;
+inline constexpr uint8_t kTrue = 0xf5;
+inline constexpr uint8_t kHalfFloat = 0xf9;
+inline constexpr uint8_t kSingleFloat = 0xfa;
+inline constexpr uint8_t kDoubleFloat = 0xfb;
+
+inline constexpr uint8_t kMaxDirectArgument = 23;
+
+// Returns the number of bytes following the initial byte that are needed to
+// encode the argument.
+size_t ArgumentSize(uint64_t argument) {
+  if (argument <= kMaxDirectArgument) {
+    return 0;
+  } else if (argument <= std::numeric_limits<uint8_t>::max()) {
+    return 1;
+  } else if (argument <= std::numeric_limits<uint16_t>::max()) {
+    return 2;
+  } else if (argument <= std::numeric_limits<uint32_t>::max()) {
+    return 4;
+  }
+  return 8;
+}
+
+// Writes the initial byte and argument at `out`, which must have room for
+// `1 + ArgumentSize(argument)` bytes.
+void EncodeHeader(CborMajorType type, uint64_t argument, char* out) {
+  const uint8_t major_type = static_cast<uint8_t>(type) << 5;
+  const size_t argument_size = ArgumentSize(argument);
+  switch (argument_size) {
+    case 0:
+      out[0] = static_cast<char>(major_type | argument);
+      return;
+    case 1:
+      out[0] = static_cast<char>(major_type | 24);
+      break;
+    case 2:
+      out[0] = static_cast<char>(major_type | 25);
+      break;
+    case 4:
+      out[0] = static_cast<char>(major_type | 26);
+      break;
+    default:
+      out[0] = static_cast<char>(major_type | 27);
+  }
+  for (size_t i = 0; i < argument_size; ++i) {
+    out[argument_size - i] = static_cast<char>(argument >> (8 * i));
+  }
+}
+
+// Mirrors `_cbor_encode_half` from libcbor 0.10, which truncates the
+// significand instead of rounding it.
+uint16_t ToHalfFloatBits(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint16_t sign = (bits & 0x80000000u) >> 16u;
+  const uint8_t exponent = (bits & 0x7F800000u) >> 23u;
+  const uint32_t mantissa = bits & 0x7FFFFFu;
+  if (exponent == 0xFF) {  // Infinity or NaN.
+    if (std::isnan(value)) {
+      return 0x7e00;
+    }
+    return sign | 0x7C00u | (mantissa ? 1u : 0u) << 15u;
+  } else if (exponent == 0) {  // Zeroes and subnormals.
+    return sign | mantissa >> 13u;
+  }
+
+  const int8_t logical_exponent = static_cast<int8_t>(exponent - 127);
+  if (logical_exponent < -24) {
+    return 0;
+  } else if (logical_exponent < -14) {
+    return sign | static_cast<uint16_t>(1u << (24 + logical_exponent));
+  }
+  return sign | (static_cast<uint8_t>(logical_exponent) + 15u) << 10u |
+         mantissa >> 13u;
+}
+
+// Mirrors `_cbor_decode_half` from libcbor.
+float FromHalfFloatBits(uint16_t half) {
+  const int exponent = (half >> 10) & 0x1f;
+  const int mantissa = half & 0x3ff;
+  double value;
+  if (exponent == 0) {
+    value = std::ldexp(mantissa, -24);
+  } else if (exponent != 31) {
+    value = std::ldexp(mantissa + 1024, exponent - 25);
+  } else {
+    value = mantissa == 0 ? INFINITY : NAN;
+  }
+  return static_cast<float>(half & 0x8000 ? -value : value);
+}
+
+template <typename T, typename U>
+bool AreWithinEpsilon(T a, U b) {
+  return std::fabs(a - b) < std::numeric_limits<double>::epsilon();
+}
+
+}  // namespace
+
+CborWriter::CborWriter(size_t expected_size) { output_.reserve(expected_size); }
+
+void CborWriter::CountItem() {
+  if (!open_containers_.empty()) {
+    ++open_containers_.back().num_items;
+  }
+}
+
+void CborWriter::WriteHeader(CborMajorType type, uint64_t argument) {
+  CountItem();
+  const size_t position = output_.size();
+  output_.resize(position + 1 + ArgumentSize(argument));
+  EncodeHeader(type, argument, output_.data() + position);
+}
+
+void CborWriter::WriteUint(uint64_t value) {
+  WriteHeader(CborMajorType::kUnsignedInt, value);
+}
+
+void CborWriter::WriteInt(int64_t value) {
+  if (value < 0) {
+    // -1 - value, without overflowing for the minimum value.
+    WriteHeader(CborMajorType::kNegativeInt, ~static_cast<uint64_t>(value));
+    return;
+  }
+  WriteUint(value);
+}
+
+void CborWriter::WriteBool(bool value) {
+  CountItem();
+  output_.push_back(static_cast<char>(value ? kTrue : kFalse));
+}
+
+void CborWriter::WriteString(CborMajorType type, absl::string_view value) {
+  WriteHeader(type, value.size());
+  output_.append(value.data(), value.size());
+}
+
+void CborWriter::WriteTextString(absl::string_view value) {
+  WriteString(CborMajorType::kTextString, value);
+}
+
+void CborWriter::WriteByteString(absl::string_view value) {
+  WriteString(CborMajorType::kByteString, value);
+}
+
+void CborWriter::WriteFloat(double value) {
+  CountItem();
+  const float single = static_cast<float>(value);
+  if (!AreWithinEpsilon(value, single)) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    output_.push_back(static_cast<char>(kDoubleFloat));
+    for (int shift = 56; shift >= 0; shift -= 8) {
+      output_.push_back(static_cast<char>(bits >> shift));
+    }
+    return;
+  }
+
+  const uint16_t half_bits = ToHalfFloatBits(single);
+  if (AreWithinEpsilon(single, FromHalfFloatBits(half_bits))) {
+    output_.push_back(static_cast<char>(kHalfFloat));
+    output_.push_back(static_cast<char>(half_bits >> 8));
+    output_.push_back(static_cast<char>(half_bits));
+    return;
+  }
+
+  uint32_t bits;
+  std::memcpy(&bits, &single, sizeof(bits));
+  output_.push_back(static_cast<char>(kSingleFloat));
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    output_.push_back(static_cast<char>(bits >> shift));
+  }
+}
+
+void CborWriter::StartContainer(CborMajorType type) {
+  CountItem();
+  open_containers_.push_back(
+      {.type = type, .header_position = output_.size()});
+  // Reserve a byte for the header, which is enough for up to 23 entries.
+  output_.push_back(0);
+}
+
+void CborWriter::EndContainer(CborMajorType type) {
+  CHECK(!open_containers_.empty()) << "No open container to end";
+  const Container container = open_containers_.back();
+  open_containers_.pop_back();
+  CHECK(container.type == type) << "Mismatched container end";
+
+  uint64_t num_entries = container.num_items;
+  if (type == CborMajorType::kMap) {
+    CHECK(num_entries % 2 == 0) << "Map has a key without a value";
+    num_entries /= 2;
+  }
+  if (ArgumentSize(num_entries) > 0) {
+    // Inserting the extra bytes now would move everything written after the
+    // header, again for every enclosing container that needs to be widened.
+    wide_headers_.push_back({.type = type,
+                             .header_position = container.header_position,
+                             .num_entries = num_entries});
+    return;
+  }
+  EncodeHeader(type, num_entries, output_.data() + container.header_position);
+}
+
+void CborWriter::StartArray() { StartContainer(CborMajorType::kArray); }
+
+void CborWriter::StartMap() { StartContainer(CborMajorType::kMap); }
+
+void CborWriter::EndArray() { EndContainer(CborMajorType::kArray); }
+
+void CborWriter::EndMap() { EndContainer(CborMajorType::kMap); }
+
+CborWriter::Checkpoint CborWriter::GetCheckpoint() const {
+  return {.size = output_.size(),
+          .num_open_containers = open_containers_.size(),
+          .num_items = num_items()};
+}
+
+void CborWriter::Rollback(const Checkpoint& checkpoint) {
+  CHECK_LE(checkpoint.num_open_containers, open_containers_.size())
+      << "Container of the checkpoint has already been ended";
+  output_.resize(checkpoint.size);
+  open_containers_.resize(checkpoint.num_open_containers);
+  wide_headers_.erase(std::remove_if(wide_headers_.begin(), wide_headers_.end(),
+                                     [&checkpoint](const WideHeader& header) {
+                                       return header.header_position >=
+                                              checkpoint.size;
+                                     }),
+                      wide_headers_.end());
+  if (!open_containers_.empty()) {
+    open_containers_.back().num_items = checkpoint.num_items;
+  }
+}
+
+uint64_t CborWriter::num_items() const {
+  return open_containers_.empty() ? 0 : open_containers_.back().num_items;
+}
+
+void CborWriter::WidenHeaders() {
+  if (wide_headers_.empty()) {
+    return;
+  }
+  // Containers are ended innermost first, so the headers aren't in order.
+  std::sort(wide_headers_.begin(), wide_headers_.end(),
+            [](const WideHeader& a, const WideHeader& b) {
+              return a.header_position < b.header_position;
+            });
+  size_t shift = 0;
+  for (const WideHeader& header : wide_headers_) {
+    shift += ArgumentSize(header.num_entries);
+  }
+  size_t end = output_.size();
+  output_.resize(end + shift);
+  char* data = output_.data();
+  // Moves each run of bytes between two wide headers once, from the last run
+  // to the first, by the total width added by the headers before it.
+  for (auto it = wide_headers_.rbegin(); it != wide_headers_.rend(); ++it) {
+    const size_t run_start = it->header_position + 1;
+    std::memmove(data + run_start + shift, data + run_start, end - run_start);
+    shift -= ArgumentSize(it->num_entries);
+    EncodeHeader(it->type, it->num_entries,
+                 data + it->header_position + shift);
+    end = it->header_position;
+  }
+  wide_headers_.clear();
+}
+
+std::string CborWriter::Release() && {
+  CHECK(open_containers_.empty()) << "Not all containers have been ended";
+  WidenHeaders();
+  return std::move(output_);
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERVICES_COMMON_UTIL_CBOR_WRITER_H_
+#define SERVICES_COMMON_UTIL_CBOR_WRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "services/common/util/cbor_reader.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// Streaming writer for CBOR with definite lengths and minimally encoded
+// arguments, i.e. the same encoding that `cbor_serialize` produces for items
+// built with libcbor's definite-length builders.
+//
+// Items are appended to a single output buffer as they are written, so no
+// intermediate item tree is allocated. The number of entries in arrays and
+// maps doesn't need to be known when they are started: a one byte header is
+// reserved and patched once the container is ended. Headers of containers
+// with more than 23 entries need more bytes: they are widened when the output
+// is released, all in a single pass over it.
+//
+// Map entries are written in the order of the calls; callers are responsible
+// for writing keys in the required (e.g. canonical) order.
+class CborWriter {
+ public:
+  // Marks a point in the output that the writer can be rolled back to.
+  struct Checkpoint {
+    size_t size;
+    size_t num_open_containers;
+    uint64_t num_items;
+  };
+
+  // `expected_size` is reserved up front in the output buffer.
+  explicit CborWriter(size_t expected_size = 0);
+
+  void WriteUint(uint64_t value);
+  void WriteInt(int64_t value);
+  void WriteBool(bool value);
+  void WriteTextString(absl::string_view value);
+  void WriteByteString(absl::string_view value);
+
+  // Writes the value as a half, single or double precision float, picking the
+  // narrowest one that preserves the value to within double epsilon. This
+  // matches how `cbor_build_float` picks the width, including libcbor's
+  // conversion to half precision floats.
+  void WriteFloat(double value);
+
+  // Starts an array/map. Everything written until the matching `End` call
+  // becomes an element (or, alternating, a key and a value) of it.
+  void StartArray();
+  void StartMap();
+  void EndArray();
+  void EndMap();
+
+  // Returns a checkpoint for the current position. Rolling back to it drops
+  // everything written since, including containers started since.
+  Checkpoint GetCheckpoint() const;
+  void Rollback(const Checkpoint& checkpoint);
+
+  // Number of items written to the innermost open container so far. For maps,
+  // keys and values are counted separately.
+  uint64_t num_items() const;
+
+  // Returns the serialized output. All containers must have been ended.
+  std::string Release() &&;
+
+ private:
+  struct Container {
+    CborMajorType type;
+    // Position of the (one byte) reserved header in the output.
+    size_t header_position;
+    uint64_t num_items = 0;
+  };
+
+  // Header of an ended container that doesn't fit in its reserved byte.
+  struct WideHeader {
+    CborMajorType type;
+    size_t header_position;
+    uint64_t num_entries;
+  };
+
+  // Appends the header of an item and counts it towards the open container.
+  void WriteHeader(CborMajorType type, uint64_t argument);
+  void WriteString(CborMajorType type, absl::string_view value);
+  void StartContainer(CborMajorType type);
+  void EndContainer(CborMajorType type);
+  void CountItem();
+  // Inserts the wide headers into the output, moving every byte at most once.
+  void WidenHeaders();
+
+  std::string output_;
+  std::vector<Container> open_containers_;
+  std::vector<WideHeader> wide_headers_;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_COMMON_UTIL_CBOR_WRITER_H_
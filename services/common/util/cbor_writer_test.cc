@@ -0,0 +1,211 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "services/common/util/cbor_writer.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "services/common/util/cbor_reader.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+using ::testing::TestWithParam;
+using ::testing::ValuesIn;
+
+// Builds a string from a literal, keeping any embedded NUL bytes.
+template <size_t N>
+std::string Bytes(const char (&literal)[N]) {
+  return std::string(literal, N - 1);
+}
+
+struct IntTestCase {
+  int64_t value;
+  std::string expected;
+};
+
+class CborWriterIntTest : public TestWithParam<IntTestCase> {};
+
+TEST_P(CborWriterIntTest, WritesMinimallyEncodedInts) {
+  CborWriter writer;
+  writer.WriteInt(GetParam().value);
+  EXPECT_EQ(std::move(writer).Release(), GetParam().expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AllWidths, CborWriterIntTest,
+    ValuesIn(std::vector<IntTestCase>{
+        {0, Bytes("\x00")},
+        {23, "\x17"},
+        {24, "\x18\x18"},
+        {256, Bytes("\x19\x01\x00")},
+        {65536, Bytes("\x1a\x00\x01\x00\x00")},
+        {4294967296ll, Bytes("\x1b\x00\x00\x00\x01\x00\x00\x00\x00")},
+        {-1, "\x20"},
+        {-500, "\x39\x01\xf3"},
+        {std::numeric_limits<int64_t>::min(),
+         "\x3b\x7f\xff\xff\xff\xff\xff\xff\xff"},
+    }));
+
+struct FloatTestCase {
+  double value;
+  std::string expected;
+};
+
+class CborWriterFloatTest : public TestWithParam<FloatTestCase> {};
+
+TEST_P(CborWriterFloatTest, WritesNarrowestPreservingFloat) {
+  CborWriter writer;
+  writer.WriteFloat(GetParam().value);
+  EXPECT_EQ(std::move(writer).Release(), GetParam().expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AllWidths, CborWriterFloatTest,
+    ValuesIn(std::vector<FloatTestCase>{
+        {1.5, Bytes("\xf9\x3e\x00")},
+        {-2, Bytes("\xf9\xc0\x00")},
+        {0, Bytes("\xf9\x00\x00")},
+        {static_cast<float>(3.14159), "\xfa\x40\x49\x0f\xd0"},
+        // Out of half precision range.
+        {100000, Bytes("\xfa\x47\xc3\x50\x00")},
+        {0.1, "\xfb\x3f\xb9\x99\x99\x99\x99\x99\x9a"},
+        // Like with libcbor, values below double epsilon collapse to zero.
+        {1e-20, Bytes("\xf9\x00\x00")},
+    }));
+
+TEST(CborWriterTest, WritesStringsAndBools) {
+  CborWriter writer;
+  writer.WriteTextString("hello");
+  writer.WriteByteString(Bytes("\x01\x00"));
+  writer.WriteBool(true);
+  writer.WriteBool(false);
+  EXPECT_EQ(std::move(writer).Release(),
+            Bytes("\x65hello\x42\x01\x00\xf5\xf4"));
+}
+
+TEST(CborWriterTest, WritesNestedContainers) {
+  // {"key": [1, 2], "empty": {}}
+  CborWriter writer;
+  writer.StartMap();
+  writer.WriteTextString("key");
+  writer.StartArray();
+  writer.WriteUint(1);
+  writer.WriteUint(2);
+  writer.EndArray();
+  writer.WriteTextString("empty");
+  writer.StartMap();
+  writer.EndMap();
+  writer.EndMap();
+  EXPECT_EQ(std::move(writer).Release(),
+            "\xa2\x63key\x82\x01\x02\x65\x65mpty\xa0");
+}
+
+TEST(CborWriterTest, WidensHeadersOfLargeContainers) {
+  CborWriter writer;
+  writer.StartArray();
+  writer.StartArray();
+  for (int i = 0; i < 300; ++i) {
+    writer.WriteUint(1);
+  }
+  writer.EndArray();
+  writer.WriteTextString("last");
+  writer.EndArray();
+  std::string encoded = std::move(writer).Release();
+
+  CborReader reader(encoded);
+  EXPECT_EQ(*reader.ReadArrayHeader(), 2);
+  EXPECT_EQ(*reader.ReadArrayHeader(), 300);
+  for (int i = 0; i < 300; ++i) {
+    EXPECT_EQ(*reader.ReadInt(), 1);
+  }
+  EXPECT_EQ(*reader.ReadTextString(), "last");
+  EXPECT_TRUE(reader.AtEnd());
+  EXPECT_EQ(encoded.substr(0, 4), Bytes("\x82\x99\x01\x2c"));
+}
+
+TEST(CborWriterTest, RollbackDropsPartiallyWrittenItems) {
+  CborWriter writer;
+  writer.StartArray();
+  writer.WriteUint(1);
+  CborWriter::Checkpoint checkpoint = writer.GetCheckpoint();
+  writer.StartMap();
+  writer.WriteTextString("dropped");
+  writer.StartArray();
+  writer.WriteUint(2);
+  writer.Rollback(checkpoint);
+  EXPECT_EQ(writer.num_items(), 1);
+  writer.WriteUint(3);
+  writer.EndArray();
+  EXPECT_EQ(std::move(writer).Release(), "\x82\x01\x03");
+}
+
+TEST(CborWriterTest, WidensHeadersOfNestedLargeContainers) {
+  // 30 maps of 25 entries each, in a map with one more entry after them.
+  CborWriter writer;
+  writer.StartMap();
+  writer.WriteTextString("maps");
+  writer.StartArray();
+  for (int i = 0; i < 30; ++i) {
+    writer.StartMap();
+    for (int j = 0; j < 25; ++j) {
+      writer.WriteUint(j);
+      writer.WriteUint(i);
+    }
+    writer.EndMap();
+  }
+  writer.EndArray();
+  writer.WriteTextString("last");
+  writer.WriteBool(true);
+  writer.EndMap();
+  std::string encoded = std::move(writer).Release();
+
+  CborReader reader(encoded);
+  EXPECT_EQ(*reader.ReadMapHeader(), 2);
+  EXPECT_EQ(*reader.ReadTextString(), "maps");
+  EXPECT_EQ(*reader.ReadArrayHeader(), 30);
+  for (int i = 0; i < 30; ++i) {
+    EXPECT_EQ(*reader.ReadMapHeader(), 25);
+    for (int j = 0; j < 25; ++j) {
+      EXPECT_EQ(*reader.ReadInt(), j);
+      EXPECT_EQ(*reader.ReadInt(), i);
+    }
+  }
+  EXPECT_EQ(*reader.ReadTextString(), "last");
+  EXPECT_TRUE(*reader.ReadBool());
+  EXPECT_TRUE(reader.AtEnd());
+}
+
+TEST(CborWriterTest, RollbackDropsWideHeadersOfDroppedContainers) {
+  CborWriter writer;
+  writer.StartArray();
+  CborWriter::Checkpoint checkpoint = writer.GetCheckpoint();
+  writer.StartArray();
+  for (int i = 0; i < 24; ++i) {
+    writer.WriteUint(1);
+  }
+  writer.EndArray();
+  writer.Rollback(checkpoint);
+  writer.WriteUint(2);
+  writer.EndArray();
+  EXPECT_EQ(std::move(writer).Release(), "\x81\x02");
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -19,6 +19,7 @@ namespace privacy_sandbox::bidding_auction_servers {
 grpc::ClientContext* ClientContexts::Add() {
   auto context = std::make_unique<grpc::ClientContext>();
   auto* context_ptr = context.get();
+  absl::MutexLock lock(&mu_);
   client_contexts_.emplace_back(std::move(context));
   return context_ptr;
 }
@@ -33,6 +34,7 @@ grpc::ClientContext* ClientContexts::Add(
 }
 
 void ClientContexts::CancelAll() {
+  absl::MutexLock lock(&mu_);
   for (const auto& context : client_contexts_) {
     context->TryCancel();
   }
@@ -24,7 +24,9 @@
 
 #include <grpcpp/grpcpp.h>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 
 namespace privacy_sandbox::bidding_auction_servers {
 
@@ -33,7 +35,8 @@ namespace privacy_sandbox::bidding_auction_servers {
 // outbound client calls for easier cancellation in case the underlying request
 // for that reactor gets cancelled.
 //
-// Not thread-safe.
+// This class is thread-safe, so that outbound calls can also be started from
+// the callbacks of other outbound calls.
 class ClientContexts {
  public:
   // Creates a context and owns it.
@@ -47,10 +50,12 @@ class ClientContexts {
       const absl::flat_hash_map<std::string, std::string>& request_metadata);
 
   // Tries to cancel all contexts that have been added
-  void CancelAll();
+  void CancelAll() ABSL_LOCKS_EXCLUDED(mu_);
 
  private:
-  std::vector<std::unique_ptr<grpc::ClientContext>> client_contexts_;
+  absl::Mutex mu_;
+  std::vector<std::unique_ptr<grpc::ClientContext>> client_contexts_
+      ABSL_GUARDED_BY(mu_);
 };
 
 }  // namespace privacy_sandbox::bidding_auction_servers
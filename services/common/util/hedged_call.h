@@ -0,0 +1,125 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERVICES_COMMON_UTIL_HEDGED_CALL_H_
+#define SERVICES_COMMON_UTIL_HEDGED_CALL_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <grpcpp/grpcpp.h>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/functional/function_ref.h"
+#include "absl/synchronization/mutex.h"
+#include "services/common/util/client_contexts.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// Races the attempts of an outbound call (the primary call and its hedges)
+// against each other and forwards the outcome of the first attempt to complete
+// to `on_done`. The other attempts are then cancelled.
+//
+// The client contexts of the attempts are owned by the HedgedCall, and each
+// attempt callback keeps the HedgedCall alive. Hence the attempts that lose
+// the race can still complete safely after the initiator of the call (e.g. a
+// reactor) is gone, as long as `on_done` has been invoked by then.
+//
+// Instances must be created with std::make_shared. This class is thread-safe.
+template <typename... Args>
+class HedgedCall : public std::enable_shared_from_this<HedgedCall<Args...>> {
+ public:
+  using OnDone = absl::AnyInvocable<void(Args...) &&>;
+
+  explicit HedgedCall(OnDone on_done) : on_done_(std::move(on_done)) {}
+
+  // Not copyable or movable.
+  HedgedCall(const HedgedCall&) = delete;
+  HedgedCall& operator=(const HedgedCall&) = delete;
+
+  // Creates the client context of a new attempt, with `request_metadata`
+  // added to it, and runs `on_added` before any attempt can complete the call.
+  // Returns nullptr without running `on_added` if the call is already
+  // completed, in which case the attempt must not be started.
+  grpc::ClientContext* AddAttempt(
+      const absl::flat_hash_map<std::string, std::string>& request_metadata,
+      absl::FunctionRef<void()> on_added = [] {}) ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    if (on_done_ == nullptr) {
+      return nullptr;
+    }
+    ++num_attempts_;
+    on_added();
+    return client_contexts_.Add(request_metadata);
+  }
+
+  // Returns the callback to start an attempt with.
+  OnDone AttemptCallback() {
+    return [self = this->shared_from_this()](Args... args) {
+      self->Complete(std::move(args)...);
+    };
+  }
+
+  // Completes the call with the given outcome, unless it is already
+  // completed. Returns whether `on_done` was invoked.
+  bool Complete(Args... args) ABSL_LOCKS_EXCLUDED(mu_) {
+    OnDone on_done = TakeOnDone();
+    if (on_done == nullptr) {
+      return false;
+    }
+    std::move(on_done)(std::move(args)...);
+    return true;
+  }
+
+  // Marks the call as completed and cancels all of its attempts, but leaves
+  // invoking the returned `on_done` to the caller. Returns nullptr if the call
+  // is already completed.
+  OnDone TakeOnDone() ABSL_LOCKS_EXCLUDED(mu_) {
+    OnDone on_done;
+    {
+      absl::MutexLock lock(&mu_);
+      on_done = std::move(on_done_);
+      on_done_ = nullptr;
+    }
+    if (on_done != nullptr) {
+      client_contexts_.CancelAll();
+    }
+    return on_done;
+  }
+
+  // Tries to cancel all the attempts started so far. The call is completed
+  // by the attempt callbacks as usual.
+  void CancelAll() { client_contexts_.CancelAll(); }
+
+  int num_attempts() const ABSL_LOCKS_EXCLUDED(mu_) {
+    absl::MutexLock lock(&mu_);
+    return num_attempts_;
+  }
+
+ private:
+  mutable absl::Mutex mu_;
+  // Reset once the call is completed.
+  OnDone on_done_ ABSL_GUARDED_BY(mu_);
+  int num_attempts_ ABSL_GUARDED_BY(mu_) = 0;
+  ClientContexts client_contexts_;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_COMMON_UTIL_HEDGED_CALL_H_
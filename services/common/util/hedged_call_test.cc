@@ -0,0 +1,118 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/common/util/hedged_call.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "gtest/gtest.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+using TestHedgedCall = HedgedCall<absl::StatusOr<int>>;
+
+TEST(HedgedCallTest, ForwardsFirstAttemptToComplete) {
+  std::vector<absl::StatusOr<int>> outcomes;
+  auto call = std::make_shared<TestHedgedCall>(
+      [&outcomes](absl::StatusOr<int> outcome) {
+        outcomes.push_back(std::move(outcome));
+      });
+  ASSERT_NE(call->AddAttempt({}), nullptr);
+  auto primary = call->AttemptCallback();
+  ASSERT_NE(call->AddAttempt({}), nullptr);
+  auto hedge = call->AttemptCallback();
+  EXPECT_EQ(call->num_attempts(), 2);
+
+  std::move(hedge)(2);
+  std::move(primary)(1);
+  ASSERT_EQ(outcomes.size(), 1);
+  EXPECT_EQ(*outcomes[0], 2);
+}
+
+TEST(HedgedCallTest, DoesNotAddAttemptsOnceCompleted) {
+  auto call = std::make_shared<TestHedgedCall>([](absl::StatusOr<int>) {});
+  ASSERT_NE(call->AddAttempt({}), nullptr);
+  EXPECT_TRUE(call->Complete(1));
+
+  bool added = false;
+  EXPECT_EQ(call->AddAttempt({}, [&added]() { added = true; }), nullptr);
+  EXPECT_FALSE(added);
+  EXPECT_EQ(call->num_attempts(), 1);
+}
+
+TEST(HedgedCallTest, CancelsAttemptsOnCompletion) {
+  auto call = std::make_shared<TestHedgedCall>([](absl::StatusOr<int>) {});
+  grpc::ClientContext* context = call->AddAttempt({{"key", "value"}});
+  ASSERT_NE(context, nullptr);
+  EXPECT_TRUE(call->Complete(absl::DeadlineExceededError("cut off")));
+  EXPECT_FALSE(call->Complete(1));
+}
+
+TEST(HedgedCallTest, TakeOnDoneLeavesInvocationToCaller) {
+  int num_calls = 0;
+  auto call = std::make_shared<TestHedgedCall>(
+      [&num_calls](absl::StatusOr<int>) { ++num_calls; });
+  auto attempt = call->AttemptCallback();
+  TestHedgedCall::OnDone on_done = call->TakeOnDone();
+  ASSERT_NE(on_done, nullptr);
+  EXPECT_EQ(call->TakeOnDone(), nullptr);
+
+  // The attempt completing afterwards is ignored.
+  std::move(attempt)(1);
+  EXPECT_EQ(num_calls, 0);
+  std::move(on_done)(2);
+  EXPECT_EQ(num_calls, 1);
+}
+
+TEST(HedgedCallTest, AttemptsOutliveInitiator) {
+  TestHedgedCall::OnDone attempt;
+  {
+    auto call = std::make_shared<TestHedgedCall>([](absl::StatusOr<int>) {});
+    ASSERT_NE(call->AddAttempt({}), nullptr);
+    attempt = call->AttemptCallback();
+    EXPECT_TRUE(call->Complete(1));
+  }
+  // Only the attempt callback keeps the call alive at this point.
+  std::move(attempt)(2);
+}
+
+TEST(HedgedCallTest, CompletesOnceWithConcurrentAttempts) {
+  constexpr int kNumAttempts = 16;
+  std::atomic<int> num_calls = 0;
+  auto call = std::make_shared<TestHedgedCall>(
+      [&num_calls](absl::StatusOr<int>) { ++num_calls; });
+  std::vector<std::thread> attempts;
+  attempts.reserve(kNumAttempts);
+  for (int i = 0; i < kNumAttempts; ++i) {
+    ASSERT_NE(call->AddAttempt({}), nullptr);
+    attempts.emplace_back(
+        [attempt = call->AttemptCallback(), i]() mutable {
+          std::move(attempt)(i);
+        });
+  }
+  for (auto& attempt : attempts) {
+    attempt.join();
+  }
+  EXPECT_EQ(num_calls, 1);
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -20,7 +20,7 @@
 
 namespace privacy_sandbox::bidding_auction_servers {
 absl::StatusOr<HpkeMessage> HpkeEncrypt(
-    const std::string& plaintext, CryptoClientWrapperInterface& crypto_client,
+    std::string plaintext, CryptoClientWrapperInterface& crypto_client,
     server_common::KeyFetcherManagerInterface& key_fetcher_manager,
     const server_common::CloudPlatform& cloud_platform) {
   auto key = key_fetcher_manager.GetPublicKey(cloud_platform);
@@ -32,7 +32,8 @@ absl::StatusOr<HpkeMessage> HpkeEncrypt(
     return absl::InternalError(std::move(error));
   }
 
-  auto encrypt_response = crypto_client.HpkeEncrypt(key.value(), plaintext);
+  auto encrypt_response =
+      crypto_client.HpkeEncrypt(key.value(), std::move(plaintext));
 
   if (!encrypt_response.ok()) {
     std::string error = absl::StrCat("Failed encrypting request: ",
@@ -43,10 +43,10 @@ struct HpkeMessage {
   std::string secret;
 };
 
-// Used to encrypt a payload with HPKE.
+// Used to encrypt a payload with HPKE. `plaintext` is moved into the
+// encryption request, so pass an rvalue to avoid copying it.
 absl::StatusOr<HpkeMessage> HpkeEncrypt(
-    // HPKE client requires const string reference.
-    const std::string& plaintext, CryptoClientWrapperInterface& crypto_client,
+    std::string plaintext, CryptoClientWrapperInterface& crypto_client,
     server_common::KeyFetcherManagerInterface& key_fetcher_manager,
     const server_common::CloudPlatform& cloud_platform);
 
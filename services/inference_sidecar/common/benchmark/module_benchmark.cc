@@ -32,15 +32,27 @@
 // * `Iterations`: The number of serial executions.
 // * `Throughput` & `items_per_second`: The number of Iterations per second.
 // * `Latency`: Average time spent per Iteration.
+// * `P99LatencyUs`: 99th percentile of the time spent per Iteration in
+//   microseconds, averaged over the threads.
+//
+// `BM_PredictBatch/<n>` sends batches of `n` inference requests, which the
+// module runs in parallel. At high thread counts it shows the overhead of
+// dispatching the requests of a batch to the inference threads.
 
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/barrier.h"
 #include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "benchmark/benchmark.h"
 #include "benchmark/request_utils.h"
 #include "modules/module_interface.h"
@@ -67,8 +79,33 @@ constexpr char kJsonString[] = R"json({
   ]
 }]
     })json";
+constexpr char kInferenceRequestJson[] = R"json({
+    "model_path" : "test_model",
+    "tensors" : [
+    {
+      "tensor_name": "serving_default_double1:0",
+      "data_type": "DOUBLE",
+      "tensor_shape": [
+        1,
+        1
+      ],
+      "tensor_content": ["3.14"]
+    }
+  ]
+})json";
 constexpr int kMaxThreads = 64;
 constexpr int kRegisterMaxThreads = 4;
+constexpr int kMaxBatchSize = 64;
+
+// Returns a batch of `batch_size` identical inference requests.
+std::string CreateBatchRequestJson(int batch_size) {
+  return absl::StrCat(
+      R"({"request" : [)",
+      absl::StrJoin(std::vector<absl::string_view>(batch_size,
+                                                   kInferenceRequestJson),
+                    ","),
+      "]}");
+}
 
 static void ExportMetrics(benchmark::State& state) {
   state.SetItemsProcessed(state.iterations());
@@ -80,6 +117,17 @@ static void ExportMetrics(benchmark::State& state) {
                                                  benchmark::Counter::kInvert);
 }
 
+static void ExportTailLatency(benchmark::State& state,
+                              std::vector<absl::Duration>& latencies) {
+  if (latencies.empty()) {
+    return;
+  }
+  auto p99 = latencies.begin() + latencies.size() * 99 / 100;
+  std::nth_element(latencies.begin(), p99, latencies.end());
+  state.counters["P99LatencyUs"] = benchmark::Counter(
+      absl::ToDoubleMicroseconds(*p99), benchmark::Counter::kAvgThreads);
+}
+
 class ModuleFixture : public benchmark::Fixture {
  public:
   void SetUp(::benchmark::State& state) {
@@ -113,19 +161,40 @@ class ModuleFixture : public benchmark::Fixture {
 };
 
 BENCHMARK_DEFINE_F(ModuleFixture, BM_Predict)(benchmark::State& state) {
+  std::vector<absl::Duration> latencies;
   for (auto _ : state) {
     state.PauseTiming();
     std::string input = StringFormat(kJsonString);
     state.ResumeTiming();
 
+    const absl::Time start = absl::Now();
     PredictRequest predict_request;
     predict_request.set_input(input);
 
     absl::StatusOr response = module_->Predict(predict_request);
     CHECK(response.ok()) << response.status().message();
+    latencies.push_back(absl::Now() - start);
   }
 
   ExportMetrics(state);
+  ExportTailLatency(state, latencies);
+}
+
+BENCHMARK_DEFINE_F(ModuleFixture, BM_PredictBatch)(benchmark::State& state) {
+  const std::string input = CreateBatchRequestJson(state.range(0));
+  std::vector<absl::Duration> latencies;
+  for (auto _ : state) {
+    const absl::Time start = absl::Now();
+    PredictRequest predict_request;
+    predict_request.set_input(input);
+
+    absl::StatusOr response = module_->Predict(predict_request);
+    CHECK(response.ok()) << response.status().message();
+    latencies.push_back(absl::Now() - start);
+  }
+
+  ExportMetrics(state);
+  ExportTailLatency(state, latencies);
 }
 
 BENCHMARK_DEFINE_F(ModuleFixture, BM_Register)(benchmark::State& state) {
@@ -156,6 +225,12 @@ BENCHMARK_REGISTER_F(ModuleFixture, BM_Predict)
     ->ThreadRange(1, kMaxThreads)
     ->MeasureProcessCPUTime()
     ->UseRealTime();
+BENCHMARK_REGISTER_F(ModuleFixture, BM_PredictBatch)
+    ->RangeMultiplier(4)
+    ->Range(1, kMaxBatchSize)
+    ->ThreadRange(1, kMaxThreads)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime();
 
 // Runs the benchmark.
 BENCHMARK_MAIN();
@@ -24,6 +24,7 @@
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/time/time.h"
@@ -204,7 +205,8 @@ std::string GetFilePath(absl::string_view relative_binary_path) {
 
 SandboxExecutor::SandboxExecutor(absl::string_view binary_path,
                                  const std::vector<std::string>& args,
-                                 const int64_t rlimit_mb) {
+                                 const int64_t rlimit_mb,
+                                 absl::string_view shared_model_dir) {
   auto executor = std::make_unique<sandbox2::Executor>(binary_path, args);
   executor->limits()
       ->set_rlimit_cpu(RLIM64_INFINITY)
@@ -222,6 +224,15 @@ SandboxExecutor::SandboxExecutor(absl::string_view binary_path,
   file_descriptor_ = executor->ipc()->ReceiveFd(kFileDescriptorName);
   sandbox_ =
       std::make_unique<sandbox2::Sandbox2>(std::move(executor), MakePolicy());
+
+  // Namespaces are disabled, so the sandboxee sees the file system of the
+  // parent process as is. The shared model directory doesn't need to be
+  // mounted, but it must be absolute to resolve to the same directory in the
+  // sandboxee, whose working directory may differ.
+  if (!shared_model_dir.empty() && !absl::StartsWith(shared_model_dir, "/")) {
+    ABSL_LOG(ERROR) << "SandboxExecutor: The shared model directory "
+                    << shared_model_dir << " is not an absolute path";
+  }
 }
 
 SandboxExecutor::~SandboxExecutor() { StopSandboxee().IgnoreError(); }
@@ -54,9 +54,12 @@ std::string GetFilePath(absl::string_view relative_binary_path);
 // Not thread safe.
 class SandboxExecutor {
  public:
+  // `shared_model_dir` is the directory of the model files shared with the
+  // sandboxee, if any. It must be an absolute path.
   SandboxExecutor(absl::string_view binary_path,
                   const std::vector<std::string>& args,
-                  const int64_t rlimit_mb = 0);
+                  const int64_t rlimit_mb = 0,
+                  absl::string_view shared_model_dir = "");
   ~SandboxExecutor();
 
   SandboxExecutor(const SandboxExecutor&) = delete;
@@ -92,6 +92,20 @@ TEST_F(SandboxExecutorTest, DoubleStop) {
   ASSERT_EQ(result->final_status(), sandbox2::Result::OK);
 }
 
+TEST_F(SandboxExecutorTest, RunWithSharedModelDir) {
+  // The sandbox policy is built and applied with a shared model directory.
+  SandboxExecutor executor(GetFilePath(kExitBinary), {""}, /*rlimit_mb=*/0,
+                           ::testing::TempDir());
+  ASSERT_EQ(executor.StartSandboxee().code(), absl::StatusCode::kOk);
+
+  // Wait for sandboxee to stop on its own.
+  absl::SleepFor(absl::Seconds(1));
+
+  absl::StatusOr<sandbox2::Result> result = executor.StopSandboxee();
+  ASSERT_TRUE(result.ok());
+  ASSERT_EQ(result->final_status(), sandbox2::Result::OK);
+}
+
 TEST_F(SandboxExecutorTest, Kill) {
   // `sandboxee_ipc_test_bin` waits for the proto message.
   SandboxExecutor executor(GetFilePath(kIpcBinary), {""});
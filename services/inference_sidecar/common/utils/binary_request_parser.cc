@@ -0,0 +1,214 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "utils/binary_request_parser.h"
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/config.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "src/util/status_macro/status_macros.h"
+
+// Tensor contents are read in place, so the host must be little-endian as the
+// binary request format.
+#ifndef ABSL_IS_LITTLE_ENDIAN
+#error "Binary inference requests require a little-endian host."
+#endif
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+namespace {
+
+constexpr char kPadding[kBinaryTensorAlignment] = {};
+
+// Reads the fields of a binary batch inference request in order.
+class BinaryReader {
+ public:
+  explicit BinaryReader(absl::string_view payload) : payload_(payload) {}
+
+  absl::StatusOr<uint32_t> ReadUint32(absl::string_view field) {
+    PS_ASSIGN_OR_RETURN(absl::string_view bytes,
+                        ReadBytes(sizeof(uint32_t), field));
+    uint32_t value;
+    std::memcpy(&value, bytes.data(), sizeof(value));
+    return value;
+  }
+
+  absl::StatusOr<absl::string_view> ReadBytes(size_t size,
+                                              absl::string_view field) {
+    if (size > payload_.size() - offset_) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Invalid binary request: truncated ", field,
+                       " at offset ", offset_));
+    }
+    absl::string_view bytes = payload_.substr(offset_, size);
+    offset_ += size;
+    return bytes;
+  }
+
+  absl::Status SkipPadding() {
+    const size_t padding_size =
+        (kBinaryTensorAlignment - offset_ % kBinaryTensorAlignment) %
+        kBinaryTensorAlignment;
+    return ReadBytes(padding_size, "padding").status();
+  }
+
+  size_t remaining_size() const { return payload_.size() - offset_; }
+
+ private:
+  absl::string_view payload_;
+  size_t offset_ = 0;
+};
+
+absl::StatusOr<BinaryTensor> ReadTensor(BinaryReader& reader) {
+  BinaryTensor tensor;
+  PS_ASSIGN_OR_RETURN(uint32_t name_size,
+                      reader.ReadUint32("tensor name size"));
+  PS_ASSIGN_OR_RETURN(tensor.tensor_name,
+                      reader.ReadBytes(name_size, "tensor name"));
+  PS_ASSIGN_OR_RETURN(uint32_t data_type, reader.ReadUint32("data type"));
+  if (data_type > DataType::kInt64) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Invalid binary request: unsupported data type ",
+                     data_type, " for tensor ", tensor.tensor_name));
+  }
+  tensor.data_type = static_cast<DataType>(data_type);
+  PS_ASSIGN_OR_RETURN(uint32_t rank, reader.ReadUint32("tensor rank"));
+  if (rank > reader.remaining_size() / sizeof(uint32_t)) {
+    return absl::InvalidArgumentError(
+        "Invalid binary request: truncated tensor shape");
+  }
+  // Only dense tensors are supported.
+  uint64_t num_elements = 1;
+  tensor.tensor_shape.reserve(rank);
+  for (uint32_t i = 0; i < rank; ++i) {
+    PS_ASSIGN_OR_RETURN(uint32_t dim, reader.ReadUint32("tensor dimension"));
+    if (dim < 1) {
+      return absl::InvalidArgumentError(
+          "Invalid tensor dimension: it has to be greater than 0");
+    }
+    // Bounds the element count by the payload size, so that it can't
+    // overflow.
+    if (dim > reader.remaining_size() / num_elements) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Invalid binary request: tensor ", tensor.tensor_name,
+                       " is larger than the request"));
+    }
+    num_elements *= dim;
+    tensor.tensor_shape.push_back(dim);
+  }
+  PS_RETURN_IF_ERROR(reader.SkipPadding());
+  PS_ASSIGN_OR_RETURN(
+      tensor.tensor_content,
+      reader.ReadBytes(num_elements * GetDataTypeSize(tensor.data_type),
+                       "tensor content"));
+  return tensor;
+}
+
+absl::StatusOr<BinaryInferenceRequest> ReadRequest(BinaryReader& reader) {
+  BinaryInferenceRequest request;
+  PS_ASSIGN_OR_RETURN(uint32_t model_path_size,
+                      reader.ReadUint32("model path size"));
+  PS_ASSIGN_OR_RETURN(request.model_path,
+                      reader.ReadBytes(model_path_size, "model path"));
+  PS_ASSIGN_OR_RETURN(uint32_t num_tensors, reader.ReadUint32("tensor count"));
+  for (uint32_t i = 0; i < num_tensors; ++i) {
+    PS_ASSIGN_OR_RETURN(BinaryTensor tensor, ReadTensor(reader));
+    request.inputs.push_back(std::move(tensor));
+  }
+  return request;
+}
+
+void AppendUint32(uint32_t value, std::string& output) {
+  output.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace
+
+size_t GetDataTypeSize(DataType data_type) {
+  switch (data_type) {
+    case DataType::kFloat:
+      return sizeof(float);
+    case DataType::kDouble:
+      return sizeof(double);
+    case DataType::kInt8:
+      return sizeof(int8_t);
+    case DataType::kInt16:
+      return sizeof(int16_t);
+    case DataType::kInt32:
+      return sizeof(int32_t);
+    case DataType::kInt64:
+      return sizeof(int64_t);
+  }
+  return 0;
+}
+
+absl::StatusOr<std::vector<BinaryInferenceRequest>> ParseBinaryInferenceRequest(
+    absl::string_view payload) {
+  BinaryReader reader(payload);
+  PS_ASSIGN_OR_RETURN(uint32_t version, reader.ReadUint32("version"));
+  if (version != kBinaryRequestVersion) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Invalid binary request: unsupported version ", version));
+  }
+  PS_ASSIGN_OR_RETURN(uint32_t num_requests,
+                      reader.ReadUint32("request count"));
+  if (num_requests == 0) {
+    return absl::InvalidArgumentError("Invalid binary request: no request");
+  }
+  std::vector<BinaryInferenceRequest> requests;
+  for (uint32_t i = 0; i < num_requests; ++i) {
+    PS_ASSIGN_OR_RETURN(BinaryInferenceRequest request, ReadRequest(reader));
+    requests.push_back(std::move(request));
+  }
+  if (reader.remaining_size() != 0) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Invalid binary request: ", reader.remaining_size(),
+                     " unexpected trailing bytes"));
+  }
+  return requests;
+}
+
+std::string SerializeBinaryInferenceRequest(
+    absl::Span<const BinaryInferenceRequest> requests) {
+  std::string output;
+  AppendUint32(kBinaryRequestVersion, output);
+  AppendUint32(requests.size(), output);
+  for (const BinaryInferenceRequest& request : requests) {
+    AppendUint32(request.model_path.size(), output);
+    output.append(request.model_path.data(), request.model_path.size());
+    AppendUint32(request.inputs.size(), output);
+    for (const BinaryTensor& tensor : request.inputs) {
+      AppendUint32(tensor.tensor_name.size(), output);
+      output.append(tensor.tensor_name.data(), tensor.tensor_name.size());
+      AppendUint32(tensor.data_type, output);
+      AppendUint32(tensor.tensor_shape.size(), output);
+      for (int64_t dim : tensor.tensor_shape) {
+        AppendUint32(dim, output);
+      }
+      output.append(kPadding,
+                    (kBinaryTensorAlignment -
+                     output.size() % kBinaryTensorAlignment) %
+                        kBinaryTensorAlignment);
+      output.append(tensor.tensor_content.data(),
+                    tensor.tensor_content.size());
+    }
+  }
+  return output;
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
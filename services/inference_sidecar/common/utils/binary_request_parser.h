@@ -0,0 +1,85 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef SERVICES_INFERENCE_SIDECAR_COMMON_UTILS_BINARY_REQUEST_PARSER_H_
+#define SERVICES_INFERENCE_SIDECAR_COMMON_UTILS_BINARY_REQUEST_PARSER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "utils/request_parser.h"
+
+// Binary batch inference request format, an alternative to the JSON format
+// that JS can build from typed arrays without converting the tensor values to
+// text. All integers are unsigned 32-bit little-endian values:
+//
+//   batch:   version (kBinaryRequestVersion), request count, requests
+//   request: model path size, model path (UTF-8), tensor count, tensors
+//   tensor:  tensor name size, tensor name (UTF-8), data type (the DataType
+//            enum value, e.g. 4 for INT32), rank, dimensions, zero padding up
+//            to a multiple of kBinaryTensorAlignment bytes from the start of
+//            the batch, content
+//
+// The content of a tensor holds its values in row-major order, as in the
+// little-endian buffer of the corresponding JS typed array (e.g. Float32Array
+// for FLOAT or BigInt64Array for INT64).
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+
+inline constexpr uint32_t kBinaryRequestVersion = 1;
+
+// Alignment of the tensor contents within a binary batch inference request.
+// It is the largest alignment required by the vectorized kernels of the ML
+// frameworks, so that a tensor can be used in place when the request is
+// aligned as well.
+inline constexpr size_t kBinaryTensorAlignment = 64;
+
+// A tensor of a binary inference request. The name and content point into
+// the parsed request.
+struct BinaryTensor {
+  absl::string_view tensor_name;
+  DataType data_type;
+  std::vector<int64_t> tensor_shape;
+  // Little-endian values of the tensor in row-major order.
+  absl::string_view tensor_content;
+};
+
+// An inference request of a binary batch inference request. The model path
+// points into the parsed request.
+struct BinaryInferenceRequest {
+  absl::string_view model_path;
+  std::vector<BinaryTensor> inputs;
+};
+
+// Returns the size in bytes of a value of `data_type`.
+size_t GetDataTypeSize(DataType data_type);
+
+// Parses a binary batch inference request without copying the tensor
+// contents. The returned requests point into `payload`, which must outlive
+// them. Fails if any part of the request is malformed.
+absl::StatusOr<std::vector<BinaryInferenceRequest>> ParseBinaryInferenceRequest(
+    absl::string_view payload);
+
+// Serializes `requests` in the binary batch inference request format.
+std::string SerializeBinaryInferenceRequest(
+    absl::Span<const BinaryInferenceRequest> requests);
+
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
+
+#endif  // SERVICES_INFERENCE_SIDECAR_COMMON_UTILS_BINARY_REQUEST_PARSER_H_
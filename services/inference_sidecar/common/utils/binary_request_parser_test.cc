@@ -0,0 +1,162 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "utils/binary_request_parser.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+namespace {
+
+template <typename T>
+absl::string_view AsBytes(const std::vector<T>& values) {
+  return absl::string_view(reinterpret_cast<const char*>(values.data()),
+                           values.size() * sizeof(T));
+}
+
+template <typename T>
+std::vector<T> FromBytes(absl::string_view bytes) {
+  std::vector<T> values(bytes.size() / sizeof(T));
+  std::memcpy(values.data(), bytes.data(), bytes.size());
+  return values;
+}
+
+std::string EncodeUint32s(const std::vector<uint32_t>& values) {
+  return std::string(AsBytes(values));
+}
+
+TEST(BinaryRequestParserTest, ParsesSerializedRequests) {
+  const std::vector<float> features = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6};
+  const std::vector<int64_t> ids = {7, 8};
+  const std::vector<int8_t> flags = {1};
+  const std::vector<BinaryInferenceRequest> requests = {
+      {.model_path = "model1",
+       .inputs = {{.tensor_name = "features",
+                   .data_type = DataType::kFloat,
+                   .tensor_shape = {2, 3},
+                   .tensor_content = AsBytes(features)},
+                  {.tensor_name = "ids",
+                   .data_type = DataType::kInt64,
+                   .tensor_shape = {2},
+                   .tensor_content = AsBytes(ids)}}},
+      {.model_path = "model2",
+       .inputs = {{.tensor_name = "flag",
+                   .data_type = DataType::kInt8,
+                   .tensor_shape = {1, 1},
+                   .tensor_content = AsBytes(flags)}}}};
+  const std::string payload = SerializeBinaryInferenceRequest(requests);
+
+  absl::StatusOr<std::vector<BinaryInferenceRequest>> parsed_requests =
+      ParseBinaryInferenceRequest(payload);
+
+  ASSERT_TRUE(parsed_requests.ok()) << parsed_requests.status();
+  ASSERT_EQ(parsed_requests->size(), 2);
+  const BinaryInferenceRequest& request1 = (*parsed_requests)[0];
+  EXPECT_EQ(request1.model_path, "model1");
+  ASSERT_EQ(request1.inputs.size(), 2);
+  EXPECT_EQ(request1.inputs[0].tensor_name, "features");
+  EXPECT_EQ(request1.inputs[0].data_type, DataType::kFloat);
+  EXPECT_EQ(request1.inputs[0].tensor_shape, std::vector<int64_t>({2, 3}));
+  EXPECT_EQ(FromBytes<float>(request1.inputs[0].tensor_content), features);
+  EXPECT_EQ(request1.inputs[1].tensor_name, "ids");
+  EXPECT_EQ(request1.inputs[1].data_type, DataType::kInt64);
+  EXPECT_EQ(FromBytes<int64_t>(request1.inputs[1].tensor_content), ids);
+  const BinaryInferenceRequest& request2 = (*parsed_requests)[1];
+  EXPECT_EQ(request2.model_path, "model2");
+  ASSERT_EQ(request2.inputs.size(), 1);
+  EXPECT_EQ(FromBytes<int8_t>(request2.inputs[0].tensor_content), flags);
+}
+
+TEST(BinaryRequestParserTest, TensorContentIsAlignedAndNotCopied) {
+  const std::vector<double> values = {1.5, 2.5};
+  const std::vector<BinaryInferenceRequest> requests = {
+      {.model_path = "m",
+       .inputs = {{.tensor_name = "x",
+                   .data_type = DataType::kDouble,
+                   .tensor_shape = {2},
+                   .tensor_content = AsBytes(values)}}}};
+  const std::string payload = SerializeBinaryInferenceRequest(requests);
+
+  absl::StatusOr<std::vector<BinaryInferenceRequest>> parsed_requests =
+      ParseBinaryInferenceRequest(payload);
+
+  ASSERT_TRUE(parsed_requests.ok()) << parsed_requests.status();
+  const absl::string_view content =
+      (*parsed_requests)[0].inputs[0].tensor_content;
+  EXPECT_GE(content.data(), payload.data());
+  EXPECT_LT(content.data(), payload.data() + payload.size());
+  EXPECT_EQ((content.data() - payload.data()) % kBinaryTensorAlignment, 0);
+}
+
+TEST(BinaryRequestParserTest, FailsOnUnsupportedVersion) {
+  EXPECT_FALSE(ParseBinaryInferenceRequest(EncodeUint32s({2, 1})).ok());
+}
+
+TEST(BinaryRequestParserTest, FailsOnEmptyBatch) {
+  EXPECT_FALSE(ParseBinaryInferenceRequest("").ok());
+  EXPECT_FALSE(
+      ParseBinaryInferenceRequest(EncodeUint32s({kBinaryRequestVersion, 0}))
+          .ok());
+}
+
+TEST(BinaryRequestParserTest, FailsOnTruncatedRequest) {
+  const std::vector<int32_t> values = {1, 2, 3, 4};
+  const std::vector<BinaryInferenceRequest> requests = {
+      {.model_path = "m",
+       .inputs = {{.tensor_name = "x",
+                   .data_type = DataType::kInt32,
+                   .tensor_shape = {2, 2},
+                   .tensor_content = AsBytes(values)}}}};
+  const std::string payload = SerializeBinaryInferenceRequest(requests);
+
+  for (size_t size = 0; size < payload.size(); ++size) {
+    EXPECT_FALSE(ParseBinaryInferenceRequest(payload.substr(0, size)).ok())
+        << "size " << size;
+  }
+  EXPECT_FALSE(ParseBinaryInferenceRequest(absl::StrCat(payload, "x")).ok());
+}
+
+TEST(BinaryRequestParserTest, FailsOnInvalidTensor) {
+  // A batch of one request with an empty model path and one tensor with an
+  // empty name.
+  const std::string request_header =
+      EncodeUint32s({kBinaryRequestVersion, 1, 0, 1, 0});
+
+  // Unsupported data type.
+  EXPECT_FALSE(ParseBinaryInferenceRequest(
+                   absl::StrCat(request_header, EncodeUint32s({6, 0})))
+                   .ok());
+  // Zero dimension.
+  EXPECT_FALSE(ParseBinaryInferenceRequest(
+                   absl::StrCat(request_header,
+                                EncodeUint32s({DataType::kFloat, 1, 0})))
+                   .ok());
+  // Overflowing element count.
+  EXPECT_FALSE(ParseBinaryInferenceRequest(
+                   absl::StrCat(request_header,
+                                EncodeUint32s({DataType::kInt64, 4, 0xFFFFFFFF,
+                                               0xFFFFFFFF, 0xFFFFFFFF,
+                                               0xFFFFFFFF})))
+                   .ok());
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
@@ -15,6 +15,7 @@
 #include "utils/cpu.h"
 
 #include <errno.h>
+#include <pthread.h>
 #include <sched.h>
 #include <unistd.h>
 
@@ -57,4 +58,23 @@ absl::Status SetCpuAffinity(const std::vector<int>& cpus) {
   return absl::OkStatus();
 }
 
+absl::Status SetThreadCpuAffinity(const std::vector<int>& cpus) {
+  if (cpus.empty()) {
+    return absl::InvalidArgumentError("cpus should have at least one element.");
+  }
+  cpu_set_t allowed_cpus;
+  CPU_ZERO(&allowed_cpus);
+  for (int cpu : cpus) {
+    CPU_SET(cpu, &allowed_cpus);
+  }
+  // Unlike other system calls, it returns the error number.
+  if (int error = pthread_setaffinity_np(pthread_self(), sizeof(allowed_cpus),
+                                         &allowed_cpus);
+      error != 0) {
+    return absl::ErrnoToStatus(
+        error, absl::StrCat("pthread_setaffinity_np() failed: ", error));
+  }
+  return absl::OkStatus();
+}
+
 }  // namespace privacy_sandbox::bidding_auction_servers::inference
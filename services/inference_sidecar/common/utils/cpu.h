@@ -24,6 +24,9 @@ namespace privacy_sandbox::bidding_auction_servers::inference {
 // Set the CPU affinity to the current process given a list of CPU IDs.
 absl::Status SetCpuAffinity(const std::vector<int>& cpus);
 
+// Pins the calling thread to `cpus`.
+absl::Status SetThreadCpuAffinity(const std::vector<int>& cpus);
+
 }  // namespace privacy_sandbox::bidding_auction_servers::inference
 
 #endif  // SERVICES_INFERENCE_SIDECAR_COMMON_UTILS_CPU_H_
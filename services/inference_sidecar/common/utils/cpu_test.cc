@@ -14,6 +14,7 @@
 
 #include "utils/cpu.h"
 
+#include <pthread.h>
 #include <sched.h>
 #include <unistd.h>
 
@@ -49,6 +50,31 @@ TEST(SetCpuAffinity, CpuExistsAfterFiltering) {
   EXPECT_EQ(status.code(), absl::StatusCode::kOk);
 }
 
+TEST(SetThreadCpuAffinity, Success) {
+  cpu_set_t original_cpus;
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(original_cpus),
+                                   &original_cpus),
+            0);
+
+  EXPECT_EQ(SetThreadCpuAffinity({kMinCpuId}).code(), absl::StatusCode::kOk);
+  EXPECT_EQ(sched_getcpu(), kMinCpuId);
+
+  // Restores the affinity of the test thread for the following tests.
+  ASSERT_EQ(pthread_setaffinity_np(pthread_self(), sizeof(original_cpus),
+                                   &original_cpus),
+            0);
+}
+
+TEST(SetThreadCpuAffinity, EmptyCpuSet) {
+  EXPECT_EQ(SetThreadCpuAffinity({}).code(),
+            absl::StatusCode::kInvalidArgument);
+}
+
+TEST(SetThreadCpuAffinity, NoCpuExists) {
+  EXPECT_EQ(SetThreadCpuAffinity({kNonExistentCpuId}).code(),
+            absl::StatusCode::kInvalidArgument);
+}
+
 TEST(SetCpuAffinity, SetAllCpus) {
   const int num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
   std::vector<int> all_cpus;
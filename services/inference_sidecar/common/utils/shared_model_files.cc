@@ -0,0 +1,158 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "utils/shared_model_files.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+namespace {
+
+// Returns the path of `model_file_path` under `shared_dir`. Model file paths
+// must stay within the shared directory.
+absl::StatusOr<std::filesystem::path> GetSharedPath(
+    absl::string_view shared_dir, absl::string_view model_file_path) {
+  const std::filesystem::path relative_path =
+      std::filesystem::path(std::string(model_file_path)).lexically_normal();
+  if (relative_path.empty() || relative_path.is_absolute() ||
+      *relative_path.begin() == "..") {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Invalid model file path: ", model_file_path));
+  }
+  return std::filesystem::path(std::string(shared_dir)) / relative_path;
+}
+
+absl::Status ErrnoToStatus(absl::string_view operation,
+                           absl::string_view path) {
+  return absl::InternalError(
+      absl::StrCat(operation, " failed for ", path, ": ", std::strerror(errno)));
+}
+
+}  // namespace
+
+absl::StatusOr<std::string> WriteSharedModelFile(
+    absl::string_view shared_dir, absl::string_view model_file_path,
+    absl::string_view contents) {
+  absl::StatusOr<std::filesystem::path> path =
+      GetSharedPath(shared_dir, model_file_path);
+  if (!path.ok()) {
+    return path.status();
+  }
+  std::error_code error;
+  std::filesystem::create_directories(path->parent_path(), error);
+  if (error) {
+    return absl::InternalError(absl::StrCat("Failed to create directory ",
+                                            path->parent_path().string(), ": ",
+                                            error.message()));
+  }
+  const std::string temp_path = absl::StrCat(path->string(), ".tmp");
+  {
+    std::ofstream ofs(temp_path,
+                      std::ios::out | std::ios::binary | std::ios::trunc);
+    ofs.write(contents.data(), contents.size());
+    if (!ofs.good()) {
+      return absl::InternalError(
+          absl::StrCat("Failed to write model file: ", temp_path));
+    }
+  }
+  std::filesystem::rename(temp_path, *path, error);
+  if (error) {
+    return absl::InternalError(absl::StrCat("Failed to rename ", temp_path,
+                                            ": ", error.message()));
+  }
+  return path->string();
+}
+
+absl::Status DeleteSharedModelFiles(absl::string_view shared_dir) {
+  std::error_code error;
+  std::filesystem::remove_all(std::string(shared_dir), error);
+  if (error) {
+    return absl::InternalError(absl::StrCat("Failed to delete ", shared_dir,
+                                            ": ", error.message()));
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<std::unique_ptr<MappedFile>> MappedFile::Open(
+    absl::string_view path) {
+  const std::string path_str(path);
+  const int fd = open(path_str.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return ErrnoToStatus("open", path);
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    absl::Status status = ErrnoToStatus("fstat", path);
+    close(fd);
+    return status;
+  }
+  const size_t size = file_stat.st_size;
+  void* data = nullptr;
+  // Empty files can't be mapped.
+  if (size > 0) {
+    data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      absl::Status status = ErrnoToStatus("mmap", path);
+      close(fd);
+      return status;
+    }
+  }
+  // The mapping stays valid after the file descriptor is closed.
+  close(fd);
+  return absl::WrapUnique(new MappedFile(data, size));
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+}
+
+absl::Status ForEachModelFile(
+    const RegisterModelRequest& request,
+    absl::FunctionRef<absl::Status(absl::string_view path,
+                                   absl::string_view contents)>
+        fn) {
+  for (const auto& [path, contents] : request.model_files()) {
+    if (absl::Status status = fn(path, contents); !status.ok()) {
+      return status;
+    }
+  }
+  for (const auto& [path, shared_path] : request.shared_model_files()) {
+    absl::StatusOr<std::unique_ptr<MappedFile>> file =
+        MappedFile::Open(shared_path);
+    if (!file.ok()) {
+      return file.status();
+    }
+    if (absl::Status status = fn(path, (*file)->contents()); !status.ok()) {
+      return status;
+    }
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
@@ -0,0 +1,87 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef SERVICES_INFERENCE_SIDECAR_COMMON_UTILS_SHARED_MODEL_FILES_H_
+#define SERVICES_INFERENCE_SIDECAR_COMMON_UTILS_SHARED_MODEL_FILES_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "absl/functional/function_ref.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "proto/inference_sidecar.pb.h"
+
+// Model files can be shared with the inference sidecar through a directory,
+// typically on tmpfs, that the sidecar sandbox sees at the same path. The
+// RegisterModelRequest then only carries the paths of the files in
+// `shared_model_files`, and the sidecar memory-maps them instead of receiving
+// their contents in `model_files`.
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+
+// Writes `contents` as the model file `model_file_path` under `shared_dir` and
+// returns the path of the written file. The contents are written to a
+// temporary file that is then renamed, so that a sidecar still mapping a
+// previous version of the file keeps reading consistent contents.
+absl::StatusOr<std::string> WriteSharedModelFile(
+    absl::string_view shared_dir, absl::string_view model_file_path,
+    absl::string_view contents);
+
+// Removes `shared_dir` with all the model files written under it.
+absl::Status DeleteSharedModelFiles(absl::string_view shared_dir);
+
+// Read-only memory mapping of a whole file.
+class MappedFile {
+ public:
+  static absl::StatusOr<std::unique_ptr<MappedFile>> Open(
+      absl::string_view path);
+
+  ~MappedFile();
+
+  // Not copyable or movable.
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  absl::string_view contents() const {
+    return absl::string_view(static_cast<const char*>(data_), size_);
+  }
+
+ private:
+  MappedFile(void* data, size_t size) : data_(data), size_(size) {}
+
+  void* data_;
+  size_t size_;
+};
+
+// Calls `fn` with the path and contents of each file of the model registered
+// by `request`, whether sent in `model_files` or shared in
+// `shared_model_files`. Shared files are memory-mapped for the duration of
+// their call. Stops at the first error returned by `fn`.
+absl::Status ForEachModelFile(
+    const RegisterModelRequest& request,
+    absl::FunctionRef<absl::Status(absl::string_view path,
+                                   absl::string_view contents)>
+        fn);
+
+// Returns the number of files of the model registered by `request`.
+inline int GetModelFileCount(const RegisterModelRequest& request) {
+  return request.model_files_size() + request.shared_model_files_size();
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
+
+#endif  // SERVICES_INFERENCE_SIDECAR_COMMON_UTILS_SHARED_MODEL_FILES_H_
@@ -0,0 +1,141 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "utils/shared_model_files.h"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+namespace {
+
+class SharedModelFilesTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    shared_dir_ = absl::StrCat(::testing::TempDir(), "/shared_models_",
+                               ::testing::UnitTest::GetInstance()
+                                   ->current_test_info()
+                                   ->name());
+    std::filesystem::remove_all(shared_dir_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(shared_dir_); }
+
+  std::string shared_dir_;
+};
+
+TEST_F(SharedModelFilesTest, WritesAndMapsModelFile) {
+  absl::StatusOr<std::string> path =
+      WriteSharedModelFile(shared_dir_, "model/variables/data", "weights");
+  ASSERT_TRUE(path.ok()) << path.status();
+  EXPECT_EQ(*path, absl::StrCat(shared_dir_, "/model/variables/data"));
+
+  absl::StatusOr<std::unique_ptr<MappedFile>> file = MappedFile::Open(*path);
+  ASSERT_TRUE(file.ok()) << file.status();
+  EXPECT_EQ((*file)->contents(), "weights");
+}
+
+TEST_F(SharedModelFilesTest, MappingOutlivesOverwrittenFile) {
+  absl::StatusOr<std::string> path =
+      WriteSharedModelFile(shared_dir_, "model", "version1");
+  ASSERT_TRUE(path.ok()) << path.status();
+  absl::StatusOr<std::unique_ptr<MappedFile>> file = MappedFile::Open(*path);
+  ASSERT_TRUE(file.ok()) << file.status();
+
+  ASSERT_TRUE(WriteSharedModelFile(shared_dir_, "model", "version2").ok());
+
+  EXPECT_EQ((*file)->contents(), "version1");
+  absl::StatusOr<std::unique_ptr<MappedFile>> new_file =
+      MappedFile::Open(*path);
+  ASSERT_TRUE(new_file.ok()) << new_file.status();
+  EXPECT_EQ((*new_file)->contents(), "version2");
+}
+
+TEST_F(SharedModelFilesTest, MapsEmptyFile) {
+  absl::StatusOr<std::string> path =
+      WriteSharedModelFile(shared_dir_, "empty", "");
+  ASSERT_TRUE(path.ok()) << path.status();
+
+  absl::StatusOr<std::unique_ptr<MappedFile>> file = MappedFile::Open(*path);
+  ASSERT_TRUE(file.ok()) << file.status();
+  EXPECT_TRUE((*file)->contents().empty());
+}
+
+TEST_F(SharedModelFilesTest, RejectsPathsOutsideSharedDir) {
+  EXPECT_FALSE(WriteSharedModelFile(shared_dir_, "../model", "bytes").ok());
+  EXPECT_FALSE(WriteSharedModelFile(shared_dir_, "a/../../model", "").ok());
+  EXPECT_FALSE(WriteSharedModelFile(shared_dir_, "/tmp/model", "bytes").ok());
+}
+
+TEST_F(SharedModelFilesTest, DeletesSharedDirectory) {
+  absl::StatusOr<std::string> path_1 =
+      WriteSharedModelFile(shared_dir_, "model/saved_model.pb", "graph");
+  absl::StatusOr<std::string> path_2 =
+      WriteSharedModelFile(shared_dir_, "model/variables/data", "weights");
+  ASSERT_TRUE(path_1.ok() && path_2.ok());
+
+  ASSERT_TRUE(DeleteSharedModelFiles(shared_dir_).ok());
+
+  EXPECT_FALSE(std::filesystem::exists(shared_dir_));
+  // Deleting a missing directory is a no-op.
+  EXPECT_TRUE(DeleteSharedModelFiles(shared_dir_).ok());
+}
+
+TEST_F(SharedModelFilesTest, MapFailsOnMissingFile) {
+  EXPECT_FALSE(MappedFile::Open(absl::StrCat(shared_dir_, "/missing")).ok());
+}
+
+TEST_F(SharedModelFilesTest, ForEachModelFileVisitsInlineAndSharedFiles) {
+  absl::StatusOr<std::string> path =
+      WriteSharedModelFile(shared_dir_, "model/shared", "shared_bytes");
+  ASSERT_TRUE(path.ok()) << path.status();
+  RegisterModelRequest request;
+  (*request.mutable_model_files())["model/inline"] = "inline_bytes";
+  (*request.mutable_shared_model_files())["model/shared"] = *path;
+  EXPECT_EQ(GetModelFileCount(request), 2);
+
+  std::vector<std::pair<std::string, std::string>> files;
+  absl::Status status = ForEachModelFile(
+      request, [&files](absl::string_view path, absl::string_view contents) {
+        files.emplace_back(path, contents);
+        return absl::OkStatus();
+      });
+
+  ASSERT_TRUE(status.ok()) << status;
+  EXPECT_EQ(files, (std::vector<std::pair<std::string, std::string>>{
+                       {"model/inline", "inline_bytes"},
+                       {"model/shared", "shared_bytes"}}));
+}
+
+TEST_F(SharedModelFilesTest, ForEachModelFileFailsOnMissingSharedFile) {
+  RegisterModelRequest request;
+  (*request.mutable_shared_model_files())["model"] =
+      absl::StrCat(shared_dir_, "/missing");
+
+  absl::Status status = ForEachModelFile(
+      request, [](absl::string_view path, absl::string_view contents) {
+        return absl::OkStatus();
+      });
+
+  EXPECT_FALSE(status.ok());
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
@@ -0,0 +1,112 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "utils/worker_pool.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_join.h"
+#include "utils/cpu.h"
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+
+WorkerPool::WorkerPool(int num_workers, const std::vector<int>& cpus) {
+  std::vector<std::vector<int>> worker_cpus;
+  if (!cpus.empty()) {
+    worker_cpus = GetWorkerCpus(cpus, num_workers);
+  }
+  workers_.reserve(num_workers);
+  for (int i = 0; i < num_workers; ++i) {
+    std::vector<int> cpu_slice;
+    if (!worker_cpus.empty()) {
+      cpu_slice = std::move(worker_cpus[i]);
+    }
+    workers_.emplace_back([this, cpu_slice = std::move(cpu_slice)]() {
+      if (!cpu_slice.empty()) {
+        if (absl::Status status = SetThreadCpuAffinity(cpu_slice);
+            !status.ok()) {
+          ABSL_LOG(WARNING) << "Failed to pin inference worker to CPUs "
+                            << absl::StrJoin(cpu_slice, ",") << ": " << status;
+        }
+      }
+      Work();
+    });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    absl::MutexLock lock(&mu_);
+    stopping_ = true;
+  }
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void WorkerPool::Enqueue(absl::AnyInvocable<void()> task) {
+  absl::MutexLock lock(&mu_);
+  tasks_.push_back(std::move(task));
+}
+
+void WorkerPool::Work() {
+  while (true) {
+    absl::AnyInvocable<void()> task;
+    {
+      absl::MutexLock lock(&mu_);
+      mu_.Await(absl::Condition(this, &WorkerPool::HasWork));
+      if (tasks_.empty()) {
+        // The pool is stopping and there is nothing left to run.
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+int GetNumInferenceWorkers(const InferenceSidecarRuntimeConfig& config) {
+  const int num_cpus = config.cpuset_size() > 0
+                           ? config.cpuset_size()
+                           : std::thread::hardware_concurrency();
+  return std::max(1, num_cpus / std::max(1, config.num_intraop_threads()));
+}
+
+std::vector<std::vector<int>> GetWorkerCpus(const std::vector<int>& cpus,
+                                            int num_workers) {
+  std::vector<std::vector<int>> worker_cpus(num_workers);
+  if (cpus.empty()) {
+    return worker_cpus;
+  }
+  const int num_cpus = cpus.size();
+  if (num_cpus < num_workers) {
+    for (int i = 0; i < num_workers; ++i) {
+      worker_cpus[i].push_back(cpus[i % num_cpus]);
+    }
+    return worker_cpus;
+  }
+  for (int i = 0; i < num_workers; ++i) {
+    worker_cpus[i].assign(cpus.begin() + i * num_cpus / num_workers,
+                          cpus.begin() + (i + 1) * num_cpus / num_workers);
+  }
+  return worker_cpus;
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
@@ -0,0 +1,94 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef SERVICES_INFERENCE_SIDECAR_COMMON_UTILS_WORKER_POOL_H_
+#define SERVICES_INFERENCE_SIDECAR_COMMON_UTILS_WORKER_POOL_H_
+
+#include <deque>
+#include <future>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/synchronization/mutex.h"
+#include "proto/inference_sidecar.pb.h"
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+
+// Fixed set of long-lived threads running the inference tasks of the predict
+// requests. Unlike std::async, it does not create an OS thread per task.
+class WorkerPool {
+ public:
+  // Starts `num_workers` threads. If `cpus` is not empty, each worker is
+  // pinned to its slice of the given CPU IDs (see `GetWorkerCpus`), which the
+  // threads it spawns (e.g. intra-op threads) inherit.
+  explicit WorkerPool(int num_workers, const std::vector<int>& cpus = {});
+
+  // Runs the tasks already queued and joins the workers.
+  ~WorkerPool();
+
+  // Not copyable or movable.
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  // Queues `task` and returns the future of its result.
+  template <typename Task>
+  std::future<std::invoke_result_t<Task>> Submit(Task task)
+      ABSL_LOCKS_EXCLUDED(mu_) {
+    std::packaged_task<std::invoke_result_t<Task>()> packaged_task(
+        std::move(task));
+    std::future<std::invoke_result_t<Task>> result =
+        packaged_task.get_future();
+    Enqueue([packaged_task = std::move(packaged_task)]() mutable {
+      packaged_task();
+    });
+    return result;
+  }
+
+  int num_workers() const { return workers_.size(); }
+
+ private:
+  void Enqueue(absl::AnyInvocable<void()> task) ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Runs the queued tasks until the pool is destroyed.
+  void Work() ABSL_LOCKS_EXCLUDED(mu_);
+
+  bool HasWork() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    return !tasks_.empty() || stopping_;
+  }
+
+  absl::Mutex mu_;
+  std::deque<absl::AnyInvocable<void()>> tasks_ ABSL_GUARDED_BY(mu_);
+  bool stopping_ ABSL_GUARDED_BY(mu_) = false;
+  std::vector<std::thread> workers_;
+};
+
+// Returns the number of inference workers for the runtime config. The CPUs of
+// `cpuset` (or of the machine, if it is not set) are shared among workers that
+// each use `num_intraop_threads` threads, with at least one worker.
+int GetNumInferenceWorkers(const InferenceSidecarRuntimeConfig& config);
+
+// Splits `cpus` into `num_workers` disjoint slices of consecutive CPU IDs
+// which together cover `cpus`. Slice sizes differ by at most one. If there are
+// fewer CPUs than workers, each worker gets a single CPU in a round-robin
+// fashion instead.
+std::vector<std::vector<int>> GetWorkerCpus(const std::vector<int>& cpus,
+                                            int num_workers);
+
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
+
+#endif  // SERVICES_INFERENCE_SIDECAR_COMMON_UTILS_WORKER_POOL_H_
@@ -0,0 +1,175 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "utils/worker_pool.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/notification.h"
+#include "googletest/include/gtest/gtest.h"
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+namespace {
+
+TEST(WorkerPoolTest, ReturnsTaskResults) {
+  WorkerPool pool(/*num_workers=*/4);
+  std::vector<std::future<absl::StatusOr<int>>> results;
+  for (int i = 0; i < 100; ++i) {
+    results.push_back(
+        pool.Submit([i]() -> absl::StatusOr<int> { return i * i; }));
+  }
+  for (int i = 0; i < 100; ++i) {
+    absl::StatusOr<int> result = results[i].get();
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ(*result, i * i);
+  }
+}
+
+TEST(WorkerPoolTest, AcceptsMoveOnlyTasks) {
+  WorkerPool pool(/*num_workers=*/1);
+  auto value = std::make_unique<int>(7);
+  std::future<int> result =
+      pool.Submit([value = std::move(value)]() { return *value; });
+  EXPECT_EQ(result.get(), 7);
+}
+
+TEST(WorkerPoolTest, RunsTasksOnTheSameThreads) {
+  constexpr int kNumWorkers = 2;
+  WorkerPool pool(kNumWorkers);
+  EXPECT_EQ(pool.num_workers(), kNumWorkers);
+  std::vector<std::future<std::thread::id>> results;
+  for (int i = 0; i < 50; ++i) {
+    results.push_back(pool.Submit([]() { return std::this_thread::get_id(); }));
+  }
+  std::vector<std::thread::id> thread_ids;
+  for (std::future<std::thread::id>& result : results) {
+    std::thread::id thread_id = result.get();
+    if (std::find(thread_ids.begin(), thread_ids.end(), thread_id) ==
+        thread_ids.end()) {
+      thread_ids.push_back(thread_id);
+    }
+  }
+  EXPECT_LE(thread_ids.size(), kNumWorkers);
+}
+
+TEST(WorkerPoolTest, RunsQueuedTasksBeforeDestruction) {
+  std::atomic<int> num_runs = 0;
+  {
+    WorkerPool pool(/*num_workers=*/1);
+    for (int i = 0; i < 10; ++i) {
+      pool.Submit([&num_runs]() { ++num_runs; });
+    }
+  }
+  EXPECT_EQ(num_runs, 10);
+}
+
+TEST(WorkerPoolTest, PinsWorkersToCpus) {
+  WorkerPool pool(/*num_workers=*/1, /*cpus=*/{0});
+  EXPECT_EQ(pool.Submit([]() { return sched_getcpu(); }).get(), 0);
+}
+
+// Returns the CPUs the calling thread can run on.
+std::vector<int> GetThreadCpus() {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  std::vector<int> cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &cpu_set)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+TEST(WorkerPoolTest, PinsWorkersToDisjointCpuSlices) {
+  const std::vector<int> cpus = GetThreadCpus();
+  if (cpus.size() < 2) {
+    GTEST_SKIP() << "Requires at least 2 CPUs";
+  }
+  constexpr int kNumWorkers = 2;
+  WorkerPool pool(kNumWorkers, cpus);
+
+  // Blocks every worker in a task, so that each task runs on its own worker.
+  absl::BlockingCounter started(kNumWorkers);
+  absl::Notification release;
+  std::vector<std::future<std::vector<int>>> results;
+  for (int i = 0; i < kNumWorkers; ++i) {
+    results.push_back(pool.Submit([&started, &release]() {
+      std::vector<int> worker_cpus = GetThreadCpus();
+      started.DecrementCount();
+      release.WaitForNotification();
+      return worker_cpus;
+    }));
+  }
+  started.Wait();
+  release.Notify();
+
+  std::vector<int> all_worker_cpus;
+  for (std::future<std::vector<int>>& result : results) {
+    std::vector<int> worker_cpus = result.get();
+    EXPECT_FALSE(worker_cpus.empty());
+    all_worker_cpus.insert(all_worker_cpus.end(), worker_cpus.begin(),
+                           worker_cpus.end());
+  }
+  // The worker CPUs are disjoint if no CPU appears twice.
+  std::sort(all_worker_cpus.begin(), all_worker_cpus.end());
+  EXPECT_EQ(all_worker_cpus, cpus);
+}
+
+TEST(GetWorkerCpusTest, SplitsCpusIntoDisjointSlices) {
+  EXPECT_EQ(GetWorkerCpus({0, 1, 2, 3, 4, 5, 6, 7}, 4),
+            std::vector<std::vector<int>>({{0, 1}, {2, 3}, {4, 5}, {6, 7}}));
+  EXPECT_EQ(GetWorkerCpus({0, 1, 2, 3, 4, 5, 6}, 3),
+            std::vector<std::vector<int>>({{0, 1}, {2, 3}, {4, 5, 6}}));
+  EXPECT_EQ(GetWorkerCpus({4, 5, 6}, 1),
+            std::vector<std::vector<int>>({{4, 5, 6}}));
+}
+
+TEST(GetWorkerCpusTest, SharesCpusIfFewerThanWorkers) {
+  EXPECT_EQ(GetWorkerCpus({0, 1}, 3),
+            std::vector<std::vector<int>>({{0}, {1}, {0}}));
+}
+
+TEST(GetNumInferenceWorkersTest, UsesCpuset) {
+  InferenceSidecarRuntimeConfig config;
+  config.add_cpuset(0);
+  config.add_cpuset(1);
+  config.add_cpuset(2);
+  config.add_cpuset(3);
+  EXPECT_EQ(GetNumInferenceWorkers(config), 4);
+  config.set_num_intraop_threads(2);
+  EXPECT_EQ(GetNumInferenceWorkers(config), 2);
+  config.set_num_intraop_threads(8);
+  EXPECT_EQ(GetNumInferenceWorkers(config), 1);
+}
+
+TEST(GetNumInferenceWorkersTest, DefaultsToMachineCpus) {
+  InferenceSidecarRuntimeConfig config;
+  EXPECT_EQ(GetNumInferenceWorkers(config),
+            std::max(1u, std::thread::hardware_concurrency()));
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
@@ -18,10 +18,12 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <future>
 #include <istream>
 #include <memory>
 #include <optional>
+#include <streambuf>
 #include <string>
 #include <utility>
 #include <vector>
@@ -36,12 +38,15 @@
 #include "modules/module_interface.h"
 #include "proto/inference_sidecar.pb.h"
 #include "src/util/status_macro/status_macros.h"
+#include "utils/binary_request_parser.h"
 #include "utils/cancellation_util.h"
 #include "utils/error.h"
 #include "utils/inference_error_code.h"
 #include "utils/inference_metric_util.h"
 #include "utils/log.h"
 #include "utils/request_parser.h"
+#include "utils/shared_model_files.h"
+#include "utils/worker_pool.h"
 
 #include "pytorch_parser.h"
 #include "validator.h"
@@ -49,10 +54,30 @@
 namespace privacy_sandbox::bidding_auction_servers::inference {
 namespace {
 
-// Called on worker thread to dispatch per request inference task. It returns
-// the inference result for a single request in a batched predict request.
+// Runs the forward method of a model on the inputs of a request of the model.
 // The forward method of a torch module is non-const although we disallow
 // mutable models.
+absl::StatusOr<torch::IValue> RunModel(
+    torch::jit::script::Module& model, absl::string_view model_key,
+    std::vector<torch::jit::IValue> inputs) {
+  // Convert PyTorch exception to absl status.
+  try {
+    // Guard against Autograd.
+    c10::InferenceMode guard;
+    return model.forward(std::move(inputs));
+  } catch (const std::exception& e) {
+    return absl::InternalError(absl::StrCat(
+        kInferenceModelExecutionError, ". Message: ", "Model ", model_key,
+        " encounters an exception during evaluation: ", std::string(e.what())));
+  } catch (...) {
+    return absl::InternalError(absl::StrCat(
+        kInferenceModelExecutionError, ". Message: ", "Model ", model_key,
+        " encounters an unknown exception during evaluation"));
+  }
+}
+
+// Called on worker thread to dispatch per request inference task. It returns
+// the inference result for a single request in a batched predict request.
 absl::StatusOr<torch::IValue> PredictInternal(
     std::shared_ptr<torch::jit::script::Module> model,
     const InferenceRequest& request) {
@@ -69,21 +94,92 @@ absl::StatusOr<torch::IValue> PredictInternal(
     }
     inputs.push_back(*std::move(torch_tensor));
   }
-  torch::IValue inference_result;
-  // Convert PyTorch exception to absl status.
-  try {
-    // Guard against Autograd.
-    c10::InferenceMode guard;
-    return model->forward(inputs);
-  } catch (const std::exception& e) {
-    return absl::InternalError(absl::StrCat(
-        kInferenceModelExecutionError, ". Message: ", "Model ", model_key,
-        " encounters an exception during evaluation: ", std::string(e.what())));
-  } catch (...) {
-    return absl::InternalError(absl::StrCat(
-        kInferenceModelExecutionError, ". Message: ", "Model ", model_key,
-        " encounters an unknown exception during evaluation"));
+  return RunModel(*model, model_key, std::move(inputs));
+}
+
+// Same as above for a request of a binary predict request. The input tensors
+// point into the request.
+absl::StatusOr<torch::IValue> PredictInternal(
+    std::shared_ptr<torch::jit::script::Module> model,
+    const BinaryInferenceRequest& request) {
+  absl::string_view model_key = request.model_path;
+  std::vector<torch::jit::IValue> inputs;
+  inputs.reserve(request.inputs.size());
+  for (const BinaryTensor& tensor : request.inputs) {
+    absl::StatusOr<torch::Tensor> torch_tensor = ConvertBinaryToTensor(tensor);
+    if (!torch_tensor.ok()) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          kInferenceInputTensorConversionError, ". Message: ", "Model ",
+          model_key, " encounters tensor parsing error: ",
+          torch_tensor.status().message()));
+    }
+    inputs.push_back(*std::move(torch_tensor));
   }
+  return RunModel(*model, model_key, std::move(inputs));
+}
+
+// An inference request of a JSON or binary predict request.
+struct ParsedRequest {
+  std::string model_path;
+  // Set if the request couldn't be parsed.
+  std::optional<Error> error;
+  // Size of the first dimension of the first input tensor.
+  int batch_count = 0;
+  // Runs the inference of the request with its model.
+  std::function<absl::StatusOr<torch::IValue>(
+      std::shared_ptr<torch::jit::script::Module>)>
+      predict;
+};
+
+absl::StatusOr<std::vector<ParsedRequest>> ParseJsonRequests(
+    absl::string_view input) {
+  PS_ASSIGN_OR_RETURN(std::vector<ParsedRequestOrError> parsed_requests,
+                      ParseJsonInferenceRequest(input));
+  std::vector<ParsedRequest> requests;
+  requests.reserve(parsed_requests.size());
+  for (ParsedRequestOrError& parsed_request : parsed_requests) {
+    if (parsed_request.request) {
+      const std::string model_path = parsed_request.request->model_path;
+      const int batch_count =
+          parsed_request.request->inputs[0].tensor_shape[0];
+      requests.push_back(ParsedRequest{
+          .model_path = model_path,
+          .batch_count = batch_count,
+          .predict = [inference_request = *std::move(parsed_request.request)](
+                         std::shared_ptr<torch::jit::script::Module> model) {
+            return PredictInternal(std::move(model), inference_request);
+          }});
+    } else {
+      requests.push_back(
+          ParsedRequest{.model_path = parsed_request.error->model_path,
+                        .error = parsed_request.error});
+    }
+  }
+  return requests;
+}
+
+// The returned requests point into `input`, which must outlive them.
+absl::StatusOr<std::vector<ParsedRequest>> ParseBinaryRequests(
+    absl::string_view input) {
+  PS_ASSIGN_OR_RETURN(std::vector<BinaryInferenceRequest> parsed_requests,
+                      ParseBinaryInferenceRequest(input));
+  std::vector<ParsedRequest> requests;
+  requests.reserve(parsed_requests.size());
+  for (BinaryInferenceRequest& parsed_request : parsed_requests) {
+    int batch_count = 0;
+    if (!parsed_request.inputs.empty() &&
+        !parsed_request.inputs[0].tensor_shape.empty()) {
+      batch_count = parsed_request.inputs[0].tensor_shape[0];
+    }
+    requests.push_back(ParsedRequest{
+        .model_path = std::string(parsed_request.model_path),
+        .batch_count = batch_count,
+        .predict = [inference_request = std::move(parsed_request)](
+                       std::shared_ptr<torch::jit::script::Module> model) {
+          return PredictInternal(std::move(model), inference_request);
+        }});
+  }
+  return requests;
 }
 
 // Initializes PyTorch runtime inter-operations and intra-operations parallelism
@@ -109,6 +205,35 @@ absl::Status InitRuntimeThreadConfig(
   return absl::OkStatus();
 }
 
+// Read-only stream buffer over a model payload, so that the model is loaded
+// from the payload (e.g. a memory-mapped model file) without copying it.
+class PayloadStreamBuf : public std::streambuf {
+ public:
+  explicit PayloadStreamBuf(absl::string_view payload) {
+    // The buffer is never written to.
+    char* begin = const_cast<char*>(payload.data());
+    setg(begin, begin, begin + payload.size());
+  }
+
+ protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                   std::ios_base::openmode which) override {
+    char* base = dir == std::ios_base::beg   ? eback()
+                 : dir == std::ios_base::cur ? gptr()
+                                             : egptr();
+    if (!(which & std::ios_base::in) || off < eback() - base ||
+        off > egptr() - base) {
+      return pos_type(off_type(-1));
+    }
+    setg(eback(), base + off, egptr());
+    return pos_type(gptr() - eback());
+  }
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+  }
+};
+
 absl::StatusOr<std::shared_ptr<torch::jit::script::Module>>
 PyTorchModelConstructor(const InferenceSidecarRuntimeConfig& config,
                         const RegisterModelRequest& request,
@@ -116,9 +241,15 @@ PyTorchModelConstructor(const InferenceSidecarRuntimeConfig& config,
   torch::jit::script::Module model;
   // Converts PyTorch exception to absl status.
   try {
-    const std::string& model_payload = request.model_files().begin()->second;
-    std::istringstream is(model_payload);
-    model = torch::jit::load(is);
+    // The model consists of exactly one file, sent in the request or shared
+    // through a memory-mapped file.
+    PS_RETURN_IF_ERROR(ForEachModelFile(
+        request, [&model](absl::string_view path, absl::string_view payload) {
+          PayloadStreamBuf buffer(payload);
+          std::istream is(&buffer);
+          model = torch::jit::load(is);
+          return absl::OkStatus();
+        }));
     // Turn on eval model for layers that behave differently during train and
     // eval times, for example, dropout and batch norm layers.
     model.eval();
@@ -196,6 +327,9 @@ PyTorchModule::PyTorchModule(const InferenceSidecarRuntimeConfig& config)
   absl::Status init_result = InitRuntimeThreadConfig(config);
   CHECK(init_result.ok()) << "Could not initialize runtime flags: "
                           << init_result;
+  worker_pool_ = std::make_unique<WorkerPool>(
+      GetNumInferenceWorkers(config),
+      std::vector<int>(config.cpuset().begin(), config.cpuset().end()));
 }
 
 absl::StatusOr<PredictResponse> PyTorchModule::Predict(
@@ -205,8 +339,9 @@ absl::StatusOr<PredictResponse> PyTorchModule::Predict(
   PredictResponse predict_response;
   absl::Time start_inference_execution_time = absl::Now();
   AddMetric(predict_response, "kInferenceRequestSize", request.ByteSizeLong());
-  absl::StatusOr<std::vector<ParsedRequestOrError>> parsed_requests =
-      ParseJsonInferenceRequest(request.input());
+  absl::StatusOr<std::vector<ParsedRequest>> parsed_requests =
+      request.has_binary_input() ? ParseBinaryRequests(request.binary_input())
+                                 : ParseJsonRequests(request.input());
   if (!parsed_requests.ok()) {
     AddMetric(predict_response, "kInferenceErrorCountByErrorCode", 1,
               std::string(kInferenceUnableToParseRequest));
@@ -223,10 +358,9 @@ absl::StatusOr<PredictResponse> PyTorchModule::Predict(
       parsed_requests->size());
   std::vector<PerModelOutput> batch_outputs(parsed_requests->size());
   for (size_t task_id = 0; task_id < parsed_requests->size(); ++task_id) {
-    if ((*parsed_requests)[task_id].request) {
-      const InferenceRequest& inference_request =
-          (*parsed_requests)[task_id].request.value();
-      const std::string& model_key = inference_request.model_path;
+    ParsedRequest& parsed_request = (*parsed_requests)[task_id];
+    if (!parsed_request.error) {
+      const std::string& model_key = parsed_request.model_path;
       INFERENCE_LOG(INFO, request_context)
           << "Received inference request to model: " << model_key;
       absl::StatusOr<std::shared_ptr<torch::jit::script::Module>> model =
@@ -247,23 +381,22 @@ absl::StatusOr<PredictResponse> PyTorchModule::Predict(
         // partition for unregistered models.
         AddMetric(predict_response, "kInferenceRequestCountByModel", 1,
                   model_key);
-        int batch_count = inference_request.inputs[0].tensor_shape[0];
         AddMetric(predict_response, "kInferenceRequestBatchCountByModel",
-                  batch_count, model_key);
-        tasks[task_id] =
-            std::async(std::launch::async,
-                       [&server_context, model = *model,
-                        inference_request]() -> absl::StatusOr<torch::IValue> {
-                         RETURN_IF_CANCELLED(server_context,
-                                             CancelLocation::kPredictAsync);
-                         return PredictInternal(model, inference_request);
-                       });
+                  parsed_request.batch_count, model_key);
+        tasks[task_id] = worker_pool_->Submit(
+            [&server_context, model = *model,
+             predict = std::move(parsed_request.predict)]()
+                -> absl::StatusOr<torch::IValue> {
+              RETURN_IF_CANCELLED(server_context,
+                                  CancelLocation::kPredictAsync);
+              return predict(model);
+            });
       }
 
     } else {
-      const Error error = (*parsed_requests)[task_id].error.value();
       batch_outputs[task_id] =
-          PerModelOutput{.model_path = error.model_path, .error = error};
+          PerModelOutput{.model_path = parsed_request.model_path,
+                         .error = parsed_request.error};
     }
   }
 
@@ -271,8 +404,7 @@ absl::StatusOr<PredictResponse> PyTorchModule::Predict(
     if (!batch_outputs[task_id].error) {
       // Task launch is not blocked by a get model error.
       absl::StatusOr<torch::IValue> task_result = tasks[task_id].get();
-      const std::string& model_path =
-          (*parsed_requests)[task_id].request.value().model_path;
+      const std::string& model_path = (*parsed_requests)[task_id].model_path;
       if (!task_result.ok()) {
         AddMetric(predict_response, "kInferenceRequestFailedCountByModel", 1,
                   model_path);
@@ -315,10 +447,9 @@ absl::StatusOr<PredictResponse> PyTorchModule::Predict(
     return predict_response;
   }
 
-  for (const ParsedRequestOrError& parsed_request : *parsed_requests) {
-    if (parsed_request.request) {
-      store_->IncrementModelInferenceCount(
-          parsed_request.request.value().model_path);
+  for (const ParsedRequest& parsed_request : *parsed_requests) {
+    if (!parsed_request.error) {
+      store_->IncrementModelInferenceCount(parsed_request.model_path);
     }
   }
 
@@ -340,10 +471,10 @@ absl::StatusOr<RegisterModelResponse> PyTorchModule::RegisterModel(
   if (model_key.empty()) {
     return absl::InvalidArgumentError("Empty model key during registration");
   }
-  if (request.model_files().size() != 1) {
+  if (GetModelFileCount(request) != 1) {
     return absl::InvalidArgumentError(absl::StrCat(
         "The number of model files should be exactly one to match size()=",
-        request.model_files().size()));
+        GetModelFileCount(request)));
   }
 
   if (store_->GetModel(model_key).ok()) {
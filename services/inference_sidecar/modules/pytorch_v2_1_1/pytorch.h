@@ -26,6 +26,7 @@
 #include "model/model_store.h"
 #include "modules/module_interface.h"
 #include "proto/inference_sidecar.pb.h"
+#include "utils/worker_pool.h"
 
 namespace privacy_sandbox::bidding_auction_servers::inference {
 
@@ -57,6 +58,9 @@ class PyTorchModule final : public ModuleInterface {
 
   // Stores a set of models. It's thread safe.
   std::unique_ptr<ModelStore<torch::jit::script::Module>> store_;
+
+  // Runs the per-model inference tasks of the predict requests.
+  std::unique_ptr<WorkerPool> worker_pool_;
 };
 
 }  // namespace privacy_sandbox::bidding_auction_servers::inference
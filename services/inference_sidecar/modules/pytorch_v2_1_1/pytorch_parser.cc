@@ -21,6 +21,7 @@
 
 #include "rapidjson/document.h"
 #include "src/util/status_macro/status_macros.h"
+#include "utils/binary_request_parser.h"
 #include "utils/error.h"
 #include "utils/json_util.h"
 #include "utils/request_parser.h"
@@ -154,6 +155,51 @@ absl::StatusOr<torch::Tensor> ConvertFlatArrayToTensor(const Tensor& tensor) {
   }
 }
 
+absl::StatusOr<torch::Tensor> ConvertBinaryToTensor(
+    const BinaryTensor& tensor) {
+  torch::ScalarType scalar_type;
+  switch (tensor.data_type) {
+    case DataType::kFloat:
+      scalar_type = torch::kFloat;
+      break;
+    case DataType::kDouble:
+      scalar_type = torch::kDouble;
+      break;
+    case DataType::kInt8:
+      scalar_type = torch::kChar;
+      break;
+    case DataType::kInt16:
+      scalar_type = torch::kShort;
+      break;
+    case DataType::kInt32:
+      scalar_type = torch::kInt;
+      break;
+    case DataType::kInt64:
+      scalar_type = torch::kLong;
+      break;
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrFormat("Unsupported data type %d", tensor.data_type));
+  }
+  size_t num_elements = 1;
+  for (int64_t dim : tensor.tensor_shape) {
+    num_elements *= dim;
+  }
+  if (tensor.tensor_content.size() !=
+      num_elements * GetDataTypeSize(tensor.data_type)) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "The tensor content size %d doesn't match the tensor shape",
+        tensor.tensor_content.size()));
+  }
+  // The binary format aligns the tensor content within the request, so that
+  // the values are aligned to their size in the request buffer.
+  // PyTorch has no read-only tensors, and freezing the model doesn't rule out
+  // in-place operations on its inputs. The content isn't copied since models
+  // must not modify their inputs (see the README).
+  return torch::from_blob(const_cast<char*>(tensor.tensor_content.data()),
+                          tensor.tensor_shape, torch::dtype(scalar_type));
+}
+
 absl::StatusOr<std::string> ConvertBatchOutputsToJson(
     const std::vector<PerModelOutput>& batch_outputs) {
   rapidjson::Document document;
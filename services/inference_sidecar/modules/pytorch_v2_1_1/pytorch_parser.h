@@ -22,6 +22,7 @@
 #include <torch/script.h>
 
 #include "absl/status/statusor.h"
+#include "utils/binary_request_parser.h"
 #include "utils/error.h"
 #include "utils/request_parser.h"
 
@@ -37,6 +38,13 @@ struct PerModelOutput {
 // one-dimensional array) into a PyTorch tensor and the desired tensor shape.
 absl::StatusOr<torch::Tensor> ConvertFlatArrayToTensor(const Tensor& tensor);
 
+// Wraps the content of a binary request tensor into a PyTorch tensor without
+// copying it. The returned tensor points into the request, which must outlive
+// it. The tensor is writable for PyTorch, but must not be modified: models
+// served with binary requests must not modify their inputs in place.
+absl::StatusOr<torch::Tensor> ConvertBinaryToTensor(
+    const BinaryTensor& tensor);
+
 // Converts inference output corresponding to each model to a JSON string.
 absl::StatusOr<std::string> ConvertBatchOutputsToJson(
     const std::vector<PerModelOutput>& batch_outputs);
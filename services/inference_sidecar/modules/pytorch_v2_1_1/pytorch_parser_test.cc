@@ -15,11 +15,13 @@
 #include "pytorch_parser.h"
 
 #include <utility>
+#include <vector>
 
 #include <torch/script.h>
 #include <torch/torch.h>
 
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "googletest/include/gtest/gtest.h"
 #include "utils/request_parser.h"
 
@@ -148,6 +150,44 @@ TEST(PyTorchModuleTest, TestConversion_WrongType) {
   EXPECT_EQ(result.status().message(), "Error in int64 conversion");
 }
 
+TEST(PyTorchModuleTest, TestBinaryConversion) {
+  const std::vector<float> values = {1.2, -2, 3, 4, 5, 6};
+  BinaryTensor tensor{
+      .data_type = DataType::kFloat,
+      .tensor_shape = {2, 3},
+      .tensor_content = absl::string_view(
+          reinterpret_cast<const char*>(values.data()),
+          values.size() * sizeof(float))};
+
+  const absl::StatusOr<torch::Tensor> result = ConvertBinaryToTensor(tensor);
+  ASSERT_TRUE(result.ok()) << result.status();
+  const torch::Tensor torch_tensor = *std::move(result);
+
+  EXPECT_EQ(torch_tensor.dtype(), torch::kFloat);
+  EXPECT_EQ(torch_tensor.dim(), 2);
+  EXPECT_EQ(torch_tensor.size(0), 2);
+  EXPECT_EQ(torch_tensor.size(1), 3);
+  // The tensor uses the request memory in place.
+  EXPECT_EQ(torch_tensor.data_ptr(), values.data());
+  EXPECT_FLOAT_EQ(torch_tensor[0][0].item<float>(), 1.2);
+  EXPECT_FLOAT_EQ(torch_tensor[1][2].item<float>(), 6.0);
+}
+
+TEST(PyTorchModuleTest, TestBinaryConversion_WrongSize) {
+  const std::vector<int64_t> values = {1, 2, 3};
+  BinaryTensor tensor{
+      .data_type = DataType::kInt64,
+      .tensor_shape = {2, 2},
+      .tensor_content = absl::string_view(
+          reinterpret_cast<const char*>(values.data()),
+          values.size() * sizeof(int64_t))};
+
+  const absl::StatusOr<torch::Tensor> result = ConvertBinaryToTensor(tensor);
+
+  EXPECT_FALSE(result.ok());
+  EXPECT_EQ(result.status().code(), absl::StatusCode::kInvalidArgument);
+}
+
 TEST(PyTorchModuleTest, ConvertBatchOutputsToJson_UnsupportedType) {
   PerModelOutput output;
   output.model_path = "/path/to/model";
@@ -46,6 +46,7 @@
 #include "modules/module_interface.h"
 #include "proto/inference_sidecar.grpc.pb.h"
 #include "proto/inference_sidecar.pb.h"
+#include "utils/binary_request_parser.h"
 #include "utils/file_util.h"
 #include "utils/inference_metric_util.h"
 #include "utils/log.h"
@@ -329,6 +330,51 @@ TEST(PyTorchModulePredictTest, PredictSimpleSuccess) {
   EXPECT_EQ(result->metrics_list().size(), 7);
 }
 
+TEST(PyTorchModulePredictTest, PredictSimpleBinarySuccess) {
+  InferenceSidecarRuntimeConfig config;
+  std::unique_ptr<ModuleInterface> torch_module =
+      ModuleInterface::Create(config);
+  RegisterModelRequest register_request;
+  ASSERT_TRUE(
+      PopulateRegisterModelRequest(kSimpleModel, register_request).ok());
+  ASSERT_TRUE(torch_module->RegisterModel(register_request).ok());
+
+  // The binary equivalent of `kSimpleRequest`.
+  const double value = 3.14;
+  const BinaryInferenceRequest binary_request{
+      .model_path = kSimpleModel,
+      .inputs = {{.data_type = DataType::kDouble,
+                  .tensor_shape = {1},
+                  .tensor_content = absl::string_view(
+                      reinterpret_cast<const char*>(&value), sizeof(value))}}};
+  PredictRequest predict_request;
+  predict_request.set_binary_input(
+      SerializeBinaryInferenceRequest({binary_request}));
+
+  const absl::StatusOr<PredictResponse> result =
+      torch_module->Predict(predict_request);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result->output(), kSimpleRequestResponse);
+  ASSERT_FALSE(result->metrics_list().empty());
+  EXPECT_EQ(result->metrics_list().size(), 7);
+}
+
+TEST(PyTorchModulePredictTest, PredictInvalidBinaryReturnsParsingJsonError) {
+  InferenceSidecarRuntimeConfig config;
+  std::unique_ptr<ModuleInterface> torch_module =
+      ModuleInterface::Create(config);
+
+  PredictRequest predict_request;
+  predict_request.set_binary_input("invalid");
+  const absl::StatusOr<PredictResponse> result =
+      torch_module->Predict(predict_request);
+  ASSERT_TRUE(result.ok());
+  EXPECT_THAT(
+      result->output(),
+      StartsWith(
+          R"({"response":[{"error":{"error_type":"INPUT_PARSING","description")"));
+}
+
 constexpr char kSimpleRequest2Models[] = R"json({
   "request" : [{
     "model_path" : "./benchmark_models/pcvr",
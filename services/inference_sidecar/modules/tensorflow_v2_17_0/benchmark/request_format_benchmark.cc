@@ -0,0 +1,227 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This benchmark compares the JSON and binary inference request formats on the
+// pcvr benchmark model.
+//
+// Run the benchmark as follows:
+// builders/tools/bazel-debian run //benchmark:request_format_benchmark -- \
+//   --benchmark_counters_tabular=true --benchmark_repetitions=5 \
+//   --benchmark_min_warmup_time=1 > /tmp/report.txt
+//
+// The argument of each benchmark is the batch size of the input tensors, i.e.
+// the size of their first dimension.
+//
+// * `BM_Parse<Format>`: Parses a request into the generic representation of
+//   the sidecar.
+// * `BM_Predict<Format>`: Runs a request end to end in the TensorFlow module,
+//   including the conversion of the inputs to TensorFlow tensors.
+//
+// `RequestBytes` is the size of the request.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
+#include "benchmark/benchmark.h"
+#include "modules/module_interface.h"
+#include "proto/inference_sidecar.pb.h"
+#include "utils/binary_request_parser.h"
+#include "utils/file_util.h"
+#include "utils/request_parser.h"
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+namespace {
+
+constexpr absl::string_view kPcvrModelPath = "./benchmark_models/pcvr";
+constexpr int kNumDoubleFeatures = 10;
+constexpr int kMaxBatchSize = 256;
+constexpr absl::string_view kDoubleInputs[] = {"serving_default_double1:0",
+                                               "serving_default_double2:0"};
+constexpr absl::string_view kIntInputs[] = {
+    "serving_default_int_input1:0", "serving_default_int_input2:0",
+    "serving_default_int_input3:0", "serving_default_int_input4:0",
+    "serving_default_int_input5:0"};
+
+// Input values of a pcvr request with `batch_size` rows.
+struct PcvrInputs {
+  explicit PcvrInputs(int batch_size)
+      : doubles(batch_size * kNumDoubleFeatures), ints(batch_size) {
+    for (size_t i = 0; i < doubles.size(); ++i) {
+      doubles[i] = 0.01 * (i % 100);
+    }
+    for (size_t i = 0; i < ints.size(); ++i) {
+      ints[i] = i % 10;
+    }
+  }
+
+  std::vector<double> doubles;
+  std::vector<int64_t> ints;
+};
+
+template <typename T>
+absl::string_view AsBytes(const std::vector<T>& values) {
+  return absl::string_view(reinterpret_cast<const char*>(values.data()),
+                           values.size() * sizeof(T));
+}
+
+std::string CreateJsonTensor(absl::string_view name,
+                             absl::string_view data_type, int batch_size,
+                             int num_features,
+                             const std::vector<std::string>& values) {
+  return absl::StrCat(R"({"tensor_name":")", name, R"(","data_type":")",
+                      data_type, R"(","tensor_shape":[)", batch_size, ",",
+                      num_features, R"(],"tensor_content":[")",
+                      absl::StrJoin(values, R"(",")"), R"("]})");
+}
+
+std::string CreatePcvrJsonRequest(const PcvrInputs& inputs, int batch_size) {
+  std::vector<std::string> doubles;
+  for (double value : inputs.doubles) {
+    doubles.push_back(absl::StrCat(value));
+  }
+  std::vector<std::string> ints;
+  for (int64_t value : inputs.ints) {
+    ints.push_back(absl::StrCat(value));
+  }
+  std::vector<std::string> tensors;
+  for (absl::string_view name : kDoubleInputs) {
+    tensors.push_back(CreateJsonTensor(name, "DOUBLE", batch_size,
+                                       kNumDoubleFeatures, doubles));
+  }
+  for (absl::string_view name : kIntInputs) {
+    tensors.push_back(CreateJsonTensor(name, "INT64", batch_size, 1, ints));
+  }
+  return absl::StrCat(R"({"request":[{"model_path":")", kPcvrModelPath,
+                      R"(","tensors":[)", absl::StrJoin(tensors, ","), "]}]}");
+}
+
+std::string CreatePcvrBinaryRequest(const PcvrInputs& inputs,
+                                    int batch_size) {
+  BinaryInferenceRequest request{.model_path = kPcvrModelPath};
+  for (absl::string_view name : kDoubleInputs) {
+    request.inputs.push_back(
+        BinaryTensor{.tensor_name = name,
+                     .data_type = DataType::kDouble,
+                     .tensor_shape = {batch_size, kNumDoubleFeatures},
+                     .tensor_content = AsBytes(inputs.doubles)});
+  }
+  for (absl::string_view name : kIntInputs) {
+    request.inputs.push_back(
+        BinaryTensor{.tensor_name = name,
+                     .data_type = DataType::kInt64,
+                     .tensor_shape = {batch_size, 1},
+                     .tensor_content = AsBytes(inputs.ints)});
+  }
+  return SerializeBinaryInferenceRequest({request});
+}
+
+void ExportRequestSize(benchmark::State& state, const std::string& request) {
+  state.SetItemsProcessed(state.iterations());
+  state.counters["RequestBytes"] = request.size();
+}
+
+static void BM_ParseJson(benchmark::State& state) {
+  const int batch_size = state.range(0);
+  const std::string request =
+      CreatePcvrJsonRequest(PcvrInputs(batch_size), batch_size);
+  for (auto _ : state) {
+    absl::StatusOr<std::vector<ParsedRequestOrError>> parsed_requests =
+        ParseJsonInferenceRequest(request);
+    CHECK(parsed_requests.ok()) << parsed_requests.status();
+    benchmark::DoNotOptimize(parsed_requests);
+  }
+  ExportRequestSize(state, request);
+}
+
+static void BM_ParseBinary(benchmark::State& state) {
+  const int batch_size = state.range(0);
+  const std::string request =
+      CreatePcvrBinaryRequest(PcvrInputs(batch_size), batch_size);
+  for (auto _ : state) {
+    absl::StatusOr<std::vector<BinaryInferenceRequest>> parsed_requests =
+        ParseBinaryInferenceRequest(request);
+    CHECK(parsed_requests.ok()) << parsed_requests.status();
+    benchmark::DoNotOptimize(parsed_requests);
+  }
+  ExportRequestSize(state, request);
+}
+
+class PcvrModuleFixture : public benchmark::Fixture {
+ public:
+  void SetUp(::benchmark::State& state) {
+    InferenceSidecarRuntimeConfig config;
+    module_ = ModuleInterface::Create(config);
+    RegisterModelRequest register_request;
+    CHECK(PopulateRegisterModelRequest(kPcvrModelPath, register_request).ok());
+    absl::StatusOr response = module_->RegisterModel(register_request);
+    CHECK(response.ok()) << response.status().message();
+  }
+  void TearDown(::benchmark::State& state) { module_.reset(); }
+
+ protected:
+  void RunPredict(benchmark::State& state,
+                  const PredictRequest& predict_request) {
+    for (auto _ : state) {
+      absl::StatusOr response = module_->Predict(predict_request);
+      CHECK(response.ok()) << response.status().message();
+      CHECK(!absl::StrContains(response->output(), "error"))
+          << response->output();
+    }
+  }
+
+  std::unique_ptr<ModuleInterface> module_;
+};
+
+BENCHMARK_DEFINE_F(PcvrModuleFixture, BM_PredictJson)
+(benchmark::State& state) {
+  const int batch_size = state.range(0);
+  PredictRequest predict_request;
+  predict_request.set_input(
+      CreatePcvrJsonRequest(PcvrInputs(batch_size), batch_size));
+  RunPredict(state, predict_request);
+  ExportRequestSize(state, predict_request.input());
+}
+
+BENCHMARK_DEFINE_F(PcvrModuleFixture, BM_PredictBinary)
+(benchmark::State& state) {
+  const int batch_size = state.range(0);
+  PredictRequest predict_request;
+  predict_request.set_binary_input(
+      CreatePcvrBinaryRequest(PcvrInputs(batch_size), batch_size));
+  RunPredict(state, predict_request);
+  ExportRequestSize(state, predict_request.binary_input());
+}
+
+// Registers the functions to the benchmark.
+BENCHMARK(BM_ParseJson)->RangeMultiplier(16)->Range(1, kMaxBatchSize);
+BENCHMARK(BM_ParseBinary)->RangeMultiplier(16)->Range(1, kMaxBatchSize);
+BENCHMARK_REGISTER_F(PcvrModuleFixture, BM_PredictJson)
+    ->RangeMultiplier(16)
+    ->Range(1, kMaxBatchSize);
+BENCHMARK_REGISTER_F(PcvrModuleFixture, BM_PredictBinary)
+    ->RangeMultiplier(16)
+    ->Range(1, kMaxBatchSize);
+
+// Runs the benchmark.
+BENCHMARK_MAIN();
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
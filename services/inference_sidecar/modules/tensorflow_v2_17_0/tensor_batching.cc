@@ -0,0 +1,115 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tensor_batching.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "src/util/status_macro/status_macros.h"
+#include "tensorflow/core/framework/tensor_util.h"
+#include "tensorflow/core/framework/types.h"
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+
+std::optional<int64_t> GetBatchSize(const NamedTensors& inputs) {
+  std::optional<int64_t> batch_size;
+  for (const auto& [name, tensor] : inputs) {
+    if (tensor.dims() == 0) {
+      return std::nullopt;
+    }
+    if (batch_size && *batch_size != tensor.dim_size(0)) {
+      return std::nullopt;
+    }
+    batch_size = tensor.dim_size(0);
+  }
+  return batch_size;
+}
+
+std::string GetBatchingKey(const NamedTensors& inputs) {
+  std::vector<std::string> tensor_keys;
+  tensor_keys.reserve(inputs.size());
+  for (const auto& [name, tensor] : inputs) {
+    std::string tensor_key =
+        absl::StrCat(name, "|", tensorflow::DataTypeString(tensor.dtype()));
+    for (int i = 1; i < tensor.dims(); ++i) {
+      absl::StrAppend(&tensor_key, "|", tensor.dim_size(i));
+    }
+    tensor_keys.push_back(std::move(tensor_key));
+  }
+  std::sort(tensor_keys.begin(), tensor_keys.end());
+  return absl::StrJoin(tensor_keys, ";");
+}
+
+absl::StatusOr<NamedTensors> ConcatInputs(
+    absl::Span<const NamedTensors* const> inputs) {
+  if (inputs.empty()) {
+    return absl::InvalidArgumentError("No inputs to concatenate");
+  }
+  NamedTensors merged_inputs;
+  merged_inputs.reserve(inputs[0]->size());
+  for (const auto& [name, first_tensor] : *inputs[0]) {
+    std::vector<tensorflow::Tensor> tensors = {first_tensor};
+    tensors.reserve(inputs.size());
+    for (size_t i = 1; i < inputs.size(); ++i) {
+      auto it = std::find_if(
+          inputs[i]->begin(), inputs[i]->end(),
+          [&name = name](const auto& input) { return input.first == name; });
+      if (it == inputs[i]->end()) {
+        return absl::InvalidArgumentError(
+            absl::StrCat("Input tensor ", name, " is missing in request ", i));
+      }
+      tensors.push_back(it->second);
+    }
+    tensorflow::Tensor merged_tensor;
+    PS_RETURN_IF_ERROR(tensorflow::tensor::Concat(tensors, &merged_tensor));
+    merged_inputs.emplace_back(name, std::move(merged_tensor));
+  }
+  return merged_inputs;
+}
+
+absl::StatusOr<std::vector<std::vector<TensorWithName>>> SplitOutputs(
+    const std::vector<TensorWithName>& outputs,
+    absl::Span<const int64_t> batch_sizes) {
+  int64_t total_batch_size = 0;
+  for (int64_t batch_size : batch_sizes) {
+    total_batch_size += batch_size;
+  }
+  std::vector<std::vector<TensorWithName>> split_outputs(batch_sizes.size());
+  for (const TensorWithName& output : outputs) {
+    if (output.tensor.dims() == 0 ||
+        output.tensor.dim_size(0) != total_batch_size) {
+      return absl::FailedPreconditionError(absl::StrCat(
+          "Output tensor ", output.tensor_name,
+          " is not batched: expected a first dimension of ", total_batch_size,
+          ", got shape ", output.tensor.shape().DebugString()));
+    }
+    std::vector<tensorflow::Tensor> tensors;
+    PS_RETURN_IF_ERROR(
+        tensorflow::tensor::Split(output.tensor, batch_sizes, &tensors));
+    for (size_t i = 0; i < tensors.size(); ++i) {
+      split_outputs[i].emplace_back(output.tensor_name, std::move(tensors[i]));
+    }
+  }
+  return split_outputs;
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
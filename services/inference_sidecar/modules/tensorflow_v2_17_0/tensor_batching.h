@@ -0,0 +1,63 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SERVICES_INFERENCE_SIDECAR_MODULES_TENSORFLOW_V2_17_0_TENSOR_BATCHING_H_
+#define SERVICES_INFERENCE_SIDECAR_MODULES_TENSORFLOW_V2_17_0_TENSOR_BATCHING_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "tensorflow/core/framework/tensor.h"
+
+#include "tensorflow_parser.h"
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+
+// Input tensors of an inference request, keyed by tensor name as fed to
+// tensorflow::Session::Run.
+using NamedTensors = std::vector<std::pair<std::string, tensorflow::Tensor>>;
+
+// Returns the batch size of `inputs`, i.e. the size of the first dimension
+// shared by all the input tensors. Returns std::nullopt if the inputs can't be
+// batched with other requests: no inputs, a scalar input or input tensors with
+// different first dimensions.
+std::optional<int64_t> GetBatchSize(const NamedTensors& inputs);
+
+// Returns a key that is equal for the inputs that can be concatenated along
+// the batch dimension: the same tensor names with the same data types and the
+// same dimensions past the first one, regardless of the tensor order.
+std::string GetBatchingKey(const NamedTensors& inputs);
+
+// Concatenates the inputs of several requests with the same batching key along
+// the batch dimension. Tensors are matched by name and ordered as in the first
+// request.
+absl::StatusOr<NamedTensors> ConcatInputs(
+    absl::Span<const NamedTensors* const> inputs);
+
+// Splits the outputs of a batched run along the batch dimension, into one set
+// of outputs per request of size `batch_sizes[i]`. Fails if an output tensor
+// isn't batched, i.e. its first dimension isn't the sum of `batch_sizes`.
+absl::StatusOr<std::vector<std::vector<TensorWithName>>> SplitOutputs(
+    const std::vector<TensorWithName>& outputs,
+    absl::Span<const int64_t> batch_sizes);
+
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
+
+#endif  // SERVICES_INFERENCE_SIDECAR_MODULES_TENSORFLOW_V2_17_0_TENSOR_BATCHING_H_
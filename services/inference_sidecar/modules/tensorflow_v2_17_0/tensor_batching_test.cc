@@ -0,0 +1,131 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensor_batching.h"
+
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "googletest/include/gtest/gtest.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+
+namespace privacy_sandbox::bidding_auction_servers::inference {
+namespace {
+
+using ::tensorflow::TensorShape;
+using ::tensorflow::test::AsTensor;
+
+NamedTensors CreateInputs(const std::vector<float>& features,
+                          const std::vector<int64_t>& ids) {
+  const int64_t batch_size = ids.size();
+  return {
+      {"features", AsTensor<float>(features, TensorShape({batch_size, 2}))},
+      {"ids", AsTensor<int64_t>(ids, TensorShape({batch_size}))}};
+}
+
+TEST(TensorBatchingTest, GetBatchSize) {
+  EXPECT_EQ(GetBatchSize(CreateInputs({1, 2, 3, 4}, {5, 6})), 2);
+  EXPECT_EQ(GetBatchSize({}), std::nullopt);
+  EXPECT_EQ(GetBatchSize({{"scalar", AsTensor<float>({1}, TensorShape({}))}}),
+            std::nullopt);
+}
+
+TEST(TensorBatchingTest, GetBatchSizeWithMismatchedFirstDimensions) {
+  NamedTensors inputs = CreateInputs({1, 2}, {5});
+  inputs.emplace_back("other", AsTensor<float>({1, 2}, TensorShape({2})));
+
+  EXPECT_EQ(GetBatchSize(inputs), std::nullopt);
+}
+
+TEST(TensorBatchingTest, GetBatchingKeyIgnoresBatchSizeAndOrder) {
+  NamedTensors inputs = CreateInputs({1, 2, 3, 4}, {5, 6});
+  NamedTensors reversed_inputs(inputs.rbegin(), inputs.rend());
+
+  EXPECT_EQ(GetBatchingKey(CreateInputs({1, 2}, {5})), GetBatchingKey(inputs));
+  EXPECT_EQ(GetBatchingKey(reversed_inputs), GetBatchingKey(inputs));
+}
+
+TEST(TensorBatchingTest, GetBatchingKeyDiffersForIncompatibleInputs) {
+  const std::string key = GetBatchingKey(CreateInputs({1, 2}, {5}));
+
+  EXPECT_NE(GetBatchingKey({{"features",
+                             AsTensor<float>({1, 2, 3}, TensorShape({1, 3}))},
+                            {"ids", AsTensor<int64_t>({5}, TensorShape({1}))}}),
+            key);
+  EXPECT_NE(GetBatchingKey({{"features",
+                             AsTensor<double>({1, 2}, TensorShape({1, 2}))},
+                            {"ids", AsTensor<int64_t>({5}, TensorShape({1}))}}),
+            key);
+  EXPECT_NE(GetBatchingKey({{"features",
+                             AsTensor<float>({1, 2}, TensorShape({1, 2}))}}),
+            key);
+}
+
+TEST(TensorBatchingTest, ConcatInputsMatchesTensorsByName) {
+  NamedTensors first = CreateInputs({1, 2}, {5});
+  NamedTensors second = CreateInputs({3, 4, 5, 6}, {6, 7});
+  std::swap(second[0], second[1]);
+
+  absl::StatusOr<NamedTensors> merged_inputs =
+      ConcatInputs(std::vector<const NamedTensors*>{&first, &second});
+
+  ASSERT_TRUE(merged_inputs.ok()) << merged_inputs.status();
+  ASSERT_EQ(merged_inputs->size(), 2);
+  EXPECT_EQ((*merged_inputs)[0].first, "features");
+  tensorflow::test::ExpectEqual(
+      (*merged_inputs)[0].second,
+      AsTensor<float>({1, 2, 3, 4, 5, 6}, TensorShape({3, 2})));
+  EXPECT_EQ((*merged_inputs)[1].first, "ids");
+  tensorflow::test::ExpectEqual((*merged_inputs)[1].second,
+                                AsTensor<int64_t>({5, 6, 7}, TensorShape({3})));
+}
+
+TEST(TensorBatchingTest, ConcatInputsFailsOnMissingTensor) {
+  NamedTensors first = CreateInputs({1, 2}, {5});
+  NamedTensors second = {
+      {"features", AsTensor<float>({3, 4}, TensorShape({1, 2}))}};
+
+  EXPECT_FALSE(
+      ConcatInputs(std::vector<const NamedTensors*>{&first, &second}).ok());
+}
+
+TEST(TensorBatchingTest, SplitOutputs) {
+  std::vector<TensorWithName> outputs = {TensorWithName(
+      "scores", AsTensor<float>({0.1, 0.2, 0.3}, TensorShape({3, 1})))};
+
+  absl::StatusOr<std::vector<std::vector<TensorWithName>>> split_outputs =
+      SplitOutputs(outputs, {2, 1});
+
+  ASSERT_TRUE(split_outputs.ok()) << split_outputs.status();
+  ASSERT_EQ(split_outputs->size(), 2);
+  ASSERT_EQ((*split_outputs)[0].size(), 1);
+  EXPECT_EQ((*split_outputs)[0][0].tensor_name, "scores");
+  tensorflow::test::ExpectEqual(
+      (*split_outputs)[0][0].tensor,
+      AsTensor<float>({0.1, 0.2}, TensorShape({2, 1})));
+  ASSERT_EQ((*split_outputs)[1].size(), 1);
+  tensorflow::test::ExpectEqual((*split_outputs)[1][0].tensor,
+                                AsTensor<float>({0.3}, TensorShape({1, 1})));
+}
+
+TEST(TensorBatchingTest, SplitOutputsFailsOnUnbatchedOutput) {
+  std::vector<TensorWithName> outputs = {TensorWithName(
+      "sum", AsTensor<float>({0.1, 0.2}, TensorShape({2})))};
+
+  EXPECT_FALSE(SplitOutputs(outputs, {2, 1}).ok());
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers::inference
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <future>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <string>
@@ -25,6 +26,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/flags/flag.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
@@ -46,12 +48,15 @@
 #include "tensorflow/core/platform/file_system.h"
 #include "tensorflow/core/protobuf/meta_graph.pb.h"
 #include "tensorflow/core/public/session.h"
+#include "utils/binary_request_parser.h"
 #include "utils/error.h"
 #include "utils/inference_error_code.h"
 #include "utils/inference_metric_util.h"
 #include "utils/log.h"
 #include "utils/request_parser.h"
+#include "utils/shared_model_files.h"
 
+#include "tensor_batching.h"
 #include "tensorflow_parser.h"
 #include "tensorflow_proto_parser.h"
 #include "validator.h"
@@ -71,13 +76,12 @@ absl::Status SaveToRamFileSystem(const RegisterModelRequest& request) {
   // Creates the top-level destination directory.
   PS_RETURN_IF_ERROR(tsl::Env::Default()->RecursivelyCreateDir(
       absl::StrCat(kRamFileSystemScheme, request.model_spec().model_path())));
-  for (const auto& pair : request.model_files()) {
-    const std::string& path = absl::StrCat(kRamFileSystemScheme, pair.first);
-    const std::string& bytes = pair.second;
-    PS_RETURN_IF_ERROR(
-        tsl::WriteStringToFile(tsl::Env::Default(), path, bytes));
-  }
-  return absl::OkStatus();
+  return ForEachModelFile(
+      request, [](absl::string_view path, absl::string_view bytes) {
+        return tsl::WriteStringToFile(
+            tsl::Env::Default(), absl::StrCat(kRamFileSystemScheme, path),
+            bytes);
+      });
 }
 
 void DeleteFromRamFileSystem(const std::string& path) {
@@ -135,10 +139,9 @@ absl::StatusOr<std::vector<TensorWithName>> PredictPerModelInternal(
 }
 
 // TODO(b/398917990): Deprecate the function after the proto migration.
-absl::StatusOr<std::vector<TensorWithName>> PredictPerModelFromJson(
-    std::shared_ptr<tensorflow::SavedModelBundle> model,
+absl::StatusOr<NamedTensors> ConvertJsonInputs(
     const InferenceRequest& inference_request) {
-  std::vector<std::pair<std::string, tensorflow::Tensor>> inputs;
+  NamedTensors inputs;
   for (const auto& tensor : inference_request.inputs) {
     if (tensor.tensor_name.empty()) {
       return absl::InvalidArgumentError(absl::StrCat(
@@ -153,15 +156,12 @@ absl::StatusOr<std::vector<TensorWithName>> PredictPerModelFromJson(
     }
     inputs.emplace_back(tensor.tensor_name, *tf_tensor);
   }
-
-  absl::string_view model_key = inference_request.model_path;
-  return PredictPerModelInternal(inputs, model, model_key);
+  return inputs;
 }
 
-absl::StatusOr<std::vector<TensorWithName>> PredictPerModelFromProto(
-    std::shared_ptr<tensorflow::SavedModelBundle> model,
+absl::StatusOr<NamedTensors> ConvertProtoInputs(
     const InferenceRequestProto& inference_request) {
-  std::vector<std::pair<std::string, tensorflow::Tensor>> inputs;
+  NamedTensors inputs;
   for (const TensorProto& tensor : inference_request.tensors()) {
     if (tensor.tensor_name().empty()) {
       return absl::InvalidArgumentError(absl::StrCat(
@@ -176,10 +176,172 @@ absl::StatusOr<std::vector<TensorWithName>> PredictPerModelFromProto(
     }
     inputs.emplace_back(tensor.tensor_name(), *tf_tensor);
   }
-  absl::string_view model_key = inference_request.model_path();
+  return inputs;
+}
+
+absl::StatusOr<NamedTensors> ConvertBinaryInputs(
+    const BinaryInferenceRequest& inference_request) {
+  NamedTensors inputs;
+  for (const BinaryTensor& tensor : inference_request.inputs) {
+    if (tensor.tensor_name.empty()) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          kInferenceTensorInputNameError,
+          ". Message: Name is required for each TensorFlow tensor input."));
+    }
+    auto tf_tensor = ConvertBinaryToTensor(tensor);
+    if (!tf_tensor.ok()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat(kInferenceInputTensorConversionError,
+                       ". Message: ", tf_tensor.status().message()));
+    }
+    inputs.emplace_back(std::string(tensor.tensor_name), *std::move(tf_tensor));
+  }
+  return inputs;
+}
+
+// TODO(b/398917990): Deprecate the function after the proto migration.
+absl::StatusOr<std::vector<TensorWithName>> PredictPerModelFromJson(
+    std::shared_ptr<tensorflow::SavedModelBundle> model,
+    const InferenceRequest& inference_request) {
+  PS_ASSIGN_OR_RETURN(NamedTensors inputs,
+                      ConvertJsonInputs(inference_request));
+  absl::string_view model_key = inference_request.model_path;
   return PredictPerModelInternal(inputs, model, model_key);
 }
 
+using PredictResult = absl::StatusOr<std::vector<TensorWithName>>;
+
+// Inference request of a predict request whose model is loaded and whose
+// inputs are converted to TensorFlow tensors.
+struct ModelInputs {
+  std::string model_path;
+  std::shared_ptr<tensorflow::SavedModelBundle> model;
+  NamedTensors inputs;
+  // Whether the request may be merged with the other requests to the model.
+  bool merge_requests = false;
+};
+
+// Returns the size of the first dimension of the first input, which is logged
+// as the batch size of a request.
+int GetBatchCount(const NamedTensors& inputs) {
+  if (inputs.empty() || inputs[0].second.dims() == 0) {
+    return 0;
+  }
+  return inputs[0].second.dim_size(0);
+}
+
+absl::Status CheckNotCancelled(const CancellableServerContext& server_context) {
+  RETURN_IF_CANCELLED(server_context, CancelLocation::kPredictAsync);
+  return absl::OkStatus();
+}
+
+// Runs the requests of `group` in a single Session::Run call on their
+// concatenated inputs, and splits the outputs back per request.
+absl::StatusOr<std::vector<PredictResult>> PredictMerged(
+    const std::vector<ModelInputs>& requests,
+    const std::vector<size_t>& group) {
+  std::vector<const NamedTensors*> inputs;
+  std::vector<int64_t> batch_sizes;
+  for (size_t request_id : group) {
+    inputs.push_back(&requests[request_id].inputs);
+    batch_sizes.push_back(*GetBatchSize(requests[request_id].inputs));
+  }
+  PS_ASSIGN_OR_RETURN(NamedTensors merged_inputs, ConcatInputs(inputs));
+  const ModelInputs& first_request = requests[group.front()];
+  PS_ASSIGN_OR_RETURN(std::vector<TensorWithName> merged_outputs,
+                      PredictPerModelInternal(merged_inputs,
+                                              first_request.model,
+                                              first_request.model_path));
+  PS_ASSIGN_OR_RETURN(std::vector<std::vector<TensorWithName>> outputs,
+                      SplitOutputs(merged_outputs, batch_sizes));
+  return std::vector<PredictResult>(std::make_move_iterator(outputs.begin()),
+                                    std::make_move_iterator(outputs.end()));
+}
+
+std::vector<PredictResult> PredictGroup(
+    const std::vector<ModelInputs>& requests,
+    const std::vector<size_t>& group) {
+  if (group.size() > 1) {
+    absl::StatusOr<std::vector<PredictResult>> results =
+        PredictMerged(requests, group);
+    if (results.ok()) {
+      return *std::move(results);
+    }
+    // Falls back to one run per request, so that a failing request (e.g. with
+    // an input the model rejects) doesn't fail the others of the batch.
+  }
+  std::vector<PredictResult> results;
+  results.reserve(group.size());
+  for (size_t request_id : group) {
+    const ModelInputs& request = requests[request_id];
+    results.push_back(PredictPerModelInternal(request.inputs, request.model,
+                                              request.model_path));
+  }
+  return results;
+}
+
+// Runs `requests` and returns their outputs in order. Requests to the same
+// model that opted into merging and whose inputs can be concatenated along the
+// batch dimension are merged into one Session::Run call. Any other request
+// runs on its own. The groups of requests run concurrently.
+// Logs the merged batch size of each run as kInferenceRequestBatchCountByModel.
+std::vector<PredictResult> PredictBatched(
+    const std::vector<ModelInputs>& requests,
+    PredictResponse& predict_response,
+    const CancellableServerContext& server_context) {
+  // Models are only frozen, and so stateless, when the test-only flag is off.
+  // A stateful model must run once per request.
+  const bool may_merge_requests =
+      !absl::GetFlag(FLAGS_testonly_disable_model_freezing);
+  std::vector<std::vector<size_t>> groups;
+  absl::flat_hash_map<
+      std::pair<const tensorflow::SavedModelBundle*, std::string>, size_t>
+      group_ids;
+  for (size_t request_id = 0; request_id < requests.size(); ++request_id) {
+    const ModelInputs& request = requests[request_id];
+    if (may_merge_requests && request.merge_requests &&
+        GetBatchSize(request.inputs).has_value()) {
+      auto [it, inserted] = group_ids.try_emplace(
+          std::make_pair(request.model.get(), GetBatchingKey(request.inputs)),
+          groups.size());
+      if (!inserted) {
+        groups[it->second].push_back(request_id);
+        continue;
+      }
+    }
+    groups.push_back({request_id});
+  }
+
+  std::vector<std::future<std::vector<PredictResult>>> tasks;
+  tasks.reserve(groups.size());
+  for (const std::vector<size_t>& group : groups) {
+    int batch_count = 0;
+    for (size_t request_id : group) {
+      batch_count += GetBatchCount(requests[request_id].inputs);
+    }
+    AddMetric(predict_response, "kInferenceRequestBatchCountByModel",
+              batch_count, requests[group.front()].model_path);
+    tasks.push_back(std::async(
+        std::launch::async,
+        [&server_context, &requests, &group]() -> std::vector<PredictResult> {
+          if (absl::Status status = CheckNotCancelled(server_context);
+              !status.ok()) {
+            return std::vector<PredictResult>(group.size(), status);
+          }
+          return PredictGroup(requests, group);
+        }));
+  }
+
+  std::vector<PredictResult> results(requests.size());
+  for (size_t group_id = 0; group_id < groups.size(); ++group_id) {
+    std::vector<PredictResult> group_results = tasks[group_id].get();
+    for (size_t i = 0; i < groups[group_id].size(); ++i) {
+      results[groups[group_id][i]] = std::move(group_results[i]);
+    }
+  }
+  return results;
+}
+
 absl::Status FreezeSavedModel(tensorflow::SessionOptions& session_options,
                               tensorflow::SavedModelBundle& model_bundle) {
   // TODO(b/368374975): Deprecate the absl flag at least for the prod build.
@@ -305,8 +467,9 @@ void TensorflowModule::PredictFromProtoHelper(
   BatchInferenceRequest parsed_requests_proto;
   parsed_requests_proto = request.proto_input();
   size_t parsed_request_size = parsed_requests_proto.request_size();
-  std::vector<std::future<absl::StatusOr<std::vector<TensorWithName>>>> tasks(
-      parsed_request_size);
+  std::vector<PredictResult> results(parsed_request_size);
+  std::vector<ModelInputs> model_inputs;
+  std::vector<size_t> model_input_task_ids;
   std::vector<InferenceResponseProto> batch_outputs_proto(parsed_request_size);
   for (size_t task_id = 0; task_id < parsed_request_size; ++task_id) {
     const InferenceRequestProto inference_request_proto =
@@ -334,23 +497,30 @@ void TensorflowModule::PredictFromProtoHelper(
       // partition for unregistered models.
       AddMetric(predict_response, "kInferenceRequestCountByModel", 1,
                 model_path);
-      int batch_count = inference_request_proto.tensors(0).tensor_shape(0);
-      AddMetric(predict_response, "kInferenceRequestBatchCountByModel",
-                batch_count, model_path);
-      tasks[task_id] = std::async(
-          std::launch::async,
-          [&server_context, model = *model, inference_request_proto]()
-              -> absl::StatusOr<std::vector<TensorWithName>> {
-            RETURN_IF_CANCELLED(server_context, CancelLocation::kPredictAsync);
-            return PredictPerModelFromProto(model, inference_request_proto);
-          });
+      absl::StatusOr<NamedTensors> inputs =
+          ConvertProtoInputs(inference_request_proto);
+      if (!inputs.ok()) {
+        results[task_id] = inputs.status();
+      } else {
+        model_inputs.push_back(
+            ModelInputs{.model_path = model_path,
+                        .model = *std::move(model),
+                        .inputs = *std::move(inputs),
+                        .merge_requests = MergesBatchRequests(model_path)});
+        model_input_task_ids.push_back(task_id);
+      }
     }
   }
 
+  std::vector<PredictResult> model_results =
+      PredictBatched(model_inputs, predict_response, server_context);
+  for (size_t i = 0; i < model_results.size(); ++i) {
+    results[model_input_task_ids[i]] = std::move(model_results[i]);
+  }
+
   for (size_t task_id = 0; task_id < parsed_request_size; ++task_id) {
     if (!batch_outputs_proto[task_id].has_error()) {
-      absl::StatusOr<std::vector<TensorWithName>> tensors =
-          tasks[task_id].get();
+      const PredictResult& tensors = results[task_id];
 
       const std::string& model_path =
           parsed_requests_proto.request(task_id).model_path();
@@ -407,14 +577,21 @@ void TensorflowModule::PredictFromProtoHelper(
       std::move(batch_inference_response));
 }
 
+struct TensorflowModule::ParsedInputs {
+  std::string model_path;
+  // Input tensors, or the error of their conversion.
+  absl::StatusOr<NamedTensors> inputs;
+  // Set if the request couldn't be parsed.
+  std::optional<Error> error;
+};
+
 // TODO(b/398917990): Deprecate the function after the proto migration.
 void TensorflowModule::PredictFromJsonHelper(
     const PredictRequest& request, const RequestContext& request_context,
     PredictResponse& predict_response,
     const CancellableServerContext& server_context) {
-  absl::Time start_inference_execution_time = absl::Now();
-  absl::StatusOr<std::vector<ParsedRequestOrError>> parsed_requests;
-  parsed_requests = ParseJsonInferenceRequest(request.input());
+  absl::StatusOr<std::vector<ParsedRequestOrError>> parsed_requests =
+      ParseJsonInferenceRequest(request.input());
   if (!parsed_requests.ok()) {
     AddMetric(predict_response, "kInferenceErrorCountByErrorCode", 1,
               std::string(kInferenceUnableToParseRequest));
@@ -424,19 +601,68 @@ void TensorflowModule::PredictFromJsonHelper(
               .description = std::string(parsed_requests.status().message())}));
     return;
   }
-  size_t parsed_request_size = parsed_requests->size();
+  std::vector<ParsedInputs> parsed_inputs;
+  parsed_inputs.reserve(parsed_requests->size());
+  for (const ParsedRequestOrError& parsed_request : *parsed_requests) {
+    if (parsed_request.request) {
+      parsed_inputs.push_back(
+          ParsedInputs{.model_path = parsed_request.request->model_path,
+                       .inputs = ConvertJsonInputs(*parsed_request.request)});
+    } else {
+      parsed_inputs.push_back(
+          ParsedInputs{.model_path = parsed_request.error->model_path,
+                       .error = parsed_request.error});
+    }
+  }
+  PredictToJson(std::move(parsed_inputs), request.is_consented(),
+                request_context, predict_response, server_context);
+}
+
+void TensorflowModule::PredictFromBinaryHelper(
+    const PredictRequest& request, const RequestContext& request_context,
+    PredictResponse& predict_response,
+    const CancellableServerContext& server_context) {
+  absl::StatusOr<std::vector<BinaryInferenceRequest>> parsed_requests =
+      ParseBinaryInferenceRequest(request.binary_input());
+  if (!parsed_requests.ok()) {
+    AddMetric(predict_response, "kInferenceErrorCountByErrorCode", 1,
+              std::string(kInferenceUnableToParseRequest));
+    INFERENCE_LOG(ERROR, request_context) << parsed_requests.status();
+    predict_response.set_output(CreateBatchErrorString(
+        Error{.error_type = Error::INPUT_PARSING,
+              .description = std::string(parsed_requests.status().message())}));
+    return;
+  }
+  std::vector<ParsedInputs> parsed_inputs;
+  parsed_inputs.reserve(parsed_requests->size());
+  for (const BinaryInferenceRequest& parsed_request : *parsed_requests) {
+    // The input tensors point into `request`, which outlives the inference.
+    parsed_inputs.push_back(
+        ParsedInputs{.model_path = std::string(parsed_request.model_path),
+                     .inputs = ConvertBinaryInputs(parsed_request)});
+  }
+  PredictToJson(std::move(parsed_inputs), request.is_consented(),
+                request_context, predict_response, server_context);
+}
+
+void TensorflowModule::PredictToJson(
+    std::vector<ParsedInputs> parsed_inputs, bool is_consented,
+    const RequestContext& request_context, PredictResponse& predict_response,
+    const CancellableServerContext& server_context) {
+  absl::Time start_inference_execution_time = absl::Now();
+  size_t parsed_request_size = parsed_inputs.size();
   std::vector<TensorsOrError> batch_outputs(parsed_request_size);
-  std::vector<std::future<absl::StatusOr<std::vector<TensorWithName>>>> tasks(
-      parsed_request_size);
+  std::vector<PredictResult> results(parsed_request_size);
+  std::vector<ModelInputs> model_inputs;
+  std::vector<size_t> model_input_task_ids;
   for (size_t task_id = 0; task_id < parsed_request_size; ++task_id) {
-    if ((*parsed_requests)[task_id].request) {
-      const InferenceRequest& inference_request =
-          (*parsed_requests)[task_id].request.value();
-      const std::string& model_path = inference_request.model_path;
+    ParsedInputs& parsed_input = parsed_inputs[task_id];
+    if (!parsed_input.error) {
+      const std::string& model_path = parsed_input.model_path;
       INFERENCE_LOG(INFO, request_context)
           << "Received inference request to model: " << model_path;
       absl::StatusOr<std::shared_ptr<tensorflow::SavedModelBundle>> model =
-          store_->GetModel(model_path, request.is_consented());
+          store_->GetModel(model_path, is_consented);
       if (!model.ok()) {
         AddMetric(predict_response, "kInferenceErrorCountByErrorCode", 1,
                   std::string(kInferenceModelNotFoundError));
@@ -453,31 +679,33 @@ void TensorflowModule::PredictFromJsonHelper(
         // partition for unregistered models.
         AddMetric(predict_response, "kInferenceRequestCountByModel", 1,
                   model_path);
-        int batch_count = inference_request.inputs[0].tensor_shape[0];
-        AddMetric(predict_response, "kInferenceRequestBatchCountByModel",
-                  batch_count, model_path);
-        tasks[task_id] = std::async(
-            std::launch::async,
-            [&server_context, model = *model, inference_request]()
-                -> absl::StatusOr<std::vector<TensorWithName>> {
-              RETURN_IF_CANCELLED(server_context,
-                                  CancelLocation::kPredictAsync);
-              return PredictPerModelFromJson(model, inference_request);
-            });
+        if (!parsed_input.inputs.ok()) {
+          results[task_id] = parsed_input.inputs.status();
+        } else {
+          model_inputs.push_back(
+              ModelInputs{.model_path = model_path,
+                          .model = *std::move(model),
+                          .inputs = *std::move(parsed_input.inputs),
+                          .merge_requests = MergesBatchRequests(model_path)});
+          model_input_task_ids.push_back(task_id);
+        }
       }
     } else {
-      const Error error = (*parsed_requests)[task_id].error.value();
-      batch_outputs[task_id] =
-          TensorsOrError{.model_path = error.model_path, .error = error};
+      batch_outputs[task_id] = TensorsOrError{
+          .model_path = parsed_input.model_path, .error = parsed_input.error};
     }
   }
 
+  std::vector<PredictResult> model_results =
+      PredictBatched(model_inputs, predict_response, server_context);
+  for (size_t i = 0; i < model_results.size(); ++i) {
+    results[model_input_task_ids[i]] = std::move(model_results[i]);
+  }
+
   for (size_t task_id = 0; task_id < parsed_request_size; ++task_id) {
     if (!batch_outputs[task_id].error) {
-      absl::StatusOr<std::vector<TensorWithName>> tensors =
-          tasks[task_id].get();
-      const std::string& model_path =
-          (*parsed_requests)[task_id].request.value().model_path;
+      const PredictResult& tensors = results[task_id];
+      const std::string& model_path = parsed_inputs[task_id].model_path;
 
       if (!tensors.ok()) {
         AddMetric(predict_response, "kInferenceErrorCountByErrorCode", 1,
@@ -521,10 +749,9 @@ void TensorflowModule::PredictFromJsonHelper(
               .description = "Error during output parsing to json."}));
     return;
   }
-  for (const ParsedRequestOrError& parsed_request : *parsed_requests) {
-    if (parsed_request.request) {
-      store_->IncrementModelInferenceCount(
-          parsed_request.request.value().model_path);
+  for (const ParsedInputs& parsed_input : parsed_inputs) {
+    if (!parsed_input.error) {
+      store_->IncrementModelInferenceCount(parsed_input.model_path);
     }
   }
 
@@ -539,13 +766,18 @@ absl::StatusOr<PredictResponse> TensorflowModule::Predict(
   absl::Time start_inference_execution_time = absl::Now();
   AddMetric(predict_response, "kInferenceRequestSize", request.ByteSizeLong());
   AddMetric(predict_response, "kInferenceRequestCount", 1);
-  const bool inference_use_proto = request.has_proto_input();
-  if (!inference_use_proto) {
-    PredictFromJsonHelper(request, request_context, predict_response,
-                          server_context);
-  } else {
-    PredictFromProtoHelper(request, request_context, predict_response,
-                           server_context);
+  switch (request.input_data_case()) {
+    case PredictRequest::kProtoInput:
+      PredictFromProtoHelper(request, request_context, predict_response,
+                             server_context);
+      break;
+    case PredictRequest::kBinaryInput:
+      PredictFromBinaryHelper(request, request_context, predict_response,
+                              server_context);
+      break;
+    default:
+      PredictFromJsonHelper(request, request_context, predict_response,
+                            server_context);
   }
   AddMetric(predict_response, "kInferenceResponseSize",
             predict_response.ByteSizeLong());
@@ -613,6 +845,10 @@ absl::StatusOr<RegisterModelResponse> TensorflowModule::RegisterModel(
   ModelConstructMetrics model_construct_metrics;
   PS_RETURN_IF_ERROR(store_->PutModel(model_path, model_request,
                                       model_construct_metrics, server_context));
+  if (request.merge_batch_requests()) {
+    absl::MutexLock lock(&merging_models_mu_);
+    merging_models_.insert(model_path);
+  }
 
   RegisterModelResponse register_model_response;
   if (!request.warm_up_batch_request_json().empty()) {
@@ -628,9 +864,19 @@ absl::StatusOr<DeleteModelResponse> TensorflowModule::DeleteModel(
     const CancellableServerContext& server_context) {
   RETURN_IF_CANCELLED(server_context, CancelLocation::kDelModelLogic);
   PS_RETURN_IF_ERROR(store_->DeleteModel(request.model_spec().model_path()));
+  {
+    absl::MutexLock lock(&merging_models_mu_);
+    merging_models_.erase(request.model_spec().model_path());
+  }
   return DeleteModelResponse();
 }
 
+bool TensorflowModule::MergesBatchRequests(
+    absl::string_view model_path) const {
+  absl::MutexLock lock(&merging_models_mu_);
+  return merging_models_.contains(model_path);
+}
+
 std::unique_ptr<ModuleInterface> ModuleInterface::Create(
     const InferenceSidecarRuntimeConfig& config) {
   return std::make_unique<TensorflowModule>(config);
@@ -17,9 +17,15 @@
 #define SERVICES_INFERENCE_SIDECAR_MODULES_TENSORFLOW_V2_17_0_TENSORFLOW_H_
 
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "model/model_store.h"
 #include "modules/module_interface.h"
 #include "proto/inference_sidecar.pb.h"
@@ -63,9 +69,30 @@ class TensorflowModule final : public ModuleInterface {
                              const RequestContext& request_context,
                              PredictResponse& predict_response,
                              const CancellableServerContext& server_context);
+  void PredictFromBinaryHelper(const PredictRequest& request,
+                               const RequestContext& request_context,
+                               PredictResponse& predict_response,
+                               const CancellableServerContext& server_context);
+
+  // Inputs of an inference request of a JSON or binary batch request.
+  struct ParsedInputs;
+  // Runs the parsed inference requests and sets the JSON output.
+  void PredictToJson(std::vector<ParsedInputs> parsed_inputs,
+                     bool is_consented, const RequestContext& request_context,
+                     PredictResponse& predict_response,
+                     const CancellableServerContext& server_context);
+
+  // Returns whether the inference requests of a batch to the model at
+  // `model_path` may be merged into a single Session::Run call.
+  bool MergesBatchRequests(absl::string_view model_path) const;
 
   // Stores a set of models. It's thread safe.
   std::unique_ptr<ModelStore<tensorflow::SavedModelBundle>> store_;
+
+  // Paths of the models registered with merge_batch_requests set.
+  mutable absl::Mutex merging_models_mu_;
+  absl::flat_hash_set<std::string> merging_models_
+      ABSL_GUARDED_BY(merging_models_mu_);
 };
 
 }  // namespace privacy_sandbox::bidding_auction_servers::inference
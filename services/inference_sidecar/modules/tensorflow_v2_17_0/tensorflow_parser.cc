@@ -14,6 +14,7 @@
 #include "tensorflow_parser.h"
 
 #include <algorithm>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -22,8 +23,10 @@
 #include "absl/strings/str_format.h"
 #include "rapidjson/document.h"
 #include "src/util/status_macro/status_macros.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
+#include "utils/binary_request_parser.h"
 #include "utils/error.h"
 #include "utils/json_util.h"
 #include "utils/request_parser.h"
@@ -78,6 +81,80 @@ absl::StatusOr<tensorflow::Tensor> ConvertFlatArrayToTensor(
   }
 }
 
+namespace {
+
+// Tensor buffer that points to the content of a binary request tensor without
+// owning it.
+class BinaryTensorBuffer : public tensorflow::TensorBuffer {
+ public:
+  explicit BinaryTensorBuffer(absl::string_view content)
+      // Tensorflow doesn't write to the input tensors.
+      : tensorflow::TensorBuffer(const_cast<char*>(content.data())),
+        size_(content.size()) {}
+
+  size_t size() const override { return size_; }
+  tensorflow::TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(
+      tensorflow::AllocationDescription* proto) const override {
+    proto->set_requested_bytes(size_);
+    proto->set_allocator_name("binary_request");
+  }
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  const size_t size_;
+};
+
+absl::StatusOr<tensorflow::DataType> ConvertDataType(DataType data_type) {
+  switch (data_type) {
+    case DataType::kFloat:
+      return tensorflow::DT_FLOAT;
+    case DataType::kDouble:
+      return tensorflow::DT_DOUBLE;
+    case DataType::kInt8:
+      return tensorflow::DT_INT8;
+    case DataType::kInt16:
+      return tensorflow::DT_INT16;
+    case DataType::kInt32:
+      return tensorflow::DT_INT32;
+    case DataType::kInt64:
+      return tensorflow::DT_INT64;
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrFormat("Unsupported data type %d", data_type));
+  }
+}
+
+}  // namespace
+
+absl::StatusOr<tensorflow::Tensor> ConvertBinaryToTensor(
+    const BinaryTensor& tensor) {
+  PS_ASSIGN_OR_RETURN(tensorflow::DataType data_type,
+                      ConvertDataType(tensor.data_type));
+  tensorflow::TensorShape shape;
+  for (int64_t dim : tensor.tensor_shape) {
+    shape.AddDim(dim);
+  }
+  if (shape.num_elements() * tensorflow::DataTypeSize(data_type) !=
+      tensor.tensor_content.size()) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Mismatch between the size of tensor_content (%d bytes) and the "
+        "tensor shape %s",
+        tensor.tensor_content.size(), shape.DebugString()));
+  }
+  auto* buffer = new BinaryTensorBuffer(tensor.tensor_content);
+  tensorflow::Tensor tf_tensor(data_type, shape, buffer);
+  buffer->Unref();
+  if (tf_tensor.IsAligned()) {
+    return tf_tensor;
+  }
+  // Tensorflow kernels may require aligned tensors.
+  tensorflow::Tensor aligned_tensor(data_type, shape);
+  std::memcpy(aligned_tensor.data(), tensor.tensor_content.data(),
+              tensor.tensor_content.size());
+  return aligned_tensor;
+}
+
 // Converts a single tensor to json.
 absl::StatusOr<rapidjson::Value> TensorToJsonValue(
     const std::string& tensor_name, const tensorflow::Tensor& tensor,
@@ -22,6 +22,7 @@
 
 #include "absl/status/statusor.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "utils/binary_request_parser.h"
 #include "utils/error.h"
 #include "utils/request_parser.h"
 
@@ -49,6 +50,12 @@ struct TensorsOrError {
 absl::StatusOr<tensorflow::Tensor> ConvertFlatArrayToTensor(
     const Tensor& tensor);
 
+// Wraps the content of a binary request tensor into a Tensorflow tensor
+// without copying it if it is aligned for Tensorflow, and copies it otherwise.
+// The returned tensor may point into the content, which must outlive it.
+absl::StatusOr<tensorflow::Tensor> ConvertBinaryToTensor(
+    const BinaryTensor& tensor);
+
 // Converts inference output (Tensorflow tensors) corresponding to each model to
 // a JSON string.
 // batch_outputs contains a collection of <model_path, inference_output> pairs.
@@ -18,6 +18,7 @@
 #include <utility>
 
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "googletest/include/gtest/gtest.h"
 #include "tensorflow/core/framework/tensor_types.h"
 
@@ -135,6 +136,54 @@ TEST(TensorflowParserTest, TestConversion_WrongType) {
   EXPECT_EQ(result.status().message(), "Error in int64 conversion");
 }
 
+TEST(TensorflowParserTest, ConvertBinaryToTensorWithoutCopy) {
+  alignas(kBinaryTensorAlignment) const float values[] = {1.5, -2, 3, 4};
+  BinaryTensor tensor = {
+      .data_type = DataType::kFloat,
+      .tensor_shape = {2, 2},
+      .tensor_content = absl::string_view(
+          reinterpret_cast<const char*>(values), sizeof(values))};
+
+  const absl::StatusOr<tensorflow::Tensor> result =
+      ConvertBinaryToTensor(tensor);
+
+  ASSERT_TRUE(result.ok()) << result.status();
+  EXPECT_EQ(result->dtype(), tensorflow::DT_FLOAT);
+  EXPECT_EQ(result->shape(), tensorflow::TensorShape({2, 2}));
+  EXPECT_EQ(result->data(), values);
+  for (int i = 0; i < 4; i++) {
+    EXPECT_FLOAT_EQ(result->flat<float>()(i), values[i]);
+  }
+}
+
+TEST(TensorflowParserTest, ConvertBinaryToTensorCopiesMisalignedContent) {
+  alignas(kBinaryTensorAlignment) const int64_t values[] = {0, 7, 8};
+  BinaryTensor tensor = {
+      .data_type = DataType::kInt64,
+      .tensor_shape = {2},
+      .tensor_content = absl::string_view(
+          reinterpret_cast<const char*>(values + 1), 2 * sizeof(int64_t))};
+
+  const absl::StatusOr<tensorflow::Tensor> result =
+      ConvertBinaryToTensor(tensor);
+
+  ASSERT_TRUE(result.ok()) << result.status();
+  EXPECT_TRUE(result->IsAligned());
+  EXPECT_EQ(result->flat<int64_t>()(0), 7);
+  EXPECT_EQ(result->flat<int64_t>()(1), 8);
+}
+
+TEST(TensorflowParserTest, ConvertBinaryToTensor_WrongSize) {
+  const int32_t values[] = {1, 2, 3};
+  BinaryTensor tensor = {
+      .data_type = DataType::kInt32,
+      .tensor_shape = {2, 2},
+      .tensor_content = absl::string_view(
+          reinterpret_cast<const char*>(values), sizeof(values))};
+
+  EXPECT_FALSE(ConvertBinaryToTensor(tensor).ok());
+}
+
 TEST(TensorflowParserTest, ConvertTensorsOrErrorToJson) {
   tensorflow::TensorShape shape({2, 3});  // 2x3 tensor
   tensorflow::Tensor tensor(tensorflow::DT_FLOAT, shape);
@@ -46,6 +46,7 @@
 #include "proto/inference_payload.pb.h"
 #include "proto/inference_sidecar.grpc.pb.h"
 #include "proto/inference_sidecar.pb.h"
+#include "utils/binary_request_parser.h"
 #include "utils/file_util.h"
 #include "utils/inference_metric_util.h"
 #include "utils/log.h"
@@ -1491,6 +1492,62 @@ TEST(TensorflowModuleTest,
   EXPECT_EQ(predict_response->metrics_list().size(), 7);
 }
 
+TEST(TensorflowModuleTest, PredictSameModelMergesRequestsIntoOneBatch) {
+  InferenceSidecarRuntimeConfig config;
+  std::unique_ptr<ModuleInterface> tensorflow_module =
+      ModuleInterface::Create(config);
+  RegisterModelRequest register_request;
+  ASSERT_TRUE(PopulateRegisterModelRequest(std::string(kFrozenModel1Dir),
+                                           register_request)
+                  .ok());
+  register_request.set_merge_batch_requests(true);
+  ASSERT_TRUE(tensorflow_module->RegisterModel(register_request).ok());
+
+  PredictRequest predict_request;
+  predict_request.set_input(kPcvrJsonRequestWith1ModelVariedSize);
+  absl::StatusOr<PredictResponse> predict_response =
+      tensorflow_module->Predict(predict_request);
+  ASSERT_TRUE(predict_response.ok());
+  // Both requests run in a single batch of size 2 + 1.
+  auto it = predict_response->metrics_list().find(
+      "kInferenceRequestBatchCountByModel");
+  ASSERT_NE(it, predict_response->metrics_list().end());
+  EXPECT_EQ(it->second.metrics_size(), 1);
+  CheckMetricList(predict_response->metrics_list(),
+                  "kInferenceRequestBatchCountByModel", 0, 3,
+                  std::string(kFrozenModel1Dir));
+  CheckMetricList(predict_response->metrics_list(),
+                  "kInferenceRequestCountByModel", 1, 1);
+}
+
+TEST(TensorflowModuleTest, PredictSameModelRunsRequestsSeparatelyByDefault) {
+  InferenceSidecarRuntimeConfig config;
+  std::unique_ptr<ModuleInterface> tensorflow_module =
+      ModuleInterface::Create(config);
+  RegisterModelRequest register_request;
+  ASSERT_TRUE(PopulateRegisterModelRequest(std::string(kFrozenModel1Dir),
+                                           register_request)
+                  .ok());
+  ASSERT_TRUE(tensorflow_module->RegisterModel(register_request).ok());
+
+  PredictRequest predict_request;
+  predict_request.set_input(kPcvrJsonRequestWith1ModelVariedSize);
+  absl::StatusOr<PredictResponse> predict_response =
+      tensorflow_module->Predict(predict_request);
+  ASSERT_TRUE(predict_response.ok());
+  // The requests of size 2 and 1 run one by one.
+  auto it = predict_response->metrics_list().find(
+      "kInferenceRequestBatchCountByModel");
+  ASSERT_NE(it, predict_response->metrics_list().end());
+  EXPECT_EQ(it->second.metrics_size(), 2);
+  CheckMetricList(predict_response->metrics_list(),
+                  "kInferenceRequestBatchCountByModel", 0, 2,
+                  std::string(kFrozenModel1Dir));
+  CheckMetricList(predict_response->metrics_list(),
+                  "kInferenceRequestBatchCountByModel", 1, 1,
+                  std::string(kFrozenModel1Dir));
+}
+
 constexpr char kPcvrJsonRequestEmbeddingModel[] = R"json({
   "request" : [{
     "model_path" : "./benchmark_models/frozen_embedding",
@@ -2185,6 +2242,70 @@ constexpr char kJsonRequestStatefulModel[] = R"json({
 }]
     })json";
 
+// Returns the binary equivalent of `kPcvrJsonRequest`.
+std::string CreatePcvrBinaryRequest() {
+  static const std::vector<double> kDoubles = {0.32, 0.12, 0.98, 0.32, 0.12,
+                                               0.98, 0.32, 0.12, 0.98, 0.11};
+  static const int64_t kInt = 7;
+  const absl::string_view doubles(
+      reinterpret_cast<const char*>(kDoubles.data()),
+      kDoubles.size() * sizeof(double));
+  const absl::string_view int_value(reinterpret_cast<const char*>(&kInt),
+                                    sizeof(kInt));
+  BinaryInferenceRequest request{.model_path = kModel1Dir};
+  for (absl::string_view name :
+       {"serving_default_double1:0", "serving_default_double2:0"}) {
+    request.inputs.push_back(BinaryTensor{.tensor_name = name,
+                                          .data_type = DataType::kDouble,
+                                          .tensor_shape = {1, 10},
+                                          .tensor_content = doubles});
+  }
+  for (absl::string_view name :
+       {"serving_default_int_input1:0", "serving_default_int_input2:0",
+        "serving_default_int_input3:0", "serving_default_int_input4:0",
+        "serving_default_int_input5:0"}) {
+    request.inputs.push_back(BinaryTensor{.tensor_name = name,
+                                          .data_type = DataType::kInt64,
+                                          .tensor_shape = {1, 1},
+                                          .tensor_content = int_value});
+  }
+  return SerializeBinaryInferenceRequest({request});
+}
+
+TEST(TensorflowModuleTest, BinaryError_PredictInvalidRequest) {
+  InferenceSidecarRuntimeConfig config;
+  std::unique_ptr<ModuleInterface> tensorflow_module =
+      ModuleInterface::Create(config);
+  PredictRequest predict_request;
+  predict_request.set_binary_input("invalid");
+
+  absl::StatusOr<PredictResponse> predict_response =
+      tensorflow_module->Predict(predict_request);
+
+  ASSERT_TRUE(predict_response.ok());
+  EXPECT_THAT(
+      predict_response->output(),
+      StartsWith(
+          R"({"response":[{"error":{"error_type":"INPUT_PARSING","description")"));
+}
+
+TEST(TensorflowModuleTest, BinaryError_PredictModelNotRegistered) {
+  InferenceSidecarRuntimeConfig config;
+  std::unique_ptr<ModuleInterface> tensorflow_module =
+      ModuleInterface::Create(config);
+  PredictRequest predict_request;
+  predict_request.set_binary_input(CreatePcvrBinaryRequest());
+
+  absl::StatusOr<PredictResponse> predict_response =
+      tensorflow_module->Predict(predict_request);
+
+  ASSERT_TRUE(predict_response.ok());
+  EXPECT_THAT(
+      predict_response->output(),
+      StartsWith(
+          R"({"response":[{"model_path":"./benchmark_models/pcvr","error":{"error_type":"MODEL_NOT_FOUND","description")"));
+}
+
 }  // namespace
 
 // This test suite verifies the behavior of TensorFlow models when model
@@ -2312,4 +2433,20 @@ TEST_F(NoFreezeTensorflowTest, Success_Predict) {
   EXPECT_EQ(predict_response->metrics_list().size(), 7);
 }
 
+TEST_F(NoFreezeTensorflowTest, Success_PredictBinary) {
+  RegisterModelRequest register_request;
+  ASSERT_TRUE(PopulateRegisterModelRequest(kModel1Dir, register_request).ok());
+  ASSERT_TRUE(tensorflow_module_->RegisterModel(register_request).ok());
+
+  PredictRequest predict_request;
+  predict_request.set_binary_input(CreatePcvrBinaryRequest());
+  absl::StatusOr<PredictResponse> predict_response =
+      tensorflow_module_->Predict(predict_request, RequestContext());
+  ASSERT_TRUE(predict_response.ok());
+  // The binary request yields the same output as the equivalent JSON request.
+  ASSERT_EQ(predict_response->output(), kPcvrResponse);
+  ASSERT_FALSE(predict_response->metrics_list().empty());
+  EXPECT_EQ(predict_response->metrics_list().size(), 7);
+}
+
 }  // namespace privacy_sandbox::bidding_auction_servers::inference
@@ -0,0 +1,215 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the libcbor item tree based decoding of ProtectedAuctionInput and
+// BuyerInput with the streaming decoder, and the libcbor item tree based
+// encoding of AuctionResult with the streaming encoder, on data shaped like the
+// examples in services/seller_frontend_service/schemas/examples.
+
+#include <optional>
+#include <string>
+
+#include "absl/log/check.h"
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+#include "services/common/compression/gzip.h"
+#include "services/common/test/utils/cbor_test_utils.h"
+#include "services/common/util/error_accumulator.h"
+#include "services/seller_frontend_service/util/cbor_tree_encode.h"
+#include "services/seller_frontend_service/util/web_utils.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+constexpr char kOwner1[] = "https://owner1.com";
+constexpr char kOwner2[] = "https://owner2.com";
+
+// Mirrors interest_group_request_example.json.
+BuyerInputForBidding BuildExampleBuyerInput(int num_interest_groups) {
+  BuyerInputForBidding buyer_input;
+  buyer_input.set_in_cooldown_or_lockout(true);
+  for (int i = 0; i < num_interest_groups; ++i) {
+    auto* interest_group = buyer_input.add_interest_groups();
+    interest_group->set_name(absl::StrCat("cars", i));
+    interest_group->add_bidding_signals_keys("key1");
+    interest_group->add_bidding_signals_keys("key2");
+    interest_group->set_user_bidding_signals("signals");
+    interest_group->add_ad_render_ids("<adRenderId>");
+    interest_group->add_ad_render_ids("<adRenderId2>");
+    auto* browser_signals = interest_group->mutable_browser_signals();
+    browser_signals->set_join_count(2);
+    browser_signals->set_bid_count(0);
+    browser_signals->set_recency(1684226729);
+    browser_signals->set_prev_wins(
+        R"([[-20,"<adRenderId>"],[-100,"<adRenderId>"]])");
+  }
+  return buyer_input;
+}
+
+google::protobuf::Map<std::string, std::string> EncodeBuyerInputs(
+    int num_interest_groups) {
+  google::protobuf::Map<std::string, BuyerInputForBidding> buyer_inputs;
+  buyer_inputs.emplace(kOwner1, BuildExampleBuyerInput(num_interest_groups));
+  buyer_inputs.emplace(kOwner2, BuildExampleBuyerInput(num_interest_groups));
+  auto encoded_buyer_inputs = GetEncodedBuyerInputMap(buyer_inputs);
+  CHECK_OK(encoded_buyer_inputs);
+  return *std::move(encoded_buyer_inputs);
+}
+
+// Mirrors auction_blob_request_example.json.
+std::string EncodeExampleProtectedAuctionInput(int num_interest_groups) {
+  ProtectedAuctionInput protected_auction_input;
+  protected_auction_input.set_publisher_name("https://foo.com");
+  protected_auction_input.set_generation_id(
+      "a8098c1a-f86e-11da-bd1a-00112444be1e");
+  protected_auction_input.set_enable_debug_reporting(true);
+  protected_auction_input.mutable_fdo_flags()
+      ->set_enable_sampled_debug_reporting(true);
+  protected_auction_input.mutable_fdo_flags()->set_in_cooldown_or_lockout(true);
+  protected_auction_input.set_request_timestamp_ms(1723102593791);
+  protected_auction_input.set_enforce_kanon(true);
+  *protected_auction_input.mutable_buyer_input() =
+      EncodeBuyerInputs(num_interest_groups);
+  auto encoded = CborEncodeProtectedAuctionProto(protected_auction_input);
+  CHECK_OK(encoded);
+  return *std::move(encoded);
+}
+
+// Returns the decompressed (i.e. CBOR encoded) BuyerInput of one owner.
+std::string EncodeExampleBuyerInput(int num_interest_groups) {
+  auto decompressed =
+      GzipDecompress(EncodeBuyerInputs(num_interest_groups).at(kOwner1));
+  CHECK_OK(decompressed);
+  return *std::move(decompressed);
+}
+
+// Mirrors auction_response_example.json, with interest groups of
+// `num_buyers` buyers in the bidding groups and update groups.
+struct ExampleAuctionResult {
+  ScoreAdsResponse::AdScore high_score;
+  google::protobuf::Map<std::string, AuctionResult::InterestGroupIndex>
+      bidding_groups;
+  UpdateGroupMap update_groups;
+};
+
+ExampleAuctionResult BuildExampleAuctionResult(int num_buyers) {
+  ExampleAuctionResult result;
+  ScoreAdsResponse::AdScore& high_score = result.high_score;
+  high_score.set_render("https://ad-found-here.com/ad-1");
+  high_score.add_component_renders("https://ad-found-here.com/component-1");
+  high_score.set_desirability(2.35);
+  high_score.set_buyer_bid(1.21);
+  high_score.set_interest_group_name("cars0");
+  high_score.set_interest_group_owner(kOwner1);
+  auto* win_reporting_urls = high_score.mutable_win_reporting_urls();
+  auto* buyer_reporting_urls =
+      win_reporting_urls->mutable_buyer_reporting_urls();
+  buyer_reporting_urls->set_reporting_url("https://owner1.com/reportWin");
+  (*buyer_reporting_urls->mutable_interaction_reporting_urls())["click"] =
+      "https://owner1.com/click";
+  win_reporting_urls->mutable_top_level_seller_reporting_urls()
+      ->set_reporting_url("https://seller.com/reportResult");
+  for (int i = 0; i < num_buyers; ++i) {
+    const std::string owner = absl::StrCat("https://owner", i, ".com");
+    AuctionResult::InterestGroupIndex& indices = result.bidding_groups[owner];
+    indices.add_index(0);
+    indices.add_index(1);
+    UpdateInterestGroup& update =
+        *result.update_groups[owner].add_interest_groups();
+    update.set_index(0);
+    update.set_update_if_older_than_ms(100000);
+  }
+  return result;
+}
+
+static void BM_EncodeAuctionResult_CborTree(benchmark::State& state) {
+  const ExampleAuctionResult result = BuildExampleAuctionResult(state.range(0));
+  for (auto _ : state) {
+    auto encoded = CborTreeEncode(
+        result.high_score, result.bidding_groups, result.update_groups,
+        /*adtech_origin_debug_urls_map=*/{}, /*error=*/std::nullopt,
+        [](const grpc::Status& status) {});
+    CHECK_OK(encoded);
+    benchmark::DoNotOptimize(encoded);
+  }
+}
+
+static void BM_EncodeAuctionResult_Streaming(benchmark::State& state) {
+  const ExampleAuctionResult result = BuildExampleAuctionResult(state.range(0));
+  for (auto _ : state) {
+    auto encoded =
+        Encode(result.high_score, result.bidding_groups, result.update_groups,
+               /*adtech_origin_debug_urls_map=*/{}, /*error=*/std::nullopt,
+               [](const grpc::Status& status) {});
+    CHECK_OK(encoded);
+    benchmark::DoNotOptimize(encoded);
+  }
+}
+
+static void BM_DecodeProtectedAuctionInput_CborTree(benchmark::State& state) {
+  const std::string payload =
+      EncodeExampleProtectedAuctionInput(state.range(0));
+  for (auto _ : state) {
+    ErrorAccumulator error_accumulator;
+    benchmark::DoNotOptimize(
+        CborTreeDecode<ProtectedAuctionInput>(payload, error_accumulator));
+    CHECK(!error_accumulator.HasErrors());
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+
+static void BM_DecodeProtectedAuctionInput_Streaming(benchmark::State& state) {
+  const std::string payload =
+      EncodeExampleProtectedAuctionInput(state.range(0));
+  for (auto _ : state) {
+    auto decoded =
+        StreamingDecodeProtectedAuctionInput<ProtectedAuctionInput>(payload);
+    CHECK_OK(decoded);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+
+static void BM_DecodeBuyerInput_CborTree(benchmark::State& state) {
+  const std::string payload = EncodeExampleBuyerInput(state.range(0));
+  for (auto _ : state) {
+    ErrorAccumulator error_accumulator;
+    benchmark::DoNotOptimize(
+        CborTreeDecodeBuyerInput(kOwner1, payload, error_accumulator));
+    CHECK(!error_accumulator.HasErrors());
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+
+static void BM_DecodeBuyerInput_Streaming(benchmark::State& state) {
+  const std::string payload = EncodeExampleBuyerInput(state.range(0));
+  for (auto _ : state) {
+    auto decoded = StreamingDecodeBuyerInput(payload);
+    CHECK_OK(decoded);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+
+// Arg: number of interest groups per buyer.
+BENCHMARK(BM_DecodeProtectedAuctionInput_CborTree)->Arg(1)->Arg(100);
+BENCHMARK(BM_DecodeProtectedAuctionInput_Streaming)->Arg(1)->Arg(100);
+BENCHMARK(BM_DecodeBuyerInput_CborTree)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_DecodeBuyerInput_Streaming)->Arg(1)->Arg(10)->Arg(100);
+// Arg: number of buyers with interest groups in the auction.
+BENCHMARK(BM_EncodeAuctionResult_CborTree)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_EncodeAuctionResult_Streaming)->Arg(1)->Arg(10)->Arg(100);
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
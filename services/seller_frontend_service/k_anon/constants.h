@@ -23,6 +23,11 @@ inline constexpr absl::string_view kKAnonAdBidHash = "AdBidHash";
 inline constexpr absl::string_view kKAnonAdComponentAdHash = "ComponentAdHash";
 inline constexpr absl::string_view kKAnonReportingIdHash = "ReportingIdHash";
 
+// Supported values of the K_ANON_CACHE_TYPE runtime flag.
+inline constexpr absl::string_view kKAnonCacheTypeLru = "LRU";
+inline constexpr absl::string_view kKAnonCacheTypeShardedLru = "SHARDED_LRU";
+inline constexpr absl::string_view kKAnonCacheTypeClock = "CLOCK";
+
 }  // namespace privacy_sandbox::bidding_auction_servers
 
 #endif  // SERVICES_SELLER_FRONTEND_SERVICE_DATA_K_ANON_CONSTANTS_H_
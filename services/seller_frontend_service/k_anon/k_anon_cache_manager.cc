@@ -30,6 +30,8 @@
 #include "absl/strings/str_join.h"
 #include "absl/synchronization/notification.h"
 #include "absl/time/time.h"
+#include "services/common/cache/clock_cache.h"
+#include "services/common/cache/sharded_cache.h"
 #include "services/seller_frontend_service/k_anon/k_anon_utils.h"
 #include "src/logger/request_context_logger.h"
 #include "src/util/status_macro/status_macros.h"
@@ -54,6 +56,23 @@ inline int GetShardIndex(absl::string_view hash, int num_shards) {
   return absl::little_endian::Load32(hash.data()) % num_shards;
 }
 
+std::unique_ptr<CacheInterface<std::string, std::string>> CreateCache(
+    KAnonCacheType cache_type, int capacity, absl::Duration ttl,
+    server_common::Executor* executor) {
+  switch (cache_type) {
+    case KAnonCacheType::kShardedLru:
+      return std::make_unique<ShardedCache<std::string, std::string>>(capacity,
+                                                                      ttl);
+    case KAnonCacheType::kClock:
+      return std::make_unique<ClockCache<std::string, std::string>>(capacity,
+                                                                    ttl);
+    case KAnonCacheType::kLru:
+    default:
+      return std::make_unique<Cache<std::string, std::string>>(
+          capacity, ttl, executor, GetEntryStringifyFunc());
+  }
+}
+
 }  // namespace
 
 KAnonCacheManager::KAnonCacheManager(
@@ -88,16 +107,14 @@ KAnonCacheManager::KAnonCacheManager(
   k_anon_caches.reserve(k_anon_shards);
   non_k_anon_caches.reserve(non_k_anon_shards);
   for (int i = 0; i < k_anon_shards; i++) {
-    k_anon_caches.emplace_back(
-        std::make_unique<Cache<std::string, std::string>>(
-            /* capacity= */ k_anon_cache_capacity, config.k_anon_ttl, executor,
-            GetEntryStringifyFunc()));
+    k_anon_caches.emplace_back(CreateCache(
+        config.cache_type, /* capacity= */ k_anon_cache_capacity,
+        config.k_anon_ttl, executor));
   }
   for (int i = 0; i < non_k_anon_shards; i++) {
-    non_k_anon_caches.emplace_back(
-        std::make_unique<Cache<std::string, std::string>>(
-            /* capacity= */ non_k_anon_cache_capacity, config.non_k_anon_ttl,
-            executor, GetEntryStringifyFunc()));
+    non_k_anon_caches.emplace_back(CreateCache(
+        config.cache_type, /* capacity= */ non_k_anon_cache_capacity,
+        config.non_k_anon_ttl, executor));
   }
   k_anon_caches_ = std::move(k_anon_caches);
   non_k_anon_caches_ = std::move(non_k_anon_caches);
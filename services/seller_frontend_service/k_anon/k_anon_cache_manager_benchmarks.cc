@@ -20,7 +20,10 @@
 //   services/seller_frontend_service/k_anon:k_anon_cache_manager_benchmarks \
 //   -- --benchmark_time_unit=us --benchmark_repetitions=10
 
+#include <memory>
 #include <random>
+#include <string>
+#include <vector>
 
 #include "absl/algorithm/container.h"
 #include "absl/container/btree_set.h"
@@ -49,6 +52,10 @@ constexpr int kNumKAnonCacheShards = 3;
 constexpr int kNumNonKAnonCacheShards = 3;
 constexpr int kNumKAnonymousCalls = 3;
 constexpr absl::string_view kFledgeSetType = "fledge";
+// Number of hashes looked up per AreKAnonymous() call by the multi-threaded
+// benchmark. All of them are cached, so that only the lookup path is timed.
+constexpr int kNumLookupHashes = 64;
+constexpr int kMaxThreads = 64;
 
 // Helper function that constructs unresolved hashes for k-anon query.
 // Unresolved hasehes will include hashes returned by
@@ -195,8 +202,109 @@ static void BM_KAnonCacheManagerAreKAnonymous(benchmark::State& state) {
   }
 }
 
+// Calls AreKAnonymous() concurrently from multiple threads with hashes that are
+// all present in the caches. The arg selects the KAnonCacheType under test, so
+// that lookup scaling with the number of cores can be compared across them.
+static void BM_KAnonCacheManagerConcurrentLookups(benchmark::State& state) {
+  static std::unique_ptr<server_common::GrpcInit> grpc_init;
+  static std::unique_ptr<server_common::EventEngineExecutor> executor;
+  static std::unique_ptr<KAnonCacheManager> k_anon_cache_manager;
+  static std::vector<std::unique_ptr<metric::SfeContext>> sfe_contexts;
+  static std::vector<SelectAdRequest> select_ad_requests;
+  static absl::flat_hash_set<std::string> hashes;
+
+  if (state.thread_index() == 0) {
+    CommonTestInit();
+    grpc_init = std::make_unique<server_common::GrpcInit>();
+    executor = std::make_unique<server_common::EventEngineExecutor>(
+        grpc_event_engine::experimental::CreateEventEngine());
+    hashes = ConstructUnresolvedHash(kNumLookupHashes);
+
+    // Every hash is k-anon; the client is only queried once to warm up the
+    // caches.
+    auto mock_client = std::make_unique<MockKAnonClient>();
+    EXPECT_CALL(*mock_client, Execute)
+        .WillRepeatedly([](std::unique_ptr<ValidateHashesRequest> request,
+                           KAnonClientCallBack on_done,
+                           absl::Duration timeout) {
+          auto response = std::make_unique<ValidateHashesResponse>();
+          auto* response_type_set = response->add_k_anonymous_sets();
+          for (auto& type_sets_map : request->sets()) {
+            response_type_set->set_type(type_sets_map.type());
+            for (const auto& hash : type_sets_map.hashes()) {
+              response_type_set->add_hashes(hash);
+            }
+          }
+          std::move(on_done)(std::move(response));
+          return absl::OkStatus();
+        });
+    KAnonCacheManagerConfig config = {
+        .total_num_hash = kNumLookupHashes * 4,
+        .num_k_anon_shards = kNumKAnonCacheShards,
+        .num_non_k_anon_shards = kNumNonKAnonCacheShards,
+        .cache_type = static_cast<KAnonCacheType>(state.range(kRangeArg))};
+    k_anon_cache_manager = std::make_unique<KAnonCacheManager>(
+        executor.get(), std::move(mock_client), config);
+
+    server_common::telemetry::TelemetryConfig config_proto;
+    config_proto.set_mode(server_common::telemetry::TelemetryConfig::PROD);
+    metric::MetricContextMap<SelectAdRequest>(
+        std::make_unique<server_common::telemetry::BuildDependentConfig>(
+            config_proto));
+    // One metric context per thread, since contexts are per request.
+    select_ad_requests = std::vector<SelectAdRequest>(state.threads());
+    sfe_contexts.clear();
+    for (auto& select_ad_request : select_ad_requests) {
+      metric::SfeContextMap()->Get(&select_ad_request);
+      auto fetched_sfe_context =
+          metric::SfeContextMap()->Remove(&select_ad_request);
+      CHECK_OK(fetched_sfe_context);
+      sfe_contexts.push_back(*std::move(fetched_sfe_context));
+    }
+
+    CHECK_OK(k_anon_cache_manager->AreKAnonymous(
+        kFledgeSetType,
+        absl::flat_hash_set<absl::string_view>(hashes.begin(), hashes.end()),
+        [](absl::StatusOr<absl::flat_hash_set<std::string>> response) {},
+        sfe_contexts[0].get()));
+  }
+
+  // The setup done by thread 0 is only guaranteed to be visible to the other
+  // threads once the timed loop has started.
+  absl::flat_hash_set<absl::string_view> lookup_hashes;
+  for (auto _ : state) {
+    if (lookup_hashes.empty()) {
+      lookup_hashes.insert(hashes.begin(), hashes.end());
+    }
+    absl::Status status = k_anon_cache_manager->AreKAnonymous(
+        kFledgeSetType, lookup_hashes,
+        [](absl::StatusOr<absl::flat_hash_set<std::string>> response) {
+          benchmark::DoNotOptimize(response);
+        },
+        sfe_contexts[state.thread_index()].get());
+    if (!status.ok()) {
+      PS_VLOG(5) << "Failed to query k-anon cache manager: " << status;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumLookupHashes);
+
+  if (state.thread_index() == 0) {
+    k_anon_cache_manager.reset();
+    sfe_contexts.clear();
+    executor.reset();
+    grpc_init.reset();
+  }
+}
+
 // Register the function as a benchmark
 BENCHMARK(BM_KAnonCacheManagerAreKAnonymous)->Range(8, 8 << 10);
+BENCHMARK(BM_KAnonCacheManagerConcurrentLookups)
+    ->ArgName("cache_type")
+    ->Arg(static_cast<int>(KAnonCacheType::kLru))
+    ->Arg(static_cast<int>(KAnonCacheType::kShardedLru))
+    ->Arg(static_cast<int>(KAnonCacheType::kClock))
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
 
 // Run the benchmark
 BENCHMARK_MAIN();
@@ -30,6 +30,17 @@
 
 namespace privacy_sandbox::bidding_auction_servers {
 
+// Cache implementation backing each k-anon and non-k-anon cache shard.
+enum class KAnonCacheType {
+  // LRU cache that expires each entry with its own timer event.
+  kLru,
+  // Lock-striped LRU cache that expires entries lazily.
+  kShardedLru,
+  // Read-mostly, lock-striped cache with CLOCK-approximated LRU eviction.
+  // Cache hits only take a shared lock and never reorder entries.
+  kClock,
+};
+
 // Configurable inputs given to KAnonCacheManager.
 struct KAnonCacheManagerConfig {
   int total_num_hash = 1000;
@@ -40,6 +51,7 @@ struct KAnonCacheManagerConfig {
   absl::Duration k_anon_ttl = absl::Hours(24);
   absl::Duration non_k_anon_ttl = absl::Hours(3);
   bool enable_k_anon_cache = true;
+  KAnonCacheType cache_type = KAnonCacheType::kLru;
 };
 
 // Interface for KAnonCacheManager.
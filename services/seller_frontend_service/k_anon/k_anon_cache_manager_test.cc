@@ -554,5 +554,45 @@ TEST_F(KAnonCacheManagerTest, DoesNotCallCacheWhenDisabled) {
   EXPECT_TRUE(status.ok()) << status;
 }
 
+TEST_F(KAnonCacheManagerTest, ResolvesFromEachCacheTypeOnRepeatedQueries) {
+  for (KAnonCacheType cache_type :
+       {KAnonCacheType::kLru, KAnonCacheType::kShardedLru,
+        KAnonCacheType::kClock}) {
+    auto client = std::make_unique<MockKAnonClient>();
+    absl::flat_hash_set<absl::string_view> unresolved_hash_set = {kTestHash1,
+                                                                  kTestHash2};
+
+    // Only the first query reaches the k-anon service; the second one is
+    // answered by the k-anon and non-k-anon caches.
+    EXPECT_CALL(*client, Execute)
+        .WillOnce([](std::unique_ptr<ValidateHashesRequest> request,
+                     KAnonClientCallBack on_done, absl::Duration timeout) {
+          auto response = std::make_unique<ValidateHashesResponse>();
+          auto* response_type_set = response->add_k_anonymous_sets();
+          response_type_set->set_type(kSetType);
+          response_type_set->add_hashes(kTestHash1);
+          std::move(on_done)(std::move(response));
+          return absl::OkStatus();
+        });
+
+    auto on_done_hash_query =
+        [](absl::StatusOr<absl::flat_hash_set<std::string>> hashes) {
+          ASSERT_TRUE(hashes.ok());
+          EXPECT_EQ(hashes->size(), 1);
+          EXPECT_TRUE(hashes->contains(kTestHash1));
+        };
+
+    config_.cache_type = cache_type;
+    KAnonCacheManager cache_manager(executor_.get(), std::move(client),
+                                    config_);
+    for (int i = 0; i < 2; ++i) {
+      auto status = cache_manager.AreKAnonymous(kSetType, unresolved_hash_set,
+                                                on_done_hash_query,
+                                                sfe_context_.get());
+      EXPECT_TRUE(status.ok()) << status;
+    }
+  }
+}
+
 }  // namespace
 }  // namespace privacy_sandbox::bidding_auction_servers
@@ -20,6 +20,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/strings/match.h"
 #include "absl/strings/str_join.h"
 #include "services/common/compression/gzip.h"
 #include "services/common/loggers/request_log_context.h"
@@ -204,6 +205,28 @@ absl::Status CborSerializePAggContributionList(
   return absl::OkStatus();
 }
 
+void CborSerializePAggContributionList(
+    const std::vector<const PrivateAggregateContribution*>& contributions,
+    CborWriter& writer) {
+  writer.WriteTextString("contributions");
+  writer.StartArray();
+  for (const PrivateAggregateContribution* contribution : contributions) {
+    // Drops the partially written contribution on failure.
+    CborWriter::Checkpoint checkpoint = writer.GetCheckpoint();
+    writer.StartMap();
+    absl::Status contribution_status =
+        CborSerializePAggContribution(*contribution, writer);
+    if (!contribution_status.ok()) {
+      PS_LOG(ERROR) << "Serialization failed for PrivateAggregateContribution:"
+                    << contribution_status;
+      writer.Rollback(checkpoint);
+      continue;
+    }
+    writer.EndMap();
+  }
+  writer.EndArray();
+}
+
 PrivateAggregationEvent DecodePrivateAggEvent(absl::string_view event_name) {
   absl::flat_hash_map<std::string, EventType> event_type_map = {
       {kReservedWinEvent.data(), EventType::EVENT_TYPE_WIN},
@@ -425,6 +448,18 @@ absl::Status CborSerializePAggBucket(const PrivateAggregationBucket& bucket,
   return absl::OkStatus();
 }
 
+absl::Status CborSerializePAggBucket(const PrivateAggregationBucket& bucket,
+                                     CborWriter& writer) {
+  if (!bucket.has_bucket_128_bit()) {
+    return absl::InternalError(
+        "Error serializing PrivateAggregationBucket. Bucket128Bit not "
+        "present.");
+  }
+  CborSerializeByteString(kBucket, ConvertIntArrayToByteString(bucket),
+                          writer);
+  return absl::OkStatus();
+}
+
 absl::Status CborSerializePAggValue(const PrivateAggregationValue& value,
                                     ErrorHandler error_handler,
                                     cbor_item_t& root) {
@@ -437,6 +472,16 @@ absl::Status CborSerializePAggValue(const PrivateAggregationValue& value,
   return absl::OkStatus();
 }
 
+absl::Status CborSerializePAggValue(const PrivateAggregationValue& value,
+                                    CborWriter& writer) {
+  if (!value.has_int_value()) {
+    return absl::InternalError(
+        "Error serializing PrivateAggregationValue. int_value is not present.");
+  }
+  CborSerializeInt(kValue, value.int_value(), writer);
+  return absl::OkStatus();
+}
+
 absl::Status CborSerializePAggContribution(
     const PrivateAggregateContribution& contribution,
     ErrorHandler error_handler, cbor_item_t& root) {
@@ -452,6 +497,18 @@ absl::Status CborSerializePAggContribution(
   return absl::OkStatus();
 }
 
+absl::Status CborSerializePAggContribution(
+    const PrivateAggregateContribution& contribution, CborWriter& writer) {
+  if (!contribution.has_bucket() || !contribution.has_value()) {
+    return absl::InternalError(
+        "Error serializing PrivateAggregateContribution. Missing bucket or "
+        "value.");
+  }
+  PS_RETURN_IF_ERROR(CborSerializePAggValue(contribution.value(), writer));
+  PS_RETURN_IF_ERROR(CborSerializePAggBucket(contribution.bucket(), writer));
+  return absl::OkStatus();
+}
+
 absl::Status CborSerializePAggEventContributions(
     const std::vector<const PrivateAggregateContribution*>& contributions,
     ErrorHandler error_handler, cbor_item_t& root) {
@@ -500,6 +557,28 @@ absl::Status CborSerializePAggEventContributions(
   return absl::OkStatus();
 }
 
+void CborSerializePAggEventContributions(
+    const std::vector<const PrivateAggregateContribution*>& contributions,
+    CborWriter& writer) {
+  // Group contributions by event type.
+  ContributionsPerEventTypeMap grouped_contributions;
+  for (const PrivateAggregateContribution* contribution : contributions) {
+    grouped_contributions[GetEvent(contribution)].push_back(contribution);
+  }
+  writer.WriteTextString(kEventContributions);
+  writer.StartArray();
+  for (const auto& [event_name, contributions] : grouped_contributions) {
+    writer.StartMap();
+    // Only custom event's name should be set in the response.
+    if (!absl::StartsWith(event_name, kReservedPrefix)) {
+      CborSerializeString(kEvent, event_name, writer);
+    }
+    CborSerializePAggContributionList(contributions, writer);
+    writer.EndMap();
+  }
+  writer.EndArray();
+}
+
 absl::StatusOr<std::vector<PrivateAggregateContribution>>
 CborDecodePAggEventContributions(
     std::optional<int> ig_idx,
@@ -628,6 +707,35 @@ absl::Status CborSerializeIgContributions(
   return absl::OkStatus();
 }
 
+void CborSerializeIgContributions(
+    const std::vector<const PrivateAggregateContribution*>& contributions,
+    CborWriter& writer) {
+  // Group contributions by ig type.
+  ContributionsPerIgTypeMap grouped_contributions;
+  std::vector<const PrivateAggregateContribution*> contributions_with_no_ig_idx;
+  for (const PrivateAggregateContribution* contribution : contributions) {
+    if (contribution->has_ig_idx()) {
+      grouped_contributions[contribution->ig_idx()].push_back(contribution);
+    } else {
+      contributions_with_no_ig_idx.push_back(contribution);
+    }
+  }
+  writer.WriteTextString(kIgContributions);
+  writer.StartArray();
+  for (const auto& [ig_idx, contributions] : grouped_contributions) {
+    writer.StartMap();
+    CborSerializeInt(kIgIndex, ig_idx, writer);
+    CborSerializePAggEventContributions(contributions, writer);
+    writer.EndMap();
+  }
+  if (!contributions_with_no_ig_idx.empty()) {
+    writer.StartMap();
+    CborSerializePAggEventContributions(contributions_with_no_ig_idx, writer);
+    writer.EndMap();
+  }
+  writer.EndArray();
+}
+
 absl::StatusOr<std::vector<PrivateAggregateContribution>>
 CborDecodePAggIgContributions(cbor_item_t& serialized_ig_contributions) {
   cbor_item_t* serialized_ig_contributions_ptr = &serialized_ig_contributions;
@@ -728,6 +836,31 @@ absl::Status CborSerializePAggResponse(
   return absl::OkStatus();
 }
 
+absl::Status CborSerializePAggResponse(
+    const PrivateAggregateReportingResponses& responses,
+    int per_adtech_paapi_contributions_limit, ErrorHandler error_handler,
+    CborWriter& writer) {
+  // Group contributions by AdTech.
+  ContributionsPerAdTechMap grouped_contributions = GroupContributionsByAdTech(
+      per_adtech_paapi_contributions_limit, responses);
+  if (grouped_contributions.empty()) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL,
+        absl::StrCat("No contributions to serialize in paggResponse")));
+    return absl::InternalError("");
+  }
+  writer.WriteTextString(kPAggResponse);
+  writer.StartArray();
+  for (const auto& [adtech_origin, contributions] : grouped_contributions) {
+    writer.StartMap();
+    CborSerializeIgContributions(contributions, writer);
+    CborSerializeString(kReportingOrigin, adtech_origin, writer);
+    writer.EndMap();
+  }
+  writer.EndArray();
+  return absl::OkStatus();
+}
+
 absl::StatusOr<PrivateAggregateReportingResponses> CborDecodePAggResponse(
     cbor_item_t& serialized_adtech_contributions) {
   cbor_item_t* serialized_adtech_contributions_ptr =
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "api/bidding_auction_servers.pb.h"
+#include "services/common/util/cbor_writer.h"
 #include "services/common/util/scoped_cbor.h"
 #include "services/seller_frontend_service/data/scoring_signals.h"
 #include "services/seller_frontend_service/util/cbor_common_util.h"
@@ -81,12 +82,17 @@ std::string ConvertIntArrayToByteString(const PrivateAggregationBucket& bucket);
 absl::Status CborSerializePAggContribution(
     const PrivateAggregateContribution& contribution,
     ErrorHandler error_handler, cbor_item_t& root);
+absl::Status CborSerializePAggContribution(
+    const PrivateAggregateContribution& contribution, CborWriter& writer);
 
 // Groups PrivateAggregateContributions by PrivateAggregationEvent and
 // serializes to create paggEventContribution.
 absl::Status CborSerializePAggEventContributions(
     const std::vector<const PrivateAggregateContribution*>& contributions,
     ErrorHandler error_handler, cbor_item_t& root);
+void CborSerializePAggEventContributions(
+    const std::vector<const PrivateAggregateContribution*>& contributions,
+    CborWriter& writer);
 
 // Decodes event and PrivateAggregateContribution from serialized
 // pAggEventContributions and returns list of PrivateAggregateContribution.
@@ -100,6 +106,9 @@ CborDecodePAggEventContributions(
 absl::Status CborSerializeIgContributions(
     const std::vector<const PrivateAggregateContribution*>& contributions,
     ErrorHandler error_handler, cbor_item_t& root);
+void CborSerializeIgContributions(
+    const std::vector<const PrivateAggregateContribution*>& contributions,
+    CborWriter& writer);
 
 // Decodes ig_idx and PrivateAggregateContribution from serialized
 // igContributions and returns list of PrivateAggregateContribution.
@@ -112,6 +121,10 @@ absl::Status CborSerializePAggResponse(
     const PrivateAggregateReportingResponses& responses,
     int per_adtech_paapi_contributions_limit, ErrorHandler error_handler,
     cbor_item_t& root);
+absl::Status CborSerializePAggResponse(
+    const PrivateAggregateReportingResponses& responses,
+    int per_adtech_paapi_contributions_limit, ErrorHandler error_handler,
+    CborWriter& writer);
 
 // Decodes reporting_origin and PrivateAggregateContributions from serialized
 // igContributions and returns list of PrivateAggregateReportingResponse.
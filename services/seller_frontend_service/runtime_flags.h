@@ -89,6 +89,7 @@ inline constexpr absl::string_view TEST_MODE_NON_K_ANON_CACHE_TTL_MS =
     "TEST_MODE_NON_K_ANON_CACHE_TTL_MS";
 inline constexpr absl::string_view ENABLE_K_ANON_QUERY_CACHE =
     "ENABLE_K_ANON_QUERY_CACHE";
+inline constexpr absl::string_view K_ANON_CACHE_TYPE = "K_ANON_CACHE_TYPE";
 inline constexpr absl::string_view ENABLE_BUYER_CACHING =
     "ENABLE_BUYER_CACHING";
 inline constexpr absl::string_view CURL_SFE_NUM_WORKERS =
@@ -97,9 +98,27 @@ inline constexpr absl::string_view CURL_SFE_QUEUE_MAX_WAIT_MS =
     "CURL_SFE_QUEUE_MAX_WAIT_MS";
 inline constexpr absl::string_view CURL_SFE_WORK_QUEUE_LENGTH =
     "CURL_SFE_WORK_QUEUE_LENGTH";
+inline constexpr absl::string_view CHAFFING_V2_MOVING_MEDIAN_TYPE =
+    "CHAFFING_V2_MOVING_MEDIAN_TYPE";
+inline constexpr absl::string_view ENABLE_INCREMENTAL_SCORING_SIGNALS_FETCH =
+    "ENABLE_INCREMENTAL_SCORING_SIGNALS_FETCH";
+inline constexpr absl::string_view ENABLE_ADAPTIVE_GET_BIDS =
+    "ENABLE_ADAPTIVE_GET_BIDS";
+inline constexpr absl::string_view GET_BIDS_CUTOFF_RESERVE_MS =
+    "GET_BIDS_CUTOFF_RESERVE_MS";
+inline constexpr absl::string_view SCORING_SIGNALS_CACHE_TTL_MS =
+    "SCORING_SIGNALS_CACHE_TTL_MS";
+inline constexpr absl::string_view SCORING_SIGNALS_CACHE_MAX_ENTRIES =
+    "SCORING_SIGNALS_CACHE_MAX_ENTRIES";
+inline constexpr absl::string_view CURL_SFE_ENABLE_SINGLE_FLIGHT =
+    "CURL_SFE_ENABLE_SINGLE_FLIGHT";
+inline constexpr absl::string_view CURL_SFE_ENABLE_HTTP2_MULTIPLEXING =
+    "CURL_SFE_ENABLE_HTTP2_MULTIPLEXING";
+inline constexpr absl::string_view CURL_SFE_MAX_CONCURRENT_STREAMS =
+    "CURL_SFE_MAX_CONCURRENT_STREAMS";
 inline constexpr char SFE_BFE_COMPRESSION_ALGO[] = "SFE_BFE_COMPRESSION_ALGO";
 
-inline constexpr int kNumRuntimeFlags = 43;
+inline constexpr int kNumRuntimeFlags = 53;
 inline constexpr std::array<absl::string_view, kNumRuntimeFlags> kFlags = {
     PORT,
     HEALTHCHECK_PORT,
@@ -140,10 +159,20 @@ inline constexpr std::array<absl::string_view, kNumRuntimeFlags> kFlags = {
     TEST_MODE_K_ANON_CACHE_TTL_MS,
     TEST_MODE_NON_K_ANON_CACHE_TTL_MS,
     ENABLE_K_ANON_QUERY_CACHE,
+    K_ANON_CACHE_TYPE,
     ENABLE_BUYER_CACHING,
     CURL_SFE_NUM_WORKERS,
     CURL_SFE_QUEUE_MAX_WAIT_MS,
     CURL_SFE_WORK_QUEUE_LENGTH,
+    CHAFFING_V2_MOVING_MEDIAN_TYPE,
+    ENABLE_INCREMENTAL_SCORING_SIGNALS_FETCH,
+    ENABLE_ADAPTIVE_GET_BIDS,
+    GET_BIDS_CUTOFF_RESERVE_MS,
+    SCORING_SIGNALS_CACHE_TTL_MS,
+    SCORING_SIGNALS_CACHE_MAX_ENTRIES,
+    CURL_SFE_ENABLE_SINGLE_FLIGHT,
+    CURL_SFE_ENABLE_HTTP2_MULTIPLEXING,
+    CURL_SFE_MAX_CONCURRENT_STREAMS,
 };
 
 inline std::vector<absl::string_view> GetServiceFlags() {
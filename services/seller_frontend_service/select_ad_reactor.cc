@@ -15,6 +15,7 @@
 #include "services/seller_frontend_service/select_ad_reactor.h"
 
 #include <algorithm>
+#include <chrono>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -62,6 +63,10 @@ namespace {
 inline constexpr int kMillisInMinute = 60000;
 inline constexpr int kSecsInMinute = 60;
 inline constexpr int kNumAllowedChromeGhostWinners = 1;
+// Latency percentile of a buyer past which its GetBids request is hedged.
+inline constexpr double kGetBidsHedgePercentile = 0.95;
+inline constexpr absl::string_view kGetBidsCutOff =
+    "GetBids cut off to stay within the SelectAd deadline";
 using ::google::protobuf::RepeatedPtrField;
 using ScoreAdsRawRequest = ScoreAdsRequest::ScoreAdsRawRequest;
 using AdScore = ScoreAdsResponse::AdScore;
@@ -168,6 +173,16 @@ SelectAdReactor::SelectAdReactor(
                        << (enable_enforce_kanon_ ? " k-anon query done " : " ");
             OnFetchScoringSignalsDone(std::move(maybe_scoring_signals_));
           }),
+      enable_incremental_scoring_signals_fetch_(
+          perform_scoring_signals_fetch_ &&
+          config_client_.HasParameter(
+              ENABLE_INCREMENTAL_SCORING_SIGNALS_FETCH) &&
+          config_client_.GetBooleanParameter(
+              ENABLE_INCREMENTAL_SCORING_SIGNALS_FETCH)),
+      enable_adaptive_get_bids_(
+          clients_.buyer_latency_tracker != nullptr &&
+          config_client_.HasParameter(ENABLE_ADAPTIVE_GET_BIDS) &&
+          config_client_.GetBooleanParameter(ENABLE_ADAPTIVE_GET_BIDS)),
       sfe_bfe_compression_algo_(sfe_bfe_compression_algo) {
   if (config_client_.GetBooleanParameter(ENABLE_SELLER_FRONTEND_BENCHMARKING)) {
     benchmarking_logger_ =
@@ -700,6 +715,10 @@ void SelectAdReactor::FetchBids() {
     num_buyers_solicited++;
   }
 
+  if (enable_adaptive_get_bids_) {
+    ScheduleGetBidsCutoff();
+  }
+
   if (buyer_caching_enabled_ && !previously_invoked_buyers_) {
     std::visit(
         [this, moved_chaff_buyers = std::move(chaff_buyers),
@@ -1003,11 +1022,7 @@ void SelectAdReactor::FetchBid(
 
   PS_VLOG(6, log_context_) << "Getting bid from a BFE";
 
-  absl::Duration timeout = absl::Milliseconds(
-      config_client_.GetIntParameter(GET_BID_RPC_TIMEOUT_MS));
-  if (auction_config_.buyer_timeout_ms() > 0) {
-    timeout = absl::Milliseconds(auction_config_.buyer_timeout_ms());
-  }
+  const absl::Duration timeout = GetBidsTimeout();
 
   // gets deleted in execute internal callback
   auto bfe_request =
@@ -1052,43 +1067,61 @@ void SelectAdReactor::FetchBid(
     }
   }
 
-  grpc::ClientContext* client_context =
-      client_contexts_.Add(buyer_metadata_copy);
-  absl::Status execute_result = buyer_client->ExecuteInternal(
-      std::move(get_bids_request), client_context,
-      CancellationWrapper(
-          request_context_, enable_cancellation_,
-          [buyer_ig_owner, this, bfe_request, buyer_client, is_chaff_request](
-              absl::StatusOr<
-                  std::unique_ptr<GetBidsResponse::GetBidsRawResponse>>
-                  response,
-              ResponseMetadata response_metadata) mutable {
-            {
-              bfe_request->SetRequestSize((int)response_metadata.request_size);
-              bfe_request->SetResponseSize(
-                  (int)response_metadata.response_size);
-
-              if (chaffing_v2_enabled_ && !is_chaff_request) {
-                absl::Status add_result =
-                    clients_.moving_median_manager->AddNumberToBuyerWindow(
-                        buyer_ig_owner, *rng_, response_metadata.request_size);
-                if (!add_result.ok()) {
-                  PS_LOG(ERROR, log_context_) << add_result;
-                }
-              }
+  const absl::Time start_time = absl::Now();
+  auto on_get_bids_done = CancellationWrapper(
+      request_context_, enable_cancellation_,
+      [buyer_ig_owner, this, bfe_request, buyer_client, is_chaff_request,
+       start_time](
+          absl::StatusOr<std::unique_ptr<GetBidsResponse::GetBidsRawResponse>>
+              response,
+          ResponseMetadata response_metadata) mutable {
+        {
+          bfe_request->SetRequestSize((int)response_metadata.request_size);
+          bfe_request->SetResponseSize((int)response_metadata.response_size);
+
+          if (chaffing_v2_enabled_ && !is_chaff_request) {
+            absl::Status add_result =
+                clients_.moving_median_manager->AddNumberToBuyerWindow(
+                    buyer_ig_owner, *rng_, response_metadata.request_size);
+            if (!add_result.ok()) {
+              PS_LOG(ERROR, log_context_) << add_result;
+            }
+          }
 
-              // destruct bfe_request, destructor measures request time
-              delete bfe_request;
+          if (enable_adaptive_get_bids_ && !is_chaff_request &&
+              response.ok()) {
+            absl::Status record_result =
+                clients_.buyer_latency_tracker->RecordLatency(
+                    buyer_ig_owner, absl::Now() - start_time);
+            if (!record_result.ok()) {
+              PS_LOG(ERROR, log_context_) << record_result;
             }
-            PS_VLOG(6, log_context_) << "Received a response from a BFE";
-            OnFetchBidsDone(std::move(response), buyer_ig_owner);
-          },
-          [&async_task_tracker_ = async_task_tracker_,
-           bfe_request]() {  // OnCancel
-            delete bfe_request;
-            async_task_tracker_.TaskCompleted(TaskStatus::CANCELLED);
-          }),
-      timeout, request_config);
+          }
+
+          // destruct bfe_request, destructor measures request time
+          delete bfe_request;
+        }
+        PS_VLOG(6, log_context_) << "Received a response from a BFE";
+        OnFetchBidsDone(std::move(response), buyer_ig_owner);
+      },
+      [&async_task_tracker_ = async_task_tracker_,
+       bfe_request]() {  // OnCancel
+        delete bfe_request;
+        async_task_tracker_.TaskCompleted(TaskStatus::CANCELLED);
+      });
+  absl::Status execute_result;
+  if (enable_adaptive_get_bids_) {
+    execute_result = StartHedgedGetBids(
+        buyer_ig_owner, buyer_client, std::move(get_bids_request),
+        buyer_metadata_copy, std::move(on_get_bids_done), timeout,
+        request_config);
+  } else {
+    grpc::ClientContext* client_context =
+        client_contexts_.Add(buyer_metadata_copy);
+    execute_result = buyer_client->ExecuteInternal(
+        std::move(get_bids_request), client_context,
+        std::move(on_get_bids_done), timeout, request_config);
+  }
   if (!execute_result.ok()) {
     delete bfe_request;
     LogIfError(
@@ -1103,6 +1136,137 @@ void SelectAdReactor::FetchBid(
   }
 }
 
+absl::Duration SelectAdReactor::GetBidsTimeout() const {
+  if (auction_config_.buyer_timeout_ms() > 0) {
+    return absl::Milliseconds(auction_config_.buyer_timeout_ms());
+  }
+  return absl::Milliseconds(
+      config_client_.GetIntParameter(GET_BID_RPC_TIMEOUT_MS));
+}
+
+absl::Status SelectAdReactor::StartHedgedGetBids(
+    const std::string& buyer_ig_owner,
+    std::shared_ptr<BuyerFrontEndAsyncClient> buyer_client,
+    std::unique_ptr<GetBidsRequest::GetBidsRawRequest> get_bids_request,
+    const RequestMetadata& buyer_metadata, HedgedGetBidsCall::OnDone on_done,
+    absl::Duration timeout, const RequestConfig& request_config) {
+  auto hedged_call = std::make_shared<HedgedGetBidsCall>(std::move(on_done));
+
+  // The request is hedged once it outlasts the buyer's recent p95 latency, as
+  // long as that leaves the hedge some of the buyer's timeout. Chaff requests
+  // are only subject to the cutoff.
+  absl::StatusOr<absl::Duration> hedge_delay = absl::ZeroDuration();
+  std::unique_ptr<GetBidsRequest::GetBidsRawRequest> hedge_request;
+  if (!get_bids_request->is_chaff()) {
+    hedge_delay = clients_.buyer_latency_tracker->GetPercentile(
+        buyer_ig_owner, kGetBidsHedgePercentile);
+    if (hedge_delay.ok() && *hedge_delay < timeout) {
+      hedge_request = std::make_unique<GetBidsRequest::GetBidsRawRequest>(
+          *get_bids_request);
+    }
+  }
+
+  PS_RETURN_IF_ERROR(buyer_client->ExecuteInternal(
+      std::move(get_bids_request), hedged_call->AddAttempt(buyer_metadata),
+      hedged_call->AttemptCallback(), timeout, request_config));
+  {
+    absl::MutexLock lock(&hedged_get_bids_calls_mu_);
+    hedged_get_bids_calls_.emplace_back(buyer_ig_owner, hedged_call);
+  }
+  if (hedge_request == nullptr) {
+    return absl::OkStatus();
+  }
+
+  // The hedge may start after the reactor is gone (once the call has been
+  // completed by the primary request or the cutoff), so the closure must not
+  // use the reactor, except for what AddAttempt() runs while the call is
+  // still pending.
+  executor_->RunAfter(
+      *hedge_delay,
+      [buyer_ig_owner, buyer_client = std::move(buyer_client),
+       hedge_request = std::move(hedge_request),
+       buyer_metadata = RequestMetadata(buyer_metadata),
+       hedged_call = std::move(hedged_call),
+       timeout = timeout - *hedge_delay, request_config,
+       metric_context = metric_context_.get()]() mutable {
+        grpc::ClientContext* client_context =
+            hedged_call->AddAttempt(buyer_metadata, [&]() {
+              LogIfError(
+                  metric_context->AccumulateMetric<
+                      metric::kSfeInitiatedRequestHedgedCountByBuyer>(
+                      1, buyer_ig_owner));
+            });
+        if (client_context == nullptr) {
+          return;
+        }
+        // The hedge goes through the buyer's channel like the primary
+        // request, and the load balancer in front of the BFEs routes it to
+        // any of the replicas.
+        absl::Status execute_result = buyer_client->ExecuteInternal(
+            std::move(hedge_request), client_context,
+            hedged_call->AttemptCallback(), timeout, request_config);
+        if (!execute_result.ok()) {
+          PS_LOG(ERROR, SystemLogContext())
+              << "Failed to make hedged GetBids call to buyer "
+              << buyer_ig_owner << ": " << execute_result;
+        }
+      });
+  return absl::OkStatus();
+}
+
+void SelectAdReactor::ScheduleGetBidsCutoff() {
+  const std::chrono::system_clock::time_point deadline =
+      request_context_->deadline();
+  if (deadline == std::chrono::system_clock::time_point::max()) {
+    return;
+  }
+  const absl::Duration reserve = absl::Milliseconds(
+      config_client_.HasParameter(GET_BIDS_CUTOFF_RESERVE_MS)
+          ? config_client_.GetInt64Parameter(GET_BIDS_CUTOFF_RESERVE_MS)
+          : 0);
+  const absl::Duration cutoff_delay = std::max(
+      absl::FromChrono(deadline) - absl::Now() - reserve, absl::ZeroDuration());
+  if (cutoff_delay >= GetBidsTimeout()) {
+    // The GetBids calls time out before the cutoff anyway.
+    return;
+  }
+
+  std::vector<std::pair<std::string, std::shared_ptr<HedgedGetBidsCall>>>
+      hedged_calls;
+  {
+    absl::MutexLock lock(&hedged_get_bids_calls_mu_);
+    hedged_calls = hedged_get_bids_calls_;
+  }
+  if (hedged_calls.empty()) {
+    return;
+  }
+  PS_VLOG(kNoisyInfo, log_context_)
+      << "Cutting off the pending GetBids calls in " << cutoff_delay;
+  executor_->RunAfter(cutoff_delay, [this,
+                                     hedged_calls = std::move(hedged_calls)]() {
+    // The calls are all taken before completing any of them: the reactor is
+    // only guaranteed to be alive while some buyer's call is pending, and the
+    // last call to complete may end the auction.
+    std::vector<HedgedGetBidsCall::OnDone> cut_off_calls;
+    for (const auto& [buyer_ig_owner, hedged_call] : hedged_calls) {
+      HedgedGetBidsCall::OnDone on_done = hedged_call->TakeOnDone();
+      if (on_done == nullptr) {
+        continue;
+      }
+      LogIfError(metric_context_->AccumulateMetric<
+                 metric::kSfeInitiatedRequestCutoffCountByBuyer>(
+          1, buyer_ig_owner));
+      PS_VLOG(kNoisyWarn, log_context_)
+          << "Cutting off GetBids call to buyer " << buyer_ig_owner;
+      cut_off_calls.push_back(std::move(on_done));
+    }
+    for (HedgedGetBidsCall::OnDone& on_done : cut_off_calls) {
+      std::move(on_done)(absl::DeadlineExceededError(kGetBidsCutOff),
+                         ResponseMetadata{});
+    }
+  });
+}
+
 void SelectAdReactor::LogInitiatedRequestErrorMetrics(
     absl::string_view server_name, const absl::Status& status,
     absl::string_view buyer) {
@@ -1164,6 +1328,9 @@ void SelectAdReactor::OnFetchBidsDone(
           [this, &buyer_ig_owner, response = *std::move(response)]() mutable {
             RecordInterestGroupUpdates(buyer_ig_owner, shared_ig_updates_map_,
                                        *response);
+            if (enable_incremental_scoring_signals_fetch_) {
+              FetchScoringSignalsForBuyer(buyer_ig_owner, response);
+            }
             shared_buyer_bids_map_.try_emplace(buyer_ig_owner,
                                                std::move(response));
           });
@@ -1184,7 +1351,7 @@ void SelectAdReactor::OnFetchBidsDone(
 
 void SelectAdReactor::OnAllBidsDone(bool any_successful_bids) {
   if (enable_cancellation_ && request_context_->IsCancelled()) {
-    FinishWithStatus(
+    FinishAfterScoringSignalsFetches(
         grpc::Status(grpc::StatusCode::CANCELLED, kRequestCancelled));
     return;
   }
@@ -1214,8 +1381,8 @@ void SelectAdReactor::OnAllBidsDone(bool any_successful_bids) {
   // Thus the preconditions of the following method are satisfied.
   if (!FilterBidsWithMismatchingCurrency()) {
     PS_VLOG(kNoisyWarn, log_context_) << kAllBidsRejectedBuyerCurrencyMismatch;
-    FinishWithStatus(grpc::Status(grpc::INVALID_ARGUMENT,
-                                  kAllBidsRejectedBuyerCurrencyMismatch));
+    FinishAfterScoringSignalsFetches(grpc::Status(
+        grpc::INVALID_ARGUMENT, kAllBidsRejectedBuyerCurrencyMismatch));
   } else if (perform_scoring_signals_fetch_) {
     if (enable_enforce_kanon_) {
       executor_->Run([this]() {
@@ -1229,7 +1396,18 @@ void SelectAdReactor::OnAllBidsDone(bool any_successful_bids) {
       // have to make sure we call this method.
       PopulateKAnonStatusForBids();
     }
-    FetchScoringSignals();
+    if (enable_incremental_scoring_signals_fetch_) {
+      // The signals have been fetched per buyer as the bids came in, so only
+      // the last fetches may still be pending.
+      scoring_signals_accumulator_.OnAllFetchesStarted(
+          [this](absl::StatusOr<std::unique_ptr<ScoringSignals>> result) {
+            maybe_scoring_signals_ = std::move(result);
+            fetch_scoring_signals_query_kanon_tracker_.TaskCompleted(
+                TaskStatus::SUCCESS);
+          });
+    } else {
+      FetchScoringSignals();
+    }
   } else if (enable_enforce_kanon_) {
     QueryKAnonHashes();
   } else {
@@ -1370,12 +1548,15 @@ void SelectAdReactor::CancellableFetchScoringSignalsV1(
               // destruct kv_request, destructor measures request time
               delete kv_request;
             }
-            maybe_scoring_signals_ = std::move(result);
-            fetch_scoring_signals_query_kanon_tracker_.TaskCompleted(
-                TaskStatus::SUCCESS);
+            OnScoringSignalsFetched(std::move(result));
           },
           [this, kv_request]() {
             delete kv_request;
+            if (enable_incremental_scoring_signals_fetch_) {
+              scoring_signals_accumulator_.OnFetchDone(
+                  absl::CancelledError(kRequestCancelled));
+              return;
+            }
             fetch_scoring_signals_query_kanon_tracker_.TaskCompleted(
                 TaskStatus::CANCELLED);
           }),
@@ -1414,6 +1595,12 @@ void SelectAdReactor::CancellableFetchScoringSignalsV2(
   if (!maybe_scoring_signals_request.ok()) {
     PS_VLOG(kNoisyWarn, log_context_) << "Failed creating TKV scoring request. "
                                       << maybe_scoring_signals_request.status();
+    if (enable_incremental_scoring_signals_fetch_) {
+      // The bids of this buyer have no keys to look up, so the buyer adds no
+      // signals, and the fetches of the other buyers go on.
+      scoring_signals_accumulator_.OnFetchDone(
+          std::unique_ptr<ScoringSignals>());
+    }
     return;
   }
 
@@ -1449,6 +1636,13 @@ void SelectAdReactor::CancellableFetchScoringSignalsV2(
               // destruct kv_request, destructor measures request time
               delete kv_request;
             }
+            if (!kv_look_up_result.ok() &&
+                enable_incremental_scoring_signals_fetch_) {
+              // Other buyers' fetches may still be in flight, so the error is
+              // reported by OnFetchScoringSignalsDone() once they are done.
+              OnScoringSignalsFetched(kv_look_up_result.status());
+              return;
+            }
             if (!kv_look_up_result.ok()) {
               LogIfError(
                   metric_context_
@@ -1478,15 +1672,21 @@ void SelectAdReactor::CancellableFetchScoringSignalsV2(
                 << " and without additional json string parsing applied:"
                 << v2_adapter_stats.values_without_json_string_parsing;
 
-            SetKvEventMessage("KVAsyncGrpcClient",
-                              *((*signals)->scoring_signals),
-                              std::move(score_signal), log_context_);
-            maybe_scoring_signals_ = *std::move(signals);
-            fetch_scoring_signals_query_kanon_tracker_.TaskCompleted(
-                TaskStatus::SUCCESS);
+            {
+              absl::MutexLock lock(&kv_event_message_mu_);
+              SetKvEventMessage("KVAsyncGrpcClient",
+                                *((*signals)->scoring_signals),
+                                std::move(score_signal), log_context_);
+            }
+            OnScoringSignalsFetched(*std::move(signals));
           },
           [this, kv_request]() {
             delete kv_request;
+            if (enable_incremental_scoring_signals_fetch_) {
+              scoring_signals_accumulator_.OnFetchDone(
+                  absl::CancelledError(kRequestCancelled));
+              return;
+            }
             FinishWithStatus(
                 grpc::Status(grpc::StatusCode::CANCELLED, kRequestCancelled));
           }),
@@ -1495,8 +1695,13 @@ void SelectAdReactor::CancellableFetchScoringSignalsV2(
 }
 
 void SelectAdReactor::CancellableFetchScoringSignals() {
+  FetchScoringSignalsForBids(shared_buyer_bids_map_);
+}
+
+void SelectAdReactor::FetchScoringSignalsForBids(
+    const BuyerBidsResponseMap& buyer_bids_map) {
   ScoringSignalsRequest scoring_signals_request(
-      shared_buyer_bids_map_, buyer_metadata_, request_->client_type());
+      buyer_bids_map, buyer_metadata_, request_->client_type());
   if (auction_config_.has_code_experiment_spec() &&
       auction_config_.code_experiment_spec()
           .has_seller_kv_experiment_group_id()) {
@@ -1515,6 +1720,43 @@ void SelectAdReactor::CancellableFetchScoringSignals() {
   }
 }
 
+void SelectAdReactor::FetchScoringSignalsForBuyer(
+    const std::string& buyer_ig_owner,
+    std::unique_ptr<GetBidsResponse::GetBidsRawResponse>& get_bids_response) {
+  PS_VLOG(6, log_context_) << "Fetching scoring signals for buyer: "
+                           << buyer_ig_owner;
+  scoring_signals_accumulator_.AddPendingFetch();
+  // The KV requests are built synchronously, so the response is only lent to
+  // a single buyer map for the duration of the call.
+  BuyerBidsResponseMap buyer_bids_map;
+  auto [buyer_bids_it, unused] =
+      buyer_bids_map.try_emplace(buyer_ig_owner, std::move(get_bids_response));
+  FetchScoringSignalsForBids(buyer_bids_map);
+  get_bids_response = std::move(buyer_bids_it->second);
+}
+
+void SelectAdReactor::OnScoringSignalsFetched(
+    absl::StatusOr<std::unique_ptr<ScoringSignals>> result) {
+  if (enable_incremental_scoring_signals_fetch_) {
+    scoring_signals_accumulator_.OnFetchDone(std::move(result));
+    return;
+  }
+  maybe_scoring_signals_ = std::move(result);
+  fetch_scoring_signals_query_kanon_tracker_.TaskCompleted(TaskStatus::SUCCESS);
+}
+
+void SelectAdReactor::FinishAfterScoringSignalsFetches(
+    const grpc::Status& status) {
+  if (!enable_incremental_scoring_signals_fetch_) {
+    FinishWithStatus(status);
+    return;
+  }
+  scoring_signals_accumulator_.OnAllFetchesStarted(
+      [this, status](absl::StatusOr<std::unique_ptr<ScoringSignals>> unused) {
+        FinishWithStatus(status);
+      });
+}
+
 void SelectAdReactor::OnFetchScoringSignalsDone(
     absl::StatusOr<std::unique_ptr<ScoringSignals>> result) {
   if (!perform_scoring_signals_fetch_) {
@@ -1793,7 +2035,7 @@ bool SelectAdReactor::EncryptResponse(std::string plaintext_response) {
       AuctionScope::AUCTION_SCOPE_SERVER_COMPONENT_MULTI_SELLER) {
     // If this will be decrypted by another SFE, encrypt with public key.
     auto encrypted_request =
-        HpkeEncrypt(plaintext_response, *clients_.crypto_client_ptr_,
+        HpkeEncrypt(std::move(plaintext_response), *clients_.crypto_client_ptr_,
                     clients_.key_fetcher_manager_,
                     ProtoCloudPlatformToScpCloudPlatform(
                         auction_config_.top_level_cloud_platform()));
@@ -2166,6 +2408,10 @@ void SelectAdReactor::OnDone() { delete this; }
 void SelectAdReactor::OnCancel() {
   if (enable_cancellation_) {
     client_contexts_.CancelAll();
+    absl::MutexLock lock(&hedged_get_bids_calls_mu_);
+    for (const auto& [unused, hedged_call] : hedged_get_bids_calls_) {
+      hedged_call->CancelAll();
+    }
   }
 }
 
@@ -28,6 +28,7 @@
 
 #include "absl/status/statusor.h"
 #include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/mutex.h"
 #include "api/bidding_auction_servers.grpc.pb.h"
 #include "api/bidding_auction_servers.pb.h"
 #include "include/grpcpp/impl/codegen/server_callback.h"
@@ -43,6 +44,7 @@
 #include "services/common/util/client_contexts.h"
 #include "services/common/util/error_accumulator.h"
 #include "services/common/util/error_reporter.h"
+#include "services/common/util/hedged_call.h"
 #include "services/common/util/request_metadata.h"
 #include "services/common/util/request_response_constants.h"
 #include "services/seller_frontend_service/data/k_anon.h"
@@ -51,6 +53,7 @@
 #include "services/seller_frontend_service/report_win_map.h"
 #include "services/seller_frontend_service/seller_frontend_service.h"
 #include "services/seller_frontend_service/util/encryption_util.h"
+#include "services/seller_frontend_service/util/scoring_signals_accumulator.h"
 #include "services/seller_frontend_service/util/validation_utils.h"
 
 namespace privacy_sandbox::bidding_auction_servers {
@@ -128,6 +131,9 @@ class SelectAdReactor : public grpc::ServerUnaryReactor {
  protected:
   using ErrorHandlerSignature = const std::function<void(absl::string_view)>&;
   using AuctionConfig = SelectAdRequest::AuctionConfig;
+  using HedgedGetBidsCall = HedgedCall<
+      absl::StatusOr<std::unique_ptr<GetBidsResponse::GetBidsRawResponse>>,
+      ResponseMetadata>;
 
   // Extracts the AuctionConfig from the SelectAdRequest object.
   grpc::Status ExtractAuctionConfig();
@@ -286,6 +292,26 @@ class SelectAdReactor : public grpc::ServerUnaryReactor {
       const std::string& buyer_ig_owner,
       std::unique_ptr<GetBidsRequest::GetBidsRawRequest> get_bids_request);
 
+  // Returns the timeout of the GetBids calls to the buyers.
+  absl::Duration GetBidsTimeout() const;
+
+  // Starts a GetBids call to a buyer when adaptive GetBids calls are enabled.
+  // The call is hedged with a second request if it outlasts the buyer's p95
+  // latency, and is tracked in hedged_get_bids_calls_ for the cutoff.
+  // Returns an error if the call could not be started, in which case
+  // `on_done` is not invoked.
+  absl::Status StartHedgedGetBids(
+      const std::string& buyer_ig_owner,
+      std::shared_ptr<BuyerFrontEndAsyncClient> buyer_client,
+      std::unique_ptr<GetBidsRequest::GetBidsRawRequest> get_bids_request,
+      const RequestMetadata& buyer_metadata, HedgedGetBidsCall::OnDone on_done,
+      absl::Duration timeout, const RequestConfig& request_config);
+
+  // Schedules the completion, with a DEADLINE_EXCEEDED error, of the GetBids
+  // calls still pending once the SelectAd deadline only leaves
+  // GET_BIDS_CUTOFF_RESERVE_MS for the rest of the auction.
+  void ScheduleGetBidsCutoff();
+
   // Handles recording the fetched bid to state.
   // This is called by the grpc buyer client when the request is finished,
   // and will subsequently call update pending bids state which will update how
@@ -309,6 +335,31 @@ class SelectAdReactor : public grpc::ServerUnaryReactor {
   // each Buyer is used as a key for the Seller Key-Value lookup.
   void CancellableFetchScoringSignals();
 
+  // Fetches the scoring signals for the bids in `buyer_bids_map` using either
+  // the V1 or the V2 key value protocol.
+  void FetchScoringSignalsForBids(const BuyerBidsResponseMap& buyer_bids_map);
+
+  // Starts fetching the scoring signals for a single buyer's bids as soon as
+  // they arrive, when incremental scoring signals fetches are enabled. The
+  // signals of all the buyers are merged by `scoring_signals_accumulator_`
+  // once every buyer has responded.
+  //
+  // Must be called while holding the lock of async_task_tracker_, so that
+  // the fetch is registered before OnAllBidsDone() can run.
+  void FetchScoringSignalsForBuyer(
+      const std::string& buyer_ig_owner,
+      std::unique_ptr<GetBidsResponse::GetBidsRawResponse>& get_bids_response);
+
+  // Routes the result of a scoring signals fetch to either the
+  // scoring_signals_accumulator_ (incremental fetches) or the
+  // fetch_scoring_signals_query_kanon_tracker_.
+  void OnScoringSignalsFetched(
+      absl::StatusOr<std::unique_ptr<ScoringSignals>> result);
+
+  // Finishes the RPC with `status` once all the incremental scoring signals
+  // fetches are done, since their callbacks reference this reactor.
+  void FinishAfterScoringSignalsFetches(const grpc::Status& status);
+
   [[deprecated]] void CancellableFetchScoringSignalsV1(
       const ScoringSignalsRequest& scoring_signals_request);
 
@@ -578,6 +629,27 @@ class SelectAdReactor : public grpc::ServerUnaryReactor {
   // Tracks the completion of scoring signals fetching and k-anon queries.
   AsyncTaskTracker fetch_scoring_signals_query_kanon_tracker_;
 
+  // Whether the scoring signals are fetched per buyer, as each buyer's bids
+  // arrive, rather than once for all the bids after every buyer responded.
+  const bool enable_incremental_scoring_signals_fetch_;
+
+  // Merges the scoring signals fetched per buyer.
+  ScoringSignalsAccumulator scoring_signals_accumulator_;
+
+  // Serializes the KV event messages logged by concurrent per buyer fetches.
+  absl::Mutex kv_event_message_mu_;
+
+  // Whether the GetBids calls are hedged past the buyers' p95 latencies and
+  // cut off ahead of the SelectAd deadline.
+  const bool enable_adaptive_get_bids_;
+
+  // GetBids calls started when adaptive GetBids calls are enabled, keyed by
+  // buyer. The calls own their client contexts, so that the calls losing
+  // to a hedge or to the cutoff can outlive the reactor.
+  absl::Mutex hedged_get_bids_calls_mu_;
+  std::vector<std::pair<std::string, std::shared_ptr<HedgedGetBidsCall>>>
+      hedged_get_bids_calls_ ABSL_GUARDED_BY(hedged_get_bids_calls_mu_);
+
   // Keeps track of the client contexts used for RPC calls
   ClientContexts client_contexts_;
 
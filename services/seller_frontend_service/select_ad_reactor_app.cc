@@ -113,18 +113,16 @@ absl::StatusOr<std::string> SelectAdReactorForApp::GetNonEncryptedResponse(
   // Serialized the data to bytes array.
   std::string serialized_result = auction_result.SerializeAsString();
 
-  // Compress the bytes array before framing it with pre-amble and padding.
-  absl::StatusOr<std::string> compressed_data = GzipCompress(serialized_result);
-  if (!compressed_data.ok()) {
+  // Compress the bytes array and frame it with pre-amble and padding.
+  absl::StatusOr<std::string> encoded_data =
+      GzipCompressAndEncodeResponsePayload(serialized_result);
+  if (!encoded_data.ok()) {
     PS_LOG(ERROR, log_context_)
         << "Failed to compress the serialized response data: "
-        << compressed_data.status().message();
+        << encoded_data.status().message();
     return absl::InternalError("");
   }
-
-  return server_common::EncodeResponsePayload(
-      server_common::CompressionType::kGzip, *compressed_data,
-      GetEncodedDataSize(compressed_data->size()));
+  return encoded_data;
 }
 
 ProtectedAudienceInput SelectAdReactorForApp::GetDecodedProtectedAudienceInput(
@@ -53,6 +53,7 @@
 #include "services/common/test/random.h"
 #include "services/common/test/utils/test_init.h"
 #include "services/seller_frontend_service/select_ad_reactor_web.h"
+#include "services/seller_frontend_service/util/buyer_latency_tracker.h"
 #include "services/seller_frontend_service/util/select_ad_reactor_test_utils.h"
 #include "services/seller_frontend_service/util/web_utils.h"
 #include "src/core/test/utils/proto_test_utils.h"
@@ -1100,6 +1101,231 @@ TYPED_TEST(SellerFrontEndServiceTest, DoesNotScoreAdsAfterGettingEmptySignals) {
   EXPECT_TRUE(auction_result.is_chaff());
 }
 
+TYPED_TEST(SellerFrontEndServiceTest,
+           FetchesScoringSignalsPerBuyerWithIncrementalFetch) {
+  this->config_.SetOverride(kFalse, ENABLE_TKV_V2_BROWSER);
+  this->config_.SetOverride(kTrue, ENABLE_INCREMENTAL_SCORING_SIGNALS_FETCH);
+  this->SetupRequest();
+  absl::flat_hash_map<std::string, std::string> buyer_to_ad_url =
+      BuildBuyerWinningAdUrlMap(this->request_);
+
+  // Buyer Clients
+  BuyerFrontEndAsyncClientFactoryMock buyer_clients;
+  EXPECT_EQ(this->protected_auction_input_.buyer_input_size(), 2);
+  for (const auto& [buyer, unused] :
+       this->protected_auction_input_.buyer_input()) {
+    SetupBuyerClientMock(
+        buyer, buyer_clients,
+        BuildGetBidsResponseWithSingleAd(buyer_to_ad_url.at(buyer)));
+  }
+  MockEntriesCallOnBuyerFactory(this->protected_auction_input_.buyer_input(),
+                                buyer_clients);
+
+  // Each buyer's bids are sent to the KV server on their own, as soon as they
+  // arrive.
+  MockAsyncProvider<ScoringSignalsRequest, ScoringSignals>
+      scoring_signals_provider;
+  EXPECT_CALL(scoring_signals_provider, Get)
+      .Times(2)
+      .WillRepeatedly([](const ScoringSignalsRequest& scoring_signals_request,
+                         ScoringSignalsDoneCallback on_done,
+                         absl::Duration timeout, RequestContext context) {
+        ASSERT_EQ(scoring_signals_request.buyer_bids_map_.size(), 1);
+        const auto& get_bids_response =
+            scoring_signals_request.buyer_bids_map_.begin()->second;
+        ASSERT_EQ(get_bids_response->bids_size(), 1);
+        auto scoring_signals = std::make_unique<ScoringSignals>();
+        scoring_signals->scoring_signals =
+            std::make_unique<std::string>(absl::StrFormat(
+                R"({"renderUrls": {"%s": [1]}})",
+                get_bids_response->bids(0).render()));
+        scoring_signals->data_version = kDefaultSellerDataVersion;
+        GetByteSize get_byte_size;
+        std::move(on_done)(std::move(scoring_signals), get_byte_size);
+      });
+  KVAsyncClientMock kv_async_client;
+
+  // Scoring Client
+  ScoringAsyncClientMock scoring_client;
+  EXPECT_CALL(scoring_client, ExecuteInternal)
+      .WillOnce([&buyer_to_ad_url](
+                    std::unique_ptr<ScoreAdsRequest::ScoreAdsRawRequest>
+                        score_ads_raw_request,
+                    grpc::ClientContext* context, ScoreAdsDoneCallback on_done,
+                    absl::Duration timeout, RequestConfig request_config) {
+        // All the ads are scored in a single request, with the merged
+        // scoring signals of all the buyers.
+        EXPECT_EQ(score_ads_raw_request->ad_bids_size(), 2);
+        for (const auto& [unused, url] : buyer_to_ad_url) {
+          EXPECT_THAT(score_ads_raw_request->scoring_signals(),
+                      ::testing::HasSubstr(url));
+        }
+        EXPECT_EQ(score_ads_raw_request->seller_data_version(),
+                  kDefaultSellerDataVersion);
+        std::move(on_done)(
+            std::make_unique<ScoreAdsResponse::ScoreAdsRawResponse>(), {});
+        return absl::OkStatus();
+      });
+
+  // Reporting Client.
+  std::unique_ptr<MockAsyncReporter> async_reporter =
+      std::make_unique<MockAsyncReporter>(
+          std::make_unique<MockHttpFetcherAsync>());
+  // Client Registry
+  ClientRegistry clients{&scoring_signals_provider,
+                         scoring_client,
+                         buyer_clients,
+                         &kv_async_client,
+                         this->key_fetcher_manager_,
+                         /*crypto_client=*/nullptr,
+                         std::move(async_reporter)};
+  Response response = RunRequest<SelectAdReactorForWeb>(
+      this->config_, clients, this->request_, this->executor_.get(),
+      this->report_win_map_);
+}
+
+TYPED_TEST(SellerFrontEndServiceTest,
+           SkipsBuyerWithoutScoringSignalsKeysWithIncrementalFetch) {
+  this->config_.SetOverride(kTrue, ENABLE_TKV_V2_BROWSER);
+  this->config_.SetOverride(kTrue, ENABLE_INCREMENTAL_SCORING_SIGNALS_FETCH);
+  this->SetupRequest();
+  absl::flat_hash_map<std::string, std::string> buyer_to_ad_url =
+      BuildBuyerWinningAdUrlMap(this->request_);
+
+  // Buyer Clients. The bid of the first buyer has no render URLs, so there is
+  // no key to look up in the KV server for this buyer.
+  BuyerFrontEndAsyncClientFactoryMock buyer_clients;
+  BuyerBidsResponseMap expected_buyer_bids;
+  EXPECT_EQ(this->protected_auction_input_.buyer_input_size(), 2);
+  bool first_buyer = true;
+  for (const auto& [buyer, unused] :
+       this->protected_auction_input_.buyer_input()) {
+    GetBidsResponse::GetBidsRawResponse response =
+        first_buyer
+            ? BuildGetBidsResponseWithSingleAd(
+                  /*ad_url=*/"", {.number_ad_component_render_urls = 0})
+            : BuildGetBidsResponseWithSingleAd(buyer_to_ad_url.at(buyer));
+    SetupBuyerClientMock(buyer, buyer_clients, response);
+    if (!first_buyer) {
+      expected_buyer_bids.try_emplace(
+          buyer,
+          std::make_unique<GetBidsResponse::GetBidsRawResponse>(response));
+    }
+    first_buyer = false;
+  }
+  MockEntriesCallOnBuyerFactory(this->protected_auction_input_.buyer_input(),
+                                buyer_clients);
+
+  // Creating the KV request fails for the first buyer, so only the bid of the
+  // second buyer is sent to the KV server.
+  MockAsyncProvider<ScoringSignalsRequest, ScoringSignals>
+      scoring_signals_provider;
+  KVAsyncClientMock kv_async_client;
+  SetupScoringSignalsClient</*UseKvV2ForBrowser=*/true>(
+      scoring_signals_provider, kv_async_client, expected_buyer_bids,
+      /*scoring_signals_provider_options=*/{}, {.expected_num_ads = 1});
+
+  // Scoring Client. The auction goes on with the signals of the second buyer.
+  ScoringAsyncClientMock scoring_client;
+  EXPECT_CALL(scoring_client, ExecuteInternal)
+      .WillOnce([](std::unique_ptr<ScoreAdsRequest::ScoreAdsRawRequest>
+                       score_ads_raw_request,
+                   grpc::ClientContext* context, ScoreAdsDoneCallback on_done,
+                   absl::Duration timeout, RequestConfig request_config) {
+        EXPECT_EQ(score_ads_raw_request->scoring_signals(),
+                  kValidScoringSignalsJsonKvV2);
+        std::move(on_done)(
+            std::make_unique<ScoreAdsResponse::ScoreAdsRawResponse>(), {});
+        return absl::OkStatus();
+      });
+
+  // Reporting Client.
+  std::unique_ptr<MockAsyncReporter> async_reporter =
+      std::make_unique<MockAsyncReporter>(
+          std::make_unique<MockHttpFetcherAsync>());
+  // Client Registry
+  ClientRegistry clients{&scoring_signals_provider,
+                         scoring_client,
+                         buyer_clients,
+                         &kv_async_client,
+                         this->key_fetcher_manager_,
+                         /*crypto_client=*/nullptr,
+                         std::move(async_reporter)};
+  Response response = RunRequest<SelectAdReactorForWeb>(
+      this->config_, clients, this->request_, this->executor_.get(),
+      this->report_win_map_);
+}
+
+TYPED_TEST(SellerFrontEndServiceTest,
+           RecordsBuyerLatenciesWithAdaptiveGetBids) {
+  this->config_.SetOverride(kTrue, ENABLE_ADAPTIVE_GET_BIDS);
+  this->SetupRequest();
+  absl::flat_hash_map<std::string, std::string> buyer_to_ad_url =
+      BuildBuyerWinningAdUrlMap(this->request_);
+
+  // Buyer Clients. Without any latencies tracked yet, the buyers are called
+  // once each.
+  BuyerFrontEndAsyncClientFactoryMock buyer_clients;
+  BuyerBidsResponseMap expected_buyer_bids;
+  absl::flat_hash_set<std::string> buyers;
+  for (const auto& [buyer, unused] :
+       this->protected_auction_input_.buyer_input()) {
+    GetBidsResponse::GetBidsRawResponse response =
+        BuildGetBidsResponseWithSingleAd(buyer_to_ad_url.at(buyer));
+    SetupBuyerClientMock(buyer, buyer_clients, response);
+    expected_buyer_bids.try_emplace(
+        buyer, std::make_unique<GetBidsResponse::GetBidsRawResponse>(response));
+    buyers.insert(buyer);
+  }
+  MockEntriesCallOnBuyerFactory(this->protected_auction_input_.buyer_input(),
+                                buyer_clients);
+
+  MockAsyncProvider<ScoringSignalsRequest, ScoringSignals>
+      scoring_signals_provider;
+  KVAsyncClientMock kv_async_client;
+  SetupScoringSignalsClient<TypeParam::kUseKvV2ForBrowser>(
+      scoring_signals_provider, kv_async_client,
+      std::move(expected_buyer_bids));
+
+  // Scoring Client
+  ScoringAsyncClientMock scoring_client;
+  EXPECT_CALL(scoring_client, ExecuteInternal)
+      .WillOnce([](std::unique_ptr<ScoreAdsRequest::ScoreAdsRawRequest>
+                       score_ads_raw_request,
+                   grpc::ClientContext* context, ScoreAdsDoneCallback on_done,
+                   absl::Duration timeout, RequestConfig request_config) {
+        EXPECT_EQ(score_ads_raw_request->ad_bids_size(), 2);
+        std::move(on_done)(
+            std::make_unique<ScoreAdsResponse::ScoreAdsRawResponse>(), {});
+        return absl::OkStatus();
+      });
+
+  // Reporting Client.
+  std::unique_ptr<MockAsyncReporter> async_reporter =
+      std::make_unique<MockAsyncReporter>(
+          std::make_unique<MockHttpFetcherAsync>());
+  // Client Registry
+  ClientRegistry clients{&scoring_signals_provider,
+                         scoring_client,
+                         buyer_clients,
+                         &kv_async_client,
+                         this->key_fetcher_manager_,
+                         /*crypto_client=*/nullptr,
+                         std::move(async_reporter)};
+  clients.buyer_latency_tracker = std::make_unique<BuyerLatencyTracker>(
+      buyers, /*window_size=*/10, /*min_samples=*/1);
+  Response response = RunRequest<SelectAdReactorForWeb>(
+      this->config_, clients, this->request_, this->executor_.get(),
+      this->report_win_map_);
+
+  for (const std::string& buyer : buyers) {
+    EXPECT_TRUE(
+        clients.buyer_latency_tracker->GetPercentile(buyer, /*percentile=*/1)
+            .ok())
+        << "No latency recorded for buyer: " << buyer;
+  }
+}
+
 TYPED_TEST(SellerFrontEndServiceTest, ReturnsWinningAdAfterScoring) {
   std::string decision_logic = "function scoreAds(){}";
 
@@ -172,17 +172,15 @@ absl::StatusOr<std::string> SelectAdReactorForWeb::GetNonEncryptedResponse(
   absl::string_view data_to_compress = absl::string_view(
       reinterpret_cast<char*>(encoded_data.data()), encoded_data.size());
 
-  absl::StatusOr<std::string> compressed_data = GzipCompress(data_to_compress);
-  if (!compressed_data.ok()) {
+  absl::StatusOr<std::string> framed_data =
+      GzipCompressAndEncodeResponsePayload(data_to_compress);
+  if (!framed_data.ok()) {
     PS_LOG(ERROR, log_context_)
         << "Failed to compress the CBOR serialized data: "
-        << compressed_data.status().message();
+        << framed_data.status().message();
     return absl::InternalError("");
   }
-
-  return server_common::EncodeResponsePayload(
-      server_common::CompressionType::kGzip, *compressed_data,
-      GetEncodedDataSize(compressed_data->size()));
+  return framed_data;
 }
 
 ProtectedAudienceInput SelectAdReactorForWeb::GetDecodedProtectedAudienceInput(
@@ -38,6 +38,9 @@
 #include "services/common/clients/config/parc_parameter_client.h"
 #include "services/common/clients/config/trusted_server_config_client.h"
 #include "services/common/clients/config/trusted_server_config_client_util.h"
+#include "services/common/clients/http/curl_connection_metrics.h"
+#include "services/common/clients/http/single_flight_http_fetcher_async.h"
+#include "services/common/clients/http_kv_server/seller/caching_seller_key_value_async_client.h"
 #include "services/common/constants/common_service_flags.h"
 #include "services/common/encryption/crypto_client_factory.h"
 #include "services/common/encryption/key_fetcher_factory.h"
@@ -45,11 +48,14 @@
 #include "services/common/util/map_utils.h"
 #include "services/common/util/signal_handler.h"
 #include "services/common/util/tcmalloc_utils.h"
+#include "services/seller_frontend_service/k_anon/constants.h"
 #include "services/seller_frontend_service/k_anon/k_anon_cache_manager.h"
 #include "services/seller_frontend_service/k_anon/k_anon_cache_manager_interface.h"
 #include "services/seller_frontend_service/report_win_map.h"
 #include "services/seller_frontend_service/runtime_flags.h"
 #include "services/seller_frontend_service/seller_frontend_service.h"
+#include "services/seller_frontend_service/util/buyer_latency_tracker.h"
+#include "services/seller_frontend_service/util/chaffing_utils.h"
 #include "services/seller_frontend_service/util/key_fetcher_utils.h"
 #include "src/concurrent/event_engine_executor.h"
 #include "src/encryption/key_fetcher/key_fetcher_manager.h"
@@ -162,9 +168,42 @@ ABSL_FLAG(std::optional<int64_t>, test_mode_non_k_anon_cache_ttl_ms, 10800,
 ABSL_FLAG(std::optional<bool>, enable_k_anon_query_cache, true,
           "Flag to make k-anon cache query optional. If set to false, k-anon "
           "caches will not be queried.");
+ABSL_FLAG(std::optional<std::string>, k_anon_cache_type, "LRU",
+          "Cache implementation backing the k-anon caches. One of LRU, "
+          "SHARDED_LRU (lock-striped, lazily expired) or CLOCK (read-mostly, "
+          "hits only take a shared lock).");
 ABSL_FLAG(
     std::optional<bool>, enable_buyer_caching, std::nullopt,
     "Enable caching for which buyers are invoked for a particular request");
+ABSL_FLAG(std::optional<bool>, enable_incremental_scoring_signals_fetch,
+          false,
+          "Fetch the scoring signals for each buyer's bids as soon as they "
+          "arrive, instead of for all the bids once every buyer has "
+          "responded.");
+ABSL_FLAG(std::optional<bool>, enable_adaptive_get_bids, false,
+          "Send a hedged GetBids request to a buyer once its request outlasts "
+          "the buyer's p95 latency, and stop waiting for the buyers when the "
+          "remaining SelectAd deadline only leaves get_bids_cutoff_reserve_ms "
+          "for the rest of the auction.");
+ABSL_FLAG(std::optional<int64_t>, get_bids_cutoff_reserve_ms, 100,
+          "Time (in milliseconds) to reserve for scoring the bids before the "
+          "SelectAd deadline, when enable_adaptive_get_bids is set.");
+ABSL_FLAG(std::optional<int>, scoring_signals_cache_ttl_ms, 0,
+          "How long (in milliseconds) SFE serves the scoring signals of a "
+          "render URL from its cache. The cache is disabled if 0");
+ABSL_FLAG(std::optional<int>, scoring_signals_cache_max_entries, 65536,
+          "Maximum number of render URLs whose scoring signals are cached");
+ABSL_FLAG(std::optional<bool>, curl_sfe_enable_http2_multiplexing, false,
+          "Multiplex the scoring signals requests to a host over its HTTP/2 "
+          "connections instead of opening a connection per concurrent "
+          "request");
+ABSL_FLAG(std::optional<int>, curl_sfe_max_concurrent_streams, 0,
+          "Maximum number of concurrent streams per HTTP/2 connection when "
+          "curl_sfe_enable_http2_multiplexing is set. libcurl's default (100) "
+          "is used if 0");
+ABSL_FLAG(std::optional<bool>, curl_sfe_enable_single_flight, false,
+          "Send identical scoring signals GET requests that are in flight at "
+          "the same time as a single transfer");
 ABSL_FLAG(std::optional<int>, curl_sfe_num_workers, 2,
           "Number of threads to use to run transfers over curl handles");
 ABSL_FLAG(std::optional<int>, curl_sfe_queue_max_wait_ms, 1000,
@@ -173,6 +212,11 @@ ABSL_FLAG(std::optional<int>, curl_sfe_queue_max_wait_ms, 1000,
 ABSL_FLAG(std::optional<int>, curl_sfe_work_queue_length, 5000,
           "Maximum number of outstanding curl requests that are allowed to "
           "wait for processing");
+ABSL_FLAG(std::optional<std::string>, chaffing_v2_moving_median_type,
+          "MULTISET",
+          "Moving median implementation tracking the per buyer medians for "
+          "chaffing v2. One of MULTISET or TWO_HEAP (preallocated ring buffer, "
+          "lock-free reads).");
 ABSL_FLAG(std::optional<int>, sfe_bfe_compression_algo, 1L,
           "Compression algorithm used between SFE and BFE. 0 - uncompressed, 1 "
           "- DEFLATE (gzip), 2 - zstd");
@@ -182,6 +226,12 @@ namespace privacy_sandbox::bidding_auction_servers {
 // K-anon service address to use for querying the status of k-anon hashes.
 inline constexpr char kKAnonServiceAddr[] = "kanonymityquery.googleapis.com";
 
+// Number of latest GetBids latencies per buyer used to estimate the buyer's
+// latency percentiles, and how many are needed before any request to the
+// buyer is hedged.
+inline constexpr size_t kBuyerLatencyWindowSize = 200;
+inline constexpr size_t kBuyerLatencyMinSamples = 50;
+
 ReportWinMap GetReportWinMapFromSellerCodeFetchConfig(
     const auction_service::SellerCodeFetchConfig& seller_code_fetch_config) {
   const auto& proto_buyer_report_win_js_urls =
@@ -203,6 +253,38 @@ ReportWinMap GetReportWinMapFromSellerCodeFetchConfig(
   };
 }
 
+KAnonCacheType GetKAnonCacheType(
+    const TrustedServersConfigClient& config_client) {
+  absl::string_view cache_type =
+      config_client.GetStringParameter(K_ANON_CACHE_TYPE);
+  if (cache_type == kKAnonCacheTypeShardedLru) {
+    return KAnonCacheType::kShardedLru;
+  }
+  if (cache_type == kKAnonCacheTypeClock) {
+    return KAnonCacheType::kClock;
+  }
+  if (!cache_type.empty() && cache_type != kKAnonCacheTypeLru) {
+    PS_LOG(WARNING) << "Unknown " << K_ANON_CACHE_TYPE << ": " << cache_type
+                    << ", defaulting to " << kKAnonCacheTypeLru;
+  }
+  return KAnonCacheType::kLru;
+}
+
+MovingMedianType GetChaffingV2MovingMedianType(
+    const TrustedServersConfigClient& config_client) {
+  absl::string_view type =
+      config_client.GetStringParameter(CHAFFING_V2_MOVING_MEDIAN_TYPE);
+  if (type == kChaffingV2MovingMedianTypeTwoHeap) {
+    return MovingMedianType::kTwoHeap;
+  }
+  if (!type.empty() && type != kChaffingV2MovingMedianTypeMultiset) {
+    PS_LOG(WARNING) << "Unknown " << CHAFFING_V2_MOVING_MEDIAN_TYPE << ": "
+                    << type << ", defaulting to "
+                    << kChaffingV2MovingMedianTypeMultiset;
+  }
+  return MovingMedianType::kMultiset;
+}
+
 KAnonCacheManagerConfig GetKAnonCacheManagerConfig(
     const TrustedServersConfigClient& config_client) {
   KAnonCacheManagerConfig config = {
@@ -215,7 +297,8 @@ KAnonCacheManagerConfig GetKAnonCacheManagerConfig(
       .num_non_k_anon_shards =
           config_client.GetIntParameter(NUM_NON_K_ANON_SHARDS),
       .enable_k_anon_cache =
-          config_client.GetBooleanParameter(ENABLE_K_ANON_QUERY_CACHE)};
+          config_client.GetBooleanParameter(ENABLE_K_ANON_QUERY_CACHE),
+      .cache_type = GetKAnonCacheType(config_client)};
 
   if (config_client.GetBooleanParameter(TEST_MODE)) {
     config.k_anon_ttl = absl::Milliseconds(
@@ -335,7 +418,24 @@ absl::StatusOr<TrustedServersConfigClient> GetConfigClient(
                         TEST_MODE_NON_K_ANON_CACHE_TTL_MS);
   config_client.SetFlag(FLAGS_enable_k_anon_query_cache,
                         ENABLE_K_ANON_QUERY_CACHE);
+  config_client.SetFlag(FLAGS_k_anon_cache_type, K_ANON_CACHE_TYPE);
   config_client.SetFlag(FLAGS_enable_buyer_caching, ENABLE_BUYER_CACHING);
+  config_client.SetFlag(FLAGS_enable_incremental_scoring_signals_fetch,
+                        ENABLE_INCREMENTAL_SCORING_SIGNALS_FETCH);
+  config_client.SetFlag(FLAGS_enable_adaptive_get_bids,
+                        ENABLE_ADAPTIVE_GET_BIDS);
+  config_client.SetFlag(FLAGS_get_bids_cutoff_reserve_ms,
+                        GET_BIDS_CUTOFF_RESERVE_MS);
+  config_client.SetFlag(FLAGS_scoring_signals_cache_ttl_ms,
+                        SCORING_SIGNALS_CACHE_TTL_MS);
+  config_client.SetFlag(FLAGS_scoring_signals_cache_max_entries,
+                        SCORING_SIGNALS_CACHE_MAX_ENTRIES);
+  config_client.SetFlag(FLAGS_curl_sfe_enable_single_flight,
+                        CURL_SFE_ENABLE_SINGLE_FLIGHT);
+  config_client.SetFlag(FLAGS_curl_sfe_enable_http2_multiplexing,
+                        CURL_SFE_ENABLE_HTTP2_MULTIPLEXING);
+  config_client.SetFlag(FLAGS_curl_sfe_max_concurrent_streams,
+                        CURL_SFE_MAX_CONCURRENT_STREAMS);
   config_client.SetFlag(FLAGS_parc_addr, PARC_ADDR);
   config_client.SetFlag(FLAGS_enable_chaffing_v2, ENABLE_CHAFFING_V2);
   config_client.SetFlag(FLAGS_curl_sfe_num_workers, CURL_SFE_NUM_WORKERS);
@@ -343,6 +443,8 @@ absl::StatusOr<TrustedServersConfigClient> GetConfigClient(
                         CURL_SFE_QUEUE_MAX_WAIT_MS);
   config_client.SetFlag(FLAGS_curl_sfe_work_queue_length,
                         CURL_SFE_WORK_QUEUE_LENGTH);
+  config_client.SetFlag(FLAGS_chaffing_v2_moving_median_type,
+                        CHAFFING_V2_MOVING_MEDIAN_TYPE);
   config_client.SetFlag(FLAGS_sfe_bfe_compression_algo,
                         SFE_BFE_COMPRESSION_ALGO);
 
@@ -495,8 +597,26 @@ absl::Status RunServer() {
                                                     string_view_key_set.end());
     moving_median_manager = std::make_unique<MovingMedianManager>(
         string_key_set, kChaffingV2MovingMedianWindowSize,
-        kChaffingV2SamplingProbablility);
+        kChaffingV2SamplingProbablility,
+        GetChaffingV2MovingMedianType(config_client));
+  }
+
+  std::unique_ptr<BuyerLatencyTracker> buyer_latency_tracker;
+  if (config_client.GetBooleanParameter(ENABLE_ADAPTIVE_GET_BIDS)) {
+    absl::flat_hash_set<absl::string_view> buyers =
+        KeySet(*buyer_server_hosts_map);
+    buyer_latency_tracker = std::make_unique<BuyerLatencyTracker>(
+        absl::flat_hash_set<std::string>(buyers.begin(), buyers.end()),
+        kBuyerLatencyWindowSize, kBuyerLatencyMinSamples);
+  }
+
+  if (config_client.GetIntParameter(SCORING_SIGNALS_CACHE_TTL_MS) > 0) {
+    PS_RETURN_IF_ERROR(SellerKeyValueCacheMetrics::RegisterSfeMetrics());
+  }
+  if (config_client.GetBooleanParameter(CURL_SFE_ENABLE_SINGLE_FLIGHT)) {
+    PS_RETURN_IF_ERROR(SingleFlightHttpFetcherMetrics::RegisterSfeMetrics());
   }
+  PS_RETURN_IF_ERROR(CurlConnectionMetrics::RegisterSfeMetrics());
 
   // Validate once at startup that the SFE_BFE_COMPRESSION_ALGO value is valid.
   if (!ToCompressionType(
@@ -512,7 +632,7 @@ absl::Status RunServer() {
       CreateCryptoClient(),
       GetReportWinMapFromSellerCodeFetchConfig(code_fetch_proto),
       std::move(k_anon_cache_manager), std::move(invoked_buyers_cache),
-      std::move(moving_median_manager));
+      std::move(moving_median_manager), std::move(buyer_latency_tracker));
   grpc::EnableDefaultHealthCheckService(true);
   grpc::reflection::InitProtoReflectionServerBuilderPlugin();
   ServerBuilder builder;
@@ -20,6 +20,8 @@
 
 #include "api/bidding_auction_servers.pb.h"
 #include "include/grpcpp/impl/codegen/server_callback.h"
+#include "services/common/clients/http/single_flight_http_fetcher_async.h"
+#include "services/common/clients/http_kv_server/seller/caching_seller_key_value_async_client.h"
 #include "services/common/clients/http_kv_server/seller/fake_seller_key_value_async_http_client.h"
 #include "services/common/clients/http_kv_server/seller/seller_key_value_async_http_client.h"
 #include "services/common/metric/server_definition.h"
@@ -84,8 +86,7 @@ SellerFrontEndService::CreateV1KVClient() {
       config_client_.GetIntParameter(CURL_SFE_QUEUE_MAX_WAIT_MS);
   int curl_queue_length =
       config_client_.GetIntParameter(CURL_SFE_WORK_QUEUE_LENGTH);
-  return std::make_unique<SellerKeyValueAsyncHttpClient>(
-      config_client_.GetStringParameter(KEY_VALUE_SIGNALS_HOST),
+  std::unique_ptr<HttpFetcherAsync> http_fetcher_async =
       std::make_unique<MultiCurlHttpFetcherAsync>(
           executor_.get(),
           MultiCurlHttpFetcherAsyncOptions{
@@ -98,8 +99,30 @@ SellerFrontEndService::CreateV1KVClient() {
               .curl_queue_length = curl_queue_length > 0
                                        ? curl_queue_length
                                        : kDefaultMaxCurlPendingRequests,
-          }),
-      true);
+              .enable_http2_multiplexing = config_client_.GetBooleanParameter(
+                  CURL_SFE_ENABLE_HTTP2_MULTIPLEXING),
+              .curlmopt_max_concurrent_streams = config_client_.GetIntParameter(
+                  CURL_SFE_MAX_CONCURRENT_STREAMS),
+          });
+  if (config_client_.GetBooleanParameter(CURL_SFE_ENABLE_SINGLE_FLIGHT)) {
+    http_fetcher_async = std::make_unique<SingleFlightHttpFetcherAsync>(
+        std::move(http_fetcher_async));
+  }
+  auto kv_client = std::make_unique<SellerKeyValueAsyncHttpClient>(
+      config_client_.GetStringParameter(KEY_VALUE_SIGNALS_HOST),
+      std::move(http_fetcher_async), true);
+  const int cache_ttl_ms =
+      config_client_.GetIntParameter(SCORING_SIGNALS_CACHE_TTL_MS);
+  if (cache_ttl_ms <= 0) {
+    return kv_client;
+  }
+  return std::make_unique<CachingSellerKeyValueAsyncClient>(
+      std::move(kv_client),
+      SellerKeyValueCacheOptions{
+          .ttl = absl::Milliseconds(cache_ttl_ms),
+          .max_entries =
+              config_client_.GetIntParameter(SCORING_SIGNALS_CACHE_MAX_ENTRIES),
+      });
 }
 
 grpc::ServerUnaryReactor* SellerFrontEndService::SelectAd(
@@ -39,6 +39,7 @@
 #include "services/seller_frontend_service/providers/scoring_signals_async_provider.h"
 #include "services/seller_frontend_service/report_win_map.h"
 #include "services/seller_frontend_service/runtime_flags.h"
+#include "services/seller_frontend_service/util/buyer_latency_tracker.h"
 #include "services/seller_frontend_service/util/config_param_parser.h"
 #include "src/concurrent/event_engine_executor.h"
 #include "src/core/lib/event_engine/default_event_engine.h"
@@ -70,6 +71,7 @@ struct ClientRegistry {
   std::unique_ptr<KAnonCacheManagerInterface> k_anon_cache_manager;
   std::unique_ptr<InvokedBuyersCache> invoked_buyers_cache;
   std::unique_ptr<MovingMedianManager> moving_median_manager;
+  std::unique_ptr<BuyerLatencyTracker> buyer_latency_tracker;
 };
 
 // SellerFrontEndService implements business logic to orchestrate requests
@@ -88,7 +90,8 @@ class SellerFrontEndService final : public SellerFrontEnd::CallbackService {
       std::unique_ptr<KAnonCacheManagerInterface> k_anon_cache_manager =
           nullptr,
       std::unique_ptr<InvokedBuyersCache> invoked_buyers_cache = nullptr,
-      std::unique_ptr<MovingMedianManager> moving_median_manager = nullptr)
+      std::unique_ptr<MovingMedianManager> moving_median_manager = nullptr,
+      std::unique_ptr<BuyerLatencyTracker> buyer_latency_tracker = nullptr)
       : config_client_(*config_client),
         key_fetcher_manager_(std::move(key_fetcher_manager)),
         crypto_client_(std::move(crypto_client)),
@@ -161,7 +164,8 @@ class SellerFrontEndService final : public SellerFrontEnd::CallbackService {
                 std::make_unique<MultiCurlHttpFetcherAsync>(executor_.get())),
             std::move(k_anon_cache_manager),
             std::move(invoked_buyers_cache),
-            std::move(moving_median_manager)},
+            std::move(moving_median_manager),
+            std::move(buyer_latency_tracker)},
         enable_cancellation_(absl::GetFlag(FLAGS_enable_cancellation)),
         enable_kanon_(absl::GetFlag(FLAGS_enable_kanon)),
         report_win_map_(std::move(report_win_map)),
@@ -67,9 +67,9 @@ BrowserSignalsForBidding ToBrowserSignalsForBidding(
   return signals_for_bidding;
 }
 
-BuyerInputForBidding::InterestGroupForBidding ToInterestGroupForBidding(
-    BuyerInput::InterestGroup&& interest_group) {
-  BuyerInputForBidding::InterestGroupForBidding interest_group_for_bidding;
+void ToInterestGroupForBiddingInto(
+    BuyerInput::InterestGroup&& interest_group,
+    BuyerInputForBidding::InterestGroupForBidding& interest_group_for_bidding) {
   interest_group_for_bidding.set_name(
       std::move(*interest_group.mutable_name()));
   interest_group_for_bidding.mutable_bidding_signals_keys()->Swap(
@@ -95,15 +95,24 @@ BuyerInputForBidding::InterestGroupForBidding ToInterestGroupForBidding(
     interest_group_for_bidding.set_origin(
         std::move(*interest_group.mutable_origin()));
   }
+}
 
+BuyerInputForBidding::InterestGroupForBidding ToInterestGroupForBidding(
+    BuyerInput::InterestGroup&& interest_group) {
+  BuyerInputForBidding::InterestGroupForBidding interest_group_for_bidding;
+  ToInterestGroupForBiddingInto(std::move(interest_group),
+                                interest_group_for_bidding);
   return interest_group_for_bidding;
 }
 
-BuyerInputForBidding ToBuyerInputForBidding(BuyerInput&& buyer_input) {
-  BuyerInputForBidding buyer_input_for_bidding;
+void ToBuyerInputForBiddingInto(BuyerInput&& buyer_input,
+                                BuyerInputForBidding& buyer_input_for_bidding) {
+  buyer_input_for_bidding.mutable_interest_groups()->Reserve(
+      buyer_input.interest_groups_size());
   for (auto&& buyer_interest_group : *buyer_input.mutable_interest_groups()) {
-    *buyer_input_for_bidding.mutable_interest_groups()->Add() =
-        ToInterestGroupForBidding(std::move(buyer_interest_group));
+    ToInterestGroupForBiddingInto(
+        std::move(buyer_interest_group),
+        *buyer_input_for_bidding.mutable_interest_groups()->Add());
   }
 
   if (buyer_input.has_protected_app_signals()) {
@@ -113,7 +122,11 @@ BuyerInputForBidding ToBuyerInputForBidding(BuyerInput&& buyer_input) {
 
   buyer_input_for_bidding.set_in_cooldown_or_lockout(
       buyer_input.in_cooldown_or_lockout());
+}
 
+BuyerInputForBidding ToBuyerInputForBidding(BuyerInput&& buyer_input) {
+  BuyerInputForBidding buyer_input_for_bidding;
+  ToBuyerInputForBiddingInto(std::move(buyer_input), buyer_input_for_bidding);
   return buyer_input_for_bidding;
 }
 
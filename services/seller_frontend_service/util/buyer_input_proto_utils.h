@@ -33,8 +33,23 @@ BrowserSignalsForBidding ToBrowserSignalsForBidding(
 BuyerInputForBidding::InterestGroupForBidding ToInterestGroupForBidding(
     BuyerInput::InterestGroup&& interest_group);
 
+// Converts `interest_group` into `interest_group_for_bidding`, which is
+// expected to be empty. Unlike ToInterestGroupForBidding(), this lets the
+// caller allocate the output, e.g. on the arena of `interest_group`, where the
+// repeated fields are swapped in without copies.
+void ToInterestGroupForBiddingInto(
+    BuyerInput::InterestGroup&& interest_group,
+    BuyerInputForBidding::InterestGroupForBidding& interest_group_for_bidding);
+
 BuyerInputForBidding ToBuyerInputForBidding(BuyerInput&& buyer_input);
 
+// Converts `buyer_input` into `buyer_input_for_bidding`, which is expected to
+// be empty. Unlike ToBuyerInputForBidding(), this lets the caller allocate the
+// output, e.g. on the arena of `buyer_input`, so that the converted request is
+// not copied from the heap into the arena.
+void ToBuyerInputForBiddingInto(BuyerInput&& buyer_input,
+                                BuyerInputForBidding& buyer_input_for_bidding);
+
 BuyerInput ToBuyerInput(const BuyerInputForBidding& buyer_input_for_bidding);
 
 }  // namespace privacy_sandbox::bidding_auction_servers
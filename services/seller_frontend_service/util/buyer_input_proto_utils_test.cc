@@ -20,6 +20,7 @@
 
 #include <include/gmock/gmock-matchers.h>
 
+#include "google/protobuf/arena.h"
 #include "gtest/gtest.h"
 
 namespace privacy_sandbox::bidding_auction_servers {
@@ -229,6 +230,28 @@ TEST(BuyerInputProtoUtilsTest, ToBuyerInputForBidding) {
   EXPECT_EQ(input_str, buyer_input_for_bidding.DebugString());
 }
 
+TEST(BuyerInputProtoUtilsTest, ToBuyerInputForBiddingIntoArenaMessage) {
+  google::protobuf::Arena arena;
+  auto* buyer_input = google::protobuf::Arena::Create<BuyerInput>(&arena);
+  *buyer_input = GenerateBuyerInput();
+  ASSERT_GT(buyer_input->interest_groups_size(), 0);
+  buyer_input->mutable_interest_groups(0)->add_bidding_signals_keys("key");
+  BuyerInput expected_input = *buyer_input;
+  const std::string* bidding_signals_key =
+      &buyer_input->interest_groups(0).bidding_signals_keys(0);
+
+  auto* buyer_input_for_bidding =
+      google::protobuf::Arena::Create<BuyerInputForBidding>(&arena);
+  ToBuyerInputForBiddingInto(std::move(*buyer_input), *buyer_input_for_bidding);
+
+  EXPECT_EQ(buyer_input_for_bidding->DebugString(),
+            ToBuyerInputForBidding(std::move(expected_input)).DebugString());
+  // The repeated fields are swapped in rather than copied.
+  EXPECT_EQ(
+      &buyer_input_for_bidding->interest_groups(0).bidding_signals_keys(0),
+      bidding_signals_key);
+}
+
 BuyerInputForBidding GenerateBuyerInputForBidding() {
   BuyerInputForBidding buyer_input_for_bidding;
   SetRandomMessage(buyer_input_for_bidding.GetDescriptor(),
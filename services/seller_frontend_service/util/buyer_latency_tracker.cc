@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "services/seller_frontend_service/util/buyer_latency_tracker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+inline constexpr absl::string_view kBuyerNotPresentError =
+    "Buyer not present in latency tracker: ";
+
+}  // namespace
+
+BuyerLatencyTracker::BuyerLatencyTracker(
+    const absl::flat_hash_set<std::string>& buyers, size_t window_size,
+    size_t min_samples)
+    : window_size_(std::max<size_t>(window_size, 1)),
+      min_samples_(std::clamp<size_t>(min_samples, 1, window_size_)) {
+  for (const std::string& buyer : buyers) {
+    auto window = std::make_unique<Window>();
+    window->latencies.reserve(window_size_);
+    windows_by_buyer_.emplace(buyer, std::move(window));
+  }
+}
+
+absl::Status BuyerLatencyTracker::RecordLatency(absl::string_view buyer,
+                                                absl::Duration latency) {
+  auto it = windows_by_buyer_.find(buyer);
+  if (it == windows_by_buyer_.end()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat(kBuyerNotPresentError, buyer));
+  }
+
+  Window& window = *it->second;
+  absl::MutexLock lock(&window.mu);
+  if (window.latencies.size() < window_size_) {
+    window.latencies.push_back(latency);
+    return absl::OkStatus();
+  }
+  window.latencies[window.next] = latency;
+  window.next = (window.next + 1) % window_size_;
+  return absl::OkStatus();
+}
+
+absl::StatusOr<absl::Duration> BuyerLatencyTracker::GetPercentile(
+    absl::string_view buyer, double percentile) const {
+  auto it = windows_by_buyer_.find(buyer);
+  if (it == windows_by_buyer_.end()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat(kBuyerNotPresentError, buyer));
+  }
+  if (percentile <= 0 || percentile > 1) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Percentile out of (0, 1]: ", percentile));
+  }
+
+  // Copy the window so that the selection below doesn't block the callers
+  // recording latencies.
+  std::vector<absl::Duration> latencies;
+  {
+    const Window& window = *it->second;
+    absl::MutexLock lock(&window.mu);
+    latencies = window.latencies;
+  }
+  if (latencies.size() < min_samples_) {
+    return absl::FailedPreconditionError(
+        absl::StrCat("Not enough latencies tracked for buyer: ", buyer));
+  }
+
+  // Nearest-rank percentile.
+  const size_t rank = static_cast<size_t>(
+      std::ceil(percentile * static_cast<double>(latencies.size())));
+  const auto nth = latencies.begin() + (std::max<size_t>(rank, 1) - 1);
+  std::nth_element(latencies.begin(), nth, latencies.end());
+  return *nth;
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERVICES_SELLER_FRONTEND_SERVICE_UTIL_BUYER_LATENCY_TRACKER_H_
+#define SERVICES_SELLER_FRONTEND_SERVICE_UTIL_BUYER_LATENCY_TRACKER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// Tracks the latencies of the latest GetBids calls per buyer over a sliding
+// window, to estimate latency percentiles that follow each buyer's current
+// behavior. The set of buyers is fixed at construction.
+//
+// This class is thread-safe.
+class BuyerLatencyTracker {
+ public:
+  // `min_samples` is the number of latencies a buyer's window needs before
+  // percentiles are estimated for the buyer.
+  BuyerLatencyTracker(const absl::flat_hash_set<std::string>& buyers,
+                      size_t window_size, size_t min_samples);
+
+  // Adds a latency to a buyer's window, evicting the oldest one if the window
+  // is full.
+  absl::Status RecordLatency(absl::string_view buyer, absl::Duration latency);
+
+  // Returns the `percentile` (in (0, 1]) of a buyer's latencies, or an error
+  // if the buyer is unknown or its window holds fewer than `min_samples`
+  // latencies.
+  absl::StatusOr<absl::Duration> GetPercentile(absl::string_view buyer,
+                                               double percentile) const;
+
+ private:
+  // Ring buffer of latencies.
+  struct Window {
+    mutable absl::Mutex mu;
+    std::vector<absl::Duration> latencies ABSL_GUARDED_BY(mu);
+    // Index of the oldest latency once the window is full.
+    size_t next ABSL_GUARDED_BY(mu) = 0;
+  };
+
+  const size_t window_size_;
+  const size_t min_samples_;
+  // Not modified after construction, so only the windows need locking.
+  absl::flat_hash_map<std::string, std::unique_ptr<Window>> windows_by_buyer_;
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_SELLER_FRONTEND_SERVICE_UTIL_BUYER_LATENCY_TRACKER_H_
@@ -0,0 +1,107 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/seller_frontend_service/util/buyer_latency_tracker.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+constexpr absl::string_view kBuyer = "https://buyer.com";
+
+TEST(BuyerLatencyTrackerTest, FailsForUnknownBuyer) {
+  BuyerLatencyTracker tracker({std::string(kBuyer)}, /*window_size=*/10,
+                              /*min_samples=*/1);
+  EXPECT_FALSE(tracker.RecordLatency("unknown", absl::Milliseconds(1)).ok());
+  EXPECT_FALSE(tracker.GetPercentile("unknown", 0.5).ok());
+}
+
+TEST(BuyerLatencyTrackerTest, FailsUntilMinSamplesAreRecorded) {
+  BuyerLatencyTracker tracker({std::string(kBuyer)}, /*window_size=*/10,
+                              /*min_samples=*/3);
+  ASSERT_TRUE(tracker.RecordLatency(kBuyer, absl::Milliseconds(1)).ok());
+  ASSERT_TRUE(tracker.RecordLatency(kBuyer, absl::Milliseconds(2)).ok());
+  EXPECT_FALSE(tracker.GetPercentile(kBuyer, 0.5).ok());
+  ASSERT_TRUE(tracker.RecordLatency(kBuyer, absl::Milliseconds(3)).ok());
+  EXPECT_TRUE(tracker.GetPercentile(kBuyer, 0.5).ok());
+}
+
+TEST(BuyerLatencyTrackerTest, ReturnsNearestRankPercentiles) {
+  BuyerLatencyTracker tracker({std::string(kBuyer)}, /*window_size=*/100,
+                              /*min_samples=*/1);
+  // Record 100ms down to 1ms, so that the window isn't sorted.
+  for (int i = 100; i > 0; --i) {
+    ASSERT_TRUE(tracker.RecordLatency(kBuyer, absl::Milliseconds(i)).ok());
+  }
+  EXPECT_EQ(*tracker.GetPercentile(kBuyer, 0.5), absl::Milliseconds(50));
+  EXPECT_EQ(*tracker.GetPercentile(kBuyer, 0.95), absl::Milliseconds(95));
+  EXPECT_EQ(*tracker.GetPercentile(kBuyer, 1), absl::Milliseconds(100));
+  EXPECT_EQ(*tracker.GetPercentile(kBuyer, 0.001), absl::Milliseconds(1));
+  EXPECT_FALSE(tracker.GetPercentile(kBuyer, 0).ok());
+  EXPECT_FALSE(tracker.GetPercentile(kBuyer, 1.5).ok());
+}
+
+TEST(BuyerLatencyTrackerTest, EvictsOldestLatencies) {
+  BuyerLatencyTracker tracker({std::string(kBuyer)}, /*window_size=*/3,
+                              /*min_samples=*/1);
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_TRUE(
+        tracker.RecordLatency(kBuyer, absl::Milliseconds(100 * i)).ok());
+  }
+  EXPECT_EQ(*tracker.GetPercentile(kBuyer, 1), absl::Milliseconds(300));
+  // Evict all of 100ms, 200ms and 300ms.
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_TRUE(tracker.RecordLatency(kBuyer, absl::Milliseconds(i)).ok());
+  }
+  EXPECT_EQ(*tracker.GetPercentile(kBuyer, 1), absl::Milliseconds(3));
+}
+
+TEST(BuyerLatencyTrackerTest, TracksBuyersIndependently) {
+  const std::string other_buyer = "https://other-buyer.com";
+  BuyerLatencyTracker tracker({std::string(kBuyer), other_buyer},
+                              /*window_size=*/10, /*min_samples=*/1);
+  ASSERT_TRUE(tracker.RecordLatency(kBuyer, absl::Milliseconds(1)).ok());
+  ASSERT_TRUE(tracker.RecordLatency(other_buyer, absl::Seconds(1)).ok());
+  EXPECT_EQ(*tracker.GetPercentile(kBuyer, 1), absl::Milliseconds(1));
+  EXPECT_EQ(*tracker.GetPercentile(other_buyer, 1), absl::Seconds(1));
+}
+
+TEST(BuyerLatencyTrackerTest, RecordsLatenciesConcurrently) {
+  constexpr int kNumThreads = 8;
+  constexpr int kLatenciesPerThread = 1000;
+  BuyerLatencyTracker tracker({std::string(kBuyer)}, /*window_size=*/64,
+                              /*min_samples=*/1);
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&tracker]() {
+      for (int j = 0; j < kLatenciesPerThread; ++j) {
+        EXPECT_TRUE(
+            tracker.RecordLatency(kBuyer, absl::Milliseconds(j % 10)).ok());
+        EXPECT_TRUE(tracker.GetPercentile(kBuyer, 0.95).ok());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_LT(*tracker.GetPercentile(kBuyer, 1), absl::Milliseconds(10));
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -169,4 +169,32 @@ absl::Status CborSerializeString(absl::string_view key, absl::string_view value,
 
   return absl::OkStatus();
 }
+
+void CborSerializeByteString(absl::string_view key, absl::string_view value,
+                             CborWriter& writer) {
+  writer.WriteTextString(key);
+  writer.WriteByteString(value);
+}
+
+void CborSerializeFloat(absl::string_view key, double value,
+                        CborWriter& writer) {
+  writer.WriteTextString(key);
+  writer.WriteFloat(value);
+}
+
+void CborSerializeBool(absl::string_view key, bool value, CborWriter& writer) {
+  writer.WriteTextString(key);
+  writer.WriteBool(value);
+}
+
+void CborSerializeInt(absl::string_view key, int value, CborWriter& writer) {
+  writer.WriteTextString(key);
+  writer.WriteInt(value);
+}
+
+void CborSerializeString(absl::string_view key, absl::string_view value,
+                         CborWriter& writer) {
+  writer.WriteTextString(key);
+  writer.WriteTextString(value);
+}
 }  // namespace privacy_sandbox::bidding_auction_servers
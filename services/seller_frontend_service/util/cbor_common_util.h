@@ -21,6 +21,7 @@
 #include <string>
 
 #include "absl/status/statusor.h"
+#include "services/common/util/cbor_writer.h"
 #include "services/common/util/data_util.h"
 #include "services/common/util/error_accumulator.h"
 #include "services/common/util/request_response_constants.h"
@@ -139,6 +140,19 @@ absl::Status CborSerializeInt(absl::string_view key, int value,
 // map and handles errors using the provided error handler.
 absl::Status CborSerializeString(absl::string_view key, absl::string_view value,
                                  ErrorHandler error_handler, cbor_item_t& root);
+
+// Counterparts of the above that write the key-value pair to the map currently
+// open in `writer`. Values are converted exactly like the libcbor based
+// versions above (e.g. integers are narrowed to `int`) so that both produce
+// the same bytes.
+void CborSerializeByteString(absl::string_view key, absl::string_view value,
+                             CborWriter& writer);
+void CborSerializeFloat(absl::string_view key, double value,
+                        CborWriter& writer);
+void CborSerializeBool(absl::string_view key, bool value, CborWriter& writer);
+void CborSerializeInt(absl::string_view key, int value, CborWriter& writer);
+void CborSerializeString(absl::string_view key, absl::string_view value,
+                         CborWriter& writer);
 }  // namespace privacy_sandbox::bidding_auction_servers
 
 #endif  // SERVICES_SELLER_FRONTEND_SERVICE_UTIL_CBOR_COMMON_UTIL_H_
@@ -0,0 +1,936 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "services/seller_frontend_service/util/cbor_tree_encode.h"
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "services/common/util/scoped_cbor.h"
+#include "services/seller_frontend_service/private_aggregation/private_aggregation_helper.h"
+#include "services/seller_frontend_service/util/web_utils.h"
+#include "src/util/status_macro/status_macros.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+using BiddingGroupMap =
+    ::google::protobuf::Map<std::string, AuctionResult::InterestGroupIndex>;
+using InteractionUrlMap = ::google::protobuf::Map<std::string, std::string>;
+using RepeatedStringProto = ::google::protobuf::RepeatedPtrField<std::string>;
+using GhostWinnerForTopLevelAuction =
+    AuctionResult::KAnonGhostWinner::GhostWinnerForTopLevelAuction;
+using GhostWinnerPrivateAggregationSignals =
+    AuctionResult::KAnonGhostWinner::GhostWinnerPrivateAggregationSignals;
+
+struct cbor_pair BuildCborKVPair(absl::string_view key,
+                                 absl::string_view value) {
+  return {.key = cbor_move(cbor_build_stringn(key.data(), key.size())),
+          .value = cbor_move(cbor_build_stringn(value.data(), value.size()))};
+}
+
+absl::Status AddKVToMap(absl::string_view key, absl::string_view value,
+                        ErrorHandler error_handler, cbor_item_t& map) {
+  if (!cbor_map_add(&map, BuildCborKVPair(key, value))) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL, absl::StrCat("Failed to serialize ", key, " to CBOR")));
+    return absl::InternalError("");
+  }
+
+  return absl::OkStatus();
+}
+
+absl::Status CborSerializeInteractionReportingUrls(
+    const InteractionUrlMap& interaction_url_map, ErrorHandler error_handler,
+    cbor_item_t& root) {
+  ScopedCbor serialized_interaction_url_map(
+      cbor_new_definite_map(interaction_url_map.size()));
+  std::set<absl::string_view, decltype(kComparator)> ordered_events(
+      kComparator);
+  for (const auto& [event, unused] : interaction_url_map) {
+    ordered_events.insert(event);
+  }
+  for (const auto& event : ordered_events) {
+    PS_RETURN_IF_ERROR(AddKVToMap(event, interaction_url_map.at(event),
+                                  error_handler,
+                                  **serialized_interaction_url_map));
+  }
+  struct cbor_pair kv = {
+      .key = cbor_move(cbor_build_stringn(
+          kInteractionReportingUrls, sizeof(kInteractionReportingUrls) - 1)),
+      .value = *serialized_interaction_url_map};
+  if (!cbor_map_add(&root, kv)) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL, absl::StrCat("Failed to serialize ",
+                                     kInteractionReportingUrls, " to CBOR")));
+    return absl::InternalError("");
+  }
+  return absl::OkStatus();
+}
+
+absl::Status CborSerializeReportingUrls(
+    absl::string_view key,
+    const WinReportingUrls::ReportingUrls& reporting_urls,
+    ErrorHandler error_handler, cbor_item_t& root) {
+  int key_count = 0;
+  if (!reporting_urls.reporting_url().empty()) {
+    key_count++;
+  }
+  if (!reporting_urls.interaction_reporting_urls().empty()) {
+    key_count++;
+  }
+  if (key_count == 0) {
+    return absl::OkStatus();
+  }
+  ScopedCbor serialized_reporting_urls(
+      cbor_new_definite_map(kNumReportingUrlsKeys));
+  if (!reporting_urls.reporting_url().empty()) {
+    PS_RETURN_IF_ERROR(AddKVToMap(kReportingUrl, reporting_urls.reporting_url(),
+                                  error_handler, **serialized_reporting_urls));
+  }
+  if (!reporting_urls.interaction_reporting_urls().empty()) {
+    PS_RETURN_IF_ERROR(CborSerializeInteractionReportingUrls(
+        reporting_urls.interaction_reporting_urls(), error_handler,
+        **serialized_reporting_urls));
+  }
+  struct cbor_pair serialized_reporting_urls_kv = {
+      .key = cbor_move(cbor_build_stringn(key.data(), key.size())),
+      .value = *serialized_reporting_urls,
+  };
+
+  if (!cbor_map_add(&root, serialized_reporting_urls_kv)) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL, absl::StrCat("Failed to serialize ", key, " to CBOR")));
+    return absl::InternalError("");
+  }
+
+  return absl::OkStatus();
+}
+
+absl::Status CborSerializeAdComponentUrls(
+    absl::string_view key, const RepeatedStringProto& component_renders,
+    ErrorHandler error_handler, cbor_item_t& root) {
+  ScopedCbor serialized_component_renders(
+      cbor_new_definite_array(component_renders.size()));
+  for (const auto& component_render : component_renders) {
+    if (!cbor_array_push(
+            *serialized_component_renders,
+            cbor_move(cbor_build_stringn(component_render.data(),
+                                         component_render.size())))) {
+      error_handler(
+          grpc::Status(grpc::INTERNAL,
+                       absl::StrCat("Failed to serialize ", key, " to CBOR")));
+      return absl::InternalError("");
+    }
+  }
+
+  struct cbor_pair kv = {
+      .key = cbor_move(cbor_build_stringn(key.data(), key.size())),
+      .value = *serialized_component_renders};
+  if (!cbor_map_add(&root, kv)) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL, absl::StrCat("Failed to serialize ", key, " to CBOR")));
+    return absl::InternalError("");
+  }
+
+  return absl::OkStatus();
+}
+
+absl::Status CborSerializekAnonJoinCandidates(
+    absl::string_view key, const KAnonJoinCandidate& kanon_join_candidate,
+    ErrorHandler error_handler, cbor_item_t& root) {
+  ScopedCbor serialized_kanon_join_candidates(
+      cbor_new_definite_map(kNumKAnonJoinCandidateKeys));
+  PS_RETURN_IF_ERROR(CborSerializeByteString(
+      kAdRenderUrlHash, kanon_join_candidate.ad_render_url_hash(),
+      error_handler, **serialized_kanon_join_candidates));
+  PS_RETURN_IF_ERROR(CborSerializeByteString(
+      kReportingIdHash, kanon_join_candidate.reporting_id_hash(), error_handler,
+      **serialized_kanon_join_candidates));
+  const auto& input_ad_component_render_urls_hash =
+      kanon_join_candidate.ad_component_render_urls_hash();
+  ScopedCbor ad_component_render_urls_hash(
+      cbor_new_definite_array(input_ad_component_render_urls_hash.size()));
+  for (const auto& ad_component_render_url_hash :
+       input_ad_component_render_urls_hash) {
+    if (!cbor_array_push(*ad_component_render_urls_hash,
+                         cbor_move(cbor_build_bytestring(
+                             ReinterpretConstCharPtrAsUnsignedPtr(
+                                 ad_component_render_url_hash.data()),
+                             ad_component_render_url_hash.size())))) {
+      error_handler(grpc::Status(
+          grpc::INTERNAL,
+          "Failed to serialize ad component render URL hash to CBOR"));
+      return absl::InternalError("");
+    }
+  }
+  struct cbor_pair kv = {
+      .key = cbor_move(cbor_build_stringn(
+          kAdComponentRenderUrlsHash, sizeof(kAdComponentRenderUrlsHash) - 1)),
+      .value = *ad_component_render_urls_hash};
+  if (!cbor_map_add(*serialized_kanon_join_candidates, kv)) {
+    error_handler(
+        grpc::Status(grpc::INTERNAL,
+                     "Failed to serialize kAdComponentRenderUrlsHash to CBOR"));
+    return absl::InternalError("");
+  }
+  struct cbor_pair outer_kv = {
+      .key = cbor_move(cbor_build_stringn(key.data(), key.size())),
+      .value = *serialized_kanon_join_candidates};
+  if (!cbor_map_add(&root, outer_kv)) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL, "Failed to serialize kAnonJoinCandidate to CBOR"));
+    return absl::InternalError("");
+  }
+  return absl::OkStatus();
+}
+
+absl::Status CborSerializekAnonGhostWinnerForTopLevelAuction(
+    absl::string_view key,
+    const GhostWinnerForTopLevelAuction& ghost_winner_for_top_level_auction,
+    ErrorHandler error_handler, cbor_item_t& root) {
+  // Logic in the rest of the system guarantees that:
+  // - buyer_bid must be > 0 for the AdWithBid to be scored
+  // - modified bid is replaced by buyer_bid if modified bid is <= 0
+  // Therefore if modified bid is 0 here,
+  // there must have been an error in B&A logic.
+  // Chrome regards modified bids of 0 as invalid and will reject them.
+  // Thus we return an error for modified bids <= 0.
+  if (ghost_winner_for_top_level_auction.modified_bid() <= 0.0f) {
+    return absl::Status(absl::StatusCode::kInternal,
+                        "Logic Error: Modified bid should be positive for "
+                        "ghost winners");
+  }
+  ScopedCbor serialized_ghost_winner(
+      cbor_new_definite_map(kNumGhostWinnerForTopLevelAuctionKeys));
+  if (!ghost_winner_for_top_level_auction.ad_metadata().empty()) {
+    PS_RETURN_IF_ERROR(CborSerializeString(
+        kAdMetadata, ghost_winner_for_top_level_auction.ad_metadata(),
+        error_handler, **serialized_ghost_winner));
+  }
+  PS_RETURN_IF_ERROR(CborSerializeString(
+      kAdRenderUrl, ghost_winner_for_top_level_auction.ad_render_url(),
+      error_handler, **serialized_ghost_winner));
+  if (!ghost_winner_for_top_level_auction.bid_currency().empty()) {
+    PS_RETURN_IF_ERROR(CborSerializeString(
+        kBidCurrency, ghost_winner_for_top_level_auction.bid_currency(),
+        error_handler, **serialized_ghost_winner));
+  }
+  PS_RETURN_IF_ERROR(CborSerializeFloat(
+      kModifiedBid, ghost_winner_for_top_level_auction.modified_bid(),
+      error_handler, **serialized_ghost_winner));
+  if (ghost_winner_for_top_level_auction.has_buyer_reporting_id()) {
+    PS_RETURN_IF_ERROR(CborSerializeString(
+        kBuyerReportingId,
+        ghost_winner_for_top_level_auction.buyer_reporting_id(), error_handler,
+        **serialized_ghost_winner));
+  }
+
+  ScopedCbor serialized_ad_component_render_urls(cbor_new_definite_array(
+      ghost_winner_for_top_level_auction.ad_component_render_urls_size()));
+  for (auto& ad_component_render_url :
+       ghost_winner_for_top_level_auction.ad_component_render_urls()) {
+    if (!cbor_array_push(
+            *serialized_ad_component_render_urls,
+            cbor_move(cbor_build_stringn(ad_component_render_url.data(),
+                                         ad_component_render_url.size())))) {
+      error_handler(grpc::Status(grpc::INTERNAL,
+                                 "Failed to serialize a ad component render "
+                                 "url for ghost winner to CBOR"));
+      return absl::InternalError("");
+    }
+  }
+  struct cbor_pair kv = {
+      .key = cbor_move(cbor_build_stringn(kAdComponentRenderUrls,
+                                          sizeof(kAdComponentRenderUrls) - 1)),
+      .value = *serialized_ad_component_render_urls};
+  if (!cbor_map_add(*serialized_ghost_winner, kv)) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL, "Failed to serialize adComponentRenderUrls to CBOR"));
+    return absl::InternalError("");
+  }
+
+  if (ghost_winner_for_top_level_auction.has_buyer_and_seller_reporting_id()) {
+    PS_RETURN_IF_ERROR(CborSerializeString(
+        kBuyerAndSellerReportingId,
+        ghost_winner_for_top_level_auction.buyer_and_seller_reporting_id(),
+        error_handler, **serialized_ghost_winner));
+  }
+  if (ghost_winner_for_top_level_auction
+          .has_selected_buyer_and_seller_reporting_id()) {
+    PS_RETURN_IF_ERROR(
+        CborSerializeString(kSelectedBuyerAndSellerReportingId,
+                            ghost_winner_for_top_level_auction
+                                .selected_buyer_and_seller_reporting_id(),
+                            error_handler, **serialized_ghost_winner));
+  }
+
+  struct cbor_pair outer_kv = {
+      .key = cbor_move(cbor_build_stringn(key.data(), key.size())),
+      .value = *serialized_ghost_winner};
+  if (!cbor_map_add(&root, outer_kv)) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL, "Failed to serialize kAnonJoinCandidate to CBOR"));
+    return absl::InternalError("");
+  }
+  return absl::OkStatus();
+}
+
+absl::Status CborSerializekAnonGhostWinnerPrivateAggSignal(
+    const GhostWinnerPrivateAggregationSignals& signal,
+    ErrorHandler error_handler, cbor_item_t& root) {
+  ScopedCbor serialized_private_agg_signal(
+      cbor_new_definite_map(kNumGhostWinnerPrivateAggregationSignalsKeys));
+  PS_RETURN_IF_ERROR(CborSerializeInt(kValue, signal.value(), error_handler,
+                                      **serialized_private_agg_signal));
+  PS_RETURN_IF_ERROR(CborSerializeByteString(kBucket, signal.bucket(),
+                                             error_handler,
+                                             **serialized_private_agg_signal));
+
+  if (!cbor_array_push(&root, *serialized_private_agg_signal)) {
+    error_handler(
+        grpc::Status(grpc::INTERNAL,
+                     "Failed to serialize a "
+                     "GhostWinnerPrivateAggregationSignals object to CBOR"));
+    return absl::InternalError("");
+  }
+  return absl::OkStatus();
+}
+
+absl::Status CborSerializekAnonGhostWinnerPrivateAggSignals(
+    absl::string_view key,
+    const google::protobuf::RepeatedPtrField<
+        GhostWinnerPrivateAggregationSignals>& private_agg_signals,
+    ErrorHandler error_handler, cbor_item_t& root) {
+  ScopedCbor serialized_private_agg_signals(
+      cbor_new_definite_array(private_agg_signals.size()));
+  for (const auto& signal : private_agg_signals) {
+    if (auto status = CborSerializekAnonGhostWinnerPrivateAggSignal(
+            signal, error_handler, **serialized_private_agg_signals);
+        !status.ok()) {
+      error_handler(
+          grpc::Status(grpc::INTERNAL,
+                       "Failed to serialize an array of "
+                       "GhostWinnerPrivateAggregationSignals to CBOR"));
+      return absl::InternalError("");
+    }
+  }
+  struct cbor_pair kv = {
+      .key = cbor_move(cbor_build_stringn(
+          kGhostWinnerPrivateAggregationSignals,
+          sizeof(kGhostWinnerPrivateAggregationSignals) - 1)),
+      .value = *serialized_private_agg_signals};
+  if (!cbor_map_add(&root, kv)) {
+    error_handler(grpc::Status(grpc::INTERNAL,
+                               "Failed to serialize an array of "
+                               "GhostWinnerPrivateAggregationSignals to CBOR"));
+    return absl::InternalError("");
+  }
+  return absl::OkStatus();
+}
+
+absl::Status CborSerializeKAnonGhostWinner(
+    const AuctionResult::KAnonGhostWinner& kanon_ghost_winner,
+    ErrorHandler error_handler, cbor_item_t& root) {
+  ScopedCbor serialized_kanon_ghost_winner(
+      cbor_new_definite_map(kNumKAnonGhostWinnerKeys));
+  PS_RETURN_IF_ERROR(CborSerializeString(kOwner, kanon_ghost_winner.owner(),
+                                         error_handler,
+                                         **serialized_kanon_ghost_winner));
+  PS_RETURN_IF_ERROR(
+      CborSerializeString(kInterestGroupName, kanon_ghost_winner.ig_name(),
+                          error_handler, **serialized_kanon_ghost_winner));
+  PS_RETURN_IF_ERROR(CborSerializeInt(
+      kInterestGroupIndex, kanon_ghost_winner.interest_group_index(),
+      error_handler, **serialized_kanon_ghost_winner));
+  PS_RETURN_IF_ERROR(CborSerializekAnonJoinCandidates(
+      kKAnonJoinCandidates, kanon_ghost_winner.k_anon_join_candidates(),
+      error_handler, **serialized_kanon_ghost_winner));
+  if (kanon_ghost_winner.has_ghost_winner_for_top_level_auction()) {
+    PS_RETURN_IF_ERROR(CborSerializekAnonGhostWinnerForTopLevelAuction(
+        kGhostWinnerForTopLevelAuction,
+        kanon_ghost_winner.ghost_winner_for_top_level_auction(), error_handler,
+        **serialized_kanon_ghost_winner));
+  }
+  if (!kanon_ghost_winner.ghost_winner_private_aggregation_signals().empty()) {
+    PS_RETURN_IF_ERROR(CborSerializekAnonGhostWinnerPrivateAggSignals(
+        kGhostWinnerPrivateAggregationSignals,
+        kanon_ghost_winner.ghost_winner_private_aggregation_signals(),
+        error_handler, **serialized_kanon_ghost_winner));
+  }
+  if (!cbor_array_push(&root, *serialized_kanon_ghost_winner)) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL,
+        "Failed to serialize ad component render URL hash to CBOR"));
+    return absl::InternalError("");
+  }
+  return absl::OkStatus();
+}
+
+absl::Status CborSerializeKAnonGhostWinners(
+    absl::string_view key,
+    const std::vector<AuctionResult::KAnonGhostWinner>& kanon_ghost_winners,
+    ErrorHandler error_handler, cbor_item_t& root) {
+  ScopedCbor serialized_kanon_ghost_winners(
+      cbor_new_definite_array(kanon_ghost_winners.size()));
+  for (const auto& kanon_ghost_winner : kanon_ghost_winners) {
+    if (auto status =
+            CborSerializeKAnonGhostWinner(kanon_ghost_winner, error_handler,
+                                          **serialized_kanon_ghost_winners);
+        !status.ok()) {
+      error_handler(grpc::Status(
+          grpc::INTERNAL, "Failed to serialize a kAnonGhostWinner to CBOR"));
+      return absl::InternalError("");
+    }
+  }
+  struct cbor_pair kv = {
+      .key = cbor_move(cbor_build_stringn(kKAnonGhostWinners,
+                                          sizeof(kKAnonGhostWinners) - 1)),
+      .value = *serialized_kanon_ghost_winners};
+  if (!cbor_map_add(&root, kv)) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL, "Failed to serialize kAnonGhostWinners to CBOR"));
+    return absl::InternalError("");
+  }
+  return absl::OkStatus();
+}
+
+absl::Status CborSerializeScoreAdResponse(
+    const ScoreAdsResponse::AdScore& ad_score,
+    const BiddingGroupMap& bidding_group_map,
+    const UpdateGroupMap& update_group_map,
+    const AdtechOriginDebugUrlsMap& adtech_origin_debug_urls_map,
+    int per_adtech_paapi_contributions_limit,
+    absl::string_view ad_auction_result_nonce,
+    std::unique_ptr<KAnonAuctionResultData> kanon_auction_result_data,
+    ErrorHandler error_handler, cbor_item_t& root) {
+  PS_RETURN_IF_ERROR(
+      CborSerializeFloat(kBid, ad_score.buyer_bid(), error_handler, root));
+  if (!ad_auction_result_nonce.empty()) {
+    PS_RETURN_IF_ERROR(CborSerializeString(
+        kAdAuctionResultNonce, ad_auction_result_nonce, error_handler, root));
+  }
+  PS_RETURN_IF_ERROR(
+      CborSerializeFloat(kScore, ad_score.desirability(), error_handler, root));
+  PS_RETURN_IF_ERROR(CborSerializeBool(kChaff, false, error_handler, root));
+  PS_RETURN_IF_ERROR(CborSerializeAdComponentUrls(
+      kAdComponents, ad_score.component_renders(), error_handler, root));
+  PS_RETURN_IF_ERROR(CborSerializeString(kAdRenderUrl, ad_score.render(),
+                                         error_handler, root));
+  if (ad_score.top_level_contributions().size() > 0) {
+    PS_RETURN_IF_ERROR(CborSerializePAggResponse(
+        ad_score.top_level_contributions(),
+        per_adtech_paapi_contributions_limit, error_handler, root));
+  }
+  PS_RETURN_IF_ERROR(CborSerializeDebugReports(adtech_origin_debug_urls_map,
+                                               error_handler, root));
+  PS_RETURN_IF_ERROR(
+      CborSerializeUpdateGroups(update_group_map, error_handler, root));
+  PS_RETURN_IF_ERROR(
+      CborSerializeBiddingGroups(bidding_group_map, error_handler, root));
+  if (!ad_score.buyer_reporting_id().empty()) {
+    PS_RETURN_IF_ERROR(CborSerializeString(
+        kBuyerReportingId, ad_score.buyer_reporting_id(), error_handler, root));
+  }
+  PS_RETURN_IF_ERROR(CborSerializeWinReportingUrls(
+      ad_score.win_reporting_urls(), error_handler, root));
+  PS_RETURN_IF_ERROR(CborSerializeString(
+      kInterestGroupName, ad_score.interest_group_name(), error_handler, root));
+  if (kanon_auction_result_data != nullptr &&
+      kanon_auction_result_data->kanon_ghost_winners != nullptr) {
+    PS_RETURN_IF_ERROR(CborSerializeKAnonGhostWinners(
+        kKAnonGhostWinners, *kanon_auction_result_data->kanon_ghost_winners,
+        error_handler, root));
+  }
+  PS_RETURN_IF_ERROR(CborSerializeString(kInterestGroupOwner,
+                                         ad_score.interest_group_owner(),
+                                         error_handler, root));
+  if (kanon_auction_result_data != nullptr &&
+      kanon_auction_result_data->kanon_winner_join_candidates != nullptr) {
+    PS_RETURN_IF_ERROR(CborSerializekAnonJoinCandidates(
+        kKAnonWinnerJoinCandidates,
+        *kanon_auction_result_data->kanon_winner_join_candidates, error_handler,
+        root));
+    PS_RETURN_IF_ERROR(CborSerializeInt(
+        kKAnonWinnerPositionalIndex,
+        kanon_auction_result_data->kanon_winner_positional_index, error_handler,
+        root));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status CborSerializeComponentScoreAdResponse(
+    absl::string_view top_level_seller,
+    const ScoreAdsResponse::AdScore& ad_score,
+    const BiddingGroupMap& bidding_group_map,
+    const UpdateGroupMap& update_group_map,
+    const AdtechOriginDebugUrlsMap& adtech_origin_debug_urls_map,
+    absl::string_view ad_auction_result_nonce,
+    std::unique_ptr<KAnonAuctionResultData> kanon_auction_result_data,
+    ErrorHandler error_handler, cbor_item_t& root) {
+  // Logic in the rest of the system guarantees that:
+  // - buyer_bid must be > 0 for the AdWithBid to be scored
+  // - modified bid is replaced by buyer_bid if modified bid is <= 0
+  // Therefore if modified bid is 0 here,
+  // there must have been an error in B&A logic.
+  // Chrome regards modified bids of 0 as invalid and will reject them.
+  // Thus we return an error for modified bids <= 0.
+  if (ad_score.bid() <= 0.0f) {
+    return absl::Status(absl::StatusCode::kInternal,
+                        "Modified bid should never be zero, logic error");
+  }
+  PS_RETURN_IF_ERROR(
+      CborSerializeFloat(kBid, ad_score.bid(), error_handler, root));
+  if (!ad_auction_result_nonce.empty()) {
+    PS_RETURN_IF_ERROR(CborSerializeString(
+        kAdAuctionResultNonce, ad_auction_result_nonce, error_handler, root));
+  }
+  PS_RETURN_IF_ERROR(
+      CborSerializeFloat(kScore, ad_score.desirability(), error_handler, root));
+  PS_RETURN_IF_ERROR(CborSerializeBool(kChaff, false, error_handler, root));
+  if (!ad_score.ad_metadata().empty()) {
+    PS_RETURN_IF_ERROR(CborSerializeString(kAdMetadata, ad_score.ad_metadata(),
+                                           error_handler, root));
+  }
+  PS_RETURN_IF_ERROR(CborSerializeAdComponentUrls(
+      kAdComponents, ad_score.component_renders(), error_handler, root));
+  PS_RETURN_IF_ERROR(CborSerializeString(kAdRenderUrl, ad_score.render(),
+                                         error_handler, root));
+  if (!ad_score.bid_currency().empty()) {
+    PS_RETURN_IF_ERROR(CborSerializeString(
+        kBidCurrency, ad_score.bid_currency(), error_handler, root));
+  }
+  PS_RETURN_IF_ERROR(CborSerializeDebugReports(adtech_origin_debug_urls_map,
+                                               error_handler, root));
+  PS_RETURN_IF_ERROR(
+      CborSerializeUpdateGroups(update_group_map, error_handler, root));
+  PS_RETURN_IF_ERROR(
+      CborSerializeBiddingGroups(bidding_group_map, error_handler, root));
+  PS_RETURN_IF_ERROR(CborSerializeString(kTopLevelSeller, top_level_seller,
+                                         error_handler, root));
+  PS_RETURN_IF_ERROR(CborSerializeWinReportingUrls(
+      ad_score.win_reporting_urls(), error_handler, root));
+  PS_RETURN_IF_ERROR(CborSerializeString(
+      kInterestGroupName, ad_score.interest_group_name(), error_handler, root));
+  if (kanon_auction_result_data != nullptr &&
+      kanon_auction_result_data->kanon_ghost_winners != nullptr) {
+    PS_RETURN_IF_ERROR(CborSerializeKAnonGhostWinners(
+        kKAnonGhostWinners, *kanon_auction_result_data->kanon_ghost_winners,
+        error_handler, root));
+  }
+  PS_RETURN_IF_ERROR(CborSerializeString(kInterestGroupOwner,
+                                         ad_score.interest_group_owner(),
+                                         error_handler, root));
+  if (kanon_auction_result_data != nullptr &&
+      kanon_auction_result_data->kanon_winner_join_candidates != nullptr) {
+    PS_RETURN_IF_ERROR(CborSerializekAnonJoinCandidates(
+        kKAnonWinnerJoinCandidates,
+        *kanon_auction_result_data->kanon_winner_join_candidates, error_handler,
+        root));
+    PS_RETURN_IF_ERROR(CborSerializeInt(
+        kKAnonWinnerPositionalIndex,
+        kanon_auction_result_data->kanon_winner_positional_index, error_handler,
+        root));
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<std::string> GetCborSerializedAuctionResult(
+    ErrorHandler error_handler, cbor_item_t& cbor_data_root) {
+  // Serialize the payload to CBOR.
+  const size_t cbor_serialized_data_size =
+      cbor_serialized_size(&cbor_data_root);
+  if (!cbor_serialized_data_size) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL,
+        "Failed to serialize the AuctionResult to CBOR (data is too large!)"));
+    return absl::InternalError("");
+  }
+
+  std::string byte_string;
+  byte_string.resize(cbor_serialized_data_size);
+  if (cbor_serialize(&cbor_data_root,
+                     reinterpret_cast<unsigned char*>(byte_string.data()),
+                     cbor_serialized_data_size) == 0) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL, "Failed to serialize the AuctionResult to CBOR"));
+    return absl::InternalError("");
+  }
+  return byte_string;
+}
+
+absl::Status CborSerializeError(const AuctionResult::Error& error,
+                                ErrorHandler error_handler, cbor_item_t& root) {
+  ScopedCbor serialized_error_map(cbor_new_definite_map(kNumErrorKeys));
+  struct cbor_pair code_kv = {
+      .key = cbor_move(cbor_build_stringn(kCode, sizeof(kCode) - 1)),
+      .value = cbor_move(cbor_build_uint(error.code()))};
+  if (!cbor_map_add(*serialized_error_map, code_kv)) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL,
+        absl::StrCat("Failed to serialize error ", kCode, " to CBOR")));
+    return absl::InternalError("");
+  }
+
+  const std::string& message = error.message();
+  struct cbor_pair message_kv = {
+      .key = cbor_move(cbor_build_stringn(kMessage, sizeof(kMessage) - 1)),
+      .value = cbor_move(cbor_build_stringn(message.data(), message.size()))};
+  if (!cbor_map_add(*serialized_error_map, message_kv)) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL,
+        absl::StrCat("Failed to serialize error ", kMessage, " to CBOR")));
+    return absl::InternalError("");
+  }
+
+  struct cbor_pair kv = {
+      .key = cbor_move(cbor_build_stringn(kError, sizeof(kError) - 1)),
+      .value = *serialized_error_map};
+  if (!cbor_map_add(&root, kv)) {
+    error_handler(
+        grpc::Status(grpc::INTERNAL,
+                     absl::StrCat("Failed to serialize ", kError, " to CBOR")));
+    return absl::InternalError("");
+  }
+
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::Status CborSerializeDebugReports(
+    const AdtechOriginDebugUrlsMap& adtech_origin_debug_urls_map,
+    ErrorHandler error_handler, cbor_item_t& root) {
+  if (adtech_origin_debug_urls_map.empty()) {
+    return absl::OkStatus();
+  }
+  ScopedCbor serialized_debug_reports(
+      cbor_new_definite_array(adtech_origin_debug_urls_map.size()));
+  std::set<absl::string_view, decltype(kComparator)> ordered_origins(
+      kComparator);
+  for (const auto& [origin, unused] : adtech_origin_debug_urls_map) {
+    ordered_origins.insert(origin);
+  }
+
+  for (absl::string_view origin : ordered_origins) {
+    const DebugReports& debug_reports = adtech_origin_debug_urls_map.at(origin);
+
+    ScopedCbor debug_reports_per_origin(
+        cbor_new_definite_map(kNumDebugReportsKeys));
+    ScopedCbor reports_array(
+        cbor_new_definite_array(debug_reports.reports_size()));
+    for (const DebugReports::DebugReport& report : debug_reports.reports()) {
+      ScopedCbor report_map(cbor_new_definite_map(kNumDebugReportKeys));
+      PS_RETURN_IF_ERROR(
+          CborSerializeString(kUrl, report.url(), error_handler, **report_map));
+      PS_RETURN_IF_ERROR(CborSerializeBool(kIsWinReport, report.is_win_report(),
+                                           error_handler, **report_map));
+      PS_RETURN_IF_ERROR(CborSerializeBool(kComponentWin,
+                                           report.is_component_win(),
+                                           error_handler, **report_map));
+      PS_RETURN_IF_ERROR(CborSerializeBool(kIsSellerReport,
+                                           report.is_seller_report(),
+                                           error_handler, **report_map));
+      if (!cbor_array_push(*reports_array, *report_map)) {
+        error_handler(grpc::Status(grpc::INTERNAL,
+                                   absl::StrCat("Failed to add debug report "
+                                                "entry to array for origin: ",
+                                                origin)));
+        return absl::InternalError("");
+      }
+    }
+    struct cbor_pair reports_kv = {
+        .key = cbor_move(cbor_build_stringn(kReports, sizeof(kReports) - 1)),
+        .value = *reports_array};
+    if (!cbor_map_add(*debug_reports_per_origin, reports_kv)) {
+      error_handler(grpc::Status(
+          grpc::INTERNAL, absl::StrCat("Failed to add ", kReports, " to map")));
+      return absl::InternalError("");
+    }
+    PS_RETURN_IF_ERROR(CborSerializeString(kAdTechOrigin, origin, error_handler,
+                                           **debug_reports_per_origin));
+
+    if (!cbor_array_push(*serialized_debug_reports,
+                         *debug_reports_per_origin)) {
+      error_handler(grpc::Status(
+          grpc::INTERNAL,
+          absl::StrCat("Failed to add debug reports per origin to array")));
+      return absl::InternalError("");
+    }
+  }
+
+  struct cbor_pair debug_reports_kv = {
+      .key = cbor_move(
+          cbor_build_stringn(kDebugReports, sizeof(kDebugReports) - 1)),
+      .value = *serialized_debug_reports};
+  if (!cbor_map_add(&root, debug_reports_kv)) {
+    error_handler(
+        grpc::Status(grpc::INTERNAL,
+                     absl::StrCat("Failed to add ", kDebugReports, " to map")));
+    return absl::InternalError("");
+  }
+  return absl::OkStatus();
+}
+
+absl::Status CborSerializeUpdateGroups(const UpdateGroupMap& update_groups,
+                                       ErrorHandler error_handler,
+                                       cbor_item_t& root) {
+  ScopedCbor serialized_group_map(cbor_new_definite_map(update_groups.size()));
+  std::set<absl::string_view, decltype(kComparator)> ordered_origins(
+      kComparator);
+  // NOLINTNEXTLINE
+  for (const auto& [origin, unused] : update_groups) {
+    ordered_origins.insert(origin);
+  }
+  for (absl::string_view origin : ordered_origins) {
+    const UpdateInterestGroupList& updates = update_groups.at(origin);
+
+    ScopedCbor update_group_array(
+        cbor_new_definite_array(updates.interest_groups().size()));
+    for (const UpdateInterestGroup& update : updates.interest_groups()) {
+      ScopedCbor serialized_update_map(cbor_new_definite_map(2));
+      PS_RETURN_IF_ERROR(CborSerializeInt(kIndex, update.index(), error_handler,
+                                          **serialized_update_map));
+      PS_RETURN_IF_ERROR(CborSerializeInt(
+          kUpdateIfOlderThanMs, update.update_if_older_than_ms(), error_handler,
+          **serialized_update_map));
+      if (!cbor_array_push(*update_group_array, *serialized_update_map)) {
+        error_handler(grpc::Status(
+            grpc::INTERNAL, absl::StrCat("Failed to add interest group update "
+                                         "entry to array for owner: ",
+                                         origin)));
+        return absl::InternalError("");
+      }
+    }
+
+    struct cbor_pair owner_update_groups_entry = {
+        .key = cbor_move(cbor_build_stringn(origin.data(), origin.size())),
+        .value = *update_group_array};
+
+    if (!cbor_map_add(*serialized_group_map, owner_update_groups_entry)) {
+      error_handler(grpc::Status(
+          grpc::INTERNAL,
+          "Failed to serialize an <origin, update group array> pair to CBOR"));
+      return absl::InternalError("");
+    }
+  }
+
+  struct cbor_pair kv = {.key = cbor_move(cbor_build_stringn(
+                             kUpdateGroups, sizeof(kUpdateGroups) - 1)),
+                         .value = *serialized_group_map};
+  if (!cbor_map_add(&root, kv)) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL,
+        absl::StrCat("Failed to serialize ", kUpdateGroups, " to CBOR")));
+    return absl::InternalError("");
+  }
+  return absl::OkStatus();
+}
+
+absl::Status CborSerializeBiddingGroups(const BiddingGroupMap& bidding_groups,
+                                        ErrorHandler error_handler,
+                                        cbor_item_t& root) {
+  ScopedCbor serialized_group_map(cbor_new_definite_map(bidding_groups.size()));
+  // Order keys by length first and then lexicographically.
+  std::set<absl::string_view, decltype(kComparator)> ordered_origins(
+      kComparator);
+  // NOLINTNEXTLINE
+  for (const auto& [origin, unused] : bidding_groups) {
+    ordered_origins.insert(origin);
+  }
+  for (const auto& origin : ordered_origins) {
+    const auto& group_indices = bidding_groups.at(origin);
+    ScopedCbor serialized_group_indices(
+        cbor_new_definite_array(group_indices.index_size()));
+    for (int32_t index : group_indices.index()) {
+      if (!cbor_array_push(*serialized_group_indices,
+                           cbor_move(cbor_build_uint(index)))) {
+        error_handler(
+            grpc::Status(grpc::INTERNAL,
+                         "Failed to serialize a bidding group index to CBOR"));
+        return absl::InternalError("");
+      }
+    }
+    struct cbor_pair kv = {
+        .key = cbor_move(cbor_build_stringn(origin.data(), origin.size())),
+        .value = *serialized_group_indices};
+    if (!cbor_map_add(*serialized_group_map, kv)) {
+      error_handler(grpc::Status(
+          grpc::INTERNAL,
+          "Failed to serialize an <origin, bidding group array> pair to CBOR"));
+      return absl::InternalError("");
+    }
+  }
+  struct cbor_pair kv = {.key = cbor_move(cbor_build_stringn(
+                             kBiddingGroups, sizeof(kBiddingGroups) - 1)),
+                         .value = *serialized_group_map};
+  if (!cbor_map_add(&root, kv)) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL,
+        absl::StrCat("Failed to serialize ", kBiddingGroups, " to CBOR")));
+    return absl::InternalError("");
+  }
+  return absl::OkStatus();
+}
+
+absl::Status CborSerializeWinReportingUrls(
+    const WinReportingUrls& win_reporting_urls, ErrorHandler error_handler,
+    cbor_item_t& root) {
+  if (!win_reporting_urls.has_buyer_reporting_urls() &&
+      !win_reporting_urls.has_top_level_seller_reporting_urls()) {
+    return absl::OkStatus();
+  }
+  ScopedCbor serialized_win_reporting_urls(
+      cbor_new_definite_map(kNumWinReportingUrlsKeys));
+  if (win_reporting_urls.has_buyer_reporting_urls()) {
+    PS_RETURN_IF_ERROR(CborSerializeReportingUrls(
+        kBuyerReportingUrls, win_reporting_urls.buyer_reporting_urls(),
+        error_handler, **serialized_win_reporting_urls));
+  }
+  if (win_reporting_urls.has_top_level_seller_reporting_urls()) {
+    PS_RETURN_IF_ERROR(CborSerializeReportingUrls(
+        kTopLevelSellerReportingUrls,
+        win_reporting_urls.top_level_seller_reporting_urls(), error_handler,
+        **serialized_win_reporting_urls));
+  }
+  if (win_reporting_urls.has_component_seller_reporting_urls()) {
+    PS_RETURN_IF_ERROR(CborSerializeReportingUrls(
+        kComponentSellerReportingUrls,
+        win_reporting_urls.component_seller_reporting_urls(), error_handler,
+        **serialized_win_reporting_urls));
+  }
+  struct cbor_pair serialized_win_reporting_urls_kv = {
+      .key = cbor_move(
+          cbor_build_stringn(kWinReportingUrls, sizeof(kWinReportingUrls) - 1)),
+      .value = *serialized_win_reporting_urls,
+  };
+  if (!cbor_map_add(&root, serialized_win_reporting_urls_kv)) {
+    error_handler(grpc::Status(
+        grpc::INTERNAL,
+        absl::StrCat("Failed to serialize ", kWinReportingUrls, " to CBOR")));
+    return absl::InternalError("");
+  }
+
+  return absl::OkStatus();
+}
+
+absl::StatusOr<std::string> CborTreeEncode(
+    const std::optional<ScoreAdsResponse::AdScore>& high_score,
+    const BiddingGroupMap& bidding_group_map,
+    const UpdateGroupMap& update_group_map,
+    const AdtechOriginDebugUrlsMap& adtech_origin_debug_urls_map,
+    const std::optional<AuctionResult::Error>& error,
+    ErrorHandler error_handler, int per_adtech_paapi_contributions_limit,
+    absl::string_view ad_auction_result_nonce,
+    std::unique_ptr<KAnonAuctionResultData> kanon_auction_result_data) {
+  // CBOR data's root handle. When serializing the auction result to CBOR, we
+  // use this handle to keep the temporary data.
+  ScopedCbor cbor_data_root(cbor_new_definite_map(kNumAuctionResultKeys));
+  auto* cbor_internal = cbor_data_root.get();
+
+  if (error) {
+    PS_RETURN_IF_ERROR(
+        CborSerializeError(*error, error_handler, *cbor_internal));
+    if (!ad_auction_result_nonce.empty()) {
+      // "nonce" must be added after "error".
+      PS_RETURN_IF_ERROR(CborSerializeString(kAdAuctionResultNonce,
+                                             ad_auction_result_nonce,
+                                             error_handler, *cbor_internal));
+    }
+  } else if (high_score) {
+    PS_RETURN_IF_ERROR(CborSerializeScoreAdResponse(
+        *high_score, bidding_group_map, update_group_map,
+        adtech_origin_debug_urls_map, per_adtech_paapi_contributions_limit,
+        ad_auction_result_nonce, std::move(kanon_auction_result_data),
+        error_handler, *cbor_internal));
+  } else if (kanon_auction_result_data != nullptr &&
+             kanon_auction_result_data->kanon_ghost_winners != nullptr) {
+    // "nonce" must be added before "kAnonGhostWinners".
+    if (!ad_auction_result_nonce.empty()) {
+      PS_RETURN_IF_ERROR(CborSerializeString(kAdAuctionResultNonce,
+                                             ad_auction_result_nonce,
+                                             error_handler, *cbor_internal));
+    }
+    PS_RETURN_IF_ERROR(CborSerializeKAnonGhostWinners(
+        kKAnonGhostWinners, *kanon_auction_result_data->kanon_ghost_winners,
+        error_handler, *cbor_internal));
+  } else {
+    if (!ad_auction_result_nonce.empty()) {
+      PS_RETURN_IF_ERROR(CborSerializeString(kAdAuctionResultNonce,
+                                             ad_auction_result_nonce,
+                                             error_handler, *cbor_internal));
+    }
+    PS_RETURN_IF_ERROR(
+        CborSerializeBool(kChaff, true, error_handler, *cbor_internal));
+  }
+
+  return GetCborSerializedAuctionResult(error_handler, *cbor_internal);
+}
+
+absl::StatusOr<std::string> CborTreeEncodeComponent(
+    absl::string_view top_level_seller,
+    const std::optional<ScoreAdsResponse::AdScore>& high_score,
+    const BiddingGroupMap& bidding_group_map,
+    const UpdateGroupMap& update_group_map,
+    const AdtechOriginDebugUrlsMap& adtech_origin_debug_urls_map,
+    const std::optional<AuctionResult::Error>& error,
+    ErrorHandler error_handler, absl::string_view ad_auction_result_nonce,
+    std::unique_ptr<KAnonAuctionResultData> kanon_auction_result_data) {
+  // CBOR data's root handle. When serializing the auction result to CBOR, we
+  // use this handle to keep the temporary data.
+  ScopedCbor cbor_data_root(cbor_new_definite_map(kNumAuctionResultKeys));
+  auto* cbor_internal = cbor_data_root.get();
+
+  if (error) {
+    PS_RETURN_IF_ERROR(
+        CborSerializeError(*error, error_handler, *cbor_internal));
+    // "nonce" added after "error".
+    if (!ad_auction_result_nonce.empty()) {
+      PS_RETURN_IF_ERROR(CborSerializeString(kAdAuctionResultNonce,
+                                             ad_auction_result_nonce,
+                                             error_handler, *cbor_internal));
+    }
+  } else if (high_score) {
+    PS_RETURN_IF_ERROR(CborSerializeComponentScoreAdResponse(
+        top_level_seller, *high_score, bidding_group_map, update_group_map,
+        adtech_origin_debug_urls_map, ad_auction_result_nonce,
+        std::move(kanon_auction_result_data), error_handler, *cbor_internal));
+  } else if (kanon_auction_result_data != nullptr &&
+             kanon_auction_result_data->kanon_ghost_winners != nullptr) {
+    // "nonce" must be added before "kAnonGhostWinners".
+    if (!ad_auction_result_nonce.empty()) {
+      PS_RETURN_IF_ERROR(CborSerializeString(kAdAuctionResultNonce,
+                                             ad_auction_result_nonce,
+                                             error_handler, *cbor_internal));
+    }
+    PS_RETURN_IF_ERROR(CborSerializeKAnonGhostWinners(
+        kKAnonGhostWinners, *kanon_auction_result_data->kanon_ghost_winners,
+        error_handler, *cbor_internal));
+  } else {
+    // "nonce" must be added before "isChaff".
+    if (!ad_auction_result_nonce.empty()) {
+      PS_RETURN_IF_ERROR(CborSerializeString(kAdAuctionResultNonce,
+                                             ad_auction_result_nonce,
+                                             error_handler, *cbor_internal));
+    }
+    PS_RETURN_IF_ERROR(
+        CborSerializeBool(kChaff, true, error_handler, *cbor_internal));
+  }
+
+  return GetCborSerializedAuctionResult(error_handler, *cbor_internal);
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
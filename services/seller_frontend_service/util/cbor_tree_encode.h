@@ -0,0 +1,97 @@
+// Copyright 2025 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SERVICES_SELLER_FRONTEND_SERVICE_UTIL_CBOR_TREE_ENCODE_H_
+#define SERVICES_SELLER_FRONTEND_SERVICE_UTIL_CBOR_TREE_ENCODE_H_
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "api/bidding_auction_servers.pb.h"
+#include "services/common/util/request_response_constants.h"
+#include "services/seller_frontend_service/data/k_anon.h"
+#include "services/seller_frontend_service/util/cbor_common_util.h"
+
+#include "cbor.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+// The original encoder of AuctionResults, which builds a libcbor item tree
+// before serializing it. The servers encode AuctionResults with the
+// `CborWriter` based functions in web_utils.h instead; this one is kept only
+// to check their output against in tests and benchmarks.
+
+// Same as `Encode` but builds the AuctionResult as a libcbor item tree before
+// serializing it.
+absl::StatusOr<std::string> CborTreeEncode(
+    const std::optional<ScoreAdsResponse::AdScore>& high_score,
+    const ::google::protobuf::Map<
+        std::string, AuctionResult::InterestGroupIndex>& bidding_group_map,
+    const UpdateGroupMap& update_group_map,
+    const AdtechOriginDebugUrlsMap& adtech_origin_debug_urls_map,
+    const std::optional<AuctionResult::Error>& error,
+    const std::function<void(const grpc::Status&)>& error_handler,
+    int per_adtech_paapi_contributions_limit = 0,
+    absl::string_view ad_auction_result_nonce = "",
+    std::unique_ptr<KAnonAuctionResultData> kanon_auction_result_data =
+        nullptr);
+
+// Same as `EncodeComponent` but builds the AuctionResult as a libcbor item
+// tree before serializing it.
+absl::StatusOr<std::string> CborTreeEncodeComponent(
+    absl::string_view top_level_seller,
+    const std::optional<ScoreAdsResponse::AdScore>& high_score,
+    const ::google::protobuf::Map<
+        std::string, AuctionResult::InterestGroupIndex>& bidding_group_map,
+    const UpdateGroupMap& update_group_map,
+    const AdtechOriginDebugUrlsMap& adtech_origin_debug_urls_map,
+    const std::optional<AuctionResult::Error>& error,
+    const std::function<void(const grpc::Status&)>& error_handler,
+    absl::string_view ad_auction_result_nonce = "",
+    std::unique_ptr<KAnonAuctionResultData> kanon_auction_result_data =
+        nullptr);
+
+// Serializes the adtech origin => debug reports map into `root`.
+absl::Status CborSerializeDebugReports(
+    const AdtechOriginDebugUrlsMap& adtech_origin_debug_urls_map,
+    ErrorHandler error_handler, cbor_item_t& root);
+
+// Serializes the bidding groups (buyer origin => interest group indices map)
+// into `root`.
+absl::Status CborSerializeBiddingGroups(
+    const google::protobuf::Map<std::string, AuctionResult::InterestGroupIndex>&
+        bidding_groups,
+    const std::function<void(const grpc::Status&)>& error_handler,
+    cbor_item_t& root);
+
+// Serializes the interest groups to update into `root`.
+absl::Status CborSerializeUpdateGroups(
+    const UpdateGroupMap& update_groups,
+    const std::function<void(const grpc::Status&)>& error_handler,
+    cbor_item_t& root);
+
+// Serializes WinReportingUrls for buyer and seller into `root`.
+absl::Status CborSerializeWinReportingUrls(
+    const WinReportingUrls& win_reporting_urls,
+    const std::function<void(const grpc::Status&)>& error_handler,
+    cbor_item_t& root);
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_SELLER_FRONTEND_SERVICE_UTIL_CBOR_TREE_ENCODE_H_
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "services/common/chaffing/moving_median_interface.h"
 #include "services/common/chaffing/moving_median_manager.h"
 #include "services/common/clients/async_grpc/request_config.h"
 #include "services/common/loggers/request_log_context.h"
@@ -38,6 +39,11 @@ inline constexpr int kMaxChaffRequestSizeBytes = 95'000;
 inline constexpr size_t kChaffingV2MovingMedianWindowSize = 10'000;
 inline constexpr int kChaffingV2UnfilledWindowRequestSizeBytes = 100'000;
 inline constexpr float kChaffingV2SamplingProbablility = 0.1;
+// Supported values of the CHAFFING_V2_MOVING_MEDIAN_TYPE runtime flag.
+inline constexpr absl::string_view kChaffingV2MovingMedianTypeMultiset =
+    "MULTISET";
+inline constexpr absl::string_view kChaffingV2MovingMedianTypeTwoHeap =
+    "TWO_HEAP";
 // Constants used to create normal distribution, which is used for calculating
 // the number of chaff requests for Chaffing V2.gs
 inline constexpr float kChaffingV2GaussianMeanDivisor = 6;
@@ -52,8 +58,8 @@ struct InvokedBuyers {
 };
 
 struct ChaffMedianTrackers {
-  std::unique_ptr<MovingMedian> request_duration;
-  std::unique_ptr<MovingMedian> response_size;
+  std::unique_ptr<MovingMedianInterface> request_duration;
+  std::unique_ptr<MovingMedianInterface> response_size;
 };
 
 RequestConfig GetChaffingV1GetBidsRequestConfig(
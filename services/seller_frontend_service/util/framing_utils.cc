@@ -14,9 +14,15 @@
 #include "services/seller_frontend_service/util/framing_utils.h"
 
 #include <algorithm>
+#include <string>
 
+#include "absl/log/check.h"
 #include "absl/numeric/bits.h"
+#include "quiche/common/quiche_data_writer.h"
+#include "services/common/compression/gzip.h"
 #include "services/common/util/request_response_constants.h"
+#include "src/communication/encoding_utils.h"
+#include "src/util/status_macro/status_macros.h"
 
 namespace privacy_sandbox::bidding_auction_servers {
 
@@ -26,6 +32,24 @@ constexpr int kVersionCompressionSize = 1;
 // 4-bytes specifying the size of the actual payload.
 constexpr int kPayloadLength = 4;
 
+constexpr int kPreambleSize = kVersionCompressionSize + kPayloadLength;
+
+namespace {
+
+// Returns the version + compression byte that the common library frames gzip
+// compressed payloads with, so that both encoders stay in sync.
+uint8_t GetGzipVersionCompressionByte() {
+  static const uint8_t version_compression_byte = [] {
+    absl::StatusOr<std::string> preamble = server_common::EncodeResponsePayload(
+        server_common::CompressionType::kGzip, "", kPreambleSize);
+    CHECK(preamble.ok()) << preamble.status();
+    return static_cast<uint8_t>(preamble->front());
+  }();
+  return version_compression_byte;
+}
+
+}  // namespace
+
 // Gets size of the complete payload including the preamble expected by
 // android, which is: 1 byte (containing version, compression details), 4 bytes
 // indicating the length of the actual encoded response and any other padding
@@ -37,4 +61,23 @@ size_t GetEncodedDataSize(size_t encapsulated_payload_size) {
   return std::max(absl::bit_ceil(total_payload_size), kMinAuctionResultBytes);
 }
 
+absl::StatusOr<std::string> GzipCompressAndEncodeResponsePayload(
+    absl::string_view payload) {
+  std::string encoded_payload;
+  encoded_payload.reserve(
+      GetEncodedDataSize(GzipCompressBound(payload.size())));
+  PS_ASSIGN_OR_RETURN(
+      size_t compressed_size,
+      GzipCompressInto(payload, kPreambleSize, encoded_payload));
+
+  quiche::QuicheDataWriter writer(kPreambleSize, encoded_payload.data());
+  if (!writer.WriteUInt8(GetGzipVersionCompressionByte()) ||
+      !writer.WriteUInt32(compressed_size)) {
+    return absl::InternalError("Failed to write the payload preamble");
+  }
+  // Pads the payload with zeros.
+  encoded_payload.resize(GetEncodedDataSize(compressed_size));
+  return encoded_payload;
+}
+
 }  // namespace privacy_sandbox::bidding_auction_servers
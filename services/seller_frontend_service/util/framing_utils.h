@@ -19,6 +19,11 @@
 
 #include <stddef.h>
 
+#include <string>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
 namespace privacy_sandbox::bidding_auction_servers {
 
 // Gets size of the complete payload including the preamble expected by
@@ -27,6 +32,13 @@ namespace privacy_sandbox::bidding_auction_servers {
 // required to make the complete payload a power of 2.
 size_t GetEncodedDataSize(size_t encapsulated_payload_size);
 
+// Gzip compresses `payload`, then frames and pads it like
+// server_common::EncodeResponsePayload does. The output is allocated once for
+// the largest possible padded size and the payload is compressed directly
+// behind the preamble, so that the compressed data is not copied again.
+absl::StatusOr<std::string> GzipCompressAndEncodeResponsePayload(
+    absl::string_view payload);
+
 }  // namespace privacy_sandbox::bidding_auction_servers
 
 #endif  // SERVICES_SELLER_FRONTEND_SERVICE_UTIL_FRAMING_UTILS_H_
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "services/seller_frontend_service/util/framing_utils.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "services/common/compression/gzip.h"
+#include "services/common/util/request_response_constants.h"
+#include "src/communication/encoding_utils.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+std::string GeneratePayload(int size) {
+  std::string payload;
+  payload.reserve(size);
+  for (int i = 0; i < size; ++i) {
+    payload.push_back(static_cast<char>('a' + (i * i) % 26));
+  }
+  return payload;
+}
+
+TEST(GetEncodedDataSizeTest, PadsToPowerOfTwo) {
+  EXPECT_EQ(GetEncodedDataSize(0), kMinAuctionResultBytes);
+  EXPECT_EQ(GetEncodedDataSize(1019), 1024);
+  EXPECT_EQ(GetEncodedDataSize(1020), 2048);
+}
+
+TEST(GzipCompressAndEncodeResponsePayloadTest, MatchesCommonLibraryEncoding) {
+  for (int size : {0, 100, 10'000, 300'000}) {
+    const std::string payload = GeneratePayload(size);
+    absl::StatusOr<std::string> compressed = GzipCompress(payload);
+    ASSERT_TRUE(compressed.ok()) << compressed.status();
+    absl::StatusOr<std::string> expected = server_common::EncodeResponsePayload(
+        server_common::CompressionType::kGzip, *compressed,
+        GetEncodedDataSize(compressed->size()));
+    ASSERT_TRUE(expected.ok()) << expected.status();
+
+    absl::StatusOr<std::string> encoded =
+        GzipCompressAndEncodeResponsePayload(payload);
+    ASSERT_TRUE(encoded.ok()) << encoded.status();
+    EXPECT_EQ(*encoded, *expected) << "Payload size: " << size;
+  }
+}
+
+TEST(GzipCompressAndEncodeResponsePayloadTest, CanBeDecoded) {
+  const std::string payload = GeneratePayload(5'000);
+  absl::StatusOr<std::string> encoded =
+      GzipCompressAndEncodeResponsePayload(payload);
+  ASSERT_TRUE(encoded.ok()) << encoded.status();
+
+  absl::StatusOr<server_common::DecodedRequest> decoded =
+      server_common::DecodeRequestPayload(*encoded);
+  ASSERT_TRUE(decoded.ok()) << decoded.status();
+  absl::StatusOr<std::string> decompressed =
+      GzipDecompress(decoded->compressed_data);
+  ASSERT_TRUE(decompressed.ok()) << decompressed.status();
+  EXPECT_EQ(*decompressed, payload);
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
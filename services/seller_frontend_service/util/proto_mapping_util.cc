@@ -107,16 +107,10 @@ AuctionResult MapAdScoreToAuctionResult(
 absl::StatusOr<std::string> PackageAuctionResultCiphertext(
     absl::string_view serialized_auction_result,
     OhttpHpkeDecryptedMessage& decrypted_request) {
-  // Gzip compress.
-  PS_ASSIGN_OR_RETURN(std::string compressed_data,
-                      GzipCompress(serialized_auction_result));
-
-  // Frame(set bits) and pad.
+  // Gzip compress, frame(set bits) and pad.
   PS_ASSIGN_OR_RETURN(
       std::string encoded_plaintext,
-      server_common::EncodeResponsePayload(
-          server_common::CompressionType::kGzip, compressed_data,
-          GetEncodedDataSize(compressed_data.size())));
+      GzipCompressAndEncodeResponsePayload(serialized_auction_result));
 
   // Encapsulate and encrypt with corresponding private key.
   return server_common::EncryptAndEncapsulateResponse(
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "services/seller_frontend_service/util/scoring_signals_accumulator.h"
+
+#include <string>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
+#include "rapidjson/document.h"
+#include "services/common/util/json_util.h"
+#include "src/util/status_macro/status_macros.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+std::string ToString(const rapidjson::Value& value) {
+  return std::string(value.GetString(), value.GetStringLength());
+}
+
+}  // namespace
+
+absl::StatusOr<std::unique_ptr<ScoringSignals>> MergeScoringSignals(
+    std::vector<std::unique_ptr<ScoringSignals>> partial_signals) {
+  // Drop the fetches that came back without any signals.
+  std::vector<std::unique_ptr<ScoringSignals>> non_empty_signals;
+  non_empty_signals.reserve(partial_signals.size());
+  bool same_data_version = true;
+  for (auto& signals : partial_signals) {
+    if (signals == nullptr || signals->scoring_signals == nullptr ||
+        signals->scoring_signals->empty()) {
+      continue;
+    }
+    if (!non_empty_signals.empty() &&
+        non_empty_signals.front()->data_version != signals->data_version) {
+      same_data_version = false;
+    }
+    non_empty_signals.push_back(std::move(signals));
+  }
+  if (non_empty_signals.empty()) {
+    auto merged = std::make_unique<ScoringSignals>();
+    merged->scoring_signals = std::make_unique<std::string>();
+    merged->data_version = 0;
+    return merged;
+  }
+  if (non_empty_signals.size() == 1) {
+    return std::move(non_empty_signals.front());
+  }
+
+  // The members of the partial documents are moved into the first document,
+  // so all the documents have to outlive the serialization below.
+  std::vector<rapidjson::Document> documents;
+  documents.reserve(non_empty_signals.size());
+  size_t merged_size = 0;
+  for (const auto& signals : non_empty_signals) {
+    PS_ASSIGN_OR_RETURN(rapidjson::Document document,
+                        ParseJsonString(*signals->scoring_signals));
+    if (!document.IsObject()) {
+      return absl::InvalidArgumentError(
+          "Scoring signals did not parse to a JSON object");
+    }
+    merged_size += signals->scoring_signals->size();
+    documents.push_back(std::move(document));
+  }
+
+  rapidjson::Document& merged_document = documents.front();
+  auto& allocator = merged_document.GetAllocator();
+  // Keys already present in each namespace of the merged document, built
+  // lazily the first time a namespace receives keys from another document.
+  // The keys are copied since rapidjson stores short strings inline, so their
+  // addresses change whenever a namespace grows.
+  absl::flat_hash_map<std::string, absl::flat_hash_set<std::string>>
+      namespace_keys;
+  for (size_t i = 1; i < documents.size(); ++i) {
+    for (auto& partial_namespace : documents[i].GetObject()) {
+      auto merged_namespace =
+          merged_document.FindMember(partial_namespace.name);
+      if (merged_namespace == merged_document.MemberEnd()) {
+        merged_document.AddMember(partial_namespace.name,
+                                  partial_namespace.value, allocator);
+        continue;
+      }
+      if (!merged_namespace->value.IsObject() ||
+          !partial_namespace.value.IsObject()) {
+        // Not a namespace of keys; keep the first value.
+        continue;
+      }
+      auto [keys_it, inserted] =
+          namespace_keys.try_emplace(ToString(merged_namespace->name));
+      absl::flat_hash_set<std::string>& keys = keys_it->second;
+      if (inserted) {
+        for (const auto& key : merged_namespace->value.GetObject()) {
+          keys.insert(ToString(key.name));
+        }
+      }
+      for (auto& key : partial_namespace.value.GetObject()) {
+        if (keys.insert(ToString(key.name)).second) {
+          merged_namespace->value.AddMember(key.name, key.value, allocator);
+        }
+      }
+    }
+  }
+
+  auto merged = std::make_unique<ScoringSignals>();
+  PS_ASSIGN_OR_RETURN(
+      std::string merged_json,
+      SerializeJsonDocToReservedString(merged_document, merged_size));
+  merged->scoring_signals =
+      std::make_unique<std::string>(std::move(merged_json));
+  merged->data_version =
+      same_data_version ? non_empty_signals.front()->data_version : 0;
+  return merged;
+}
+
+void ScoringSignalsAccumulator::AddPendingFetch() {
+  absl::MutexLock lock(&mu_);
+  ++pending_fetches_;
+}
+
+void ScoringSignalsAccumulator::OnFetchDone(
+    absl::StatusOr<std::unique_ptr<ScoringSignals>> result) {
+  absl::AnyInvocable<void() &&> completion;
+  {
+    absl::MutexLock lock(&mu_);
+    DCHECK_GT(pending_fetches_, 0)
+        << "OnFetchDone() called without a matching AddPendingFetch()";
+    --pending_fetches_;
+    if (!result.ok()) {
+      if (status_.ok()) {
+        status_ = std::move(result).status();
+      }
+    } else {
+      partial_signals_.push_back(*std::move(result));
+    }
+    completion = TakeCompletion();
+  }
+  if (completion) {
+    std::move(completion)();
+  }
+}
+
+void ScoringSignalsAccumulator::OnAllFetchesStarted(
+    MergedScoringSignalsCallback on_done) {
+  absl::AnyInvocable<void() &&> completion;
+  {
+    absl::MutexLock lock(&mu_);
+    DCHECK(on_done_ == nullptr) << "OnAllFetchesStarted() called twice";
+    on_done_ = std::move(on_done);
+    completion = TakeCompletion();
+  }
+  if (completion) {
+    std::move(completion)();
+  }
+}
+
+absl::AnyInvocable<void() &&> ScoringSignalsAccumulator::TakeCompletion() {
+  if (pending_fetches_ > 0 || on_done_ == nullptr) {
+    return nullptr;
+  }
+  MergedScoringSignalsCallback on_done = std::move(on_done_);
+  on_done_ = nullptr;
+  if (!status_.ok()) {
+    return [on_done = std::move(on_done), status = status_]() mutable {
+      std::move(on_done)(status);
+    };
+  }
+  return [on_done = std::move(on_done),
+          partial_signals = std::move(partial_signals_)]() mutable {
+    std::move(on_done)(MergeScoringSignals(std::move(partial_signals)));
+  };
+}
+
+}  // namespace privacy_sandbox::bidding_auction_servers
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERVICES_SELLER_FRONTEND_SERVICE_UTIL_SCORING_SIGNALS_ACCUMULATOR_H_
+#define SERVICES_SELLER_FRONTEND_SERVICE_UTIL_SCORING_SIGNALS_ACCUMULATOR_H_
+
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "services/seller_frontend_service/data/scoring_signals.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+
+using MergedScoringSignalsCallback = absl::AnyInvocable<void(
+    absl::StatusOr<std::unique_ptr<ScoringSignals>>) &&>;
+
+// Merges the scoring signals fetched for disjoint sets of bids into a single
+// set of scoring signals. Each partial result is expected to be a JSON object
+// keyed by namespace (e.g. "renderUrls" and "adComponentRenderUrls"), and the
+// keys of the namespaces present in several partial results are unioned (the
+// first value wins for duplicate keys). The data version is kept only if all
+// the partial results agree on it.
+absl::StatusOr<std::unique_ptr<ScoringSignals>> MergeScoringSignals(
+    std::vector<std::unique_ptr<ScoringSignals>> partial_signals);
+
+// Collects the scoring signals of fetches that are started independently of
+// each other (e.g. one per buyer, as soon as the buyer's bids arrive) and
+// hands the merged signals over once the last fetch has completed.
+//
+// Usage: call AddPendingFetch() before starting each fetch and OnFetchDone()
+// with its result. Once no more fetches are going to be started, call
+// OnAllFetchesStarted() exactly once; its callback runs as soon as every
+// pending fetch has completed (possibly right away, on the calling thread).
+//
+// If any fetch fails, the callback receives the status of the first failure.
+//
+// This class is thread-safe.
+class ScoringSignalsAccumulator {
+ public:
+  ScoringSignalsAccumulator() = default;
+
+  // Not copyable or movable.
+  ScoringSignalsAccumulator(const ScoringSignalsAccumulator&) = delete;
+  ScoringSignalsAccumulator& operator=(const ScoringSignalsAccumulator&) =
+      delete;
+
+  void AddPendingFetch() ABSL_LOCKS_EXCLUDED(mu_);
+
+  void OnFetchDone(absl::StatusOr<std::unique_ptr<ScoringSignals>> result)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+  void OnAllFetchesStarted(MergedScoringSignalsCallback on_done)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+ private:
+  // Returns a closure that invokes `on_done_` with the merged signals if all
+  // the fetches are done and `on_done_` is yet to be invoked, otherwise
+  // returns nullptr. The closure is meant to be run after releasing `mu_`.
+  absl::AnyInvocable<void() &&> TakeCompletion()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  absl::Mutex mu_;
+  int pending_fetches_ ABSL_GUARDED_BY(mu_) = 0;
+  absl::Status status_ ABSL_GUARDED_BY(mu_);
+  std::vector<std::unique_ptr<ScoringSignals>> partial_signals_
+      ABSL_GUARDED_BY(mu_);
+  MergedScoringSignalsCallback on_done_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace privacy_sandbox::bidding_auction_servers
+
+#endif  // SERVICES_SELLER_FRONTEND_SERVICE_UTIL_SCORING_SIGNALS_ACCUMULATOR_H_
@@ -0,0 +1,221 @@
+//  Copyright 2025 Google LLC
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "services/seller_frontend_service/util/scoring_signals_accumulator.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+#include "services/common/util/json_util.h"
+
+namespace privacy_sandbox::bidding_auction_servers {
+namespace {
+
+std::unique_ptr<ScoringSignals> CreateSignals(absl::string_view json,
+                                              uint32_t data_version = 0) {
+  auto signals = std::make_unique<ScoringSignals>();
+  signals->scoring_signals = std::make_unique<std::string>(json);
+  signals->data_version = data_version;
+  return signals;
+}
+
+// Parses both JSON strings so that the comparison ignores member ordering
+// and whitespace.
+void ExpectJsonEq(absl::string_view actual, absl::string_view expected) {
+  auto actual_doc = ParseJsonString(actual);
+  ASSERT_TRUE(actual_doc.ok()) << actual_doc.status();
+  auto expected_doc = ParseJsonString(expected);
+  ASSERT_TRUE(expected_doc.ok()) << expected_doc.status();
+  EXPECT_TRUE(*actual_doc == *expected_doc)
+      << "actual: " << actual << "\nexpected: " << expected;
+}
+
+TEST(MergeScoringSignalsTest, ReturnsEmptySignalsForNoPartialSignals) {
+  auto merged = MergeScoringSignals({});
+  ASSERT_TRUE(merged.ok()) << merged.status();
+  EXPECT_TRUE((*merged)->scoring_signals->empty());
+}
+
+TEST(MergeScoringSignalsTest, PassesThroughSinglePartialSignals) {
+  constexpr absl::string_view kSignals = R"({"renderUrls": {"a": 1}})";
+  std::vector<std::unique_ptr<ScoringSignals>> partial_signals;
+  partial_signals.push_back(CreateSignals(kSignals, /*data_version=*/7));
+  partial_signals.push_back(CreateSignals(""));
+  auto merged = MergeScoringSignals(std::move(partial_signals));
+  ASSERT_TRUE(merged.ok()) << merged.status();
+  EXPECT_EQ(*(*merged)->scoring_signals, kSignals);
+  EXPECT_EQ((*merged)->data_version, 7);
+}
+
+TEST(MergeScoringSignalsTest, UnionsKeysOfEachNamespace) {
+  std::vector<std::unique_ptr<ScoringSignals>> partial_signals;
+  partial_signals.push_back(CreateSignals(
+      R"({"renderUrls": {"a": 1}, "adComponentRenderUrls": {"c": 3}})"));
+  partial_signals.push_back(CreateSignals(
+      R"({"renderUrls": {"b": 2}, "adComponentRenderUrls": {"d": [4]}})"));
+  partial_signals.push_back(CreateSignals(R"({"renderUrls": {"e": "5"}})"));
+  auto merged = MergeScoringSignals(std::move(partial_signals));
+  ASSERT_TRUE(merged.ok()) << merged.status();
+  ExpectJsonEq(*(*merged)->scoring_signals,
+               R"({"renderUrls": {"a": 1, "b": 2, "e": "5"},
+                   "adComponentRenderUrls": {"c": 3, "d": [4]}})");
+}
+
+TEST(MergeScoringSignalsTest, AddsNamespacesMissingFromFirstSignals) {
+  std::vector<std::unique_ptr<ScoringSignals>> partial_signals;
+  partial_signals.push_back(CreateSignals(R"({"renderUrls": {"a": 1}})"));
+  partial_signals.push_back(
+      CreateSignals(R"({"adComponentRenderUrls": {"c": 3}})"));
+  auto merged = MergeScoringSignals(std::move(partial_signals));
+  ASSERT_TRUE(merged.ok()) << merged.status();
+  ExpectJsonEq(*(*merged)->scoring_signals,
+               R"({"renderUrls": {"a": 1},
+                   "adComponentRenderUrls": {"c": 3}})");
+}
+
+TEST(MergeScoringSignalsTest, KeepsFirstValueOfDuplicateKeys) {
+  std::vector<std::unique_ptr<ScoringSignals>> partial_signals;
+  // Long keys make sure that the deduplication doesn't depend on where
+  // rapidjson stores the key strings.
+  const std::string long_key(64, 'k');
+  for (int i = 0; i < 3; ++i) {
+    partial_signals.push_back(CreateSignals(absl::StrCat(
+        R"({"renderUrls": {"short": )", i, R"(, ")", long_key, R"(": )", i,
+        R"(, "key)", i, R"(": )", i, "}}")));
+  }
+  auto merged = MergeScoringSignals(std::move(partial_signals));
+  ASSERT_TRUE(merged.ok()) << merged.status();
+  ExpectJsonEq(*(*merged)->scoring_signals,
+               absl::StrCat(R"({"renderUrls": {"short": 0, ")", long_key,
+                            R"(": 0, "key0": 0, "key1": 1, "key2": 2}})"));
+}
+
+TEST(MergeScoringSignalsTest, DropsDataVersionIfPartialSignalsDisagree) {
+  std::vector<std::unique_ptr<ScoringSignals>> same_versions;
+  same_versions.push_back(
+      CreateSignals(R"({"renderUrls": {"a": 1}})", /*data_version=*/3));
+  same_versions.push_back(
+      CreateSignals(R"({"renderUrls": {"b": 2}})", /*data_version=*/3));
+  auto merged = MergeScoringSignals(std::move(same_versions));
+  ASSERT_TRUE(merged.ok()) << merged.status();
+  EXPECT_EQ((*merged)->data_version, 3);
+
+  std::vector<std::unique_ptr<ScoringSignals>> different_versions;
+  different_versions.push_back(
+      CreateSignals(R"({"renderUrls": {"a": 1}})", /*data_version=*/3));
+  different_versions.push_back(
+      CreateSignals(R"({"renderUrls": {"b": 2}})", /*data_version=*/4));
+  merged = MergeScoringSignals(std::move(different_versions));
+  ASSERT_TRUE(merged.ok()) << merged.status();
+  EXPECT_EQ((*merged)->data_version, 0);
+}
+
+TEST(MergeScoringSignalsTest, FailsOnMalformedSignals) {
+  std::vector<std::unique_ptr<ScoringSignals>> partial_signals;
+  partial_signals.push_back(CreateSignals(R"({"renderUrls": {"a": 1}})"));
+  partial_signals.push_back(CreateSignals(R"(["renderUrls"])"));
+  EXPECT_FALSE(MergeScoringSignals(std::move(partial_signals)).ok());
+}
+
+TEST(ScoringSignalsAccumulatorTest, InvokesCallbackRightAwayWithNoFetches) {
+  ScoringSignalsAccumulator accumulator;
+  bool called = false;
+  accumulator.OnAllFetchesStarted(
+      [&called](absl::StatusOr<std::unique_ptr<ScoringSignals>> result) {
+        ASSERT_TRUE(result.ok()) << result.status();
+        EXPECT_TRUE((*result)->scoring_signals->empty());
+        called = true;
+      });
+  EXPECT_TRUE(called);
+}
+
+TEST(ScoringSignalsAccumulatorTest, WaitsForPendingFetches) {
+  ScoringSignalsAccumulator accumulator;
+  accumulator.AddPendingFetch();
+  accumulator.AddPendingFetch();
+  accumulator.OnFetchDone(CreateSignals(R"({"renderUrls": {"a": 1}})"));
+
+  bool called = false;
+  accumulator.OnAllFetchesStarted(
+      [&called](absl::StatusOr<std::unique_ptr<ScoringSignals>> result) {
+        ASSERT_TRUE(result.ok()) << result.status();
+        ExpectJsonEq(*(*result)->scoring_signals,
+                     R"({"renderUrls": {"a": 1, "b": 2}})");
+        called = true;
+      });
+  EXPECT_FALSE(called);
+  accumulator.OnFetchDone(CreateSignals(R"({"renderUrls": {"b": 2}})"));
+  EXPECT_TRUE(called);
+}
+
+TEST(ScoringSignalsAccumulatorTest, ReturnsFirstFetchError) {
+  ScoringSignalsAccumulator accumulator;
+  accumulator.AddPendingFetch();
+  accumulator.AddPendingFetch();
+  accumulator.AddPendingFetch();
+  accumulator.OnFetchDone(CreateSignals(R"({"renderUrls": {"a": 1}})"));
+  accumulator.OnFetchDone(absl::UnavailableError("first"));
+  accumulator.OnFetchDone(absl::InternalError("second"));
+
+  absl::Status status;
+  accumulator.OnAllFetchesStarted(
+      [&status](absl::StatusOr<std::unique_ptr<ScoringSignals>> result) {
+        status = result.status();
+      });
+  EXPECT_EQ(status.code(), absl::StatusCode::kUnavailable);
+}
+
+TEST(ScoringSignalsAccumulatorTest, MergesFetchesCompletingConcurrently) {
+  constexpr int kNumFetches = 32;
+  ScoringSignalsAccumulator accumulator;
+  for (int i = 0; i < kNumFetches; ++i) {
+    accumulator.AddPendingFetch();
+  }
+  int num_calls = 0;
+  int num_keys = 0;
+  std::thread caller([&accumulator, &num_calls, &num_keys]() {
+    accumulator.OnAllFetchesStarted(
+        [&num_calls,
+         &num_keys](absl::StatusOr<std::unique_ptr<ScoringSignals>> result) {
+          ASSERT_TRUE(result.ok()) << result.status();
+          auto document = ParseJsonString(*(*result)->scoring_signals);
+          ASSERT_TRUE(document.ok()) << document.status();
+          num_keys = (*document)["renderUrls"].MemberCount();
+          ++num_calls;
+        });
+  });
+  std::vector<std::thread> fetches;
+  fetches.reserve(kNumFetches);
+  for (int i = 0; i < kNumFetches; ++i) {
+    fetches.emplace_back([&accumulator, i]() {
+      accumulator.OnFetchDone(CreateSignals(
+          absl::StrCat(R"({"renderUrls": {"key)", i, R"(": )", i, "}}")));
+    });
+  }
+  caller.join();
+  for (auto& fetch : fetches) {
+    fetch.join();
+  }
+  EXPECT_EQ(num_calls, 1);
+  EXPECT_EQ(num_keys, kNumFetches);
+}
+
+}  // namespace
+}  // namespace privacy_sandbox::bidding_auction_servers
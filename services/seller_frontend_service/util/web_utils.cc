@@ -14,11 +14,13 @@
 
 #include "services/seller_frontend_service/util/web_utils.h"
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/numeric/bits.h"
 #include "absl/status/statusor.h"
@@ -68,22 +70,9 @@ inline constexpr std::array<absl::string_view, kNumCborDataTypes>
                                 // values")
 };
 
-struct cbor_pair BuildCborKVPair(absl::string_view key,
-                                 absl::string_view value) {
-  return {.key = cbor_move(cbor_build_stringn(key.data(), key.size())),
-          .value = cbor_move(cbor_build_stringn(value.data(), value.size()))};
-}
-
-absl::Status AddKVToMap(absl::string_view key, absl::string_view value,
-                        ErrorHandler error_handler, cbor_item_t& map) {
-  if (!cbor_map_add(&map, BuildCborKVPair(key, value))) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL, absl::StrCat("Failed to serialize ", key, " to CBOR")));
-    return absl::InternalError("");
-  }
-
-  return absl::OkStatus();
-}
+// Initial capacity of the buffer that AuctionResults are encoded into, which is
+// enough for typical results to be written without reallocating.
+inline constexpr size_t kExpectedAuctionResultSize = 1024;
 
 // Decodes a Span of cbor* string objects and adds them to the provided list.
 RepeatedStringProto DecodeStringArray(absl::Span<cbor_item_t*> span,
@@ -280,88 +269,204 @@ BrowserSignalsForBidding DecodeBrowserSignals(
   return signals;
 }
 
-absl::Status CborSerializeAdComponentUrls(
-    absl::string_view key, const RepeatedStringProto& component_renders,
-    ErrorHandler error_handler, cbor_item_t& root) {
-  ScopedCbor serialized_component_renders(
-      cbor_new_definite_array(component_renders.size()));
-  for (const auto& component_render : component_renders) {
-    if (!cbor_array_push(
-            *serialized_component_renders,
-            cbor_move(cbor_build_stringn(component_render.data(),
-                                         component_render.size())))) {
-      error_handler(
-          grpc::Status(grpc::INTERNAL,
-                       absl::StrCat("Failed to serialize ", key, " to CBOR")));
-      return absl::InternalError("");
-    }
+// Reads an array of strings into `repeated_field`, replacing its contents.
+absl::Status StreamingDecodeStringArray(CborReader& reader,
+                                        RepeatedStringProto& repeated_field) {
+  PS_ASSIGN_OR_RETURN(uint64_t num_entries, reader.ReadArrayHeader());
+  repeated_field.Clear();
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    PS_ASSIGN_OR_RETURN(absl::string_view entry, reader.ReadTextString());
+    repeated_field.Add(std::string(entry));
   }
+  return absl::OkStatus();
+}
 
-  struct cbor_pair kv = {
-      .key = cbor_move(cbor_build_stringn(key.data(), key.size())),
-      .value = *serialized_component_renders};
-  if (!cbor_map_add(&root, kv)) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL, absl::StrCat("Failed to serialize ", key, " to CBOR")));
-    return absl::InternalError("");
-  }
+// Streaming counterpart of `GetStringifiedPrevWins`. The JSON arrays are
+// written out directly instead of being built up as rapidjson documents first.
+absl::Status StreamingDecodePrevWins(CborReader& reader,
+                                     BrowserSignalsForBidding& signals) {
+  PS_ASSIGN_OR_RETURN(uint64_t num_entries, reader.ReadArrayHeader());
+
+  rapidjson::StringBuffer buffer_seconds;
+  rapidjson::Writer<rapidjson::StringBuffer> writer_seconds(buffer_seconds);
+  rapidjson::StringBuffer buffer_ms;
+  rapidjson::Writer<rapidjson::StringBuffer> writer_ms(buffer_ms);
+  writer_seconds.StartArray();
+  writer_ms.StartArray();
 
+  // Previous win entries should be in the form [relative_time, ad_render_id]
+  // where relative_time is an int and ad_render_id is a string.
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    PS_ASSIGN_OR_RETURN(uint64_t prev_win_size, reader.ReadArrayHeader());
+    if (prev_win_size != 2) {
+      return absl::InvalidArgumentError("prevWins entry has incorrect length");
+    }
+    // Matches the narrowing of `cbor_get_int` in `GetStringifiedPrevWins`.
+    PS_ASSIGN_OR_RETURN(uint64_t relative_time, reader.ReadInt());
+    const int time = static_cast<int>(relative_time);
+    PS_ASSIGN_OR_RETURN(absl::string_view ad_render_id,
+                        reader.ReadTextString());
+
+    writer_seconds.StartArray();
+    writer_seconds.Int(time);
+    writer_seconds.String(ad_render_id.data(), ad_render_id.size());
+    writer_seconds.EndArray();
+
+    writer_ms.StartArray();
+    writer_ms.Int(time * 1000);
+    writer_ms.String(ad_render_id.data(), ad_render_id.size());
+    writer_ms.EndArray();
+  }
+
+  writer_seconds.EndArray();
+  writer_ms.EndArray();
+  signals.set_prev_wins(buffer_seconds.GetString(), buffer_seconds.GetSize());
+  signals.set_prev_wins_ms(buffer_ms.GetString(), buffer_ms.GetSize());
   return absl::OkStatus();
 }
 
-absl::Status CborSerializekAnonJoinCandidates(
-    absl::string_view key, const KAnonJoinCandidate& kanon_join_candidate,
-    ErrorHandler error_handler, cbor_item_t& root) {
-  ScopedCbor serialized_kanon_join_candidates(
-      cbor_new_definite_map(kNumKAnonJoinCandidateKeys));
-  PS_RETURN_IF_ERROR(CborSerializeByteString(
-      kAdRenderUrlHash, kanon_join_candidate.ad_render_url_hash(),
-      error_handler, **serialized_kanon_join_candidates));
-  PS_RETURN_IF_ERROR(CborSerializeByteString(
-      kReportingIdHash, kanon_join_candidate.reporting_id_hash(), error_handler,
-      **serialized_kanon_join_candidates));
-  const auto& input_ad_component_render_urls_hash =
-      kanon_join_candidate.ad_component_render_urls_hash();
-  ScopedCbor ad_component_render_urls_hash(
-      cbor_new_definite_array(input_ad_component_render_urls_hash.size()));
-  for (const auto& ad_component_render_url_hash :
-       input_ad_component_render_urls_hash) {
-    if (!cbor_array_push(*ad_component_render_urls_hash,
-                         cbor_move(cbor_build_bytestring(
-                             ReinterpretConstCharPtrAsUnsignedPtr(
-                                 ad_component_render_url_hash.data()),
-                             ad_component_render_url_hash.size())))) {
-      error_handler(grpc::Status(
-          grpc::INTERNAL,
-          "Failed to serialize ad component render URL hash to CBOR"));
-      return absl::InternalError("");
+// Streaming counterpart of `DecodeBrowserSignals`.
+absl::Status StreamingDecodeBrowserSignals(CborReader& reader,
+                                           BrowserSignalsForBidding& signals) {
+  PS_ASSIGN_OR_RETURN(uint64_t num_entries, reader.ReadMapHeader());
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    PS_ASSIGN_OR_RETURN(absl::string_view key, reader.ReadTextString());
+    switch (FindItemIndex(kBrowserSignalKeys, key)) {
+      case 0: {  // Bid count.
+        PS_ASSIGN_OR_RETURN(uint64_t bid_count, reader.ReadInt());
+        signals.set_bid_count(bid_count);
+        break;
+      }
+      case 1: {  // Join count.
+        PS_ASSIGN_OR_RETURN(uint64_t join_count, reader.ReadInt());
+        signals.set_join_count(join_count);
+        break;
+      }
+      case 2: {  // Recency.
+        PS_ASSIGN_OR_RETURN(uint64_t recency, reader.ReadInt());
+        signals.set_recency(recency);
+        break;
+      }
+      case 3: {  // Previous wins.
+        PS_RETURN_IF_ERROR(StreamingDecodePrevWins(reader, signals));
+        break;
+      }
+      case 4: {  // RecencyMs.
+        PS_ASSIGN_OR_RETURN(uint64_t recency_ms, reader.ReadInt());
+        signals.set_recency_ms(recency_ms);
+        break;
+      }
+      default:
+        PS_RETURN_IF_ERROR(reader.SkipItem());
     }
   }
-  struct cbor_pair kv = {
-      .key = cbor_move(cbor_build_stringn(
-          kAdComponentRenderUrlsHash, sizeof(kAdComponentRenderUrlsHash) - 1)),
-      .value = *ad_component_render_urls_hash};
-  if (!cbor_map_add(*serialized_kanon_join_candidates, kv)) {
-    error_handler(
-        grpc::Status(grpc::INTERNAL,
-                     "Failed to serialize kAdComponentRenderUrlsHash to CBOR"));
-    return absl::InternalError("");
-  }
-  struct cbor_pair outer_kv = {
-      .key = cbor_move(cbor_build_stringn(key.data(), key.size())),
-      .value = *serialized_kanon_join_candidates};
-  if (!cbor_map_add(&root, outer_kv)) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL, "Failed to serialize kAnonJoinCandidate to CBOR"));
-    return absl::InternalError("");
+  return absl::OkStatus();
+}
+
+// Streaming counterpart of the interest group decoding in
+// `CborTreeDecodeBuyerInput`.
+absl::Status StreamingDecodeInterestGroup(
+    CborReader& reader, BuyerInputForBidding& buyer_input_for_bidding) {
+  auto* buyer_interest_group = buyer_input_for_bidding.add_interest_groups();
+  PS_ASSIGN_OR_RETURN(uint64_t num_entries, reader.ReadMapHeader());
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    PS_ASSIGN_OR_RETURN(absl::string_view key, reader.ReadTextString());
+    switch (FindItemIndex(kInterestGroupKeys, key)) {
+      case 0: {  // Name.
+        PS_ASSIGN_OR_RETURN(absl::string_view name, reader.ReadTextString());
+        buyer_interest_group->set_name(name.data(), name.size());
+        break;
+      }
+      case 1: {  // Bidding signal keys.
+        PS_RETURN_IF_ERROR(StreamingDecodeStringArray(
+            reader, *buyer_interest_group->mutable_bidding_signals_keys()));
+        break;
+      }
+      case 2: {  // User bidding signals.
+        PS_ASSIGN_OR_RETURN(absl::string_view user_bidding_signals,
+                            reader.ReadTextString());
+        buyer_interest_group->set_user_bidding_signals(
+            user_bidding_signals.data(), user_bidding_signals.size());
+        break;
+      }
+      case 3: {  // Ad render IDs.
+        PS_RETURN_IF_ERROR(StreamingDecodeStringArray(
+            reader, *buyer_interest_group->mutable_ad_render_ids()));
+        break;
+      }
+      case 4: {  // Component ads.
+        PS_RETURN_IF_ERROR(StreamingDecodeStringArray(
+            reader, *buyer_interest_group->mutable_component_ads()));
+        break;
+      }
+      case 5: {  // Browser signals.
+        buyer_interest_group->clear_browser_signals();
+        PS_RETURN_IF_ERROR(StreamingDecodeBrowserSignals(
+            reader, *buyer_interest_group->mutable_browser_signals()));
+        break;
+      }
+      case 6: {  // Buyer in Cooldown or Lockout.
+        PS_ASSIGN_OR_RETURN(bool in_cooldown_or_lockout, reader.ReadBool());
+        buyer_input_for_bidding.set_in_cooldown_or_lockout(
+            in_cooldown_or_lockout);
+        break;
+      }
+      default:
+        PS_RETURN_IF_ERROR(reader.SkipItem());
+    }
   }
   return absl::OkStatus();
 }
 
+// Returns the entries of the map ordered by their keys using `kComparator`.
+template <typename MapT>
+std::vector<const typename MapT::value_type*> GetEntriesOrderedByKey(
+    const MapT& map) {
+  std::vector<const typename MapT::value_type*> entries;
+  entries.reserve(map.size());
+  for (const auto& entry : map) {
+    entries.push_back(&entry);
+  }
+  std::sort(entries.begin(), entries.end(), [](const auto* a, const auto* b) {
+    return kComparator(a->first, b->first);
+  });
+  return entries;
+}
+
+void CborSerializeAdComponentUrls(absl::string_view key,
+                                  const RepeatedStringProto& component_renders,
+                                  CborWriter& writer) {
+  writer.WriteTextString(key);
+  writer.StartArray();
+  for (const auto& component_render : component_renders) {
+    writer.WriteTextString(component_render);
+  }
+  writer.EndArray();
+}
+
+void CborSerializekAnonJoinCandidates(
+    absl::string_view key, const KAnonJoinCandidate& kanon_join_candidate,
+    CborWriter& writer) {
+  writer.WriteTextString(key);
+  writer.StartMap();
+  CborSerializeByteString(kAdRenderUrlHash,
+                          kanon_join_candidate.ad_render_url_hash(), writer);
+  CborSerializeByteString(kReportingIdHash,
+                          kanon_join_candidate.reporting_id_hash(), writer);
+  writer.WriteTextString(kAdComponentRenderUrlsHash);
+  writer.StartArray();
+  for (const auto& ad_component_render_url_hash :
+       kanon_join_candidate.ad_component_render_urls_hash()) {
+    writer.WriteByteString(ad_component_render_url_hash);
+  }
+  writer.EndArray();
+  writer.EndMap();
+}
+
 absl::Status CborSerializekAnonGhostWinnerForTopLevelAuction(
     absl::string_view key,
     const GhostWinnerForTopLevelAuction& ghost_winner_for_top_level_auction,
-    ErrorHandler error_handler, cbor_item_t& root) {
+    CborWriter& writer) {
   // Logic in the rest of the system guarantees that:
   // - buyer_bid must be > 0 for the AdWithBid to be scored
   // - modified bid is replaced by buyer_bid if modified bid is <= 0
@@ -374,197 +479,104 @@ absl::Status CborSerializekAnonGhostWinnerForTopLevelAuction(
                         "Logic Error: Modified bid should be positive for "
                         "ghost winners");
   }
-  ScopedCbor serialized_ghost_winner(
-      cbor_new_definite_map(kNumGhostWinnerForTopLevelAuctionKeys));
+  writer.WriteTextString(key);
+  writer.StartMap();
   if (!ghost_winner_for_top_level_auction.ad_metadata().empty()) {
-    PS_RETURN_IF_ERROR(CborSerializeString(
-        kAdMetadata, ghost_winner_for_top_level_auction.ad_metadata(),
-        error_handler, **serialized_ghost_winner));
+    CborSerializeString(kAdMetadata,
+                        ghost_winner_for_top_level_auction.ad_metadata(),
+                        writer);
   }
-  PS_RETURN_IF_ERROR(CborSerializeString(
-      kAdRenderUrl, ghost_winner_for_top_level_auction.ad_render_url(),
-      error_handler, **serialized_ghost_winner));
+  CborSerializeString(kAdRenderUrl,
+                      ghost_winner_for_top_level_auction.ad_render_url(),
+                      writer);
   if (!ghost_winner_for_top_level_auction.bid_currency().empty()) {
-    PS_RETURN_IF_ERROR(CborSerializeString(
-        kBidCurrency, ghost_winner_for_top_level_auction.bid_currency(),
-        error_handler, **serialized_ghost_winner));
+    CborSerializeString(kBidCurrency,
+                        ghost_winner_for_top_level_auction.bid_currency(),
+                        writer);
   }
-  PS_RETURN_IF_ERROR(CborSerializeFloat(
-      kModifiedBid, ghost_winner_for_top_level_auction.modified_bid(),
-      error_handler, **serialized_ghost_winner));
+  CborSerializeFloat(kModifiedBid,
+                     ghost_winner_for_top_level_auction.modified_bid(), writer);
   if (ghost_winner_for_top_level_auction.has_buyer_reporting_id()) {
-    PS_RETURN_IF_ERROR(CborSerializeString(
-        kBuyerReportingId,
-        ghost_winner_for_top_level_auction.buyer_reporting_id(), error_handler,
-        **serialized_ghost_winner));
-  }
-
-  ScopedCbor serialized_ad_component_render_urls(cbor_new_definite_array(
-      ghost_winner_for_top_level_auction.ad_component_render_urls_size()));
-  for (auto& ad_component_render_url :
-       ghost_winner_for_top_level_auction.ad_component_render_urls()) {
-    if (!cbor_array_push(
-            *serialized_ad_component_render_urls,
-            cbor_move(cbor_build_stringn(ad_component_render_url.data(),
-                                         ad_component_render_url.size())))) {
-      error_handler(grpc::Status(grpc::INTERNAL,
-                                 "Failed to serialize a ad component render "
-                                 "url for ghost winner to CBOR"));
-      return absl::InternalError("");
-    }
-  }
-  struct cbor_pair kv = {
-      .key = cbor_move(cbor_build_stringn(kAdComponentRenderUrls,
-                                          sizeof(kAdComponentRenderUrls) - 1)),
-      .value = *serialized_ad_component_render_urls};
-  if (!cbor_map_add(*serialized_ghost_winner, kv)) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL, "Failed to serialize adComponentRenderUrls to CBOR"));
-    return absl::InternalError("");
+    CborSerializeString(kBuyerReportingId,
+                        ghost_winner_for_top_level_auction.buyer_reporting_id(),
+                        writer);
   }
-
+  CborSerializeAdComponentUrls(
+      kAdComponentRenderUrls,
+      ghost_winner_for_top_level_auction.ad_component_render_urls(), writer);
   if (ghost_winner_for_top_level_auction.has_buyer_and_seller_reporting_id()) {
-    PS_RETURN_IF_ERROR(CborSerializeString(
+    CborSerializeString(
         kBuyerAndSellerReportingId,
         ghost_winner_for_top_level_auction.buyer_and_seller_reporting_id(),
-        error_handler, **serialized_ghost_winner));
+        writer);
   }
   if (ghost_winner_for_top_level_auction
           .has_selected_buyer_and_seller_reporting_id()) {
-    PS_RETURN_IF_ERROR(
-        CborSerializeString(kSelectedBuyerAndSellerReportingId,
-                            ghost_winner_for_top_level_auction
-                                .selected_buyer_and_seller_reporting_id(),
-                            error_handler, **serialized_ghost_winner));
-  }
-
-  struct cbor_pair outer_kv = {
-      .key = cbor_move(cbor_build_stringn(key.data(), key.size())),
-      .value = *serialized_ghost_winner};
-  if (!cbor_map_add(&root, outer_kv)) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL, "Failed to serialize kAnonJoinCandidate to CBOR"));
-    return absl::InternalError("");
-  }
-  return absl::OkStatus();
-}
-
-absl::Status CborSerializekAnonGhostWinnerPrivateAggSignal(
-    const GhostWinnerPrivateAggregationSignals& signal,
-    ErrorHandler error_handler, cbor_item_t& root) {
-  ScopedCbor serialized_private_agg_signal(
-      cbor_new_definite_map(kNumGhostWinnerPrivateAggregationSignalsKeys));
-  PS_RETURN_IF_ERROR(CborSerializeInt(kValue, signal.value(), error_handler,
-                                      **serialized_private_agg_signal));
-  PS_RETURN_IF_ERROR(CborSerializeByteString(kBucket, signal.bucket(),
-                                             error_handler,
-                                             **serialized_private_agg_signal));
-
-  if (!cbor_array_push(&root, *serialized_private_agg_signal)) {
-    error_handler(
-        grpc::Status(grpc::INTERNAL,
-                     "Failed to serialize a "
-                     "GhostWinnerPrivateAggregationSignals object to CBOR"));
-    return absl::InternalError("");
+    CborSerializeString(kSelectedBuyerAndSellerReportingId,
+                        ghost_winner_for_top_level_auction
+                            .selected_buyer_and_seller_reporting_id(),
+                        writer);
   }
+  writer.EndMap();
   return absl::OkStatus();
 }
 
-absl::Status CborSerializekAnonGhostWinnerPrivateAggSignals(
+void CborSerializekAnonGhostWinnerPrivateAggSignals(
     absl::string_view key,
     const google::protobuf::RepeatedPtrField<
         GhostWinnerPrivateAggregationSignals>& private_agg_signals,
-    ErrorHandler error_handler, cbor_item_t& root) {
-  ScopedCbor serialized_private_agg_signals(
-      cbor_new_definite_array(private_agg_signals.size()));
+    CborWriter& writer) {
+  writer.WriteTextString(key);
+  writer.StartArray();
   for (const auto& signal : private_agg_signals) {
-    if (auto status = CborSerializekAnonGhostWinnerPrivateAggSignal(
-            signal, error_handler, **serialized_private_agg_signals);
-        !status.ok()) {
-      error_handler(
-          grpc::Status(grpc::INTERNAL,
-                       "Failed to serialize an array of "
-                       "GhostWinnerPrivateAggregationSignals to CBOR"));
-      return absl::InternalError("");
-    }
+    writer.StartMap();
+    CborSerializeInt(kValue, signal.value(), writer);
+    CborSerializeByteString(kBucket, signal.bucket(), writer);
+    writer.EndMap();
   }
-  struct cbor_pair kv = {
-      .key = cbor_move(cbor_build_stringn(
-          kGhostWinnerPrivateAggregationSignals,
-          sizeof(kGhostWinnerPrivateAggregationSignals) - 1)),
-      .value = *serialized_private_agg_signals};
-  if (!cbor_map_add(&root, kv)) {
-    error_handler(grpc::Status(grpc::INTERNAL,
-                               "Failed to serialize an array of "
-                               "GhostWinnerPrivateAggregationSignals to CBOR"));
-    return absl::InternalError("");
-  }
-  return absl::OkStatus();
+  writer.EndArray();
 }
 
 absl::Status CborSerializeKAnonGhostWinner(
     const AuctionResult::KAnonGhostWinner& kanon_ghost_winner,
-    ErrorHandler error_handler, cbor_item_t& root) {
-  ScopedCbor serialized_kanon_ghost_winner(
-      cbor_new_definite_map(kNumKAnonGhostWinnerKeys));
-  PS_RETURN_IF_ERROR(CborSerializeString(kOwner, kanon_ghost_winner.owner(),
-                                         error_handler,
-                                         **serialized_kanon_ghost_winner));
-  PS_RETURN_IF_ERROR(
-      CborSerializeString(kInterestGroupName, kanon_ghost_winner.ig_name(),
-                          error_handler, **serialized_kanon_ghost_winner));
-  PS_RETURN_IF_ERROR(CborSerializeInt(
-      kInterestGroupIndex, kanon_ghost_winner.interest_group_index(),
-      error_handler, **serialized_kanon_ghost_winner));
-  PS_RETURN_IF_ERROR(CborSerializekAnonJoinCandidates(
+    CborWriter& writer) {
+  writer.StartMap();
+  CborSerializeString(kOwner, kanon_ghost_winner.owner(), writer);
+  CborSerializeString(kInterestGroupName, kanon_ghost_winner.ig_name(), writer);
+  CborSerializeInt(kInterestGroupIndex,
+                   kanon_ghost_winner.interest_group_index(), writer);
+  CborSerializekAnonJoinCandidates(
       kKAnonJoinCandidates, kanon_ghost_winner.k_anon_join_candidates(),
-      error_handler, **serialized_kanon_ghost_winner));
+      writer);
   if (kanon_ghost_winner.has_ghost_winner_for_top_level_auction()) {
     PS_RETURN_IF_ERROR(CborSerializekAnonGhostWinnerForTopLevelAuction(
         kGhostWinnerForTopLevelAuction,
-        kanon_ghost_winner.ghost_winner_for_top_level_auction(), error_handler,
-        **serialized_kanon_ghost_winner));
+        kanon_ghost_winner.ghost_winner_for_top_level_auction(), writer));
   }
   if (!kanon_ghost_winner.ghost_winner_private_aggregation_signals().empty()) {
-    PS_RETURN_IF_ERROR(CborSerializekAnonGhostWinnerPrivateAggSignals(
+    CborSerializekAnonGhostWinnerPrivateAggSignals(
         kGhostWinnerPrivateAggregationSignals,
-        kanon_ghost_winner.ghost_winner_private_aggregation_signals(),
-        error_handler, **serialized_kanon_ghost_winner));
-  }
-  if (!cbor_array_push(&root, *serialized_kanon_ghost_winner)) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL,
-        "Failed to serialize ad component render URL hash to CBOR"));
-    return absl::InternalError("");
+        kanon_ghost_winner.ghost_winner_private_aggregation_signals(), writer);
   }
+  writer.EndMap();
   return absl::OkStatus();
 }
 
 absl::Status CborSerializeKAnonGhostWinners(
     absl::string_view key,
     const std::vector<AuctionResult::KAnonGhostWinner>& kanon_ghost_winners,
-    ErrorHandler error_handler, cbor_item_t& root) {
-  ScopedCbor serialized_kanon_ghost_winners(
-      cbor_new_definite_array(kanon_ghost_winners.size()));
+    ErrorHandler error_handler, CborWriter& writer) {
+  writer.WriteTextString(key);
+  writer.StartArray();
   for (const auto& kanon_ghost_winner : kanon_ghost_winners) {
-    if (auto status =
-            CborSerializeKAnonGhostWinner(kanon_ghost_winner, error_handler,
-                                          **serialized_kanon_ghost_winners);
+    if (auto status = CborSerializeKAnonGhostWinner(kanon_ghost_winner, writer);
         !status.ok()) {
       error_handler(grpc::Status(
           grpc::INTERNAL, "Failed to serialize a kAnonGhostWinner to CBOR"));
       return absl::InternalError("");
     }
   }
-  struct cbor_pair kv = {
-      .key = cbor_move(cbor_build_stringn(kKAnonGhostWinners,
-                                          sizeof(kKAnonGhostWinners) - 1)),
-      .value = *serialized_kanon_ghost_winners};
-  if (!cbor_map_add(&root, kv)) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL, "Failed to serialize kAnonGhostWinners to CBOR"));
-    return absl::InternalError("");
-  }
+  writer.EndArray();
   return absl::OkStatus();
 }
 
@@ -575,59 +587,48 @@ absl::Status CborSerializeScoreAdResponse(
     const AdtechOriginDebugUrlsMap& adtech_origin_debug_urls_map,
     int per_adtech_paapi_contributions_limit,
     absl::string_view ad_auction_result_nonce,
-    std::unique_ptr<KAnonAuctionResultData> kanon_auction_result_data,
-    ErrorHandler error_handler, cbor_item_t& root) {
-  PS_RETURN_IF_ERROR(
-      CborSerializeFloat(kBid, ad_score.buyer_bid(), error_handler, root));
+    const KAnonAuctionResultData* kanon_auction_result_data,
+    ErrorHandler error_handler, CborWriter& writer) {
+  CborSerializeFloat(kBid, ad_score.buyer_bid(), writer);
   if (!ad_auction_result_nonce.empty()) {
-    PS_RETURN_IF_ERROR(CborSerializeString(
-        kAdAuctionResultNonce, ad_auction_result_nonce, error_handler, root));
-  }
-  PS_RETURN_IF_ERROR(
-      CborSerializeFloat(kScore, ad_score.desirability(), error_handler, root));
-  PS_RETURN_IF_ERROR(CborSerializeBool(kChaff, false, error_handler, root));
-  PS_RETURN_IF_ERROR(CborSerializeAdComponentUrls(
-      kAdComponents, ad_score.component_renders(), error_handler, root));
-  PS_RETURN_IF_ERROR(CborSerializeString(kAdRenderUrl, ad_score.render(),
-                                         error_handler, root));
+    CborSerializeString(kAdAuctionResultNonce, ad_auction_result_nonce, writer);
+  }
+  CborSerializeFloat(kScore, ad_score.desirability(), writer);
+  CborSerializeBool(kChaff, false, writer);
+  CborSerializeAdComponentUrls(kAdComponents, ad_score.component_renders(),
+                               writer);
+  CborSerializeString(kAdRenderUrl, ad_score.render(), writer);
   if (ad_score.top_level_contributions().size() > 0) {
     PS_RETURN_IF_ERROR(CborSerializePAggResponse(
         ad_score.top_level_contributions(),
-        per_adtech_paapi_contributions_limit, error_handler, root));
-  }
-  PS_RETURN_IF_ERROR(CborSerializeDebugReports(adtech_origin_debug_urls_map,
-                                               error_handler, root));
-  PS_RETURN_IF_ERROR(
-      CborSerializeUpdateGroups(update_group_map, error_handler, root));
-  PS_RETURN_IF_ERROR(
-      CborSerializeBiddingGroups(bidding_group_map, error_handler, root));
+        per_adtech_paapi_contributions_limit, error_handler, writer));
+  }
+  CborSerializeDebugReports(adtech_origin_debug_urls_map, writer);
+  CborSerializeUpdateGroups(update_group_map, writer);
+  CborSerializeBiddingGroups(bidding_group_map, writer);
   if (!ad_score.buyer_reporting_id().empty()) {
-    PS_RETURN_IF_ERROR(CborSerializeString(
-        kBuyerReportingId, ad_score.buyer_reporting_id(), error_handler, root));
+    CborSerializeString(kBuyerReportingId, ad_score.buyer_reporting_id(),
+                        writer);
   }
-  PS_RETURN_IF_ERROR(CborSerializeWinReportingUrls(
-      ad_score.win_reporting_urls(), error_handler, root));
-  PS_RETURN_IF_ERROR(CborSerializeString(
-      kInterestGroupName, ad_score.interest_group_name(), error_handler, root));
+  CborSerializeWinReportingUrls(ad_score.win_reporting_urls(), writer);
+  CborSerializeString(kInterestGroupName, ad_score.interest_group_name(),
+                      writer);
   if (kanon_auction_result_data != nullptr &&
       kanon_auction_result_data->kanon_ghost_winners != nullptr) {
     PS_RETURN_IF_ERROR(CborSerializeKAnonGhostWinners(
         kKAnonGhostWinners, *kanon_auction_result_data->kanon_ghost_winners,
-        error_handler, root));
+        error_handler, writer));
   }
-  PS_RETURN_IF_ERROR(CborSerializeString(kInterestGroupOwner,
-                                         ad_score.interest_group_owner(),
-                                         error_handler, root));
+  CborSerializeString(kInterestGroupOwner, ad_score.interest_group_owner(),
+                      writer);
   if (kanon_auction_result_data != nullptr &&
       kanon_auction_result_data->kanon_winner_join_candidates != nullptr) {
-    PS_RETURN_IF_ERROR(CborSerializekAnonJoinCandidates(
+    CborSerializekAnonJoinCandidates(
         kKAnonWinnerJoinCandidates,
-        *kanon_auction_result_data->kanon_winner_join_candidates, error_handler,
-        root));
-    PS_RETURN_IF_ERROR(CborSerializeInt(
-        kKAnonWinnerPositionalIndex,
-        kanon_auction_result_data->kanon_winner_positional_index, error_handler,
-        root));
+        *kanon_auction_result_data->kanon_winner_join_candidates, writer);
+    CborSerializeInt(kKAnonWinnerPositionalIndex,
+                     kanon_auction_result_data->kanon_winner_positional_index,
+                     writer);
   }
   return absl::OkStatus();
 }
@@ -639,8 +640,8 @@ absl::Status CborSerializeComponentScoreAdResponse(
     const UpdateGroupMap& update_group_map,
     const AdtechOriginDebugUrlsMap& adtech_origin_debug_urls_map,
     absl::string_view ad_auction_result_nonce,
-    std::unique_ptr<KAnonAuctionResultData> kanon_auction_result_data,
-    ErrorHandler error_handler, cbor_item_t& root) {
+    const KAnonAuctionResultData* kanon_auction_result_data,
+    ErrorHandler error_handler, CborWriter& writer) {
   // Logic in the rest of the system guarantees that:
   // - buyer_bid must be > 0 for the AdWithBid to be scored
   // - modified bid is replaced by buyer_bid if modified bid is <= 0
@@ -652,121 +653,55 @@ absl::Status CborSerializeComponentScoreAdResponse(
     return absl::Status(absl::StatusCode::kInternal,
                         "Modified bid should never be zero, logic error");
   }
-  PS_RETURN_IF_ERROR(
-      CborSerializeFloat(kBid, ad_score.bid(), error_handler, root));
+  CborSerializeFloat(kBid, ad_score.bid(), writer);
   if (!ad_auction_result_nonce.empty()) {
-    PS_RETURN_IF_ERROR(CborSerializeString(
-        kAdAuctionResultNonce, ad_auction_result_nonce, error_handler, root));
+    CborSerializeString(kAdAuctionResultNonce, ad_auction_result_nonce, writer);
   }
-  PS_RETURN_IF_ERROR(
-      CborSerializeFloat(kScore, ad_score.desirability(), error_handler, root));
-  PS_RETURN_IF_ERROR(CborSerializeBool(kChaff, false, error_handler, root));
+  CborSerializeFloat(kScore, ad_score.desirability(), writer);
+  CborSerializeBool(kChaff, false, writer);
   if (!ad_score.ad_metadata().empty()) {
-    PS_RETURN_IF_ERROR(CborSerializeString(kAdMetadata, ad_score.ad_metadata(),
-                                           error_handler, root));
+    CborSerializeString(kAdMetadata, ad_score.ad_metadata(), writer);
   }
-  PS_RETURN_IF_ERROR(CborSerializeAdComponentUrls(
-      kAdComponents, ad_score.component_renders(), error_handler, root));
-  PS_RETURN_IF_ERROR(CborSerializeString(kAdRenderUrl, ad_score.render(),
-                                         error_handler, root));
+  CborSerializeAdComponentUrls(kAdComponents, ad_score.component_renders(),
+                               writer);
+  CborSerializeString(kAdRenderUrl, ad_score.render(), writer);
   if (!ad_score.bid_currency().empty()) {
-    PS_RETURN_IF_ERROR(CborSerializeString(
-        kBidCurrency, ad_score.bid_currency(), error_handler, root));
-  }
-  PS_RETURN_IF_ERROR(CborSerializeDebugReports(adtech_origin_debug_urls_map,
-                                               error_handler, root));
-  PS_RETURN_IF_ERROR(
-      CborSerializeUpdateGroups(update_group_map, error_handler, root));
-  PS_RETURN_IF_ERROR(
-      CborSerializeBiddingGroups(bidding_group_map, error_handler, root));
-  PS_RETURN_IF_ERROR(CborSerializeString(kTopLevelSeller, top_level_seller,
-                                         error_handler, root));
-  PS_RETURN_IF_ERROR(CborSerializeWinReportingUrls(
-      ad_score.win_reporting_urls(), error_handler, root));
-  PS_RETURN_IF_ERROR(CborSerializeString(
-      kInterestGroupName, ad_score.interest_group_name(), error_handler, root));
+    CborSerializeString(kBidCurrency, ad_score.bid_currency(), writer);
+  }
+  CborSerializeDebugReports(adtech_origin_debug_urls_map, writer);
+  CborSerializeUpdateGroups(update_group_map, writer);
+  CborSerializeBiddingGroups(bidding_group_map, writer);
+  CborSerializeString(kTopLevelSeller, top_level_seller, writer);
+  CborSerializeWinReportingUrls(ad_score.win_reporting_urls(), writer);
+  CborSerializeString(kInterestGroupName, ad_score.interest_group_name(),
+                      writer);
   if (kanon_auction_result_data != nullptr &&
       kanon_auction_result_data->kanon_ghost_winners != nullptr) {
     PS_RETURN_IF_ERROR(CborSerializeKAnonGhostWinners(
         kKAnonGhostWinners, *kanon_auction_result_data->kanon_ghost_winners,
-        error_handler, root));
+        error_handler, writer));
   }
-  PS_RETURN_IF_ERROR(CborSerializeString(kInterestGroupOwner,
-                                         ad_score.interest_group_owner(),
-                                         error_handler, root));
+  CborSerializeString(kInterestGroupOwner, ad_score.interest_group_owner(),
+                      writer);
   if (kanon_auction_result_data != nullptr &&
       kanon_auction_result_data->kanon_winner_join_candidates != nullptr) {
-    PS_RETURN_IF_ERROR(CborSerializekAnonJoinCandidates(
+    CborSerializekAnonJoinCandidates(
         kKAnonWinnerJoinCandidates,
-        *kanon_auction_result_data->kanon_winner_join_candidates, error_handler,
-        root));
-    PS_RETURN_IF_ERROR(CborSerializeInt(
-        kKAnonWinnerPositionalIndex,
-        kanon_auction_result_data->kanon_winner_positional_index, error_handler,
-        root));
+        *kanon_auction_result_data->kanon_winner_join_candidates, writer);
+    CborSerializeInt(kKAnonWinnerPositionalIndex,
+                     kanon_auction_result_data->kanon_winner_positional_index,
+                     writer);
   }
   return absl::OkStatus();
 }
 
-absl::StatusOr<std::string> GetCborSerializedAuctionResult(
-    ErrorHandler error_handler, cbor_item_t& cbor_data_root) {
-  // Serialize the payload to CBOR.
-  const size_t cbor_serialized_data_size =
-      cbor_serialized_size(&cbor_data_root);
-  if (!cbor_serialized_data_size) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL,
-        "Failed to serialize the AuctionResult to CBOR (data is too large!)"));
-    return absl::InternalError("");
-  }
-
-  std::string byte_string;
-  byte_string.resize(cbor_serialized_data_size);
-  if (cbor_serialize(&cbor_data_root,
-                     reinterpret_cast<unsigned char*>(byte_string.data()),
-                     cbor_serialized_data_size) == 0) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL, "Failed to serialize the AuctionResult to CBOR"));
-    return absl::InternalError("");
-  }
-  return byte_string;
-}
-
-absl::Status CborSerializeError(const AuctionResult::Error& error,
-                                ErrorHandler error_handler, cbor_item_t& root) {
-  ScopedCbor serialized_error_map(cbor_new_definite_map(kNumErrorKeys));
-  struct cbor_pair code_kv = {
-      .key = cbor_move(cbor_build_stringn(kCode, sizeof(kCode) - 1)),
-      .value = cbor_move(cbor_build_uint(error.code()))};
-  if (!cbor_map_add(*serialized_error_map, code_kv)) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL,
-        absl::StrCat("Failed to serialize error ", kCode, " to CBOR")));
-    return absl::InternalError("");
-  }
-
-  const std::string& message = error.message();
-  struct cbor_pair message_kv = {
-      .key = cbor_move(cbor_build_stringn(kMessage, sizeof(kMessage) - 1)),
-      .value = cbor_move(cbor_build_stringn(message.data(), message.size()))};
-  if (!cbor_map_add(*serialized_error_map, message_kv)) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL,
-        absl::StrCat("Failed to serialize error ", kMessage, " to CBOR")));
-    return absl::InternalError("");
-  }
-
-  struct cbor_pair kv = {
-      .key = cbor_move(cbor_build_stringn(kError, sizeof(kError) - 1)),
-      .value = *serialized_error_map};
-  if (!cbor_map_add(&root, kv)) {
-    error_handler(
-        grpc::Status(grpc::INTERNAL,
-                     absl::StrCat("Failed to serialize ", kError, " to CBOR")));
-    return absl::InternalError("");
-  }
-
-  return absl::OkStatus();
+void CborSerializeError(const AuctionResult::Error& error, CborWriter& writer) {
+  writer.WriteTextString(kError);
+  writer.StartMap();
+  writer.WriteTextString(kCode);
+  writer.WriteUint(static_cast<uint>(error.code()));
+  CborSerializeString(kMessage, error.message(), writer);
+  writer.EndMap();
 }
 
 absl::StatusOr<UpdateGroupMap> CborDecodeUpdateGroupMapToProto(
@@ -1439,6 +1374,50 @@ EncodedBuyerInputs DecodeBuyerInputKeys(
   return encoded_buyer_inputs;
 }
 
+absl::Status StreamingDecodeConsentedDebugConfig(
+    CborReader& reader,
+    server_common::ConsentedDebugConfiguration& consented_debug_config) {
+  PS_ASSIGN_OR_RETURN(uint64_t num_entries, reader.ReadMapHeader());
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    PS_ASSIGN_OR_RETURN(absl::string_view key, reader.ReadTextString());
+    switch (FindItemIndex(kConsentedDebugConfigKeys, key)) {
+      case 0: {  // IsConsented.
+        PS_ASSIGN_OR_RETURN(bool is_consented, reader.ReadBool());
+        consented_debug_config.set_is_consented(is_consented);
+        break;
+      }
+      case 1: {  // Token.
+        PS_ASSIGN_OR_RETURN(absl::string_view token, reader.ReadTextString());
+        consented_debug_config.set_token(token.data(), token.size());
+        break;
+      }
+      case 2: {  // IsDebugResponse.
+        PS_ASSIGN_OR_RETURN(bool is_debug_info_in_response, reader.ReadBool());
+        consented_debug_config.set_is_debug_info_in_response(
+            is_debug_info_in_response);
+        break;
+      }
+      default:
+        PS_RETURN_IF_ERROR(reader.SkipItem());
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status StreamingDecodeBuyerInputKeys(
+    CborReader& reader, EncodedBuyerInputs& encoded_buyer_inputs) {
+  PS_ASSIGN_OR_RETURN(uint64_t num_entries, reader.ReadMapHeader());
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    PS_ASSIGN_OR_RETURN(absl::string_view owner, reader.ReadTextString());
+    // The value is a gzip compressed bytestring.
+    PS_ASSIGN_OR_RETURN(absl::string_view compressed_igs,
+                        reader.ReadByteString());
+    encoded_buyer_inputs.insert(
+        {std::string(owner), std::string(compressed_igs)});
+  }
+  return absl::OkStatus();
+}
+
 bool IsTypeValid(absl::AnyInvocable<bool(const cbor_item_t*)> is_valid_type,
                  const cbor_item_t* item, absl::string_view field_name,
                  absl::string_view expected_type,
@@ -1458,207 +1437,80 @@ bool IsTypeValid(absl::AnyInvocable<bool(const cbor_item_t*)> is_valid_type,
   return true;
 }
 
-absl::Status CborSerializeDebugReports(
+void CborSerializeDebugReports(
     const AdtechOriginDebugUrlsMap& adtech_origin_debug_urls_map,
-    ErrorHandler error_handler, cbor_item_t& root) {
+    CborWriter& writer) {
   if (adtech_origin_debug_urls_map.empty()) {
-    return absl::OkStatus();
-  }
-  ScopedCbor serialized_debug_reports(
-      cbor_new_definite_array(adtech_origin_debug_urls_map.size()));
-  std::set<absl::string_view, decltype(kComparator)> ordered_origins(
-      kComparator);
-  for (const auto& [origin, unused] : adtech_origin_debug_urls_map) {
-    ordered_origins.insert(origin);
-  }
-
-  for (absl::string_view origin : ordered_origins) {
-    const DebugReports& debug_reports = adtech_origin_debug_urls_map.at(origin);
-
-    ScopedCbor debug_reports_per_origin(
-        cbor_new_definite_map(kNumDebugReportsKeys));
-    ScopedCbor reports_array(
-        cbor_new_definite_array(debug_reports.reports_size()));
+    return;
+  }
+  writer.WriteTextString(kDebugReports);
+  writer.StartArray();
+  for (const auto* entry :
+       GetEntriesOrderedByKey(adtech_origin_debug_urls_map)) {
+    const auto& [origin, debug_reports] = *entry;
+    writer.StartMap();
+    writer.WriteTextString(kReports);
+    writer.StartArray();
     for (const DebugReports::DebugReport& report : debug_reports.reports()) {
-      ScopedCbor report_map(cbor_new_definite_map(kNumDebugReportKeys));
-      PS_RETURN_IF_ERROR(
-          CborSerializeString(kUrl, report.url(), error_handler, **report_map));
-      PS_RETURN_IF_ERROR(CborSerializeBool(kIsWinReport, report.is_win_report(),
-                                           error_handler, **report_map));
-      PS_RETURN_IF_ERROR(CborSerializeBool(kComponentWin,
-                                           report.is_component_win(),
-                                           error_handler, **report_map));
-      PS_RETURN_IF_ERROR(CborSerializeBool(kIsSellerReport,
-                                           report.is_seller_report(),
-                                           error_handler, **report_map));
-      if (!cbor_array_push(*reports_array, *report_map)) {
-        error_handler(grpc::Status(grpc::INTERNAL,
-                                   absl::StrCat("Failed to add debug report "
-                                                "entry to array for origin: ",
-                                                origin)));
-        return absl::InternalError("");
-      }
-    }
-    struct cbor_pair reports_kv = {
-        .key = cbor_move(cbor_build_stringn(kReports, sizeof(kReports) - 1)),
-        .value = *reports_array};
-    if (!cbor_map_add(*debug_reports_per_origin, reports_kv)) {
-      error_handler(grpc::Status(
-          grpc::INTERNAL, absl::StrCat("Failed to add ", kReports, " to map")));
-      return absl::InternalError("");
-    }
-    PS_RETURN_IF_ERROR(CborSerializeString(kAdTechOrigin, origin, error_handler,
-                                           **debug_reports_per_origin));
-
-    if (!cbor_array_push(*serialized_debug_reports,
-                         *debug_reports_per_origin)) {
-      error_handler(grpc::Status(
-          grpc::INTERNAL,
-          absl::StrCat("Failed to add debug reports per origin to array")));
-      return absl::InternalError("");
+      writer.StartMap();
+      CborSerializeString(kUrl, report.url(), writer);
+      CborSerializeBool(kIsWinReport, report.is_win_report(), writer);
+      CborSerializeBool(kComponentWin, report.is_component_win(), writer);
+      CborSerializeBool(kIsSellerReport, report.is_seller_report(), writer);
+      writer.EndMap();
     }
+    writer.EndArray();
+    CborSerializeString(kAdTechOrigin, origin, writer);
+    writer.EndMap();
   }
-
-  struct cbor_pair debug_reports_kv = {
-      .key = cbor_move(
-          cbor_build_stringn(kDebugReports, sizeof(kDebugReports) - 1)),
-      .value = *serialized_debug_reports};
-  if (!cbor_map_add(&root, debug_reports_kv)) {
-    error_handler(
-        grpc::Status(grpc::INTERNAL,
-                     absl::StrCat("Failed to add ", kDebugReports, " to map")));
-    return absl::InternalError("");
-  }
-  return absl::OkStatus();
+  writer.EndArray();
 }
 
-absl::Status CborSerializeUpdateGroups(const UpdateGroupMap& update_groups,
-                                       ErrorHandler error_handler,
-                                       cbor_item_t& root) {
-  ScopedCbor serialized_group_map(cbor_new_definite_map(update_groups.size()));
-  std::set<absl::string_view, decltype(kComparator)> ordered_origins(
-      kComparator);
-  // NOLINTNEXTLINE
-  for (const auto& [origin, unused] : update_groups) {
-    ordered_origins.insert(origin);
-  }
-  for (absl::string_view origin : ordered_origins) {
-    const UpdateInterestGroupList& updates = update_groups.at(origin);
-
-    ScopedCbor update_group_array(
-        cbor_new_definite_array(updates.interest_groups().size()));
+void CborSerializeUpdateGroups(const UpdateGroupMap& update_groups,
+                               CborWriter& writer) {
+  writer.WriteTextString(kUpdateGroups);
+  writer.StartMap();
+  for (const auto* entry : GetEntriesOrderedByKey(update_groups)) {
+    const auto& [origin, updates] = *entry;
+    writer.WriteTextString(origin);
+    writer.StartArray();
     for (const UpdateInterestGroup& update : updates.interest_groups()) {
-      ScopedCbor serialized_update_map(cbor_new_definite_map(2));
-      PS_RETURN_IF_ERROR(CborSerializeInt(kIndex, update.index(), error_handler,
-                                          **serialized_update_map));
-      PS_RETURN_IF_ERROR(CborSerializeInt(
-          kUpdateIfOlderThanMs, update.update_if_older_than_ms(), error_handler,
-          **serialized_update_map));
-      if (!cbor_array_push(*update_group_array, *serialized_update_map)) {
-        error_handler(grpc::Status(
-            grpc::INTERNAL, absl::StrCat("Failed to add interest group update "
-                                         "entry to array for owner: ",
-                                         origin)));
-        return absl::InternalError("");
-      }
-    }
-
-    struct cbor_pair owner_update_groups_entry = {
-        .key = cbor_move(cbor_build_stringn(origin.data(), origin.size())),
-        .value = *update_group_array};
-
-    if (!cbor_map_add(*serialized_group_map, owner_update_groups_entry)) {
-      error_handler(grpc::Status(
-          grpc::INTERNAL,
-          "Failed to serialize an <origin, update group array> pair to CBOR"));
-      return absl::InternalError("");
+      writer.StartMap();
+      CborSerializeInt(kIndex, update.index(), writer);
+      CborSerializeInt(kUpdateIfOlderThanMs, update.update_if_older_than_ms(),
+                       writer);
+      writer.EndMap();
     }
+    writer.EndArray();
   }
-
-  struct cbor_pair kv = {.key = cbor_move(cbor_build_stringn(
-                             kUpdateGroups, sizeof(kUpdateGroups) - 1)),
-                         .value = *serialized_group_map};
-  if (!cbor_map_add(&root, kv)) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL,
-        absl::StrCat("Failed to serialize ", kUpdateGroups, " to CBOR")));
-    return absl::InternalError("");
-  }
-  return absl::OkStatus();
+  writer.EndMap();
 }
 
-absl::Status CborSerializeBiddingGroups(const BiddingGroupMap& bidding_groups,
-                                        ErrorHandler error_handler,
-                                        cbor_item_t& root) {
-  ScopedCbor serialized_group_map(cbor_new_definite_map(bidding_groups.size()));
+void CborSerializeBiddingGroups(const BiddingGroupMap& bidding_groups,
+                                CborWriter& writer) {
+  writer.WriteTextString(kBiddingGroups);
+  writer.StartMap();
   // Order keys by length first and then lexicographically.
-  std::set<absl::string_view, decltype(kComparator)> ordered_origins(
-      kComparator);
-  // NOLINTNEXTLINE
-  for (const auto& [origin, unused] : bidding_groups) {
-    ordered_origins.insert(origin);
-  }
-  for (const auto& origin : ordered_origins) {
-    const auto& group_indices = bidding_groups.at(origin);
-    ScopedCbor serialized_group_indices(
-        cbor_new_definite_array(group_indices.index_size()));
+  for (const auto* entry : GetEntriesOrderedByKey(bidding_groups)) {
+    const auto& [origin, group_indices] = *entry;
+    writer.WriteTextString(origin);
+    writer.StartArray();
     for (int32_t index : group_indices.index()) {
-      if (!cbor_array_push(*serialized_group_indices,
-                           cbor_move(cbor_build_uint(index)))) {
-        error_handler(
-            grpc::Status(grpc::INTERNAL,
-                         "Failed to serialize a bidding group index to CBOR"));
-        return absl::InternalError("");
-      }
+      writer.WriteUint(static_cast<uint>(index));
     }
-    struct cbor_pair kv = {
-        .key = cbor_move(cbor_build_stringn(origin.data(), origin.size())),
-        .value = *serialized_group_indices};
-    if (!cbor_map_add(*serialized_group_map, kv)) {
-      error_handler(grpc::Status(
-          grpc::INTERNAL,
-          "Failed to serialize an <origin, bidding group array> pair to CBOR"));
-      return absl::InternalError("");
-    }
-  }
-  struct cbor_pair kv = {.key = cbor_move(cbor_build_stringn(
-                             kBiddingGroups, sizeof(kBiddingGroups) - 1)),
-                         .value = *serialized_group_map};
-  if (!cbor_map_add(&root, kv)) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL,
-        absl::StrCat("Failed to serialize ", kBiddingGroups, " to CBOR")));
-    return absl::InternalError("");
+    writer.EndArray();
   }
-  return absl::OkStatus();
+  writer.EndMap();
 }
 
-absl::Status CborSerializeInteractionReportingUrls(
-    const InteractionUrlMap& interaction_url_map, ErrorHandler error_handler,
-    cbor_item_t& root) {
-  ScopedCbor serialized_interaction_url_map(
-      cbor_new_definite_map(interaction_url_map.size()));
-  std::set<absl::string_view, decltype(kComparator)> ordered_events(
-      kComparator);
-  for (const auto& [event, unused] : interaction_url_map) {
-    ordered_events.insert(event);
-  }
-  for (const auto& event : ordered_events) {
-    PS_RETURN_IF_ERROR(AddKVToMap(event, interaction_url_map.at(event),
-                                  error_handler,
-                                  **serialized_interaction_url_map));
-  }
-  struct cbor_pair kv = {
-      .key = cbor_move(cbor_build_stringn(
-          kInteractionReportingUrls, sizeof(kInteractionReportingUrls) - 1)),
-      .value = *serialized_interaction_url_map};
-  if (!cbor_map_add(&root, kv)) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL, absl::StrCat("Failed to serialize ",
-                                     kInteractionReportingUrls, " to CBOR")));
-    return absl::InternalError("");
+void CborSerializeInteractionReportingUrls(
+    const InteractionUrlMap& interaction_url_map, CborWriter& writer) {
+  writer.WriteTextString(kInteractionReportingUrls);
+  writer.StartMap();
+  for (const auto* entry : GetEntriesOrderedByKey(interaction_url_map)) {
+    CborSerializeString(entry->first, entry->second, writer);
   }
-  return absl::OkStatus();
+  writer.EndMap();
 }
 
 absl::StatusOr<std::string> Encode(
@@ -1670,48 +1522,40 @@ absl::StatusOr<std::string> Encode(
     ErrorHandler error_handler, int per_adtech_paapi_contributions_limit,
     absl::string_view ad_auction_result_nonce,
     std::unique_ptr<KAnonAuctionResultData> kanon_auction_result_data) {
-  // CBOR data's root handle. When serializing the auction result to CBOR, we
-  // use this handle to keep the temporary data.
-  ScopedCbor cbor_data_root(cbor_new_definite_map(kNumAuctionResultKeys));
-  auto* cbor_internal = cbor_data_root.get();
-
+  CborWriter writer(kExpectedAuctionResultSize);
+  writer.StartMap();
   if (error) {
-    PS_RETURN_IF_ERROR(
-        CborSerializeError(*error, error_handler, *cbor_internal));
+    CborSerializeError(*error, writer);
     if (!ad_auction_result_nonce.empty()) {
       // "nonce" must be added after "error".
-      PS_RETURN_IF_ERROR(CborSerializeString(kAdAuctionResultNonce,
-                                             ad_auction_result_nonce,
-                                             error_handler, *cbor_internal));
+      CborSerializeString(kAdAuctionResultNonce, ad_auction_result_nonce,
+                          writer);
     }
   } else if (high_score) {
     PS_RETURN_IF_ERROR(CborSerializeScoreAdResponse(
         *high_score, bidding_group_map, update_group_map,
         adtech_origin_debug_urls_map, per_adtech_paapi_contributions_limit,
-        ad_auction_result_nonce, std::move(kanon_auction_result_data),
-        error_handler, *cbor_internal));
+        ad_auction_result_nonce, kanon_auction_result_data.get(), error_handler,
+        writer));
   } else if (kanon_auction_result_data != nullptr &&
              kanon_auction_result_data->kanon_ghost_winners != nullptr) {
     // "nonce" must be added before "kAnonGhostWinners".
     if (!ad_auction_result_nonce.empty()) {
-      PS_RETURN_IF_ERROR(CborSerializeString(kAdAuctionResultNonce,
-                                             ad_auction_result_nonce,
-                                             error_handler, *cbor_internal));
+      CborSerializeString(kAdAuctionResultNonce, ad_auction_result_nonce,
+                          writer);
     }
     PS_RETURN_IF_ERROR(CborSerializeKAnonGhostWinners(
         kKAnonGhostWinners, *kanon_auction_result_data->kanon_ghost_winners,
-        error_handler, *cbor_internal));
+        error_handler, writer));
   } else {
     if (!ad_auction_result_nonce.empty()) {
-      PS_RETURN_IF_ERROR(CborSerializeString(kAdAuctionResultNonce,
-                                             ad_auction_result_nonce,
-                                             error_handler, *cbor_internal));
+      CborSerializeString(kAdAuctionResultNonce, ad_auction_result_nonce,
+                          writer);
     }
-    PS_RETURN_IF_ERROR(
-        CborSerializeBool(kChaff, true, error_handler, *cbor_internal));
+    CborSerializeBool(kChaff, true, writer);
   }
-
-  return GetCborSerializedAuctionResult(error_handler, *cbor_internal);
+  writer.EndMap();
+  return std::move(writer).Release();
 }
 
 absl::StatusOr<std::string> EncodeComponent(
@@ -1723,48 +1567,40 @@ absl::StatusOr<std::string> EncodeComponent(
     const std::optional<AuctionResult::Error>& error,
     ErrorHandler error_handler, absl::string_view ad_auction_result_nonce,
     std::unique_ptr<KAnonAuctionResultData> kanon_auction_result_data) {
-  // CBOR data's root handle. When serializing the auction result to CBOR, we
-  // use this handle to keep the temporary data.
-  ScopedCbor cbor_data_root(cbor_new_definite_map(kNumAuctionResultKeys));
-  auto* cbor_internal = cbor_data_root.get();
-
+  CborWriter writer(kExpectedAuctionResultSize);
+  writer.StartMap();
   if (error) {
-    PS_RETURN_IF_ERROR(
-        CborSerializeError(*error, error_handler, *cbor_internal));
+    CborSerializeError(*error, writer);
     // "nonce" added after "error".
     if (!ad_auction_result_nonce.empty()) {
-      PS_RETURN_IF_ERROR(CborSerializeString(kAdAuctionResultNonce,
-                                             ad_auction_result_nonce,
-                                             error_handler, *cbor_internal));
+      CborSerializeString(kAdAuctionResultNonce, ad_auction_result_nonce,
+                          writer);
     }
   } else if (high_score) {
     PS_RETURN_IF_ERROR(CborSerializeComponentScoreAdResponse(
         top_level_seller, *high_score, bidding_group_map, update_group_map,
         adtech_origin_debug_urls_map, ad_auction_result_nonce,
-        std::move(kanon_auction_result_data), error_handler, *cbor_internal));
+        kanon_auction_result_data.get(), error_handler, writer));
   } else if (kanon_auction_result_data != nullptr &&
              kanon_auction_result_data->kanon_ghost_winners != nullptr) {
     // "nonce" must be added before "kAnonGhostWinners".
     if (!ad_auction_result_nonce.empty()) {
-      PS_RETURN_IF_ERROR(CborSerializeString(kAdAuctionResultNonce,
-                                             ad_auction_result_nonce,
-                                             error_handler, *cbor_internal));
+      CborSerializeString(kAdAuctionResultNonce, ad_auction_result_nonce,
+                          writer);
     }
     PS_RETURN_IF_ERROR(CborSerializeKAnonGhostWinners(
         kKAnonGhostWinners, *kanon_auction_result_data->kanon_ghost_winners,
-        error_handler, *cbor_internal));
+        error_handler, writer));
   } else {
     // "nonce" must be added before "isChaff".
     if (!ad_auction_result_nonce.empty()) {
-      PS_RETURN_IF_ERROR(CborSerializeString(kAdAuctionResultNonce,
-                                             ad_auction_result_nonce,
-                                             error_handler, *cbor_internal));
+      CborSerializeString(kAdAuctionResultNonce, ad_auction_result_nonce,
+                          writer);
     }
-    PS_RETURN_IF_ERROR(
-        CborSerializeBool(kChaff, true, error_handler, *cbor_internal));
+    CborSerializeBool(kChaff, true, writer);
   }
-
-  return GetCborSerializedAuctionResult(error_handler, *cbor_internal);
+  writer.EndMap();
+  return std::move(writer).Release();
 }
 
 DecodedBuyerInputs DecodeBuyerInputs(
@@ -1786,8 +1622,6 @@ BuyerInputForBidding DecodeBuyerInput(absl::string_view owner,
                                       absl::string_view compressed_buyer_input,
                                       ErrorAccumulator& error_accumulator,
                                       bool fail_fast) {
-  BuyerInputForBidding buyer_input_for_bidding;
-
   const absl::StatusOr<std::string> decompressed_buyer_input =
       GzipDecompress(compressed_buyer_input);
   if (!decompressed_buyer_input.ok()) {
@@ -1795,13 +1629,42 @@ BuyerInputForBidding DecodeBuyerInput(absl::string_view owner,
         ErrorVisibility::CLIENT_VISIBLE,
         absl::StrFormat(kMalformedCompressedIgError, owner),
         ErrorCode::CLIENT_SIDE);
-    return buyer_input_for_bidding;
+    return BuyerInputForBidding();
+  }
+
+  absl::StatusOr<BuyerInputForBidding> buyer_input_for_bidding =
+      StreamingDecodeBuyerInput(*decompressed_buyer_input);
+  if (buyer_input_for_bidding.ok()) {
+    return *std::move(buyer_input_for_bidding);
   }
 
+  PS_VLOG(5) << "Streaming decode of BuyerInput for " << owner
+             << " failed, falling back to libcbor: "
+             << buyer_input_for_bidding.status();
+  return CborTreeDecodeBuyerInput(owner, *decompressed_buyer_input,
+                                  error_accumulator, fail_fast);
+}
+
+absl::StatusOr<BuyerInputForBidding> StreamingDecodeBuyerInput(
+    absl::string_view encoded_buyer_input) {
+  BuyerInputForBidding buyer_input_for_bidding;
+  CborReader reader(encoded_buyer_input);
+  PS_ASSIGN_OR_RETURN(uint64_t num_interest_groups, reader.ReadArrayHeader());
+  for (uint64_t i = 0; i < num_interest_groups; ++i) {
+    PS_RETURN_IF_ERROR(
+        StreamingDecodeInterestGroup(reader, buyer_input_for_bidding));
+  }
+  return buyer_input_for_bidding;
+}
+
+BuyerInputForBidding CborTreeDecodeBuyerInput(
+    absl::string_view owner, absl::string_view encoded_buyer_input,
+    ErrorAccumulator& error_accumulator, bool fail_fast) {
+  BuyerInputForBidding buyer_input_for_bidding;
   cbor_load_result result;
   ScopedCbor root(cbor_load(
-      reinterpret_cast<const unsigned char*>(decompressed_buyer_input->data()),
-      decompressed_buyer_input->size(), &result));
+      reinterpret_cast<const unsigned char*>(encoded_buyer_input.data()),
+      encoded_buyer_input.size(), &result));
 
   if (result.error.code != CBOR_ERR_NONE) {
     error_accumulator.ReportError(
@@ -1952,84 +1815,50 @@ BuyerInputForBidding DecodeBuyerInput(absl::string_view owner,
   return buyer_input_for_bidding;
 }
 
-absl::Status CborSerializeReportingUrls(
+void CborSerializeReportingUrls(
     absl::string_view key,
     const WinReportingUrls::ReportingUrls& reporting_urls,
-    ErrorHandler error_handler, cbor_item_t& root) {
-  int key_count = 0;
-  if (!reporting_urls.reporting_url().empty()) {
-    key_count++;
-  }
-  if (!reporting_urls.interaction_reporting_urls().empty()) {
-    key_count++;
+    CborWriter& writer) {
+  if (reporting_urls.reporting_url().empty() &&
+      reporting_urls.interaction_reporting_urls().empty()) {
+    return;
   }
-  if (key_count == 0) {
-    return absl::OkStatus();
-  }
-  ScopedCbor serialized_reporting_urls(
-      cbor_new_definite_map(kNumReportingUrlsKeys));
+  writer.WriteTextString(key);
+  writer.StartMap();
   if (!reporting_urls.reporting_url().empty()) {
-    PS_RETURN_IF_ERROR(AddKVToMap(kReportingUrl, reporting_urls.reporting_url(),
-                                  error_handler, **serialized_reporting_urls));
+    CborSerializeString(kReportingUrl, reporting_urls.reporting_url(), writer);
   }
   if (!reporting_urls.interaction_reporting_urls().empty()) {
-    PS_RETURN_IF_ERROR(CborSerializeInteractionReportingUrls(
-        reporting_urls.interaction_reporting_urls(), error_handler,
-        **serialized_reporting_urls));
-  }
-  struct cbor_pair serialized_reporting_urls_kv = {
-      .key = cbor_move(cbor_build_stringn(key.data(), key.size())),
-      .value = *serialized_reporting_urls,
-  };
-
-  if (!cbor_map_add(&root, serialized_reporting_urls_kv)) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL, absl::StrCat("Failed to serialize ", key, " to CBOR")));
-    return absl::InternalError("");
+    CborSerializeInteractionReportingUrls(
+        reporting_urls.interaction_reporting_urls(), writer);
   }
-
-  return absl::OkStatus();
+  writer.EndMap();
 }
 
-absl::Status CborSerializeWinReportingUrls(
-    const WinReportingUrls& win_reporting_urls, ErrorHandler error_handler,
-    cbor_item_t& root) {
+void CborSerializeWinReportingUrls(const WinReportingUrls& win_reporting_urls,
+                                   CborWriter& writer) {
   if (!win_reporting_urls.has_buyer_reporting_urls() &&
       !win_reporting_urls.has_top_level_seller_reporting_urls()) {
-    return absl::OkStatus();
+    return;
   }
-  ScopedCbor serialized_win_reporting_urls(
-      cbor_new_definite_map(kNumWinReportingUrlsKeys));
+  writer.WriteTextString(kWinReportingUrls);
+  writer.StartMap();
   if (win_reporting_urls.has_buyer_reporting_urls()) {
-    PS_RETURN_IF_ERROR(CborSerializeReportingUrls(
-        kBuyerReportingUrls, win_reporting_urls.buyer_reporting_urls(),
-        error_handler, **serialized_win_reporting_urls));
+    CborSerializeReportingUrls(kBuyerReportingUrls,
+                               win_reporting_urls.buyer_reporting_urls(),
+                               writer);
   }
   if (win_reporting_urls.has_top_level_seller_reporting_urls()) {
-    PS_RETURN_IF_ERROR(CborSerializeReportingUrls(
+    CborSerializeReportingUrls(
         kTopLevelSellerReportingUrls,
-        win_reporting_urls.top_level_seller_reporting_urls(), error_handler,
-        **serialized_win_reporting_urls));
+        win_reporting_urls.top_level_seller_reporting_urls(), writer);
   }
   if (win_reporting_urls.has_component_seller_reporting_urls()) {
-    PS_RETURN_IF_ERROR(CborSerializeReportingUrls(
+    CborSerializeReportingUrls(
         kComponentSellerReportingUrls,
-        win_reporting_urls.component_seller_reporting_urls(), error_handler,
-        **serialized_win_reporting_urls));
-  }
-  struct cbor_pair serialized_win_reporting_urls_kv = {
-      .key = cbor_move(
-          cbor_build_stringn(kWinReportingUrls, sizeof(kWinReportingUrls) - 1)),
-      .value = *serialized_win_reporting_urls,
-  };
-  if (!cbor_map_add(&root, serialized_win_reporting_urls_kv)) {
-    error_handler(grpc::Status(
-        grpc::INTERNAL,
-        absl::StrCat("Failed to serialize ", kWinReportingUrls, " to CBOR")));
-    return absl::InternalError("");
+        win_reporting_urls.component_seller_reporting_urls(), writer);
   }
-
-  return absl::OkStatus();
+  writer.EndMap();
 }
 
 absl::StatusOr<AuctionResult> CborDecodeAuctionResultToProto(
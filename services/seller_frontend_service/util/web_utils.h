@@ -29,12 +29,16 @@
 #include "absl/strings/str_format.h"
 #include "api/bidding_auction_servers.grpc.pb.h"
 #include "api/bidding_auction_servers.pb.h"
+#include "services/common/util/cbor_reader.h"
+#include "services/common/util/cbor_writer.h"
 #include "services/common/util/data_util.h"
 #include "services/common/util/error_accumulator.h"
 #include "services/common/util/request_response_constants.h"
 #include "services/common/util/scoped_cbor.h"
 #include "services/seller_frontend_service/data/k_anon.h"
 #include "services/seller_frontend_service/util/cbor_common_util.h"
+#include "src/logger/request_context_logger.h"
+#include "src/util/status_macro/status_macros.h"
 
 #include "cbor.h"
 
@@ -138,7 +142,8 @@ inline constexpr auto kComparator = [](absl::string_view a,
   }
 
 // Encodes the data into a CBOR-serialized AuctionResult response for single
-// seller auction.
+// seller auction. The response is written directly into a single buffer
+// without building a libcbor item tree first.
 absl::StatusOr<std::string> Encode(
     const std::optional<ScoreAdsResponse::AdScore>& high_score,
     const ::google::protobuf::Map<
@@ -319,12 +324,114 @@ T DecodeProtectedAuctionInput(cbor_item_t* root,
   return output;
 }
 
-// Decodes CBOR-encoded ProtectedAudienceInput. Note that this method doesn't
-// decompress and decodes the BuyerInput values in the buyer input map. Any
-// errors are reported to `error_accumulator`.
+// Streaming counterpart of `DecodeBuyerInputKeys`: reads the owner =>
+// BuyerInput map at the reader's position into `encoded_buyer_inputs`. Returns
+// an error for any input that `DecodeBuyerInputKeys` wouldn't accept as-is.
+absl::Status StreamingDecodeBuyerInputKeys(
+    CborReader& reader,
+    ::google::protobuf::Map<std::string, std::string>& encoded_buyer_inputs);
+
+// Streaming counterpart of `DecodeConsentedDebugConfig`. Returns an error for
+// any input that `DecodeConsentedDebugConfig` wouldn't accept as-is.
+absl::Status StreamingDecodeConsentedDebugConfig(
+    CborReader& reader,
+    server_common::ConsentedDebugConfiguration& consented_debug_config);
+
+// Decodes CBOR-encoded ProtectedAudienceInput in a single pass over the
+// payload, without building a libcbor item tree. The decoder is strict: it
+// returns an error for anything that the libcbor based decoder would report
+// as an error (or can't be read without one, e.g. indefinite-length items),
+// in which case the caller is expected to fall back to `CborTreeDecode`,
+// which produces the client facing errors. Note: this should not be used
+// directly and is only here to facilitate testing.
 template <typename T>
-T Decode(absl::string_view cbor_payload, ErrorAccumulator& error_accumulator,
-         bool fail_fast = true) {
+absl::StatusOr<T> StreamingDecodeProtectedAuctionInput(
+    absl::string_view cbor_payload) {
+  T output;
+  output.set_enable_debug_reporting(true);  // Default value if not present.
+
+  CborReader reader(cbor_payload);
+  PS_ASSIGN_OR_RETURN(uint64_t num_entries, reader.ReadMapHeader());
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    PS_ASSIGN_OR_RETURN(absl::string_view key, reader.ReadTextString());
+    switch (FindItemIndex(kRequestRootKeys, key)) {
+      case 0: {  // Schema version.
+        PS_ASSIGN_OR_RETURN(uint64_t version, reader.ReadInt());
+        // Only support version 0 schemas for now.
+        if (version != 0) {
+          return absl::InvalidArgumentError("Unsupported schema version");
+        }
+        break;
+      }
+      case 1: {  // Publisher.
+        PS_ASSIGN_OR_RETURN(absl::string_view publisher,
+                            reader.ReadTextString());
+        output.set_publisher_name(publisher.data(), publisher.size());
+        break;
+      }
+      case 2: {  // Interest groups.
+        output.clear_buyer_input();
+        PS_RETURN_IF_ERROR(StreamingDecodeBuyerInputKeys(
+            reader, *output.mutable_buyer_input()));
+        break;
+      }
+      case 3: {  // Generation Id.
+        PS_ASSIGN_OR_RETURN(absl::string_view generation_id,
+                            reader.ReadTextString());
+        output.set_generation_id(generation_id.data(), generation_id.size());
+        break;
+      }
+      case 4: {  // Enable Debug Reporting.
+        PS_ASSIGN_OR_RETURN(bool enable_debug_reporting, reader.ReadBool());
+        output.set_enable_debug_reporting(enable_debug_reporting);
+        break;
+      }
+      case 5: {  // Consented Debug Config.
+        output.clear_consented_debug_config();
+        PS_RETURN_IF_ERROR(StreamingDecodeConsentedDebugConfig(
+            reader, *output.mutable_consented_debug_config()));
+        break;
+      }
+      case 6: {  // Request timestamp ms.
+        PS_ASSIGN_OR_RETURN(uint64_t request_timestamp_ms, reader.ReadInt());
+        output.set_request_timestamp_ms(request_timestamp_ms);
+        break;
+      }
+      case 7: {  // Enforce k-Anon.
+        PS_ASSIGN_OR_RETURN(bool enforce_kanon, reader.ReadBool());
+        output.set_enforce_kanon(enforce_kanon);
+        break;
+      }
+      case 8: {  // Enable Sampled Debug Reporting.
+        PS_ASSIGN_OR_RETURN(bool enable_sampled_debug_reporting,
+                            reader.ReadBool());
+        if (enable_sampled_debug_reporting) {
+          output.mutable_fdo_flags()->set_enable_sampled_debug_reporting(true);
+        }
+        break;
+      }
+      case 9: {  // Seller in Cooldown or Lockout.
+        PS_ASSIGN_OR_RETURN(bool in_cooldown_or_lockout, reader.ReadBool());
+        if (in_cooldown_or_lockout) {
+          output.mutable_fdo_flags()->set_in_cooldown_or_lockout(true);
+        }
+        break;
+      }
+      default:
+        PS_RETURN_IF_ERROR(reader.SkipItem());
+        break;
+    }
+  }
+
+  return output;
+}
+
+// Decodes CBOR-encoded ProtectedAudienceInput by loading it into a libcbor item
+// tree. Any errors are reported to `error_accumulator`. Note: this should not
+// be used directly and is only here to facilitate testing.
+template <typename T>
+T CborTreeDecode(absl::string_view cbor_payload,
+                 ErrorAccumulator& error_accumulator, bool fail_fast = true) {
   T protected_auction_input;
   cbor_load_result result;
   ScopedCbor root(
@@ -342,20 +449,40 @@ T Decode(absl::string_view cbor_payload, ErrorAccumulator& error_accumulator,
   return DecodeProtectedAuctionInput<T>(*root, error_accumulator, fail_fast);
 }
 
+// Decodes CBOR-encoded ProtectedAudienceInput. Note that this method doesn't
+// decompress and decodes the BuyerInput values in the buyer input map. Any
+// errors are reported to `error_accumulator`.
+//
+// Well-formed payloads are decoded in a single streaming pass; everything else
+// is handed to the libcbor based decoder so that clients get the same errors.
+template <typename T>
+T Decode(absl::string_view cbor_payload, ErrorAccumulator& error_accumulator,
+         bool fail_fast = true) {
+  absl::StatusOr<T> decoded =
+      StreamingDecodeProtectedAuctionInput<T>(cbor_payload);
+  if (decoded.ok()) {
+    return *std::move(decoded);
+  }
+
+  PS_VLOG(5) << "Streaming decode of ProtectedAuctionInput failed, falling "
+                "back to libcbor: "
+             << decoded.status();
+  return CborTreeDecode<T>(cbor_payload, error_accumulator, fail_fast);
+}
+
 // Serializes the adtech origin => debug reports map to CBOR. Note: this should
 // not be used directly and is only here to facilitate testing.
-absl::Status CborSerializeDebugReports(
+void CborSerializeDebugReports(
     const AdtechOriginDebugUrlsMap& adtech_origin_debug_urls_map,
-    ErrorHandler error_handler, cbor_item_t& root);
+    CborWriter& writer);
 
 // Serializes the bidding groups (buyer origin => interest group indices map)
 // to CBOR. Note: this should not be used directly and is only here to
 // facilitate testing.
-absl::Status CborSerializeBiddingGroups(
+void CborSerializeBiddingGroups(
     const google::protobuf::Map<std::string, AuctionResult::InterestGroupIndex>&
         bidding_groups,
-    const std::function<void(const grpc::Status&)>& error_handler,
-    cbor_item_t& root);
+    CborWriter& writer);
 
 // Serializes the interest groups groups to CBOR. This structure is represented
 // by the following CDDL:
@@ -367,10 +494,8 @@ absl::Status CborSerializeBiddingGroups(
 // }
 // Note: this should not be used directly and is only here to
 // facilitate testing.
-absl::Status CborSerializeUpdateGroups(
-    const UpdateGroupMap& update_groups,
-    const std::function<void(const grpc::Status&)>& error_handler,
-    cbor_item_t& root);
+void CborSerializeUpdateGroups(const UpdateGroupMap& update_groups,
+                               CborWriter& writer);
 
 // Decodes the decompressed but CBOR encoded BuyerInput map to a mapping from
 // owner => BuyerInput. Errors are reported to `error_accumulator`.
@@ -385,6 +510,21 @@ BuyerInputForBidding DecodeBuyerInput(absl::string_view owner,
                                       ErrorAccumulator& error_accumulator,
                                       bool fail_fast = true);
 
+// Decodes the decompressed, CBOR encoded BuyerInput in a single pass without
+// building a libcbor item tree. Like `StreamingDecodeProtectedAuctionInput`,
+// this returns an error for any input that `CborTreeDecodeBuyerInput` would
+// report errors for. Note: this should not be used directly and is only here
+// to facilitate testing.
+absl::StatusOr<BuyerInputForBidding> StreamingDecodeBuyerInput(
+    absl::string_view encoded_buyer_input);
+
+// Decodes the decompressed, CBOR encoded BuyerInput by loading it into a
+// libcbor item tree. Errors are reported to `error_accumulator`. Note: this
+// should not be used directly and is only here to facilitate testing.
+BuyerInputForBidding CborTreeDecodeBuyerInput(
+    absl::string_view owner, absl::string_view encoded_buyer_input,
+    ErrorAccumulator& error_accumulator, bool fail_fast = true);
+
 // Minimally encodes an unsigned int into CBOR. Caller is responsible for
 // decrementing the reference once done with the returned int.
 cbor_item_t* cbor_build_uint(uint input);
@@ -398,10 +538,8 @@ cbor_item_t* cbor_build_int(int input);
 absl::StatusOr<cbor_item_t*> cbor_build_float(double input);
 
 // Serializes WinReportingUrls for buyer and seller.
-absl::Status CborSerializeWinReportingUrls(
-    const WinReportingUrls& win_reporting_urls,
-    const std::function<void(const grpc::Status&)>& error_handler,
-    cbor_item_t& root);
+void CborSerializeWinReportingUrls(const WinReportingUrls& win_reporting_urls,
+                                   CborWriter& writer);
 
 inline constexpr std::array<std::string_view, kNumAuctionResultKeys>
     kAuctionResultKeys = {
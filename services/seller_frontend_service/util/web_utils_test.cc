@@ -41,6 +41,7 @@
 #include "services/seller_frontend_service/test/kanon_test_utils.h"
 #include "services/seller_frontend_service/util/buyer_input_proto_utils.h"
 #include "services/seller_frontend_service/util/cbor_common_util.h"
+#include "services/seller_frontend_service/util/cbor_tree_encode.h"
 #include "src/core/test/utils/proto_test_utils.h"
 
 #include "cbor.h"
@@ -603,6 +604,119 @@ TEST(ChromeRequestUtils, Decode_FailOnMalformedCompresedBytestring) {
       kMalformedCompressedBytestring));
 }
 
+ScopedCbor BuildSampleProtectedAuctionInput() {
+  ScopedCbor protected_auction_input(cbor_new_definite_map(6));
+  EXPECT_TRUE(cbor_map_add(*protected_auction_input,
+                           BuildIntMapPair(kVersion, 0)));
+  EXPECT_TRUE(cbor_map_add(*protected_auction_input,
+                           BuildStringMapPair(kPublisher, kSamplePublisher)));
+  EXPECT_TRUE(
+      cbor_map_add(*protected_auction_input,
+                   BuildStringMapPair(kGenerationId, kSampleGenerationId)));
+  EXPECT_TRUE(
+      cbor_map_add(*protected_auction_input,
+                   BuildIntMapPair(kRequestTimestampMs, kSampleRequestMs)));
+  EXPECT_TRUE(
+      cbor_map_add(*protected_auction_input,
+                   BuildBoolMapPair(kEnforceKAnon, kSampleEnforceKAnon)));
+
+  ScopedCbor ig_array(cbor_new_definite_array(1));
+  EXPECT_TRUE(cbor_array_push(*ig_array, BuildSampleCborInterestGroup()));
+  cbor_item_t* interest_group_data_map = cbor_new_definite_map(1);
+  EXPECT_TRUE(cbor_map_add(interest_group_data_map,
+                           {cbor_move(cbor_build_stringn(
+                                kSampleIgOwner, sizeof(kSampleIgOwner) - 1)),
+                            cbor_move(CompressInterestGroups(ig_array))}));
+  EXPECT_TRUE(cbor_map_add(*protected_auction_input,
+                           {cbor_move(cbor_build_stringn(
+                                kInterestGroups, sizeof(kInterestGroups) - 1)),
+                            cbor_move(interest_group_data_map)}));
+  return protected_auction_input;
+}
+
+TEST(ChromeRequestUtils, StreamingDecodeMatchesCborTreeDecode) {
+  std::string serialized_cbor =
+      SerializeCbor(*BuildSampleProtectedAuctionInput());
+
+  absl::StatusOr<ProtectedAuctionInput> streamed =
+      StreamingDecodeProtectedAuctionInput<ProtectedAuctionInput>(
+          serialized_cbor);
+  ASSERT_TRUE(streamed.ok()) << streamed.status();
+
+  ErrorAccumulator error_accumulator(&log_context);
+  ProtectedAuctionInput expected =
+      CborTreeDecode<ProtectedAuctionInput>(serialized_cbor, error_accumulator);
+  ASSERT_FALSE(error_accumulator.HasErrors());
+  EXPECT_THAT(*streamed, EqualsProto(expected));
+}
+
+TEST(ChromeRequestUtils, StreamingDecodeBuyerInputMatchesCborTreeDecode) {
+  ScopedCbor ig_array(cbor_new_definite_array(2));
+  EXPECT_TRUE(cbor_array_push(
+      *ig_array, BuildSampleCborInterestGroup({.recency = kSampleRecency})));
+  EXPECT_TRUE(cbor_array_push(
+      *ig_array,
+      BuildSampleCborInterestGroup({.recency_ms = kSampleRecencyMs})));
+  std::string serialized_cbor = SerializeCbor(*ig_array);
+
+  absl::StatusOr<BuyerInputForBidding> streamed =
+      StreamingDecodeBuyerInput(serialized_cbor);
+  ASSERT_TRUE(streamed.ok()) << streamed.status();
+
+  ErrorAccumulator error_accumulator(&log_context);
+  BuyerInputForBidding expected = CborTreeDecodeBuyerInput(
+      kSampleIgOwner, serialized_cbor, error_accumulator);
+  ASSERT_FALSE(error_accumulator.HasErrors());
+  EXPECT_THAT(*streamed, EqualsProto(expected));
+  ASSERT_EQ(streamed->interest_groups_size(), 2);
+  EXPECT_EQ(streamed->interest_groups(0).browser_signals().prev_wins(),
+            absl::StrFormat(R"([[-20,"%s"],[-100,"%s"]])", kSampleAdRenderId1,
+                            kSampleAdRenderId2));
+  EXPECT_EQ(streamed->interest_groups(0).browser_signals().prev_wins_ms(),
+            absl::StrFormat(R"([[-20000,"%s"],[-100000,"%s"]])",
+                            kSampleAdRenderId1, kSampleAdRenderId2));
+}
+
+TEST(ChromeRequestUtils, StreamingDecodeSkipsUnknownKeys) {
+  ScopedCbor protected_auction_input = BuildSampleProtectedAuctionInput();
+  cbor_item_t* unknown_value = cbor_new_definite_map(1);
+  EXPECT_TRUE(cbor_map_add(unknown_value, BuildStringArrayMapPair(
+                                              "nested", {"a", "b", "c"})));
+  EXPECT_TRUE(cbor_map_add(*protected_auction_input,
+                           {cbor_move(cbor_build_string("unknownKey")),
+                            cbor_move(unknown_value)}));
+  std::string serialized_cbor = SerializeCbor(*protected_auction_input);
+
+  absl::StatusOr<ProtectedAuctionInput> streamed =
+      StreamingDecodeProtectedAuctionInput<ProtectedAuctionInput>(
+          serialized_cbor);
+  ASSERT_TRUE(streamed.ok()) << streamed.status();
+
+  ErrorAccumulator error_accumulator(&log_context);
+  EXPECT_THAT(*streamed, EqualsProto(CborTreeDecode<ProtectedAuctionInput>(
+                             serialized_cbor, error_accumulator)));
+  EXPECT_FALSE(error_accumulator.HasErrors());
+}
+
+TEST(ChromeRequestUtils, StreamingDecodeRejectsInputsWithErrors) {
+  ScopedCbor unsupported_version(cbor_new_definite_map(1));
+  EXPECT_TRUE(
+      cbor_map_add(*unsupported_version, BuildIntMapPair(kVersion, 999)));
+  EXPECT_FALSE(StreamingDecodeProtectedAuctionInput<ProtectedAuctionInput>(
+                   SerializeCbor(*unsupported_version))
+                   .ok());
+
+  ScopedCbor wrong_type(cbor_new_definite_map(1));
+  EXPECT_TRUE(
+      cbor_map_add(*wrong_type, BuildIntMapPair(kGenerationId, 1)));
+  EXPECT_FALSE(StreamingDecodeProtectedAuctionInput<ProtectedAuctionInput>(
+                   SerializeCbor(*wrong_type))
+                   .ok());
+
+  ScopedCbor not_an_array(cbor_build_string("string"));
+  EXPECT_FALSE(StreamingDecodeBuyerInput(SerializeCbor(*not_an_array)).ok());
+}
+
 TEST(ChromeResponseUtils, VerifyBiddingGroupBuyerOriginOrdering) {
   google::protobuf::Map<std::string, AuctionResult::InterestGroupIndex>
       bidding_group_map = GetTestBiddingGroupMap();
@@ -1525,6 +1639,119 @@ TEST(ChromeResponseUtils, EncodesKAnonData) {
   EXPECT_THAT(*decoded_result, EqualsProto(expected));
 }
 
+std::unique_ptr<KAnonAuctionResultData> GetTestKAnonAuctionResultData() {
+  return SampleKAnonAuctionResultData(
+      {.ig_index = kSampleIgIndex,
+       .ig_owner = kSampleIgOwner,
+       .ig_name = kSampleIgName,
+       .bucket_name =
+           std::vector<uint8_t>(kSampleBucket.begin(), kSampleBucket.end()),
+       .bucket_value = kSampleValue,
+       .ad_render_url = kSampleAdRenderUrl,
+       .ad_component_render_url = kSampleAdComponentRenderUrl,
+       .modified_bid = kSampleModifiedBid,
+       .bid_currency = kSampleBidCurrency,
+       .ad_metadata = kSampleAdMetadata,
+       .buyer_reporting_id = kSampleBuyerReportingId,
+       .buyer_and_seller_reporting_id = kSampleBuyerAndSellerReportingId,
+       .selected_buyer_and_seller_reporting_id =
+           kSampleSelectedBuyerAndSellerReportingId,
+       .ad_render_url_hash = std::vector<uint8_t>(
+           kSampleAdRenderUrlHash.begin(), kSampleAdRenderUrlHash.end()),
+       .ad_component_render_urls_hash =
+           std::vector<uint8_t>(kSampleAdComponentRenderUrlsHash.begin(),
+                                kSampleAdComponentRenderUrlsHash.end()),
+       .reporting_id_hash = std::vector<uint8_t>(
+           kSampleReportingIdHash.begin(), kSampleReportingIdHash.end()),
+       .winner_positional_index = kSampleWinnerPositionalIndex});
+}
+
+TEST(ChromeResponseUtils, EncodeMatchesCborTreeEncode) {
+  ScoreAdsResponse::AdScore winner = GetTestAdScore();
+  winner.add_component_renders("https://buyer-adtech.com/component-1");
+  winner.add_component_renders("https://buyer-adtech.com/component-2");
+  winner.set_buyer_reporting_id("buyerReportingId");
+  *winner.mutable_top_level_contributions() =
+      GetTestPrivateAggregateReportingResponses();
+  // Contributions without a bucket are dropped by both encoders.
+  winner.mutable_top_level_contributions(0)
+      ->mutable_contributions(0)
+      ->clear_bucket();
+  AuctionResult::Error client_error;
+  client_error.set_code(kSampleErrorCode);
+  client_error.set_message(kSampleErrorMessage);
+
+  struct TestCase {
+    std::optional<ScoreAdsResponse::AdScore> high_score;
+    std::optional<AuctionResult::Error> error;
+    bool with_kanon_data;
+  };
+  std::vector<TestCase> test_cases = {
+      {winner, std::nullopt, /*with_kanon_data=*/false},
+      {winner, std::nullopt, /*with_kanon_data=*/true},
+      {std::nullopt, client_error, /*with_kanon_data=*/false},
+      // Ghost winners only.
+      {std::nullopt, std::nullopt, /*with_kanon_data=*/true},
+      // Chaff.
+      {std::nullopt, std::nullopt, /*with_kanon_data=*/false},
+  };
+  for (const auto& [high_score, error, with_kanon_data] : test_cases) {
+    for (absl::string_view nonce : {"", kSampleAdAuctionResultNonce}) {
+      auto encoded = Encode(
+          high_score, GetTestBiddingGroupMap(), GetTestUpdateGroupMap(),
+          GetTestAdtechOriginDebugUrlsMapForSampledAuction(), error,
+          [](const grpc::Status& status) {},
+          /*per_adtech_paapi_contributions_limit=*/100, nonce,
+          with_kanon_data ? GetTestKAnonAuctionResultData() : nullptr);
+      auto expected = CborTreeEncode(
+          high_score, GetTestBiddingGroupMap(), GetTestUpdateGroupMap(),
+          GetTestAdtechOriginDebugUrlsMapForSampledAuction(), error,
+          [](const grpc::Status& status) {},
+          /*per_adtech_paapi_contributions_limit=*/100, nonce,
+          with_kanon_data ? GetTestKAnonAuctionResultData() : nullptr);
+      ASSERT_TRUE(encoded.ok()) << encoded.status();
+      ASSERT_TRUE(expected.ok()) << expected.status();
+      EXPECT_EQ(absl::BytesToHexString(*encoded),
+                absl::BytesToHexString(*expected));
+    }
+  }
+}
+
+TEST(ChromeResponseUtils, EncodeComponentMatchesCborTreeEncodeComponent) {
+  ScoreAdsResponse::AdScore winner = GetTestComponentAdScore();
+  winner.add_component_renders("https://buyer-adtech.com/component-1");
+  for (bool with_kanon_data : {false, true}) {
+    auto encoded = EncodeComponent(
+        kTestTopLevelSellerOrigin, winner, GetTestBiddingGroupMap(),
+        GetTestUpdateGroupMap(),
+        GetTestAdtechOriginDebugUrlsMapForComponentAuction(),
+        /*error=*/std::nullopt, [](const grpc::Status& status) {},
+        kSampleAdAuctionResultNonce,
+        with_kanon_data ? GetTestKAnonAuctionResultData() : nullptr);
+    auto expected = CborTreeEncodeComponent(
+        kTestTopLevelSellerOrigin, winner, GetTestBiddingGroupMap(),
+        GetTestUpdateGroupMap(),
+        GetTestAdtechOriginDebugUrlsMapForComponentAuction(),
+        /*error=*/std::nullopt, [](const grpc::Status& status) {},
+        kSampleAdAuctionResultNonce,
+        with_kanon_data ? GetTestKAnonAuctionResultData() : nullptr);
+    ASSERT_TRUE(encoded.ok()) << encoded.status();
+    ASSERT_TRUE(expected.ok()) << expected.status();
+    EXPECT_EQ(absl::BytesToHexString(*encoded),
+              absl::BytesToHexString(*expected));
+  }
+}
+
+TEST(ChromeResponseUtils, EncodeComponentRejectsNonPositiveBids) {
+  ScoreAdsResponse::AdScore winner = GetTestComponentAdScore();
+  winner.set_bid(0);
+  auto encoded = EncodeComponent(
+      kTestTopLevelSellerOrigin, winner, /*bidding_group_map=*/{},
+      /*update_group_map=*/{}, /*adtech_origin_debug_urls_map=*/{},
+      /*error=*/std::nullopt, [](const grpc::Status& status) {});
+  EXPECT_EQ(encoded.status().code(), absl::StatusCode::kInternal);
+}
+
 std::string ErrStr(absl::string_view field_name,
                    absl::string_view expected_type,
                    absl::string_view observed_type) {
@@ -146,8 +146,8 @@ absl::StatusOr<HpkeMessage> PackageServerComponentAuctionResult(
       std::make_unique<server_common::FakeKeyFetcherManager>(
           keyset.public_key, keyset.private_key, std::to_string(keyset.key_id));
   auto crypto_client = CreateCryptoClient();
-  return HpkeEncrypt(plaintext_response, *crypto_client, *key_fetcher_manager,
-                     server_common::CloudPlatform::kGcp);
+  return HpkeEncrypt(std::move(plaintext_response), *crypto_client,
+                     *key_fetcher_manager, server_common::CloudPlatform::kGcp);
 }
 
 absl::StatusOr<AuctionResult> UnpackageResultForServerComponentAuction(